@@ -57,6 +57,17 @@ function (set_visual_studio_project_folder TARGET REMOVE_CURRENT)
 endfunction ()
 
 
+# Add the ${TARGET} microbenchmark built from ${SOURCE} and linked with the rest of the arguments. It is not part of
+# the ALL target, build it on demand (inc/Benchmark.h tells which benchmarks can be compared across revisions).
+function (add_benchmark TARGET SOURCE)
+  add_executable (${TARGET} EXCLUDE_FROM_ALL ${SOURCE})
+  add_dependencies (${TARGET} ${COLUMBUS_GLOBAL_DEPENDENCY})
+  if (ARGN)
+    target_link_libraries (${TARGET} ${ARGN})
+  endif ()
+  set_visual_studio_project_folder (${TARGET} TRUE)
+endfunction ()
+
 # Replace the ${FROM} parameter in all the compiler flag lists to ${TO}
 function (replace_compiler_options FROM TO)
   set(CompilerFlags
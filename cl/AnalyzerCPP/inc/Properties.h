@@ -55,6 +55,8 @@ struct Properties : public columbus::controller::BaseProperties {
     , cleanProject(false)
     , maxCan2LimThreads(0)
     , runCppcheck(true)
+    , deferAnalysis(false)
+    , astCacheSize(0)
     , runClangTidy(true)
     , runLimMetrics(true)
     , runDCF(true)
@@ -106,6 +108,9 @@ struct Properties : public columbus::controller::BaseProperties {
   bool analyzeOnly;                                   // Run the analysis only.
   int maxCan2LimThreads;                              // Number of maximum threads the Can2Lim task can use
   bool runCppcheck;                                   // Run cppcheck.
+  bool deferAnalysis;                                 // The wrappers record the analyzer commands, which are run after the build.
+  boost::filesystem::path astCacheDir;                // Absolute path of the directory of the AST cache shared by the analyses (no cache if it is empty)
+  int astCacheSize;                                   // Size limit of the AST cache in MByte (the default of the wrapper if it is 0)
   bool runClangTidy;                                  // Run clang-tidy.
   bool runLimMetrics;                                 // Run Lim2Metrics.
   bool runDCF;                                        // Run DCF.
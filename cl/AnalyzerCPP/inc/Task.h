@@ -22,6 +22,8 @@
 #define _OSACPP_CONTR_TASK_H_
 
 #include <atomic>
+#include <map>
+#include <ostream>
 #include <boost/thread.hpp>
 
 #include "Properties.h"
@@ -51,7 +53,8 @@ class ClangTidyTask : public columbus::controller::Task
   class Worker : public columbus::thread::Task
   {
   public:
-    Worker(const boost::filesystem::path program, std::queue<std::vector<std::string>>& clangtidy_args, std::string& logDir, boost::mutex& m, boost::condition_variable& cv, std::atomic<int>& threadsLeft, int* failure) : program(program), clangtidy_args(clangtidy_args), logDir(logDir), m(m), cv(cv), threadsLeft(threadsLeft), failure(failure) {}
+    Worker(const boost::filesystem::path program, std::queue<std::vector<std::string>>& clangtidy_args, std::string& logDir, boost::mutex& m, boost::condition_variable& cv, std::atomic<int>& threadsLeft, int* failure, std::map<std::string, double>& timings, std::ostream& finishedList)
+      : program(program), clangtidy_args(clangtidy_args), logDir(logDir), m(m), cv(cv), threadsLeft(threadsLeft), failure(failure), timings(timings), finishedList(finishedList) {}
     void operator()();
 
   private:
@@ -62,6 +65,8 @@ class ClangTidyTask : public columbus::controller::Task
     boost::condition_variable& cv;
     std::atomic<int>& threadsLeft;
     int* failure;
+    std::map<std::string, double>& timings;   // The running time of clang-tidy for each AST (guarded by m)
+    std::ostream& finishedList;               // The finished ASTs are appended to the input list of the ClangTidy2Graph (guarded by m)
   };
 
 public:
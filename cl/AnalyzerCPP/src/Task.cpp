@@ -25,6 +25,7 @@
 #include <cstdlib>
 #include <cstdarg>
 #include <algorithm>
+#include <chrono>
 #include <regex>
 
 #include <Exception.h>
@@ -43,6 +44,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/regex.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
 
 #include "../inc/Task.h"
 #include "../inc/messages.h"
@@ -57,6 +59,9 @@ using namespace boost::filesystem;
 namespace
 {
   void generateClangTidyConfigFile(columbus::rul::RulHandler& rulHandler, const std::string& outputFileName);
+  void loadClangTidyTimings(const std::string& fileName, std::map<std::string, double>& timings);
+  void saveClangTidyTimings(const std::string& fileName, const std::map<std::string, double>& timings);
+  void sortByExpectedClangTidyTime(std::list<std::string>& astList, const std::map<std::string, double>& timings);
   list<TemporalArhiveExtractor> archives;
 }
 
@@ -160,6 +165,7 @@ Task::ExecutionResult WrapperTask::execute()
     copyBinaryExecutable(props.wrapperToolsDir, wrapperWorkDirBin, "CANLink");
     copyBinaryExecutable(props.wrapperToolsDir, wrapperWorkDirBin, "CANLib");
     copyBinaryExecutable(props.wrapperToolsDir, wrapperWorkDirBin, "AnalyzerWrapperConfig");
+    copyBinaryExecutable(props.wrapperToolsDir, wrapperWorkDirBin, "DeferredAnalysis");
 
     copyDirectory(props.wrapperToolsDir, wrapperWorkDirBin, "cppcheck");
     copyDirectory(props.wrapperToolsDir, wrapperWorkDirLib, "clang");
@@ -317,6 +323,21 @@ Task::ExecutionResult WrapperTask::execute()
       sv.push_back("1");
     }
 
+    if (props.deferAnalysis) {
+      sv.push_back("-deferAnalysis");
+      sv.push_back("1");
+    }
+
+    if (!props.astCacheDir.empty()) {
+      sv.push_back("-astCacheDir");
+      sv.push_back(props.astCacheDir.string());
+
+      if (props.astCacheSize > 0) {
+        sv.push_back("-astCacheSize");
+        sv.push_back(std::to_string(props.astCacheSize));
+      }
+    }
+
     if (props.wrapperMode == WM_CL)
     {
       if (props.noDelayedTemplateParsing) {
@@ -342,6 +363,13 @@ Task::ExecutionResult WrapperTask::execute()
     sv.clear();
     checkedExec(props.buildScript, sv, logger);
 
+    // the analyzer commands recorded by the wrappers during the build
+    if (props.deferAnalysis) {
+      sv.push_back("-jobs");
+      sv.push_back(std::to_string(props.maxThreads));
+      checkedExec(wrapperWorkDirBin / "DeferredAnalysis", sv, logger);
+    }
+
     if (exists(wrapperWorkDirLog / "Error.log")) {
       logstream << CMSG_WRAPPER_ERROR << endl;
       result.setError(CMSG_WRAPPER_ERROR);
@@ -653,13 +681,19 @@ void ClangTidyTask::Worker::operator()()
       clangtidy_args.pop();
     }
     // Invoke clang-tidy with the arguments
+    auto start = std::chrono::steady_clock::now();
     result = exec(program, args, logstream);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
     {
       boost::lock_guard<boost::mutex> lock(m);
 
       if (result)
         *failure = true;
+
+      // The ClangTidy2Graph converts the results of the finished ASTs while the others are analyzed
+      timings[args.front()] = seconds;
+      finishedList << args.front() << endl;
     }
 
     if(threadsLeft.load() > 0)
@@ -679,6 +713,9 @@ Task::ExecutionResult ClangTidyTask::execute()
     const string ClangTidyConfigFile = (props.tempDir / "ClangTidy.conf").string();
     const boost::filesystem::path& clangTidyPath = props.wrapperToolsDir / "clang-tidy";
 
+    const string timingsFile = (props.projectResultDir / (props.projectName + "-ClangTidy.timings.csv")).string();
+    const string streamListFile = (props.tempDir / "ClangTidy.finished.list").string();
+
     list<string> astList;
 
     if (loadStringListFromFile((wrapperWorkDirLog / "ast.list").string(), astList))
@@ -686,6 +723,58 @@ Task::ExecutionResult ClangTidyTask::execute()
       astList.sort();
       astList.unique();
 
+      // Longest processing time first, so the analysis does not end with a few big ASTs running alone
+      map<string, double> timings;
+      loadClangTidyTimings(timingsFile, timings);
+      sortByExpectedClangTidyTime(astList, timings);
+      timings.clear();
+
+      // The ClangTidy2Graph runs during the analysis, it reads the finished ASTs from the stream list until an empty line
+      std::ofstream finishedList(streamListFile.c_str(), ios_base::binary | ios_base::trunc);
+      logger.criticalErrorIfFail(finishedList.is_open(), CMSG_ERROR_OPEN_FILE, streamListFile.c_str());
+
+      // The lock is held until the list is closed, so the ClangTidy2Graph notices if this process stops before that
+      const string streamLockFile = streamListFile + ".lock";
+      logger.criticalErrorIfFail(std::ofstream(streamLockFile.c_str()).is_open(), CMSG_ERROR_OPEN_FILE, streamLockFile.c_str());
+      boost::interprocess::file_lock streamLock(streamLockFile.c_str());
+      streamLock.lock();
+
+      vector<string> tidy2graphArgs;
+
+      tidy2graphArgs.push_back("-graph:" + (props.graphDir / (props.projectName + "-clangtidy.graph")).string());
+      tidy2graphArgs.push_back("-rul:" + (props.tempDir / "ClangTidy.rul.md").string());
+      tidy2graphArgs.push_back("-exportrul");
+      tidy2graphArgs.push_back("-lim:" + (props.asgDir / (props.projectName + ".lim")).string());
+      tidy2graphArgs.push_back("-inputlist:" + (wrapperWorkDirLog / "ast.list").string());
+      tidy2graphArgs.push_back("-stream:" + streamListFile);
+      tidy2graphArgs.push_back("-out:" + (props.projectTimedResultDir  / (props.projectName + "-ClangTidy.txt")).string());
+
+      int tidy2graphResult = 0;
+      boost::thread tidy2graph([&]() { tidy2graphResult = exec(props.toolsDir / "ClangTidy2Graph", tidy2graphArgs, logstream); });
+
+      // The list is closed and the converter is waited for even if the analysis is interrupted by an exception
+      struct StreamCloser
+      {
+        std::ofstream& list;
+        boost::interprocess::file_lock& lock;
+        boost::thread& converter;
+
+        void close()
+        {
+          // The empty line lets the ClangTidy2Graph aggregate the warnings and save the graph
+          if (list.is_open())
+          {
+            list << endl;
+            list.close();
+            lock.unlock();
+          }
+          if (converter.joinable())
+            converter.join();
+        }
+
+        ~StreamCloser() { close(); }
+      } streamCloser = { finishedList, streamLock, tidy2graph };
+
       // Start running clang-tidy on multiple threads
       queue<vector<string>> clangtidy_args; // Holds the arguements for each seperate run of the clang-metrics
       boost::condition_variable cv; // Used to notify the main thread when a thread has finished
@@ -716,7 +805,7 @@ Task::ExecutionResult ClangTidyTask::execute()
         {
           string logDir = (properties.logDir / (getName() + "-T" + to_string(i) + ".log")).string();
           int* taskResult = &results[i];
-          threadPool.add(columbus::thread::ThreadPool::PtrTask(new Worker(clangTidyPath, clangtidy_args, logDir, m, cv, threadsLeft, taskResult)));
+          threadPool.add(columbus::thread::ThreadPool::PtrTask(new Worker(clangTidyPath, clangtidy_args, logDir, m, cv, threadsLeft, taskResult, timings, finishedList)));
         }
       }
       
@@ -724,13 +813,17 @@ Task::ExecutionResult ClangTidyTask::execute()
         // Start a worker on this thread too
         string logDir = (properties.logDir / (getName() + "-T0.log")).string();
         int* taskResult = &results[0];
-        Worker worker(clangTidyPath, clangtidy_args, logDir, m, cv, threadsLeft, taskResult);
+        Worker worker(clangTidyPath, clangtidy_args, logDir, m, cv, threadsLeft, taskResult, timings, finishedList);
         worker();
       }
 
       // Wait for all the threads to finish
-      boost::unique_lock<boost::mutex> lock(m);
-      cv.wait(lock, [&threadsLeft]() { return  threadsLeft.load() == 0; });
+      {
+        boost::unique_lock<boost::mutex> lock(m);
+        cv.wait(lock, [&threadsLeft]() { return  threadsLeft.load() == 0; });
+      }
+
+      saveClangTidyTimings(timingsFile, timings);
       
       // Delete any empty log files
       for (int i = 0; i < props.maxThreads; i++)
@@ -752,18 +845,11 @@ Task::ExecutionResult ClangTidyTask::execute()
         }
       }
       
-      logger.errorIfFail(!failure, errorMsg.c_str());
-
-      vector<string> tidy2graphArgs;
+      // The converter writes the log too, so nothing is logged until it is finished
+      streamCloser.close();
 
-      tidy2graphArgs.push_back("-graph:" + (props.graphDir / (props.projectName + "-clangtidy.graph")).string());
-      tidy2graphArgs.push_back("-rul:" + (props.tempDir / "ClangTidy.rul.md").string());
-      tidy2graphArgs.push_back("-exportrul");
-      tidy2graphArgs.push_back("-lim:" + (props.asgDir / (props.projectName + ".lim")).string());
-      tidy2graphArgs.push_back("-inputlist:" + (props.columbusWrapperTmpDir / "log" / "ast.list").string());
-      tidy2graphArgs.push_back("-out:" + (props.projectTimedResultDir  / (props.projectName + "-ClangTidy.txt")).string());
-
-      checkedExec(props.toolsDir / "ClangTidy2Graph", tidy2graphArgs, logger, false);
+      logger.errorIfFail(!failure, errorMsg.c_str());
+      logger.errorIfFail(tidy2graphResult == 0, CMSG_ERROR_EXECUTION_FAILURE, tidy2graphResult);
     }
   } HANDLE_TASK_EXCEPTIONS
 
@@ -1061,6 +1147,80 @@ namespace {
       out.close();
     }
   }
+
+  // The timings of the previous analysis, each line contains the seconds and the AST file separated by a semicolon.
+  void loadClangTidyTimings(const string& fileName, map<string, double>& timings)
+  {
+    std::ifstream in(fileName);
+    string line;
+    while (getline(in, line))
+    {
+      size_t separator = line.find(';');
+      if (separator == string::npos)
+        continue;
+
+      try
+      {
+        timings[line.substr(separator + 1)] = stod(line.substr(0, separator));
+      }
+      catch (const std::exception&)
+      {
+        // the line is skipped, the AST is scheduled by its size
+      }
+    }
+  }
+
+  void saveClangTidyTimings(const string& fileName, const map<string, double>& timings)
+  {
+    std::ofstream out(fileName, std::ofstream::out | std::ofstream::trunc);
+    if (!out)
+    {
+      WriteMsg::write(CMSG_FAILED_TO_OPEN_FILE, fileName.c_str());
+      return;
+    }
+
+    for (const auto& timing : timings)
+      out << timing.second << ';' << timing.first << '\n';
+  }
+
+  // Sorts the ASTs by their expected running time in descending order. The expected time of an AST is its time in the
+  // previous analysis. Without timing, it is estimated from the size of the AST with the average speed of the timed ASTs.
+  void sortByExpectedClangTidyTime(list<string>& astList, const map<string, double>& timings)
+  {
+    vector<pair<string, uintmax_t>> sizes;
+    double timedSeconds = 0;
+    double timedBytes = 0;
+    for (const auto& fileName : astList)
+    {
+      boost::system::error_code ec;
+      uintmax_t size = file_size(fileName, ec);
+      if (ec)
+        size = 0;
+
+      sizes.push_back(make_pair(fileName, size));
+
+      auto timing = timings.find(fileName);
+      if (timing != timings.end())
+      {
+        timedSeconds += timing->second;
+        timedBytes += size;
+      }
+    }
+
+    const double secondsPerByte = timedBytes > 0 ? timedSeconds / timedBytes : 1.0;
+    vector<pair<double, string>> expected;
+    for (const auto& size : sizes)
+    {
+      auto timing = timings.find(size.first);
+      expected.push_back(make_pair(timing != timings.end() ? timing->second : size.second * secondsPerByte, size.first));
+    }
+
+    stable_sort(expected.begin(), expected.end(), [](const pair<double, string>& a, const pair<double, string>& b) { return a.first > b.first; });
+
+    astList.clear();
+    for (const auto& ast : expected)
+      astList.push_back(ast.second);
+  }
 }
 
 TASK_NAME_DEF(UserDefinedMetricsTask);
@@ -112,6 +112,24 @@ bool ppCppcheck(const common::Option *o, char *argv[]) {
   return true;
 }
 
+bool ppDeferAnalysis(const common::Option *o, char *argv[]) {
+  if(strcmp(argv[0], "true") == 0)
+    props.deferAnalysis = true;
+  else
+    props.deferAnalysis = false;
+  return true;
+}
+
+bool ppAstCacheDir(const common::Option *o, char *argv[]) {
+  props.astCacheDir = argv[0];
+  return true;
+}
+
+bool ppAstCacheSize(const common::Option *o, char *argv[]) {
+  props.astCacheSize = common::str2int(argv[0]);
+  return true;
+}
+
 bool ppClangTidy(const common::Option *o, char *argv[]) {
   if(strcmp(argv[0], "true") == 0)
     props.runClangTidy = true;
@@ -306,6 +324,9 @@ const Option OPTIONS_OBJ [] = {
   { false,  "-csvSeparator",              1, CL_KIND_CHAR,     0, OT_WE | OT_WC,     ppCsvSeparator,              NULL, "This parameter sets the separator character in the CSV outputs. The default value is the comma (\",\"). The character set here must be placed in quotation marks (e.g. -csvSeparator=\";\"). Tabulator character can be set by the special \"\\t\" value."},
   { false,  "-csvDecimalMark",            1, CL_KIND_CHAR,     0, OT_WE | OT_WC,     ppCsvDecimalMark,            NULL, "This parameter sets the decimal mark character in the CSV outputs. The default is value is the dot (\".\"). The character set here must be placed in quotation marks (e.g. -csvDecimalMark=\",\")."},
   { false,  "-runCppcheck",               1, CL_KIND_BOOL,     0, OT_WE | OT_WC,     ppCppcheck,                  NULL, "This parameter turns on or off the Cppcheck coding rule violation checking. With this feature, OpenStaticAnalyzer lists coding rule violations detected by Cppcheck. Its value can be \"true\" (turn this feature on) or \"false\" (turn this feature off). The default value is \"true\"."},
+  { false,  "-deferAnalysis",             1, CL_KIND_BOOL,     0, OT_WE | OT_WC,     ppDeferAnalysis,             NULL, "This parameter turns on or off the deferred analysis. In this mode, the wrappers only record the analyzer commands (CAN, Cppcheck, CANLib, CANLink) and return immediately. After the build, the CAN and Cppcheck commands run in parallel, and no new command starts while the system load is above the number of CPU cores. Then the CANLib and CANLink commands run in their original order. Its value can be \"true\" (turn this feature on) or \"false\" (turn this feature off). The default value is \"false\"."},
+  { false,  "-astCacheDir",               1, CL_KIND_DIR,      0, OT_WE | OT_WC,     ppAstCacheDir,               NULL, "Relative or absolute path name of the directory of the AST cache. If it is set, the results of CAN and Cppcheck are cached, and they are reused for the source files which are compiled with the same arguments and whose included files are not changed since a previous analysis. The cache can be shared by the analyses of several projects."},
+  { false,  "-astCacheSize",              1, CL_KIND_NUMBER,   0, OT_WE | OT_WC,     ppAstCacheSize,              NULL, "This parameter sets the size limit of the AST cache in megabytes. Over this limit, the least recently used results are removed from the cache. The default value is 5120."},
   { false,  "-runClangTidy",              1, CL_KIND_BOOL,     0, OT_WE | OT_WC,     ppClangTidy,                 NULL, "This parameter turns on or off the Clang-tidy coding rule violation checking. With this feature, OpenStaticAnalyzer lists coding rule violations detected by Clang-tidy. Its value can be \"true\" (turn this feature on) or \"false\" (turn this feature off). The default value is \"true\"."},
   { false,  "-runMetricHunter",           1, CL_KIND_BOOL,     0, OT_WE | OT_WC,     ppRunMetricHunter,           NULL, "This parameter turns on or off the MetricHunter module. With this feature, OpenStaticAnalyzer lists metric threshold violations. Its value can be \"true\" (turn this feature on) or \"false\" (turn this feature off). The default value is \"true\""},
   { false,  "-runDCF",                    1, CL_KIND_BOOL,     0, OT_WE | OT_WC,     ppRunDCF,                    NULL, "This parameter turns on or off the DuplicatedCodeFinder module. With this feature, OpenStaticAnalyzer identifies copy-pasted code fragments. Its value can be \"true\" (turn this feature on) or \"false\" (turn this feature off). The default value is \"true\""},
@@ -362,6 +383,9 @@ void dumpProperties() {
   DUMP_PROPERTY_PATH(profileXML);
   DUMP_PROPERTY_PATH(rulesCSV);
   DUMP_PROPERTY_INT(runCppcheck);
+  DUMP_PROPERTY_INT(deferAnalysis);
+  DUMP_PROPERTY_PATH(astCacheDir);
+  DUMP_PROPERTY_INT(astCacheSize);
   DUMP_PROPERTY_INT(runClangTidy);
   DUMP_PROPERTY_INT(runLimMetrics);
   DUMP_PROPERTY_INT(runDCF);
@@ -423,6 +447,9 @@ void checkUserProperties()
   if ( !props.externalSoftFilter.empty() )
     props.externalSoftFilter = system_complete(props.externalSoftFilter);
 
+  if ( !props.astCacheDir.empty() )
+    props.astCacheDir = system_complete(props.astCacheDir);
+
   if (props.maxThreads == 0)
     props.maxThreads = columbus::thread::ThreadPool::getNumberOfCores();
 
@@ -0,0 +1,106 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef __CAN_STAT_CACHE_FILE_SYSTEM_H__
+#define __CAN_STAT_CACHE_FILE_SYSTEM_H__
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include <boost/thread.hpp>
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+/**
+ * The stat results and the contents of the files read while parsing the translation units
+ * of a batch. It is shared by the workers of the batch, so every header is stat'ed and
+ * read only once. The cache is keyed by absolute paths, and it contains the failed lookups
+ * (of the include directory searches) as well.
+ */
+class SharedStatCache
+{
+public:
+  /**
+   * @param uncachedFiles  The files whose contents are always read from the disk (the main files of the translation units).
+   */
+  explicit SharedStatCache(std::set<std::string> uncachedFiles);
+
+  /**
+   * Returns true and sets the status (or the error code of the failed lookup) if the path is already cached.
+   */
+  bool findStatus(const std::string& path, llvm::ErrorOr<llvm::vfs::Status>& status) const;
+
+  void addStatus(const std::string& path, const llvm::ErrorOr<llvm::vfs::Status>& status);
+
+  /**
+   * Returns the cached contents of the file or nullptr.
+   */
+  const llvm::MemoryBuffer* findContents(const std::string& path) const;
+
+  /**
+   * Stores the contents of the file (if it is already stored by an other worker, the stored one is returned).
+   */
+  const llvm::MemoryBuffer* addContents(const std::string& path, std::unique_ptr<llvm::MemoryBuffer> contents);
+
+  bool isCacheable(const std::string& path) const;
+
+  unsigned long long getStatHits() const { return statHits; }
+  unsigned long long getStatMisses() const { return statMisses; }
+  unsigned long long getReadHits() const { return readHits; }
+  unsigned long long getReadMisses() const { return readMisses; }
+
+private:
+  std::set<std::string> uncachedFiles;
+
+  std::unordered_map<std::string, llvm::ErrorOr<llvm::vfs::Status>> statuses;
+  std::unordered_map<std::string, std::unique_ptr<llvm::MemoryBuffer>> contents;
+  mutable boost::shared_mutex statusMutex;
+  mutable boost::shared_mutex contentsMutex;
+
+  mutable std::atomic<unsigned long long> statHits;
+  std::atomic<unsigned long long> statMisses;
+  mutable std::atomic<unsigned long long> readHits;
+  std::atomic<unsigned long long> readMisses;
+};
+
+/**
+ * File system of one worker of the batch. It has its own working directory (the clang tool
+ * changes it for every translation unit, so the process wide one cannot be used by several
+ * threads), and it looks up the stat results and the file contents in the shared cache first.
+ */
+class StatCacheFileSystem : public llvm::vfs::ProxyFileSystem
+{
+public:
+  explicit StatCacheFileSystem(SharedStatCache& cache);
+
+  llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override;
+  llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine& path) override;
+
+private:
+  bool getAbsolutePath(const llvm::Twine& path, std::string& absolutePath) const;
+
+  SharedStatCache& cache;
+};
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/StatCacheFileSystem.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
+
+using namespace std;
+using namespace llvm;
+
+namespace
+{
+  /**
+   * File opened from the contents in the shared cache.
+   */
+  class CachedFile : public vfs::File
+  {
+  public:
+    CachedFile(vfs::Status fileStatus, const MemoryBuffer& contents) : fileStatus(std::move(fileStatus)), contents(contents) {}
+
+    ErrorOr<vfs::Status> status() override
+    {
+      return fileStatus;
+    }
+
+    ErrorOr<unique_ptr<MemoryBuffer>> getBuffer(const Twine& name, int64_t fileSize, bool requiresNullTerminator, bool isVolatile) override
+    {
+      return MemoryBuffer::getMemBuffer(contents.getBuffer(), name.str(), requiresNullTerminator);
+    }
+
+    std::error_code close() override
+    {
+      return std::error_code();
+    }
+
+  private:
+    vfs::Status fileStatus;
+    const MemoryBuffer& contents;
+  };
+}
+
+SharedStatCache::SharedStatCache(set<string> uncachedFiles)
+  : uncachedFiles(std::move(uncachedFiles))
+  , statuses()
+  , contents()
+  , statHits(0)
+  , statMisses(0)
+  , readHits(0)
+  , readMisses(0)
+{
+}
+
+bool SharedStatCache::findStatus(const string& path, ErrorOr<vfs::Status>& status) const
+{
+  boost::shared_lock<boost::shared_mutex> lock(statusMutex);
+  auto it = statuses.find(path);
+  if (it == statuses.end())
+    return false;
+
+  status = it->second;
+  ++statHits;
+  return true;
+}
+
+void SharedStatCache::addStatus(const string& path, const ErrorOr<vfs::Status>& status)
+{
+  boost::unique_lock<boost::shared_mutex> lock(statusMutex);
+  statuses.emplace(path, status);
+  ++statMisses;
+}
+
+const MemoryBuffer* SharedStatCache::findContents(const string& path) const
+{
+  boost::shared_lock<boost::shared_mutex> lock(contentsMutex);
+  auto it = contents.find(path);
+  if (it == contents.end())
+    return nullptr;
+
+  ++readHits;
+  return it->second.get();
+}
+
+const MemoryBuffer* SharedStatCache::addContents(const string& path, unique_ptr<MemoryBuffer> buffer)
+{
+  boost::unique_lock<boost::shared_mutex> lock(contentsMutex);
+  ++readMisses;
+  return contents.emplace(path, std::move(buffer)).first->second.get();
+}
+
+bool SharedStatCache::isCacheable(const string& path) const
+{
+  return uncachedFiles.find(path) == uncachedFiles.end();
+}
+
+
+StatCacheFileSystem::StatCacheFileSystem(SharedStatCache& cache)
+  : ProxyFileSystem(IntrusiveRefCntPtr<vfs::FileSystem>(vfs::createPhysicalFileSystem().release()))
+  , cache(cache)
+{
+}
+
+bool StatCacheFileSystem::getAbsolutePath(const Twine& path, string& absolutePath) const
+{
+  SmallString<256> pathBuffer;
+  path.toVector(pathBuffer);
+  if (makeAbsolute(pathBuffer))
+    return false;
+
+  // ".." is kept, it cannot be resolved without following the symbolic links
+  sys::path::remove_dots(pathBuffer, false);
+  absolutePath = pathBuffer.str().str();
+  return true;
+}
+
+ErrorOr<vfs::Status> StatCacheFileSystem::status(const Twine& path)
+{
+  string absolutePath;
+  if (!getAbsolutePath(path, absolutePath))
+    return ProxyFileSystem::status(path);
+
+  ErrorOr<vfs::Status> result = make_error_code(errc::no_such_file_or_directory);
+  if (!cache.findStatus(absolutePath, result))
+  {
+    result = ProxyFileSystem::status(absolutePath);
+    cache.addStatus(absolutePath, result);
+  }
+
+  if (!result)
+    return result.getError();
+
+  return vfs::Status::copyWithNewName(*result, path.str());
+}
+
+ErrorOr<unique_ptr<vfs::File>> StatCacheFileSystem::openFileForRead(const Twine& path)
+{
+  string absolutePath;
+  if (!getAbsolutePath(path, absolutePath) || !cache.isCacheable(absolutePath))
+    return ProxyFileSystem::openFileForRead(path);
+
+  ErrorOr<vfs::Status> fileStatus = status(absolutePath);
+  if (!fileStatus)
+    return fileStatus.getError();
+
+  if (!fileStatus->isRegularFile())
+    return ProxyFileSystem::openFileForRead(path);
+
+  const MemoryBuffer* contents = cache.findContents(absolutePath);
+  if (!contents)
+  {
+    ErrorOr<unique_ptr<vfs::File>> file = ProxyFileSystem::openFileForRead(absolutePath);
+    if (!file)
+      return file.getError();
+
+    ErrorOr<unique_ptr<MemoryBuffer>> buffer = (*file)->getBuffer(absolutePath, fileStatus->getSize(), true, false);
+    if (!buffer)
+      return buffer.getError();
+
+    contents = cache.addContents(absolutePath, std::move(*buffer));
+  }
+
+  return unique_ptr<vfs::File>(new CachedFile(vfs::Status::copyWithNewName(*fileStatus, path.str()), *contents));
+}
@@ -20,15 +20,27 @@
 
 #include <clang/AST/ASTContext.h>
 #include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/MultiplexConsumer.h>
+#include <clang/Serialization/ASTWriter.h>
 #include <clang/Tooling/Tooling.h>
 #include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/JSONCompilationDatabase.h>
 #include "clang/Frontend/TextDiagnosticPrinter.h"
+#include <llvm/Support/Path.h>
+#include <llvm/Support/xxhash.h>
+#include <llvm/ADT/StringExtras.h>
 #include <common/inc/Stat.h>
 #include <common/inc/FileSup.h>
 #include <common/inc/StringSup.h>
 #include <common/inc/WriteMessage.h>
 #include <common/inc/DirectoryFilter.h>
+#include <threadpool/inc/ThreadPool.h>
 
+#include "../inc/StatCacheFileSystem.h"
+
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <string>
 #include <iostream>
@@ -49,71 +61,91 @@ namespace
 {
 // Tool CL options.
 cl::OptionCategory category(EXECUTABLE_NAME " options");
-cl::opt<string> outputFilename("o", cl::desc("AST file to output"), cl::Required, cl::cat(category));
+cl::opt<string> outputFilename("o", cl::desc("AST file to output"), cl::cat(category));
 cl::opt<string> statFilename("stat", cl::desc("Statistics file"), cl::cat(category));
 cl::opt<string> configFilename("config", cl::desc("Configuration file"), cl::cat(category));
 cl::opt<string> changePathFrom("changepathfrom", cl::desc("Part of the paths needed to be replaced"), cl::cat(category));
 cl::opt<string> changePathTo("changepathto", cl::desc("New value of the path to be inserted"), cl::cat(category));
 cl::opt<string> filterPath("fltp", cl::desc("Path to the softfilter file"), cl::cat(category));
+cl::opt<string> batchFilename("batch", cl::desc("Compilation database (compile_commands.json) of the translation units to be parsed in one run; the AST file of an entry is given by its \"output\" field"), cl::cat(category));
+cl::opt<string> pchDirectory("pch", cl::desc("Directory of the precompiled headers shared by the translation units with the same include prefix; the AST files reference them instead of containing the headers"), cl::cat(category));
+cl::opt<string> dependencyFilename("deps", cl::desc("File listing the main file and the included files of the translation unit, one canonical path per line (the wrapper caches the AST by the contents of these files)"), cl::cat(category));
+cl::opt<unsigned> batchThreads("threads", cl::desc("Number of the worker threads of the batch mode (default: number of cores)"), cl::init(0), cl::cat(category));
 
-// Handles comments.
-class CANAction : public ASTFrontendAction
+// Serializes the messages of the batch workers.
+boost::mutex outputMutex;
+
+// Writes the comments into the .comment file.
+class MyCommentHandler: public CommentHandler
 {
+public:
+  ofstream commentFile;
+
+  MyCommentHandler() : prevFileEntry(nullptr) {}
+
 private:
-  class MyCommentHandler: public CommentHandler
+  const FileEntry *prevFileEntry;
+
+  bool HandleComment(Preprocessor& pp, SourceRange comment) override
   {
-  public:
-    ofstream commentFile;
+    const SourceManager& sm = pp.getSourceManager();
+    const SourceLocation beg = comment.getBegin();
+    const SourceLocation end = comment.getEnd();
 
-  private:
-    const FileEntry *prevFileEntry;
+    const unsigned bl = sm.getSpellingLineNumber(beg);
+    const unsigned bc = sm.getSpellingColumnNumber(beg);
+    const unsigned el = sm.getSpellingLineNumber(end);
+    const unsigned ec = sm.getSpellingColumnNumber(end);
 
-    bool HandleComment(Preprocessor& pp, SourceRange comment) override
+    if (const FileEntry *F = sm.getFileEntryForID(sm.getFileID(beg)))
     {
-      const SourceManager& sm = pp.getSourceManager();
-      const SourceLocation beg = comment.getBegin();
-      const SourceLocation end = comment.getEnd();
-
-      const unsigned bl = sm.getSpellingLineNumber(beg);
-      const unsigned bc = sm.getSpellingColumnNumber(beg);
-      const unsigned el = sm.getSpellingLineNumber(end);
-      const unsigned ec = sm.getSpellingColumnNumber(end);
-
-      if (const FileEntry *F = sm.getFileEntryForID(sm.getFileID(beg)))
+      if (prevFileEntry != F)
       {
-        if (prevFileEntry != F)
-        {
-          //new file encountered
-          prevFileEntry = F;
-          commentFile << (char)1 << ' '; //this marks that the line is for a file
+        //new file encountered
+        prevFileEntry = F;
+        commentFile << (char)1 << ' '; //this marks that the line is for a file
 
-          string filename = F->getName().str();
+        // The relative names are resolved in the working directory of the translation unit (in batch mode it is not the CWD of the process)
+        SmallString<256> absoluteName(F->getName());
+        sm.getFileManager().makeAbsolutePath(absoluteName);
+        string filename = absoluteName.str().str();
 
-          // We need to get the canonical (absolute) path for the file, as the CWD could change during build so relative paths make no sense
-          filename = common::pathCanonicalize(filename);
+        // We need to get the canonical (absolute) path for the file, as the CWD could change during build so relative paths make no sense
+        filename = common::pathCanonicalize(filename);
 
-          // Unless, there is a "global" string replace on paths (which we sometimes use for relative paths, but these are all relative to one specific "folder")
-          if(filename.c_str() && changePathFrom.c_str() && changePathTo.c_str())
-            filename = common::replace(filename.c_str(), changePathFrom.c_str(), changePathTo.c_str());
+        // Unless, there is a "global" string replace on paths (which we sometimes use for relative paths, but these are all relative to one specific "folder")
+        if(filename.c_str() && changePathFrom.c_str() && changePathTo.c_str())
+          filename = common::replace(filename.c_str(), changePathFrom.c_str(), changePathTo.c_str());
 
-          commentFile << std::quoted(filename) << '\n';
-        }
-
-        commentFile << (char)0 << ' '; //this marks that the line is for a comment
+        commentFile << std::quoted(filename) << '\n';
+      }
 
-        const char* b = sm.getCharacterData(beg);
-        const char* e = sm.getCharacterData(end);
+      commentFile << (char)0 << ' '; //this marks that the line is for a comment
 
-        commentFile << bl << ' ' << bc << ' ' << el << ' ' << ec << ' ' << quoted(string(b, e - b)) << '\n';
-      }
+      const char* b = sm.getCharacterData(beg);
+      const char* e = sm.getCharacterData(end);
 
-      return false;
+      commentFile << bl << ' ' << bc << ' ' << el << ' ' << ec << ' ' << quoted(string(b, e - b)) << '\n';
     }
 
-  };
+    return false;
+  }
+
+};
+
+// Handles comments.
+class CANAction : public ASTFrontendAction
+{
+private:
   MyCommentHandler myHandler;
+  const string outputName;
+  const string pch;
 
 public:
+  // If the translation unit is parsed with a precompiled header, the AST file is written by the action itself, and it
+  // references the precompiled header instead of containing its declarations (ASTUnit::Save always writes the whole AST).
+  CANAction(const string& outputName, const string& pch) : outputName(outputName), pch(pch) {}
+
   unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &Compiler, StringRef InFile) override
   {
     // "Empty" class - we do nothing with the AST, but we must have this even if 'usePreprocessorOnly' is true.
@@ -124,8 +156,33 @@ public:
 
     // Setup output file according to the tool options and the current TU filename.
     // Binary mode is needed to avoid CR/LF confusion on Windows.
-    myHandler.commentFile = ofstream(outputFilename + ".comment", ofstream::binary);
-    return unique_ptr<ASTConsumer>(new Consumer());
+    myHandler.commentFile = ofstream(outputName + ".comment", ofstream::binary);
+
+    if (pch.empty())
+      return unique_ptr<ASTConsumer>(new Consumer());
+
+    // The headers of the precompiled header are not preprocessed again, their comments are collected when it is built.
+    ifstream pchComments(pch + ".comment", ifstream::binary);
+    if (pchComments.peek() != ifstream::traits_type::eof())
+      myHandler.commentFile << pchComments.rdbuf();
+
+    // The same consumers as the ones of 'clang -emit-ast', the writer is chained to the loaded precompiled header.
+    Compiler.getFrontendOpts().OutputFile = outputName;
+    string sysroot;
+    if (!GeneratePCHAction::ComputeASTConsumerArguments(Compiler, sysroot))
+      return nullptr;
+
+    string astFile;
+    unique_ptr<raw_pwrite_stream> os = GeneratePCHAction::CreateOutputFile(Compiler, InFile, astFile);
+    if (!os)
+      return nullptr;
+
+    auto buffer = make_shared<PCHBuffer>();
+    vector<unique_ptr<ASTConsumer>> consumers;
+    consumers.push_back(unique_ptr<ASTConsumer>(new Consumer()));
+    consumers.push_back(make_unique<PCHGenerator>(Compiler.getPreprocessor(), Compiler.getModuleCache(), astFile, "", buffer, Compiler.getFrontendOpts().ModuleFileExtensions, /*AllowASTWithErrors=*/true));
+    consumers.push_back(Compiler.getPCHContainerWriter().CreatePCHContainerGenerator(Compiler, InFile.str(), astFile, std::move(os), buffer));
+    return make_unique<MultiplexConsumer>(std::move(consumers));
   }
 
   bool BeginSourceFileAction(CompilerInstance &ci) override
@@ -179,25 +236,177 @@ vector<string> loadSystemIncludeConfiguration(Language language, const string& f
   return includeDirs;
 }
 
-int run(int argc, const char** argv)
+class MyTextDiagnosticPrinter  : public TextDiagnosticPrinter
 {
-  WriteMsg::setAutomaticFlush(true);
+public:
+  MyTextDiagnosticPrinter(raw_ostream &os, DiagnosticOptions *diags) : TextDiagnosticPrinter(os, diags), directoryFilter(DirectoryFilter::getSharedFilter(filterPath)) {}
+  void HandleDiagnostic(DiagnosticsEngine::Level DiagLevel, const Diagnostic &Info) override 
+  {
+    SmallString<256> absoluteName(Info.getSourceManager().getFilename(Info.getLocation()));
+    Info.getSourceManager().getFileManager().makeAbsolutePath(absoluteName);
+    string canonicalFileName = common::pathCanonicalize(absoluteName.str().str());
+    
+    // If the error is not in a filtered file.
+    if (!directoryFilter->isFilteredOut(canonicalFileName))
+    {
+      boost::mutex::scoped_lock lock(outputMutex);
+      TextDiagnosticPrinter::HandleDiagnostic(DiagLevel, Info);
+    }
+  }
 
-  // Parse options with the common parser.
-  CommonOptionsParser parser(argc, argv, category);
-  const std::vector<string>& files = parser.getSourcePathList();
+private:
+  // the filter file is compiled only once in the process and shared by all the translation units
+  shared_ptr<const DirectoryFilter> directoryFilter;
+};
 
-  if (files.size() != 1)
-    throw std::runtime_error("program requires exactly one input file");
+// ToolAction to create binary AST and comment files.
+class CANActionFactory : public FrontendActionFactory
+{
+public:
+  // If useToolFileSystem is set, the AST is parsed through the file system of the tool (the shared cache of the batch mode).
+  // If pch is set, the translation unit is parsed with this precompiled header, and the AST file references it.
+  // If dependencyName is set, the files of the translation unit are listed into it after a successful parse.
+  CANActionFactory(const string& outputName, bool useToolFileSystem, const string& pch, const string& dependencyName = "")
+    : outputName(outputName), useToolFileSystem(useToolFileSystem), pch(pch), dependencyName(dependencyName) {}
 
-  for (const auto& x : parser.getCompilations().getCompileCommands(files.front()))
+  bool runInvocation(shared_ptr<CompilerInvocation> inv, FileManager* files, shared_ptr<PCHContainerOperations> pchOps, DiagnosticConsumer* dgc) override
   {
-    for (auto y : x.CommandLine)
-      WriteMsg::write(WriteMsg::mlNormal, "%s ", y.c_str());
+    auto opts = &inv->getDiagnosticOpts();
+    auto dc = CompilerInstance::createDiagnostics(opts, dgc, false);
 
-    WriteMsg::write(WriteMsg::mlNormal, "\n");
+    MyTextDiagnosticPrinter consumer(llvm::errs(), opts);
+    dc->setClient(&consumer);
+
+    unique_ptr<ASTUnit> unit;
+    if (useToolFileSystem)
+    {
+      unit = ASTUnit::create(inv, dc, CaptureDiagsKind::None, false);
+      if (unit == nullptr)
+        return false;
+
+      unit->getFileManager().setVirtualFileSystem(IntrusiveRefCntPtr<llvm::vfs::FileSystem>(&files->getVirtualFileSystem()));
+    }
+
+    unique_ptr<FrontendAction> action = create();
+    auto ast = ASTUnit::LoadFromCompilerInvocationAction(std::move(inv), std::move(pchOps), dc, action.get(), unit.get());
+    if (ast == nullptr)
+      return false;
+
+    if (pch.empty() && ast->Save(outputName))
+      return false;
+
+    if (dc->hasErrorOccurred() ||
+        dc->hasUncompilableErrorOccurred() ||
+        dc->hasFatalErrorOccurred() ||
+        dc->hasUnrecoverableErrorOccurred())
+    {
+      return false;
+    }
+
+    if (!dependencyName.empty())
+      writeDependencies(*ast);
+
+    return true;
+  }
+
+  unique_ptr<FrontendAction> create() override { return unique_ptr<FrontendAction>(new CANAction(outputName, pch)); }
+
+private:
+  // Every file read by the preprocessor has an entry in the source manager, the main file included.
+  void writeDependencies(ASTUnit& ast) const
+  {
+    set<string> files;
+    const SourceManager& sm = ast.getSourceManager();
+    for (auto it = sm.fileinfo_begin(); it != sm.fileinfo_end(); ++it)
+    {
+      SmallString<256> absoluteName(it->first->getName());
+      ast.getFileManager().makeAbsolutePath(absoluteName);
+      files.insert(common::pathCanonicalize(absoluteName.str().str()));
+    }
+
+    ofstream dependencyFile(dependencyName, ofstream::binary);
+    for (const auto& file : files)
+      dependencyFile << file << '\n';
+  }
+
+  const string outputName;
+  const bool useToolFileSystem;
+  const string pch;
+  const string dependencyName;
+};
+
+// Builds the precompiled header of an include prefix and collects the comments and the names of its headers.
+class PrefixPCHAction : public GeneratePCHAction
+{
+public:
+  PrefixPCHAction(const string& commentName, vector<string>& headers) : commentName(commentName), headers(headers) {}
+
+  bool BeginSourceFileAction(CompilerInstance &ci) override
+  {
+    myHandler.commentFile = ofstream(commentName, ofstream::binary);
+    ci.getPreprocessor().addCommentHandler(&myHandler);
+    return GeneratePCHAction::BeginSourceFileAction(ci);
+  }
+
+  void EndSourceFileAction() override
+  {
+    const SourceManager& sm = getCompilerInstance().getSourceManager();
+    for (auto it = sm.fileinfo_begin(); it != sm.fileinfo_end(); ++it)
+    {
+      SmallString<256> absoluteName(it->first->getName());
+      sm.getFileManager().makeAbsolutePath(absoluteName);
+      headers.push_back(absoluteName.str().str());
+    }
+
+    GeneratePCHAction::EndSourceFileAction();
+    myHandler.commentFile.close();
+  }
+
+private:
+  MyCommentHandler myHandler;
+  const string commentName;
+  vector<string>& headers;
+};
+
+// ToolAction to create the precompiled header of an include prefix.
+class PrefixPCHActionFactory : public FrontendActionFactory
+{
+public:
+  explicit PrefixPCHActionFactory(const string& outputName) : outputName(outputName) {}
+
+  bool runInvocation(shared_ptr<CompilerInvocation> inv, FileManager* files, shared_ptr<PCHContainerOperations> pch, DiagnosticConsumer* dgc) override
+  {
+    inv->getFrontendOpts().OutputFile = outputName;
+    return FrontendActionFactory::runInvocation(std::move(inv), files, std::move(pch), dgc);
+  }
+
+  unique_ptr<FrontendAction> create() override { return unique_ptr<FrontendAction>(new PrefixPCHAction(outputName + ".comment", headers)); }
+
+  // The files read while the precompiled header was built.
+  const vector<string>& getHeaders() const { return headers; }
+
+private:
+  const string outputName;
+  vector<string> headers;
+};
+
+// Compilation database of one compile command (of the batch or of a precompiled header).
+class SingleCommandDatabase : public CompilationDatabase
+{
+public:
+  explicit SingleCommandDatabase(const CompileCommand& command) : command(command) {}
+
+  vector<CompileCommand> getCompileCommands(StringRef filePath) const override
+  {
+    return vector<CompileCommand>(1, command);
   }
 
+private:
+  const CompileCommand& command;
+};
+
+CommandLineArguments getSystemIncludeArguments()
+{
   auto sysIncludes = loadSystemIncludeConfiguration(Language::cpp, configFilename);
 
   CommandLineArguments cla;
@@ -207,77 +416,438 @@ int run(int argc, const char** argv)
     cla.push_back("-Xclang");
     cla.push_back("-internal-isystem" + sysInclude);
   }
-  
-  // Create Clang tool.
-  ClangTool tool(parser.getCompilations(), files);
+  return cla;
+}
 
+void addArgumentAdjusters(ClangTool& tool, const CommandLineArguments& cla)
+{
   //this may not work
   if (!cla.empty()){
     tool.clearArgumentsAdjusters(); //this may not be needed
     tool.appendArgumentsAdjuster(tooling::getInsertArgumentAdjuster(cla, tooling::ArgumentInsertPosition::BEGIN));
   }
+}
+
+string getAbsolutePath(const string& directory, const string& path)
+{
+  SmallString<256> absolutePath(path);
+  llvm::sys::fs::make_absolute(directory, absolutePath);
+  llvm::sys::path::remove_dots(absolutePath, false);
+  return absolutePath.str().str();
+}
+
+// Returns the leading #include directives of the file (only comments and empty lines can be between them).
+string getIncludePrefix(const string& filename)
+{
+  ifstream file(filename);
+  string prefix;
+  string line;
+  bool inComment = false;
+
+  while (getline(file, line))
+  {
+    StringRef rest(line);
+    while (true)
+    {
+      if (inComment)
+      {
+        size_t end = rest.find("*/");
+        if (end == StringRef::npos)
+        {
+          rest = StringRef();
+          break;
+        }
+        rest = rest.substr(end + 2);
+        inComment = false;
+      }
+
+      rest = rest.ltrim();
+      if (rest.startswith("/*"))
+      {
+        rest = rest.substr(2);
+        inComment = true;
+        continue;
+      }
+      break;
+    }
+
+    rest = rest.rtrim();
+    if (rest.empty() || rest.startswith("//"))
+      continue;
+
+    if (!rest.startswith("#") || !rest.substr(1).ltrim().startswith("include"))
+      break;
+
+    prefix += rest.str() + '\n';
+  }
+  return prefix;
+}
 
-  class MyTextDiagnosticPrinter  : public TextDiagnosticPrinter
+// The quoted includes of the prefix are looked up in the directory of the translation unit first, but the prefix header is in
+// the directory of the precompiled headers, so the ones found there are included by their absolute path.
+string resolveQuotedIncludes(const string& prefix, const string& mainDirectory)
+{
+  string resolved;
+  StringRef rest(prefix);
+  while (!rest.empty())
   {
-  public:
-    MyTextDiagnosticPrinter(raw_ostream &os, DiagnosticOptions *diags) : TextDiagnosticPrinter(os, diags) {}
-    void HandleDiagnostic(DiagnosticsEngine::Level DiagLevel, const Diagnostic &Info) override 
+    pair<StringRef, StringRef> lines = rest.split('\n');
+    rest = lines.second;
+    StringRef line = lines.first;
+
+    size_t begin = line.find('"');
+    size_t end = begin == StringRef::npos ? StringRef::npos : line.find('"', begin + 1);
+    if (end != StringRef::npos)
     {
-      DirectoryFilter directoryFilter;
-      directoryFilter.openFilterFile(filterPath);
-      string canonicalFileName = common::pathCanonicalize(Info.getSourceManager().getFilename(Info.getLocation()).str());
-      
-      // If the error is not in a filtered file.
-      if (!directoryFilter.isFilteredOut(canonicalFileName))
-        TextDiagnosticPrinter::HandleDiagnostic(DiagLevel, Info);
+      StringRef name = line.slice(begin + 1, end);
+      SmallString<256> path(mainDirectory);
+      llvm::sys::path::append(path, name);
+      if (!llvm::sys::path::is_absolute(name) && llvm::sys::fs::exists(path))
+      {
+        resolved += line.substr(0, begin + 1).str() + llvm::sys::path::convert_to_slash(path) + line.substr(end).str() + '\n';
+        continue;
+      }
     }
-  };
+    resolved += line.str() + '\n';
+  }
+  return resolved;
+}
+
+// Gives back the modification time and the size of the headers (one line for each), which identify their content in the key file.
+string getHeaderStamps(const vector<string>& headers)
+{
+  string stamps;
+  for (const auto& header : headers)
+  {
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(header, status))
+      return "";
+    stamps += to_string(status.getLastModificationTime().time_since_epoch().count()) + ' ' + to_string(status.getSize()) + ' ' + header + '\n';
+  }
+  return stamps;
+}
+
+// The key file of a precompiled header contains the key of its prefix and options, the name of the precompiled header built last time,
+// and the stamps of the headers it was built from. Gives back the precompiled header if it still matches the key and the headers.
+string findUpToDatePCH(const string& keyName, const string& key)
+{
+  ifstream keyFile(keyName, ifstream::binary);
+  string storedKey;
+  string pch;
+  if (!(keyFile >> quoted(storedKey) >> quoted(pch)) || storedKey != key)
+    return "";
+
+  keyFile.ignore(1);
+  vector<string> headers;
+  string storedStamps;
+  for (string line; getline(keyFile, line); )
+  {
+    storedStamps += line + '\n';
+    // modification time, size, file name
+    size_t nameBegin = line.find(' ', line.find(' ') + 1);
+    if (nameBegin == string::npos)
+      return "";
+    headers.push_back(line.substr(nameBegin + 1));
+  }
+
+  if (headers.empty() || getHeaderStamps(headers) != storedStamps || !llvm::sys::fs::exists(pch) || !llvm::sys::fs::exists(pch + ".comment"))
+    return "";
+  return pch;
+}
 
-  // ToolAction to create binary AST and comment files.
-  class : public FrontendActionFactory
+// Writes the file unless it already exists (the existing file is never replaced, as other processes may already use it).
+bool publishFile(const string& temporaryFilename, const string& filename)
+{
+  bool published = !llvm::sys::fs::create_hard_link(temporaryFilename, filename) || llvm::sys::fs::exists(filename);
+  llvm::sys::fs::remove(temporaryFilename);
+  return published;
+}
+
+// Gives back the precompiled header of the include prefix of the translation unit (it is built if it does not exist yet),
+// or an empty string if the translation unit has no include prefix or the precompiled header cannot be built.
+string getPrefixPCH(const CompileCommand& command, const CommandLineArguments& cla, IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem, IntrusiveRefCntPtr<FileManager> fileManager)
+{
+  const string mainFile = getAbsolutePath(command.Directory, command.Filename);
+  const string mainDirectory = llvm::sys::path::parent_path(mainFile).str();
+  const string prefix = getIncludePrefix(mainFile);
+  if (prefix.empty())
+    return "";
+
+  // The precompiled header can be shared by the translation units having the same prefix and the same options.
+  CompileCommand pchCommand = command;
+  pchCommand.CommandLine.clear();
+  string key = prefix + '\0' + mainDirectory + '\0' + command.Directory;
+  bool hasMainFile = false;
+  for (size_t i = 0; i < command.CommandLine.size(); ++i)
   {
-  public:
-    // This variable is incremented during each invocation and effectively works as an index into the input file array.
-    int myHack = 0;
-    //unordered_map<string, vector<CommentData>> commentsForFile;
+    const string& argument = command.CommandLine[i];
+    if (argument == "-o" && i + 1 < command.CommandLine.size())
+    {
+      ++i;
+      continue;
+    }
+    if (argument.size() > 2 && argument.compare(0, 2, "-o") == 0)
+      continue;
 
-    // Stores the input file names.
-    const vector<string>* pMyInputs;
+    if (argument == command.Filename)
+    {
+      hasMainFile = true;
+      pchCommand.CommandLine.push_back(string());
+      continue;
+    }
 
-    bool runInvocation(shared_ptr<CompilerInvocation> inv, FileManager* files, shared_ptr<PCHContainerOperations> pch, DiagnosticConsumer* dgc) override
+    key += '\0' + argument;
+    pchCommand.CommandLine.push_back(argument);
+  }
+  for (const auto& argument : cla)
+    key += '\0' + argument;
+
+  if (!hasMainFile)
+    return "";
+
+  SmallString<256> directory(pchDirectory);
+  llvm::sys::fs::make_absolute(directory);
+  if (llvm::sys::fs::create_directories(directory))
+    return "";
+
+  const bool isC = llvm::sys::path::extension(mainFile) == ".c";
+  const string base = directory.str().str() + llvm::sys::path::get_separator().str() + "prefix-" + llvm::utohexstr(llvm::xxHash64(key));
+  const string header = base + (isC ? ".h" : ".hpp");
+  const string keyName = base + ".key";
+
+  // The precompiled header is rebuilt if a header of it has changed since it was built.
+  string pch = findUpToDatePCH(keyName, key);
+  if (!pch.empty())
+    return pch;
+
+  if (!llvm::sys::fs::exists(header))
+  {
+    SmallString<256> temporaryHeader;
+    llvm::sys::fs::createUniquePath(header + "-%%%%%%%%.tmp", temporaryHeader, false);
     {
-      auto opts = &inv->getDiagnosticOpts();
-      auto dc = CompilerInstance::createDiagnostics(opts, dgc, false);
+      ofstream headerFile(temporaryHeader.str().str(), ofstream::binary);
+      headerFile << resolveQuotedIncludes(prefix, mainDirectory);
+    }
+    if (!publishFile(temporaryHeader.str().str(), header))
+      return "";
+  }
 
-      MyTextDiagnosticPrinter consumer(llvm::errs(), opts);
-      dc->setClient(&consumer);
+  for (auto& argument : pchCommand.CommandLine)
+  {
+    if (argument.empty())
+      argument = header;
+  }
+  pchCommand.Filename = header;
 
-      auto ast = ASTUnit::LoadFromCompilerInvocationAction(std::move(inv), std::move(pch), dc, create().get());
-      if (ast == nullptr)
-        return false;
+  SmallString<256> temporaryPCH;
+  llvm::sys::fs::createUniquePath(base + "-%%%%%%%%.pch.tmp", temporaryPCH, false);
 
-      if (ast->Save(outputFilename))
-        return false;
+  SingleCommandDatabase compilations(pchCommand);
+  ClangTool tool(compilations, vector<string>(1, header), std::make_shared<PCHContainerOperations>(), fileSystem, fileManager);
+  addArgumentAdjusters(tool, cla);
+  tool.appendArgumentsAdjuster(tooling::getClangStripDependencyFileAdjuster());
 
-      if (dc->hasErrorOccurred() ||
-          dc->hasUncompilableErrorOccurred() ||
-          dc->hasFatalErrorOccurred() ||
-          dc->hasUnrecoverableErrorOccurred())
-      {
-        return false;
-      }
+  // The translation unit is parsed without the precompiled header if it cannot be built, so its errors are not reported.
+  IgnoringDiagConsumer ignoringConsumer;
+  tool.setDiagnosticConsumer(&ignoringConsumer);
+
+  const string temporaryComments = temporaryPCH.str().str() + ".comment";
+  PrefixPCHActionFactory factory(temporaryPCH.str().str());
+  if (tool.run(&factory) != 0 || !llvm::sys::fs::exists(temporaryPCH))
+  {
+    llvm::sys::fs::remove(temporaryPCH);
+    llvm::sys::fs::remove(temporaryComments);
+    return "";
+  }
+
+  // The precompiled headers built from different header contents get different names, so the AST files referencing an older one
+  // can still be loaded.
+  const string stamps = getHeaderStamps(factory.getHeaders());
+  if (stamps.empty())
+  {
+    llvm::sys::fs::remove(temporaryPCH);
+    llvm::sys::fs::remove(temporaryComments);
+    return "";
+  }
+  pch = base + "-" + llvm::utohexstr(llvm::xxHash64(stamps)) + ".pch";
 
-      return true;
+  // The comments are published first, the precompiled header is only used if they exist.
+  if (!publishFile(temporaryComments, pch + ".comment"))
+  {
+    llvm::sys::fs::remove(temporaryPCH);
+    return "";
+  }
+  if (!publishFile(temporaryPCH.str().str(), pch))
+    return "";
+
+  // The key file is replaced, the last one written wins.
+  SmallString<256> temporaryKey;
+  llvm::sys::fs::createUniquePath(keyName + "-%%%%%%%%.tmp", temporaryKey, false);
+  {
+    ofstream keyFile(temporaryKey.str().str(), ofstream::binary);
+    keyFile << quoted(key) << '\n' << quoted(pch) << '\n' << stamps;
+  }
+  if (llvm::sys::fs::rename(temporaryKey, keyName))
+    llvm::sys::fs::remove(temporaryKey);
+
+  return pch;
+}
+
+int runTool(const CompilationDatabase& compilations, const string& file, const CommandLineArguments& cla, const string& output, IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem, IntrusiveRefCntPtr<FileManager> fileManager, const string& dependencyName = "")
+{
+  const bool useToolFileSystem = fileManager != nullptr;
+  if (!fileSystem)
+    fileSystem = llvm::vfs::getRealFileSystem();
+
+  if (!pchDirectory.empty())
+  {
+    // The compile commands are looked up by absolute path (as the clang tool does).
+    string absoluteFile = file;
+    if (ErrorOr<string> workingDirectory = fileSystem->getCurrentWorkingDirectory())
+      absoluteFile = getAbsolutePath(*workingDirectory, file);
+
+    vector<CompileCommand> commands = compilations.getCompileCommands(absoluteFile);
+    string pch = commands.empty() ? "" : getPrefixPCH(commands.front(), cla, fileSystem, fileManager);
+    if (!pch.empty())
+    {
+      ClangTool tool(compilations, vector<string>(1, file), std::make_shared<PCHContainerOperations>(), fileSystem, fileManager);
+      addArgumentAdjusters(tool, cla);
+      tool.appendArgumentsAdjuster(tooling::getInsertArgumentAdjuster(CommandLineArguments{ "-include-pch", pch }, tooling::ArgumentInsertPosition::END));
+
+      CANActionFactory factory(output, useToolFileSystem, pch);
+      if (tool.run(&factory) == 0)
+        return 0;
+
+      // E.g. a header of the prefix without include guard cannot be included again.
+      boost::mutex::scoped_lock lock(outputMutex);
+      WriteMsg::write(WriteMsg::mlNormal, "The precompiled header %s cannot be used for %s, it is parsed without it\n", pch.c_str(), file.c_str());
     }
+  }
 
-    unique_ptr<FrontendAction> create() override { return unique_ptr<FrontendAction>(new CANAction()); }
-  } factory;
-  factory.pMyInputs = &files;
+  ClangTool tool(compilations, vector<string>(1, file), std::make_shared<PCHContainerOperations>(), fileSystem, fileManager);
+  addArgumentAdjusters(tool, cla);
+
+  // The headers of a precompiled header are not in the source manager, so the dependencies are listed only without it.
+  CANActionFactory factory(output, useToolFileSystem, "", dependencyName);
 
   // Run the tool.
-  int ret = tool.run(&factory);
+  return tool.run(&factory);
+}
+
+// Parses the translation units of the batch compilation database on a pool of workers.
+int runBatch()
+{
+  string errorMessage;
+  unique_ptr<JSONCompilationDatabase> database = JSONCompilationDatabase::loadFromFile(batchFilename, errorMessage, JSONCommandLineSyntax::AutoDetect);
+  if (!database)
+    throw std::runtime_error(errorMessage);
+
+  vector<CompileCommand> commands = database->getAllCompileCommands();
+
+  // The consecutive jobs of a worker can share its file manager while their directory is the same.
+  stable_sort(commands.begin(), commands.end(), [](const CompileCommand& a, const CompileCommand& b) { return a.Directory < b.Directory; });
+
+  set<string> mainFiles;
+  for (auto& command : commands)
+  {
+    if (command.Output.empty())
+      throw std::runtime_error("missing output in the batch for " + command.Filename);
+
+    // The paths of the entries are relative to their directories.
+    SmallString<256> output(command.Output);
+    llvm::sys::fs::make_absolute(command.Directory, output);
+    command.Output = output.str().str();
+
+    SmallString<256> path(command.Filename);
+    llvm::sys::fs::make_absolute(command.Directory, path);
+    llvm::sys::path::remove_dots(path, false);
+    mainFiles.insert(path.str().str());
+  }
+
+  SharedStatCache cache(std::move(mainFiles));
+  CommandLineArguments cla = getSystemIncludeArguments();
+
+  unsigned threads = batchThreads > 0 ? (unsigned)batchThreads : columbus::thread::ThreadPool::getNumberOfCores();
+  threads = max(1u, min(threads, (unsigned)commands.size()));
+
+  atomic<size_t> nextCommand(0);
+  atomic<unsigned> failed(0);
+  {
+    columbus::thread::ThreadPool pool(threads);
+    vector<columbus::thread::TaskFuture<void>> workers;
+    for (unsigned i = 0; i < threads; ++i)
+    {
+      workers.push_back(pool.submit([&]()
+      {
+        // The file system has its own working directory, the file manager is not thread safe.
+        IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem(new StatCacheFileSystem(cache));
+        IntrusiveRefCntPtr<FileManager> fileManager;
+        string directory;
+
+        for (size_t job = nextCommand++; job < commands.size(); job = nextCommand++)
+        {
+          const CompileCommand& command = commands[job];
+          if (!fileManager || directory != command.Directory)
+          {
+            fileManager = new FileManager(FileSystemOptions(), fileSystem);
+            directory = command.Directory;
+          }
+
+          {
+            boost::mutex::scoped_lock lock(outputMutex);
+            string commandLine;
+            for (const auto& argument : command.CommandLine)
+              commandLine += argument + " ";
+
+            WriteMsg::write(WriteMsg::mlNormal, "%s\n", commandLine.c_str());
+          }
+
+          SingleCommandDatabase compilations(command);
+          if (runTool(compilations, command.Filename, cla, command.Output, fileSystem, fileManager) != 0)
+            ++failed;
+        }
+      }));
+    }
+
+    for (auto& worker : workers)
+      worker.get();
+  }
+
+  WriteMsg::write(WriteMsg::mlNormal, "Batch: %u translation units, %u failed, stat cache %llu hits / %llu misses, file cache %llu hits / %llu misses\n",
+    (unsigned)commands.size(), failed.load(), cache.getStatHits(), cache.getStatMisses(), cache.getReadHits(), cache.getReadMisses());
+
+  return failed > 0 ? 1 : 0;
+}
+
+int run(int argc, const char** argv)
+{
+  WriteMsg::setAutomaticFlush(true);
+
+  // Parse options with the common parser (the batch mode does not need input files).
+  CommonOptionsParser parser(argc, argv, category, cl::ZeroOrMore);
+
+  if (!batchFilename.empty())
+    return runBatch();
+
+  const std::vector<string>& files = parser.getSourcePathList();
+
+  if (files.size() != 1)
+    throw std::runtime_error("program requires exactly one input file");
+
+  if (outputFilename.empty())
+    throw std::runtime_error("program requires an output file (-o)");
+
+  for (const auto& x : parser.getCompilations().getCompileCommands(files.front()))
+  {
+    for (auto y : x.CommandLine)
+      WriteMsg::write(WriteMsg::mlNormal, "%s ", y.c_str());
+
+    WriteMsg::write(WriteMsg::mlNormal, "\n");
+  }
+
+  CommandLineArguments cla = getSystemIncludeArguments();
 
-  return ret;
+  return runTool(parser.getCompilations(), files.front(), cla, outputFilename, nullptr, nullptr, dependencyFilename);
 }
 
 } // anonymous namespace
@@ -31,6 +31,7 @@
 #include <clang/AST/Mangle.h>
 #include <lim/inc/lim.h>
 #include "Linker.h"
+#include "ShardedUIDTable.h"
 #include <boost/filesystem.hpp>
 #include <boost/thread.hpp>
 #include <string>
@@ -101,12 +102,14 @@ public:
     void filterFolders();
 
   // Matches UIDs to LIM nodes.
-  std::unordered_map<std::shared_ptr<clang::metrics::UID>, columbus::lim::asg::base::Base*, UIDHasher, UIDEq> limTable;
+  // The UID tables are sharded, so they can be read without the lock of GlobalASTConversionInfo_ThreadSafe.
+  // They are written only while that lock is held, together with the creation of the LIM node.
+  ShardedUIDMap<std::shared_ptr<clang::metrics::UID>, columbus::lim::asg::base::Base*, UIDHasher, UIDEq> limTable;
 
   // Matches UIDs to LIM Types.
-  std::unordered_map<std::shared_ptr<clang::metrics::UID>, columbus::lim::asg::type::Type*, UIDHasher, UIDEq> typeTable;
+  ShardedUIDMap<std::shared_ptr<clang::metrics::UID>, columbus::lim::asg::type::Type*, UIDHasher, UIDEq> typeTable;
 
-  std::unordered_set<std::shared_ptr<clang::metrics::UID>, UIDHasher, UIDEq> incompleteNodes;
+  ShardedUIDSet<std::shared_ptr<clang::metrics::UID>, UIDHasher, UIDEq> incompleteNodes;
 
   CommentProcessor commentProcessor;
 
@@ -177,15 +180,37 @@ class GlobalASTConversionInfo_ThreadSafe
 {
   GlobalASTConversionInfo& globalASTConversionInfo;
   boost::recursive_mutex globalASTConversionInfoMutex;
+  LockStatistics lockStatistics;
 
 public:
   GlobalASTConversionInfo_ThreadSafe(GlobalASTConversionInfo& globalASTConversionInfo) : globalASTConversionInfo(globalASTConversionInfo) {}
   template <class Operation>
   auto call(Operation o) -> decltype(o(globalASTConversionInfo))
   { 
-    boost::lock_guard<boost::recursive_mutex> lock(globalASTConversionInfoMutex);
+    boost::unique_lock<boost::recursive_mutex> lock(globalASTConversionInfoMutex, boost::defer_lock);
+    lockStatistics.lock(lock);
     return o(globalASTConversionInfo);
   }
+
+  // The lookups below only lock one shard of the UID tables, not the whole GlobalASTConversionInfo.
+  // They are used to find the nodes which are already converted from another AST (e.g. the content of the common headers).
+
+  columbus::lim::asg::base::Base* lookupNode(const std::shared_ptr<clang::metrics::UID>& uid) const
+  {
+    return globalASTConversionInfo.limTable.lookup(uid);
+  }
+
+  columbus::lim::asg::type::Type* lookupType(const std::shared_ptr<clang::metrics::UID>& uid) const
+  {
+    return globalASTConversionInfo.typeTable.lookup(uid);
+  }
+
+  bool isIncomplete(const std::shared_ptr<clang::metrics::UID>& uid) const
+  {
+    return globalASTConversionInfo.incompleteNodes.contains(uid);
+  }
+
+  const LockStatistics& getLockStatistics() const { return lockStatistics; }
 };
 
 class ASTConversionInfo
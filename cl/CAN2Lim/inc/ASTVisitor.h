@@ -129,8 +129,8 @@ class ASTConverterVisitor : public clang::RecursiveASTVisitor<ASTConverterVisito
     columbus::lim::asg::logical::Class * getOrCreateIncompleteNode_Class(const clang::CXXRecordDecl * decl);
     columbus::lim::asg::logical::Scope * getOrCreateIncompleteNode_Scope(const clang::Decl * decl);
 
-    // Creates a new LIM node.
-    template<class T, class U> bool createNode(std::shared_ptr<clang::metrics::UID> uid, U*& out, const clang::Decl* decl);
+    // Creates a new LIM node. If incomplete is true, the node is registered as incomplete, it is completed by a later call without it.
+    template<class T, class U> bool createNode(std::shared_ptr<clang::metrics::UID> uid, U*& out, const clang::Decl* decl, bool incomplete = false);
     
     /// Creates a file node in the LIM
     /// The input filename MUST be in the format given by clangtool FileEntry->getName()
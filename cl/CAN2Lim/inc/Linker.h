@@ -56,11 +56,12 @@ public:
 public:
   GlobalASTConversionInfo &conversionInfo;
 
-  std::vector<std::pair<std::shared_ptr<MergeUID>,columbus::lim::asg::Member*>> unresolved_declarations;
-  std::vector<std::pair<std::shared_ptr<MergeUID>,columbus::lim::asg::base::Base*>> unresolved_calls;
-  std::vector<std::pair<std::shared_ptr<MergeUID>,columbus::lim::asg::logical::Method*>> unresolved_attribute_accesses;
+  // Only the keys (the interned mangled names) of the UIDs are kept, as the linking does not depend on the positions.
+  std::vector<std::pair<MergeUIDKey,columbus::lim::asg::Member*>> unresolved_declarations;
+  std::vector<std::pair<MergeUIDKey,columbus::lim::asg::base::Base*>> unresolved_calls;
+  std::vector<std::pair<MergeUIDKey,columbus::lim::asg::logical::Method*>> unresolved_attribute_accesses;
 
-  std::unordered_multimap<std::shared_ptr<MergeUID>, columbus::lim::asg::Member*, MergeUID::UIDHasher, MergeUID::NoPosUIDEq> UID_to_definitions;
+  std::unordered_multimap<MergeUIDKey, columbus::lim::asg::Member*, MergeUIDKey::Hasher> UID_to_definitions;
 
   struct FilePtrComparator {
     bool operator()(const columbus::lim::asg::physical::File* lhs, const columbus::lim::asg::physical::File* rhs) const{
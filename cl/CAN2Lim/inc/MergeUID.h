@@ -27,7 +27,7 @@
 #include <clang/AST/AST.h>
 #include <clang/AST/Mangle.h>
 
-#include <boost/thread.hpp>
+#include "SymbolTable.h"
 
 #include <string>
 
@@ -37,14 +37,40 @@ namespace clang
   class CompilerInstance;
 }
 
+// The mangled name of a MergeUID as a compact value. The Linker pairs the declarations with the
+// definitions by these, regardless of the positions.
+class MergeUIDKey
+{
+public:
+  explicit MergeUIDKey(const Symbol* mangledName) : mangledName(mangledName) {}
+
+  const std::string& getMangledName() const { return mangledName->text; }
+
+  // The symbols are interned, so equal names have the same symbol.
+  bool operator==(const MergeUIDKey& o) const { return mangledName == o.mangledName; }
+  bool operator!=(const MergeUIDKey& o) const { return !(*this == o); }
+
+  struct Hasher
+  {
+    size_t operator()(const MergeUIDKey& k) const { return Fingerprint::Hasher()(k.mangledName->fingerprint); }
+  };
+
+private:
+  const Symbol* mangledName;
+};
+
+// The names are interned in the SymbolTable of the MergeUIDFactory, so a UID is only a few pointers
+// and numbers, and the UIDs are compared and hashed without touching the (sometimes very long) names.
 class MergeUID : public clang::metrics::UID
 {
 public:
-  MergeUID(const std::string& mangledName, std::string fileName, unsigned lineNumber, unsigned columnNumber, bool isNamespace);
+  MergeUID(const Symbol* mangledName, const Symbol* fileName, unsigned lineNumber, unsigned columnNumber, bool isNamespace);
+
+  const std::string& getMangledName() const { return mangledName->text; }
 
-  const std::string& getMangledName() const { return mangledName; }
+  const std::string& getFilename() const { return fileName->text; }
 
-  const std::string& getFilename() const { return fileName; }
+  MergeUIDKey getKey() const { return MergeUIDKey(mangledName); }
 
   bool noPositionEquals(const MergeUID& o) const
   {
@@ -58,15 +84,13 @@ private:
 
   std::string getName() const override
   {
-    return mangledName;
+    return mangledName->text;
   }
 
 private:
-  const std::string mangledName;
-  mutable std::string fileName;
+  const Symbol* const mangledName;
+  const Symbol* const fileName;
   const unsigned lineNumber, columnNumber;
-  const size_t hashValue;
-  static boost::mutex m;
 
   const bool isNamespace;
 public:
@@ -101,22 +125,6 @@ public:
       return lhs->equals(*rhs);
     }
   };
-
-  // Helper for UID equivalence.
-  struct NoPosUIDEq
-  {
-    typedef std::shared_ptr<const MergeUID> first_argument_type;
-    typedef std::shared_ptr<const MergeUID> second_argument_type;
-    typedef bool result_type;
-
-    result_type operator()(const first_argument_type& lhs, const second_argument_type& rhs) const
-    {
-      if (!lhs || !rhs)
-        return lhs.get() == rhs.get();
-
-      return lhs->noPositionEquals(*rhs);
-    }
-  };
 };
 
 class MergeUIDFactory : public clang::metrics::UIDFactory
@@ -132,7 +140,16 @@ private:
 
 private:
   std::string declToFileName(const clang::Decl* decl, clang::ASTContext& astContext);
+
+  std::unique_ptr<clang::metrics::UID> createUID(const std::string& mangledName, const std::string& fileName, unsigned lineNumber, unsigned columnNumber, bool isNamespace);
+
+public:
+  // The mangled names and the file names of all the UIDs created by this factory.
+  const SymbolTable& getSymbolTable() const { return symbols; }
+
+private:
   std::atomic<size_t> itsMissingIdCounter { 0 };
+  SymbolTable symbols;
 };
 
 
@@ -0,0 +1,203 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _CAN2LIM_SHARDED_UID_TABLE_H
+#define _CAN2LIM_SHARDED_UID_TABLE_H
+
+#include <boost/thread.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+// Counts the acquisitions of a lock. An acquisition is contended if the lock was held by
+// another thread, the time spent waiting for these is summed up as well.
+// The sharded containers count every shard separately, so the counters are not shared between the shards.
+class LockStatistics
+{
+public:
+  LockStatistics() : acquisitions(0), contentions(0), waitNanoseconds(0) {}
+
+  LockStatistics(const LockStatistics& o) : acquisitions(o.getAcquisitions()), contentions(o.getContentions()), waitNanoseconds(o.waitNanoseconds.load(std::memory_order_relaxed)) {}
+
+  // Adds the counts of the other statistics to these ones.
+  void add(const LockStatistics& o)
+  {
+    acquisitions.fetch_add(o.getAcquisitions(), std::memory_order_relaxed);
+    contentions.fetch_add(o.getContentions(), std::memory_order_relaxed);
+    waitNanoseconds.fetch_add(o.waitNanoseconds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  // Locks the given lockable and records the acquisition.
+  template <class Lock>
+  void lock(Lock& lock)
+  {
+    acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (lock.try_lock())
+      return;
+
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    contentions.fetch_add(1, std::memory_order_relaxed);
+    waitNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+  }
+
+  uint64_t getAcquisitions() const { return acquisitions.load(std::memory_order_relaxed); }
+  uint64_t getContentions() const { return contentions.load(std::memory_order_relaxed); }
+  double getWaitTime() const { return waitNanoseconds.load(std::memory_order_relaxed) / 1e9; }
+
+private:
+  std::atomic<uint64_t> acquisitions;
+  std::atomic<uint64_t> contentions;
+  std::atomic<uint64_t> waitNanoseconds;
+};
+
+// An unordered container of UIDs split into shards by the hash of the UID. Every shard has its
+// own reader-writer lock, so lookups of different (or the same) UIDs from different threads
+// do not block each other, only an insertion blocks the readers of its own shard.
+template <class Container>
+class ShardedUIDContainer
+{
+public:
+  typedef typename Container::key_type key_type;
+
+  static const unsigned shardCount = 64;
+
+  bool contains(const key_type& key) const
+  {
+    const Shard& shard = getShard(key);
+    boost::shared_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    return shard.items.count(key) != 0;
+  }
+
+  // Returns the number of erased elements.
+  size_t erase(const key_type& key)
+  {
+    Shard& shard = getShard(key);
+    boost::unique_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    return shard.items.erase(key);
+  }
+
+  // Calls f for every element, shard by shard. The elements must not be inserted or erased by f.
+  template <class Operation>
+  void forEach(Operation f) const
+  {
+    for (const Shard& shard : shards)
+    {
+      boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+      for (const auto& item : shard.items)
+        f(item);
+    }
+  }
+
+  size_t size() const
+  {
+    size_t result = 0;
+    for (const Shard& shard : shards)
+    {
+      boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+      result += shard.items.size();
+    }
+    return result;
+  }
+
+  // The sum of the statistics of the shards.
+  LockStatistics getLockStatistics() const
+  {
+    LockStatistics result;
+    for (const Shard& shard : shards)
+      result.add(shard.statistics);
+    return result;
+  }
+
+protected:
+  struct Shard
+  {
+    mutable boost::shared_mutex mutex;
+    mutable LockStatistics statistics;
+    Container items;
+  };
+
+  Shard& getShard(const key_type& key)
+  {
+    return shards[typename Container::hasher()(key) % shardCount];
+  }
+
+  const Shard& getShard(const key_type& key) const
+  {
+    return shards[typename Container::hasher()(key) % shardCount];
+  }
+
+  std::array<Shard, shardCount> shards;
+};
+
+template <class Key, class Value, class Hash, class Eq>
+class ShardedUIDMap : public ShardedUIDContainer<std::unordered_map<Key, Value, Hash, Eq>>
+{
+public:
+  // Returns the value stored for the key or a value initialized Value (nullptr) if it is not found.
+  Value lookup(const Key& key) const
+  {
+    auto& shard = this->getShard(key);
+    boost::shared_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    auto it = shard.items.find(key);
+    return it != shard.items.end() ? it->second : Value();
+  }
+
+  // Like lookup(), but throws std::out_of_range if the key is not found.
+  Value at(const Key& key) const
+  {
+    auto& shard = this->getShard(key);
+    boost::shared_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    return shard.items.at(key);
+  }
+
+  // Inserts the value if the key is not in the map yet. Returns true if the value is inserted.
+  bool insert(const Key& key, const Value& value)
+  {
+    auto& shard = this->getShard(key);
+    boost::unique_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    return shard.items.emplace(key, value).second;
+  }
+};
+
+template <class Key, class Hash, class Eq>
+class ShardedUIDSet : public ShardedUIDContainer<std::unordered_set<Key, Hash, Eq>>
+{
+public:
+  // Returns true if the key is inserted (it was not in the set yet).
+  bool insert(const Key& key)
+  {
+    auto& shard = this->getShard(key);
+    boost::unique_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    return shard.items.insert(key).second;
+  }
+};
+
+#endif
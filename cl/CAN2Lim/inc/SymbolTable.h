@@ -0,0 +1,119 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _CAN2LIM_SYMBOL_TABLE_H
+#define _CAN2LIM_SYMBOL_TABLE_H
+
+#include "ShardedUIDTable.h"
+#include <boost/thread.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// A 128 bit fingerprint of a string. Equal strings have equal fingerprints, different strings
+// have different ones with an overwhelming probability.
+struct Fingerprint
+{
+  uint64_t low;
+  uint64_t high;
+
+  static Fingerprint of(const std::string& text);
+
+  bool operator==(const Fingerprint& o) const { return low == o.low && high == o.high; }
+  bool operator!=(const Fingerprint& o) const { return !(*this == o); }
+
+  struct Hasher
+  {
+    size_t operator()(const Fingerprint& f) const { return static_cast<size_t>(f.low); }
+  };
+};
+
+// A string stored only once in a SymbolTable.
+struct Symbol
+{
+  Symbol(const Fingerprint& fingerprint, const std::string& text) : fingerprint(fingerprint), text(text) {}
+
+  const Fingerprint fingerprint;
+  const std::string text;
+};
+
+// Interns the mangled names and the file names of the UIDs, so every distinct string is stored
+// once, no matter how many UIDs refer to it. The symbols are never freed before the table, so
+// they are identified by their address: two interned strings are equal if and only if their
+// symbols are the same. The strings themselves are compared only if their fingerprints collide.
+// The table is split into shards by the fingerprint, every shard has its own reader-writer lock.
+class SymbolTable
+{
+public:
+  static const unsigned shardCount = 64;
+
+  SymbolTable() : internedCount(0), residentBytes(0) {}
+
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+
+  // Returns the symbol of the text, the symbol is created if the text is not interned yet.
+  const Symbol* intern(const std::string& text);
+
+  // The number of intern() calls.
+  uint64_t getInternedCount() const { return internedCount.load(std::memory_order_relaxed); }
+
+  // The number of distinct symbols.
+  size_t size() const;
+
+  // The approximate memory the table holds: the symbols, their strings and the hash map entries.
+  // The symbols are never freed before the table, so this is also their part of the peak memory.
+  uint64_t getResidentBytes() const { return residentBytes.load(std::memory_order_relaxed); }
+
+  // The sum of the statistics of the shards.
+  LockStatistics getLockStatistics() const;
+
+private:
+  // Returns the symbol of the text from the given range, or nullptr if it is not there.
+  template <class Iterator>
+  static const Symbol* find(Iterator first, Iterator last, const std::string& text)
+  {
+    for (; first != last; ++first)
+      if (first->second->text == text)
+        return first->second.get();
+    return nullptr;
+  }
+
+  // The approximate size of a symbol together with its string and its entry in the hash map.
+  static uint64_t memorySize(const std::string& text);
+
+  struct Shard
+  {
+    mutable boost::shared_mutex mutex;
+    mutable LockStatistics statistics;
+    // Multimap, as the fingerprints of different strings may (though very unlikely) collide.
+    std::unordered_multimap<Fingerprint, std::unique_ptr<Symbol>, Fingerprint::Hasher> symbols;
+  };
+
+  std::array<Shard, shardCount> shards;
+
+  std::atomic<uint64_t> internedCount;
+  std::atomic<uint64_t> residentBytes;
+};
+
+#endif
@@ -44,7 +44,14 @@
 #define CMSG_CAN2LIM_DUMP_TIME                          WriteMsg::mlNormal, "\tDump limml time              : %10.2fs\n"
 #define CMSG_CAN2LIM_TOTAL_TIME                         WriteMsg::mlNormal, "\tTotal time                   : %10.2fs\n"
 #define CMSG_CAN2LIM_PEAK_MEMORY                        WriteMsg::mlNormal, "\tPeak memory usage            : %10.2fMB\n"
+#define CMSG_CAN2LIM_UID_NAMES                          WriteMsg::mlNormal, "\tDistinct UID names           : %10llu (of %llu)\n"
+#define CMSG_CAN2LIM_UID_NAME_MEMORY                    WriteMsg::mlNormal, "\tUID name table memory        : %10.2fMB\n"
 #define CMSG_CAN2LIM_NOT_EXISTED_FILES                  WriteMsg::mlNormal, "\tNumber of not existed files  : %10d\n"
+#define CMSG_CAN2LIM_GLOBAL_LOCK_ACQUISITIONS           WriteMsg::mlNormal, "\tGlobal lock acquisitions     : %10llu\n"
+#define CMSG_CAN2LIM_GLOBAL_LOCK_CONTENTIONS            WriteMsg::mlNormal, "\tGlobal lock contentions      : %10llu\n"
+#define CMSG_CAN2LIM_GLOBAL_LOCK_WAIT_TIME              WriteMsg::mlNormal, "\tGlobal lock wait time        : %10.2fs\n"
+#define CMSG_CAN2LIM_UID_TABLE_LOCK_ACQUISITIONS        WriteMsg::mlNormal, "\tUID table lock acquisitions  : %10llu\n"
+#define CMSG_CAN2LIM_UID_TABLE_LOCK_CONTENTIONS         WriteMsg::mlNormal, "\tUID table lock contentions   : %10llu\n"
 
 #define CMSG_CAN2LIM_CANT_LOAD_COMPONENT_FILE           WriteMsg::mlError,  "Error: Can not load component file: %s\n"
 #define CMSG_CAN2LIM_DOUBLE_C_VERSION_NODE              WriteMsg::mlDebug,  "Double member node on the same location with 'C' language type: Node1:%d Node2:%d\n"
@@ -62,8 +62,7 @@ struct ComponentComparator
 // This traverses all the folders with a stack.
 void GlobalASTConversionInfo::filterFolders()
 {
-  DirectoryFilter directoryFilter;
-  directoryFilter.openFilterFile(g_filterfile);
+  const DirectoryFilter& directoryFilter = *DirectoryFilter::getSharedFilter(g_filterfile);
 
   columbus::lim::asg::physical::FileSystem *fs = (columbus::lim::asg::physical::FileSystem*)limFactory.getPointer(limFactory.getFileSystemRoot());
 
@@ -152,7 +151,7 @@ void GlobalASTConversionInfo::finalizeConversion()
   
 
 
-  for (auto kv : limTable)
+  limTable.forEach([&](const auto& kv)
   {
     columbus::lim::asg::base::Base* basePtr = kv.second;
     if (columbus::lim::asg::logical::Member *memberPtr = dynamic_cast<columbus::lim::asg::logical::Member *>(basePtr))
@@ -182,7 +181,7 @@ void GlobalASTConversionInfo::finalizeConversion()
         memberPtr->addBelongsTo(component);
 
     }
-  }
+  });
   linker.link_unresolved_declarations();
   linker.link_unresolved_calls();
   linker.link_unresolved_attribute_accesses();
@@ -221,9 +221,9 @@ bool ASTConverterVisitor::VisitVarDecl(const clang::VarDecl* decl)
     ConvertType(type);
 
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-      if (it != globalInfo.typeTable.end())
-        limAttribute->addType(it->second);
+      auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+      if (it)
+        limAttribute->addType(it);
     });
 
   }
@@ -296,9 +296,9 @@ bool ASTConverterVisitor::VisitFieldDecl(const clang::FieldDecl* decl)
     ConvertType(type);
 
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-      if (it != globalInfo.typeTable.end())
-        limAttribute->addType(it->second);
+      auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+      if (it)
+        limAttribute->addType(it);
     });
     
   }
@@ -342,9 +342,9 @@ bool ASTConverterVisitor::VisitEnumConstantDecl(const clang::EnumConstantDecl* d
     ConvertType(type);
 
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-      if (it != globalInfo.typeTable.end())
-        limAttribute->addType(it->second);
+      auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+      if (it)
+        limAttribute->addType(it);
     });
     
   }
@@ -663,9 +663,9 @@ bool ASTConverterVisitor::VisitCXXThrowExpr(const clang::CXXThrowExpr* stmt)
 
     Method* limMethod = getOrCreateIncompleteNode_Method(fd);
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it2 = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-      if (limMethod && it2 != globalInfo.typeTable.end())
-        limMethod->addThrows(it2->second);
+      auto* it2 = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+      if (limMethod && it2)
+        limMethod->addThrows(it2);
     });
     
   }
@@ -750,9 +750,9 @@ bool ASTConverterVisitor::VisitObjCInterfaceDecl(clang::ObjCInterfaceDecl* decl)
     {
       ConvertType(baseType);
       conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-        auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(baseType, 0), conversionInfo.pMyMangleContext));
-        if (it != globalInfo.typeTable.end())
-          limClass->addIsSubclass(it->second);
+        auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(baseType, 0), conversionInfo.pMyMangleContext));
+        if (it)
+          limClass->addIsSubclass(it);
       });
     }
 
@@ -787,10 +787,10 @@ bool ASTConverterVisitor::VisitObjCInterfaceDecl(clang::ObjCInterfaceDecl* decl)
     for (const ObjCProtocolDecl* p : protocols)
     {
       conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-        auto it = globalInfo.limTable.find(conversionInfo.uidFactory.create(p, conversionInfo.pMyMangleContext));
-        if (it != globalInfo.limTable.end())
+        auto* it = globalInfo.limTable.lookup(conversionInfo.uidFactory.create(p, conversionInfo.pMyMangleContext));
+        if (it)
         {
-          Class* protocol = static_cast<Class*>(it->second);
+          Class* protocol = static_cast<Class*>(it);
           protocol->addExtends(limClass);
         }
       });
@@ -881,9 +881,9 @@ bool ASTConverterVisitor::VisitObjCMethodDecl(const clang::ObjCMethodDecl* decl)
   if (limMethod->getReturnsIsEmpty())
   {
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(decl->getReturnType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
-      if (it != globalInfo.typeTable.end())
-        limMethod->addReturns(it->second);
+      auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(decl->getReturnType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
+      if (it)
+        limMethod->addReturns(it);
     });
   }
 
@@ -901,9 +901,9 @@ bool ASTConverterVisitor::VisitObjCMethodDecl(const clang::ObjCMethodDecl* decl)
         Parameter* limParam = globalInfo.limFactory.createParameterNode();
         limParam->setName(param->getNameAsString());
 
-        auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(param->getType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
-        if (it != globalInfo.typeTable.end())
-          limParam->setType(it->second);
+        auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(param->getType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
+        if (it)
+          limParam->setType(it);
         limMethod->addParameter(limParam);
       });
     }
@@ -977,10 +977,10 @@ bool ASTConverterVisitor::VisitObjCProtocolDecl(clang::ObjCProtocolDecl* decl)
       for (const ObjCProtocolDecl* p : protocols)
       {
         conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-          auto it = globalInfo.limTable.find(conversionInfo.uidFactory.create(p, conversionInfo.pMyMangleContext));
-          if (it != globalInfo.limTable.end())
+          auto* it = globalInfo.limTable.lookup(conversionInfo.uidFactory.create(p, conversionInfo.pMyMangleContext));
+          if (it)
           {
-            Class* ancestorProtocol = static_cast<Class*>(it->second);
+            Class* ancestorProtocol = static_cast<Class*>(it);
             globalInfo.limFactory.beginType();
             globalInfo.limFactory.addTypeFormer(globalInfo.limFactory.createTypeFormerType(ancestorProtocol->getId()).getId());
             type::Type& artificialProtocolType = globalInfo.limFactory.endType();
@@ -1107,13 +1107,13 @@ bool ASTConverterVisitor::VisitObjCAtThrowStmt(const clang::ObjCAtThrowStmt* stm
     ConvertType(type);
 
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it1 = globalInfo.limTable.find(conversionInfo.uidFactory.create(decl, conversionInfo.pMyMangleContext));
-      auto it2 = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-      if (it1 != globalInfo.limTable.end() && it2 != globalInfo.typeTable.end())
+      auto* it1 = globalInfo.limTable.lookup(conversionInfo.uidFactory.create(decl, conversionInfo.pMyMangleContext));
+      auto* it2 = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+      if (it1 && it2)
       {
-        if (Method* limMethod = dynamic_cast<Method*>(it1->second))
+        if (Method* limMethod = dynamic_cast<Method*>(it1))
         {
-          limMethod->addThrows(it2->second);
+          limMethod->addThrows(it2);
         }
       }
     });
@@ -1214,9 +1214,9 @@ void ASTConverterVisitor::CXXRecordDeclHelper(const clang::CXXRecordDecl* decl,
       const Type* baseType = base.getType().getTypePtr();
       ConvertType(baseType);
       conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-        auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(baseType, 0), conversionInfo.pMyMangleContext));
-        if (it != globalInfo.typeTable.end())
-          limClass->addIsSubclass(it->second);
+        auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(baseType, 0), conversionInfo.pMyMangleContext));
+        if (it)
+          limClass->addIsSubclass(it);
       });
     }
   }
@@ -1531,9 +1531,9 @@ void ASTConverterVisitor::methodBuildCommon(const clang::FunctionDecl* decl, Met
     }*/
     ConvertType(decl->getReturnType().getTypePtr());
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(decl->getReturnType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
-      if (it != globalInfo.typeTable.end())
-        limMethod->addReturns(it->second);
+      auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(decl->getReturnType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
+      if (it)
+        limMethod->addReturns(it);
     });
 
     /*
@@ -1568,9 +1568,9 @@ void ASTConverterVisitor::methodBuildCommon(const clang::FunctionDecl* decl, Met
       ConvertType(param->getType().getTypePtr());
       usedTypes.insert(param->getType().getTypePtr());
       conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-        auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(param->getType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
-        if (it != globalInfo.typeTable.end())
-          limParam->setType(it->second);
+        auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(param->getType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
+        if (it)
+          limParam->setType(it);
       });
 
       limMethod->addParameter(limParam);
@@ -1741,7 +1741,7 @@ bool ASTConverterVisitor::HandleFunctionCalling(const CallType* callee, const Ca
       {
         shared_ptr<UID> uid = conversionInfo.uidFactory.create(callee, conversionInfo.pMyMangleContext);
         conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-          globalInfo.linker.unresolved_calls.push_back(std::pair<std::shared_ptr<MergeUID>, columbus::lim::asg::base::Base*>(std::static_pointer_cast<MergeUID>(uid), limCaller));
+          globalInfo.linker.unresolved_calls.push_back(std::pair<MergeUIDKey, columbus::lim::asg::base::Base*>(static_cast<MergeUID&>(*uid).getKey(), limCaller));
         }); 
       }
       else if (limCall && !hasCallsAlready(limCaller, limCall->getId()))
@@ -1770,7 +1770,7 @@ bool ASTConverterVisitor::HandleFunctionCalling(const CallType* callee, const Ca
       {
         shared_ptr<UID> calleeUID = conversionInfo.uidFactory.create(callee, conversionInfo.pMyMangleContext);
         conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-          globalInfo.linker.unresolved_calls.push_back(std::pair<std::shared_ptr<MergeUID>, columbus::lim::asg::base::Base*>(std::static_pointer_cast<MergeUID>(calleeUID), limAttribute));
+          globalInfo.linker.unresolved_calls.push_back(std::pair<MergeUIDKey, columbus::lim::asg::base::Base*>(static_cast<MergeUID&>(*calleeUID).getKey(), limAttribute));
         });
       }
       else
@@ -1818,15 +1818,19 @@ bool ASTConverterVisitor::ConvertType(const clang::Type* type)
   if (!uid)
     return true;
 
+  // Most of the types are already converted from another AST, these are found without the global lock.
+  if (conversionInfo.globalInfo.lookupType(uid))
+    return true;
+
   conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-    auto it = globalInfo.typeTable.find(uid);
-    if (it != globalInfo.typeTable.end())
+    auto* it = globalInfo.typeTable.lookup(uid);
+    if (it)
       return;
 
     globalInfo.limFactory.beginType();
     createLIMType(type);
     type::Type& limType = globalInfo.limFactory.endType();
-    globalInfo.typeTable.emplace(uid, &limType);
+    globalInfo.typeTable.insert(uid, &limType);
   });
 
   return true;
@@ -1837,12 +1841,7 @@ T* ASTConverterVisitor::getOrCreateIncompleteNode(const clang::Decl* decl)
 {
   shared_ptr<UID> uid = conversionInfo.uidFactory.create(decl, conversionInfo.pMyMangleContext);
   T* limNode = nullptr;
-  conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-  bool nodeCreated = createNode<T>(uid, limNode, decl);
-
-  if(nodeCreated)
-    globalInfo.incompleteNodes.insert(uid);
-  });
+  createNode<T>(uid, limNode, decl, true);
 
   return limNode;
 }
@@ -1904,23 +1903,33 @@ columbus::lim::asg::logical::Scope * ASTConverterVisitor::getOrCreateIncompleteN
     return nullptr;
 }
 
-template<class T, class U> bool ASTConverterVisitor::createNode(std::shared_ptr<metrics::UID> uid, U*& out, const Decl* decl)
+template<class T, class U> bool ASTConverterVisitor::createNode(std::shared_ptr<metrics::UID> uid, U*& out, const Decl* decl, bool incomplete)
 {
   if(decl && decl->isImplicit())
     return false;
 
+  // The complete nodes are found without the global lock. A new node is published in the limTable
+  // after it is marked as incomplete, so a node which is found here and is not incomplete is complete.
+  if (columbus::lim::asg::base::Base* limNode = conversionInfo.globalInfo.lookupNode(uid))
+  {
+    if (!conversionInfo.globalInfo.isIncomplete(uid))
+    {
+      out = static_cast<T*>(limNode);
+      return false;
+    }
+  }
+
   bool isCreated;
 
   columbus::lim::asg::base::Base* limNode = nullptr;
   conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-    auto it = globalInfo.limTable.find(uid);
-    if (it != globalInfo.limTable.end())
-      limNode = it->second;
+    auto* it = globalInfo.limTable.lookup(uid);
+    if (it)
+      limNode = it;
 
   if (!limNode)
   {
     out = createNodeHelper<T>();
-    globalInfo.limTable.emplace(uid, out);
     
     if (decl)
     {
@@ -2037,6 +2046,11 @@ template<class T, class U> bool ASTConverterVisitor::createNode(std::shared_ptr<
           globalInfo.linker.add_declaration(out, uid);
       }
     }
+
+    // The node is published only when it is fully set up (see the lookup at the beginning)
+    if (incomplete)
+      globalInfo.incompleteNodes.insert(uid);
+    globalInfo.limTable.insert(uid, out);
     isCreated = true;
   }
   else
@@ -2047,7 +2061,9 @@ template<class T, class U> bool ASTConverterVisitor::createNode(std::shared_ptr<
     if (globalInfo.incompleteNodes.erase(uid) > 0)
     {
       // The node is already in the LIM table, but it's incomplete. In such case we return true, so that the rest of the build finishes.
-      // We also delete it, as it will be soon completed
+      // We also delete it, as it will be soon completed, unless it is requested as an incomplete node again
+      if (incomplete)
+        globalInfo.incompleteNodes.insert(uid);
       isCreated = true;
     }
     else
@@ -2205,8 +2221,7 @@ columbus::lim::asg::GenericParameter* ASTConverterVisitor::createGenericParamete
     // Register in LIM table.
     shared_ptr<UID> uid = conversionInfo.uidFactory.create(param, conversionInfo.pMyMangleContext);
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      if (globalInfo.limTable.find(uid) == globalInfo.limTable.end())
-        globalInfo.limTable.emplace(uid, limParam);
+      globalInfo.limTable.insert(uid, limParam);
     });
     
   }
@@ -2309,10 +2324,10 @@ void ASTConverterVisitor::createLIMType(const clang::Type* type)
     // TemplateSpecializationType is not necessary a class template,
     // as it can also be a template template parameter or alias template.
     columbus::NodeId id = 0;
-    auto it = globalInfo.limTable.find(conversionInfo.uidFactory.createTypeId(QualType(specificType, 0), conversionInfo.pMyMangleContext));
-    if (it != globalInfo.limTable.end())
+    auto* it = globalInfo.limTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(specificType, 0), conversionInfo.pMyMangleContext));
+    if (it)
     {
-      id = it->second->getId();
+      id = it->getId();
     }
     else if (const CXXRecordDecl* ptr = specificType->getAsCXXRecordDecl())
     {
@@ -2376,10 +2391,10 @@ void ASTConverterVisitor::createLIMType(const clang::Type* type)
     if (const TemplateTypeParmDecl* decl = specificType->getDecl())
     {
       //This is not eliminated... no reason
-      auto it = globalInfo.limTable.find(conversionInfo.uidFactory.create(decl, conversionInfo.pMyMangleContext));
-      if (it != globalInfo.limTable.end())
+      auto* it = globalInfo.limTable.lookup(conversionInfo.uidFactory.create(decl, conversionInfo.pMyMangleContext));
+      if (it)
       {
-        type::TypeFormer& tf = limFactory.createTypeFormerType(it->second->getId());
+        type::TypeFormer& tf = limFactory.createTypeFormerType(it->getId());
         limFactory.addTypeFormer(tf.getId());
       }
     }
@@ -2393,10 +2408,10 @@ void ASTConverterVisitor::createLIMType(const clang::Type* type)
     ConvertType(specificType->getReturnType().getTypePtr());
 
     limFactory.beginTypeFormerMethod();
-    auto it = typeTable.find(uidFactory.createTypeId(QualType(specificType->getReturnType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
-    if (it != typeTable.end())
+    auto* it = typeTable.lookup(uidFactory.createTypeId(QualType(specificType->getReturnType().getTypePtr(), 0), conversionInfo.pMyMangleContext));
+    if (it)
     {
-      base::Base* limRetType = it->second;
+      base::Base* limRetType = it;
       limFactory.setTypeFormerMethodHasReturnType(limRetType->getId());
     }
 
@@ -2406,10 +2421,10 @@ void ASTConverterVisitor::createLIMType(const clang::Type* type)
       for (auto pt : specificType->getParamTypes())
       {
         ConvertType(pt.getTypePtr());
-        auto it = typeTable.find(uidFactory.createTypeId(QualType(pt.getTypePtr(), 0), conversionInfo.pMyMangleContext));
-        if (it != typeTable.end())
+        auto* it = typeTable.lookup(uidFactory.createTypeId(QualType(pt.getTypePtr(), 0), conversionInfo.pMyMangleContext));
+        if (it)
         {
-          base::Base* limParamType = it->second;
+          base::Base* limParamType = it;
           if (pt.getTypePtr()->isPointerType() || pt.getTypePtr()->isReferenceType())
             limFactory.addTypeFormerMethodHasParameterType(limParamType->getId(), ParameterKind::pmkInOut);
           else
@@ -2531,7 +2546,7 @@ void ASTConverterVisitor::handleAttributeAccess(const clang::ValueDecl* decl, co
       if (!isDefinition(vd))
       {
         conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-          globalInfo.linker.unresolved_attribute_accesses.push_back(std::pair<std::shared_ptr<MergeUID>, columbus::lim::asg::logical::Method*>(std::static_pointer_cast<MergeUID>(declUID), limMethod));
+          globalInfo.linker.unresolved_attribute_accesses.push_back(std::pair<MergeUIDKey, columbus::lim::asg::logical::Method*>(static_cast<MergeUID&>(*declUID).getKey(), limMethod));
         });
         return;
       }
@@ -2948,15 +2963,15 @@ void ASTConverterVisitor::addUsesEdgeForType(columbus::lim::asg::logical::Member
   //cout << conversionInfo.uidFactory.createTypeId(QualType(type, 0)) << endl;
   ConvertType(type);
   conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-  auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-  if (it != globalInfo.typeTable.end())
+  auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+  if (it)
   {
-    //cout << it->second->getId() << endl;
+    //cout << it->getId() << endl;
     bool found = false;
     // Ensure that it's not added
     for (auto it2 = to->getUsesListIteratorBegin(); it2 != to->getUsesListIteratorEnd(); ++it2)
     {
-      if (it2->getId() == it->second->getId())
+      if (it2->getId() == it->getId())
       {
         found = true;
         break;
@@ -2968,7 +2983,7 @@ void ASTConverterVisitor::addUsesEdgeForType(columbus::lim::asg::logical::Member
       // Ensure that it's not added already as instantiation
       for (auto mit = m->getInstantiatesListIteratorBegin(); mit != m->getInstantiatesListIteratorEnd(); ++mit)
       {
-        if (mit->getId() == it->second->getId())
+        if (mit->getId() == it->getId())
         {
           found = true;
           break;
@@ -2977,7 +2992,7 @@ void ASTConverterVisitor::addUsesEdgeForType(columbus::lim::asg::logical::Member
       // Ensure that it's not added already as return value
       for (auto mit = m->getReturnsListIteratorBegin(); mit != m->getReturnsListIteratorEnd(); ++mit)
       {
-        if (mit->getId() == it->second->getId())
+        if (mit->getId() == it->getId())
         {
           found = true;
           break;
@@ -2986,7 +3001,7 @@ void ASTConverterVisitor::addUsesEdgeForType(columbus::lim::asg::logical::Member
       // Ensure that it's not added already as parameter
       for (auto mit = m->getParameterListIteratorBegin(); mit != m->getParameterListIteratorEnd(); ++mit)
       {
-        if (mit->getType() && mit->getType()->getId() == it->second->getId())
+        if (mit->getType() && mit->getType()->getId() == it->getId())
         {
           found = true;
           break;
@@ -2998,7 +3013,7 @@ void ASTConverterVisitor::addUsesEdgeForType(columbus::lim::asg::logical::Member
       // Ensure that it's not added already as hasType
       for (auto ait = a->getTypeListIteratorBegin(); ait != a->getTypeListIteratorEnd(); ++ait)
       {
-        if (ait->getId() == it->second->getId())
+        if (ait->getId() == it->getId())
         {
           found = true;
           break;
@@ -3007,7 +3022,7 @@ void ASTConverterVisitor::addUsesEdgeForType(columbus::lim::asg::logical::Member
     }
     if (!found)
     {
-      to->addUses(it->second);
+      to->addUses(it);
     }
   }
   });
@@ -3022,9 +3037,9 @@ bool ASTConverterVisitor::addInstantiatesEdge(const clang::FunctionDecl* f, cons
   ConvertType(type);
   columbus::lim::asg::type::Type* t = nullptr;
   conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-    auto rit = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-    if (!(rit == globalInfo.typeTable.end()))
-      t = rit->second;
+    auto* rit = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+    if (rit)
+      t = rit;
   });
 
   if (!t)
@@ -3115,9 +3130,9 @@ void ASTConverterVisitor::addTemplateArgumentEdge(const clang::TemplateArgument&
   {
     ConvertType(type);
     conversionInfo.globalInfo.call([&](GlobalASTConversionInfo& globalInfo) {
-      auto it = globalInfo.typeTable.find(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
-      if (it != (globalInfo.typeTable.end()))
-        limTo->addArguments(it->second, tackNone);
+      auto* it = globalInfo.typeTable.lookup(conversionInfo.uidFactory.createTypeId(QualType(type, 0), conversionInfo.pMyMangleContext));
+      if (it)
+        limTo->addArguments(it, tackNone);
     });
   }
 }
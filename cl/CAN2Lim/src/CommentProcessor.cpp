@@ -21,12 +21,10 @@
 #include "../inc/CommentProcessor.h"
 #include "../inc/ASTConversionInfo.h"
 
-#include <common/inc/DirectoryFilter.h>
 #include <common/inc/WriteMessage.h>
 
 #include <iomanip>
 
-extern std::string g_filterfile;
 using namespace std;
 using namespace common;
 
@@ -36,8 +34,6 @@ CommentProcessor::CommentProcessor(GlobalASTConversionInfo& conversionInfo) : co
 
 void CommentProcessor::loadCommentStructure(const std::string& astFile)
 {
-  DirectoryFilter directoryFilter;
-  directoryFilter.openFilterFile(g_filterfile);
   std::string renamedASTFile = cANFilePathRenamer.changeToLIMCompatible(common::pathCanonicalize(astFile));
   std::ifstream file(renamedASTFile + ".comment");
 
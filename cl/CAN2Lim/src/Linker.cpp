@@ -31,19 +31,19 @@ using namespace columbus::lim::asg;
 
 void Linker::add_definition(Member * limNode, std::shared_ptr<clang::metrics::UID> uid)
 {
-  UID_to_definitions.emplace(std::static_pointer_cast<MergeUID>(uid), limNode);
+  UID_to_definitions.emplace(static_cast<MergeUID&>(*uid).getKey(), limNode);
 }
 
 void Linker::add_declaration(Member * limNode, std::shared_ptr<clang::metrics::UID> uid)
 {
-  unresolved_declarations.push_back(std::pair<std::shared_ptr<MergeUID>,columbus::lim::asg::Member*>(std::static_pointer_cast<MergeUID>(uid), limNode));
+  unresolved_declarations.push_back(std::pair<MergeUIDKey,columbus::lim::asg::Member*>(static_cast<MergeUID&>(*uid).getKey(), limNode));
 }
 
 /*void Linker::handle_decl(const Decl * decl, std::shared_ptr<clang::metrics::UID> uid, Member * limNode)
 {
   if (isDefinition(decl))
   {
-    UID_to_definitions.emplace(std::static_pointer_cast<MergeUID>(uid), limNode);
+    UID_to_definitions.emplace(static_cast<MergeUID&>(*uid).getKey(), limNode);
   }
   else
   {
@@ -59,12 +59,12 @@ void Linker::add_declaration(Member * limNode, std::shared_ptr<clang::metrics::U
       }
       else
       {
-        conversionInfo.linker.unresolved_declarations.push_back(std::pair<std::shared_ptr<MergeUID>,columbus::lim::asg::Member*>(std::static_pointer_cast<MergeUID>(uid), limNode));
+        conversionInfo.linker.unresolved_declarations.push_back(std::pair<MergeUIDKey,columbus::lim::asg::Member*>(static_cast<MergeUID&>(*uid).getKey(), limNode));
       }
     }
     else
     {
-      conversionInfo.linker.unresolved_declarations.push_back(std::pair<std::shared_ptr<MergeUID>,columbus::lim::asg::Member*>(std::static_pointer_cast<MergeUID>(uid), limNode));
+      conversionInfo.linker.unresolved_declarations.push_back(std::pair<MergeUIDKey,columbus::lim::asg::Member*>(static_cast<MergeUID&>(*uid).getKey(), limNode));
     }
   }
 }*/
@@ -81,7 +81,7 @@ bool Linker::link_unresolved_declarations()
     {
       //if there is no definition for the declaration UID then we have to go no further, just skip this and go for next
       if(LINKER_DEBUG)
-        cout << "Definition not found for " << decl_kv.first->getMangledName() << endl; 
+        cout << "Definition not found for " << decl_kv.first.getMangledName() << endl; 
       continue;
     }
 
@@ -106,14 +106,14 @@ bool Linker::link_unresolved_declarations()
           decl_kv.second->setDeclares(def_it->second); //TODO: modify this line accordingly, if the LIM schema is ready for it (and turn off SIMPLIFIED_LINKING)
           foundDefinitionForDeclaration = true;
           if(LINKER_DEBUG)
-            cout << "Linked declaration " << decl_kv.first->getMangledName() << " in component " << decl_component->getName() << " to definition "<< def_it->first->getMangledName() <<" in file " << file->getName() << endl;
+            cout << "Linked declaration " << decl_kv.first.getMangledName() << " in component " << decl_component->getName() << " to definition "<< def_it->first.getMangledName() <<" in file " << file->getName() << endl;
           break; //a declaration can only be linked to one file per component(if there are no multiple definitions, in which case, it shouldn't even build...)
         }
       }
     }
     if(LINKER_DEBUG && !foundDefinitionForDeclaration)
       //in this case there IS a definition for the declaration just not in the same compononent so we cannot link them
-      cout << "Definition not found for " << decl_kv.first->getMangledName() << endl; 
+      cout << "Definition not found for " << decl_kv.first.getMangledName() << endl; 
   }
 
   return true;
@@ -140,7 +140,7 @@ bool Linker::link_unresolved_calls()
     {
       //if there is no definition for the call UID then we have to go no further, just skip this and go for next
       if(LINKER_DEBUG)
-        cout << "Definition not found for " << call_kv.first->getMangledName() << endl; 
+        cout << "Definition not found for " << call_kv.first.getMangledName() << endl; 
       continue;
     }
 
@@ -167,7 +167,7 @@ bool Linker::link_unresolved_calls()
     }
 
     if(LINKER_DEBUG && !foundDefinitionForCall)
-      cout << "Definition not found for " << call_kv.first->getMangledName() << endl; 
+      cout << "Definition not found for " << call_kv.first.getMangledName() << endl; 
 
   }
   return true;
@@ -182,7 +182,7 @@ bool Linker::link_unresolved_attribute_accesses()
     {
       //if there is no definition for the call UID then we have to go no further, just skip this and go for next
       if(LINKER_DEBUG)
-        cout << "Definition not found for " << access_kv.first->getMangledName() << endl; 
+        cout << "Definition not found for " << access_kv.first.getMangledName() << endl; 
       continue;
     }
 
@@ -201,7 +201,7 @@ bool Linker::link_unresolved_attribute_accesses()
     }
 
     if(LINKER_DEBUG && !foundDefinitionForCall)
-      cout << "Definition not found for " << access_kv.first->getMangledName() << endl; 
+      cout << "Definition not found for " << access_kv.first.getMangledName() << endl; 
 
   }
   return true;
@@ -233,12 +233,12 @@ void Linker::print_debug_overview()
     cout << "Unresolved declarations:" << endl;
     for (auto p : unresolved_declarations)
     {
-      cout << "UID: " << p.first->getMangledName() << " , declarationName: " << p.second->getName() << endl;
+      cout << "UID: " << p.first.getMangledName() << " , declarationName: " << p.second->getName() << endl;
     }
     cout << "Definitions:" << endl;
     for (auto p : UID_to_definitions)
     {
-      cout << "UID: " << p.first->getMangledName() << " , definitionName: " << p.second->getName() << endl;
+      cout << "UID: " << p.first.getMangledName() << " , definitionName: " << p.second->getName() << endl;
     }
   }
 }
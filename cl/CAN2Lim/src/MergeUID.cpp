@@ -34,18 +34,15 @@
 using namespace std;
 using namespace clang;
 
-boost::mutex MergeUID::m;
 extern CANFilePathRenamer cANFilePathRenamer;
 
-MergeUID::MergeUID(const string& mangledName, std::string fileName, unsigned lineNumber, unsigned columnNumber, bool isNamespace)
+MergeUID::MergeUID(const Symbol* mangledName, const Symbol* fileName, unsigned lineNumber, unsigned columnNumber, bool isNamespace)
   : mangledName (mangledName)
-  , fileName(common::pathCanonicalize(fileName))
+  , fileName(fileName)
   , lineNumber(lineNumber)
   , columnNumber(columnNumber)
-  , hashValue (std::hash<string>()(mangledName /*+ (isNamespace ? "" : "|" + common::pathCanonicalize(fileName))*/))
   , isNamespace(isNamespace)
 {
-  // TODO: More sophisticated solution to combine hash values.
 }
 
 bool MergeUID::equals(const metrics::UID& rhs) const
@@ -66,7 +63,12 @@ bool MergeUID::equals(const metrics::UID& rhs) const
 
 size_t MergeUID::hash() const
 {
-  return hashValue;
+  return Fingerprint::Hasher()(mangledName->fingerprint);
+}
+
+unique_ptr<metrics::UID> MergeUIDFactory::createUID(const string& mangledName, const string& fileName, unsigned lineNumber, unsigned columnNumber, bool isNamespace)
+{
+  return make_unique<MergeUID>(symbols.intern(mangledName), symbols.intern(common::pathCanonicalize(fileName)), lineNumber, columnNumber, isNamespace);
 }
 
 void MergeUIDFactory::declContextName(SourceManager& sm, llvm::raw_string_ostream& ss, const DeclContext* parent)
@@ -210,7 +212,7 @@ void MergeUIDFactory::mangleTypeName(const Type* type, llvm::raw_string_ostream&
 unique_ptr<metrics::UID> MergeUIDFactory::create(const clang::Decl* decl, shared_ptr<clang::MangleContext> mangleContext)
 {
   if (!decl)
-    return make_unique<MergeUID>("<missing id " + std::to_string(itsMissingIdCounter++) + ">", declToFileName(decl, mangleContext->getASTContext()), 0, 0, false);
+    return createUID("<missing id " + std::to_string(itsMissingIdCounter++) + ">", declToFileName(decl, mangleContext->getASTContext()), 0, 0, false);
 
   ASTContext& astContext = mangleContext->getASTContext();
   SourceManager& sm = astContext.getSourceManager();
@@ -272,7 +274,7 @@ unique_ptr<metrics::UID> MergeUIDFactory::create(const clang::Decl* decl, shared
     if (type)
     {
       mangleTypeName(type, ss, mangleContext);
-      return make_unique<MergeUID>(ss.str(), declToFileName(decl, mangleContext->getASTContext()), ln, cn, false);
+      return createUID(ss.str(), declToFileName(decl, mangleContext->getASTContext()), ln, cn, false);
     }
   }
 
@@ -426,7 +428,7 @@ unique_ptr<metrics::UID> MergeUIDFactory::create(const clang::Decl* decl, shared
     ss << "<missing id " << (itsMissingIdCounter++) << ">";
   }
 
-  return make_unique<MergeUID>(ss.str(), fileName, ln, cn, isNamespaceDecl);
+  return createUID(ss.str(), fileName, ln, cn, isNamespaceDecl);
 }
 
 std::unique_ptr<clang::metrics::UID> MergeUIDFactory::createTypeId(const clang::QualType type, shared_ptr<MangleContext> mangleContext)
@@ -434,7 +436,7 @@ std::unique_ptr<clang::metrics::UID> MergeUIDFactory::createTypeId(const clang::
   string mangledName;
   llvm::raw_string_ostream ss(mangledName);
   mangleTypeName(type.getTypePtrOrNull(), ss, mangleContext);
-  return make_unique<MergeUID>(ss.str(), declToFileName(nullptr, mangleContext->getASTContext()), 0, 0, false);
+  return createUID(ss.str(), declToFileName(nullptr, mangleContext->getASTContext()), 0, 0, false);
 }
 
 std::string MergeUIDFactory::declToFileName(const clang::Decl* decl, ASTContext& astContext)
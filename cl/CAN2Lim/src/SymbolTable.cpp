@@ -0,0 +1,172 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/SymbolTable.h"
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+  inline uint64_t rotl64(uint64_t x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  inline uint64_t fmix64(uint64_t k)
+  {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+  }
+
+  inline uint64_t readBlock(const uint8_t* p)
+  {
+    uint64_t block;
+    memcpy(&block, p, sizeof(block));
+    return block;
+  }
+}
+
+// MurmurHash3_x64_128 (by Austin Appleby, public domain).
+Fingerprint Fingerprint::of(const string& text)
+{
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+  const size_t length = text.size();
+  const size_t blockCount = length / 16;
+  const uint64_t c1 = 0x87c37b91114253d5ULL;
+  const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+  uint64_t h1 = 0;
+  uint64_t h2 = 0;
+
+  for (size_t i = 0; i < blockCount; ++i)
+  {
+    uint64_t k1 = readBlock(data + i * 16);
+    uint64_t k2 = readBlock(data + i * 16 + 8);
+
+    k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+    h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  const uint8_t* tail = data + blockCount * 16;
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+
+  switch (length & 15)
+  {
+    case 15: k2 ^= uint64_t(tail[14]) << 48; // fall through
+    case 14: k2 ^= uint64_t(tail[13]) << 40; // fall through
+    case 13: k2 ^= uint64_t(tail[12]) << 32; // fall through
+    case 12: k2 ^= uint64_t(tail[11]) << 24; // fall through
+    case 11: k2 ^= uint64_t(tail[10]) << 16; // fall through
+    case 10: k2 ^= uint64_t(tail[ 9]) << 8;  // fall through
+    case  9: k2 ^= uint64_t(tail[ 8]) << 0;
+             k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+             // fall through
+    case  8: k1 ^= uint64_t(tail[ 7]) << 56; // fall through
+    case  7: k1 ^= uint64_t(tail[ 6]) << 48; // fall through
+    case  6: k1 ^= uint64_t(tail[ 5]) << 40; // fall through
+    case  5: k1 ^= uint64_t(tail[ 4]) << 32; // fall through
+    case  4: k1 ^= uint64_t(tail[ 3]) << 24; // fall through
+    case  3: k1 ^= uint64_t(tail[ 2]) << 16; // fall through
+    case  2: k1 ^= uint64_t(tail[ 1]) << 8;  // fall through
+    case  1: k1 ^= uint64_t(tail[ 0]) << 0;
+             k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+  }
+
+  h1 ^= length;
+  h2 ^= length;
+
+  h1 += h2;
+  h2 += h1;
+
+  h1 = fmix64(h1);
+  h2 = fmix64(h2);
+
+  h1 += h2;
+  h2 += h1;
+
+  return Fingerprint { h1, h2 };
+}
+
+uint64_t SymbolTable::memorySize(const string& text)
+{
+  // The short strings are stored inside the string object itself (15 characters in libstdc++ and MSVC).
+  const uint64_t symbolSize = sizeof(Symbol) + (text.size() > 15 ? text.size() + 1 : 0);
+  // A node of the multimap holds the key, the pointer, the next pointer and the cached hash, and it takes a bucket.
+  const uint64_t entrySize = sizeof(Fingerprint) + sizeof(unique_ptr<Symbol>) + 2 * sizeof(void*) + sizeof(size_t);
+  return symbolSize + entrySize;
+}
+
+const Symbol* SymbolTable::intern(const string& text)
+{
+  internedCount.fetch_add(1, memory_order_relaxed);
+
+  const Fingerprint fingerprint = Fingerprint::of(text);
+  Shard& shard = shards[fingerprint.high % shardCount];
+
+  {
+    boost::shared_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+    shard.statistics.lock(lock);
+    auto range = shard.symbols.equal_range(fingerprint);
+    if (const Symbol* symbol = find(range.first, range.second, text))
+      return symbol;
+  }
+
+  boost::unique_lock<boost::shared_mutex> lock(shard.mutex, boost::defer_lock);
+  shard.statistics.lock(lock);
+
+  // Another thread may have interned the same text in the meantime.
+  auto range = shard.symbols.equal_range(fingerprint);
+  if (const Symbol* symbol = find(range.first, range.second, text))
+    return symbol;
+
+  unique_ptr<Symbol> symbol = make_unique<Symbol>(fingerprint, text);
+  const Symbol* result = symbol.get();
+  shard.symbols.emplace(fingerprint, move(symbol));
+  residentBytes.fetch_add(memorySize(text), memory_order_relaxed);
+  return result;
+}
+
+size_t SymbolTable::size() const
+{
+  size_t result = 0;
+  for (const Shard& shard : shards)
+  {
+    boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+    result += shard.symbols.size();
+  }
+  return result;
+}
+
+LockStatistics SymbolTable::getLockStatistics() const
+{
+  LockStatistics result;
+  for (const Shard& shard : shards)
+    result.add(shard.statistics);
+  return result;
+}
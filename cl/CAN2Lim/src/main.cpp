@@ -48,6 +48,7 @@
 #include <limits>
 #include <set>
 #include <iomanip>
+#include <atomic>
 
 #define PROGRAM_NAME "CAN2Lim"
 #define EXECUTABLE_NAME PROGRAM_NAME
@@ -71,6 +72,7 @@ string changePathFrom;
 string changePathTo;
 string g_filterfile;
 int maxThreads = 0;
+static bool mappedLim = false;
 
 static list<string> inputFiles;
 
@@ -113,6 +115,11 @@ static bool ppMaxThreads(const Option* o, char* argv[]) {
   return true;
 }
 
+static bool ppMappedLim(const Option* o, char* argv[]) {
+  mappedLim = true;
+  return true;
+}
+
 const common::Option OPTIONS_OBJ [] = {
   { false,  "-ilist",        1, "listfile",        0, common::OT_WC,             ppList,           NULL,       "List file containing input filenames" },
   { false,  "-out",          1, "outputfile",      0, common::OT_WC,             ppOut,            NULL,       "Output file" },
@@ -120,6 +127,7 @@ const common::Option OPTIONS_OBJ [] = {
   { false,  "-dLIMML",       0, "",                0, common::OT_NONE,           ppLimDump,        NULL,       "Create LIMML dump" },
   { false,  "-dGRAPHML",     0, "",                0, common::OT_WC,             dumpGRAPHML,      NULL,       "Dump graphml to lim" },
   { false,  "-maxThreads",   1, CL_KIND_NUMBER,    0, OT_WE | OT_WC,             ppMaxThreads,     NULL,       "This parameter sets the maximum number of threads the Can2Lim can start. The default value is the number of available CPU cores on the current system."},
+  { false,  "-mappedLim",    0, "",                0, common::OT_NONE,           ppMappedLim,      NULL,       "Save the LIM in the memory mappable layout, which the tools can load lazily."},
   CL_FLTP
   COMMON_CL_ARGS
 };
@@ -170,11 +178,11 @@ class MetricsWorker : public columbus::thread::Task
 {
 public:
   MetricsWorker(clang::metrics::Invocation& metricsInvocation, const tooling::FixedCompilationDatabase& compilationDatabase
-    , queue<string>& compilationUnitNames, boost::shared_mutex& taskLockSharedMutex)
+    , const vector<string>& compilationUnitNames, atomic<size_t>& nextCompilationUnit)
     : metricsInvocation(metricsInvocation)
     , compilationDatabase(compilationDatabase)
     , compilationUnitNames(compilationUnitNames)
-    , taskLockSharedMutex(taskLockSharedMutex)
+    , nextCompilationUnit(nextCompilationUnit)
   {
   }
 
@@ -183,15 +191,11 @@ public:
     // Breaks when there is no more work to do (When compilationUnitNames is empty)
     while (true)
     {
-      vector<string> compilationsUnitsForCurrentThread;
-      {
-        // Take the name of the next compilation unit to process
-        columbus::thread::ThreadPool::TaskLock lock(taskLockSharedMutex);
-        if (compilationUnitNames.empty())
-          break;
-        compilationsUnitsForCurrentThread.push_back(compilationUnitNames.front());
-        compilationUnitNames.pop();
-      }
+      // Take the name of the next compilation unit to process
+      size_t index = nextCompilationUnit.fetch_add(1);
+      if (index >= compilationUnitNames.size())
+        break;
+      vector<string> compilationsUnitsForCurrentThread{ compilationUnitNames[index] };
       // Invoke clang-metrics with the given compilation unit name
       metricsInvocation.invoke(compilationDatabase, compilationsUnitsForCurrentThread);
     }
@@ -201,17 +205,18 @@ public:
 private:
   clang::metrics::Invocation& metricsInvocation;
   const tooling::FixedCompilationDatabase& compilationDatabase;
-  queue<string>& compilationUnitNames;
-  boost::shared_mutex& taskLockSharedMutex;
+  const vector<string>& compilationUnitNames;
+  atomic<size_t>& nextCompilationUnit;
 };
 
 // The threadPool calls the () operator of this class
 class CAN2LimWorker : public columbus::thread::Task
 {
 public:
-  CAN2LimWorker(queue<string>& compilationUnitNames, const tooling::FixedCompilationDatabase& compilationDatabase, GlobalASTConversionInfo_ThreadSafe& globalConversionInfo, MergeUIDFactory& uidFactory, uint64_t& mem, boost::shared_mutex& taskLockSharedMutex)
+  CAN2LimWorker(const vector<string>& compilationUnitNames, atomic<size_t>& nextCompilationUnit, const tooling::FixedCompilationDatabase& compilationDatabase, GlobalASTConversionInfo_ThreadSafe& globalConversionInfo, MergeUIDFactory& uidFactory, uint64_t& mem, boost::shared_mutex& taskLockSharedMutex)
     : uidFactory(uidFactory)
     , compilationUnitNames(compilationUnitNames)
+    , nextCompilationUnit(nextCompilationUnit)
     , compilationDatabase(compilationDatabase)
     , globalConversionInfo(globalConversionInfo)
     , mem(mem)
@@ -223,15 +228,11 @@ public:
     // Breaks when there is no more work to do (When compilationUnitNames is empty)
     while (true)
     {
-      string compilationUnitName;
-      {
-        // Take the name of the next compilation unit to process
-        columbus::thread::ThreadPool::TaskLock lock(taskLockSharedMutex);
-        if (compilationUnitNames.empty())
-          break;
-        compilationUnitName = compilationUnitNames.front();
-        compilationUnitNames.pop();
-      }
+      // Take the name of the next compilation unit to process
+      size_t index = nextCompilationUnit.fetch_add(1);
+      if (index >= compilationUnitNames.size())
+        break;
+      const string& compilationUnitName = compilationUnitNames[index];
       // Setup clang tool
       ASTConversionInfo conversionInfo(compilationUnitName.c_str(), compilationUnitName, globalConversionInfo, uidFactory);
       tooling::ClangTool tool(compilationDatabase, { compilationUnitName });
@@ -252,7 +253,8 @@ public:
 
 private:
   MergeUIDFactory& uidFactory;
-  queue<string>& compilationUnitNames;
+  const vector<string>& compilationUnitNames;
+  atomic<size_t>& nextCompilationUnit;
   const tooling::FixedCompilationDatabase& compilationDatabase;
   GlobalASTConversionInfo_ThreadSafe& globalConversionInfo;
   uint64_t& mem;
@@ -394,19 +396,18 @@ int main(int argc, char *argv[]) {
 
     // Create Invocation object that stores data across multiple invocation calls
     clang::metrics::Invocation metricsInvocation(std::move(metricsOutput), clang::metrics::InvokeOptions{ clangMetricsHalsteadDebug,clangMetricsRangeDebug,clangMetricsProcessingTraceDebug });
+    // The workers of the pool are persistent, so the same pool is reused for every component
+    columbus::thread::ThreadPool metricsThreadPool(maxThreads);
     // Analyze only one component at a time
     for (auto it = compilationUnitsByComponent.begin(); it != compilationUnitsByComponent.end(); it++)
     {
-      columbus::thread::ThreadPool threadPool(maxThreads);
-      queue<string> compilationUnitNames;
-
-      // Setup a queue that will be accessed by all threads, holding the names of all the compilationUnits they must process between them
-      for (const auto& compilationUnitName : *it)
-        compilationUnitNames.push(compilationUnitName);
+      columbus::thread::ThreadPool& threadPool = metricsThreadPool;
+      // The threads take the compilationUnits of the component one by one by incrementing the shared index
+      atomic<size_t> nextCompilationUnit(0);
 
-      // Create all the threads, the threadPool calls their () operator and they start analyzing the compilationsUnits in compilationUnitNames
+      // Create all the threads, the threadPool calls their () operator and they start analyzing the compilationsUnits of the component
       for (int i = 0; i < maxThreads; i++)
-        threadPool.add(columbus::thread::ThreadPool::PtrTask(new MetricsWorker(metricsInvocation, compilationDatabase, compilationUnitNames, threadPool.getTaskLockMutex())));
+        threadPool.add(columbus::thread::ThreadPool::PtrTask(new MetricsWorker(metricsInvocation, compilationDatabase, *it, nextCompilationUnit)));
 
       threadPool.wait();
     }
@@ -426,19 +427,18 @@ int main(int argc, char *argv[]) {
 
     // Create threadsafe wrapper of the globalConversionInfo object
     GlobalASTConversionInfo_ThreadSafe globalInfoThreadSafe(globalConversionInfo);
+    // The workers of the pool are persistent, so the same pool is reused for every component
+    columbus::thread::ThreadPool conversionThreadPool(maxThreads);
     // Analyze only one component at a time
     for (auto it = compilationUnitsByComponent.begin(); it != compilationUnitsByComponent.end(); it++)
     {
-      columbus::thread::ThreadPool threadPool(maxThreads);
-      queue<string> compilationUnitNames;
-
-      // Setup a queue that will be accessed by all threads, holding the names of all the compilationUnits they must process between them
-      for (const auto& compilationUnitName : *it)
-        compilationUnitNames.push(compilationUnitName);
+      columbus::thread::ThreadPool& threadPool = conversionThreadPool;
+      // The threads take the compilationUnits of the component one by one by incrementing the shared index
+      atomic<size_t> nextCompilationUnit(0);
 
-      // Create all the threads, the threadPool calls their () operator and they start analyzing the compilationsUnits in compilationUnitNames
+      // Create all the threads, the threadPool calls their () operator and they start analyzing the compilationsUnits of the component
       for (int i = 0; i < maxThreads; i++)
-        threadPool.add(columbus::thread::ThreadPool::PtrTask(new CAN2LimWorker(compilationUnitNames, compilationDatabase, globalInfoThreadSafe, uidFactory, mem, threadPool.getTaskLockMutex())));
+        threadPool.add(columbus::thread::ThreadPool::PtrTask(new CAN2LimWorker(*it, nextCompilationUnit, compilationDatabase, globalInfoThreadSafe, uidFactory, mem, threadPool.getTaskLockMutex())));
 
       threadPool.wait();
     }
@@ -466,7 +466,10 @@ int main(int argc, char *argv[]) {
     headerList.push_back(&limOrigin);
 
     try {
-      limFact.save(out,  headerList, false);
+      if (mappedLim)
+        limFact.saveMapped(out, headerList);
+      else
+        limFact.save(out,  headerList, false);
     } catch (const IOException& e) {
       common::WriteMsg::write(CMSG_CAN2LIM_FACTORY_SAVE_ERROR, e.getMessage().c_str());
     }
@@ -519,7 +522,14 @@ int main(int argc, char *argv[]) {
     WriteMsg::write(CMSG_CAN2LIM_DUMP_TIME, ((float)limmltime)/100);
     WriteMsg::write(CMSG_CAN2LIM_TOTAL_TIME, ((float)totaltime)/100);
     WriteMsg::write(CMSG_CAN2LIM_PEAK_MEMORY, ((float)mem)/1048576);
+    WriteMsg::write(CMSG_CAN2LIM_UID_NAME_MEMORY, ((float)uidFactory.getSymbolTable().getResidentBytes())/1048576);
+    WriteMsg::write(CMSG_CAN2LIM_UID_NAMES, (unsigned long long)uidFactory.getSymbolTable().size(), (unsigned long long)uidFactory.getSymbolTable().getInternedCount());
     WriteMsg::write(CMSG_CAN2LIM_NOT_EXISTED_FILES, notExistedFiles);
+    WriteMsg::write(CMSG_CAN2LIM_GLOBAL_LOCK_ACQUISITIONS, (unsigned long long)globalInfoThreadSafe.getLockStatistics().getAcquisitions());
+    WriteMsg::write(CMSG_CAN2LIM_GLOBAL_LOCK_CONTENTIONS, (unsigned long long)globalInfoThreadSafe.getLockStatistics().getContentions());
+    WriteMsg::write(CMSG_CAN2LIM_GLOBAL_LOCK_WAIT_TIME, globalInfoThreadSafe.getLockStatistics().getWaitTime());
+    WriteMsg::write(CMSG_CAN2LIM_UID_TABLE_LOCK_ACQUISITIONS, (unsigned long long)(globalConversionInfo.limTable.getLockStatistics().getAcquisitions() + globalConversionInfo.typeTable.getLockStatistics().getAcquisitions() + globalConversionInfo.incompleteNodes.getLockStatistics().getAcquisitions()));
+    WriteMsg::write(CMSG_CAN2LIM_UID_TABLE_LOCK_CONTENTIONS, (unsigned long long)(globalConversionInfo.limTable.getLockStatistics().getContentions() + globalConversionInfo.typeTable.getLockStatistics().getContentions() + globalConversionInfo.incompleteNodes.getLockStatistics().getContentions()));
 
   MAIN_END
 
@@ -31,4 +31,7 @@
 #define CMSG_RULE_NO_NAME                                       WriteMsg::mlWarning,  "Rule %s does not have name!\n"
 #define CMSG_FILE_NOT_EXISTS  
 
+#define CMSG_EX_STREAM_LOCK_NOT_FOUND(FILE)                     "The lock file of the writer of the stream list does not exist: " + FILE
+#define CMSG_EX_STREAM_WRITER_STOPPED(FILE)                     "The writer of the stream list " + FILE + " has stopped before closing it"
+
 #endif
@@ -21,12 +21,15 @@
 #define PROGRAM_NAME "ClangTidy2Graph"
 #define EXECUTABLE_NAME "ClangTidy2Graph"
 
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 
 #include <MainCommon.h>
 #include <common/inc/Stat.h>
@@ -35,6 +38,7 @@
 #include <rul/inc/RulHandler.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
 
 
 #include "../inc/ResultConverter.h"
@@ -53,6 +57,7 @@ static string graphFileName;
 static string rul_s = "ClangTidy.rul.md";
 static string rulConfig = "Default";
 static bool exportRul = false;
+static string streamFileName;
 static string fList;
 static list<string> listOfFile;
 static size_t peakMemory = 0;
@@ -98,6 +103,11 @@ static bool ppList(const Option *o, char *argv[]) {
   return true;
 }
 
+static bool ppStream(const Option *o, char *argv[]) {
+  streamFileName = argv[0];
+  return true;
+}
+
 static void ppFile(char *filename) {
   listOfFile.push_back(filename);
 }
@@ -107,6 +117,7 @@ const common::Option OPTIONS_OBJ [] = {
   { false,  "-graph",           1, "filename",          0,  OT_WC,  ppGraph,      NULL,   "Save binary graph output."},
   { false,  "-out",             1, "filename",          0,  OT_WC,  ppOut,        NULL,   "Specify the name of the output file. The list of rule violations will be dumped in it.\n"},
   CL_INPUT_LIST
+  { false,  "-stream",          1, "filename",          0,  OT_WC,  ppStream,     NULL,   "List of the finished files of the input list, written while the program runs until an empty line. The files are processed in the order of the input list as they are finished. The writer holds a lock on <filename>.lock until it closes the list."},
   CL_LIM
   CL_RUL_AND_RULCONFIG("ClangTidy.rul.md")
   CL_EXPORTRUL
@@ -169,6 +180,85 @@ std::unordered_map<std::string, std::string> parseCheckDescriptionMD(const std::
   return map;
 }
 
+static void processResults(ResultConverter& converter, const string& astFile) {
+  string ctFilePath = astFile + ".ct.err";
+  if(pathFileExists(ctFilePath, false)){
+    WriteMsg::write(WriteMsg::mlNormal, "Loading warnings from file: %s\n", ctFilePath.c_str());
+    converter.process(ctFilePath);
+  }else{
+    // If a compilation unit does not contain a warning, the ct.err file will NOT be generated either
+    WriteMsg::write(WriteMsg::mlNormal, "No warnings for file: %s\n", astFile.c_str());
+  }
+}
+
+// Reads the complete lines appended to the stream list since the last call into the finished set.
+// Gives back false if nothing was read. The empty line which closes the list sets the closed flag.
+static bool readStream(ifstream& stream, string& pending, set<string>& finished, bool& closed) {
+  bool read = false;
+  string line;
+  while (!closed && getline(stream, line)) {
+    if (stream.eof()) {
+      // the rest of the line is not written yet
+      pending += line;
+      break;
+    }
+
+    read = true;
+    line = pending + line;
+    pending.clear();
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    if (line.empty())
+      closed = true;
+    else
+      finished.insert(line);
+  }
+  stream.clear();
+  return read;
+}
+
+// Processes the ASTs of the input list as clang-tidy finishes them. They are processed in the order of the input list
+// (the results do not depend on the order the ASTs are finished), after the stream list is closed all the rest are processed.
+// The writer of the stream list holds a lock on <stream list>.lock, so a writer stopped without closing the list is detected.
+static void processStream(ResultConverter& converter, const list<string>& astFiles, const string& streamFile) {
+  ifstream stream(streamFile, ifstream::binary);
+  if (!stream) {
+    WriteMsg::write(CMSG_FAILED_TO_OPEN_FILE, streamFile.c_str());
+    return;
+  }
+
+  const string lockFile = streamFile + ".lock";
+  if (!pathFileExists(lockFile, false))
+    throw Exception(COLUMBUS_LOCATION, CMSG_EX_STREAM_LOCK_NOT_FOUND(lockFile));
+  boost::interprocess::file_lock writerLock(lockFile.c_str());
+
+  set<string> finished;
+  string pending;
+  bool closed = false;
+  list<string>::const_iterator next = astFiles.begin();
+  while (next != astFiles.end()) {
+    bool read = readStream(stream, pending, finished, closed);
+    for (; next != astFiles.end() && (closed || finished.count(*next)); ++next) {
+      processResults(converter, *next);
+      updateMemStat(&peakMemory);
+    }
+
+    if (next == astFiles.end() || read)
+      continue;
+
+    if (writerLock.try_lock()) {
+      // the writer released its lock, everything it has written is readable now
+      writerLock.unlock();
+      if (!readStream(stream, pending, finished, closed))
+        throw Exception(COLUMBUS_LOCATION, CMSG_EX_STREAM_WRITER_STOPPED(streamFile));
+      continue;
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(100));
+  }
+}
+
 int main(int argc, char* argv[]) {
   int ret = EXIT_SUCCESS;
   MAIN_BEGIN
@@ -250,14 +340,11 @@ int main(int argc, char* argv[]) {
     }
     ResultConverter converter(limFileName, outputFileName, rul_s, rulConfig, exportRul, "", "");
     updateMemStat(&peakMemory);
-    for(list<string>::iterator file = listOfFile.begin(); file != listOfFile.end(); ++file){
-      string ctFilePath = *file + ".ct.err";
-      if(pathFileExists(ctFilePath, false)){
-        WriteMsg::write(WriteMsg::mlNormal, "Loading warnings from file: %s\n", ctFilePath.c_str());
-        converter.process(ctFilePath);
-      }else{
-        // If a compilation unit does not contain a warning, the ct.err file will NOT be generated either
-        WriteMsg::write(WriteMsg::mlNormal, "No warnings for file: %s\n", (*file).c_str());
+    if (!streamFileName.empty()) {
+      processStream(converter, listOfFile, streamFileName);
+    } else {
+      for(list<string>::iterator file = listOfFile.begin(); file != listOfFile.end(); ++file){
+        processResults(converter, *file);
       }
     }
     
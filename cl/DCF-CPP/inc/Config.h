@@ -64,6 +64,7 @@ struct Config {
     , statementFilter(true)
     , smallGenealogy(true)
     , maxCCSize(0)
+    , maxThreads(1)
   {
     memset(&stat,0,sizeof(stat));
   }
@@ -120,6 +121,7 @@ struct Config {
   bool smallGenealogy;                           ///< keep the string attributes of the last system only in the genealogy output
   std::string            xmlDumpFile;
   int                    maxCCSize;              ///< muber of maximum allowed clone instance in one clone class
+  unsigned int           maxThreads;             ///< number of threads used for the suffix arrays (0 means the number of cores)
 };
 
 extern Config config;
@@ -481,6 +481,13 @@ protected:
    */
   void patternFilter();
 
+  /**
+   * \internal
+   * \brief creates the thread pool used for building and enumerating the suffix arrays.
+   * \return the pool, or null if the suffix arrays are processed by the calling thread only
+   */
+  std::unique_ptr<columbus::thread::ThreadPool> createSuffixArrayPool() const;
+
   /**
    * \internal
    * \brief serialize all the given asg-s.
@@ -686,6 +693,21 @@ protected:
    */
   double similarity(const columbus::genealogy::CloneInstance& from, const columbus::genealogy::CloneInstance& to);
 
+  typedef std::vector<unsigned int> SimilarityBucketKey;
+
+  /**
+   * \internal
+   * \brief the bucket of the clone instance in the candidate index of the evolution mapping
+   *        (similarity() is infinite between instances of different buckets)
+   */
+  SimilarityBucketKey similarityBucketKey(const columbus::genealogy::CloneInstance& ci) const;
+
+  /**
+   * \internal
+   * \brief checks whether F6 attributes of the given lengths can be close enough to keep the similarity under the bound
+   */
+  bool isF6LengthCompatible(unsigned int length1, unsigned int length2) const;
+
   /**
    * \internal
    * \return the id of the component or 0
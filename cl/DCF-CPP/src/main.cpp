@@ -151,6 +151,11 @@ static bool  ppFst (const Option *o, char *argv[]) {
   return true;
 }
 
+static bool ppMaxThreads (const Option *o, char *argv[]) {
+  config.maxThreads = boost::lexical_cast<unsigned int>(argv[0]);
+  return true;
+}
+
 static bool ppFilterPath (const Option *o, char *argv[]) {
   config.filterfile = argv[0];
   return true;
@@ -175,6 +180,7 @@ const common::Option OPTIONS_OBJ [] = {
   { false,  "-multipleasgroot",      0, "",               0, OT_WC,    ppMultipleAsgRoot, NULL,"Clone instances can have multiple ASG root."},
   { false,  "-onlyfunctionclone",    0, "",               0, OT_WC,    ppFc,              NULL,"Clones are detected only inside the functions."},
   { false,  "-statementNotReq",      0, "",               0, OT_WC,    ppFst,             NULL,"Not filter clone instance which has not contained statement."},
+  { false,  "-maxThreads",           1, "number",         0, OT_WE | OT_WC, ppMaxThreads, NULL,"The number of threads used for building and enumerating the suffix arrays. The detected clones do not depend on it. 0 means the number of available CPU cores. Default value is 1."},
   CL_RUL_AND_RULCONFIG("DCF.rul")
   CL_EXPORTRUL
   CL_INPUT_LIST
@@ -0,0 +1,131 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+/**
+* \file SuffixArrayBenchmark.cpp
+* \brief Measures the suffix array construction and the clone interval enumeration used by DuplicatedCodeFinder.
+*
+* Usage: SuffixArrayBenchmark [sequence length] [number of threads] [minimum clone length]
+*
+* The input is a synthetic node kind sequence: random node kinds separated by unique separator values (like the
+* serialized ASGs of the files) with copied segments planted into it. Every configuration is run by the calling
+* thread only and with a thread pool, and the checksums of the reported clone classes must be the same.
+*/
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <suffixarray/inc/suffix_array.h>
+#include "Benchmark.h"
+
+using namespace std;
+using namespace columbus;
+using namespace columbus::suffix_array;
+using columbus::benchmark::measure;
+
+namespace {
+
+  class ChecksumVisitor : public SuffixArray<int>::CloneVisitor {
+    public:
+      ChecksumVisitor() : classes(0), checksum(1469598103934665603ULL) {}
+
+      void visit(SuffixArray<int>::CloneClass& cc) override {
+        ++classes;
+        add(cc.length);
+        add(cc.num);
+        for (unsigned i = 0; i < cc.num; ++i)
+          add(cc.position[i]);
+      }
+
+      unsigned long long classes;
+      unsigned long long checksum;
+
+    private:
+      void add(unsigned long long value) {
+        checksum = (checksum ^ value) * 1099511628211ULL;
+      }
+  };
+
+  vector<int> createSequence(size_t length) {
+    mt19937 random(42);
+    vector<int> sequence;
+    sequence.reserve(length);
+    int separator = -1;
+    while (sequence.size() < length) {
+      // a "file" of node kinds, the frequent kinds are the small ones
+      size_t fileLength = 200 + random() % 5000;
+      for (size_t i = 0; i < fileLength && sequence.size() < length; ++i)
+        sequence.push_back((int)(random() % 16 * (random() % 16) + random() % 8));
+      sequence.push_back(separator--);
+    }
+    sequence.resize(length);
+
+    // plant clones of 35-500 nodes
+    for (size_t clones = length / 2000; clones > 0 && length > 1000; --clones) {
+      size_t cloneLength = 35 + random() % 465;
+      size_t from = random() % (length - cloneLength);
+      size_t copies = 1 + random() % 4;
+      for (size_t c = 0; c < copies; ++c) {
+        size_t to = random() % (length - cloneLength);
+        for (size_t i = 0; i < cloneLength; ++i)
+          sequence[to + i] = sequence[from + i];
+      }
+    }
+    return sequence;
+  }
+
+  void run(Sequence<int>& sequence, thread::ThreadPool* pool, unsigned minLength) {
+    const char* kind = pool ? "pool      " : "sequential";
+    string buildName = string(kind) + " suffix array + lcp";
+    string enumerateName = string(kind) + " clone intervals";
+
+    LinearSuffixArray<int>* suffixArray = NULL;
+    measure(buildName.c_str(), sequence.getLength(), "nodes", [&]() {
+      suffixArray = new LinearSuffixArray<int>(sequence, pool);
+      return (unsigned long long)sequence.getLength();
+    });
+    measure(enumerateName.c_str(), sequence.getLength(), "nodes", [&]() {
+      ChecksumVisitor visitor;
+      LinearSuffixArray<int>::Duplicateiterator iterator = suffixArray->iterator(minLength, 0, 0, true);
+      iterator.run(visitor, pool);
+      printf("%-36s %8llu clone classes\n", "", visitor.classes);
+      return visitor.checksum;
+    });
+    delete suffixArray;
+  }
+
+}
+
+int main(int argc, char* argv[]) {
+  size_t length = argc > 1 ? stoul(argv[1]) : 8 * 1024 * 1024;
+  unsigned threads = argc > 2 ? stoul(argv[2]) : thread::ThreadPool::getNumberOfCores();
+  unsigned minLength = argc > 3 ? stoul(argv[3]) : 35;
+
+  vector<int> nodeKinds = createSequence(length);
+  Sequence<int> sequence(nodeKinds);
+  printf("sequence length: %zu, threads: %u, minimum clone length: %u\n", length, threads, minLength);
+
+  run(sequence, NULL, minLength);
+  thread::ThreadPool pool(threads);
+  run(sequence, &pool, minLength);
+  return 0;
+}
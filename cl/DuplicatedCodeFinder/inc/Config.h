@@ -58,6 +58,7 @@ struct Config {
     , statementFilter(true)
     , smallGenealogy(true)
     , xmlDumpFile ("")
+    , maxThreads  (1)
   { memset(&stat,0,sizeof(stat)); }
 
   unsigned int           minLines;              ///< minimum lines in clone
@@ -116,6 +117,7 @@ struct Config {
   bool statementFilter;
   bool smallGenealogy;                          ///< keep the string attributes of the last system only in the genealogy output
   std::string            xmlDumpFile;
+  unsigned int           maxThreads;            ///< number of threads used for the suffix arrays (0 means the number of cores)
 };
 
 #endif
@@ -52,6 +52,13 @@ public:
 #endif
 
   std::string getFileNameByComponentId(const std::string& id);
+
+  /**
+   * @brief Registers the asg file of the component without loading it (like a component replayed from the serialization cache).
+   * @parameter componentID the id of the component.
+   * @parameter fileName the name of the asg file of the component.
+   */
+  void setFileNameOfComponent(const std::string& componentID, const std::string& fileName);
   void release() ;
   Factory* operator()(const std::string& component) ;
 
@@ -0,0 +1,175 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _DCF_SERIALIZATION_CACHE_H_
+#define _DCF_SERIALIZATION_CACHE_H_
+
+#include <AsgCommon.h>
+#include <io/inc/BinaryIO.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace columbus { namespace dcf {
+
+  /**
+   * \brief The recorded result of serializing the ASG of one component with the CloneVisitorBase.
+   *
+   * Besides the produced sequences it stores everything the serialization read from or wrote into the
+   * state shared between the components, so it can be replayed only if the previous components left the
+   * same state behind. The LIM node ids are not stable between runs, so the LIM nodes are referenced
+   * through the ids of the ASG nodes they originate from, and the strings are stored as text.
+   */
+  struct SerializedComponent {
+    /**
+     * \brief The state of the visitor which is carried over from one component to the next one.
+     */
+    struct BoundaryState {
+      BoundaryState() : prevLine(0), separatorCounter(0), limRootOnStack(false) {}
+      bool operator==(const BoundaryState& other) const {
+        return prevPath == other.prevPath && prevLine == other.prevLine && path == other.path && limRootOnStack == other.limRootOnStack;
+      }
+
+      std::string prevPath;
+      unsigned int prevLine;
+      std::string path;
+      int separatorCounter;         ///< not part of the comparison, the separators are renumbered at replay
+      bool limRootOnStack;
+    };
+
+    // values of the LIM node references besides the indices of limRefs
+    static const int limRefComponent = -2;
+    static const int limRefRoot = -1;
+    // pathIndex of the elements of the sequence without node
+    static const unsigned int noPath = (unsigned int)-1;
+
+    struct Position {
+      unsigned int pathIndex;
+      unsigned int line;
+      unsigned int col;
+      unsigned int endLine;
+      unsigned int endCol;
+      unsigned int nodeKind;
+      NodeId nodeId;
+      int limNode;
+    };
+
+    struct Line {
+      unsigned int pathIndex;
+      unsigned int line;
+      bool visited;                 ///< the answer of the lookup (used only for the dependencies)
+    };
+
+    struct LimNode {
+      int limNode;
+      bool visited;                 ///< the answer of the lookup (used only for the dependencies)
+    };
+
+    SerializedComponent() : contentHash(0), asgHash(0), visitedNodesNumber(0) {}
+
+    /**
+     * \brief gives back the index of the path in the paths (the path is added if it is new)
+     */
+    unsigned int getPathIndex(const std::string& path);
+
+    /**
+     * \brief gives back the reference of the LIM node originated from the given ASG node (the node is added if it is new)
+     */
+    int getLimRef(NodeId asgNodeId);
+
+    std::string asgFile;
+    std::size_t contentHash;        ///< hash of the content of the ASG file
+    std::string componentId;
+    std::size_t asgHash;            ///< the hash code of the genealogy component
+    unsigned long long visitedNodesNumber;
+    BoundaryState entry;
+    BoundaryState exit;
+
+    std::vector<std::string> paths;
+    std::vector<NodeId> limRefs;    ///< the ASG nodes the referenced LIM nodes originate from
+
+    std::vector<int> nodeKinds;     ///< the serialized sequence
+    std::vector<Position> positions;
+
+    std::vector<Line> lineDependencies;
+    std::vector<LimNode> limNodeDependencies;
+    std::vector<Line> visitedLines;
+    std::vector<Line> logicalLines;
+    std::vector<int> visitedLimNodes;
+    std::vector<unsigned int> componentFiles;
+
+  private:
+    std::map<std::string, unsigned int> pathIndices;
+    std::map<NodeId, int> limRefIndices;
+  };
+
+  /**
+   * \brief Cache of the serialized components, stored next to the genealogy.
+   *
+   * The entries are keyed by the name and the content hash of the ASG file. The previous cache is only read,
+   * the entries of the current run are written into a new file which replaces the old one at commit().
+   */
+  class SerializationCache {
+  public:
+    /**
+     * \brief opens the cache
+     * \param filename  [in] the cache file
+     * \param configKey [in] the description of the options influencing the serialization, the cache is dropped if it differs
+     */
+    SerializationCache(const std::string& filename, const std::string& configKey);
+
+    ~SerializationCache();
+
+    /**
+     * \brief loads the entry of the ASG file if the cache has one for the given content
+     * \return true if the entry is found
+     */
+    bool find(const std::string& asgFile, std::size_t contentHash, SerializedComponent& component);
+
+    /**
+     * \brief writes the entry into the new cache
+     */
+    void store(const SerializedComponent& component);
+
+    /**
+     * \brief replaces the previous cache with the entries stored in this run
+     */
+    void commit();
+
+    /**
+     * \brief computes the hash of the content of the given file
+     */
+    static std::size_t hashFile(const std::string& filename);
+
+  private:
+    static void read(io::BinaryIO& io, SerializedComponent& component);
+    static void write(io::BinaryIO& io, const SerializedComponent& component);
+
+    std::string filename;
+    std::string configKey;
+    std::unique_ptr<io::BinaryIO> in;
+    std::unique_ptr<io::BinaryIO> out;
+    std::map<std::string, std::pair<std::size_t, std::streampos> > index;
+  };
+
+}}
+
+#endif
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <common/inc/WriteMessage.h>
 #include <lim/inc/LimOrigin.h>
+#include "../SerializationCache.h"
 
 
 /*
@@ -127,6 +128,8 @@ protected:
   NodeId             blockedNode;
   BlockKind          blockNodeKind;
   std::stack<NodeId> currentLimNode;
+  // the ASG nodes the elements of the currentLimNode originate from (0 for the LIM root)
+  std::stack<NodeId> currentLimNodeOrigin;
 
   int depth;
   columbus::LANGUAGE_NAMESPACE::Factory* factory;
@@ -153,6 +156,15 @@ protected:
   columbus::NodeId filterBegin;
   unsigned long long visitedNodesNumber;
 
+  // the component being recorded for the serialization cache and the shared state it has written so far
+  columbus::dcf::SerializedComponent* record;
+  std::set<LineIdentifier> recordedVisitedLines;
+  std::set<LineIdentifier> recordedLogicalLines;
+  std::set<LineIdentifier> recordedLineDependencies;
+  std::set<NodeId> recordedVisitedLimNodes;
+  std::set<NodeId> recordedLimNodeDependencies;
+  std::set<std::string> recordedComponentFiles;
+
 ////////////Protected functions////////////
   
   bool isNodeSeparatorNeeded(const Base& node);
@@ -180,6 +192,11 @@ protected:
 
   void assignSrcFileToComponenet( std::string &lPath ,NodeId currentLimComponent);
 
+  void insertLogicalLine(const std::string& lPath, unsigned int line);
+
+  // the reference of currentLimNode.top() (or the component if it is empty) in the record
+  int getRecordedLimRef();
+
 public:
   void setLogicalLines(std::set<LineIdentifier>* val) { logicalLines = val; }
   void setFileNamesByComponent(std::map<NodeId,std::set<columbus::Key> >* val) { fileNamesByComponent = val; }
@@ -232,6 +249,29 @@ public:
   bool evoluteLimNode( const Base& n , bool end);
 
   bool parseLimNodeId (const Base& n, NodeId& limNodeID );
+
+  /**
+   * \brief gives back the state carried over to the next component
+   * \return false if the visitor is inside a blocked or filtered range, so the boundary cannot be cached
+   */
+  bool getBoundaryState(columbus::dcf::SerializedComponent::BoundaryState& state) const;
+
+  /**
+   * \brief starts recording the serialization of the current component (the factory must be set and no filter can be used)
+   */
+  void startRecording(columbus::dcf::SerializedComponent& record);
+
+  /**
+   * \brief stops the recording
+   * \return false if the recorded component cannot be replayed later
+   */
+  bool stopRecording();
+
+  /**
+   * \brief reproduces the serialization of the current component from the recorded one
+   * \return false (and nothing is changed) if the state left by the previous components differs from the recorded one
+   */
+  bool replay(const columbus::dcf::SerializedComponent& record);
 };
 
 
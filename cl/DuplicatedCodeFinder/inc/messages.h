@@ -41,6 +41,8 @@
 #define CMSG_FILENAME_COMPONENT_MATCH           common::WriteMsg::mlWarning, "Warning: Component has found with filename only! (%s)\n"
 #define CMSG_ADDING_PATH_TO_FILTER              common::WriteMsg::mlWarning, "Warning: Clone detection in file (%s) need to be skiped due to it seems to contain too much clones. (Probably a generated file.)\n"
 #define CMSG_NO_COMPILATION_UNIT_FOUND          common::WriteMsg::mlWarning, "Warning: Can't find compilation unit file: %s\n"
+#define CMSG_SERIALIZATION_CACHE_CANNOT_BE_READ     common::WriteMsg::mlWarning, "Warning: Serialization cache cannot be read: \"%s\"\n"
+#define CMSG_SERIALIZATION_CACHE_CANNOT_BE_WRITTEN  common::WriteMsg::mlWarning, "Warning: Serialization cache cannot be written: \"%s\"\n"
 
 // normal
 #define CMSG_GENERATING_CLONE_INSTANCES         common::WriteMsg::mlNormal, "Generating clone instances...\n"
@@ -75,6 +77,9 @@
 #define CMSG_CLONE_INSTANCE                     common::WriteMsg::mlDDDDebug,"Debug: CloneInstance%d:\n"
 #define CMSG_SD_ON                              common::WriteMsg::mlDDDDebug,"%s(%d) on %d %d %s ,%d\n"
 #define CMSG_CURRENT_COMPONENT_ID               common::WriteMsg::mlDebug, "Debug: The ID of the current component node in LIM:%d\n"
+#define CMSG_SERIALIZATION_CACHE_OUTDATED       common::WriteMsg::mlDebug, "Debug: Serialization cache is created with different settings, it is not used: \"%s\"\n"
+#define CMSG_SERIALIZATION_CACHE_HIT             common::WriteMsg::mlDebug, "Debug: Serialized ASG is reused from the cache: %s\n"
+#define CMSG_SERIALIZATION_CACHE_STAT            common::WriteMsg::mlDebug, "Debug: Serialization cache reused %u of %u components\n"
 
 #define CMSG_LINE_INFO_CASE_LOWERED             "lower case" 
 #define CMSG_LINE_INFO_CASE_DEFAULT             "default case"
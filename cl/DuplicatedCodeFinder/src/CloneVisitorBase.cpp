@@ -64,6 +64,7 @@ CloneVisitorBase::CloneVisitorBase(
   , filterIsOn(false)
   , filterBegin(0)
   , visitedNodesNumber(0)
+  , record(NULL)
 {}
 
 CloneVisitorBase::~CloneVisitorBase() {}
@@ -93,6 +94,8 @@ int CloneVisitorBase::getSeparator() {
 
 void CloneVisitorBase::addToResultSequence(int kind) {
   resultSequence.push_back(kind);
+  if (record)
+    record->nodeKinds.push_back(kind);
 }
 
 ClonePositioned* CloneVisitorBase::createClonePositioned(const Positioned* p) {
@@ -121,9 +124,17 @@ void CloneVisitorBase::addToNodeIdSequence(const Positioned* p) {
   if (p!=NULL) {
     ClonePositioned* px = createClonePositioned(p);
     nodeIdSequence.push_back(px);
+    if (record) {
+      columbus::dcf::SerializedComponent::Position position = { record->getPathIndex(px->getStringPath()), px->getLine(), px->getCol(), px->getEndLine(), px->getEndCol(), px->getNodeKind(), px->getId(), getRecordedLimRef() };
+      record->positions.push_back(position);
+    }
     common::WriteMsg::write(CMSG_ADD_NODE_TO_SEQ,nodeIdSequence.size()-1,LANGUAGE_NAMESPACE::Common::toString(p->getNodeKind()).c_str(),px->getStringPath().c_str(),px->getLine());
   } else {
     nodeIdSequence.push_back(NULL);
+    if (record) {
+      columbus::dcf::SerializedComponent::Position position = { columbus::dcf::SerializedComponent::noPath, 0, 0, 0, 0, 0, 0, 0 };
+      record->positions.push_back(position);
+    }
     common::WriteMsg::write(CMSG_ADD_NODE_TO_SEQ_END ,nodeIdSequence.size()-1);
   }
 }
@@ -188,32 +199,44 @@ void CloneVisitorBase::blockNode(const Base& b) {
 
   if ((prevPath!=lPath) && fileNamesByComponent) {
     assignSrcFileToComponenet(lPath,currentLimComponent);
+    if (record)
+      recordedComponentFiles.insert(lPath);
   }
 
   if (logicalLines) {
 #ifdef SCHEMA_JAVA
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getLine()));
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getEndLine()));
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getWideLine()));
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getWideEndLine()));
+    insertLogicalLine(lPath, pos.getPosition().getLine());
+    insertLogicalLine(lPath, pos.getPosition().getEndLine());
+    insertLogicalLine(lPath, pos.getPosition().getWideLine());
+    insertLogicalLine(lPath, pos.getPosition().getWideEndLine());
 #elif defined SCHEMA_PYTHON
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getLine()));
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getEndLine()));
+    insertLogicalLine(lPath, pos.getPosition().getLine());
+    insertLogicalLine(lPath, pos.getPosition().getEndLine());
 #elif defined SCHEMA_CSHARP
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getStartLine()));
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()),pos.getPosition().getEndLine()));
+    insertLogicalLine(lPath, pos.getPosition().getStartLine());
+    insertLogicalLine(lPath, pos.getPosition().getEndLine());
 #elif defined SCHEMA_JAVASCRIPT
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()), pos.getPosition().getLine()));
-    logicalLines->insert(LineIdentifier(limFactory->getStringTable().set(lPath.c_str()), pos.getPosition().getEndLine()));
+    insertLogicalLine(lPath, pos.getPosition().getLine());
+    insertLogicalLine(lPath, pos.getPosition().getEndLine());
 #endif
   }
 
   if ((prevPath!=lPath || line!=prevLine) && lPath!="") {
-    visitedLines.insert(LineIdentifier(limFactory->getStringTable().set(prevPath.c_str()),prevLine));
+    LineIdentifier prevLineId(limFactory->getStringTable().set(prevPath.c_str()),prevLine);
+    visitedLines.insert(prevLineId);
+    if (record)
+      recordedVisitedLines.insert(prevLineId);
     prevPath = lPath;
     prevLine = line;
 
-    if (visitedLines.count(LineIdentifier(limFactory->getStringTable().get(lPath),line))!=0) {
+    LineIdentifier lineId(limFactory->getStringTable().get(lPath),line);
+    bool visited = visitedLines.count(lineId)!=0;
+    if (record && !recordedVisitedLines.count(lineId) && recordedLineDependencies.insert(lineId).second) {
+      columbus::dcf::SerializedComponent::Line dependency = { record->getPathIndex(lPath), line, visited };
+      record->lineDependencies.push_back(dependency);
+    }
+
+    if (visited) {
       blockNodeKind = BK_asgNodeBlock;
       blockedNode   = b.getId(); 
       
@@ -222,6 +245,11 @@ void CloneVisitorBase::blockNode(const Base& b) {
     }
   }
   
+  if (record && !currentLimNode.empty() && !recordedVisitedLimNodes.count(currentLimNode.top()) && recordedLimNodeDependencies.insert(currentLimNode.top()).second) {
+    columbus::dcf::SerializedComponent::LimNode dependency = { getRecordedLimRef(), visitedLimNodes.count(currentLimNode.top()) > 0 };
+    record->limNodeDependencies.push_back(dependency);
+  }
+
   if (!currentLimNode.empty() && (visitedLimNodes.count(currentLimNode.top()) > 0))
   {
     columbus::NodeId  posibelBlockedNode   = currentLimNode.top();
@@ -457,6 +485,8 @@ bool CloneVisitorBase::evoluteLimNode( const Base& n ,bool end){
         if (currentLimNode.size() > 0) {
           if (!lim::asg::Common::getIsPackage( limFactory->getRef(currentLimNode.top()))) {
             visitedLimNodes.insert(currentLimNode.top());
+            if (record && recordedVisitedLimNodes.insert(currentLimNode.top()).second)
+              record->visitedLimNodes.push_back(getRecordedLimRef());
           }
         }
 
@@ -467,16 +497,19 @@ bool CloneVisitorBase::evoluteLimNode( const Base& n ,bool end){
         }
 
         currentLimNode.pop() ;
+        currentLimNodeOrigin.pop();
         return true;
       } else {
         common::WriteMsg::write(CMSG_MORE_END_THEN_BEGIN );
       }
     } else {
       currentLimNode.push(parsedLimNodeID) ;
+      currentLimNodeOrigin.push(n.getId());
       return true;
     }
   } else if (currentLimNode.empty()) {
-     currentLimNode.push(limFactory->getRoot()->getId()); 
+     currentLimNode.push(limFactory->getRoot()->getId());
+     currentLimNodeOrigin.push(0);
   }
   return false;
 }
@@ -502,3 +535,144 @@ void CloneVisitorBase::assignSrcFileToComponenet( std::string &lPath ,columbus::
 }
 
 
+
+void CloneVisitorBase::insertLogicalLine(const std::string& lPath, unsigned int line)
+{
+  LineIdentifier lineId(limFactory->getStringTable().set(lPath.c_str()), line);
+  logicalLines->insert(lineId);
+  if (record)
+    recordedLogicalLines.insert(lineId);
+}
+
+int CloneVisitorBase::getRecordedLimRef()
+{
+  if (currentLimNode.empty())
+    return columbus::dcf::SerializedComponent::limRefComponent;
+  if (currentLimNodeOrigin.top() == 0)
+    return columbus::dcf::SerializedComponent::limRefRoot;
+  return record->getLimRef(currentLimNodeOrigin.top());
+}
+
+bool CloneVisitorBase::getBoundaryState(columbus::dcf::SerializedComponent::BoundaryState& state) const
+{
+  if (blockNodeKind != BK_none || filterIsOn || currentLimNode.size() > 1 || (!currentLimNode.empty() && currentLimNodeOrigin.top() != 0))
+    return false;
+
+  state.prevPath = prevPath;
+  state.prevLine = prevLine;
+  state.path = path;
+  state.separatorCounter = separatorCounter;
+  state.limRootOnStack = !currentLimNode.empty();
+  return true;
+}
+
+void CloneVisitorBase::startRecording(columbus::dcf::SerializedComponent& record)
+{
+  // a component started inside a blocked or filtered range cannot be replayed
+  if (filter == NULL && getBoundaryState(record.entry))
+    this->record = &record;
+}
+
+bool CloneVisitorBase::stopRecording()
+{
+  if (!record)
+    return false;
+
+  bool replayable = (filter == NULL) && getBoundaryState(record->exit);
+
+  const StrTable& strTable = limFactory->getStringTable();
+  for (std::set<LineIdentifier>::const_iterator it = recordedVisitedLines.begin(); it != recordedVisitedLines.end(); ++it) {
+    columbus::dcf::SerializedComponent::Line line = { record->getPathIndex(strTable.get(it->path)), (unsigned int)it->line, true };
+    record->visitedLines.push_back(line);
+  }
+  for (std::set<LineIdentifier>::const_iterator it = recordedLogicalLines.begin(); it != recordedLogicalLines.end(); ++it) {
+    columbus::dcf::SerializedComponent::Line line = { record->getPathIndex(strTable.get(it->path)), (unsigned int)it->line, true };
+    record->logicalLines.push_back(line);
+  }
+  for (std::set<std::string>::const_iterator it = recordedComponentFiles.begin(); it != recordedComponentFiles.end(); ++it)
+    record->componentFiles.push_back(record->getPathIndex(*it));
+  record->visitedNodesNumber = visitedNodesNumber;
+
+  record = NULL;
+  recordedVisitedLines.clear();
+  recordedLogicalLines.clear();
+  recordedLineDependencies.clear();
+  recordedVisitedLimNodes.clear();
+  recordedLimNodeDependencies.clear();
+  recordedComponentFiles.clear();
+  return replayable;
+}
+
+bool CloneVisitorBase::replay(const columbus::dcf::SerializedComponent& record)
+{
+  using columbus::dcf::SerializedComponent;
+
+  SerializedComponent::BoundaryState state;
+  if (filter != NULL || !getBoundaryState(state) || !(state == record.entry))
+    return false;
+
+  // the LIM nodes of this run
+  std::vector<NodeId> limNodes(record.limRefs.size());
+  for (size_t i = 0; i < record.limRefs.size(); ++i) {
+    limNodes[i] = limOrigin.getLimIdToCompIdAndCppId(currentLimComponent, record.limRefs[i]);
+    if (limNodes[i] == 0)
+      return false;
+  }
+  const NodeId limRoot = limFactory->getRoot()->getId();
+#define LIM_NODE_OF_REF(ref) ((ref) == SerializedComponent::limRefComponent ? currentLimComponent : (ref) == SerializedComponent::limRefRoot ? limRoot : limNodes[(ref)])
+
+  // the previous components must have left the same state behind
+  StrTable& strTable = limFactory->getStringTable();
+  for (std::vector<SerializedComponent::Line>::const_iterator it = record.lineDependencies.begin(); it != record.lineDependencies.end(); ++it) {
+    if ((visitedLines.count(LineIdentifier(strTable.get(record.paths[it->pathIndex]), it->line)) != 0) != it->visited)
+      return false;
+  }
+  for (std::vector<SerializedComponent::LimNode>::const_iterator it = record.limNodeDependencies.begin(); it != record.limNodeDependencies.end(); ++it) {
+    if ((visitedLimNodes.count(LIM_NODE_OF_REF(it->limNode)) != 0) != it->visited)
+      return false;
+  }
+
+  // the separators are renumbered to continue the ones of the previous components
+  const int separatorShift = separatorCounter - record.entry.separatorCounter;
+  resultSequence.reserve(resultSequence.size() + record.nodeKinds.size());
+  for (std::vector<int>::const_iterator it = record.nodeKinds.begin(); it != record.nodeKinds.end(); ++it)
+    resultSequence.push_back(*it < decDepthSign ? *it + separatorShift : *it);
+  separatorCounter = record.exit.separatorCounter + separatorShift;
+
+  nodeIdSequence.reserve(nodeIdSequence.size() + record.positions.size());
+  for (std::vector<SerializedComponent::Position>::const_iterator it = record.positions.begin(); it != record.positions.end(); ++it) {
+    if (it->pathIndex == SerializedComponent::noPath)
+      nodeIdSequence.push_back(NULL);
+    else
+      nodeIdSequence.push_back(new ClonePositioned(record.paths[it->pathIndex], it->line, it->col, it->endLine, it->endCol, it->nodeKind, it->nodeId, LIM_NODE_OF_REF(it->limNode), currentLimComponent));
+  }
+
+  for (std::vector<SerializedComponent::Line>::const_iterator it = record.visitedLines.begin(); it != record.visitedLines.end(); ++it)
+    visitedLines.insert(LineIdentifier(strTable.set(record.paths[it->pathIndex].c_str()), it->line));
+  if (logicalLines) {
+    for (std::vector<SerializedComponent::Line>::const_iterator it = record.logicalLines.begin(); it != record.logicalLines.end(); ++it)
+      logicalLines->insert(LineIdentifier(strTable.set(record.paths[it->pathIndex].c_str()), it->line));
+  }
+  for (std::vector<int>::const_iterator it = record.visitedLimNodes.begin(); it != record.visitedLimNodes.end(); ++it)
+    visitedLimNodes.insert(LIM_NODE_OF_REF(*it));
+  if (fileNamesByComponent) {
+    for (std::vector<unsigned int>::const_iterator it = record.componentFiles.begin(); it != record.componentFiles.end(); ++it) {
+      std::string file = record.paths[*it];
+      assignSrcFileToComponenet(file, currentLimComponent);
+    }
+  }
+#undef LIM_NODE_OF_REF
+
+  prevPath = record.exit.prevPath;
+  prevLine = record.exit.prevLine;
+  path = record.exit.path;
+  if (record.exit.limRootOnStack && currentLimNode.empty()) {
+    currentLimNode.push(limRoot);
+    currentLimNodeOrigin.push(0);
+  } else if (!record.exit.limRootOnStack && !currentLimNode.empty()) {
+    currentLimNode.pop();
+    currentLimNodeOrigin.pop();
+  }
+  visitedNodesNumber = record.visitedNodesNumber;
+  return true;
+}
@@ -165,6 +165,11 @@ namespace columbus { namespace dcf {
     return  std::string();
   }
 
+  void LanguageFactory::setFileNameOfComponent( const std::string& componentID, const std::string& fileName )
+  {
+    limComponentNameFileNameMap[componentID] = fileName;
+  }
+
   const std::map<std::string, std::string>& LanguageFactory::getLimComponentNameFileNameMap() const
   {
     return limComponentNameFileNameMap;
@@ -0,0 +1,328 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/SerializationCache.h"
+#include "../inc/messages.h"
+#include <common/inc/WriteMessage.h>
+#include <Exception.h>
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+namespace columbus { namespace dcf {
+
+  static const char* cacheMagic = "DCF serialization cache";
+  static const unsigned int cacheVersion = 1;
+
+  unsigned int SerializedComponent::getPathIndex(const string& path) {
+    map<string, unsigned int>::iterator it = pathIndices.find(path);
+    if (it != pathIndices.end())
+      return it->second;
+
+    unsigned int index = (unsigned int)paths.size();
+    paths.push_back(path);
+    pathIndices.insert(make_pair(path, index));
+    return index;
+  }
+
+  int SerializedComponent::getLimRef(NodeId asgNodeId) {
+    map<NodeId, int>::iterator it = limRefIndices.find(asgNodeId);
+    if (it != limRefIndices.end())
+      return it->second;
+
+    int index = (int)limRefs.size();
+    limRefs.push_back(asgNodeId);
+    limRefIndices.insert(make_pair(asgNodeId, index));
+    return index;
+  }
+
+
+  SerializationCache::SerializationCache(const string& filename, const string& configKey)
+    : filename(filename)
+    , configKey(configKey)
+    , in()
+    , out()
+    , index()
+  {
+    // reading the index of the previous cache
+    if (boost::filesystem::exists(filename)) {
+      try {
+        in.reset(new io::BinaryIO(filename, io::IOBase::omRead));
+        string magic;
+        string key;
+        in->readString(magic);
+        unsigned int version = in->readUInt4();
+        in->readString(key);
+        if (magic == cacheMagic && version == cacheVersion && key == configKey) {
+          string asgFile;
+          in->readString(asgFile);
+          while (!asgFile.empty()) {
+            size_t contentHash = (size_t)in->readULongLong8();
+            unsigned long long size = in->readULongLong8();
+            index[asgFile] = make_pair(contentHash, in->getPosition());
+            in->skipNext((streamsize)size);
+            in->readString(asgFile);
+          }
+        } else {
+          common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_OUTDATED, filename.c_str());
+          index.clear();
+          in.reset();
+        }
+      } catch (const Exception&) {
+        common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_CANNOT_BE_READ, filename.c_str());
+        index.clear();
+        in.reset();
+      }
+    }
+
+    try {
+      out.reset(new io::BinaryIO(filename + ".new", io::IOBase::omWrite));
+      out->writeString(cacheMagic);
+      out->writeUInt4(cacheVersion);
+      out->writeString(configKey);
+    } catch (const Exception&) {
+      common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_CANNOT_BE_WRITTEN, filename.c_str());
+      out.reset();
+    }
+  }
+
+  SerializationCache::~SerializationCache() {
+    in.reset();
+    if (out) {
+      // not committed
+      out.reset();
+      boost::system::error_code ec;
+      boost::filesystem::remove(filename + ".new", ec);
+    }
+  }
+
+  bool SerializationCache::find(const string& asgFile, size_t contentHash, SerializedComponent& component) {
+    map<string, pair<size_t, streampos> >::iterator it = index.find(asgFile);
+    if (!in || it == index.end() || it->second.first != contentHash)
+      return false;
+
+    try {
+      in->setStartReadPosition(it->second.second);
+      component = SerializedComponent();
+      component.asgFile = asgFile;
+      component.contentHash = contentHash;
+      read(*in, component);
+    } catch (const Exception&) {
+      common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_CANNOT_BE_READ, filename.c_str());
+      index.clear();
+      in.reset();
+      return false;
+    }
+    return true;
+  }
+
+  void SerializationCache::store(const SerializedComponent& component) {
+    if (!out)
+      return;
+
+    try {
+      // the entry is serialized into memory first, so its size can precede it
+      stringbuf buffer;
+      {
+        io::BinaryIO entry;
+        entry.open(&buffer);
+        write(entry, component);
+      }
+      const string& data = buffer.str();
+      out->writeString(component.asgFile);
+      out->writeULongLong8(component.contentHash);
+      out->writeULongLong8(data.size());
+      out->writeData(data.data(), data.size());
+    } catch (const Exception&) {
+      common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_CANNOT_BE_WRITTEN, filename.c_str());
+      out.reset();
+    }
+  }
+
+  void SerializationCache::commit() {
+    if (!out)
+      return;
+
+    try {
+      // terminating empty name
+      out->writeString("");
+      out->close();
+      out.reset();
+      in.reset();
+      index.clear();
+      boost::filesystem::rename(filename + ".new", filename);
+    } catch (const Exception&) {
+      common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_CANNOT_BE_WRITTEN, filename.c_str());
+    } catch (const boost::filesystem::filesystem_error&) {
+      common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_CANNOT_BE_WRITTEN, filename.c_str());
+    }
+  }
+
+  size_t SerializationCache::hashFile(const string& filename) {
+    size_t hash = 0;
+    ifstream file(filename.c_str(), ios::binary);
+    if (!file)
+      return hash;
+
+    vector<char> buffer(1 << 20);
+    while (file) {
+      file.read(&buffer[0], buffer.size());
+      streamsize count = file.gcount();
+      if (count <= 0)
+        break;
+      boost::hash_combine(hash, boost::hash_range(buffer.begin(), buffer.begin() + count));
+    }
+    return hash;
+  }
+
+  static void writeLine(io::BinaryIO& io, const SerializedComponent::Line& line) {
+    io.writeUInt4(line.pathIndex);
+    io.writeUInt4(line.line);
+    io.writeBool1(line.visited);
+  }
+
+  static void readLine(io::BinaryIO& io, SerializedComponent::Line& line) {
+    line.pathIndex = io.readUInt4();
+    line.line = io.readUInt4();
+    line.visited = io.readBool1();
+  }
+
+  static void writeLines(io::BinaryIO& io, const vector<SerializedComponent::Line>& lines) {
+    io.writeULongLong8(lines.size());
+    for (vector<SerializedComponent::Line>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+      writeLine(io, *it);
+  }
+
+  static void readLines(io::BinaryIO& io, vector<SerializedComponent::Line>& lines) {
+    lines.resize((size_t)io.readULongLong8());
+    for (vector<SerializedComponent::Line>::iterator it = lines.begin(); it != lines.end(); ++it)
+      readLine(io, *it);
+  }
+
+  template <typename T>
+  static void writeVector(io::BinaryIO& io, const vector<T>& values) {
+    io.writeULongLong8(values.size());
+    io.writeArray(values.data(), values.size());
+  }
+
+  template <typename T>
+  static void readVector(io::BinaryIO& io, vector<T>& values) {
+    values.resize((size_t)io.readULongLong8());
+    io.readArray(values.data(), values.size());
+  }
+
+  static void writeBoundaryState(io::BinaryIO& io, const SerializedComponent::BoundaryState& state) {
+    io.writeString(state.prevPath);
+    io.writeUInt4(state.prevLine);
+    io.writeString(state.path);
+    io.writeInt4(state.separatorCounter);
+    io.writeBool1(state.limRootOnStack);
+  }
+
+  static void readBoundaryState(io::BinaryIO& io, SerializedComponent::BoundaryState& state) {
+    io.readString(state.prevPath);
+    state.prevLine = io.readUInt4();
+    io.readString(state.path);
+    state.separatorCounter = io.readInt4();
+    state.limRootOnStack = io.readBool1();
+  }
+
+  void SerializationCache::write(io::BinaryIO& io, const SerializedComponent& component) {
+    io.writeString(component.componentId);
+    io.writeULongLong8(component.asgHash);
+    io.writeULongLong8(component.visitedNodesNumber);
+    writeBoundaryState(io, component.entry);
+    writeBoundaryState(io, component.exit);
+
+    io.writeULongLong8(component.paths.size());
+    for (vector<string>::const_iterator it = component.paths.begin(); it != component.paths.end(); ++it)
+      io.writeString(*it);
+    writeVector(io, component.limRefs);
+
+    writeVector(io, component.nodeKinds);
+    io.writeULongLong8(component.positions.size());
+    for (vector<SerializedComponent::Position>::const_iterator it = component.positions.begin(); it != component.positions.end(); ++it) {
+      io.writeUInt4(it->pathIndex);
+      if (it->pathIndex == SerializedComponent::noPath)
+        continue;
+      io.writeUInt4(it->line);
+      io.writeUInt4(it->col);
+      io.writeUInt4(it->endLine);
+      io.writeUInt4(it->endCol);
+      io.writeUInt4(it->nodeKind);
+      io.writeUInt4(it->nodeId);
+      io.writeInt4(it->limNode);
+    }
+
+    writeLines(io, component.lineDependencies);
+    io.writeULongLong8(component.limNodeDependencies.size());
+    for (vector<SerializedComponent::LimNode>::const_iterator it = component.limNodeDependencies.begin(); it != component.limNodeDependencies.end(); ++it) {
+      io.writeInt4(it->limNode);
+      io.writeBool1(it->visited);
+    }
+    writeLines(io, component.visitedLines);
+    writeLines(io, component.logicalLines);
+    writeVector(io, component.visitedLimNodes);
+    writeVector(io, component.componentFiles);
+  }
+
+  void SerializationCache::read(io::BinaryIO& io, SerializedComponent& component) {
+    io.readString(component.componentId);
+    component.asgHash = (size_t)io.readULongLong8();
+    component.visitedNodesNumber = io.readULongLong8();
+    readBoundaryState(io, component.entry);
+    readBoundaryState(io, component.exit);
+
+    component.paths.resize((size_t)io.readULongLong8());
+    for (vector<string>::iterator it = component.paths.begin(); it != component.paths.end(); ++it)
+      io.readString(*it);
+    readVector(io, component.limRefs);
+
+    readVector(io, component.nodeKinds);
+    component.positions.resize((size_t)io.readULongLong8());
+    for (vector<SerializedComponent::Position>::iterator it = component.positions.begin(); it != component.positions.end(); ++it) {
+      it->pathIndex = io.readUInt4();
+      if (it->pathIndex == SerializedComponent::noPath)
+        continue;
+      it->line = io.readUInt4();
+      it->col = io.readUInt4();
+      it->endLine = io.readUInt4();
+      it->endCol = io.readUInt4();
+      it->nodeKind = io.readUInt4();
+      it->nodeId = io.readUInt4();
+      it->limNode = io.readInt4();
+    }
+
+    readLines(io, component.lineDependencies);
+    component.limNodeDependencies.resize((size_t)io.readULongLong8());
+    for (vector<SerializedComponent::LimNode>::iterator it = component.limNodeDependencies.begin(); it != component.limNodeDependencies.end(); ++it) {
+      it->limNode = io.readInt4();
+      it->visited = io.readBool1();
+    }
+    readLines(io, component.visitedLines);
+    readLines(io, component.logicalLines);
+    readVector(io, component.visitedLimNodes);
+    readVector(io, component.componentFiles);
+  }
+
+}}
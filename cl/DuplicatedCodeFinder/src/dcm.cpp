@@ -23,7 +23,7 @@
 #include "../inc/StatementFilter.h"
 #include <algorithm>
 #include <cmath>
-#include <common/inc/math/linear/hungarian_method.h>
+#include <common/inc/math/linear/sparse_assignment.h>
 #include <lim2graph/inc/VisitorGraphConverter.h>
 #include <graphsupport/inc/RulBuilder.h>
 #include <graphsupport/inc/GraphConstants.h>
@@ -32,6 +32,7 @@
 #include <iomanip> 
 #include <lim/inc/visitors/Visitor.h>
 #include <boost/filesystem/path.hpp>
+#include <boost/preprocessor/stringize.hpp>
 #include <vector>
 
 using namespace common;
@@ -296,6 +297,11 @@ namespace columbus {
 
     }
 
+    // similarities above the bound are considered infinite
+    static const double similarityBound = 0.1;
+    // weights of the F1, ..., F6 attributes (index 0 is unused)
+    static const double similarityWeights[7] = { 0.0, 0.3122, 0.6365, 0.2066, 0.4293, 0.1101, 0.5080};
+
     double DuplicatedCodeMiner::similarity(const columbus::genealogy::CloneInstance& from, const columbus::genealogy::CloneInstance& to) {
       static unsigned long counter = 0;
       double inf=std::numeric_limits<double>::infinity();
@@ -303,9 +309,9 @@ namespace columbus {
       DEBUGPRINTF(printf("[%lu]Similarity:%d -> %d:", counter, from.getId(), to.getId());)
 
       double dist = 0.0;
-      double bound = 0.1;
+      double bound = similarityBound;
 
-      double alpha[7]={ 0.0, 0.3122, 0.6365, 0.2066, 0.4293, 0.1101, 0.5080};
+      const double* alpha = similarityWeights;
 
       columbus::genealogy::CloneClass& fromClass=*(from.getCloneClass());
       columbus::genealogy::CloneClass& toClass=*(to.getCloneClass());
@@ -466,6 +472,26 @@ namespace columbus {
       return dist;
     }
 
+    DuplicatedCodeMiner::SimilarityBucketKey DuplicatedCodeMiner::similarityBucketKey(const columbus::genealogy::CloneInstance& ci) const {
+      // Each of these differences alone adds at least the full weight of a feature to the distance,
+      // which is already above the bound, so similarity() returns inf for them.
+      SimilarityBucketKey key;
+      key.push_back(ci.getCloneClass()->getHeadNodeKind());
+      key.push_back(ci.getRootLength());
+      key.push_back(ci.getF2_OrdinalNumber());
+      key.push_back(ci.getPath().empty());
+      key.push_back(ci.getF3_HeadNodeUniqueName().empty());
+      key.push_back(ci.getF4_AncestorUniqueName().empty());
+      return key;
+    }
+
+    bool DuplicatedCodeMiner::isF6LengthCompatible(unsigned int length1, unsigned int length2) const {
+      // the edit distance of the F6 attributes is at least the difference of their lengths
+      unsigned int n_max = max(length1, length2);
+      unsigned int diff = n_max - min(length1, length2);
+      return similarityWeights[6] * diff <= similarityBound * n_max * (1.0 + 1e-9);
+    }
+
     vector<genealogy::CloneInstance*> DuplicatedCodeMiner::getInstancesOfaSystem(const genealogy::System& system) const {
       vector<genealogy::CloneInstance*> instances;
       for (genealogy::ListIterator<genealogy::CloneClass> classItemsIter = system.getCloneClassesListIteratorBegin(); classItemsIter != system.getCloneClassesListIteratorEnd(); ++classItemsIter)
@@ -626,11 +652,12 @@ namespace columbus {
       ppf.min_inst_length = config.patternMinFullLength;
       ppf.dcm = this;
 
-      LinearSuffixArray<int> suffixArray(sequence);
+      std::unique_ptr<columbus::thread::ThreadPool> pool = createSuffixArrayPool();
+      LinearSuffixArray<int> suffixArray(sequence, pool.get());
       LinearSuffixArray<int>::Duplicateiterator lduplicateIterator = suffixArray.iterator(1, config.patternMaxSingleLength, config.patternMinFullLength, false);
 
 
-      lduplicateIterator.run(ppf);
+      lduplicateIterator.run(ppf, pool.get());
       size_t count = ppf.filteredNodeIndexes.size();
 
       auto filterTime = common::getProcessUsedTime().user - time.user;
@@ -656,6 +683,13 @@ namespace columbus {
       updateMemoryStat();
     }
 
+    std::unique_ptr<columbus::thread::ThreadPool> DuplicatedCodeMiner::createSuffixArrayPool() const {
+      unsigned int threads = config.maxThreads == 0 ? columbus::thread::ThreadPool::getNumberOfCores() : config.maxThreads;
+      if (threads < 2)
+        return nullptr;
+      return std::unique_ptr<columbus::thread::ThreadPool>(new columbus::thread::ThreadPool(threads));
+    }
+
     
     void DuplicatedCodeMiner::dumpNodeIdSequence(const std::string filename)
     {
@@ -735,7 +769,8 @@ namespace columbus {
       std::map<std::string, unsigned int> clone_counter;
       Sequence<int> sequence(nodeKindSequence);
 
-      LinearSuffixArray<int> suffixArray(sequence);
+      std::unique_ptr<columbus::thread::ThreadPool> pool = createSuffixArrayPool();
+      LinearSuffixArray<int> suffixArray(sequence, pool.get());
       common::WriteMsg::write(CMSG_CLONE_DETECTION_DONE_IN, common::getProcessUsedTime().user - time.user);
 
       common::WriteMsg::write(CMSG_GENERATING_CLONE_INSTANCES);
@@ -753,7 +788,7 @@ namespace columbus {
       processCC.maxCCSize = maxCCSize;
       processCC.needToSkip = &needToSkip;
 
-      lduplicateIterator.run(processCC);
+      lduplicateIterator.run(processCC, pool.get());
 
       updateMemoryStat();
       common::WriteMsg::write(CMSG_PROBALBLY_CLONES_FOUND);
@@ -1672,7 +1707,7 @@ namespace columbus {
       return instanceRootIds;
     }
 
-    int DuplicatedCodeMiner::serializeAsg(bool createComponent)
+    int DuplicatedCodeMiner::serializeAsg(bool createComponent, bool useCache)
     {
       auto perfSectionHandler = common::PerformanceLogger::getPerformanceLogger().startSection("serializeAsg()");
 
@@ -1700,6 +1735,18 @@ namespace columbus {
       while (bp_iter!=config.bpaths.end()) {
         theCloneVisitor->addBlockPath((*bp_iter++));
       }
+
+      // the serialized asgs of the previous run, the entries depend on the settings of the serialization too
+      std::unique_ptr<SerializationCache> cache;
+      if (createComponent && useCache && !config.genealogyFilename.empty()) {
+        std::string cacheKey = BOOST_PP_STRINGIZE(LANGUAGE_NAMESPACE);
+        cacheKey += config.ofc ? ";ofc" : ";all";
+        for (bp_iter = config.bpaths.begin(); bp_iter != config.bpaths.end(); ++bp_iter)
+          cacheKey += ";" + *bp_iter;
+        cache.reset(new SerializationCache(config.genealogyFilename + ".dcfcache", cacheKey));
+      }
+      unsigned int reusedComponents = 0;
+
       float numberOfComponents = config.files.size();
       int componentCounter = 0;
       for  (std::list<std::string>::iterator fileIter=config.files.begin();fileIter!=config.files.end();fileIter++)
@@ -1707,7 +1754,37 @@ namespace columbus {
         ++componentCounter;
         std::string fname=(*fileIter);
         std::string componenetID;
+        std::size_t hash = 0;
+        std::size_t contentHash = 0;
         common::WriteMsg::write(CMSG_LOADING_AND_PERCENTAGE, componentCounter / numberOfComponents, fname.c_str());
+
+        SerializedComponent serialized;
+        if (cache) {
+          contentHash = SerializationCache::hashFile(fname);
+          if (cache->find(fname, contentHash, serialized) && filteredNodes.find(serialized.componentId) == filteredNodes.end()) {
+            theCloneVisitor->setFactory(NULL, getLimComponenetIdByName(serialized.componentId, *limFact));
+            if (theCloneVisitor->replay(serialized)) {
+              // the asg is not loaded, but the coverage and the metrics load it later by the component id
+              currentFactory.setFileNameOfComponent(serialized.componentId, fname);
+
+              // create component to genealogy
+              columbus::genealogy::Component* componentRef=genealogyFact->createComponentNode();
+              componentRef->setLocation(fname);
+              componentRef->setName(serialized.componentId);
+              currentSystem->addComponents(componentRef);
+              componentRef->setCode(serialized.asgHash);
+
+              serializedAsgNodeNumberByComponenet[fname] = serialized.visitedNodesNumber;
+              cache->store(serialized);
+              ++reusedComponents;
+              common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_HIT, fname.c_str());
+              perfSectionHandler.addTimeStamp("replay");
+              continue;
+            }
+          }
+          serialized = SerializedComponent();
+        }
+
         try {
           currentFactory.loadComponent(fname,false,NULL,&componenetID);
           perfSectionHandler.addTimeStamp("loadComponent");
@@ -1718,7 +1795,7 @@ namespace columbus {
             componentRef->setName(componenetID);
             currentSystem->addComponents(componentRef);
             //calculate hash
-            std::size_t hash = currentFactory.calculateHash(currentFactory.operator ()(fname), fname);
+            hash = currentFactory.calculateHash(currentFactory.operator ()(fname), fname);
             perfSectionHandler.addTimeStamp("calculateHash");
             componentRef->setCode(hash);
           }
@@ -1749,10 +1826,21 @@ namespace columbus {
         WriteMsg::write(CMSG_LOAD_ASG_DONE);
         updateMemoryStat();
 
+        if (cache)
+          theCloneVisitor->startRecording(serialized);
+
         traversalPosiotionedNodes( (*currentFactory.operator ()(fname)),theCloneVisitor, componenetID); //main serialize method for other languages
         perfSectionHandler.addTimeStamp("traversalPosiotionedNodes");
         common::WriteMsg::write(CMSG_DONE_D);
 
+        if (cache && theCloneVisitor->stopRecording()) {
+          serialized.asgFile = fname;
+          serialized.contentHash = contentHash;
+          serialized.componentId = componenetID;
+          serialized.asgHash = hash;
+          cache->store(serialized);
+        }
+
         serializedAsgNodeNumberByComponenet[fname] = theCloneVisitor->getVisitedNodesNumber();
 
 
@@ -1762,6 +1850,11 @@ namespace columbus {
         common::WriteMsg::write(CMSG_DONE_D);
       }
 
+      if (cache) {
+        cache->commit();
+        common::WriteMsg::write(CMSG_SERIALIZATION_CACHE_STAT, reusedComponents, componentCounter);
+      }
+
       config.stat.asgSerializationTime += common::getProcessUsedTime().user - serializeTime.user;
       return exit_code;
     }
@@ -1806,7 +1899,8 @@ namespace columbus {
         
         limFact->turnFilterOn();
         
-        exit_code = serializeAsg(true);
+        // the cache is used only with the original settings, the retry with the extra block paths serializes everything
+        exit_code = serializeAsg(true, first);
 
         config.stat.serializedASGLength = nodeIdSequence.size();
         /**
@@ -2013,7 +2107,6 @@ namespace columbus {
 
 
       vector<genealogy::CloneInstance*> instancesOfTheCurrentSystem = getInstancesOfaSystem(systemRef);
-      unsigned numberOfInstancesInTheRefSystem = instancesOfTheCurrentSystem.size();
 
       std::sort(instancesOfTheCurrentSystem.begin(), instancesOfTheCurrentSystem.end(), sortCloneInstancesByComponentId());
       unsigned int prev = 0;
@@ -2040,16 +2133,53 @@ namespace columbus {
         unsigned numberOfInstancesInTheLastSystem = instancesOfTheLastSystem.size();
         config.stat.numberOfInstancesInTheLastSystem = numberOfInstancesInTheLastSystem;
 
-        for (vector<genealogy::CloneInstance*>::iterator currentInsatnceIt = instancesOfTheCurrentSystem.begin(); currentInsatnceIt != instancesOfTheCurrentSystem.end();++currentInsatnceIt) {
-          genealogy::CloneInstance* instanceOfTheCurentSystem = *currentInsatnceIt;
+        // Candidate index of the unmapped instances of the last system. Only the pairs falling into the same bucket
+        // with compatible F6 lengths can have finite similarity, the others are not compared at all.
+        // (key -> (length of F6, index in instancesOfTheLastSystem))
+        typedef std::map<SimilarityBucketKey, std::vector<std::pair<unsigned int, unsigned int> > > SimilarityBuckets;
+        SimilarityBuckets buckets;
+        for (unsigned int lastIndex = 0; lastIndex < instancesOfTheLastSystem.size(); ++lastIndex) {
+          genealogy::CloneInstance* instanceOfTheLastSystem = instancesOfTheLastSystem[lastIndex];
+
+          if (!instanceOfTheLastSystem->getNextIsEmpty() || instanceOfTheLastSystem->getIsVirtual())
+            continue;
+
+          buckets[similarityBucketKey(*instanceOfTheLastSystem)].push_back(make_pair((unsigned int)instanceOfTheLastSystem->getF6_LexicalStructure().size(), lastIndex));
+        }
+        for (SimilarityBuckets::iterator bucketIt = buckets.begin(); bucketIt != buckets.end(); ++bucketIt)
+          std::sort(bucketIt->second.begin(), bucketIt->second.end());
+
+        // the finite similarities computed for the instances of the current system: (index in instancesOfTheLastSystem, similarity)
+        // every pair is compared only once, the assignment reuses the values of the trivial pairing
+        vector<vector<pair<unsigned int, double> > > candidates(instancesOfTheCurrentSystem.size());
+        vector<unsigned int> candidateIndices;
+        for (unsigned int currentIndex = 0; currentIndex < instancesOfTheCurrentSystem.size(); ++currentIndex) {
+          genealogy::CloneInstance* instanceOfTheCurentSystem = instancesOfTheCurrentSystem[currentIndex];
 
           if (!instanceOfTheCurentSystem->getPrevIsEmpty() || instanceOfTheCurentSystem->getIsVirtual())
             continue;
 
-          for (vector<genealogy::CloneInstance*>::iterator prevInsatnceIt = instancesOfTheLastSystem.begin(); prevInsatnceIt != instancesOfTheLastSystem.end();++prevInsatnceIt) {
-            genealogy::CloneInstance* instanceOfTheLastSystem = *prevInsatnceIt;
+          SimilarityBuckets::const_iterator bucketIt = buckets.find(similarityBucketKey(*instanceOfTheCurentSystem));
+          if (bucketIt == buckets.end())
+            continue;
+
+          // the F6 lengths compatible with the current one form a contiguous range of the sorted bucket
+          unsigned int length = (unsigned int)instanceOfTheCurentSystem->getF6_LexicalStructure().size();
+          const vector<pair<unsigned int, unsigned int> >& bucket = bucketIt->second;
+          vector<pair<unsigned int, unsigned int> >::const_iterator it = std::lower_bound(bucket.begin(), bucket.end(), make_pair(length, 0u));
+          while (it != bucket.begin() && isF6LengthCompatible((it - 1)->first, length))
+            --it;
+          candidateIndices.clear();
+          for (; it != bucket.end() && isF6LengthCompatible(it->first, length); ++it)
+            candidateIndices.push_back(it->second);
 
-            if (!instanceOfTheLastSystem->getNextIsEmpty() || instanceOfTheLastSystem->getIsVirtual())
+          // keep the original order of the last system, the first trivial pair wins
+          std::sort(candidateIndices.begin(), candidateIndices.end());
+
+          for (vector<unsigned int>::const_iterator indexIt = candidateIndices.begin(); indexIt != candidateIndices.end(); ++indexIt) {
+            genealogy::CloneInstance* instanceOfTheLastSystem = instancesOfTheLastSystem[*indexIt];
+
+            if (!instanceOfTheLastSystem->getNextIsEmpty())
               continue;
 
             double sim=similarity(*instanceOfTheLastSystem, *instanceOfTheCurentSystem);
@@ -2058,65 +2188,52 @@ namespace columbus {
               instanceOfTheLastSystem->addNext(instanceOfTheCurentSystem);
               instanceOfTheCurentSystem->addPrev(instanceOfTheLastSystem);
               trivial_pairs++;
+              candidates[currentIndex].clear();
               break;
             }
+            if (sim != std::numeric_limits<double>::infinity())
+              candidates[currentIndex].push_back(make_pair(*indexIt, sim));
           }
         }
 
         config.stat.numberOfTrivialPairs = trivial_pairs;
         try{
-          boost::numeric::ublas::matrix<double> m(numberOfInstancesInTheLastSystem - trivial_pairs, numberOfInstancesInTheRefSystem - trivial_pairs);
-
-          for (unsigned int q1=0; q1<m.size1(); q1++) {
-            for (unsigned int q2=0; q2<m.size2(); q2++) {
-              m(q1,q2)=std::numeric_limits<double>::infinity();
-            }
-          }
-
           updateMemoryStat();
 
-          unsigned int row=0;
-          unsigned int col=0;
-          typedef boost::bimap<unsigned int, columbus::genealogy::CloneInstance*> IntCloneInstanceBimap;
-          typedef std::map<unsigned int, columbus::genealogy::CloneInstance*> IntCloneInstanceMap;
-
-          IntCloneInstanceMap row_map;
-          IntCloneInstanceBimap col_map;
-
-          for (vector<genealogy::CloneInstance*>::iterator prevInsatnceIt = instancesOfTheLastSystem.begin(); prevInsatnceIt != instancesOfTheLastSystem.end();++prevInsatnceIt) {
-            genealogy::CloneInstance* instanceOfTheLastSystem = *prevInsatnceIt;    
+          const unsigned int noRow = std::numeric_limits<unsigned int>::max();
+          vector<unsigned int> rowOfLastInstance(instancesOfTheLastSystem.size(), noRow);
+          vector<genealogy::CloneInstance*> row_map;
+          for (unsigned int lastIndex = 0; lastIndex < instancesOfTheLastSystem.size(); ++lastIndex) {
+            genealogy::CloneInstance* instanceOfTheLastSystem = instancesOfTheLastSystem[lastIndex];
 
             if (!instanceOfTheLastSystem->getNextIsEmpty() || instanceOfTheLastSystem->getIsVirtual())
               continue;
 
-            row_map.insert(IntCloneInstanceMap::value_type(row, instanceOfTheLastSystem));
+            rowOfLastInstance[lastIndex] = (unsigned int)row_map.size();
+            row_map.push_back(instanceOfTheLastSystem);
+          }
 
-            for (vector<genealogy::CloneInstance*>::iterator currentInsatnceIt = instancesOfTheCurrentSystem.begin(); currentInsatnceIt != instancesOfTheCurrentSystem.end();++currentInsatnceIt) {
-              genealogy::CloneInstance* instanceOfTheCurentSystem = *currentInsatnceIt;
+          vector<unsigned int> col_map;   // col -> index in instancesOfTheCurrentSystem
+          for (unsigned int currentIndex = 0; currentIndex < instancesOfTheCurrentSystem.size(); ++currentIndex) {
+            genealogy::CloneInstance* instanceOfTheCurentSystem = instancesOfTheCurrentSystem[currentIndex];
 
-              if (!instanceOfTheCurentSystem->getPrevIsEmpty() || instanceOfTheCurentSystem->getIsVirtual())
-                continue;
+            if (!instanceOfTheCurentSystem->getPrevIsEmpty() || instanceOfTheCurentSystem->getIsVirtual())
+              continue;
 
-              IntCloneInstanceBimap::right_iterator leftIter=col_map.right.find(instanceOfTheCurentSystem);
-              unsigned int mycol = 0;
-              if (leftIter != col_map.right.end())
-                mycol = leftIter->second;
-              else {
-                col_map.insert(IntCloneInstanceBimap::value_type(col, instanceOfTheCurentSystem));
-                mycol = col;
-                col++;
-              }
-              double sim = similarity(*instanceOfTheLastSystem, *instanceOfTheCurentSystem);  // Ez mar egyszer ki lett szamolva! Lehet el kellene tarolni es nem megegyszer kiszamolni.
-              m(row, mycol) = sim;
-            }
-            row++;
+            col_map.push_back(currentIndex);
+          }
+
+          common::math::SparseAssignment<double> assignment((unsigned int)row_map.size(), (unsigned int)col_map.size());
+          for (unsigned int col = 0; col < col_map.size(); ++col) {
+            const vector<pair<unsigned int, double> >& candidatesOfCol = candidates[col_map[col]];
+            for (vector<pair<unsigned int, double> >::const_iterator candIt = candidatesOfCol.begin(); candIt != candidatesOfCol.end(); ++candIt)
+              if (rowOfLastInstance[candIt->first] != noRow)
+                assignment.add(rowOfLastInstance[candIt->first], col, candIt->second);
           }
 
           updateMemoryStat();
-          boost::numeric::ublas::matrix<double> m_orig(m);
-          
-          common::math::HungarianMethod<std::string, double> Hm(m_orig);
-          std::map<unsigned int, unsigned int> solution=Hm.solve(common::math::HungarianMethod<std::string, double>::INJECTIVE_KIND);
+
+          std::map<unsigned int, unsigned int> solution=assignment.solve();
           std::map<unsigned int, unsigned int>::iterator sol_iter=solution.begin();
           unsigned int nontrivial_maps=0;
           double overall_similarity=0.0;
@@ -2124,18 +2241,15 @@ namespace columbus {
             unsigned int second=(*sol_iter).first;
             unsigned int first=(*sol_iter).second;
             sol_iter++;
-            if (first>=m.size1() || second>=m.size2() || m(first,second)==numeric_limits<double>::infinity())
-              continue;
-            IntCloneInstanceMap::iterator iter1;
-            if ((iter1=row_map.find(first))==row_map.end())
-              continue;
-            IntCloneInstanceBimap::left_iterator iter2;
-            if ((iter2=col_map.left.find(second))==col_map.left.end())
-              continue;
-            (*iter1).second->addNext((*iter2).second->getId());
-            (*iter2).second->addPrev((*iter1).second->getId());
+            genealogy::CloneInstance* instanceOfTheLastSystem = row_map[first];
+            genealogy::CloneInstance* instanceOfTheCurentSystem = instancesOfTheCurrentSystem[col_map[second]];
+            instanceOfTheLastSystem->addNext(instanceOfTheCurentSystem->getId());
+            instanceOfTheCurentSystem->addPrev(instanceOfTheLastSystem->getId());
             nontrivial_maps++;
-            overall_similarity+=m(first, second);
+            const vector<pair<unsigned int, double> >& candidatesOfCol = candidates[col_map[second]];
+            for (vector<pair<unsigned int, double> >::const_iterator candIt = candidatesOfCol.begin(); candIt != candidatesOfCol.end(); ++candIt)
+              if (rowOfLastInstance[candIt->first] == first)
+                overall_similarity += candIt->second;
           }
         }catch (std::bad_alloc&) {
           common::WriteMsg::write(CMSG_NOT_ENOUGH_MEMORY_TO_EVOLUTE);
@@ -24,6 +24,7 @@
 #define CMSG_NO_INPUT_FILE        WriteMsg::mlNormal, "Error: No input file\n"
 #define CMSG_TOO_MANY_INPUT_FILES WriteMsg::mlNormal, "Error: Too many input files\n"
 #define CMSG_LOAD_FILE            WriteMsg::mlNormal, "Loading: %s\n"
+#define CMSG_LOAD_COMPACT_FILE    WriteMsg::mlNormal, "Loading (compact): %s\n"
 #define CMSG_CSV_DUMP             WriteMsg::mlNormal, "Creating csv dump ...\n"
 #define CMSG_XML_DUMP             WriteMsg::mlNormal, "Creating xml dump ...\n"
 #define CMSG_JSON_DUMP             WriteMsg::mlNormal, "Creating json dump ...\n"
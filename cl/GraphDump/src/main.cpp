@@ -22,7 +22,9 @@
 #define EXECUTABLE_NAME "GraphDump"
 
 #include <graph/inc/graph.h>
+#include <graph/inc/CompactGraph.h>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include <MainCommon.h>
@@ -30,6 +32,7 @@
 #include <common/inc/WriteMessage.h>
 #include <common/inc/Stat.h>
 #include <graphsupport/inc/CsvExporter.h>
+#include <graphsupport/inc/GraphExporter.h>
 #include <graphsupport/inc/SarifExporter.h>
 #include "../inc/messages.h"
 
@@ -46,6 +49,7 @@ static string sarifFile;
 static char csvSeparator = ',';
 static char csvDmark = '.';
 static string sarifSeverityLevel = "2345c";
+static bool compactGraph = false;
 
 static void ppFile(char *filename) {
   files.push_back(filename);
@@ -131,6 +135,11 @@ static bool ppCsvDecimalMark (const common::Option *o, char *argv[]) {
   return true;
 }
 
+static bool ppCompactGraph (const common::Option *o, char *argv[]) {
+  compactGraph = true;
+  return true;
+}
+
 const Option OPTIONS_OBJ [] = {
   { false,  "-csv",     1, "filename",      1, OT_WC | OT_DEFAULT,  ppCsvOutput,  ppCsvOutputDefault, "Generate csv dump files with the given file name template."},
   CL_CSVSEPARATOR
@@ -139,6 +148,7 @@ const Option OPTIONS_OBJ [] = {
   { false,  "-json",    1, "filename",      1, OT_WC | OT_DEFAULT,  ppSaveJSON,    ppSaveJSONDefault,   "Generate JSON dump file."},
   { false,  "-sarif",   1, "filename",      1, OT_WC | OT_DEFAULT,  ppSarifOutput,  ppSarifOutputDefault, "Generate SARIF dump files with the given file name template."},
   CL_SARIFSEVERITY
+  { false,  "-compactGraph", 0, "",         0, OT_NONE,             ppCompactGraph, NULL,             "Use the compact, read-only graph representation for the XML and JSON dumps. It needs considerably less memory on large graphs and the graph is loaded into the full representation only if csv or SARIF dump is also requested."},
   COMMON_CL_ARGS
 };
 
@@ -159,31 +169,58 @@ int main(int argc, char** argv) {
     clError();
   }
 
+  if (compactGraph && (!xmlFile.empty() || !jsonFile.empty())) {
+    common::WriteMsg::write(CMSG_LOAD_COMPACT_FILE, files[0].c_str());
+    CompactGraph cg;
+    cg.loadBinary(files[0]);
+
+    if (!xmlFile.empty()) {
+      common::WriteMsg::write(CMSG_XML_DUMP);
+      cg.saveXML(xmlFile);
+    }
+
+    if (!jsonFile.empty()) {
+      common::WriteMsg::write(CMSG_JSON_DUMP);
+      cg.saveJSON(jsonFile);
+    }
+
+    if (csvFile.empty() && sarifFile.empty())
+      return 0;
+
+    xmlFile.clear();
+    jsonFile.clear();
+  }
+
   common::WriteMsg::write(CMSG_LOAD_FILE, files[0].c_str());
   Graph g;
   g.loadBinary(files[0]);
-  
+
+  // the requested dumps are written in one pass over the graph, each on its own thread
+  graphsupport::GraphExporter exporter(g);
+
   if (!csvFile.empty()) {
     common::WriteMsg::write(CMSG_CSV_DUMP);
-    graphsupport::exportReadableMetricsCSV(g, csvFile, csvSeparator, csvDmark);
+    exporter.addWriter(unique_ptr<graphsupport::GraphExportWriter>(new graphsupport::ReadableMetricsCsvWriter(g, csvFile, csvSeparator, csvDmark)));
   }
-  
+
   if (!xmlFile.empty()) {
     common::WriteMsg::write(CMSG_XML_DUMP);
-    g.saveXML(xmlFile);
+    exporter.addWriter(unique_ptr<graphsupport::GraphExportWriter>(new graphsupport::XMLExportWriter(g, xmlFile)));
   }
 
   if (!jsonFile.empty())
   {
     common::WriteMsg::write(CMSG_JSON_DUMP);
-    g.saveJSON(jsonFile);
+    exporter.addWriter(unique_ptr<graphsupport::GraphExportWriter>(new graphsupport::JSONExportWriter(g, jsonFile)));
   }
 
   if (!sarifFile.empty()) {
     common::WriteMsg::write(CMSG_SARIF_DUMP);
-    graphsupport::exportToSarif(g, sarifFile, sarifSeverityLevel);
+    exporter.addWriter(unique_ptr<graphsupport::GraphExportWriter>(new graphsupport::SarifWriter(g, sarifFile, sarifSeverityLevel)));
   }
 
+  exporter.run();
+
   MAIN_END
 
   return 0;
@@ -23,6 +23,7 @@
 #define EXECUTABLE_NAME "GraphMerge"
 
 #include <MainCommon.h>
+#include <memory>
 #include <vector>
 
 #include "messages.h"
@@ -31,9 +32,11 @@
 #include <graphsupport/inc/Metric.h>
 #include <graphsupport/inc/GraphConstants.h>
 #include <io/inc/CsvIO.h>
+#include <threadpool/inc/ThreadPool.h>
 #include <common/inc/Stat.h>
 #include "common/inc/Arguments.h"
 #include "common/inc/FileSup.h"
+#include "common/inc/StringSup.h"
 
 using namespace std;
 using namespace common;
@@ -45,6 +48,7 @@ static vector<string> files;
 static string out;
 static bool saveXml = false;
 static bool generateSummary = false;
+static int maxThreads = 1;
 
 static void ppFile(char *filename) {
   files.push_back(filename);
@@ -65,10 +69,16 @@ static bool ppSaveXML (const common::Option *o, char *argv[]) {
   return true;
 }
 
+static bool ppMaxThreads (const common::Option *o, char *argv[]) {
+  maxThreads = common::str2int(argv[0]);
+  return true;
+}
+
 const Option OPTIONS_OBJ [] = {
   { false,  "-out",         1, "filename",      1, OT_WC,    ppOut,             NULL, "The merged output graph."},
   { false,  "-summary",     0, "",              1, OT_WC,    ppSummary,         NULL, "Save SM dependent summary graph too."},
   { false,  "-dumpxml",     0, "",              0, OT_NONE,  ppSaveXML,         NULL, "Dump the graph in xml format."},
+  { false,  "-maxThreads",  1, CL_KIND_NUMBER,  0, OT_WE | OT_WC, ppMaxThreads, NULL, "The maximum number of threads used for loading the input graphs. The graphs are still merged in the order of the input files, so the result does not depend on it. 0 means the number of available CPU cores. The default value is 1."},
   COMMON_CL_ARGS
 };
 
@@ -86,12 +96,38 @@ int main(int argc, char** argv) {
       clError();
     }
 
+    if (maxThreads <= 0)
+      maxThreads = columbus::thread::ThreadPool::getNumberOfCores();
+
     Graph g;
     WriteMsg::write(CMSG_LOAD_FILE, files[0].c_str());
     g.loadBinary(files[0]);
-    for (size_t i = 1; i < files.size(); ++i) {
-      WriteMsg::write(CMSG_MERGE_FILE, files[i].c_str());
-      g.mergeWithBinary(files[i], Graph::mmUnionAttribute, Graph::csmmUnionNewAttributes, Graph::nmmSummarizeAttributes, Graph::mmUnionAttribute, Graph::csmmUnionNewAttributes, Graph::nmmSummarizeAttributes);
+    if (maxThreads > 1 && files.size() > 2) {
+      // The input graphs are loaded (and released after merging) by the pool, at most maxThreads of them
+      // ahead of the merge. The merge itself remains sequential in the order of the files.
+      columbus::thread::ThreadPool pool(maxThreads);
+      vector<columbus::thread::TaskFuture<shared_ptr<Graph> > > loadedGraphs(files.size());
+      size_t nextToLoad = 1;
+      for (size_t i = 1; i < files.size(); ++i) {
+        for (; nextToLoad < files.size() && nextToLoad <= i + maxThreads; ++nextToLoad) {
+          const string& file = files[nextToLoad];
+          loadedGraphs[nextToLoad] = pool.submit([&file]() {
+            shared_ptr<Graph> graph = make_shared<Graph>();
+            graph->loadBinary(file);
+            return graph;
+          });
+        }
+
+        WriteMsg::write(CMSG_MERGE_FILE, files[i].c_str());
+        shared_ptr<Graph> mergeGraph = loadedGraphs[i].get();
+        g.merge(*mergeGraph, Graph::mmUnionAttribute, Graph::csmmUnionNewAttributes, Graph::nmmSummarizeAttributes, Graph::mmUnionAttribute, Graph::csmmUnionNewAttributes, Graph::nmmSummarizeAttributes);
+        pool.submit([mergeGraph]() mutable { mergeGraph.reset(); });
+      }
+    } else {
+      for (size_t i = 1; i < files.size(); ++i) {
+        WriteMsg::write(CMSG_MERGE_FILE, files[i].c_str());
+        g.mergeWithBinary(files[i], Graph::mmUnionAttribute, Graph::csmmUnionNewAttributes, Graph::nmmSummarizeAttributes, Graph::mmUnionAttribute, Graph::csmmUnionNewAttributes, Graph::nmmSummarizeAttributes);
+      }
     }
     summarizeWarningMetricsByPriority(g, true); 
 
@@ -28,6 +28,7 @@
 #define CMSG_INVALID_MEMORY_VALUE           common::WriteMsg::mlError, "Error: Invalid maxmem value!\n"
 #define CMSG_FILTER_FILE_DEPRECATED         common::WriteMsg::mlWarning, "Warning: Filter file (%s) is older than the input file (.lim). Filter file is not used.\n"
 #define CMSG_CANNOT_OPEN_FILTER_FILE        common::WriteMsg::mlWarning, "Warning: Filter file cannot be loaded (%s)\n"
+#define CMSG_INVALID_PREFETCH_VALUE         common::WriteMsg::mlError, "Error: Invalid prefetch or prefetchmem value!\n"
 #define CMSG_MAXMEM_EXCEEDED                common::WriteMsg::mlError, "Error: Maximum memory exceeded, the remaining files are skipped.\n"
 
 //Warning messages
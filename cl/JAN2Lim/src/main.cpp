@@ -31,6 +31,10 @@
 #include <string>
 #include <list>
 #include <vector>
+#include <deque>
+#include <memory>
+
+#include <boost/filesystem/operations.hpp>
 
 #include <MainCommon.h>
 #include <ErrorCodes.h>
@@ -44,6 +48,7 @@
 #include <csi/inc/csi.h>
 #include <lim/inc/lim.h>
 #include <io/inc/CsvIO.h>
+#include <threadpool/inc/ThreadPool.h>
 
 #include "../inc/JAN2LimVisitor.h"
 #include "../inc/CheckVisitor.h"
@@ -80,8 +85,14 @@ namespace columbus { namespace JAN2Lim { namespace options
   static std::string maxmem;
   static unsigned maxMem = 0;
 
+  static std::string prefetch;
+  static unsigned prefetchFiles = 0;   // the number of files loaded ahead of the conversion
+  static std::string prefetchmem;
+  static unsigned long long prefetchMem = 0;  // the size of the files loaded ahead (0 means unlimited)
+
   void checkInputFiles();
   void checkMaxMem();
+  void checkPrefetch();
 
   void parse( int argc, char** argv)
   {
@@ -91,6 +102,7 @@ namespace columbus { namespace JAN2Lim { namespace options
     // validate parameters
     checkInputFiles();
     checkMaxMem();
+    checkPrefetch();
   }
 
   void checkInputFiles()
@@ -169,6 +181,30 @@ namespace columbus { namespace JAN2Lim { namespace options
     }
   }
 
+  void checkPrefetch()
+  {
+    int value = 0;
+    if ( !prefetch.empty() )
+    {
+      if ( !str2int(prefetch, value) || value < 0 )
+      {
+        WriteMsg::write(CMSG_INVALID_PREFETCH_VALUE);
+        clError();
+      }
+      prefetchFiles = (unsigned) value;
+    }
+
+    if ( !prefetchmem.empty() )
+    {
+      if ( !str2int(prefetchmem, value) || value < 0 )
+      {
+        WriteMsg::write(CMSG_INVALID_PREFETCH_VALUE);
+        clError();
+      }
+      prefetchMem = (unsigned long long) value * 1024 * 1024;
+    }
+  }
+
 }}} // end options, end JAN2Lim, end columbus
 
 // callbacks for argument processing
@@ -177,6 +213,8 @@ static bool ppOut           ( const Option *o, char *argv[] ) { options::out = a
 static bool ppNoFilt        ( const Option *o, char *argv[] ) { options::noFilter = true;         return true; }
 static bool ppMaxMem        ( const Option *o, char *argv[] ) { options::maxmem = argv[0];        return true; }
 static bool ppCompStruct    ( const Option *o, char *argv[] ) { options::compStructFile= argv[0]; return true; }
+static bool ppPrefetch      ( const Option *o, char *argv[] ) { options::prefetch = argv[0];      return true; }
+static bool ppPrefetchMem   ( const Option *o, char *argv[] ) { options::prefetchmem = argv[0];   return true; }
 static void ppFile          ( char *filename ) { columbus::JAN2Lim::options::inputFiles.push_back( filename ); }
 
 // the list of valid options
@@ -185,6 +223,8 @@ const Option OPTIONS_OBJ [] =
   { false,  "-out",               1,  "filename",           0, OT_WC | OT_WS,          ppOut,            NULL,       "Name of the output LIM file"},
   { false,  "-nofilter",          0,  "",                   0, OT_NONE,                ppNoFilt,         NULL,       "Filter files are not used"},
   { false,  "-maxmem",            1,  "number",             0, OT_WC,                  ppMaxMem,         NULL,       "Maximum usable memory (not converted files are written out)"},
+  { false,  "-prefetch",          1,  "number",             0, OT_WC,                  ppPrefetch,       NULL,       "The number of input files loaded, filtered and measured (Halstead) on worker threads while the current one is converted. Default value is 0 (no look-ahead)."},
+  { false,  "-prefetchmem",       1,  "number",             0, OT_WC,                  ppPrefetchMem,    NULL,       "The maximum total size (in MB) of the input files loaded ahead. At least one file is always loaded ahead. Default value is 0 (unlimited)."},
   CL_INPUT_LIST
   { false,  "-struct",            1, "ComponenetStructureFile",0, OT_WC,               ppCompStruct,     NULL,       "The file with the componenet structure. If it is missing the componet tree is assumed to be flat."},
   COMMON_CL_ARGS
@@ -195,13 +235,20 @@ const Option OPTIONS_OBJ [] =
 *                      UTILITY FUNCTIONS                            *
 ********************************************************************/
 
-void loadFilter( java::asg::Factory& fact, const string& file )
+enum FilterLoadResult
+{
+  flrLoaded,
+  flrDeprecated,
+  flrCannotOpen
+};
+
+// it does not write any message, so it can be called from the loader threads too
+FilterLoadResult loadFilter( java::asg::Factory& fact, const string& file )
 {
   string flt = pathRemoveExtension(file) + ".fjsi";
   if ( fileTimeCmp(flt, file) == -1 )
   {
-    WriteMsg::write(CMSG_FILTER_FILE_DEPRECATED, flt.c_str());
-    return;
+    return flrDeprecated;
   }
 
   try
@@ -210,10 +257,67 @@ void loadFilter( java::asg::Factory& fact, const string& file )
   }
   catch (const IOException&)
   {
-    WriteMsg::write(CMSG_CANNOT_OPEN_FILTER_FILE, flt.c_str());
+    return flrCannotOpen;
   }
+  return flrLoaded;
 }
 
+// a loaded, filtered and measured input file waiting for the conversion
+struct LoadedComponent
+{
+  LoadedComponent()
+    : factory( strTable )
+    , loaded( false )
+    , filterResult( flrLoaded )
+  {
+  }
+
+  RefDistributorStrTable strTable;
+  java::asg::Factory factory;
+  CsiHeader header;
+  bool loaded;
+  FilterLoadResult filterResult;
+  std::map<NodeId, HalsteadVisitor::HalsteadInfo> halMap;
+};
+
+// loads the input file and computes everything which does not need the lim graph
+std::unique_ptr<LoadedComponent> loadComponent( const string& file )
+{
+  std::unique_ptr<LoadedComponent> component( new LoadedComponent() );
+  try
+  {
+    component->factory.load( file, component->header );
+  }
+  catch (const IOException&)
+  {
+    return component;
+  }
+  component->loaded = true;
+
+  // filter init
+  if ( ! options::noFilter )
+  {
+    component->factory.turnFilterOn();
+    component->factory.initializeFilter();
+    component->filterResult = loadFilter( component->factory, file );
+
+    component->factory.turnFilterOff();
+  }
+
+  HalsteadVisitor halsteadVisitor( component->factory );
+  java::asg::AlgorithmPreorder().run( component->factory, halsteadVisitor );
+  component->halMap = halsteadVisitor.getHalsteadValues();
+  return component;
+}
+
+// an input file submitted to the loader threads
+struct PendingComponent
+{
+  string file;
+  unsigned long long size;
+  thread::TaskFuture<std::unique_ptr<LoadedComponent>> component;
+};
+
 static inline void setStartTime(unsigned long *time)
 {
   timestat usedtime= getProcessUsedTime();
@@ -374,21 +478,55 @@ int main( int argc, char* argv[] )
     }
   }
 
-  for ( list<string>::const_iterator it = options::inputFiles.begin(); it != options::inputFiles.end(); ++it )
+  // the next files are loaded on the worker threads while the current one is converted into the shared lim graph
+  std::unique_ptr<thread::ThreadPool> loaderPool;
+  if ( options::prefetchFiles > 0 )
+  {
+    unsigned threads = std::min<unsigned>( options::prefetchFiles, std::max( 1, thread::ThreadPool::getNumberOfCores() ) );
+    loaderPool.reset( new thread::ThreadPool( threads ) );
+  }
+  std::deque<PendingComponent> pending;
+  unsigned long long pendingSize = 0;
+  list<string>::const_iterator nextToLoad = options::inputFiles.begin();
+
+  // submits the next files until the look-ahead or its memory budget is full (the size of the file estimates the size of the asg)
+  auto fillPipeline = [&]()
   {
-    // creating factory
-    RefDistributorStrTable javaStrTable;
-    java::asg::Factory factory( javaStrTable );
+    while ( nextToLoad != options::inputFiles.end() && pending.size() < options::prefetchFiles )
+    {
+      boost::system::error_code ec;
+      unsigned long long size = boost::filesystem::file_size( *nextToLoad, ec );
+      if ( ec )
+        size = 0;
+      if ( !pending.empty() && options::prefetchMem != 0 && pendingSize + size > options::prefetchMem )
+        break;
+
+      string file = *nextToLoad++;
+      pending.push_back( PendingComponent{ file, size, loaderPool->submit( [file]() { return loadComponent( file ); } ) } );
+      pendingSize += size;
+    }
+  };
 
+  for ( list<string>::const_iterator it = options::inputFiles.begin(); it != options::inputFiles.end(); ++it )
+  {
     // load schema instance
     WriteMsg::write(CMSG_LOADING_FILE, it->c_str());
 
-    CsiHeader header;
-    try
+    std::unique_ptr<LoadedComponent> component;
+    if ( loaderPool )
     {
-      factory.load( it->c_str(), header );
+      fillPipeline();
+      component = pending.front().component.get();
+      pendingSize -= pending.front().size;
+      pending.pop_front();
+      fillPipeline();
     }
-    catch (const IOException&)
+    else
+    {
+      component = loadComponent( *it );
+    }
+
+    if ( !component->loaded )
     {
       WriteMsg::write(CMSG_WARN_CANNOT_READ_FILE, it->c_str());
       exitCode = 1;
@@ -396,31 +534,27 @@ int main( int argc, char* argv[] )
       continue;
     }
 
+    string flt = pathRemoveExtension( *it ) + ".fjsi";
+    if ( component->filterResult == flrDeprecated )
+      WriteMsg::write(CMSG_FILTER_FILE_DEPRECATED, flt.c_str());
+    else if ( component->filterResult == flrCannotOpen )
+      WriteMsg::write(CMSG_CANNOT_OPEN_FILTER_FILE, flt.c_str());
+
+    java::asg::Factory& factory = component->factory;
+    CsiHeader& header = component->header;
+
     // component name
     string compPath;
     header.get(CsiHeader::csih_OriginalLocation, compPath);
     if ( compPath.empty() ) compPath = *it;
 
-    // filter init
-    if ( ! options::noFilter )
-    {
-      factory.turnFilterOn();
-      factory.initializeFilter();
-      loadFilter( factory, *it );
-
-      factory.turnFilterOff();
-    }
-
     // JAN2Lim visitor is created and called
     WriteMsg::write(CMSG_CONVERTING_FILE, it->c_str());
     string  changesetID = "";
 
     header.get(CsiHeader::csih_ChangesetID, changesetID);
 
-    HalsteadVisitor halsteadVisitor( factory );
-    java::asg::AlgorithmPreorder().run( factory, halsteadVisitor );
-    std::map<NodeId, HalsteadVisitor::HalsteadInfo> halMap = halsteadVisitor.getHalsteadValues();
-    JAN2LimVisitor jan2LimVisitor(limFactory, factory, map, cgiMap, nodeStates, compPath, classStats, origin, overrides, options::compStructFile.empty(), false, changesetID, halMap);
+    JAN2LimVisitor jan2LimVisitor(limFactory, factory, map, cgiMap, nodeStates, compPath, classStats, origin, overrides, options::compStructFile.empty(), false, changesetID, std::move(component->halMap));
     java::asg::AlgorithmPreorder().run( factory, jan2LimVisitor );
     
     writeClassStats( classStats, limFactory );
@@ -434,6 +568,12 @@ int main( int argc, char* argv[] )
     }
   }
 
+  // the files loaded ahead are dropped when the conversion is stopped
+  for ( PendingComponent& pendingComponent : pending )
+    pendingComponent.component.cancel();
+  pending.clear();
+  loaderPool.reset();
+
   // finalizing and cleanup
   JAN2LimVisitor::setLineMetrics( limFactory );
   JAN2LimVisitor::filterInitBlocks( limFactory );
@@ -37,11 +37,15 @@
 #include "common/inc/WriteMessage.h"
 #include "common/inc/Arguments.h"
 #include "common/inc/Stat.h"
+#include "common/inc/StringSup.h"
 #include "csi/inc/csi.h"
 #include "lim2graph/inc/Lim2GraphConverter.h"
 #include <limmetrics/inc/LimMetrics.h>
+#include <limmetrics/inc/ParallelLimMetrics.h>
+#include <threadpool/inc/ThreadPool.h>
 #include "graphsupport/inc/CsvExporter.h"
 #include "graphsupport/inc/RulBuilder.h"
+#include "graphsupport/inc/MetricTable.h"
 
 
 //
@@ -67,6 +71,7 @@ static bool exportRul = false;
 static char csvSeparator = ',';
 static list<string> inputFiles;
 static string LCOMFile;
+static int maxThreads = 1;
 
 static bool ppGraph( const common::Option *o, char *argv[] ) {
   graphFile = argv[0];
@@ -103,6 +108,11 @@ static bool ppConvertInstances( const common::Option *o, char *argv[] ) {
   return true;
 }
 
+static bool ppMaxThreads( const common::Option *o, char *argv[] ) {
+  maxThreads = common::str2int( argv[0] );
+  return true;
+}
+
 static void ppFile( char *filename ) {
   inputFiles.push_back( filename );
 }
@@ -124,6 +134,7 @@ const common::Option OPTIONS_OBJ [] = {
   CL_CSVSEPARATOR
   { false,  "-pathlower",           0, "",                0, common::OT_NONE,           ppPathLower,          NULL,       "Paths are converted to lower case for writting out"},
   { false,   "-convertInstancesToo",0, "",                0, common::OT_NONE,           ppConvertInstances,   NULL,       "Convert the instance nodes too into the graph."},
+  { false,  "-maxThreads",          1, CL_KIND_NUMBER,    0, common::OT_WE | common::OT_WC, ppMaxThreads,  NULL,       "The maximum number of threads used for the metric calculation. The independent metric groups are calculated in parallel if it is greater than 1, 0 means the number of available CPU cores. The default value is 1."},
   CL_RUL_AND_RULCONFIG("MET.rul")
   CL_EXPORTRUL
   COMMON_CL_ARGS
@@ -273,8 +284,22 @@ int main(int argc, char *argv[]) {
     common::WriteMsg::write( CMSG_LIM2METRICS_DEBUG_VISITOR_RUN );
     setStartTime( &calculatingtime );
 
-    lim::metrics::LimMetricsVisitor visitor( limFact, limGraph, rul, shared );
-    visitor.run();
+    if ( maxThreads <= 0 ) {
+      maxThreads = columbus::thread::ThreadPool::getNumberOfCores();
+    }
+
+    // the metric values are kept in the table until the results are exported
+    graphsupport::MetricTable metricTable( limGraph );
+
+    if ( maxThreads > 1 ) {
+      lim::metrics::ParallelLimMetrics parallelMetrics( limFact, limGraph, rul, shared, maxThreads );
+      parallelMetrics.setMetricTable( &metricTable );
+      parallelMetrics.run();
+    } else {
+      lim::metrics::LimMetricsVisitor visitor( limFact, limGraph, rul, shared );
+      visitor.setMetricTable( &metricTable );
+      visitor.run();
+    }
     
     setElapsedTime( &calculatingtime );
     updateMemStat( &mem );
@@ -285,6 +310,8 @@ int main(int argc, char *argv[]) {
     common::WriteMsg::write( CMSG_LIM2METRICS_DEBUG_EXPORT_RESULTS );
     setStartTime( &exporttime );
 
+    metricTable.materialize();
+
     if ( ! csvFile.empty() ) {
       cout << "CSV export to " << csvFile << endl;
       graphsupport::exportReadableMetricsCSV( limGraph, csvFile, csvSeparator );
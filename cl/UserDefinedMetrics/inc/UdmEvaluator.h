@@ -0,0 +1,101 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _UDM_EVALUATOR_
+#define _UDM_EVALUATOR_
+
+#include "UdmCommon.h"
+#include "UdmNode.h"
+#include "UdmFunction.h"
+#include <memory>
+#include <unordered_map>
+
+using namespace std;
+using namespace columbus;
+
+// Evaluates the formulas on the Nodes of the graph. Every formula is compiled only once, its variables
+// are bound to slots, which are refilled from the metric attributes of the actual Node before the evaluation.
+class UdmEvaluator {
+
+private:
+
+    // Properties of a symbol (a variable of a formula or a metric attribute name)
+    struct Symbol {
+
+        string name;
+
+        // Whether exprtk accepts it as a constant name (valid and not reserved)
+        bool valid;
+
+        // The symbol is defined for the actual Node if its stamp equals to the actual stamp
+        unsigned stamp;
+    };
+
+    // A compiled formula with the symbols of its variables
+    struct Formula {
+
+        const UdmNode* udmNode;
+
+        exprtk::symbol_table<long double> symbolTable;
+
+        exprtk::expression<long double> expression;
+
+        vector<size_t> variables;
+    };
+
+    const map<string, UdmNode>& udm_nodes;
+
+    graph::Graph& graph;
+
+    // The aggregation functions shared by all of the compiled formulas
+    exprtk::symbol_table<long double> functionTable;
+    unique_ptr<UdmFunction::Inserter> inserter;
+
+    // Symbols by name (exprtk's symbol names are case insensitive)
+    map<string, size_t, exprtk::details::ilesscompare> symbolIds;
+    unordered_map<string, size_t> exactSymbolIds;
+    vector<Symbol> symbols;
+
+    // The values of the symbols, which are variables of a formula (the formulas refer to these elements)
+    unique_ptr<long double[]> slots;
+    size_t slotCount;
+
+    unsigned stamp;
+
+    map<string, Formula> formulas;
+
+    // Gives back the id of the symbol, registers it if it is new
+    size_t getSymbolId(const string& name);
+
+    // Defines the symbol for the actual Node, the first definition wins (like in case of exprtk::symbol_table::add_constant)
+    bool defineSymbol(size_t id, long double value);
+
+    // Compiling the formula as the original per Node evaluation did to get the same error message
+    void throwCompileError(const UdmNode& udmNode);
+
+public:
+
+    UdmEvaluator(const map<string, UdmNode>& udm_nodes, graph::Graph& graph);
+
+    // Calculate the Node's metrics, which are in the dependency vector and write it to the graph
+    void evaluateNode(graph::Node& node, const vector<string>& dependency);
+};
+
+#endif
@@ -66,7 +66,7 @@ private:
 
 protected:
 
-    const graph::Node node;
+    graph::Node node;
     
     // Get the collected values and do some calculation
     virtual long double aggr(const vector<long double>& metricsValues) = 0;
@@ -78,6 +78,9 @@ public:
 
     // Main logic, called to calculate the function's value
     long double operator ()(parameter_list_t parameters);
+
+    // Changing the Node, whose children are aggregated (the compiled expressions can be reused for every Node)
+    void setNode(const graph::Node& node);
     
     // Inserting the defined functions into the symbolTable 
     class Inserter {
@@ -93,6 +96,12 @@ public:
 
         Inserter(exprtk::symbol_table<long double>& symbolTable, const graph::Node& node, vector<pair<set<string>, string>>* aggrCalcFors = NULL);
         ~Inserter();
+
+        // Inserting the same functions into another symbolTable
+        void insert(exprtk::symbol_table<long double>& symbolTable);
+
+        // Changing the Node of all of the functions
+        void setNode(const graph::Node& node);
     };
     
     const string& getName() const;
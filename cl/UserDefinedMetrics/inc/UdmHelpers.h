@@ -24,6 +24,7 @@
 #include "UdmCommon.h"
 #include "UdmNode.h"
 #include "UdmFunction.h"
+#include "UdmEvaluator.h"
 #include "graphsupport/inc/Metric.h"
 #include "rul/inc/RulHandler.h"
 
@@ -0,0 +1,255 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/UdmEvaluator.h"
+#include "graphsupport/inc/Metric.h"
+#include <limits>
+
+// The built-in constants added by exprtk::symbol_table::add_constants(), after the metrics of the Node
+static const char* builtinConstantNames[] = { "pi", "epsilon", "inf" };
+
+static long double builtinConstantValue(size_t index) {
+
+    switch (index) {
+        case 0: return static_cast<long double>(exprtk::details::numeric::constant::pi);
+        case 1: return exprtk::details::numeric::details::epsilon_type<long double>::value();
+        default: return numeric_limits<long double>::infinity();
+    }
+}
+
+UdmEvaluator::UdmEvaluator(const map<string, UdmNode>& udm_nodes, graph::Graph& graph) :
+    udm_nodes(udm_nodes), graph(graph), functionTable(), inserter(), symbolIds(), exactSymbolIds(), symbols(), slots(), slotCount(0), stamp(0), formulas() {
+
+    inserter = make_unique<UdmFunction::Inserter>(functionTable, graph::Graph::invalidNode);
+
+    //
+    // COLLECTING THE VARIABLES OF THE FORMULAS
+    //
+
+    map<string, deque<string>> formulaVariables;
+    for (const auto& udm_node : udm_nodes) {
+
+        exprtk::symbol_table<long double> symbolTable;
+        exprtk::expression<long double> expression;
+        exprtk::parser<long double> parser;
+        inserter->insert(symbolTable);
+        expression.register_symbol_table(symbolTable);
+
+        // The formulas are already checked by loadFormulaAttributes()
+        parser.enable_unknown_symbol_resolver();
+        if (!parser.compile(udm_node.second.getFormula(), expression)) {
+            const string& metricName = udm_node.first;
+            throw Exception(COLUMBUS_LOCATION, CMSG_UDM_EX_WRONG_FORMULA_EXPRESSION);
+        }
+
+        deque<string>& variables = formulaVariables[udm_node.first];
+        symbolTable.get_variable_list(variables);
+        for (const string& variable : variables) {
+            getSymbolId(variable);
+        }
+    }
+
+    for (const char* name : builtinConstantNames) {
+        getSymbolId(name);
+    }
+
+    // Only the variables of the formulas need slots
+    slotCount = symbols.size();
+    slots = make_unique<long double[]>(slotCount);
+
+    //
+    // COMPILING THE FORMULAS WITH THEIR VARIABLES BOUND TO THE SLOTS
+    //
+
+    exprtk::parser<long double> parser;
+    for (const auto& udm_node : udm_nodes) {
+
+        Formula& formula = formulas[udm_node.first];
+        formula.udmNode = &udm_node.second;
+        inserter->insert(formula.symbolTable);
+
+        for (const string& variable : formulaVariables[udm_node.first]) {
+            size_t id = getSymbolId(variable);
+            formula.symbolTable.add_variable(variable, slots[id]);
+            formula.variables.push_back(id);
+        }
+
+        formula.expression.register_symbol_table(formula.symbolTable);
+        if (!parser.compile(udm_node.second.getFormula(), formula.expression)) {
+            const string& metricName = udm_node.first;
+            throw Exception(COLUMBUS_LOCATION, CMSG_UDM_EX_WRONG_FORMULA_EXPRESSION);
+        }
+    }
+}
+
+size_t UdmEvaluator::getSymbolId(const string& name) {
+
+    auto exactIt = exactSymbolIds.find(name);
+    if (exactIt != exactSymbolIds.end()) {
+        return exactIt->second;
+    }
+
+    size_t id;
+    auto it = symbolIds.find(name);
+    if (it != symbolIds.end()) {
+        id = it->second;
+    }
+    else {
+
+        // Checking whether exprtk would accept the name (it must not be reserved or used by a function)
+        exprtk::symbol_table<long double> symbolTable;
+        inserter->insert(symbolTable);
+        bool valid = symbolTable.add_constant(name, 0);
+
+        id = symbols.size();
+        symbols.push_back(Symbol{ name, valid, 0 });
+        symbolIds.insert(make_pair(name, id));
+    }
+
+    exactSymbolIds.insert(make_pair(name, id));
+    return id;
+}
+
+bool UdmEvaluator::defineSymbol(size_t id, long double value) {
+
+    Symbol& symbol = symbols[id];
+    if (!symbol.valid || symbol.stamp == stamp) {
+        return false;
+    }
+
+    symbol.stamp = stamp;
+    if (id < slotCount) {
+        slots[id] = value;
+    }
+    return true;
+}
+
+void UdmEvaluator::throwCompileError(const UdmNode& udmNode) {
+
+    exprtk::symbol_table<long double> symbolTable;
+    exprtk::expression<long double> expression;
+    exprtk::parser<long double> parser;
+    inserter->insert(symbolTable);
+    expression.register_symbol_table(symbolTable);
+
+    for (size_t id = 0; id < slotCount; ++id) {
+        if (symbols[id].stamp == stamp) {
+            symbolTable.add_constant(symbols[id].name, slots[id]);
+        }
+    }
+
+    // It fails because of the first undefined variable
+    parser.compile(udmNode.getFormula(), expression);
+    const string& metricName = udmNode.getMetricName();
+    throw Exception(COLUMBUS_LOCATION, CMSG_UDM_EX_WRONG_FORMULA_EXPRESSION);
+}
+
+void UdmEvaluator::evaluateNode(graph::Node& node, const vector<string>& dependency) {
+
+    // Starting a new set of symbol definitions
+    if (++stamp == 0) {
+        for (Symbol& symbol : symbols) {
+            symbol.stamp = 0;
+        }
+        stamp = 1;
+    }
+
+    inserter->setNode(node);
+
+    //
+    // GETTING NODE'S "metric" TYPE ATTRIBUTES AND STORING THEM INTO THE SLOTS
+    //
+
+    graph::Attribute::AttributeIterator aI = node.findAttributeByContext(graphsupport::graphconstants::CONTEXT_METRIC);
+    while (aI.hasNext()) {
+        long double a;
+        graph::Attribute& attr = aI.next();
+
+        if (attr.getType() == graph::Attribute::atInt) {
+
+            graph::AttributeInt& aInt = dynamic_cast<graph::AttributeInt&>(attr);
+            a = aInt.getValue();
+        }
+        else {
+            if (attr.getType() == graph::Attribute::atFloat) {
+
+                graph::AttributeFloat& aFloat = dynamic_cast<graph::AttributeFloat&>(attr);
+                a = aFloat.getValue();
+            }
+            else {
+                a = 0;
+            }
+        }
+        if (!defineSymbol(getSymbolId(attr.getName()), a)) {
+            WriteMsg::write(CMSG_UDM_CANT_ADD_VARIABLE, attr.getName().c_str());
+        }
+    }
+
+    // Defining the constants: Pi, Epsilon, Infinity (add_constants() stops at the first already defined one)
+    for (size_t i = 0; i < sizeof(builtinConstantNames) / sizeof(builtinConstantNames[0]); ++i) {
+        if (!defineSymbol(getSymbolId(builtinConstantNames[i]), builtinConstantValue(i))) {
+            break;
+        }
+    }
+
+    //
+    // CALCULATING THE FORMULA AND INSERTING ITS VALUE IN THE GRAPH
+    //
+
+    for (const string& metricName : dependency) {
+        // Checking whether the current node's type is in the current formulas calculated attributes
+        Formula& formula = formulas.find(metricName)->second;
+        const UdmNode& depUdmNode = *formula.udmNode;
+        const set<string>& depCalcFors = depUdmNode.getCalcFors();
+        if (depCalcFors.find(node.getType().getType()) != depCalcFors.end()) {
+
+            for (size_t id : formula.variables) {
+                if (symbols[id].stamp != stamp) {
+                    throwCompileError(depUdmNode);
+                }
+            }
+
+            //
+            // CREATING A METRIC TYPE ATTRIBUTE WITH THE VALUE OF THE EXPRESSION(formula)
+            //
+
+            long double a = formula.expression.value();
+
+            if (depUdmNode.getFormulaType() == "Float") {
+                graphsupport::setMetricFloat(graph, node, metricName, static_cast<float>(a));
+                if (node.findAttributeByName(metricName).hasNext()) {
+                    // Checking whether the Metric is invalid is done separately, afterwards
+                    // because setMetricFloat() can create invalid metrics, silently
+                    if (graphsupport::isINVALID(node.findAttributeByName(metricName).next())) {
+                        WriteMsg::write(CMSG_UDM_INVALID_ATTRIBUTE, metricName.c_str(), node.getUID().c_str());
+                        warning = true;
+                    }
+                }
+            }
+            else {
+                graphsupport::setMetricInt(graph, node, metricName, static_cast<int>(a));
+            }
+
+            if (!defineSymbol(getSymbolId(metricName), a)) {
+                WriteMsg::write(CMSG_UDM_CANT_ADD_VARIABLE, metricName.c_str());
+            }
+        }
+    }
+}
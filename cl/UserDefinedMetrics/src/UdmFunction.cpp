@@ -112,6 +112,11 @@ long double UdmFunction::operator()(parameter_list_t parameters) {
     return aggr(derivedMetricValues);
 }
 
+void UdmFunction::setNode(const graph::Node& node) {
+
+    this->node = node;
+}
+
 const string& UdmFunction::getName() const{
 
     return functionName;
@@ -185,11 +190,23 @@ UdmFunction::Inserter::Inserter(exprtk::symbol_table<long double>& symbolTable,
     min = new MIN(node, aggrCalcFors);
     max = new MAX(node, aggrCalcFors);
 
+    insert(symbolTable);
+}
+
+void UdmFunction::Inserter::insert(exprtk::symbol_table<long double>& symbolTable) {
+
     if (!symbolTable.add_function(sum->getName(), *sum)) { WriteMsg::write(CMSG_UDM_CANT_ADD_FUNCTION, sum->getName().c_str()); }
     if (!symbolTable.add_function(avg->getName(), *avg)) { WriteMsg::write(CMSG_UDM_CANT_ADD_FUNCTION, avg->getName().c_str()); }
     if (!symbolTable.add_function(min->getName(), *min)) { WriteMsg::write(CMSG_UDM_CANT_ADD_FUNCTION, min->getName().c_str()); }
     if (!symbolTable.add_function(max->getName(), *max)) { WriteMsg::write(CMSG_UDM_CANT_ADD_FUNCTION, max->getName().c_str()); }
+}
+
+void UdmFunction::Inserter::setNode(const graph::Node& node) {
 
+    sum->setNode(node);
+    avg->setNode(node);
+    min->setNode(node);
+    max->setNode(node);
 }
 
 UdmFunction::Inserter::~Inserter() {
@@ -295,98 +295,17 @@ void buildDependency(vector<vector<string>>& passVector, map<string, UdmNode>& u
 
 }
 
-// Calculate the Node's metrics, which are in the dependency vector and write it to the graph
-void evaluateNode(graph::Node& node, const map<string, UdmNode>& udm_nodes, const vector<string>& dependency, graph::Graph& graph) {
-
-    exprtk::symbol_table<long double> symbolTable;
-    exprtk::expression<long double> expression;
-    exprtk::parser<long double> parser;
-    expression.register_symbol_table(symbolTable);
-
-    // Inserting the aggregations functions
-    UdmFunction::Inserter inserter(symbolTable, node);
-
-    //
-    // GETTING NODE'S "metric" TYPE ATTRIBUTES AND ADDING THEM TO THE SYMBOL TABLE
-    //
-
-    graph::Attribute::AttributeIterator aI = node.findAttributeByContext(graphsupport::graphconstants::CONTEXT_METRIC);
-    while (aI.hasNext()) {
-        long double a;
-        graph::Attribute& attr = aI.next();
-
-        if (attr.getType() == graph::Attribute::atInt) {
-
-            graph::AttributeInt& aInt = dynamic_cast<graph::AttributeInt&>(attr);
-            a = aInt.getValue();
-        }
-        else {
-            if (attr.getType() == graph::Attribute::atFloat) {
-
-                graph::AttributeFloat& aFloat = dynamic_cast<graph::AttributeFloat&>(attr);
-                a = aFloat.getValue();
-            }
-            else {
-                a = 0;
-            }
-        }
-        if (!symbolTable.add_constant(attr.getName(), a)) {
-            WriteMsg::write(CMSG_UDM_CANT_ADD_VARIABLE, attr.getName().c_str());
-        }
-    }
-    symbolTable.add_constants();  // Defining the constants: Pi, Epsilon, Infinity
-
-    //
-    // CALCULATING THE FORMULA AND INSERTING ITS VALUE IN THE GRAPH
-    //
-
-    for (const string& metricName : dependency) {
-        // Checking whether the current node's type is in the current formulas calculated attributes
-        const UdmNode& depUdmNode = udm_nodes.find(metricName)->second;
-        const set<string>& depCalcFors = depUdmNode.getCalcFors();
-        if (depCalcFors.find(node.getType().getType()) != depCalcFors.end()) {
-            if (!parser.compile(udm_nodes.find(metricName)->second.getFormula(), expression)) {
-                throw Exception(COLUMBUS_LOCATION, CMSG_UDM_EX_WRONG_FORMULA_EXPRESSION);
-            }
-            else {
-
-                //
-                // CREATING A METRIC TYPE ATTRIBUTE WITH THE VALUE OF THE EXPRESSION(formula)
-                //
-
-                long double a = expression.value();
-
-                if (depUdmNode.getFormulaType() == "Float") {
-                    graphsupport::setMetricFloat(graph, node, metricName, static_cast<float>(a));
-                    if (node.findAttributeByName(metricName).hasNext()) {
-                        // Checking whether the Metric is invalid is done separately, afterwards
-                        // because setMetricFloat() can create invalid metrics, silently
-                        if (graphsupport::isINVALID(node.findAttributeByName(metricName).next())) {
-                            WriteMsg::write(CMSG_UDM_INVALID_ATTRIBUTE, metricName.c_str(), node.getUID().c_str());
-                            warning = true;
-                        }
-                    }
-                }
-                else {
-                    graphsupport::setMetricInt(graph, node, metricName, static_cast<int>(a));
-                }
-
-                if (!symbolTable.add_constant(metricName, a)) {
-                    WriteMsg::write(CMSG_UDM_CANT_ADD_VARIABLE, metricName.c_str());
-                }
-            }
-        }
-    }
-}
-
 void evaluateGraph(const map<string, UdmNode>& udm_nodes, const vector<vector<string>>& passVector, graph::Graph& graph) {
 
+    // Compiling the formulas only once
+    UdmEvaluator evaluator(udm_nodes, graph);
+
     for (const vector<string>& pass : passVector) {
 
         graph::Node::NodeIterator nodeIter = graph.getNodes();
         while (nodeIter.hasNext()) {
             graph::Node currentNode = nodeIter.next();
-            evaluateNode(currentNode, udm_nodes, pass, graph);
+            evaluator.evaluateNode(currentNode, pass);
         }
     }
 }
@@ -0,0 +1,59 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _COLUMBUS_BENCHMARK_H_
+#define _COLUMBUS_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+* \file Benchmark.h
+* \brief Common measurement helper of the on-demand microbenchmarks (see add_benchmark in UtilityFunctions.cmake).
+*
+* The benchmarks do not contain former implementations to compare with:
+* - BinaryIOBenchmark uses only interfaces which older revisions also have, build it at both revisions and compare their outputs.
+* - SuffixArrayBenchmark needs the thread pool interfaces of the suffix array (LinearSuffixArray(sequence, pool) and
+*   run(visitor, pool)), so it does not build at older revisions. It compares the single thread and the parallel runs instead.
+*/
+
+namespace columbus { namespace benchmark {
+
+  /**
+  * \brief Runs the function once and prints its running time and throughput.
+  * \param name   [in] The name of the measured operation.
+  * \param amount [in] The amount of work done by the function.
+  * \param unit   [in] The unit of the amount (e.g. "MB").
+  * \param func   [in] The measured function. It returns a checksum of its results, which keeps the work from being optimized away and lets the runs be compared.
+  * \return The running time in seconds.
+  */
+  template <class Function>
+  double measure(const char* name, double amount, const char* unit, Function func) {
+    auto start = std::chrono::steady_clock::now();
+    auto checksum = func();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-36s %12.1f %s/s  (%.3f s, checksum %s)\n", name, amount / seconds, unit, seconds, std::to_string(checksum).c_str());
+    return seconds;
+  }
+
+}}
+
+#endif
@@ -306,6 +306,9 @@ let transform = function (astSet, parsingOptions) {
             }
         });
     });
+    // the nodes of the first traverse are created at once
+    globals.flushNodes();
+
     astSet.forEach(ast => {
         globals.setActualFile(ast.filename);
 
@@ -325,6 +328,7 @@ let transform = function (astSet, parsingOptions) {
             // }
         });
     });
+    globals.flushEdges();
     console.log("Transform finished!");
 };
 
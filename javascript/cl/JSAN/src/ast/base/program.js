@@ -30,22 +30,19 @@ export default function (node, parent, firstVisit) {
     //new program => clear comments
 
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const program = factory.createProgramWrapper();
-        program.setName(path.basename(actualJsFilePath, path.extname(actualJsFilePath)));
-        globals.setPositionInfo(node, program);
-        factory.getRoot().addPrograms(program);
-        program.setSourceType(conversions.convertSourceType(node.sourceType));
-        return program;
+        globals.createNode(node, globals.NodeKind.ndkProgram, path.basename(actualJsFilePath, path.extname(actualJsFilePath)));
     } else {
         const programWrapper = globals.getWrapperOfNode(node);
+        factory.getRoot().addPrograms(programWrapper);
+        programWrapper.setSourceType(conversions.convertSourceType(node.sourceType));
         if (node.body != null) {
             for (let i = 0; i < node.body.length; i++) {
                 if (node.body[i] != null) {
 
-                    globals.safeSet(programWrapper, "addBody", node.body[i], "PROGRAM - Cannot add body to program!");
+                    globals.addEdge(node, globals.EdgeKind.edkProgram_HasBody, node.body[i], "PROGRAM - Cannot add body to program!");
                 }
             }
         }
@@ -20,29 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const classDeclaration = factory.createClassDeclarationWrapper();
-        globals.setPositionInfo(node, classDeclaration);
-        return classDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkClassDeclaration);
     } else {
-        const classDeclarationWrapper = globals.getWrapperOfNode(node);
-
         if (node.superClass != null) {
-            globals.safeSet(classDeclarationWrapper, "setSuperClass", node.superClass, "CLASSDECLARATION - Could not add superClass!");
+            globals.addEdge(node, globals.EdgeKind.edkClass_HasSuperClass, node.superClass, "CLASSDECLARATION - Could not add superClass!");
         }
 
         if (node.body != null) {
-            globals.safeSet(classDeclarationWrapper, "setBody", node.body, "CLASSDECLARATION - Could not set body");
+            globals.addEdge(node, globals.EdgeKind.edkClass_HasBody, node.body, "CLASSDECLARATION - Could not set body");
         }
 
         if (node.id != null) {
-            globals.safeSet(classDeclarationWrapper, "setIdentifier", node.id, "CLASSDECLARATION - Could not set Identifier");
+            globals.addEdge(node, globals.EdgeKind.edkClass_HasIdentifier, node.id, "CLASSDECLARATION - Could not set Identifier");
         }
 
     }
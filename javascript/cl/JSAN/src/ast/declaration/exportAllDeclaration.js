@@ -21,24 +21,19 @@
 import * as globals from '../../globals.js';
 import {createASGNode} from '../astTransformer';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const exportAllDeclaration = factory.createExportAllDeclarationWrapper();
-        globals.setPositionInfo(node, exportAllDeclaration);
-        return exportAllDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkExportAllDeclaration);
     } else {
-        const exportAllDeclarationWrapper = globals.getWrapperOfNode(node);
         if (node.source !== null) {
-            globals.safeSet(exportAllDeclarationWrapper, "setSource", node.source, "EXPORTALLDECLARATION - Could not set source node!");
+            globals.addEdge(node, globals.EdgeKind.edkExportAllDeclaration_HasSource, node.source, "EXPORTALLDECLARATION - Could not set source node!");
         }
 
         if (node.exported !== null) {
-            globals.safeSet(exportAllDeclarationWrapper, "setExported", node.exported, "EXPORTALLDECLARATION - Could not set exported node!")
+            globals.addEdge(node, globals.EdgeKind.edkExportAllDeclaration_HasExported, node.exported, "EXPORTALLDECLARATION - Could not set exported node!")
         }
     }
 }
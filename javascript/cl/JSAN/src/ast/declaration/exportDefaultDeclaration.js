@@ -20,21 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const exportDefaultDeclaration = factory.createExportDefaultDeclarationWrapper();
-        globals.setPositionInfo(node, exportDefaultDeclaration);
-        return exportDefaultDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkExportDefaultDeclaration);
     } else {
-        const exportDefaultDeclarationWrapper = globals.getWrapperOfNode(node);
-
         if (node.declaration != null) {
-            globals.safeSet(exportDefaultDeclarationWrapper, "setDeclaration", node.declaration, "EXPORTDEFAULTDECLARATION - Could not set declaration!");
+            globals.addEdge(node, globals.EdgeKind.edkExportDefaultDeclaration_HasDeclaration, node.declaration, "EXPORTDEFAULTDECLARATION - Could not set declaration!");
         }
     }
 }
@@ -20,31 +20,25 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const exportNamedDeclaration = factory.createExportNamedDeclarationWrapper();
-        globals.setPositionInfo(node, exportNamedDeclaration);
-        return exportNamedDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkExportNamedDeclaration);
     } else {
-        const exportNamedDeclarationWrapper = globals.getWrapperOfNode(node);
-
         if (node.source != null) {
-            globals.safeSet(exportNamedDeclarationWrapper, "setSource", node.source, "EXPORTNAMEDDECLARATION - Could not set source!");
+            globals.addEdge(node, globals.EdgeKind.edkExportNamedDeclaration_HasSource, node.source, "EXPORTNAMEDDECLARATION - Could not set source!");
         }
 
         if (node.declaration != null) {
-            globals.safeSet(exportNamedDeclarationWrapper, "setDeclaration", node.declaration, "EXPORTNAMEDDECLARATION - Could not set declaration!")
+            globals.addEdge(node, globals.EdgeKind.edkExportNamedDeclaration_HasDeclaration, node.declaration, "EXPORTNAMEDDECLARATION - Could not set declaration!")
         }
 
         if (node.specifiers != null) {
             for (let i = 0; i < node.specifiers.length; i++) {
                 if (node.specifiers[i] != null) {
-                    globals.safeSet(exportNamedDeclarationWrapper, "addSpecifiers", node.specifiers[i], "EXPORTNAMEDDECLARATION - Could not add specifier!")
+                    globals.addEdge(node, globals.EdgeKind.edkExportNamedDeclaration_HasSpecifiers, node.specifiers[i], "EXPORTNAMEDDECLARATION - Could not add specifier!")
                 }
             }
         }
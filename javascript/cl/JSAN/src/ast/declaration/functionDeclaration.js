@@ -20,25 +20,21 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const functionDeclaration = factory.createFunctionDeclarationWrapper();
-        globals.setPositionInfo(node, functionDeclaration);
-        functionDeclaration.setGenerator(node.generator);
-        functionDeclaration.setAsync(node.async);
-        return functionDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkFunctionDeclaration);
     } else {
         const functionDeclarationWrapper = globals.getWrapperOfNode(node);
+        functionDeclarationWrapper.setGenerator(node.generator);
+        functionDeclarationWrapper.setAsync(node.async);
 
         if (node.params != null) {
             for (let i = 0; i < node.params.length; i++) {
                 if (node.params[i] != null) {
-                    globals.safeSet(functionDeclarationWrapper, "addParams", node.params[i], "FUNCTIONDECLARATION - Could not add param");
+                    globals.addEdge(node, globals.EdgeKind.edkFunction_HasParams, node.params[i], "FUNCTIONDECLARATION - Could not add param");
                 }
             }
         }
@@ -48,11 +44,11 @@ export default function (node, parent, firstVisit) {
         }
 
         if (node.body != null) {
-            globals.safeSet(functionDeclarationWrapper, "setBody", node.body, "FUNCTIONDECLARATION - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkFunction_HasBody, node.body, "FUNCTIONDECLARATION - Could not set body!");
         }
 
         if (node.id != null) {
-            globals.safeSet(functionDeclarationWrapper, "setIdentifier", node.id, "FUNCTIONDECLARATION - Could not set identifier!");
+            globals.addEdge(node, globals.EdgeKind.edkFunction_HasIdentifier, node.id, "FUNCTIONDECLARATION - Could not set identifier!");
         }
 
     }
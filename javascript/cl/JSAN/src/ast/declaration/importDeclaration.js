@@ -20,27 +20,21 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const importDeclaration = factory.createImportDeclarationWrapper();
-        globals.setPositionInfo(node, importDeclaration);
-        return importDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkImportDeclaration);
     } else {
-        const importDeclarationWrapper = globals.getWrapperOfNode(node);
-
         if (node.source != null) {
-            globals.safeSet(importDeclarationWrapper, "setSource", node.source, "IMPORTDECLARATION - Could not set source!");
+            globals.addEdge(node, globals.EdgeKind.edkImportDeclaration_HasSource, node.source, "IMPORTDECLARATION - Could not set source!");
         }
 
         if (node.specifiers != null) {
             for (let i = 0; i < node.specifiers.length; i++) {
                 if (node.specifiers[i] != null) {
-                    globals.safeSet(importDeclarationWrapper, "addSpecifiers", node.specifiers[i], "IMPORTDECLARATION - Could not add specifiers!");
+                    globals.addEdge(node, globals.EdgeKind.edkImportDeclaration_HasSpecifiers, node.specifiers[i], "IMPORTDECLARATION - Could not add specifiers!");
                 }
             }
         }
@@ -21,23 +21,19 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const variableDeclaration = factory.createVariableDeclarationWrapper();
-        globals.setPositionInfo(node, variableDeclaration);
-        variableDeclaration.setKind(conversions.convertDeclarationKind(node.kind));
-        return variableDeclaration;
+        globals.createNode(node, globals.NodeKind.ndkVariableDeclaration);
     } else {
         const variableDeclarationWrapper = globals.getWrapperOfNode(node);
+        variableDeclarationWrapper.setKind(conversions.convertDeclarationKind(node.kind));
         if (node.declarations != null) {
             for (let i = 0; i < node.declarations.length; i++) {
                 if (node.declarations[i] != null) {
-                    globals.safeSet(variableDeclarationWrapper, "addDeclarations", node.declarations[i], "VARIABLEDECLARATION - Could not add declaration!");
+                    globals.addEdge(node, globals.EdgeKind.edkVariableDeclaration_HasDeclarations, node.declarations[i], "VARIABLEDECLARATION - Could not add declaration!");
                 }
             }
         }
@@ -20,26 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const variableDeclarator = factory.createVariableDeclaratorWrapper();
-        globals.setPositionInfo(node, variableDeclarator);
-
-        return variableDeclarator;
+        globals.createNode(node, globals.NodeKind.ndkVariableDeclarator);
     } else {
-        const variableDeclaratorWrapper = globals.getWrapperOfNode(node);
-
         if (node.init != null) {
-            globals.safeSet(variableDeclaratorWrapper, "setInit", node.init, "VARIABLEDECLARATOR - Could not set init!");
+            globals.addEdge(node, globals.EdgeKind.edkVariableDeclarator_HasInit, node.init, "VARIABLEDECLARATOR - Could not set init!");
         }
 
         if (node.id != null) {
-            globals.safeSet(variableDeclaratorWrapper, "setIdentifier", node.id, "VARIABLEDECLARATOR - Could not set identifier!");
+            globals.addEdge(node, globals.EdgeKind.edkVariableDeclarator_HasIdentifier, node.id, "VARIABLEDECLARATOR - Could not set identifier!");
         }
 
     }
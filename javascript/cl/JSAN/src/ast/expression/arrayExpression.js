@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const arrayExpression = factory.createArrayExpressionWrapper();
-        globals.setPositionInfo(node, arrayExpression);
-        return arrayExpression;
+        globals.createNode(node, globals.NodeKind.ndkArrayExpression);
     } else {
-        const arrayExpressionWrapper = globals.getWrapperOfNode(node);
         if (node.elements != null) {
             for (let i = 0; i < node.elements.length; i++) {
                 if (node.elements[i] != null) {
-                    globals.safeSet(arrayExpressionWrapper, "addElements", node.elements[i], "ARRAYEXPRESSION - Could not add element!");
+                    globals.addEdge(node, globals.EdgeKind.edkArrayExpression_HasElements, node.elements[i], "ARRAYEXPRESSION - Could not add element!");
                 }
             }
         }
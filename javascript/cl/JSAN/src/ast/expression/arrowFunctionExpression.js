@@ -20,36 +20,32 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const arrowFunctionExpression = factory.createArrowFunctionExpressionWrapper();
-        globals.setPositionInfo(node, arrowFunctionExpression);
-        arrowFunctionExpression.setExpression(node.expression);
-        arrowFunctionExpression.setGenerator(node.generator);
-        arrowFunctionExpression.setAsync(node.async);
-        return arrowFunctionExpression;
+        globals.createNode(node, globals.NodeKind.ndkArrowFunctionExpression);
     } else {
         const arrowFunctionExpressionWrapper = globals.getWrapperOfNode(node);
+        arrowFunctionExpressionWrapper.setExpression(node.expression);
+        arrowFunctionExpressionWrapper.setGenerator(node.generator);
+        arrowFunctionExpressionWrapper.setAsync(node.async);
 
         if (node.params != null) {
             for (let i = 0; i < node.params.length; i++) {
                 if (node.params[i] != null) {
-                    globals.safeSet(arrowFunctionExpressionWrapper, "addParams", node.params[i], "ARROWFUNCTIONEXPRESSION - Could not add param!");
+                    globals.addEdge(node, globals.EdgeKind.edkFunction_HasParams, node.params[i], "ARROWFUNCTIONEXPRESSION - Could not add param!");
                 }
             }
         }
 
         if (node.body != null) {
-            globals.safeSet(arrowFunctionExpressionWrapper, "setBody", node.body, "ARROWFUNCTIONEXPRESSION - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkFunction_HasBody, node.body, "ARROWFUNCTIONEXPRESSION - Could not set body!");
         }
 
         if (node.id != null) {
-            globals.safeSet(arrowFunctionExpressionWrapper, "setIdentifier", node.id, "ARROWFUNCTIONEXPRESSION - Could not set identifier!");
+            globals.addEdge(node, globals.EdgeKind.edkFunction_HasIdentifier, node.id, "ARROWFUNCTIONEXPRESSION - Could not set identifier!");
         }
     }
 }
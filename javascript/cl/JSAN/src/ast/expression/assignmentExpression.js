@@ -21,26 +21,22 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const assignmentExpression = factory.createAssignmentExpressionWrapper();
-        globals.setPositionInfo(node, assignmentExpression);
-        assignmentExpression.setOperator(conversions.convertOperatorToString(node.operator));
-        return assignmentExpression;
+        globals.createNode(node, globals.NodeKind.ndkAssignmentExpression);
     } else {
         const assignmentExpressionWrapper = globals.getWrapperOfNode(node);
+        assignmentExpressionWrapper.setOperator(conversions.convertOperatorToString(node.operator));
 
         if (node.left != null) {
-            globals.safeSet(assignmentExpressionWrapper, "setLeft", node.left, "ASSIGNMENTEXPRESSION - Could not set left!");
+            globals.addEdge(node, globals.EdgeKind.edkAssignmentExpression_HasLeft, node.left, "ASSIGNMENTEXPRESSION - Could not set left!");
         }
 
         if (node.right != null) {
-            globals.safeSet(assignmentExpressionWrapper, "setRight", node.right, "ASSIGNMENTEXPRESSION - Could not set right!");
+            globals.addEdge(node, globals.EdgeKind.edkAssignmentExpression_HasRight, node.right, "ASSIGNMENTEXPRESSION - Could not set right!");
         }
     }
 }
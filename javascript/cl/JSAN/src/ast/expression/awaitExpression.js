@@ -20,21 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const awaitExpr = factory.createAwaitExpressionWrapper();
-        globals.setPositionInfo(node, awaitExpr);
-        return awaitExpr;
+        globals.createNode(node, globals.NodeKind.ndkAwaitExpression);
     } else {
-        const awaitExprWrapper = globals.getWrapperOfNode(node);
-
         if (node.argument != null) {
-            globals.safeSet(awaitExprWrapper, "setArgument", node.argument, "AWAITEXPRESSION - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkAwaitExpression_HasArgument, node.argument, "AWAITEXPRESSION - Could not set argument!");
         }
     }
 }
@@ -21,26 +21,22 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js'
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const binaryExpression = factory.createBinaryExpressionWrapper();
-        globals.setPositionInfo(node, binaryExpression);
-        binaryExpression.setOperator(conversions.convertOperatorToString(node.operator));
-        return binaryExpression;
+        globals.createNode(node, globals.NodeKind.ndkBinaryExpression);
     } else {
         const binaryExpressionWrapper = globals.getWrapperOfNode(node);
+        binaryExpressionWrapper.setOperator(conversions.convertOperatorToString(node.operator));
 
         if (node.left != null) {
-            globals.safeSet(binaryExpressionWrapper, "setLeft", node.left, "BINARYEXPRESSION - Could not set left!");
+            globals.addEdge(node, globals.EdgeKind.edkBinaryExpression_HasLeft, node.left, "BINARYEXPRESSION - Could not set left!");
         }
 
         if (node.right != null) {
-            globals.safeSet(binaryExpressionWrapper, "setRight", node.right, "BINARYEXPRESSION - Could not set right!");
+            globals.addEdge(node, globals.EdgeKind.edkBinaryExpression_HasRight, node.right, "BINARYEXPRESSION - Could not set right!");
         }
 
     }
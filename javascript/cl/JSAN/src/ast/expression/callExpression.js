@@ -20,27 +20,21 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const callExpression = factory.createCallExpressionWrapper();
-        globals.setPositionInfo(node, callExpression);
-        return callExpression;
+        globals.createNode(node, globals.NodeKind.ndkCallExpression);
     } else {
-        const callExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.callee != null) {
-            globals.safeSet(callExpressionWrapper, "setCallee", node.callee, "CALLEXPRESSION - Could not set callee!");
+            globals.addEdge(node, globals.EdgeKind.edkCallExpression_HasCallee, node.callee, "CALLEXPRESSION - Could not set callee!");
         }
 
         if (node.arguments != null) {
             for (let i = 0; i < node.arguments.length; i++) {
                 if (node.arguments[i] != null) {
-                    globals.safeSet(callExpressionWrapper, "addArguments", node.arguments[i], "CALLEXPRESSION - Could not add argument!");
+                    globals.addEdge(node, globals.EdgeKind.edkCallExpression_HasArguments, node.arguments[i], "CALLEXPRESSION - Could not add argument!");
                 }
             }
         }
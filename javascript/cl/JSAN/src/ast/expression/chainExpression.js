@@ -1,20 +1,14 @@
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        let chainExpression = factory.createChainExpressionWrapper();
-        globals.setPositionInfo(node, chainExpression);
-        return chainExpression;
+        globals.createNode(node, globals.NodeKind.ndkChainExpression);
     } else {
-        let chainExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.expression != null) {
-            globals.safeSet(chainExpressionWrapper, "setExpression", node.expression, "CHAINEXPRESSION - Could not set expression!");
+            globals.addEdge(node, globals.EdgeKind.edkChainExpression_HasExpression, node.expression, "CHAINEXPRESSION - Could not set expression!");
         }
     }
 }
@@ -20,29 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const classExpression = factory.createClassExpressionWrapper();
-        globals.setPositionInfo(node, classExpression);
-        return classExpression;
+        globals.createNode(node, globals.NodeKind.ndkClassExpression);
     } else {
-        const classExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.superClass != null) {
-            globals.safeSet(classExpressionWrapper, "setSuperClass", node.superClass, "CLASSEXPRESSION - Could not set superclass!");
+            globals.addEdge(node, globals.EdgeKind.edkClass_HasSuperClass, node.superClass, "CLASSEXPRESSION - Could not set superclass!");
         }
 
         if (node.id != null) {
-            globals.safeSet(classExpressionWrapper, "setIdentifier", node.id, "CLASSEXPRESSION - Could not set identifier!");
+            globals.addEdge(node, globals.EdgeKind.edkClass_HasIdentifier, node.id, "CLASSEXPRESSION - Could not set identifier!");
         }
 
         if (node.body != null) {
-            globals.safeSet(classExpressionWrapper, "setBody", node.body, "CLASSEXPRESSION - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkClass_HasBody, node.body, "CLASSEXPRESSION - Could not set body!");
         }
     }
 }
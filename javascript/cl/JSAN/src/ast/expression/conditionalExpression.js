@@ -20,29 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const conditionalExpression = factory.createConditionalExpressionWrapper();
-        globals.setPositionInfo(node, conditionalExpression);
-        return conditionalExpression;
+        globals.createNode(node, globals.NodeKind.ndkConditionalExpression);
     } else {
-        const conditionalExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.alternate != null) {
-            globals.safeSet(conditionalExpressionWrapper, "setAlternate", node.alternate, "CONDITIONALEXPRESSION - Could not set alternate!");
+            globals.addEdge(node, globals.EdgeKind.edkConditionalExpression_HasAlternate, node.alternate, "CONDITIONALEXPRESSION - Could not set alternate!");
         }
 
         if (node.test != null) {
-            globals.safeSet(conditionalExpressionWrapper, "setTest", node.test, "CONDITIONALEXPRESSION - Could not set test!");
+            globals.addEdge(node, globals.EdgeKind.edkConditionalExpression_HasTest, node.test, "CONDITIONALEXPRESSION - Could not set test!");
         }
 
         if (node.consequent != null) {
-            globals.safeSet(conditionalExpressionWrapper, "setConsequent", node.consequent, "CONDITIONALEXPRESSION - Could not set consequent!")
+            globals.addEdge(node, globals.EdgeKind.edkConditionalExpression_HasConsequent, node.consequent, "CONDITIONALEXPRESSION - Could not set consequent!")
         }
     }
 }
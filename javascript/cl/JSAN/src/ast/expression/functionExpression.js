@@ -20,36 +20,32 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const functionExpression = factory.createFunctionExpressionWrapper();
-        globals.setPositionInfo(node, functionExpression);
-        functionExpression.setGenerator(node.generator);
-        functionExpression.setExpression(node.expression);
-        functionExpression.setAsync(node.async);
-        return functionExpression;
+        globals.createNode(node, globals.NodeKind.ndkFunctionExpression);
     } else {
         const functionExpressionWrapper = globals.getWrapperOfNode(node);
+        functionExpressionWrapper.setGenerator(node.generator);
+        functionExpressionWrapper.setExpression(node.expression);
+        functionExpressionWrapper.setAsync(node.async);
 
         if (node.params != null) {
             for (let i = 0; i < node.params.length; i++) {
                 if (node.params[i] != null) {
-                    globals.safeSet(functionExpressionWrapper, "addParams", node.params[i], "FUNCTIONEXPRESSION - Could not add params!");
+                    globals.addEdge(node, globals.EdgeKind.edkFunction_HasParams, node.params[i], "FUNCTIONEXPRESSION - Could not add params!");
                 }
             }
         }
 
         if (node.body != null) {
-            globals.safeSet(functionExpressionWrapper, "setBody", node.body, "FUNCTIONEXPRESSION - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkFunction_HasBody, node.body, "FUNCTIONEXPRESSION - Could not set body!");
         }
 
         if (node.id != null) {
-            globals.safeSet(functionExpressionWrapper, "setIdentifier", node.id, "FUNCTIONEXPRESSION - Could not set identifier!")
+            globals.addEdge(node, globals.EdgeKind.edkFunction_HasIdentifier, node.id, "FUNCTIONEXPRESSION - Could not set identifier!")
         }
 
     }
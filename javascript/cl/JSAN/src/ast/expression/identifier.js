@@ -20,16 +20,11 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const identifier = factory.createIdentifierWrapper();
-        globals.setPositionInfo(node, identifier);
-        identifier.setName(node.name);
-        return identifier;
+        globals.createNode(node, globals.NodeKind.ndkIdentifier, node.name);
     }
 }
@@ -1,20 +1,14 @@
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const importExpression = factory.createImportExpressionWrapper();
-        globals.setPositionInfo(node, importExpression);
-        return importExpression;
+        globals.createNode(node, globals.NodeKind.ndkImportExpression);
     } else {
-        const importExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.source != null) {
-            globals.safeSet(importExpressionWrapper, "setSource", node.source, "IMPORTEXPRESSION - Could not set source!");
+            globals.addEdge(node, globals.EdgeKind.edkImportExpression_HasSource, node.source, "IMPORTEXPRESSION - Could not set source!");
         }
     }
 }
@@ -20,49 +20,51 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
+    const type = globals.getLiteralType(node);
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
 
-        const type = globals.getLiteralType(node);
-        let literalNode;
         switch (type) {
             case "Number":
-                literalNode = factory.createNumberLiteralWrapper();
-                literalNode.setValue(node.value);
+                globals.createNode(node, globals.NodeKind.ndkNumberLiteral);
                 break;
             case "Boolean":
-                literalNode = factory.createBooleanLiteralWrapper();
-                literalNode.setValue(node.value);
+                globals.createNode(node, globals.NodeKind.ndkBooleanLiteral);
                 break;
             case "String":
-                literalNode = factory.createStringLiteralWrapper();
-                literalNode.setValue(node.value);
+                globals.createNode(node, globals.NodeKind.ndkStringLiteral);
                 break;
             case "Null":
-                literalNode = factory.createNullLiteralWrapper();
+                globals.createNode(node, globals.NodeKind.ndkNullLiteral);
                 break;
             case "RegExp":
-                literalNode = factory.createRegExpLiteralWrapper();
-                literalNode.setFlags(node.regex.flags);
-                literalNode.setPattern(node.regex.pattern);
+                globals.createNode(node, globals.NodeKind.ndkRegExpLiteral);
                 break;
             case "Bigint":
-                literalNode = factory.createBigIntLiteralWrapper();
-                literalNode.setBigint(node.bigint);
+                globals.createNode(node, globals.NodeKind.ndkBigIntLiteral);
                 break;
             default:
                 throw new Error("Literal type could not be recognized! Type: " + type);
         }
-
-        globals.setPositionInfo(node, literalNode);
-        literalNode.setRaw(node.raw);
-
-        return literalNode;
+    } else {
+        const literalWrapper = globals.getWrapperOfNode(node);
+        switch (type) {
+            case "Number":
+            case "Boolean":
+            case "String":
+                literalWrapper.setValue(node.value);
+                break;
+            case "RegExp":
+                literalWrapper.setFlags(node.regex.flags);
+                literalWrapper.setPattern(node.regex.pattern);
+                break;
+            case "Bigint":
+                literalWrapper.setBigint(node.bigint);
+                break;
+        }
+        literalWrapper.setRaw(node.raw);
     }
-
 }
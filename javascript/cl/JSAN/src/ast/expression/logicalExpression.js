@@ -21,26 +21,22 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const logicalExpression = factory.createLogicalExpressionWrapper();
-        globals.setPositionInfo(node, logicalExpression);
-        logicalExpression.setOperator(conversions.convertOperatorToString(node.operator));
-        return logicalExpression;
+        globals.createNode(node, globals.NodeKind.ndkLogicalExpression);
     } else {
         const logicalExpressionWrapper = globals.getWrapperOfNode(node);
+        logicalExpressionWrapper.setOperator(conversions.convertOperatorToString(node.operator));
 
         if (node.left != null) {
-            globals.safeSet(logicalExpressionWrapper, "setLeft", node.left, "LOGICALEXPRESSION - Could not set left!");
+            globals.addEdge(node, globals.EdgeKind.edkLogicalExpression_HasLeft, node.left, "LOGICALEXPRESSION - Could not set left!");
         }
 
         if (node.right != null) {
-            globals.safeSet(logicalExpressionWrapper, "setRight", node.right, "LOGICALEXPRESSION - Could not set right!");
+            globals.addEdge(node, globals.EdgeKind.edkLogicalExpression_HasRight, node.right, "LOGICALEXPRESSION - Could not set right!");
         }
     }
 }
@@ -20,26 +20,22 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const memberExpression = factory.createMemberExpressionWrapper();
-        globals.setPositionInfo(node, memberExpression);
-        memberExpression.setComputed(node.computed);
-        return memberExpression;
+        globals.createNode(node, globals.NodeKind.ndkMemberExpression);
     } else {
         const memberExpressionWrapper = globals.getWrapperOfNode(node);
+        memberExpressionWrapper.setComputed(node.computed);
 
         if (node.property != null) {
-            globals.safeSet(memberExpressionWrapper, "setProperty", node.property, "MEMBEREXPRESSION - Could not set property!");
+            globals.addEdge(node, globals.EdgeKind.edkMemberExpression_HasProperty, node.property, "MEMBEREXPRESSION - Could not set property!");
         }
 
         if (node.object != null) {
-            globals.safeSet(memberExpressionWrapper, "setObject", node.object, "MEMBEREXPRESSION - Could not set object!");
+            globals.addEdge(node, globals.EdgeKind.edkMemberExpression_HasObject, node.object, "MEMBEREXPRESSION - Could not set object!");
         }
 
     }
@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const metaProperty = factory.createMetaPropertyWrapper();
-        globals.setPositionInfo(node, metaProperty);
-        return metaProperty;
+        globals.createNode(node, globals.NodeKind.ndkMetaProperty);
     } else {
-        const metaPropertyWrapper = globals.getWrapperOfNode(node);
-
         if (node.meta != null) {
-            globals.safeSet(metaPropertyWrapper, "setMeta", node.meta, "METAPROPERTY - Could not set meta!");
+            globals.addEdge(node, globals.EdgeKind.edkMetaProperty_HasMeta, node.meta, "METAPROPERTY - Could not set meta!");
         }
 
         if (node.property != null) {
-            globals.safeSet(metaPropertyWrapper, "setProperty", node.property, "METAPROPERTY - Could not set property!");
+            globals.addEdge(node, globals.EdgeKind.edkMetaProperty_HasProperty, node.property, "METAPROPERTY - Could not set property!");
         }
 
     }
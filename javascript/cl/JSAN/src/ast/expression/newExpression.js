@@ -20,27 +20,21 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const newExpression = factory.createNewExpressionWrapper();
-        globals.setPositionInfo(node, newExpression);
-        return newExpression;
+        globals.createNode(node, globals.NodeKind.ndkNewExpression);
     } else {
-        const newExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.callee != null) {
-            globals.safeSet(newExpressionWrapper, "setCallee", node.callee, "NEWEXPRESSION - Could not set callee!");
+            globals.addEdge(node, globals.EdgeKind.edkNewExpression_HasCallee, node.callee, "NEWEXPRESSION - Could not set callee!");
         }
 
         if (node.arguments != null) {
             for (let i = 0; i < node.arguments.length; i++) {
                 if (node.arguments[i] != null) {
-                    globals.safeSet(newExpressionWrapper, "addArguments", node.arguments[i], "NEWEXPRESSION - Could not set argument!");
+                    globals.addEdge(node, globals.EdgeKind.edkNewExpression_HasArguments, node.arguments[i], "NEWEXPRESSION - Could not set argument!");
                 }
             }
         }
@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const objectExpression = factory.createObjectExpressionWrapper();
-        globals.setPositionInfo(node, objectExpression);
-        return objectExpression;
+        globals.createNode(node, globals.NodeKind.ndkObjectExpression);
     } else {
-        const objectExpressionWrapper = globals.getWrapperOfNode(node);
         if (node.properties != null) {
             for (let i = 0; i < node.properties.length; i++) {
                 if (node.properties[i] != null) {
-                    globals.safeSet(objectExpressionWrapper, "addProperties", node.properties[i], "OBJECTEXPRESSION - Could not add property!");
+                    globals.addEdge(node, globals.EdgeKind.edkObjectExpression_HasProperties, node.properties[i], "OBJECTEXPRESSION - Could not add property!");
                 }
             }
         }
@@ -1,22 +1,17 @@
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const privateIdentifier = factory.createPrivateIdentifierWrapper();
-        globals.setPositionInfo(node, privateIdentifier);
 
         // Workaround until parser gets updated
         // TODO: Remove this once parser gets updated
         if (node.type === 'TSPrivateIdentifier') {
-            privateIdentifier.setName(node.escapedText.substring(1));
+            globals.createNode(node, globals.NodeKind.ndkPrivateIdentifier, node.escapedText.substring(1));
         } else {
-            privateIdentifier.setName(node.name);
+            globals.createNode(node, globals.NodeKind.ndkPrivateIdentifier, node.name);
         }
-        return privateIdentifier;
     }
 }
@@ -21,29 +21,25 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const property = factory.createPropertyWrapper();
-        globals.setPositionInfo(node, property);
-        property.setKind(conversions.convertPropertyKind(node.kind));
-        property.setMethod(node.method);
-        property.setShorthand(node.shorthand);
-        property.setComputed(node.computed);
-        return property;
+        globals.createNode(node, globals.NodeKind.ndkProperty);
     } else {
         const propertyWrapper = globals.getWrapperOfNode(node);
+        propertyWrapper.setKind(conversions.convertPropertyKind(node.kind));
+        propertyWrapper.setMethod(node.method);
+        propertyWrapper.setShorthand(node.shorthand);
+        propertyWrapper.setComputed(node.computed);
 
         if (node.key != null) {
-            globals.safeSet(propertyWrapper, "setKey", node.key, "PROPERTY - Could not set key!");
+            globals.addEdge(node, globals.EdgeKind.edkProperty_HasKey, node.key, "PROPERTY - Could not set key!");
         }
 
         if (node.value != null) {
-            globals.safeSet(propertyWrapper, "setValue", node.value, "PROPERTY - Could not set value!");
+            globals.addEdge(node, globals.EdgeKind.edkProperty_HasValue, node.value, "PROPERTY - Could not set value!");
         }
 
     }
@@ -20,17 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const regExpLiteral = factory.createRegExpLiteralWrapper();
-        globals.setPositionInfo(node, regExpLiteral);
-        regExpLiteral.setPattern(node.pattern);
-        regExpLiteral.setFlags(node.flags);
-        return regExpLiteral;
+        globals.createNode(node, globals.NodeKind.ndkRegExpLiteral);
+    } else {
+        const regExpLiteralWrapper = globals.getWrapperOfNode(node);
+        regExpLiteralWrapper.setPattern(node.pattern);
+        regExpLiteralWrapper.setFlags(node.flags);
     }
 }
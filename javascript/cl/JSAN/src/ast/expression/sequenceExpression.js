@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const sequenceExpression = factory.createSequenceExpressionWrapper();
-        globals.setPositionInfo(node, sequenceExpression);
-        return sequenceExpression;
+        globals.createNode(node, globals.NodeKind.ndkSequenceExpression);
     } else {
-        const sequenceExpressionWrapper = globals.getWrapperOfNode(node);
         if (node.expressions != null) {
             for (let i = 0; i < node.expressions.length; i++) {
                 if (node.expressions[i] != null) {
-                    globals.safeSet(sequenceExpressionWrapper, "addExpressions", node.expressions[i], "SEQUENCEEXPRESSION - Could not add expression!");
+                    globals.addEdge(node, globals.EdgeKind.edkSequenceExpression_HasExpressions, node.expressions[i], "SEQUENCEEXPRESSION - Could not add expression!");
                 }
             }
         }
@@ -20,21 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const spreadElement = factory.createSpreadElementWrapper();
-        globals.setPositionInfo(node, spreadElement);
-        return spreadElement;
+        globals.createNode(node, globals.NodeKind.ndkSpreadElement);
     } else {
-        const spreadElementWrapper = globals.getWrapperOfNode(node);
-
         if (node.argument != null) {
-            globals.safeSet(spreadElementWrapper, "setArgument", node.argument, "SPREADELEMENT - Could not add argument!");
+            globals.addEdge(node, globals.EdgeKind.edkSpreadElement_HasArgument, node.argument, "SPREADELEMENT - Could not add argument!");
         }
     }
 }
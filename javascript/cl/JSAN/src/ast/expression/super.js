@@ -20,15 +20,11 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const superNode = factory.createSuperWrapper();
-        globals.setPositionInfo(node, superNode);
-        return superNode;
+        globals.createNode(node, globals.NodeKind.ndkSuper);
     }
 }
@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const taggedTemplateExpression = factory.createTaggedTemplateExpressionWrapper();
-        globals.setPositionInfo(node, taggedTemplateExpression);
-        return taggedTemplateExpression;
+        globals.createNode(node, globals.NodeKind.ndkTaggedTemplateExpression);
     } else {
-        const taggedTemplateExpressionWrapper = globals.getWrapperOfNode(node);
-
         if (node.tag != null) {
-            globals.safeSet(taggedTemplateExpressionWrapper, "setTag", node.tag, "TAGGEDTEMPLATEEXPRESSION - Could not add tag!");
+            globals.addEdge(node, globals.EdgeKind.edkTaggedTemplateExpression_HasTag, node.tag, "TAGGEDTEMPLATEEXPRESSION - Could not add tag!");
         }
 
         if (node.quasi != null) {
-            globals.safeSet(taggedTemplateExpressionWrapper, "setQuasi", node.quasi, "TAGGEDTEMPLATEEXPRESSION - Could not set quasi!");
+            globals.addEdge(node, globals.EdgeKind.edkTaggedTemplateExpression_HasQuasi, node.quasi, "TAGGEDTEMPLATEEXPRESSION - Could not set quasi!");
         }
     }
 }
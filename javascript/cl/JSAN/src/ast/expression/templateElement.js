@@ -20,18 +20,16 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const templateElement = factory.createTemplateElementWrapper();
-        globals.setPositionInfo(node, templateElement);
-        templateElement.setTail(node.tail);
-        templateElement.setCooked(node.value.cooked);
-        templateElement.setValue(node.value.raw);
-        return templateElement;
+        globals.createNode(node, globals.NodeKind.ndkTemplateElement);
+    } else {
+        const templateElementWrapper = globals.getWrapperOfNode(node);
+        templateElementWrapper.setTail(node.tail);
+        templateElementWrapper.setCooked(node.value.cooked);
+        templateElementWrapper.setValue(node.value.raw);
     }
 }
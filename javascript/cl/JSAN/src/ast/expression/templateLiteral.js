@@ -20,16 +20,12 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const templateLiteral = factory.createTemplateLiteralWrapper();
-        globals.setPositionInfo(node, templateLiteral);
-        return templateLiteral;
+        globals.createNode(node, globals.NodeKind.ndkTemplateLiteral);
     } else {
         const templateLiteralWrapper = globals.getWrapperOfNode(node);
 
@@ -40,7 +36,7 @@ export default function (node, parent, firstVisit) {
         if (node.expressions != null) {
             for (let i = 0; i < node.expressions.length; i++) {
                 if (node.expressions[i] != null) {
-                    globals.safeSet(templateLiteralWrapper, "addExpressions", node.expressions[i], "TEMPLATELITERAL - Could not add expression!");
+                    globals.addEdge(node, globals.EdgeKind.edkTemplateLiteral_HasExpressions, node.expressions[i], "TEMPLATELITERAL - Could not add expression!");
                 }
             }
         }
@@ -48,7 +44,7 @@ export default function (node, parent, firstVisit) {
         if (node.quasis != null) {
             for (let i = 0; i < node.quasis.length; i++) {
                 if (node.quasis[i] != null) {
-                    globals.safeSet(templateLiteralWrapper, "addQuasis", node.quasis[i], "TEMPLATELITERAL - Could not add quasis!");
+                    globals.addEdge(node, globals.EdgeKind.edkTemplateLiteral_HasQuasis, node.quasis[i], "TEMPLATELITERAL - Could not add quasis!");
                 }
             }
         }
@@ -20,16 +20,12 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const thisExpression = factory.createThisExpressionWrapper();
-        globals.setPositionInfo(node, thisExpression);
-        return thisExpression;
+        globals.createNode(node, globals.NodeKind.ndkThisExpression);
     } else {
         const thisExpressionWrapper = globals.getWrapperOfNode(node);
 
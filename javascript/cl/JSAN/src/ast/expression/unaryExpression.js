@@ -21,23 +21,19 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const unaryExpression = factory.createUnaryExpressionWrapper();
-        globals.setPositionInfo(node, unaryExpression);
-        unaryExpression.setOperator(conversions.convertUnaryOperatorToString(node.operator));
-        unaryExpression.setPrefix(node.prefix);
-        return unaryExpression;
+        globals.createNode(node, globals.NodeKind.ndkUnaryExpression);
     } else {
         const unaryExpressionWrapper = globals.getWrapperOfNode(node);
+        unaryExpressionWrapper.setOperator(conversions.convertUnaryOperatorToString(node.operator));
+        unaryExpressionWrapper.setPrefix(node.prefix);
         if (node.argument != null) {
-            globals.safeSet(unaryExpressionWrapper, "setArgument", node.argument, "UNARYEXPRESSION - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkUnaryExpression_HasArgument, node.argument, "UNARYEXPRESSION - Could not set argument!");
         }
     }
 }
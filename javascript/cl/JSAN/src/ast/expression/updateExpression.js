@@ -21,23 +21,18 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const updateExpression = factory.createUpdateExpressionWrapper();
-        globals.setPositionInfo(node, updateExpression);
-        updateExpression.setOperator(conversions.convertOperatorToString(node.operator));
-        updateExpression.setPrefix(node.prefix);
-
-        return updateExpression;
+        globals.createNode(node, globals.NodeKind.ndkUpdateExpression);
     } else {
         const updateExpressionWrapper = globals.getWrapperOfNode(node);
+        updateExpressionWrapper.setOperator(conversions.convertOperatorToString(node.operator));
+        updateExpressionWrapper.setPrefix(node.prefix);
         if (node.argument != null) {
-            globals.safeSet(updateExpressionWrapper, "setArgument", node.argument, "UPDATEEXPRESSION - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkUpdateExpression_HasArgument, node.argument, "UPDATEEXPRESSION - Could not set argument!");
         }
 
     }
@@ -20,22 +20,18 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const yieldExpression = factory.createYieldExpressionWrapper();
-        globals.setPositionInfo(node, yieldExpression);
-        yieldExpression.setDelegate(node.delegate);
-        return yieldExpression;
+        globals.createNode(node, globals.NodeKind.ndkYieldExpression);
     } else {
         const yieldExpressionWrapper = globals.getWrapperOfNode(node);
         yieldExpressionWrapper.setDelegate(node.delegate);
+        yieldExpressionWrapper.setDelegate(node.delegate);
         if (node.argument != null) {
-            globals.safeSet(yieldExpressionWrapper, "setArgument", node.argument, "YIELDEXPRESSION - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkYieldExpression_HasArgument, node.argument, "YIELDEXPRESSION - Could not set argument!");
         }
     }
 }
@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const arrayPattern = factory.createArrayPatternWrapper();
-        globals.setPositionInfo(node, arrayPattern);
-        return arrayPattern;
+        globals.createNode(node, globals.NodeKind.ndkArrayPattern);
     } else {
-        const arrayPatternWrapper = globals.getWrapperOfNode(node);
         if (node.elements != null) {
             for (let i = 0; i < node.elements.length; i++) {
                 if (node.elements[i] != null) {
-                    globals.safeSet(arrayPatternWrapper, "addElements", node.elements[i], "ARRAYPATTERN - Could not add element!");
+                    globals.addEdge(node, globals.EdgeKind.edkArrayPattern_HasElements, node.elements[i], "ARRAYPATTERN - Could not add element!");
                 }
             }
         }
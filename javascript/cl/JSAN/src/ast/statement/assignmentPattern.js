@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const assignmentPattern = factory.createAssignmentPatternWrapper();
-        globals.setPositionInfo(node, assignmentPattern);
-        return assignmentPattern;
+        globals.createNode(node, globals.NodeKind.ndkAssignmentPattern);
     } else {
-        const assignmentPatternWrapper = globals.getWrapperOfNode(node);
-
         if (node.left != null) {
-            globals.safeSet(assignmentPatternWrapper, "setLeft", node.left, "ASSIGNMENTPATTERN - Could not set left!");
+            globals.addEdge(node, globals.EdgeKind.edkAssignmentPattern_HasLeft, node.left, "ASSIGNMENTPATTERN - Could not set left!");
         }
 
         if (node.right != null) {
-            globals.safeSet(assignmentPatternWrapper, "setRight", node.right, "ASSIGNMENTPATTERN - Could not set right!");
+            globals.addEdge(node, globals.EdgeKind.edkAssignmentPattern_HasRight, node.right, "ASSIGNMENTPATTERN - Could not set right!");
         }
     }
 }
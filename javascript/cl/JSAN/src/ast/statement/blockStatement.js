@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const blockStatement = factory.createBlockStatementWrapper();
-        globals.setPositionInfo(node, blockStatement);
-        return blockStatement;
+        globals.createNode(node, globals.NodeKind.ndkBlockStatement);
     } else {
-        const blockStatementWrapper = globals.getWrapperOfNode(node);
         if (node.body != null) {
             for (let i = 0; i < node.body.length; i++) {
                 if (node.body[i] != null) {
-                    globals.safeSet(blockStatementWrapper, "addBody", node.body[i], "BLOCKSTATEMENT - Could not add body!");
+                    globals.addEdge(node, globals.EdgeKind.edkBlockStatement_HasBody, node.body[i], "BLOCKSTATEMENT - Could not add body!");
                 }
             }
         }
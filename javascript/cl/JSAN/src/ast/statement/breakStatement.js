@@ -20,20 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const breakStatement = factory.createBreakStatementWrapper();
-        globals.setPositionInfo(node, breakStatement);
-        return breakStatement;
+        globals.createNode(node, globals.NodeKind.ndkBreakStatement);
     } else {
-        const breakStatementWrapper = globals.getWrapperOfNode(node);
         if (node.label != null) {
-            globals.safeSet(breakStatementWrapper, "setLabel", node.label, "BREAKSTATEMENT - Could not set label!");
+            globals.addEdge(node, globals.EdgeKind.edkBreakStatement_HasLabel, node.label, "BREAKSTATEMENT - Could not set label!");
         }
     }
 }
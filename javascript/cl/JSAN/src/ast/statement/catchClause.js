@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const catchClause = factory.createCatchClauseWrapper();
-        globals.setPositionInfo(node, catchClause);
-        return catchClause;
+        globals.createNode(node, globals.NodeKind.ndkCatchClause);
     } else {
-        const catchClauseWrapper = globals.getWrapperOfNode(node);
-
         if (node.body != null) {
-            globals.safeSet(catchClauseWrapper, "setBody", node.body, "CATCHCLAUSE - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkCatchClause_HasBody, node.body, "CATCHCLAUSE - Could not set body!");
         }
 
         if (node.param != null) {
-            globals.safeSet(catchClauseWrapper, "setParam", node.param, "CATCHCLAUSE - Could not set param!");
+            globals.addEdge(node, globals.EdgeKind.edkCatchClause_HasParam, node.param, "CATCHCLAUSE - Could not set param!");
         }
     }
 }
@@ -20,20 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const continueStatement = factory.createContinueStatementWrapper();
-        globals.setPositionInfo(node, continueStatement);
-        return continueStatement;
+        globals.createNode(node, globals.NodeKind.ndkContinueStatement);
     } else {
-        const continueStatementWrapper = globals.getWrapperOfNode(node);
         if (node.label != null) {
-            globals.safeSet(continueStatementWrapper, "setLabel", node.label, "CONTINUESTATEMENT - Could not set label!");
+            globals.addEdge(node, globals.EdgeKind.edkContinueStatement_HasLabel, node.label, "CONTINUESTATEMENT - Could not set label!");
         }
     }
 }
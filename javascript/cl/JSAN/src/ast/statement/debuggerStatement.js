@@ -20,15 +20,11 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const debuggerStatement = factory.createDebuggerStatementWrapper();
-        globals.setPositionInfo(node, debuggerStatement);
-        return debuggerStatement;
+        globals.createNode(node, globals.NodeKind.ndkDebuggerStatement);
     }
 }
@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const doWhileStatement = factory.createDoWhileStatementWrapper();
-        globals.setPositionInfo(node, doWhileStatement);
-        return doWhileStatement;
+        globals.createNode(node, globals.NodeKind.ndkDoWhileStatement);
     } else {
-        const doWhileStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.test != null) {
-            globals.safeSet(doWhileStatementWrapper, "setTest", node.test, "CONTINUESTATEMENT - Could not set test!");
+            globals.addEdge(node, globals.EdgeKind.edkWhileStatement_HasTest, node.test, "CONTINUESTATEMENT - Could not set test!");
         }
 
         if (node.body != null) {
-            globals.safeSet(doWhileStatementWrapper, "setBody", node.body, "CONTINUESTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkWhileStatement_HasBody, node.body, "CONTINUESTATEMENT - Could not set body!");
         }
     }
 }
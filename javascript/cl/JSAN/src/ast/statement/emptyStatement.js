@@ -20,15 +20,11 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const emptyStatements = factory.createEmptyStatementWrapper();
-        globals.setPositionInfo(node, emptyStatements);
-        return emptyStatements;
+        globals.createNode(node, globals.NodeKind.ndkEmptyStatement);
     }
 }
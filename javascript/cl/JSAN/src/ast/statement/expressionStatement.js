@@ -20,20 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const expressionStatement = factory.createExpressionStatementWrapper();
-        globals.setPositionInfo(node, expressionStatement);
-        return expressionStatement;
+        globals.createNode(node, globals.NodeKind.ndkExpressionStatement);
     } else {
-        const expressionStatementWrapper = globals.getWrapperOfNode(node);
         if (node.expression != null) {
-            globals.safeSet(expressionStatementWrapper, "setExpression", node.expression, "EXPRESSIONSTATEMENT - Could not set expression!");
+            globals.addEdge(node, globals.EdgeKind.edkExpressionStatement_HasExpression, node.expression, "EXPRESSIONSTATEMENT - Could not set expression!");
         }
     }
 }
@@ -20,29 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const forInStatement = factory.createForInStatementWrapper();
-        globals.setPositionInfo(node, forInStatement);
-        return forInStatement;
+        globals.createNode(node, globals.NodeKind.ndkForInStatement);
     } else {
-        const forInStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.left != null) {
-            globals.safeSet(forInStatementWrapper, "setLeft", node.left, "FORINSTATEMENT - Could not set left!");
+            globals.addEdge(node, globals.EdgeKind.edkForInStatement_HasLeft, node.left, "FORINSTATEMENT - Could not set left!");
         }
 
         if (node.right != null) {
-            globals.safeSet(forInStatementWrapper, "setRight", node.right, "FORINSTATEMENT - Could not set right!");
+            globals.addEdge(node, globals.EdgeKind.edkForInStatement_HasRight, node.right, "FORINSTATEMENT - Could not set right!");
         }
 
         if (node.body != null) {
-            globals.safeSet(forInStatementWrapper, "setBody", node.body, "FORINSTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkForInStatement_HasBody, node.body, "FORINSTATEMENT - Could not set body!");
         }
     }
 }
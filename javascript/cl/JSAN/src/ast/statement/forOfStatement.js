@@ -20,30 +20,26 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const forOfStatement = factory.createForOfStatementWrapper();
-        forOfStatement.setAwait(node.await);
-        globals.setPositionInfo(node, forOfStatement);
-        return forOfStatement;
+        globals.createNode(node, globals.NodeKind.ndkForOfStatement);
     } else {
         const forOfStatementWrapper = globals.getWrapperOfNode(node);
+        forOfStatementWrapper.setAwait(node.await);
 
         if (node.left != null) {
-            globals.safeSet(forOfStatementWrapper, "setLeft", node.left, "FOROFSTATEMENT - Could not set left!");
+            globals.addEdge(node, globals.EdgeKind.edkForInStatement_HasLeft, node.left, "FOROFSTATEMENT - Could not set left!");
         }
 
         if (node.right != null) {
-            globals.safeSet(forOfStatementWrapper, "setRight", node.right, "FOROFSTATEMENT - Could not set right!");
+            globals.addEdge(node, globals.EdgeKind.edkForInStatement_HasRight, node.right, "FOROFSTATEMENT - Could not set right!");
         }
 
         if (node.body != null) {
-            globals.safeSet(forOfStatementWrapper, "setBody", node.body, "FOROFSTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkForInStatement_HasBody, node.body, "FOROFSTATEMENT - Could not set body!");
         }
     }
 }
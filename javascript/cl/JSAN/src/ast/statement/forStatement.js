@@ -20,33 +20,27 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const forStatement = factory.createForStatementWrapper();
-        globals.setPositionInfo(node, forStatement);
-        return forStatement;
+        globals.createNode(node, globals.NodeKind.ndkForStatement);
     } else {
-        const forStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.init != null) {
-            globals.safeSet(forStatementWrapper, "setInit", node.init, "FORSTATEMENT - Could not set init!");
+            globals.addEdge(node, globals.EdgeKind.edkForStatement_HasInit, node.init, "FORSTATEMENT - Could not set init!");
         }
 
         if (node.test != null) {
-            globals.safeSet(forStatementWrapper, "setTest", node.test, "FORSTATEMENT - Could not set test!");
+            globals.addEdge(node, globals.EdgeKind.edkForStatement_HasTest, node.test, "FORSTATEMENT - Could not set test!");
         }
 
         if (node.update != null) {
-            globals.safeSet(forStatementWrapper, "setUpdate", node.update, "FORSTATEMENT - Could not set update!");
+            globals.addEdge(node, globals.EdgeKind.edkForStatement_HasUpdate, node.update, "FORSTATEMENT - Could not set update!");
         }
 
         if (node.body != null) {
-            globals.safeSet(forStatementWrapper, "setBody", node.body, "FORSTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkForStatement_HasBody, node.body, "FORSTATEMENT - Could not set body!");
         }
     }
 }
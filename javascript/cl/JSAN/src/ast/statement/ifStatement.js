@@ -20,29 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const ifStatement = factory.createIfStatementWrapper();
-        globals.setPositionInfo(node, ifStatement);
-        return ifStatement;
+        globals.createNode(node, globals.NodeKind.ndkIfStatement);
     } else {
-        const ifStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.consequent != null) {
-            globals.safeSet(ifStatementWrapper, "setConsequent", node.consequent, "IFSTATEMENT - Could not set consequent!");
+            globals.addEdge(node, globals.EdgeKind.edkIfStatement_HasConsequent, node.consequent, "IFSTATEMENT - Could not set consequent!");
         }
 
         if (node.test != null) {
-            globals.safeSet(ifStatementWrapper, "setTest", node.test, "IFSTATEMENT - Could not set test!");
+            globals.addEdge(node, globals.EdgeKind.edkIfStatement_HasTest, node.test, "IFSTATEMENT - Could not set test!");
         }
 
         if (node.alternate != null) {
-            globals.safeSet(ifStatementWrapper, "setAlternate", node.alternate, "IFSTATEMENT - Could not set alternate!");
+            globals.addEdge(node, globals.EdgeKind.edkIfStatement_HasAlternate, node.alternate, "IFSTATEMENT - Could not set alternate!");
         }
     }
 }
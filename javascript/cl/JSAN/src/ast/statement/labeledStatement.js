@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const labeledStatement = factory.createLabeledStatementWrapper();
-        globals.setPositionInfo(node, labeledStatement);
-        return labeledStatement;
+        globals.createNode(node, globals.NodeKind.ndkLabeledStatement);
     } else {
-        const labeledStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.label != null) {
-            globals.safeSet(labeledStatementWrapper, "setLabel", node.label, "LABELEDSTATEMENT - Could not set label!");
+            globals.addEdge(node, globals.EdgeKind.edkLabeledStatement_HasLabel, node.label, "LABELEDSTATEMENT - Could not set label!");
         }
 
         if (node.body != null) {
-            globals.safeSet(labeledStatementWrapper, "setBody", node.body, "LABELEDSTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkLabeledStatement_HasBody, node.body, "LABELEDSTATEMENT - Could not set body!");
         }
     }
 }
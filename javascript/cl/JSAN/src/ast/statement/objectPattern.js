@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const objectPattern = factory.createObjectPatternWrapper();
-        globals.setPositionInfo(node, objectPattern);
-        return objectPattern;
+        globals.createNode(node, globals.NodeKind.ndkObjectPattern);
     } else {
-        const objectPatternWrapper = globals.getWrapperOfNode(node);
         if (node.properties != null) {
             for (let i = 0; i < node.properties.length; i++) {
                 if (node.properties[i] != null) {
-                    globals.safeSet(objectPatternWrapper, "addProperties", node.properties[i], "OBJECTPATTERN - Could not add property!");
+                    globals.addEdge(node, globals.EdgeKind.edkObjectPattern_HasProperties, node.properties[i], "OBJECTPATTERN - Could not add property!");
                 }
             }
         }
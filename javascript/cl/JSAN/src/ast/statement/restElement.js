@@ -20,21 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const restElement = factory.createRestElementWrapper();
-        globals.setPositionInfo(node, restElement);
-        return restElement;
+        globals.createNode(node, globals.NodeKind.ndkRestElement);
     } else {
-        const restElementWrapper = globals.getWrapperOfNode(node);
-
         if (node.argument != null) {
-            globals.safeSet(restElementWrapper, "setArgument", node.argument, "RESTELEMENT - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkRestElement_HasArgument, node.argument, "RESTELEMENT - Could not set argument!");
         }
     }
 }
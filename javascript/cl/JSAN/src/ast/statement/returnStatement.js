@@ -20,22 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const returnStatement = factory.createReturnStatementWrapper();
-        globals.setPositionInfo(node, returnStatement);
-
-        return returnStatement;
+        globals.createNode(node, globals.NodeKind.ndkReturnStatement);
     } else {
-        const returnStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.argument != null) {
-            globals.safeSet(returnStatementWrapper, "setArgument", node.argument, "RETURNSTATEMENT - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkReturnStatement_HasArgument, node.argument, "RETURNSTATEMENT - Could not set argument!");
         }
     }
 }
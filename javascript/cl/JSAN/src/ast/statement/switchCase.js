@@ -20,25 +20,20 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const switchCase = factory.createSwitchCaseWrapper();
-        globals.setPositionInfo(node, switchCase);
-        return switchCase;
+        globals.createNode(node, globals.NodeKind.ndkSwitchCase);
     } else {
-        const switchCaseWrapper = globals.getWrapperOfNode(node);
         if (node.test != null) {
-            globals.safeSet(switchCaseWrapper, "setTest", node.test, "SWITCHCASE - Could not set test!");
+            globals.addEdge(node, globals.EdgeKind.edkSwitchCase_HasTest, node.test, "SWITCHCASE - Could not set test!");
         }
         if (node.consequent != null) {
             for (let i = 0; i < node.consequent.length; i++) {
                 if (node.consequent[i] != null) {
-                    globals.safeSet(switchCaseWrapper, "addConsequent", node.consequent[i], "SWITCHCASE - Could not add consequent!");
+                    globals.addEdge(node, globals.EdgeKind.edkSwitchCase_HasConsequent, node.consequent[i], "SWITCHCASE - Could not add consequent!");
                 }
             }
         }
@@ -20,28 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const switchStatement = factory.createSwitchStatementWrapper();
-        globals.setPositionInfo(node, switchStatement);
-        return switchStatement;
+        globals.createNode(node, globals.NodeKind.ndkSwitchStatement);
     } else {
-        const switchStatementWrapper = globals.getWrapperOfNode(node);
         if (node.cases != null) {
             for (let i = 0; i < node.cases.length; i++) {
                 if (node.cases[i] != null) {
-                    globals.safeSet(switchStatementWrapper, "addCases", node.cases[i], "SWITCHSTATEMENT - Could not add case!");
+                    globals.addEdge(node, globals.EdgeKind.edkSwitchStatement_HasCases, node.cases[i], "SWITCHSTATEMENT - Could not add case!");
                 }
             }
         }
 
         if (node.discriminant != null) {
-            globals.safeSet(switchStatementWrapper, "setDiscriminant", node.discriminant, "SWITCHSTATEMENT - Could not set discriminant!");
+            globals.addEdge(node, globals.EdgeKind.edkSwitchStatement_HasDiscriminant, node.discriminant, "SWITCHSTATEMENT - Could not set discriminant!");
         }
     }
 }
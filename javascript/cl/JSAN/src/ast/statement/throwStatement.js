@@ -20,22 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const throwStatement = factory.createThrowStatementWrapper();
-        globals.setPositionInfo(node, throwStatement);
-
-        return throwStatement;
+        globals.createNode(node, globals.NodeKind.ndkThrowStatement);
     } else {
-        const throwStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.argument != null) {
-            globals.safeSet(throwStatementWrapper, "setArgument", node.argument, "THROWSTATEMENT - Could not set argument!");
+            globals.addEdge(node, globals.EdgeKind.edkThrowStatement_HasArgument, node.argument, "THROWSTATEMENT - Could not set argument!");
         }
     }
 }
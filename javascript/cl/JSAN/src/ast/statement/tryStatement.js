@@ -20,29 +20,23 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const tryStatement = factory.createTryStatementWrapper();
-        globals.setPositionInfo(node, tryStatement);
-        return tryStatement;
+        globals.createNode(node, globals.NodeKind.ndkTryStatement);
     } else {
-        const tryStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.handler != null) {
-            globals.safeSet(tryStatementWrapper, "setHandler", node.handler, "TRYSTATEMENT - Could not set handler!");
+            globals.addEdge(node, globals.EdgeKind.edkTryStatement_HasHandler, node.handler, "TRYSTATEMENT - Could not set handler!");
         }
 
         if (node.block != null) {
-            globals.safeSet(tryStatementWrapper, "setBlock", node.block, "TRYSTATEMENT - Could not set block!");
+            globals.addEdge(node, globals.EdgeKind.edkTryStatement_HasBlock, node.block, "TRYSTATEMENT - Could not set block!");
         }
 
         if (node.finalizer != null) {
-            globals.safeSet(tryStatementWrapper, "setFinalizer", node.finalizer, "TRYSTATEMENT - Could not set finalizer!");
+            globals.addEdge(node, globals.EdgeKind.edkTryStatement_HasFinalizer, node.finalizer, "TRYSTATEMENT - Could not set finalizer!");
         }
     }
 }
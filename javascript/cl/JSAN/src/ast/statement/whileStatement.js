@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const whileStatement = factory.createWhileStatementWrapper();
-        globals.setPositionInfo(node, whileStatement);
-        return whileStatement;
+        globals.createNode(node, globals.NodeKind.ndkWhileStatement);
     } else {
-        const whileStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.test != null) {
-            globals.safeSet(whileStatementWrapper, "setTest", node.test, "WHILESTATEMENT - Could not set test!");
+            globals.addEdge(node, globals.EdgeKind.edkWhileStatement_HasTest, node.test, "WHILESTATEMENT - Could not set test!");
         }
 
         if (node.body != null) {
-            globals.safeSet(whileStatementWrapper, "setBody", node.body, "WHILESTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkWhileStatement_HasBody, node.body, "WHILESTATEMENT - Could not set body!");
         }
     }
 }
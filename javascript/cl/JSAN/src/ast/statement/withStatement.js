@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const withStatement = factory.createWithStatementWrapper();
-        globals.setPositionInfo(node, withStatement);
-        return withStatement;
+        globals.createNode(node, globals.NodeKind.ndkWithStatement);
     } else {
-        const withStatementWrapper = globals.getWrapperOfNode(node);
-
         if (node.object != null) {
-            globals.safeSet(withStatementWrapper, "setObject", node.object, "WITHSTATEMENT - Could not set object!");
+            globals.addEdge(node, globals.EdgeKind.edkWithStatement_HasObject, node.object, "WITHSTATEMENT - Could not set object!");
         }
 
         if (node.body != null) {
-            globals.safeSet(withStatementWrapper, "setBody", node.body, "WITHSTATEMENT - Could not set body!");
+            globals.addEdge(node, globals.EdgeKind.edkWithStatement_HasBody, node.body, "WITHSTATEMENT - Could not set body!");
         }
 
     }
@@ -20,22 +20,17 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const classBody = factory.createClassBodyWrapper();
-        globals.setPositionInfo(node, classBody);
-        return classBody;
+        globals.createNode(node, globals.NodeKind.ndkClassBody);
     } else {
-        const classBodyWrapper = globals.getWrapperOfNode(node);
         if (node.body != null) {
             for (let i = 0; i < node.body.length; i++) {
                 if (node.body[i] != null) {
-                    globals.safeSet(classBodyWrapper, "addBody", node.body[i], "CLASSBODY - Could not add body!");
+                    globals.addEdge(node, globals.EdgeKind.edkClassBody_HasBody, node.body[i], "CLASSBODY - Could not add body!");
                 }
             }
         }
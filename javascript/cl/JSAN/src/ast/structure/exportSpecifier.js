@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const exportSpecifier = factory.createExportSpecifierWrapper();
-        globals.setPositionInfo(node, exportSpecifier);
-        return exportSpecifier;
+        globals.createNode(node, globals.NodeKind.ndkExportSpecifier);
     } else {
-        const exportSpecifierWrapper = globals.getWrapperOfNode(node);
-
         if (node.exported != null) {
-            globals.safeSet(exportSpecifierWrapper, "setExported", node.exported, "EXPORTSPECIFIER - Could not set exported!");
+            globals.addEdge(node, globals.EdgeKind.edkExportSpecifier_HasExported, node.exported, "EXPORTSPECIFIER - Could not set exported!");
         }
 
         if (node.local != null) {
-            globals.safeSet(exportSpecifierWrapper, "setLocal", node.local, "EXPORTSPECIFIER - Could not set local!");
+            globals.addEdge(node, globals.EdgeKind.edkModuleSpecifier_HasLocal, node.local, "EXPORTSPECIFIER - Could not set local!");
         }
 
     }
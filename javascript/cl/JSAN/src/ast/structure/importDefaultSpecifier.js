@@ -20,21 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const importDefaultSpecifier = factory.createImportDefaultSpecifierWrapper();
-        globals.setPositionInfo(node, importDefaultSpecifier);
-        return importDefaultSpecifier;
+        globals.createNode(node, globals.NodeKind.ndkImportDefaultSpecifier);
     } else {
-        const importDefaultSpecifierWrapper = globals.getWrapperOfNode(node);
-
         if (node.local != null) {
-            globals.safeSet(importDefaultSpecifierWrapper, "setLocal", node.local, "IMPORTDEFAULTSPECIFIER - Could not set local!");
+            globals.addEdge(node, globals.EdgeKind.edkModuleSpecifier_HasLocal, node.local, "IMPORTDEFAULTSPECIFIER - Could not set local!");
         }
     }
 }
@@ -20,21 +20,15 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const importNamespaceSpecifier = factory.createImportNamespaceSpecifierWrapper();
-        globals.setPositionInfo(node, importNamespaceSpecifier);
-        return importNamespaceSpecifier;
+        globals.createNode(node, globals.NodeKind.ndkImportNamespaceSpecifier);
     } else {
-        const importNamespaceSpecifierWrapper = globals.getWrapperOfNode(node);
-
         if (node.local != null) {
-            globals.safeSet(importNamespaceSpecifierWrapper, "setLocal", node.local, "IMPORTNAMESPACESPECIFIER - Could not set local!");
+            globals.addEdge(node, globals.EdgeKind.edkModuleSpecifier_HasLocal, node.local, "IMPORTNAMESPACESPECIFIER - Could not set local!");
         }
     }
 }
@@ -20,25 +20,19 @@
 
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const importSpecifier = factory.createImportSpecifierWrapper();
-        globals.setPositionInfo(node, importSpecifier);
-        return importSpecifier;
+        globals.createNode(node, globals.NodeKind.ndkImportSpecifier);
     } else {
-        const importSpecifierWrapper = globals.getWrapperOfNode(node);
-
         if (node.imported != null) {
-            globals.safeSet(importSpecifierWrapper, "setImported", node.imported, "IMPORTSPECIFIER - Could not set imported!");
+            globals.addEdge(node, globals.EdgeKind.edkImportSpecifier_HasImported, node.imported, "IMPORTSPECIFIER - Could not set imported!");
         }
 
         if (node.local != null) {
-            globals.safeSet(importSpecifierWrapper, "setLocal", node.local, "IMPORTSPECIFIER - Could not set local!");
+            globals.addEdge(node, globals.EdgeKind.edkModuleSpecifier_HasLocal, node.local, "IMPORTSPECIFIER - Could not set local!");
         }
 
     }
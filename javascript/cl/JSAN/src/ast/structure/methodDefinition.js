@@ -21,28 +21,24 @@
 import * as globals from '../../globals.js';
 import * as conversions from '../conversions.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const methodDefinition = factory.createMethodDefinitionWrapper();
-        globals.setPositionInfo(node, methodDefinition);
-        methodDefinition.setKind(conversions.convertMethodDefinitionKind(node.kind));
-        methodDefinition.setComputed(node.computed);
-        methodDefinition.setStatic(node.static);
-        return methodDefinition;
+        globals.createNode(node, globals.NodeKind.ndkMethodDefinition);
     } else {
         const methodDefinitionWrapper = globals.getWrapperOfNode(node);
+        methodDefinitionWrapper.setKind(conversions.convertMethodDefinitionKind(node.kind));
+        methodDefinitionWrapper.setComputed(node.computed);
+        methodDefinitionWrapper.setStatic(node.static);
 
         if (node.key != null) {
-            globals.safeSet(methodDefinitionWrapper, "setKey", node.key, "METHODDEFINITION - Could not set key!");
+            globals.addEdge(node, globals.EdgeKind.edkMethodDefinition_HasKey, node.key, "METHODDEFINITION - Could not set key!");
         }
 
         if (node.value != null) {
-            globals.safeSet(methodDefinitionWrapper, "setValue", node.value, "METHODDEFINITION - Could not set value!");
+            globals.addEdge(node, globals.EdgeKind.edkMethodDefinition_HasValue, node.value, "METHODDEFINITION - Could not set value!");
         }
 
     }
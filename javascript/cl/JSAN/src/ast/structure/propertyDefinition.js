@@ -1,27 +1,22 @@
 import * as globals from '../../globals.js';
 
-const factory = globals.getFactory();
-
 export default function (node, parent, firstVisit) {
     if (firstVisit) {
-        if (globals.getWrapperOfNode(node) !== undefined) {
+        if (globals.hasNode(node)) {
             return;
         }
-        const propertyDefinition = factory.createPropertyDefinitionWrapper();
-        globals.setPositionInfo(node, propertyDefinition);
-
-        propertyDefinition.setComputed(node.computed);
-        propertyDefinition.setStatic(node.static);
-        return propertyDefinition;
+        globals.createNode(node, globals.NodeKind.ndkPropertyDefinition);
     } else {
         const propertyDefinitionWrapper = globals.getWrapperOfNode(node);
+        propertyDefinitionWrapper.setComputed(node.computed);
+        propertyDefinitionWrapper.setStatic(node.static);
 
         if (node.key !== null) {
-            globals.safeSet(propertyDefinitionWrapper, "setKey", node.key, "PROPERTYDEFINITION - Could not set key!");
+            globals.addEdge(node, globals.EdgeKind.edkPropertyDefinition_HasKey, node.key, "PROPERTYDEFINITION - Could not set key!");
         }
 
         if (node.value !== null) {
-            globals.safeSet(propertyDefinitionWrapper, "setValue", node.value, "PROPERTYDEFINITION - Could not set value!");
+            globals.addEdge(node, globals.EdgeKind.edkPropertyDefinition_HasValue, node.value, "PROPERTYDEFINITION - Could not set value!");
         }
 
     }
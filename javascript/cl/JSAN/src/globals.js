@@ -21,13 +21,21 @@
 import {default as hashmap} from 'hashmap';
 import * as path from 'path';
 import * as addon from '../javascriptAddon.node';
+import {AsgBuilder} from './util/asgBuilder.js';
 
 let nodeAndWrapperMap = new hashmap();
 let actualFile = undefined;
 let factory = new addon.Factory();
+let builder = new AsgBuilder(factory);
 let options = undefined;
 let actualProgramNode = null;
 
+/**
+ * The kinds of the ASG nodes and edges by their names (e.g. NodeKind.ndkIdentifier)
+ */
+const NodeKind = addon.NodeKind;
+const EdgeKind = addon.EdgeKind;
+
 /**
  * Supported extensions by JSAN
  * @type {string[]}
@@ -64,7 +72,16 @@ let putNodeWrapperPair = function (node, wrapper) {
 };
 
 let getWrapperOfNode = function (node) {
-    return nodeAndWrapperMap.get(node); //returns the wrapper
+    let wrapper = nodeAndWrapperMap.get(node);
+    if (wrapper === undefined) {
+        // the wrappers of the nodes created by the builder are made on demand
+        const id = builder.getId(node);
+        if (id !== undefined) {
+            wrapper = factory.getWrapper(id);
+            nodeAndWrapperMap.set(node, wrapper);
+        }
+    }
+    return wrapper;
 };
 
 let setOptions = function (opt) {
@@ -83,35 +100,71 @@ let getOption = function (obj) {
     return false;
 };
 
+let getPath = function () {
+    if (options.useRelativePath) {
+        return path.relative(process.cwd(), actualFile);
+    }
+    return actualFile;
+};
+
+let getPosition = function (node) {
+    //A JS file always starts from 1,1 (line, column)
+    if (node.type === "Program") {
+        return [1, 0, node.loc.end.line, node.loc.end.column, 1, 0, node.loc.end.line, node.loc.end.column];
+    }
+    return [
+        node.loc.start.line,
+        node.loc.start.column,
+        node.loc.end.line,
+        node.loc.end.column,
+        node.loc.start.line,
+        node.loc.start.column,
+        node.loc.end.line,
+        node.loc.end.column
+    ];
+};
+
 let setPositionInfo = function (node, wrapper) {
     try {
-        if (options.useRelativePath) {
-            wrapper.setPath(path.relative(process.cwd(), actualFile));
-        } else {
-            wrapper.setPath(actualFile);
-        }
-
-        //A JS file always starts from 1,1 (line, column)
-        if (node.type === "Program") {
-            wrapper.setPosition(1, 0, node.loc.end.line, node.loc.end.column, 1, 0, node.loc.end.line, node.loc.end.column);
-        } else {
-            wrapper.setPosition(
-                node.loc.start.line,
-                node.loc.start.column,
-                node.loc.end.line,
-                node.loc.end.column,
-                node.loc.start.line,
-                node.loc.start.column,
-                node.loc.end.line,
-                node.loc.end.column
-            );
-        }
+        wrapper.setPath(getPath());
+        wrapper.setPosition(...getPosition(node));
+    } catch (e) {
+        console.error(node.type + " - Position cannot be set! Reason of the error: " + e + "\n");
+    }
+};
 
+/**
+ * Adds an ASG node of the given kind with the position (and the name) of the estree node to the builder.
+ * The node is created by the next flushNodes() call, its wrapper is available by getWrapperOfNode() afterwards.
+ */
+let createNode = function (node, kind, name) {
+    try {
+        builder.addNode(node, kind, getPath(), getPosition(node), name);
     } catch (e) {
         console.error(node.type + " - Position cannot be set! Reason of the error: " + e + "\n");
     }
 };
 
+let hasNode = function (node) {
+    return builder.hasNode(node) || nodeAndWrapperMap.has(node);
+};
+
+/**
+ * Adds an edge between the ASG nodes of the estree nodes to the builder, it is created by the next flushEdges() call.
+ * Nothing happens if the target has no ASG node (like in safeSet()).
+ */
+let addEdge = function (node, edgeKind, nodeToAdd, errorMessage) {
+    builder.addEdge(node, edgeKind, nodeToAdd, errorMessage);
+};
+
+let flushNodes = function () {
+    builder.buildNodes();
+};
+
+let flushEdges = function () {
+    builder.buildEdges();
+};
+
 let getLiteralType = function (node) {
     if (typeof (node.value) !== "object") {
         const type = typeof (node.value);
@@ -162,7 +215,14 @@ export {
     getOptions,
     getOption,
     setPositionInfo,
+    createNode,
+    hasNode,
+    addEdge,
+    flushNodes,
+    flushEdges,
     getLiteralType,
     safeSet,
+    NodeKind,
+    EdgeKind,
     supportedExts
 }
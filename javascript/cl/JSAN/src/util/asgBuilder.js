@@ -0,0 +1,188 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+/**
+ * Marks a missing path or name in the string index columns.
+ * @type {number}
+ */
+const NO_STRING = 0xFFFFFFFF;
+
+/**
+ * A typed array which grows like a plain array.
+ */
+class GrowableArray {
+    constructor(ArrayType, capacity = 1024) {
+        this.ArrayType = ArrayType;
+        this.data = new ArrayType(capacity);
+        this.length = 0;
+    }
+
+    push(...values) {
+        this.append(values);
+    }
+
+    append(values) {
+        if (this.length + values.length > this.data.length) {
+            const data = new this.ArrayType(Math.max(this.data.length * 2, this.length + values.length));
+            data.set(this.data);
+            this.data = data;
+        }
+        for (const value of values) {
+            this.data[this.length++] = value;
+        }
+    }
+
+    /**
+     * The values from the given index, without copying them.
+     */
+    slice(begin = 0) {
+        return this.data.subarray(begin, this.length);
+    }
+
+    clear() {
+        this.length = 0;
+    }
+}
+
+/**
+ * Collects the ASG nodes and edges in columns (typed arrays) and builds them in the addon by one call per column set,
+ * instead of creating a wrapper object and calling its setters for every node and edge.
+ *
+ * The nodes are referred by their estree node until they are built, then by the id of the ASG node.
+ */
+class AsgBuilder {
+    constructor(factory) {
+        this.factory = factory;
+
+        // node columns: one kind, path and name index and 8 positions for every node
+        this.nodeIndexes = new Map();
+        this.ids = new GrowableArray(Uint32Array);
+        this.kinds = new GrowableArray(Uint16Array);
+        this.positions = new GrowableArray(Int32Array);
+        this.paths = new GrowableArray(Uint32Array);
+        this.names = new GrowableArray(Uint32Array);
+
+        // edge columns: (source node index, edge kind, target node index) triplets and the message of the failure
+        this.edges = new GrowableArray(Uint32Array);
+        this.edgeMessages = [];
+
+        this.strings = [];
+        this.stringIndexes = new Map();
+    }
+
+    internString(string) {
+        let index = this.stringIndexes.get(string);
+        if (index === undefined) {
+            index = this.strings.length;
+            this.strings.push(string);
+            this.stringIndexes.set(string, index);
+        }
+        return index;
+    }
+
+    hasNode(node) {
+        return this.nodeIndexes.has(node);
+    }
+
+    /**
+     * Returns the id of the ASG node of the estree node, or undefined if it is not built (yet).
+     */
+    getId(node) {
+        const index = this.nodeIndexes.get(node);
+        if (index === undefined || index >= this.ids.length) {
+            return undefined;
+        }
+        return this.ids.data[index];
+    }
+
+    /**
+     * Adds a node to the next build.
+     * @param node the estree node
+     * @param kind the NodeKind of the ASG node
+     * @param path the path of the file of the node
+     * @param position line, col, endline, endcol, wideline, widecol, wideendline, wideendcol
+     * @param name the name of a Named node, or undefined
+     */
+    addNode(node, kind, path, position, name) {
+        this.nodeIndexes.set(node, this.ids.length + this.kinds.length);
+        this.kinds.push(kind);
+        this.positions.push(...position);
+        this.paths.push(path === undefined ? NO_STRING : this.internString(path));
+        this.names.push(name === undefined ? NO_STRING : this.internString(name));
+    }
+
+    /**
+     * Adds an edge to the next build of the edges. The edge is dropped if the target has no ASG node.
+     * @return false if the source or the target has no ASG node
+     */
+    addEdge(source, edgeKind, target, errorMessage) {
+        const sourceIndex = this.nodeIndexes.get(source);
+        const targetIndex = this.nodeIndexes.get(target);
+        if (sourceIndex === undefined || targetIndex === undefined) {
+            return false;
+        }
+        this.edges.push(sourceIndex, edgeKind, targetIndex);
+        this.edgeMessages.push(errorMessage);
+        return true;
+    }
+
+    /**
+     * Creates the collected nodes in the addon.
+     */
+    buildNodes() {
+        if (this.kinds.length === 0) {
+            return;
+        }
+        const ids = this.factory.createNodes(this.kinds.slice(), this.positions.slice(), this.paths.slice(), this.names.slice(), this.strings);
+        this.ids.append(ids);
+
+        this.kinds.clear();
+        this.positions.clear();
+        this.paths.clear();
+        this.names.clear();
+        this.strings = [];
+        this.stringIndexes.clear();
+    }
+
+    /**
+     * Creates the collected edges in the addon. The nodes must be built before.
+     */
+    buildEdges() {
+        if (this.edges.length === 0) {
+            return;
+        }
+        const edges = this.edges.slice();
+        for (let i = 0; i < edges.length; i += 3) {
+            edges[i] = this.ids.data[edges[i]];
+            edges[i + 2] = this.ids.data[edges[i + 2]];
+        }
+        const failures = this.factory.addEdges(edges);
+        for (const failure of failures) {
+            console.error(`${this.edgeMessages[failure.index]}. Reason of the error: ${failure.reason}\n`);
+        }
+
+        this.edges.clear();
+        this.edgeMessages = [];
+    }
+}
+
+export {
+    AsgBuilder
+}
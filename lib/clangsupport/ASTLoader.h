@@ -38,6 +38,11 @@ namespace columbus
     std::shared_ptr<NodeIDMaps> nodeIdMaps;
   } ASTWithNodeIDMaps;
 
+  /**
+   * Loads the AST file. An AST file written by CAN with a shared precompiled header (CAN -pch) contains only the
+   * declarations of its translation unit, the precompiled header it references (by absolute path) is loaded by clang
+   * together with it, so the result is the same as with a self-contained AST file.
+   */
   ASTWithNodeIDMaps loadAST(const std::string& astFilename, const bool cacheLast = false);
 
 } // namespace columbus
@@ -24,7 +24,17 @@
 #include <string>
 #include <list>
 #include <map>
+#include <memory>
 
+/**
+* \brief Filters paths by the regular expressions of a filter file.
+*
+* Every line of the filter file starts with '+' (include) or '-' (exclude) followed by an extended regular expression.
+* The last matching line decides about a path. The lines are compiled once when the file is loaded: the literal
+* patterns are matched with a prefix trie and string comparisons, and only the real regular expressions are run.
+* The compiled filter is immutable and shared by the copies of the object, so isFilteredOut() can be called from
+* several threads at the same time.
+*/
 class DirectoryFilter {
 public:
   DirectoryFilter();
@@ -46,11 +56,21 @@ public:
   /**
   * \return           True, if the filter_list is empty, false otherwise.
   */
-  bool isEmpty();
+  bool isEmpty() const;
+
+  /**
+  * \brief Gives back the filter of the given filter file, which is loaded and compiled only once in the process.
+  *        If the file cannot be opened, the returned filter is empty.
+  * \param fltp       [in] The given filter file.
+  * \return           The shared filter.
+  */
+  static std::shared_ptr<const DirectoryFilter> getSharedFilter(const std::string& fltp);
 
 private:
+  struct CompiledFilter;
+
   std::list<std::string> filter_list;
-  mutable std::map<std::string, bool> filter_cache;
+  std::shared_ptr<CompiledFilter> compiled_filter;
 };
 
 #endif
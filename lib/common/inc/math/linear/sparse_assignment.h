@@ -0,0 +1,222 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef __COLUMBUS__COMMON__MATH_SPARSE_ASSIGNMENT_H
+#define __COLUMBUS__COMMON__MATH_SPARSE_ASSIGNMENT_H
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace common { namespace math {
+
+  /**
+   * \brief Minimum cost assignment over a sparse cost matrix.
+   *
+   * Only the finite entries are stored, missing entries mean that the row and the column cannot be paired.
+   * The solver returns a matching with the maximal number of pairs, and among those one with minimal overall cost,
+   * which is what the HungarianMethod computes for a dense matrix filled with infinity.
+   * The bipartite graph is split into its connected components first, and every component is solved with
+   * successive shortest augmenting paths (Dijkstra on reduced costs), so the work depends on the number of
+   * stored entries instead of rows*cols.
+   */
+  template<typename eType>
+  class SparseAssignment {
+  private:
+    static const unsigned int NONE = (unsigned int)-1;
+
+    unsigned int rows;
+    unsigned int cols;
+    std::vector<std::vector<std::pair<unsigned int, eType> > > edges;   // row -> (col, cost)
+
+    unsigned int find(std::vector<unsigned int>& parent, unsigned int x) {
+      while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+      }
+      return x;
+    }
+
+    /**
+     * \brief solves one connected component
+     * \param compRows [in] the rows of the component in increasing order
+     * \param compCols [in] the columns of the component in increasing order
+     * \param solution [out] the pairs are inserted as col -> row
+     */
+    void solveComponent(const std::vector<unsigned int>& compRows, const std::vector<unsigned int>& compCols, std::vector<unsigned int>& localIndex, std::map<unsigned int, unsigned int>& solution) {
+      const eType linf = std::numeric_limits<eType>::infinity();
+      const unsigned int R = (unsigned int)compRows.size();
+      const unsigned int C = (unsigned int)compCols.size();
+      const unsigned int T = R + C;
+
+      for (unsigned int i = 0; i < C; ++i)
+        localIndex[compCols[i]] = i;
+
+      // local edge lists (col indices are local, the order of the original entries is kept)
+      std::vector<std::vector<std::pair<unsigned int, eType> > > adj(R);
+      for (unsigned int r = 0; r < R; ++r) {
+        const std::vector<std::pair<unsigned int, eType> >& rowEdges = edges[compRows[r]];
+        adj[r].reserve(rowEdges.size());
+        for (typename std::vector<std::pair<unsigned int, eType> >::const_iterator it = rowEdges.begin(); it != rowEdges.end(); ++it)
+          adj[r].push_back(std::make_pair(localIndex[it->first], it->second));
+      }
+
+      std::vector<eType> potential(T + 1, eType());
+      std::vector<eType> dist(T + 1);
+      std::vector<unsigned int> matchOfRow(R, NONE);
+      std::vector<eType> costOfRow(R, eType());
+      std::vector<unsigned int> matchOfCol(C, NONE);
+      std::vector<unsigned int> prevRowOfCol(C, NONE);
+      std::vector<eType> prevCostOfCol(C, eType());
+      unsigned int lastCol = NONE;
+
+      typedef std::pair<eType, unsigned int> QueueItem;
+
+      const unsigned int maxPairs = std::min(R, C);
+      for (unsigned int pairs = 0; pairs < maxPairs; ++pairs) {
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > queue;
+        std::fill(dist.begin(), dist.end(), linf);
+        for (unsigned int r = 0; r < R; ++r) {
+          if (matchOfRow[r] == NONE) {
+            dist[r] = std::max(eType(), -potential[r]);
+            queue.push(QueueItem(dist[r], r));
+          }
+        }
+
+        while (!queue.empty()) {
+          QueueItem item = queue.top();
+          queue.pop();
+          unsigned int x = item.second;
+          if (item.first > dist[x])
+            continue;
+          if (x == T)
+            break;
+
+          if (x < R) {
+            for (typename std::vector<std::pair<unsigned int, eType> >::const_iterator it = adj[x].begin(); it != adj[x].end(); ++it) {
+              if (matchOfRow[x] == it->first)
+                continue;
+              unsigned int y = R + it->first;
+              eType nd = dist[x] + std::max(eType(), it->second + potential[x] - potential[y]);
+              if (nd < dist[y]) {
+                dist[y] = nd;
+                prevRowOfCol[it->first] = x;
+                prevCostOfCol[it->first] = it->second;
+                queue.push(QueueItem(nd, y));
+              }
+            }
+          } else {
+            unsigned int c = x - R;
+            if (matchOfCol[c] == NONE) {
+              eType nd = dist[x] + std::max(eType(), potential[x] - potential[T]);
+              if (nd < dist[T]) {
+                dist[T] = nd;
+                lastCol = c;
+                queue.push(QueueItem(nd, T));
+              }
+            } else {
+              unsigned int r = matchOfCol[c];
+              eType nd = dist[x] + std::max(eType(), potential[x] - potential[r] - costOfRow[r]);
+              if (nd < dist[r]) {
+                dist[r] = nd;
+                queue.push(QueueItem(nd, r));
+              }
+            }
+          }
+        }
+
+        if (dist[T] == linf)
+          break;
+
+        const eType D = dist[T];
+        for (unsigned int i = 0; i <= T; ++i)
+          potential[i] += std::min(dist[i], D);
+
+        // augment along the path ending at lastCol
+        unsigned int c = lastCol;
+        while (true) {
+          unsigned int r = prevRowOfCol[c];
+          unsigned int oldCol = matchOfRow[r];
+          matchOfRow[r] = c;
+          costOfRow[r] = prevCostOfCol[c];
+          matchOfCol[c] = r;
+          if (oldCol == NONE)
+            break;
+          c = oldCol;
+        }
+      }
+
+      for (unsigned int c = 0; c < C; ++c)
+        if (matchOfCol[c] != NONE)
+          solution.insert(std::map<unsigned int, unsigned int>::value_type(compCols[c], compRows[matchOfCol[c]]));
+    }
+
+  public:
+    SparseAssignment(unsigned int _rows, unsigned int _cols) : rows(_rows), cols(_cols), edges(_rows) {}
+
+    /**
+     * \brief sets the cost of pairing the given row and column (infinite costs are not stored)
+     */
+    void add(unsigned int row, unsigned int col, eType cost) {
+      if (cost == std::numeric_limits<eType>::infinity())
+        return;
+      edges[row].push_back(std::make_pair(col, cost));
+    }
+
+    /**
+     * \brief computes the assignment
+     * \return the pairs as col -> row, like HungarianMethod::solve
+     */
+    std::map<unsigned int, unsigned int> solve() {
+      std::map<unsigned int, unsigned int> solution;
+
+      // rows are 0..rows-1, columns are rows..rows+cols-1 in the union-find
+      std::vector<unsigned int> parent(rows + cols);
+      for (unsigned int i = 0; i < rows + cols; ++i)
+        parent[i] = i;
+      for (unsigned int r = 0; r < rows; ++r)
+        for (typename std::vector<std::pair<unsigned int, eType> >::const_iterator it = edges[r].begin(); it != edges[r].end(); ++it)
+          parent[find(parent, r)] = find(parent, rows + it->first);
+
+      std::map<unsigned int, std::pair<std::vector<unsigned int>, std::vector<unsigned int> > > components;
+      for (unsigned int r = 0; r < rows; ++r)
+        if (!edges[r].empty())
+          components[find(parent, r)].first.push_back(r);
+      for (unsigned int c = 0; c < cols; ++c) {
+        unsigned int root = find(parent, rows + c);
+        typename std::map<unsigned int, std::pair<std::vector<unsigned int>, std::vector<unsigned int> > >::iterator it = components.find(root);
+        if (it != components.end())
+          it->second.second.push_back(c);
+      }
+
+      std::vector<unsigned int> localIndex(cols, NONE);
+      for (typename std::map<unsigned int, std::pair<std::vector<unsigned int>, std::vector<unsigned int> > >::iterator it = components.begin(); it != components.end(); ++it)
+        solveComponent(it->second.first, it->second.second, localIndex, solution);
+
+      return solution;
+    }
+
+  };
+}}
+
+#endif
@@ -23,52 +23,252 @@
 #include "../inc/messages.h"
 #include "../inc/StringSup.h"
 #include <boost/regex.hpp>
+#include <cctype>
+#include <cstring>
 #include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace common;
 
-bool DirectoryFilter::isFilteredOut(const std::string& path ) const
-{
-  if (filter_list.empty())
-    return false;
+/**
+* \internal
+* \brief The filter lines compiled into matchers. The index of a pattern is its position in the filter file, so the
+*        last matching line is the matching pattern with the largest index.
+*/
+struct DirectoryFilter::CompiledFilter {
+  enum PatternKind {
+    pkSubstring,  // literal anywhere in the path
+    pkPrefix,     // ^literal
+    pkSuffix,     // literal$
+    pkExact,      // ^literal$
+    pkRegex       // everything else
+  };
 
-  std::map<std::string, bool>::const_iterator pathIt = filter_cache.find(path);
-  if (pathIt != filter_cache.end())
-    return pathIt->second;
-    
-  bool isFiltered = false;
+  struct Pattern {
+    PatternKind kind;
+    bool filterOut;
+    std::string literal;
+    boost::regex regex;
+  };
 
-  for (std::list<std::string>::const_reverse_iterator rit = filter_list.rbegin(); rit != filter_list.rend(); ++rit) {
-    try {
-      char fltp = (*rit)[0];
-      std::string tmp = rit->substr(1, std::string::npos);
+  struct TrieNode {
+    std::map<char, size_t> children;
+    int pattern;  // the last prefix pattern ending in this node or -1
+
+    TrieNode() : children(), pattern(-1) {}
+  };
+
+  std::vector<Pattern> patterns;
+  // the prefix patterns, node 0 is the root
+  std::vector<TrieNode> prefixTrie;
+  // the last exact pattern of every literal
+  std::unordered_map<std::string, int> exactPatterns;
+  // the substring, suffix and regex patterns in reverse order
+  std::vector<int> otherPatterns;
+  bool hasRegex;
+
+  // the results of the regular expressions are cached like before
+  mutable std::shared_mutex cacheMutex;
+  mutable std::unordered_map<std::string, bool> cache;
+
+  explicit CompiledFilter(const std::list<std::string>& filterList);
 
+  bool isFilteredOut(const std::string& path) const;
+
+private:
+  void addPattern(const std::string& line);
+  int findLastMatching(const std::string& path) const;
+};
+
+// Literals are compared case insensitively on Windows like the regular expressions.
+static std::string normalizeCase(const std::string& str) {
+#ifdef _WIN32
+  std::string result(str);
+  for (char& c : result)
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  return result;
+#else
+  return str;
+#endif
+}
+
+// Gives back true if the extended regular expression is a (possibly anchored) literal string.
+static bool parseLiteral(const std::string& re, std::string& literal, bool& anchoredStart, bool& anchoredEnd) {
+  size_t begin = 0;
+  size_t end = re.size();
+  anchoredStart = !re.empty() && re[0] == '^';
+  if (anchoredStart)
+    ++begin;
+  anchoredEnd = false;
+  if (end > begin && re[end - 1] == '$') {
+    size_t backslashes = 0;
+    for (size_t i = end - 1; i > begin && re[i - 1] == '\\'; --i)
+      ++backslashes;
+    if (backslashes % 2 == 0) {
+      anchoredEnd = true;
+      --end;
+    }
+  }
 
+  literal.clear();
+  for (size_t i = begin; i < end; ++i) {
+    char c = re[i];
+    if (c == '\\') {
+      if (i + 1 >= end)
+        return false;
+      char escaped = re[i + 1];
+      // escaped letters, digits and the word and buffer boundaries are not literals
+      if (std::isalnum(static_cast<unsigned char>(escaped)) || std::strchr("<>`'", escaped))
+        return false;
+      literal += escaped;
+      ++i;
+    } else if (std::strchr(".[]()*+?{}|^$", c)) {
+      return false;
+    } else {
+      literal += c;
+    }
+  }
+  return true;
+}
+
+DirectoryFilter::CompiledFilter::CompiledFilter(const std::list<std::string>& filterList)
+  : patterns()
+  , prefixTrie(1)
+  , exactPatterns()
+  , otherPatterns()
+  , hasRegex(false)
+  , cacheMutex()
+  , cache()
+{
+  for (const std::string& line : filterList)
+    addPattern(line);
+  for (int i = static_cast<int>(patterns.size()) - 1; i >= 0; --i) {
+    if (patterns[i].kind != pkPrefix && patterns[i].kind != pkExact)
+      otherPatterns.push_back(i);
+  }
+}
+
+void DirectoryFilter::CompiledFilter::addPattern(const std::string& line) {
+  Pattern pattern;
+  pattern.filterOut = line[0] == '-';
+  std::string re = line.substr(1, std::string::npos);
+
+  bool anchoredStart;
+  bool anchoredEnd;
+  if (parseLiteral(re, pattern.literal, anchoredStart, anchoredEnd)) {
+    pattern.literal = normalizeCase(pattern.literal);
+    pattern.kind = anchoredStart ? (anchoredEnd ? pkExact : pkPrefix) : (anchoredEnd ? pkSuffix : pkSubstring);
+  } else {
+    try {
 #if defined(__linux__)
-      boost::regex re(tmp, boost::regex::extended);
+      pattern.regex = boost::regex(re, boost::regex::extended);
 #endif
 
 #ifdef _WIN32
-      boost::regex re(tmp, boost::regex::extended | boost::regex::icase);
+      pattern.regex = boost::regex(re, boost::regex::extended | boost::regex::icase);
 #endif
+    }
+    catch (const boost::bad_expression& e) {
+      // an invalid line never matches
+      WriteMsg::write(CMSG_CANT_PARSE, line.c_str(), e.what());
+      return;
+    }
+    pattern.kind = pkRegex;
+    hasRegex = true;
+  }
 
-      if(boost::regex_search(path, re)) {
-        if (fltp == '-') {
-          isFiltered = true;
-        }
-        break;
+  int index = static_cast<int>(patterns.size());
+  if (pattern.kind == pkPrefix) {
+    size_t node = 0;
+    for (char c : pattern.literal) {
+      std::map<char, size_t>::iterator child = prefixTrie[node].children.find(c);
+      if (child == prefixTrie[node].children.end()) {
+        prefixTrie.push_back(TrieNode());
+        child = prefixTrie[node].children.insert(std::make_pair(c, prefixTrie.size() - 1)).first;
       }
+      node = child->second;
     }
-    catch (const boost::bad_expression& e){
-      WriteMsg::write(CMSG_CANT_PARSE,rit->c_str(),e.what());
+    prefixTrie[node].pattern = index;
+  } else if (pattern.kind == pkExact) {
+    exactPatterns[pattern.literal] = index;
+  }
+  patterns.push_back(std::move(pattern));
+}
+
+int DirectoryFilter::CompiledFilter::findLastMatching(const std::string& originalPath) const {
+  const std::string path = normalizeCase(originalPath);
+  // every trie node on the path of the string is a matching prefix
+  size_t node = 0;
+  int last = prefixTrie[node].pattern;
+  for (char c : path) {
+    std::map<char, size_t>::const_iterator child = prefixTrie[node].children.find(c);
+    if (child == prefixTrie[node].children.end())
+      break;
+    node = child->second;
+    last = std::max(last, prefixTrie[node].pattern);
+  }
+
+  std::unordered_map<std::string, int>::const_iterator exact = exactPatterns.find(path);
+  if (exact != exactPatterns.end())
+    last = std::max(last, exact->second);
+
+  // only the patterns after the last match found so far have to be checked
+  for (int index : otherPatterns) {
+    if (index <= last)
+      break;
+    const Pattern& pattern = patterns[index];
+    bool matches = false;
+    switch (pattern.kind) {
+      case pkSubstring:
+        matches = path.find(pattern.literal) != std::string::npos;
+        break;
+      case pkSuffix:
+        matches = path.size() >= pattern.literal.size() && path.compare(path.size() - pattern.literal.size(), pattern.literal.size(), pattern.literal) == 0;
+        break;
+      case pkRegex:
+        matches = boost::regex_search(originalPath, pattern.regex);
+        break;
+      default:
+        break;
     }
+    if (matches)
+      return index;
+  }
+  return last;
+}
+
+bool DirectoryFilter::CompiledFilter::isFilteredOut(const std::string& path) const {
+  if (!hasRegex) {
+    int last = findLastMatching(path);
+    return last >= 0 && patterns[last].filterOut;
   }
-  
-  filter_cache.insert(std::make_pair(path, isFiltered));
-    
+
+  {
+    std::shared_lock<std::shared_mutex> lock(cacheMutex);
+    std::unordered_map<std::string, bool>::const_iterator pathIt = cache.find(path);
+    if (pathIt != cache.end())
+      return pathIt->second;
+  }
+
+  int last = findLastMatching(path);
+  bool isFiltered = last >= 0 && patterns[last].filterOut;
+
+  std::unique_lock<std::shared_mutex> lock(cacheMutex);
+  cache.insert(std::make_pair(path, isFiltered));
   return isFiltered;
 }
 
+bool DirectoryFilter::isFilteredOut(const std::string& path ) const
+{
+  if (filter_list.empty() || !compiled_filter)
+    return false;
+
+  return compiled_filter->isFilteredOut(path);
+}
+
 bool DirectoryFilter::openFilterFile( std::string fltp )
 {
   std::ifstream ifs(fltp.c_str());
@@ -94,16 +294,33 @@ bool DirectoryFilter::openFilterFile( std::string fltp )
   } else {
     return false;
   }
+  compiled_filter = std::make_shared<CompiledFilter>(filter_list);
   return true;
 }
 
-bool DirectoryFilter::isEmpty()
+bool DirectoryFilter::isEmpty() const
 {
   return filter_list.empty();
 }
 
+std::shared_ptr<const DirectoryFilter> DirectoryFilter::getSharedFilter(const std::string& fltp)
+{
+  static std::mutex sharedFiltersMutex;
+  static std::map<std::string, std::shared_ptr<const DirectoryFilter> > sharedFilters;
+
+  std::lock_guard<std::mutex> lock(sharedFiltersMutex);
+  std::shared_ptr<const DirectoryFilter>& filter = sharedFilters[fltp];
+  if (!filter) {
+    std::shared_ptr<DirectoryFilter> newFilter = std::make_shared<DirectoryFilter>();
+    newFilter->openFilterFile(fltp);
+    filter = newFilter;
+  }
+  return filter;
+}
+
 DirectoryFilter::DirectoryFilter()
   :filter_list()
+  ,compiled_filter()
 {
 }
 
@@ -42,6 +42,7 @@
 #define CMSG_EX_L2P_NO_PARAMETER                              "LIM2Patterns does not have parameter set!"
 #define CMSG_EX_L2P_SETTINGS_NOT_FOUND                        "LIM2Patterns settings is not found: "
 #define CMSG_ERROR_CREATE_DIR                                 "ERROR: Can't create %s dir.\n"
+#define CMSG_ERROR_OPEN_FILE                                  "ERROR: Can't open %s file.\n"
 #define CMSG_ERROR_EXECUTION_FAILURE                          "ERROR: Execution failure! Exit:%d\n"
 #define CMSG_ERROR_ENVSET_FAILURE                             "ERROR: Failed to set '%s' environment variable!\n"
 #define CMSG_WARNING_ENVSET_OVERWRITE                         "WARNING: Overwriting '%s' environment variable!\n"
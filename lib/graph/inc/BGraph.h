@@ -25,9 +25,11 @@
 #include <set>
 #include <map>
 #include <queue>
+#include <unordered_map>
+#include <vector>
+#include <boost/functional/hash.hpp>
 #include <strtable/inc/StrTable.h>
 #include <io/inc/IO.h>
-#include <jsoncpp/inc/json.h>
 
 
 /**
@@ -177,8 +179,9 @@ namespace columbus {  namespace graph {
       BGraph* g;
       StrTable* strTable;
 
-      typedef std::map<Key,GraphVertex> KeyMap;
-      typedef std::map<GraphEdge, GraphEdge> EdgePairMap; 
+      // These are only used for lookups (never iterated), so hashing does not change any output order.
+      typedef std::unordered_map<Key,GraphVertex> KeyMap;
+      typedef std::unordered_map<GraphEdge, GraphEdge, boost::hash<GraphEdge> > EdgePairMap;
 
       KeyMap nodeUIDs;
       EdgePairMap edgePairMap;
@@ -220,11 +223,11 @@ namespace columbus {  namespace graph {
 
       /**
       * \internal
-      * \brief add attribute to a JSON node
+      * \brief write a attribute with values to JSON
       * \param attribute [in] the attribute
-      * \param node [in/out] the JSON node to which the attribute will be added
+      * \param jio [in] the JSON out
       */
-      void addAttributeToJsonNode(Attribute& attribute, Json::Value& node) const;
+      void writeAttributeToJson(Attribute& attribute, io::JsonIO& jio) const;
 
       /**
       * \internal
@@ -267,6 +270,7 @@ namespace columbus {  namespace graph {
 
       BGraph* getBGraph() const;
       StrTable* getStrTable() const;
+      static GraphVertex getVertex(const Node& node) { return node.vertex; }
       const std::string& getVertexUID(const GraphVertex& vertex) const;
       void setVertexUID(const GraphVertex& vertex, const std::string& uid);
       const Node::NodeType getVertexType(const GraphVertex& vertex) const;
@@ -336,6 +340,45 @@ namespace columbus {  namespace graph {
         nmmSummarizeAttributes
       };
 
+    public:
+
+      /**
+      * \brief writes the XML dump of the graph node by node, saveXML() gives it the nodes in UID order
+      *
+      * It reads the storage of the graph directly and creates no iterators (the iterators register themselves
+      * in the graph), so more writers can run on separate threads while the graph is not modified.
+      */
+      class XMLWriter {
+        public:
+          XMLWriter(const Graph& graph, io::SimpleXmlIO& sio);
+          void writeBegin();
+          void writeNode(const Node& node);
+          void writeEnd();
+
+        private:
+          const Graph& graph;
+          io::SimpleXmlIO& sio;
+          std::set<GraphEdge> savedEdgePairs;
+      };
+
+      /**
+      * \brief writes the JSON dump of the graph node by node, saveJSON() gives it the nodes in UID order
+      *
+      * The document is written to the stream as it goes, it is not built in the memory. Like XMLWriter,
+      * it creates no iterators.
+      */
+      class JSONWriter {
+        public:
+          JSONWriter(const Graph& graph, io::JsonIO& jio);
+          void writeBegin();
+          void writeNode(const Node& node);
+          void writeEnd();
+
+        private:
+          const Graph& graph;
+          io::JsonIO& jio;
+      };
+
     public:
 
       /**
@@ -498,6 +541,12 @@ namespace columbus {  namespace graph {
 
       void saveJSON(const std::string& filename) const;
 
+      /**
+      * \brief get all nodes sorted by their UIDs (the order of the XML and JSON dumps)
+      * \return the nodes
+      */
+      std::vector<Node> getNodesOrderedByUID() const;
+
       /**
       * \brief get iterator to all nodes
       * \return iterator to nodes
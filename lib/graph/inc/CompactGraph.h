@@ -0,0 +1,221 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _GRAPHCOMPACTGRAPH_H
+#define _GRAPHCOMPACTGRAPH_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <strtable/inc/StrTable.h>
+#include "graph.h"
+
+/**
+* \file CompactGraph.h
+* \brief Contains the compressed sparse row representation of the graph
+*/
+
+namespace columbus {  namespace graph {
+
+  /**
+  * \brief read-mostly graph stored in compressed sparse row form
+  *
+  * It is an alternative of Graph for the tools which only read (and maybe update the numeric values of) a
+  * graph loaded from a binary file. The nodes get dense ids in the order of their creation, which is the
+  * order of the vertices of a Graph loaded from the same file. The out edges of a node are stored
+  * consecutively, in the same order as in Graph, every edge knows its pair (the reverse edge of a
+  * directional edge or the other half of a bidirectional edge). The attributes are stored in preorder
+  * (a composite attribute is followed by its subtree) and their values are stored in typed columns.
+  * The UIDs, types, names and string values are keys of the string table of the graph.
+  *
+  * The saveBinary(), saveXML() and saveJSON() methods give the same output as the methods of Graph.
+  */
+  class CompactGraph {
+
+    public:
+
+      /** \brief dense id of a node */
+      typedef std::uint32_t NodeId;
+      /** \brief dense id of an edge */
+      typedef std::uint32_t EdgeId;
+      /** \brief dense id of an attribute */
+      typedef std::uint32_t AttributeId;
+
+      /** \brief the invalid node, edge and attribute id */
+      static constexpr std::uint32_t invalidId = 0xFFFFFFFF;
+
+      /**
+      * \brief iterates the attributes of a node, an edge or a composite attribute (the subtrees of the composites are skipped)
+      */
+      class AttributeIterator {
+        public:
+          bool hasNext() const { return current != end; }
+          AttributeId next();
+
+        private:
+          AttributeIterator(const CompactGraph& graph, AttributeId begin, AttributeId end) : graph(&graph), current(begin), end(end) {}
+
+          const CompactGraph* graph;
+          AttributeId current;
+          AttributeId end;
+
+        friend class CompactGraph;
+      };
+
+    public:
+
+      CompactGraph();
+
+      void clear();
+
+      /**
+      * \brief loads the graph saved by Graph::saveBinary()
+      * \param filename [in] the binary graph
+      * \throw GraphException if the file is corrupt
+      */
+      void loadBinary(const std::string& filename);
+
+      void saveBinary(const std::string& filename) const;
+      void saveXML(const std::string& filename) const;
+      void saveJSON(const std::string& filename) const;
+
+      StrTable& getStrTable() { return strTable; }
+      const StrTable& getStrTable() const { return strTable; }
+
+      /**
+      * \brief get information
+      * \param key [in] the info name
+      * \return the information value
+      * \throw GraphException if key doesn't exist
+      */
+      std::string getHeaderInfo(const std::string& key) const;
+      std::vector<std::string> getHeaderKeys() const;
+
+      // nodes
+
+      NodeId getNodeCount() const { return static_cast<NodeId>(nodeUIDs.size()); }
+
+      /**
+      * \brief find a node by its UID, O(1)
+      * \return the id of the node or invalidId
+      */
+      NodeId findNode(const std::string& UID) const;
+      const std::string& getUID(NodeId node) const { return strTable.get(nodeUIDs[node]); }
+      const std::string& getType(NodeId node) const { return strTable.get(nodeTypes[node]); }
+      Key getTypeKey(NodeId node) const { return nodeTypes[node]; }
+
+      /**
+      * \brief the out edges of the node are the [first, second) ids
+      */
+      std::pair<EdgeId, EdgeId> getOutEdges(NodeId node) const { return std::make_pair(outEdgeOffsets[node], outEdgeOffsets[node + 1]); }
+      AttributeIterator getAttributes(NodeId node) const { return AttributeIterator(*this, nodeAttributes[node].first, nodeAttributes[node].second); }
+
+      /**
+      * \brief find the first attribute of the node with the given type, name and context
+      * \return the id of the attribute or invalidId
+      */
+      AttributeId findAttribute(NodeId node, Attribute::aType type, const std::string& name, const std::string& context) const;
+
+      // edges
+
+      EdgeId getEdgeCount() const { return static_cast<EdgeId>(edgeTargets.size()); }
+      NodeId getFromNode(EdgeId edge) const;
+      NodeId getToNode(EdgeId edge) const { return edgeTargets[edge]; }
+      const std::string& getEdgeType(EdgeId edge) const { return strTable.get(edgeTypes[edge]); }
+      Key getEdgeTypeKey(EdgeId edge) const { return edgeTypes[edge]; }
+      Edge::eDirectionType getEdgeDirection(EdgeId edge) const { return static_cast<Edge::eDirectionType>(edgeDirections[edge]); }
+
+      /**
+      * \return the pair of the edge or invalidId
+      */
+      EdgeId getEdgePair(EdgeId edge) const { return edgePairs[edge]; }
+      AttributeIterator getEdgeAttributes(EdgeId edge) const { return AttributeIterator(*this, edgeAttributes[edge].first, edgeAttributes[edge].second); }
+
+      // attributes
+
+      Attribute::aType getAttributeType(AttributeId attribute) const { return static_cast<Attribute::aType>(attributes[attribute].type); }
+      const std::string& getAttributeName(AttributeId attribute) const { return strTable.get(attributes[attribute].name); }
+      const std::string& getAttributeContext(AttributeId attribute) const { return strTable.get(attributes[attribute].context); }
+
+      /**
+      * \brief the values of the attributes, the type of the attribute is not checked
+      */
+      int getIntValue(AttributeId attribute) const { return intValues[attributes[attribute].value]; }
+      float getFloatValue(AttributeId attribute) const { return floatValues[attributes[attribute].value]; }
+      const std::string& getStringValue(AttributeId attribute) const { return strTable.get(stringValues[attributes[attribute].value]); }
+      void setIntValue(AttributeId attribute, int value) { intValues[attributes[attribute].value] = value; }
+      void setFloatValue(AttributeId attribute, float value) { floatValues[attributes[attribute].value] = value; }
+
+      /**
+      * \brief iterates the members of a composite attribute
+      */
+      AttributeIterator getCompositeAttributes(AttributeId composite) const { return AttributeIterator(*this, composite + 1, attributes[composite].next); }
+
+    private:
+
+      /** \internal \brief an attribute, the value is the index of the value in the column of its type */
+      struct AttributeData {
+        Key name;
+        Key context;
+        std::uint32_t value;
+        /** \internal \brief the id after the subtree of the attribute */
+        AttributeId next;
+        std::uint8_t type;
+      };
+
+      /** \internal \brief [first, second) range of attribute ids */
+      typedef std::pair<AttributeId, AttributeId> AttributeRange;
+
+      NodeId getOrCreateNode(Key UID, Key type);
+      AttributeId readAttribute(io::BinaryIO& in);
+      void writeAttributeToBinary(AttributeId attribute, io::BinaryIO& out) const;
+      void writeAttributeToXml(AttributeId attribute, io::SimpleXmlIO& sio) const;
+      void writeAttributeToJson(AttributeId attribute, io::JsonIO& jio) const;
+      std::vector<NodeId> getNodesOrderedByUID() const;
+
+      StrTable strTable;
+      std::map<Key, Key> headerInformations;
+
+      std::vector<Key> nodeUIDs;
+      std::vector<Key> nodeTypes;
+      std::vector<AttributeRange> nodeAttributes;
+      /** \internal \brief the out edges of node i are [outEdgeOffsets[i], outEdgeOffsets[i+1]) */
+      std::vector<EdgeId> outEdgeOffsets;
+      /** \internal \brief UID key -> node */
+      std::unordered_map<Key, NodeId> nodeIndex;
+
+      std::vector<NodeId> edgeTargets;
+      std::vector<Key> edgeTypes;
+      std::vector<std::uint8_t> edgeDirections;
+      std::vector<EdgeId> edgePairs;
+      std::vector<AttributeRange> edgeAttributes;
+
+      std::vector<AttributeData> attributes;
+      std::vector<int> intValues;
+      std::vector<float> floatValues;
+      std::vector<Key> stringValues;
+  };
+
+}}
+
+#endif
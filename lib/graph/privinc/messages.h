@@ -78,6 +78,7 @@
 #define CMSG_EX_NODEGROUP_DOESNOT_FOUND             "Nodegroup is not found: "
 #define CMSG_EX_EDGE_DOESNOT_FOUND                  "Edge is not found: "
 #define CMSG_EX_NODE_DOESNOT_FOUND                  "Node is not found: "
+#define CMSG_EX_COMPACT_GRAPH_NODE_SPLIT(UID)       "The attributes of node " + UID + " are not contiguous in the binary graph"
 #define CMSG_EX_TAG_NO_CAN_RECOGNIZE                "Tag cancot be recongnized: "
 #define CMSG_EX_ATTRIBUTEGROUP_DOESNOT_FOUND        "Attributegroup is not found: "
 #define CMSG_EX_WRONG_XML_FORMAT                    "Wrong XML format"
@@ -30,6 +30,7 @@
 
 
 #include <fstream>
+#include <unordered_set>
 
 using namespace boost;
 using namespace std;
@@ -1073,84 +1074,106 @@ namespace columbus {  namespace graph {
     return (n1.getUID() <  n2.getUID());
   }
 
-  void Graph::saveXML(const string& filename) const {
-    set<GraphEdge> savedEdgePairs;
-    SimpleXmlIO sio(filename,io::IOBase::omWrite);
+  vector<Node> Graph::getNodesOrderedByUID() const {
+    vector<Node> nodes;
+    nodes.reserve(num_vertices(*g));
+    vertex_iter vertex_begin, vertex_end, vertex_it;
+    boost::tie(vertex_begin, vertex_end) = vertices(*g);
+    for (vertex_it = vertex_begin; vertex_it != vertex_end; vertex_it++)
+      nodes.push_back(Node(const_cast<Graph*>(this), *vertex_it));
+
+    stable_sort(nodes.begin(), nodes.end(), [this](const Node& n1, const Node& n2) {
+      return getVertexUID(getVertex(n1)) < getVertexUID(getVertex(n2));
+    });
+    return nodes;
+  }
+
+  Graph::XMLWriter::XMLWriter(const Graph& graph, SimpleXmlIO& sio)
+    : graph(graph)
+    , sio(sio)
+    , savedEdgePairs()
+  {
+  }
+
+  void Graph::XMLWriter::writeBegin() {
     sio.writeXMLDeclaration("1.0","utf-8");
     sio.writeBeginElement(XML_GRAPH_ROOT);
     sio.writeBeginElement(XML_GRAPH_HEAD);
-    for(StringMap::const_iterator it = headerInformations.begin(); it != headerInformations.end(); it++) {
+    for(StringMap::const_iterator it = graph.headerInformations.begin(); it != graph.headerInformations.end(); it++) {
       sio.writeBeginElement(XML_GRAPH_INFO);
-      sio.writeAttribute(XML_GRAPH_NAME, strTable->get(it->first) );
-      sio.writeAttribute(XML_GRAPH_VALUE, strTable->get(it->second) );
+      sio.writeAttribute(XML_GRAPH_NAME, graph.strTable->get(it->first) );
+      sio.writeAttribute(XML_GRAPH_VALUE, graph.strTable->get(it->second) );
       sio.writeEndElement();
     }
     sio.writeEndElement();
     sio.writeBeginElement(XML_GRAPH_DATA);
-    vertex_iter vertex_begin, vertex_end,vertex_it;
-    boost::tie(vertex_begin,vertex_end) = vertices(*g);
-
-    list<Node> nodeList;
+  }
 
-    for(vertex_it = vertex_begin; vertex_it != vertex_end; vertex_it++) {
-      nodeList.push_back( Node( const_cast<Graph*>(this),*vertex_it) );
+  void Graph::XMLWriter::writeNode(const Node& node) {
+    const BGraph& g = *graph.g;
+    const StrTable* strTable = graph.strTable;
+    GraphVertex vertex = getVertex(node);
+    // write node
+    sio.writeBeginElement(XML_GRAPH_NODE);
+    sio.writeAttribute(XML_GRAPH_NAME, strTable->get(get(vertex_UID,g,vertex) ) );
+    sio.writeAttribute(XML_GRAPH_TYPE,strTable->get(get(vertex_type,g,vertex) ) );
+    AttributeList *vertex_attr = get(vertex_attributes,g,vertex);
+    // write attributes
+    for(AttributeList::iterator it = vertex_attr->begin(); it != vertex_attr->end(); it++) {
+      graph.writeAttributeToXml(**it,sio);
     }
-
-    nodeList.sort(compareNodeByUID);
-
-    for(list<Node>::iterator it = nodeList.begin(); it != nodeList.end(); it++ ) {
-
-      GraphVertex vertex = it->vertex;
-      // write node
-      sio.writeBeginElement(XML_GRAPH_NODE);
-      sio.writeAttribute(XML_GRAPH_NAME, strTable->get(get(vertex_UID,*g,vertex) ) );
-      sio.writeAttribute(XML_GRAPH_TYPE,strTable->get(get(vertex_type,*g,vertex) ) );
-      AttributeList *vertex_attr = get(vertex_attributes,*g,vertex);
-      // write attributes
-      for(AttributeList::iterator it = vertex_attr->begin(); it != vertex_attr->end(); it++) {
-        writeAttributeToXml(**it,sio);
-      }
-      // write out edges
-      out_edge_iter edge_begin, edge_end, edge_it;
-      boost::tie(edge_begin,edge_end) = out_edges(vertex,*g);
-      for(edge_it = edge_begin; edge_it != edge_end; edge_it++) {
-        if(get(edge_direction,*g,*edge_it) != Edge::edtReverse && savedEdgePairs.find(*edge_it) == savedEdgePairs.end() ) {
-          sio.writeBeginElement(XML_GRAPh_EDGE);
-          sio.writeAttribute(XML_GRAPH_TYPE, strTable->get(get(edge_type,*g,*edge_it) ) );
-          switch(get(edge_direction,*g,*edge_it)) {
-            case Edge::edtBidirectional:
-              sio.writeAttribute(XML_GRAPH_DIRECTION,"bidirectional");
-              break;
-            case Edge::edtDirectional:
-              sio.writeAttribute(XML_GRAPH_DIRECTION,"directional");
-              break;
-            default:
-              break;
-          }
-          sio.writeAttribute(XML_GRAPH_EDGE_TO, strTable->get(get(vertex_UID,*g,target(*edge_it,*g) ) ) );
-          // write reserve pair edge
-          if(hasEdgePair(*edge_it)) {
-            GraphEdge reservePair = getEdgePair(*edge_it);
-            savedEdgePairs.insert(reservePair);
-            sio.writeBeginElement(XML_GRAPH_EDGE_PAIR);
-            AttributeList *edge_attr = get(edge_attributes,*g,reservePair);
-            for(AttributeList::iterator it = edge_attr->begin(); it != edge_attr->end(); it++) {
-              writeAttributeToXml(**it,sio);
-            }
-            sio.writeEndElement();
-          }
-          AttributeList *edge_attr = get(edge_attributes,*g,*edge_it);
+    // write out edges
+    out_edge_iter edge_begin, edge_end, edge_it;
+    boost::tie(edge_begin,edge_end) = out_edges(vertex,g);
+    for(edge_it = edge_begin; edge_it != edge_end; edge_it++) {
+      if(get(edge_direction,g,*edge_it) != Edge::edtReverse && savedEdgePairs.find(*edge_it) == savedEdgePairs.end() ) {
+        sio.writeBeginElement(XML_GRAPh_EDGE);
+        sio.writeAttribute(XML_GRAPH_TYPE, strTable->get(get(edge_type,g,*edge_it) ) );
+        switch(get(edge_direction,g,*edge_it)) {
+          case Edge::edtBidirectional:
+            sio.writeAttribute(XML_GRAPH_DIRECTION,"bidirectional");
+            break;
+          case Edge::edtDirectional:
+            sio.writeAttribute(XML_GRAPH_DIRECTION,"directional");
+            break;
+          default:
+            break;
+        }
+        sio.writeAttribute(XML_GRAPH_EDGE_TO, strTable->get(get(vertex_UID,g,target(*edge_it,g) ) ) );
+        // write reserve pair edge
+        if(graph.hasEdgePair(*edge_it)) {
+          GraphEdge reservePair = graph.getEdgePair(*edge_it);
+          savedEdgePairs.insert(reservePair);
+          sio.writeBeginElement(XML_GRAPH_EDGE_PAIR);
+          AttributeList *edge_attr = get(edge_attributes,g,reservePair);
           for(AttributeList::iterator it = edge_attr->begin(); it != edge_attr->end(); it++) {
-            writeAttributeToXml(**it,sio);
+            graph.writeAttributeToXml(**it,sio);
           }
           sio.writeEndElement();
         }
+        AttributeList *edge_attr = get(edge_attributes,g,*edge_it);
+        for(AttributeList::iterator it = edge_attr->begin(); it != edge_attr->end(); it++) {
+          graph.writeAttributeToXml(**it,sio);
+        }
+        sio.writeEndElement();
       }
-      // write node end
-      sio.writeEndElement();
     }
+    // write node end
+    sio.writeEndElement();
+  }
+
+  void Graph::XMLWriter::writeEnd() {
     sio.writeEndElement();
     sio.writeEndElement();
+  }
+
+  void Graph::saveXML(const string& filename) const {
+    SimpleXmlIO sio(filename,io::IOBase::omWrite);
+    XMLWriter writer(*this, sio);
+    writer.writeBegin();
+    for (const Node& node : getNodesOrderedByUID())
+      writer.writeNode(node);
+    writer.writeEnd();
     sio.close();
   }
 
@@ -2575,46 +2598,54 @@ namespace columbus {  namespace graph {
     in.close();
   }
 
-  void Graph::addAttributeToJsonNode(Attribute& attribute, Json::Value& node) const
+  void Graph::writeAttributeToJson(Attribute& attribute, JsonIO& jio) const
   {
+    // the members are written in alphabetical order
     switch(attribute.getType()) {
       case Attribute::atInt:
         {
-          node[XML_GRAPH_TYPE] = "int";
-          node[XML_GRAPH_NAME] = ((AttributeInt&)attribute).getName();
-          node[XML_GRAPH_CONTEXT] =  ((AttributeInt&)attribute).getContext();
-          node[XML_GRAPH_VALUE] = ((AttributeInt&)attribute).getValue();
+          jio.writeBeginObject();
+          jio.writeMember(XML_GRAPH_CONTEXT, ((AttributeInt&)attribute).getContext());
+          jio.writeMember(XML_GRAPH_NAME, ((AttributeInt&)attribute).getName());
+          jio.writeMember(XML_GRAPH_TYPE, "int");
+          jio.writeMember(XML_GRAPH_VALUE, ((AttributeInt&)attribute).getValue());
+          jio.writeEndObject();
           break;
         }
       case Attribute::atFloat:
         {
-          node[XML_GRAPH_TYPE] = "float";
-          node[XML_GRAPH_NAME] = ((AttributeFloat&)attribute).getName();
-          node[XML_GRAPH_CONTEXT] = ((AttributeFloat&)attribute).getContext();
-          node[XML_GRAPH_VALUE] = ((AttributeFloat&)attribute).getValue();
+          jio.writeBeginObject();
+          jio.writeMember(XML_GRAPH_CONTEXT, ((AttributeFloat&)attribute).getContext());
+          jio.writeMember(XML_GRAPH_NAME, ((AttributeFloat&)attribute).getName());
+          jio.writeMember(XML_GRAPH_TYPE, "float");
+          jio.writeMember(XML_GRAPH_VALUE, static_cast<double>(((AttributeFloat&)attribute).getValue()));
+          jio.writeEndObject();
           break;
         }
       case Attribute::atString:
         {
-          node[XML_GRAPH_TYPE] = "string";
-          node[XML_GRAPH_NAME] = ((AttributeString&)attribute).getName();
-          node[XML_GRAPH_CONTEXT] = ((AttributeString&)attribute).getContext();
-          node[XML_GRAPH_VALUE] = ((AttributeString&)attribute).getValue();
+          jio.writeBeginObject();
+          jio.writeMember(XML_GRAPH_CONTEXT, ((AttributeString&)attribute).getContext());
+          jio.writeMember(XML_GRAPH_NAME, ((AttributeString&)attribute).getName());
+          jio.writeMember(XML_GRAPH_TYPE, "string");
+          jio.writeMember(XML_GRAPH_VALUE, ((AttributeString&)attribute).getValue());
+          jio.writeEndObject();
           break;
         }
       case Attribute::atComposite:
         {
-          node[XML_GRAPH_TYPE] = "composite";
-
           AttributeComposite& attrComp = (AttributeComposite&)attribute;
-          node[XML_GRAPH_NAME] = attrComp.getName();
-          node[XML_GRAPH_CONTEXT] = attrComp.getContext();
-          Json::Value& attributesValue = node["attributes"] = Json::Value(Json::arrayValue);
-
-          int attributeIndex = 0;
+          jio.writeBeginObject();
+          jio.writeName("attributes");
+          jio.writeBeginArray();
           for(AttributeList::iterator it = attrComp.values->begin(); it != attrComp.values->end(); it++)
-            addAttributeToJsonNode(**it, attributesValue[attributeIndex++]);
-
+            writeAttributeToJson(**it, jio);
+          jio.writeEndArray();
+          jio.writeMember(XML_GRAPH_CONTEXT, attrComp.getContext());
+          jio.writeMember(XML_GRAPH_NAME, attrComp.getName());
+          jio.writeMember(XML_GRAPH_TYPE, "composite");
+          jio.writeEndObject();
+          break;
         }
       default:
         break;
@@ -2622,102 +2653,118 @@ namespace columbus {  namespace graph {
 
   }
 
-
-  void Graph::saveJSON(const string& filename) const
+  Graph::JSONWriter::JSONWriter(const Graph& graph, JsonIO& jio)
+    : graph(graph)
+    , jio(jio)
   {
-    Json::Value root(Json::objectValue);
-    Json::Value& header = root["header"];
-    for (const auto& headerInfo : headerInformations)
-      header[strTable->get(headerInfo.first)] = strTable->get(headerInfo.second);
-
-    list<Node> nodeList;
-
-    vertex_iter vi, vi_end;
-    for (boost::tie(vi, vi_end) = vertices(*g); vi != vi_end; ++vi)
-      nodeList.push_back( Node( const_cast<Graph*>(this), *vi) );
+    // the dump is indented with tabs, like the former output of jsoncpp
+    jio.setIndentation("\t");
+  }
 
-    nodeList.sort(compareNodeByUID);
+  void Graph::JSONWriter::writeBegin()
+  {
+    jio.writeBeginObject();
+    jio.writeName("header");
+    jio.writeBeginObject();
+    map<string, string> header;
+    for (const auto& headerInfo : graph.headerInformations)
+      header[graph.strTable->get(headerInfo.first)] = graph.strTable->get(headerInfo.second);
+    for (const auto& headerInfo : header)
+      jio.writeMember(headerInfo.first, headerInfo.second);
+    jio.writeEndObject();
+    jio.writeName("nodes");
+    jio.writeBeginArray();
+  }
+
+  void Graph::JSONWriter::writeNode(const Node& node)
+  {
+    const BGraph& g = *graph.g;
+    const StrTable* strTable = graph.strTable;
+    GraphVertex vertex = getVertex(node);
 
-    int nodeIndex = 0;
-    Json::Value& nodes = root["nodes"] = Json::Value(Json::arrayValue);
+    jio.writeBeginObject();
 
-    for(const auto& node : nodeList )
+    AttributeList *vertex_attr = get(vertex_attributes,g,vertex);
+    // attributes
+    if (vertex_attr->begin() != vertex_attr->end())
     {
-      Json::Value& nodeValue = nodes[nodeIndex++];
-
-      GraphVertex vertex = node.vertex;
-
-      // node
-      nodeValue[XML_GRAPH_NAME] = strTable->get(get(vertex_UID,*g,vertex));
-      nodeValue[XML_GRAPH_TYPE] = strTable->get(get(vertex_type,*g,vertex));
+      jio.writeName("attributes");
+      jio.writeBeginArray();
+      for(AttributeList::iterator it = vertex_attr->begin(); it != vertex_attr->end(); it++)
+        graph.writeAttributeToJson(**it, jio);
+      jio.writeEndArray();
+    }
 
+    // edges
+    bool edgesCreated = false;
 
-      AttributeList *vertex_attr = get(vertex_attributes,*g,vertex);
-      // attributes
-      if (vertex_attr->begin() != vertex_attr->end())
+    out_edge_iter edge_end, edge_it;
+    for(boost::tie(edge_it, edge_end) = out_edges(vertex,g); edge_it != edge_end; edge_it++)
+    {
+      if ((get(edge_direction,g,*edge_it) != Edge::edtReverse))
       {
-        Json::Value& nodeAttributes = nodeValue["attributes"] = Json::Value(Json::arrayValue);
-        int attributeIndex = 0;
+        if (!edgesCreated)
+        {
+          jio.writeName("edges");
+          jio.writeBeginArray();
+          edgesCreated = true;
+        }
 
-        for(AttributeList::iterator it = vertex_attr->begin(); it != vertex_attr->end(); it++)
-          addAttributeToJsonNode(**it, nodeAttributes[attributeIndex++]);
-      }
+        jio.writeBeginObject();
 
-      // edges
-      int edgeIndex = 0;
-      bool edgesCreated = false;
-      Json::Value* nodeEdges = nullptr;
+        AttributeList *edge_attr = get(edge_attributes,g,*edge_it);
+        if (edge_attr->begin() != edge_attr->end())
+        {
+          jio.writeName("attributes");
+          jio.writeBeginArray();
+          for(AttributeList::iterator it = edge_attr->begin(); it != edge_attr->end(); it++)
+            graph.writeAttributeToJson(**it, jio);
+          jio.writeEndArray();
+        }
 
-      out_edge_iter edge_end, edge_it;
-      for(boost::tie(edge_it, edge_end) = out_edges(vertex,*g); edge_it != edge_end; edge_it++)
-      {
-        if ((get(edge_direction,*g,*edge_it) != Edge::edtReverse))
+        switch(get(edge_direction,g,*edge_it))
         {
-          if (!edgesCreated)
-          {
-            nodeEdges = &(nodeValue["edges"] = Json::Value(Json::arrayValue));
-            edgesCreated = true;
-          }
+          case Edge::edtBidirectional:
+            jio.writeMember(XML_GRAPH_DIRECTION, "bidirectional");
+            break;
+          case Edge::edtDirectional:
+            jio.writeMember(XML_GRAPH_DIRECTION, "directional");
+            break;
+          default:
+            break;
+        }
 
-          Json::Value& nodeEdge = (*nodeEdges)[edgeIndex++];
+        jio.writeMember(XML_GRAPH_EDGE_TO, strTable->get(get(vertex_UID,g,target(*edge_it,g))));
+        jio.writeMember(XML_GRAPH_TYPE, strTable->get(get(edge_type,g,*edge_it)));
+        jio.writeEndObject();
+      }
+    }
 
-          nodeEdge[XML_GRAPH_TYPE] = strTable->get(get(edge_type,*g,*edge_it));
+    if (edgesCreated)
+      jio.writeEndArray();
 
-          switch(get(edge_direction,*g,*edge_it))
-          {
-            case Edge::edtBidirectional:
-              nodeEdge[XML_GRAPH_DIRECTION] = "bidirectional";
-              break;
-            case Edge::edtDirectional:
-              nodeEdge[XML_GRAPH_DIRECTION] = "directional";
-              break;
-            default:
-              break;
-          }
+    // node
+    jio.writeMember(XML_GRAPH_NAME, strTable->get(get(vertex_UID,g,vertex)));
+    jio.writeMember(XML_GRAPH_TYPE, strTable->get(get(vertex_type,g,vertex)));
 
-          nodeEdge[XML_GRAPH_EDGE_TO] = strTable->get(get(vertex_UID,*g,target(*edge_it,*g)));
-          AttributeList *edge_attr = get(edge_attributes,*g,*edge_it);
+    jio.writeEndObject();
+  }
 
-          if (edge_attr->begin() != edge_attr->end())
-          {
-            Json::Value& edgeAttributes = nodeEdge["attributes"] = Json::Value(Json::arrayValue);
-            int attributeIndex = 0;
+  void Graph::JSONWriter::writeEnd()
+  {
+    jio.writeEndArray();
+    jio.writeEndObject();
+  }
 
-            for(AttributeList::iterator it = edge_attr->begin(); it != edge_attr->end(); it++)
-              addAttributeToJsonNode(**it, edgeAttributes[attributeIndex++]);
-          }
-        }
-      }
-    }
- 
-    ofstream output(filename);
-    if (output)
-    {
-      Json::StreamWriterBuilder builder;
-      std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-      writer->write(root, &output);
-      output.close();
-    }
+  void Graph::saveJSON(const string& filename) const
+  {
+    JsonIO jio(filename, io::IOBase::omWrite);
+    JSONWriter writer(*this, jio);
+    writer.writeBegin();
+    for (const Node& node : getNodesOrderedByUID())
+      writer.writeNode(node);
+    writer.writeEnd();
+    jio.close();
   }
 
 
@@ -3038,15 +3085,15 @@ namespace columbus {  namespace graph {
   void Graph::merge(Graph& graph, Graph::MergeMode nodeMode, Graph::CompsiteAndStringMergeMode nodeAttributeStringAndCompositeMode, Graph::NumericMergeMode nodeAttributeNumericMode,
     Graph::MergeMode edgeMode, Graph::CompsiteAndStringMergeMode edgeAttributeStringAndCompositeMode, Graph::NumericMergeMode edgeAttributeNumericMode) {
     // convert all nodes from 'graph' to this graph
-    set<Node> visitedNodes;
-    set<Edge> visitedEdges;
+    // (the nodes and edges of 'graph' are identified by their descriptors, which are hashed instead of ordered)
+    std::unordered_set<GraphVertex> visitedNodes;
+    std::unordered_set<GraphEdge, boost::hash<GraphEdge> > visitedEdges;
     Node::NodeIterator nodeIt = graph.getNodes();
     while(nodeIt.hasNext()) {
       Node newNode = nodeIt.next();
 
       // convert node
-      if(visitedNodes.find(newNode) == visitedNodes.end() ) {
-        visitedNodes.insert(newNode);
+      if(visitedNodes.insert(newNode.vertex).second) {
         convertNodeMerge(newNode, *this, nodeMode, nodeAttributeStringAndCompositeMode, nodeAttributeNumericMode);
       }
       multimap<string, Edge> oldNodeTargets;
@@ -3064,16 +3111,14 @@ namespace columbus {  namespace graph {
       while(edgeIt.hasNext()) {
         Edge newEdge = edgeIt.next();
         Node toNode = newEdge.getToNode();
-        if(visitedNodes.find(toNode) == visitedNodes.end() ) {
-          visitedNodes.insert(toNode);
+        if(visitedNodes.insert(toNode.vertex).second) {
           convertNodeMerge(toNode, *this, nodeMode, nodeAttributeStringAndCompositeMode, nodeAttributeNumericMode);
         }
         // convert edge
-        if( (newEdge.getType().getDirectionType() != Edge::edtReverse) && (visitedEdges.find(newEdge) == visitedEdges.end()) ) {
-          visitedEdges.insert(newEdge);
+        if( (newEdge.getType().getDirectionType() != Edge::edtReverse) && (visitedEdges.insert(newEdge.edge).second) ) {
           Edge edgePair = newEdge.getReversePair();
           if(!(edgePair == invalidEdge))
-            visitedEdges.insert(edgePair);
+            visitedEdges.insert(edgePair.edge);
           convertEdgeMerge(oldNodeTargets, newEdge, *this, edgeMode, edgeAttributeStringAndCompositeMode, edgeAttributeNumericMode);
         }
       }
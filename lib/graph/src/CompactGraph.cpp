@@ -0,0 +1,610 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/CompactGraph.h"
+#include "../privinc/messages.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace std;
+using namespace columbus::io;
+
+namespace columbus {  namespace graph {
+
+  CompactGraph::AttributeId CompactGraph::AttributeIterator::next() {
+    if (current == end)
+      throw GraphNoSuchElementException(COLUMBUS_LOCATION, CMSG_EX_ITERATOR_NOT_NEXT_ELEMENT);
+    AttributeId result = current;
+    current = graph->attributes[current].next;
+    return result;
+  }
+
+  CompactGraph::CompactGraph()
+    : strTable()
+    , headerInformations()
+    , outEdgeOffsets(1, 0)
+  {
+  }
+
+  void CompactGraph::clear() {
+    strTable = StrTable();
+    headerInformations.clear();
+    nodeUIDs.clear();
+    nodeTypes.clear();
+    nodeAttributes.clear();
+    outEdgeOffsets.assign(1, 0);
+    nodeIndex.clear();
+    edgeTargets.clear();
+    edgeTypes.clear();
+    edgeDirections.clear();
+    edgePairs.clear();
+    edgeAttributes.clear();
+    attributes.clear();
+    intValues.clear();
+    floatValues.clear();
+    stringValues.clear();
+  }
+
+  CompactGraph::NodeId CompactGraph::getOrCreateNode(Key UID, Key type) {
+    pair<unordered_map<Key, NodeId>::iterator, bool> inserted = nodeIndex.insert(make_pair(UID, static_cast<NodeId>(nodeUIDs.size())));
+    if (inserted.second) {
+      nodeUIDs.push_back(UID);
+      nodeTypes.push_back(type);
+      nodeAttributes.push_back(AttributeRange(0, 0));
+    }
+    return inserted.first->second;
+  }
+
+  CompactGraph::AttributeId CompactGraph::readAttribute(BinaryIO& in) {
+    AttributeId id = static_cast<AttributeId>(attributes.size());
+    AttributeData data;
+    data.type = static_cast<uint8_t>(in.readUInt4());
+    data.name = in.readUInt4();
+    data.context = in.readUInt4();
+    data.next = id + 1;
+
+    switch (data.type) {
+      case Attribute::atInt:
+        data.value = static_cast<uint32_t>(intValues.size());
+        intValues.push_back(in.readInt4());
+        attributes.push_back(data);
+        break;
+      case Attribute::atFloat:
+        data.value = static_cast<uint32_t>(floatValues.size());
+        floatValues.push_back(in.readFloat4());
+        attributes.push_back(data);
+        break;
+      case Attribute::atString:
+        data.value = static_cast<uint32_t>(stringValues.size());
+        stringValues.push_back(in.readUInt4());
+        attributes.push_back(data);
+        break;
+      case Attribute::atComposite:
+        {
+          unsigned int attributesLength = in.readUInt4();
+          data.value = 0;
+          attributes.push_back(data);
+          for (unsigned int i = 0; i < attributesLength; i++)
+            readAttribute(in);
+          attributes[id].next = static_cast<AttributeId>(attributes.size());
+          break;
+        }
+      default:
+        throw GraphException(COLUMBUS_LOCATION, CMSG_EX_WRONG_ATTRIBUTE_FOUND);
+    }
+    return id;
+  }
+
+  void CompactGraph::loadBinary(const string& filename) {
+    clear();
+
+    BinaryIO in(filename, BinaryIO::omRead);
+    strTable.load(in);
+
+    // read header information
+    unsigned int headerCount = in.readUInt4();
+    for (unsigned int i = 0; i < headerCount; i++) {
+      Key infoName = in.readUInt4();
+      Key infoValue = in.readUInt4();
+      headerInformations[infoName] = infoValue;
+    }
+
+    // the same type as the one of the nodes created by Graph::loadBinary() for the unknown edge targets
+    Key invalidNodeType = strTable.set("__INVALID__");
+
+    // The edges are collected in the order of their creation in Graph::loadBinary(), then they are sorted by
+    // their source node (stable), so the out edges of every node are in the same order as in Graph.
+    vector<NodeId> edgeSources;
+    auto createEdge = [&](NodeId from, NodeId to, Key type, Edge::eDirectionType direction) {
+      edgeSources.push_back(from);
+      edgeTargets.push_back(to);
+      edgeTypes.push_back(type);
+      edgeDirections.push_back(static_cast<uint8_t>(direction));
+      edgePairs.push_back(invalidId);
+      edgeAttributes.push_back(AttributeRange(0, 0));
+      return static_cast<EdgeId>(edgeTargets.size() - 1);
+    };
+    // like in the edge pair map of Graph, an edge keeps its first pair
+    auto setPair = [&](EdgeId edge, EdgeId pair) {
+      if (edgePairs[edge] == invalidId)
+        edgePairs[edge] = pair;
+      if (edgePairs[pair] == invalidId)
+        edgePairs[pair] = edge;
+    };
+    auto readAttributes = [&](unsigned int count) {
+      AttributeId begin = static_cast<AttributeId>(attributes.size());
+      for (unsigned int i = 0; i < count; i++)
+        readAttribute(in);
+      return AttributeRange(begin, static_cast<AttributeId>(attributes.size()));
+    };
+
+    while (true) {
+      if (in.eof())
+        throw GraphException(COLUMBUS_LOCATION, CMSG_EX_UNEXCPECTED_END_OF_LINE);
+
+      // read a node
+      Key UID = in.readUInt4();
+      Key type = in.readUInt4();
+
+      // last node
+      if ((UID == 0) && (type == 0))
+        break;
+
+      NodeId node = getOrCreateNode(UID, type);
+      nodeTypes[node] = type;
+
+      unsigned int nodeAttrSize = in.readUInt4();
+      if (nodeAttrSize != 0) {
+        // the attributes of a node must be contiguous
+        if (nodeAttributes[node].first != nodeAttributes[node].second)
+          throw GraphException(COLUMBUS_LOCATION, CMSG_EX_COMPACT_GRAPH_NODE_SPLIT(strTable.get(UID)));
+        nodeAttributes[node] = readAttributes(nodeAttrSize);
+      }
+
+      // read edges
+      while (true) {
+        if (in.eof())
+          throw GraphException(COLUMBUS_LOCATION, CMSG_EX_UNEXCPECTED_END_OF_LINE);
+
+        Key edgeTypeKey = in.readUInt4();
+        unsigned int edgeDirectionKey = in.readUInt4();
+        Key toNodeKey = in.readUInt4();
+
+        if ((edgeTypeKey == 0) && (edgeDirectionKey == 0) && (toNodeKey == 0))
+          break;
+
+        bool hasPair = in.readBool1();
+
+        NodeId toNode = getOrCreateNode(toNodeKey, invalidNodeType);
+
+        EdgeId edge = invalidId;
+        switch (edgeDirectionKey) {
+          case Edge::edtBidirectional:
+            edge = createEdge(node, toNode, edgeTypeKey, Edge::edtBidirectional);
+            setPair(edge, createEdge(toNode, node, edgeTypeKey, Edge::edtBidirectional));
+            break;
+          case Edge::edtDirectional:
+            edge = createEdge(node, toNode, edgeTypeKey, Edge::edtDirectional);
+            break;
+          default:
+            throw GraphException(COLUMBUS_LOCATION, CMSG_EX_WRONG_EDGE_FOUNDED + strTable.get(edgeTypeKey));
+        }
+
+        edgeAttributes[edge] = readAttributes(in.readUInt4());
+
+        if (hasPair) {
+          EdgeId reversePair = createEdge(toNode, node, edgeTypeKey, Edge::edtReverse);
+          setPair(edge, reversePair);
+          edgeAttributes[reversePair] = readAttributes(in.readUInt4());
+        }
+      }
+    }
+    in.close();
+
+    // build the rows of the out edges
+    outEdgeOffsets.assign(nodeUIDs.size() + 1, 0);
+    for (NodeId source : edgeSources)
+      ++outEdgeOffsets[source + 1];
+    for (size_t i = 1; i < outEdgeOffsets.size(); ++i)
+      outEdgeOffsets[i] += outEdgeOffsets[i - 1];
+
+    vector<EdgeId> newIds(edgeSources.size());
+    vector<EdgeId> fill(outEdgeOffsets.begin(), outEdgeOffsets.end() - 1);
+    for (size_t edge = 0; edge < edgeSources.size(); ++edge)
+      newIds[edge] = fill[edgeSources[edge]]++;
+
+    auto permute = [&newIds](auto& column) {
+      typename std::remove_reference<decltype(column)>::type sorted(column.size());
+      for (size_t edge = 0; edge < column.size(); ++edge)
+        sorted[newIds[edge]] = column[edge];
+      column.swap(sorted);
+    };
+    permute(edgeTargets);
+    permute(edgeTypes);
+    permute(edgeDirections);
+    permute(edgeAttributes);
+    for (EdgeId& pair : edgePairs)
+      if (pair != invalidId)
+        pair = newIds[pair];
+    permute(edgePairs);
+  }
+
+  string CompactGraph::getHeaderInfo(const string& key) const {
+    map<Key, Key>::const_iterator it = headerInformations.find(strTable.get(key));
+    if (it == headerInformations.end())
+      throw GraphException("CompactGraph::getHeaderInfo(const string& key)", "Header information not exist!");
+    return strTable.get(it->second);
+  }
+
+  vector<string> CompactGraph::getHeaderKeys() const {
+    vector<string> keys;
+    for (const auto& headerElement : headerInformations)
+      keys.push_back(strTable.get(headerElement.first));
+    return keys;
+  }
+
+  CompactGraph::NodeId CompactGraph::findNode(const string& UID) const {
+    Key key = strTable.get(UID);
+    if (!StrTable::getIsValid(key))
+      return invalidId;
+    unordered_map<Key, NodeId>::const_iterator it = nodeIndex.find(key);
+    return it != nodeIndex.end() ? it->second : invalidId;
+  }
+
+  CompactGraph::NodeId CompactGraph::getFromNode(EdgeId edge) const {
+    return static_cast<NodeId>(upper_bound(outEdgeOffsets.begin(), outEdgeOffsets.end(), edge) - outEdgeOffsets.begin() - 1);
+  }
+
+  CompactGraph::AttributeId CompactGraph::findAttribute(NodeId node, Attribute::aType type, const string& name, const string& context) const {
+    Key nameKey = strTable.get(name);
+    Key contextKey = strTable.get(context);
+    AttributeIterator it = getAttributes(node);
+    while (it.hasNext()) {
+      AttributeId attribute = it.next();
+      const AttributeData& data = attributes[attribute];
+      if (data.type == type && data.name == nameKey && data.context == contextKey)
+        return attribute;
+    }
+    return invalidId;
+  }
+
+  void CompactGraph::writeAttributeToBinary(AttributeId attribute, BinaryIO& out) const {
+    const AttributeData& data = attributes[attribute];
+    out.writeUInt4(data.type);
+    out.writeUInt4(data.name);
+    out.writeUInt4(data.context);
+    switch (data.type) {
+      case Attribute::atInt:
+        out.writeInt4(intValues[data.value]);
+        break;
+      case Attribute::atFloat:
+        out.writeFloat4(floatValues[data.value]);
+        break;
+      case Attribute::atString:
+        out.writeUInt4(stringValues[data.value]);
+        break;
+      case Attribute::atComposite:
+        {
+          unsigned int count = 0;
+          AttributeIterator it = getCompositeAttributes(attribute);
+          while (it.hasNext()) {
+            it.next();
+            ++count;
+          }
+          out.writeUInt4(count);
+          it = getCompositeAttributes(attribute);
+          while (it.hasNext())
+            writeAttributeToBinary(it.next(), out);
+          break;
+        }
+      default:
+        break;
+    }
+  }
+
+  void CompactGraph::saveBinary(const string& filename) const {
+    BinaryIO out(filename, BinaryIO::omWrite);
+    vector<bool> savedEdgePairs(edgeTargets.size(), false);
+
+    auto writeAttributes = [&](AttributeIterator it) {
+      unsigned int count = 0;
+      for (AttributeIterator counter = it; counter.hasNext(); counter.next())
+        ++count;
+      out.writeUInt4(count);
+      while (it.hasNext())
+        writeAttributeToBinary(it.next(), out);
+    };
+
+    strTable.save(out);
+
+    out.writeUInt4(static_cast<unsigned int>(headerInformations.size()));
+    for (const auto& headerElement : headerInformations) {
+      out.writeUInt4(headerElement.first);
+      out.writeUInt4(headerElement.second);
+    }
+
+    for (NodeId node = 0; node < getNodeCount(); ++node) {
+      out.writeUInt4(nodeUIDs[node]);
+      out.writeUInt4(nodeTypes[node]);
+      writeAttributes(getAttributes(node));
+
+      for (EdgeId edge = outEdgeOffsets[node]; edge < outEdgeOffsets[node + 1]; ++edge) {
+        if (edgeDirections[edge] == Edge::edtReverse || savedEdgePairs[edge])
+          continue;
+
+        out.writeUInt4(edgeTypes[edge]);
+        out.writeUInt4(edgeDirections[edge]);
+        out.writeUInt4(nodeUIDs[edgeTargets[edge]]);
+
+        EdgeId pair = edgePairs[edge];
+        out.writeBool1(pair != invalidId);
+        if (pair != invalidId)
+          savedEdgePairs[pair] = true;
+
+        writeAttributes(getEdgeAttributes(edge));
+        if (pair != invalidId)
+          writeAttributes(getEdgeAttributes(pair));
+      }
+
+      // empty edge
+      out.writeUInt4(0);
+      out.writeUInt4(0);
+      out.writeUInt4(0);
+    }
+
+    // empty node
+    out.writeUInt4(0);
+    out.writeUInt4(0);
+
+    out.close();
+  }
+
+  vector<CompactGraph::NodeId> CompactGraph::getNodesOrderedByUID() const {
+    vector<NodeId> nodes(nodeUIDs.size());
+    for (NodeId node = 0; node < nodes.size(); ++node)
+      nodes[node] = node;
+    stable_sort(nodes.begin(), nodes.end(), [this](NodeId lhs, NodeId rhs) {
+      return strTable.get(nodeUIDs[lhs]) < strTable.get(nodeUIDs[rhs]);
+    });
+    return nodes;
+  }
+
+  void CompactGraph::writeAttributeToXml(AttributeId attribute, SimpleXmlIO& sio) const {
+    const AttributeData& data = attributes[attribute];
+    sio.writeBeginElement(XML_GRAPH_ATTR);
+    switch (data.type) {
+      case Attribute::atInt:
+        sio.writeAttribute(XML_GRAPH_TYPE, "int");
+        sio.writeAttribute(XML_GRAPH_NAME, strTable.get(data.name));
+        sio.writeAttribute(XML_GRAPH_CONTEXT, strTable.get(data.context));
+        sio.writeAttribute(XML_GRAPH_VALUE, intValues[data.value]);
+        break;
+      case Attribute::atFloat:
+        sio.writeAttribute(XML_GRAPH_TYPE, "float");
+        sio.writeAttribute(XML_GRAPH_NAME, strTable.get(data.name));
+        sio.writeAttribute(XML_GRAPH_CONTEXT, strTable.get(data.context));
+        sio.writeAttribute(XML_GRAPH_VALUE, floatValues[data.value]);
+        break;
+      case Attribute::atString:
+        sio.writeAttribute(XML_GRAPH_TYPE, "string");
+        sio.writeAttribute(XML_GRAPH_NAME, strTable.get(data.name));
+        sio.writeAttribute(XML_GRAPH_CONTEXT, strTable.get(data.context));
+        sio.writeAttribute(XML_GRAPH_VALUE, strTable.get(stringValues[data.value]));
+        break;
+      case Attribute::atComposite:
+        {
+          sio.writeAttribute(XML_GRAPH_TYPE, "composite");
+          sio.writeAttribute(XML_GRAPH_NAME, strTable.get(data.name));
+          sio.writeAttribute(XML_GRAPH_CONTEXT, strTable.get(data.context));
+          AttributeIterator it = getCompositeAttributes(attribute);
+          while (it.hasNext())
+            writeAttributeToXml(it.next(), sio);
+          break;
+        }
+      default:
+        break;
+    }
+    sio.writeEndElement();
+  }
+
+  void CompactGraph::saveXML(const string& filename) const {
+    vector<bool> savedEdgePairs(edgeTargets.size(), false);
+    SimpleXmlIO sio(filename, IOBase::omWrite);
+    sio.writeXMLDeclaration("1.0", "utf-8");
+    sio.writeBeginElement(XML_GRAPH_ROOT);
+    sio.writeBeginElement(XML_GRAPH_HEAD);
+    for (const auto& headerElement : headerInformations) {
+      sio.writeBeginElement(XML_GRAPH_INFO);
+      sio.writeAttribute(XML_GRAPH_NAME, strTable.get(headerElement.first));
+      sio.writeAttribute(XML_GRAPH_VALUE, strTable.get(headerElement.second));
+      sio.writeEndElement();
+    }
+    sio.writeEndElement();
+    sio.writeBeginElement(XML_GRAPH_DATA);
+
+    for (NodeId node : getNodesOrderedByUID()) {
+      sio.writeBeginElement(XML_GRAPH_NODE);
+      sio.writeAttribute(XML_GRAPH_NAME, strTable.get(nodeUIDs[node]));
+      sio.writeAttribute(XML_GRAPH_TYPE, strTable.get(nodeTypes[node]));
+      AttributeIterator attrIt = getAttributes(node);
+      while (attrIt.hasNext())
+        writeAttributeToXml(attrIt.next(), sio);
+
+      for (EdgeId edge = outEdgeOffsets[node]; edge < outEdgeOffsets[node + 1]; ++edge) {
+        if (edgeDirections[edge] == Edge::edtReverse || savedEdgePairs[edge])
+          continue;
+
+        sio.writeBeginElement(XML_GRAPh_EDGE);
+        sio.writeAttribute(XML_GRAPH_TYPE, strTable.get(edgeTypes[edge]));
+        switch (edgeDirections[edge]) {
+          case Edge::edtBidirectional:
+            sio.writeAttribute(XML_GRAPH_DIRECTION, "bidirectional");
+            break;
+          case Edge::edtDirectional:
+            sio.writeAttribute(XML_GRAPH_DIRECTION, "directional");
+            break;
+          default:
+            break;
+        }
+        sio.writeAttribute(XML_GRAPH_EDGE_TO, strTable.get(nodeUIDs[edgeTargets[edge]]));
+        EdgeId pair = edgePairs[edge];
+        if (pair != invalidId) {
+          savedEdgePairs[pair] = true;
+          sio.writeBeginElement(XML_GRAPH_EDGE_PAIR);
+          AttributeIterator pairAttrIt = getEdgeAttributes(pair);
+          while (pairAttrIt.hasNext())
+            writeAttributeToXml(pairAttrIt.next(), sio);
+          sio.writeEndElement();
+        }
+        AttributeIterator edgeAttrIt = getEdgeAttributes(edge);
+        while (edgeAttrIt.hasNext())
+          writeAttributeToXml(edgeAttrIt.next(), sio);
+        sio.writeEndElement();
+      }
+      sio.writeEndElement();
+    }
+    sio.writeEndElement();
+    sio.writeEndElement();
+    sio.close();
+  }
+
+  void CompactGraph::writeAttributeToJson(AttributeId attribute, JsonIO& jio) const {
+    // the members are written in alphabetical order, like Graph does
+    const AttributeData& data = attributes[attribute];
+    switch (data.type) {
+      case Attribute::atInt:
+        jio.writeBeginObject();
+        jio.writeMember(XML_GRAPH_CONTEXT, strTable.get(data.context));
+        jio.writeMember(XML_GRAPH_NAME, strTable.get(data.name));
+        jio.writeMember(XML_GRAPH_TYPE, "int");
+        jio.writeMember(XML_GRAPH_VALUE, intValues[data.value]);
+        jio.writeEndObject();
+        break;
+      case Attribute::atFloat:
+        jio.writeBeginObject();
+        jio.writeMember(XML_GRAPH_CONTEXT, strTable.get(data.context));
+        jio.writeMember(XML_GRAPH_NAME, strTable.get(data.name));
+        jio.writeMember(XML_GRAPH_TYPE, "float");
+        jio.writeMember(XML_GRAPH_VALUE, static_cast<double>(floatValues[data.value]));
+        jio.writeEndObject();
+        break;
+      case Attribute::atString:
+        jio.writeBeginObject();
+        jio.writeMember(XML_GRAPH_CONTEXT, strTable.get(data.context));
+        jio.writeMember(XML_GRAPH_NAME, strTable.get(data.name));
+        jio.writeMember(XML_GRAPH_TYPE, "string");
+        jio.writeMember(XML_GRAPH_VALUE, strTable.get(stringValues[data.value]));
+        jio.writeEndObject();
+        break;
+      case Attribute::atComposite:
+        {
+          jio.writeBeginObject();
+          jio.writeName("attributes");
+          jio.writeBeginArray();
+          AttributeIterator it = getCompositeAttributes(attribute);
+          while (it.hasNext())
+            writeAttributeToJson(it.next(), jio);
+          jio.writeEndArray();
+          jio.writeMember(XML_GRAPH_CONTEXT, strTable.get(data.context));
+          jio.writeMember(XML_GRAPH_NAME, strTable.get(data.name));
+          jio.writeMember(XML_GRAPH_TYPE, "composite");
+          jio.writeEndObject();
+          break;
+        }
+      default:
+        break;
+    }
+  }
+
+  void CompactGraph::saveJSON(const string& filename) const {
+    JsonIO jio(filename, IOBase::omWrite);
+    jio.setIndentation("\t");
+    jio.writeBeginObject();
+    jio.writeName("header");
+    jio.writeBeginObject();
+    map<string, string> header;
+    for (const auto& headerInfo : headerInformations)
+      header[strTable.get(headerInfo.first)] = strTable.get(headerInfo.second);
+    for (const auto& headerInfo : header)
+      jio.writeMember(headerInfo.first, headerInfo.second);
+    jio.writeEndObject();
+
+    jio.writeName("nodes");
+    jio.writeBeginArray();
+    for (NodeId node : getNodesOrderedByUID()) {
+      jio.writeBeginObject();
+
+      if (nodeAttributes[node].first != nodeAttributes[node].second) {
+        jio.writeName("attributes");
+        jio.writeBeginArray();
+        AttributeIterator it = getAttributes(node);
+        while (it.hasNext())
+          writeAttributeToJson(it.next(), jio);
+        jio.writeEndArray();
+      }
+
+      bool edgesCreated = false;
+      for (EdgeId edge = outEdgeOffsets[node]; edge < outEdgeOffsets[node + 1]; ++edge) {
+        if (edgeDirections[edge] == Edge::edtReverse)
+          continue;
+
+        if (!edgesCreated) {
+          jio.writeName("edges");
+          jio.writeBeginArray();
+          edgesCreated = true;
+        }
+
+        jio.writeBeginObject();
+        if (edgeAttributes[edge].first != edgeAttributes[edge].second) {
+          jio.writeName("attributes");
+          jio.writeBeginArray();
+          AttributeIterator it = getEdgeAttributes(edge);
+          while (it.hasNext())
+            writeAttributeToJson(it.next(), jio);
+          jio.writeEndArray();
+        }
+        switch (edgeDirections[edge]) {
+          case Edge::edtBidirectional:
+            jio.writeMember(XML_GRAPH_DIRECTION, "bidirectional");
+            break;
+          case Edge::edtDirectional:
+            jio.writeMember(XML_GRAPH_DIRECTION, "directional");
+            break;
+          default:
+            break;
+        }
+        jio.writeMember(XML_GRAPH_EDGE_TO, strTable.get(nodeUIDs[edgeTargets[edge]]));
+        jio.writeMember(XML_GRAPH_TYPE, strTable.get(edgeTypes[edge]));
+        jio.writeEndObject();
+      }
+      if (edgesCreated)
+        jio.writeEndArray();
+
+      jio.writeMember(XML_GRAPH_NAME, strTable.get(nodeUIDs[node]));
+      jio.writeMember(XML_GRAPH_TYPE, strTable.get(nodeTypes[node]));
+      jio.writeEndObject();
+    }
+    jio.writeEndArray();
+    jio.writeEndObject();
+    jio.close();
+  }
+
+}}
@@ -22,8 +22,11 @@
 #define _CSVEXPORTER_H
 
 #include <graph/inc/graph.h>
+#include "GraphExporter.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 namespace columbus { namespace graphsupport {
@@ -45,6 +48,54 @@ namespace columbus { namespace graphsupport {
    */
   void exportImpactSet(graph::Graph& graph, const std::string& filename, graph::Edge::EdgeTypeSet& edgeTypes, const std::set<graph::Node>& parentNodes);
 
+  /**
+   * \brief orders the metric columns, the tag columns (starting with '/') come last
+   */
+  struct ColumnNameComparator {
+    bool operator()(const std::string &lhs, const std::string &rhs) const noexcept {
+      const auto lhs_tag = lhs.front() == '/';
+      const auto rhs_tag = rhs.front() == '/';
+
+      if (lhs_tag) {
+        if (!rhs_tag) { return false; }
+      } else {
+        if (rhs_tag) { return true; }
+      }
+
+      return lhs < rhs;
+    }
+  };
+
+  /**
+   * \brief writes the readable metrics of the nodes into one csv file per node type
+   *
+   * The header of the files is computed in begin(), the files are kept open until end().
+   */
+  class ReadableMetricsCsvWriter : public GraphExportWriter {
+    public:
+      ReadableMetricsCsvWriter(graph::Graph& graph, const std::string& filename, char separator = ',', char dmark = '.');
+      ~ReadableMetricsCsvWriter();
+
+      void begin() override;
+      void writeNode(const graph::Node& node) override;
+      void end() override;
+
+    private:
+      struct CsvFile;
+
+      io::CsvIO& openCsvFile(const std::string& nodeType, bool append);
+      io::CsvIO& getCsvFile(const std::string& nodeType);
+
+      graph::Graph& graph;
+      std::string fname;
+      std::string fext;
+      char separator;
+      char dmark;
+      std::string asg;
+      std::map<std::string, std::set<std::string, ColumnNameComparator>> calc_of_columns;
+      std::map<std::string, std::unique_ptr<CsvFile>> files;
+  };
+
   void exportReadableMetricsCSV(graph::Graph& graph, const std::string& filename, char separator = ',', char dmark = '.');
 
 }}
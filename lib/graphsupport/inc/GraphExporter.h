@@ -0,0 +1,147 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _GRAPHEXPORTER_H
+#define _GRAPHEXPORTER_H
+
+#include <graph/inc/graph.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace columbus { namespace graphsupport {
+
+  /**
+   * \brief an output format of the GraphExporter
+   *
+   * The exporter calls begin(), writeNode() for every node of the graph and end() on the same thread.
+   */
+  class GraphExportWriter {
+    public:
+      virtual ~GraphExportWriter() {}
+
+      /**
+       * \brief true if the writer needs the nodes ordered by their UIDs, otherwise they come in the order of the graph
+       */
+      virtual bool needsNodesOrderedByUID() const { return false; }
+
+      /**
+       * \brief true if the writer creates no iterators of the graph (the iterators register themselves in the graph,
+       *        so the writers using them run one at a time, the others run freely)
+       */
+      virtual bool isConcurrent() const { return false; }
+
+      virtual void begin() {}
+      virtual void writeNode(const graph::Node& node) = 0;
+      virtual void end() {}
+  };
+
+  /**
+   * \brief exports a graph to several formats in one pass
+   *
+   * The nodes are collected (and sorted by UID, if a writer needs it) once, then every writer runs on its own thread.
+   * The writers using the iterators of the graph take turns in blocks of nodes.
+   */
+  class GraphExporter {
+    public:
+      GraphExporter(graph::Graph& graph);
+
+      void addWriter(std::unique_ptr<GraphExportWriter> writer);
+
+      /**
+       * \brief runs the writers, the graph must not be modified meanwhile
+       * \throw the first exception thrown by the writers (after all of them are finished)
+       */
+      void run();
+
+    private:
+      graph::Graph& graph;
+      std::vector<std::unique_ptr<GraphExportWriter>> writers;
+  };
+
+  /**
+   * \brief output file of the writers with a large buffer, it can be used through the IO classes opened on getBuffer()
+   */
+  class BufferedOutputFile {
+    public:
+      /**
+       * \brief opens the file
+       * \throw IOException if the file cannot be opened
+       */
+      BufferedOutputFile(const std::string& filename, bool append = false);
+
+      std::streambuf* getBuffer() { return file.rdbuf(); }
+
+      /**
+       * \brief flushes the buffer and closes the file
+       * \throw IOException if the writing is failed
+       */
+      void close();
+
+    private:
+      std::string filename;
+      std::vector<char> buffer;
+      std::ofstream file;
+  };
+
+  /**
+   * \brief writes the XML dump of the graph with Graph::XMLWriter
+   */
+  class XMLExportWriter : public GraphExportWriter {
+    public:
+      XMLExportWriter(const graph::Graph& graph, const std::string& filename);
+
+      bool needsNodesOrderedByUID() const override { return true; }
+      bool isConcurrent() const override { return true; }
+
+      void begin() override;
+      void writeNode(const graph::Node& node) override;
+      void end() override;
+
+    private:
+      BufferedOutputFile file;
+      io::SimpleXmlIO sio;
+      graph::Graph::XMLWriter writer;
+  };
+
+  /**
+   * \brief writes the JSON dump of the graph with Graph::JSONWriter
+   */
+  class JSONExportWriter : public GraphExportWriter {
+    public:
+      JSONExportWriter(const graph::Graph& graph, const std::string& filename);
+
+      bool needsNodesOrderedByUID() const override { return true; }
+      bool isConcurrent() const override { return true; }
+
+      void begin() override;
+      void writeNode(const graph::Node& node) override;
+      void end() override;
+
+    private:
+      BufferedOutputFile file;
+      io::JsonIO jio;
+      graph::Graph::JSONWriter writer;
+  };
+
+}}
+
+#endif
@@ -22,7 +22,9 @@
 #define _GRAPHRANGEINDEXER_H
 
 #include <graph/inc/graph.h>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <list>
 #include <strtable/inc/StrTable.h>
@@ -31,9 +33,29 @@ namespace columbus { namespace graphsupport {
 
   /**
    * \brief index nodes by path and line in graph
+   *
+   * The nodes of every path are kept in an array sorted by their start position, augmented with an implicit
+   * balanced tree of the maximal end positions, so a range query costs O(log n + k) instead of a linear scan.
+   * Queries may be issued from several threads at the same time, but they must not overlap with turnOn(),
+   * turnOff() or adding new nodes.
    */
   class GraphRangeIndexer {
 
+  public:
+
+    /**
+     * \brief a searched source range
+     */
+    struct Range {
+      int line;
+      int col;
+      int endLine;
+      int endCol;
+
+      Range() : line(0), col(0), endLine(0), endCol(0) {}
+      Range(int line, int col, int endLine, int endCol) : line(line), col(col), endLine(endLine), endCol(endCol) {}
+    };
+
   protected:
 
     /**
@@ -47,40 +69,52 @@ namespace columbus { namespace graphsupport {
       int endCol;
       graph::Node node;
 
-      bool operator<(const RangedNode& rangedNode);
+      bool operator<(const RangedNode& rangedNode) const;
       RangedNode() : line(0), col(0), endLine(0), endCol(0), node() {}
     };
 
     /**
      * \internal
-     * \brief list of node range
+     * \brief the indexed nodes of a path
      */
-    typedef std::list< RangedNode > NodePrioritiList;
+    struct PathNodes {
+      /** \internal \brief the nodes sorted by their start position (nodes with equal start keep their insertion order) */
+      std::vector<RangedNode> nodes;
+      /** \internal \brief the maximal end position (line, col) of the implicit subtree rooted at the same index */
+      std::vector<std::pair<int, int> > maxEnds;
+      /** \internal \brief the length of the already sorted prefix of nodes (the rest was added since the last build) */
+      size_t sortedCount;
+      /** \internal \brief true if nodes were added since the last time the index was built */
+      std::atomic<bool> dirty;
+
+      PathNodes() : nodes(), maxEnds(), sortedCount(0), dirty(false) {}
+    };
+
     /**
      * \internal
      * \brief index by path
      */
-    typedef std::map< columbus::Key, NodePrioritiList > PathIndex;
+    typedef std::map< columbus::Key, PathNodes > PathIndex;
     /**
      * \internal
      * \brief container for indexers
      */
-    typedef std::vector< std::pair<const graph::Graph*, PathIndex > > IndexContainer;
+    typedef std::list< std::pair<const graph::Graph*, PathIndex > > IndexContainer;
 
   protected:
     /**
-     * \internal \brief actual graph indexer object
+     * \internal \brief string table of the indexed paths
      */
-    static GraphRangeIndexer* indexerObj;
-    /**
-     * \internal \brief string tabel for indexers
-     */
-    static StrTable strTable;
+    StrTable strTable;
     /**
      * \internal \brief conteainer for indexers
      *
      */
     IndexContainer indexContainer;
+    /**
+     * \internal \brief guards the lazy rebuilding of the path indices
+     */
+    std::mutex buildMutex;
 
   protected:
     /**
@@ -108,8 +142,10 @@ namespace columbus { namespace graphsupport {
     * \brief get range from node of graph
     * \param node [in] the node
     * \param range [out] the node range
+    * \param path [out] the key of the path of the node
+    * \return false, if the node does not have position
     */
-    void getRangeFromNode(const graph::Node& node, RangedNode& range, columbus::Key& path);
+    bool getRangeFromNode(const graph::Node& node, RangedNode& range, columbus::Key& path);
 
     /**
     * \internal
@@ -119,6 +155,31 @@ namespace columbus { namespace graphsupport {
     */
     PathIndex& getGraphPathIndex(const graph::Graph& graph);
 
+    /**
+    * \internal
+    * \brief gives back the indexed nodes of the path (the index of the path is built if it is necessary)
+    * \param graph [in] the graph
+    * \param path [in] the searched path
+    * \return the nodes of the path, or NULL if the graph doesn't have index or the index doesn't contain 'path'
+    */
+    const PathNodes* getPathNodes(const graph::Graph& graph, const std::string& path);
+
+    /**
+    * \internal
+    * \brief sorts the nodes of the path and builds the max end tree over them
+    * \param pathNodes [in, out] the nodes of a path
+    */
+    static void buildPathNodes(PathNodes& pathNodes);
+
+    /**
+    * \internal
+    * \brief collects the nodes overlapping with the range (in the order of their start position)
+    * \param pathNodes [in] the nodes of a path
+    * \param range [in] the searched range
+    * \param nodes [out] the founded nodes
+    */
+    static void collectNodes(const PathNodes& pathNodes, const Range& range, std::list<graph::Node>& nodes);
+
     /**
      * \internal
      * \brief add node to index
@@ -169,6 +230,16 @@ namespace columbus { namespace graphsupport {
      */
     bool findNodesByRange(graph::Graph& graph, const std::string& path, int line, int col, int endLine, int endCol, std::list<graph::Node>& nodes);
 
+    /**
+     * \brief find nodes by several ranges of the same path (the path is looked up only once)
+     * \param graph [in] graph, witch has an index object
+     * \param path [in] the searched path
+     * \param ranges [in] the searched ranges
+     * \param nodes [out] the founded nodes of every range (in the order of 'ranges')
+     * \return false, if graph doesn't have index, or the index doesn't contains 'path', otherwise return true
+     */
+    bool findNodesByRanges(graph::Graph& graph, const std::string& path, const std::vector<Range>& ranges, std::vector<std::list<graph::Node> >& nodes);
+
     /**
     * \brieg get instance from GraphRangeIndexer singleton class
     * \return a GraphRangeIndexer object
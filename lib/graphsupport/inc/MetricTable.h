@@ -0,0 +1,208 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _METRICTABLEGRAPSUPPORT
+#define _METRICTABLEGRAPSUPPORT
+
+#include <graph/inc/graph.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+  \file MetricTable.h
+  \brief Contains a dense storage for the metrics of graph nodes
+*/
+
+namespace columbus { namespace graphsupport {
+
+  /**
+  * \brief Stores the metric values of graph nodes in rows of integer indexed cells instead of metric attributes.
+  *
+  * The metrics are registered once (e.g. from the rul) and referred by their ids, the rows are identified by
+  * the caller (e.g. by the ids of the corresponding LIM nodes). The modifications have the same semantics
+  * as incMetricInt(), incMetricFloat() and setMetricINVALID() of Metric.h, and materialize() creates the
+  * same metric attributes (in the same order) as if these functions were called on the graph nodes. So
+  * storing an int and a float value for the same metric of a node results in two attributes, like there.
+  *
+  * Every row has a kind given by the caller (e.g. the node kind of the LIM node). The rows of the same kind
+  * share a layout of the metrics which are stored for that kind, so a row only has cells for these metrics.
+  */
+  class MetricTable {
+
+    public:
+
+      typedef unsigned MetricId;
+      typedef unsigned RowId;
+      typedef unsigned short RowKind;
+
+      /**
+      * \brief the id of the not registered metrics
+      */
+      static const MetricId invalidMetricId;
+
+      /**
+      * \brief constructor
+      * \param graph [in] the graph the metric attributes are materialized into
+      */
+      MetricTable(graph::Graph& graph);
+
+      ~MetricTable();
+
+      /**
+      * \brief registers the metric (can only be called before any value is stored)
+      * \param name [in] name of the metric
+      * \return the id of the metric (the existing one if the metric is already registered)
+      */
+      MetricId addMetric(const std::string& name);
+
+      /**
+      * \brief gives back the id of the metric or invalidMetricId if it is not registered
+      */
+      MetricId findMetric(const std::string& name) const;
+
+      /**
+      * \brief gives back the name of the metric
+      */
+      const std::string& getMetricName(MetricId metric) const;
+
+      /**
+      * \brief gives back the number of registered metrics
+      */
+      size_t getMetricCount() const;
+
+      /**
+      * \brief sets the graph node of the row (the metrics of the row are materialized into this node)
+      *        and its kind, which has to be set before any value is stored in the row
+      */
+      void setNode(RowId row, const graph::Node& node, RowKind kind);
+
+      /**
+      * \brief returns true if the graph node of the row is already set
+      */
+      bool hasNode(RowId row) const;
+
+      /**
+      * \brief increase metric value by 'value' in the row. If metric doesn't exist, the function create one, and set value to 'value'
+      */
+      void incMetricInt(RowId row, MetricId metric, int value);
+
+      /**
+      * \brief increase metric value by 'value' in the row. If metric doesn't exist, the function create one, and set value to 'value'
+      */
+      void incMetricFloat(RowId row, MetricId metric, float value);
+
+      /**
+      * \brief set metric value to INVALID in the row
+      */
+      void setMetricINVALID(RowId row, MetricId metric);
+
+      /**
+      * \brief gets the integer value of the metric
+      * \return false if the row does not have an integer value for the metric
+      */
+      bool getMetricInt(RowId row, MetricId metric, int& value) const;
+
+      /**
+      * \brief gets the float value of the metric
+      * \return false if the row does not have a float value for the metric
+      */
+      bool getMetricFloat(RowId row, MetricId metric, float& value) const;
+
+      /**
+      * \brief returns true if the metric is INVALID in the row
+      */
+      bool isINVALID(RowId row, MetricId metric) const;
+
+      /**
+      * \brief creates the metric attributes of the stored values on the graph nodes and clears the values
+      */
+      void materialize();
+
+    private:
+
+      enum CellFlag : unsigned char {
+        cfInt     = 1,
+        cfFloat   = 2,
+        cfInvalid = 4
+      };
+
+      /**
+      * \internal \brief the values of a metric in a row (the int and the float attributes can exist together, the INVALID one excludes them)
+      */
+      struct Cell {
+        int intValue;
+        float floatValue;
+        unsigned short intOrder;     ///> The creation order of the int (or the INVALID) metric attribute in the row
+        unsigned short floatOrder;   ///> The creation order of the float metric attribute in the row
+        unsigned char flags;
+      };
+
+      /**
+      * \internal \brief the metrics stored for a row kind, every row of the kind has its cells in this order
+      */
+      struct Layout {
+        std::vector<unsigned> slots;     ///> The cell index of each metric, or noSlot
+        std::vector<MetricId> metrics;   ///> The metric of each cell index
+      };
+
+      /**
+      * \internal \brief the metrics of a node (the cells are allocated when a value is stored)
+      */
+      struct Row {
+        graph::Node node;
+        RowKind kind;
+        std::vector<Cell> cells;
+        unsigned short nextOrder;
+      };
+
+      /**
+      * \internal \brief gives back the cell (allocates the cells of the row if needed)
+      */
+      Cell& getCell(RowId row, MetricId metric);
+
+      /**
+      * \internal \brief gives back the cell, or NULL if it is not allocated
+      */
+      const Cell* findCell(RowId row, MetricId metric) const;
+
+      /**
+      * \internal \brief gives back the next creation order of the row
+      */
+      unsigned short nextOrder(Row& row);
+
+      graph::Graph& graph;
+
+      std::vector<std::string> metricNames;
+      std::unordered_map<std::string, MetricId> metricIds;
+
+      std::vector<Row> rows;
+      std::vector<Layout> layouts;
+
+      /**
+      * \internal \brief true if a value is stored, the number of metrics cannot be changed after that
+      */
+      bool inUse;
+  };
+
+}}
+
+#endif
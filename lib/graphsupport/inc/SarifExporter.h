@@ -22,12 +22,40 @@
 #define _SARIFEXPORTER_H
 
 #include <graph/inc/graph.h>
+#include "GraphExporter.h"
+#include <map>
 #include <string>
 #include <common/inc/Stat.h>
 
 namespace columbus {
     namespace graphsupport {
 
+        /**
+        * \brief writes the warnings of the graph into a sarif file
+        *
+        * The rules are written in begin(), the results of the nodes in writeNode(), everything is streamed into the file.
+        */
+        class SarifWriter : public GraphExportWriter {
+        public:
+            SarifWriter(graph::Graph& graph, const std::string& filename, const std::string& sarifSeverityLevel);
+            ~SarifWriter();
+
+            void begin() override;
+            void writeNode(const graph::Node& node) override;
+            void end() override;
+
+        private:
+            void writeRules();
+
+            graph::Graph& graph;
+            BufferedOutputFile file;
+            io::JsonIO jio;
+            std::string asg;
+            bool sarifSeverityLevelVal[6];
+            std::map<std::string, int> ruleIndexesInJson;
+            graph::Node::NodeTypeSet types;
+        };
+
         /**
         * \brief load the graph, iterates it, and write the result into the sarif file
         * \param graph [in], graph from file
@@ -26,6 +26,9 @@
 #define CMSG_EX_WRONG_ATTRIBUTE_TYPE                  "Wrong attribute type!"
 #define CMSG_EX_UNHANDLED_ASG_TYPE(ASG)               "Unhandled ASG type (" + ASG + ")"
 #define CMSG_EX_INVALID_PRIORITY_VALUE(VAL)           "Invalid priority value:" + VAL
+#define CMSG_EX_METRIC_TABLE_ALREADY_IN_USE(NAME)     "The metric " + NAME + " cannot be added to the metric table after a value has been stored"
+#define CMSG_EX_METRIC_TABLE_NO_NODE                  "The row of the metric table has no graph node"
+#define CMSG_EX_CANNOT_WRITE_FILE(NAME)               "Cannot write the file: " + NAME
 
 
 #define CMSG_STAT_HEADER_IMPACTED                     "Impacted"
@@ -85,21 +85,6 @@ namespace columbus { namespace graphsupport {
     return fname + "-" + nodeType + fext;
   }
 
-  struct ColumnNameComparator {
-    bool operator()(const std::string &lhs, const std::string &rhs) const noexcept {
-      const auto lhs_tag = lhs.front() == '/';
-      const auto rhs_tag = rhs.front() == '/';
-
-      if (lhs_tag) {
-        if (!rhs_tag) { return false; }
-      } else {
-        if (rhs_tag) { return true; }
-      }
-
-      return lhs < rhs;
-    }
-  };
-
   static void writeTagMetricsHeader(const std::set<std::string, ColumnNameComparator> &tags, io::CsvIO &csvHeader) {
     for (const auto &tag_name : tags) {
       auto after_last_slash_pos = tag_name.rend() - std::find(tag_name.rbegin(), tag_name.rend(), '/');
@@ -185,10 +170,47 @@ namespace columbus { namespace graphsupport {
     csv.setQuotationMode(true);
   }
 
-  void exportReadableMetricsCSV(graph::Graph& graph, const string& filename, char separator, char dmark) {
-    string fname, fext;
+  struct ReadableMetricsCsvWriter::CsvFile {
+    BufferedOutputFile file;
+    io::CsvIO csv;
+
+    CsvFile(const string& filename, bool append) : file(filename, append), csv() {
+      csv.open(file.getBuffer());
+    }
+  };
+
+  ReadableMetricsCsvWriter::ReadableMetricsCsvWriter(graph::Graph& graph, const string& filename, char separator, char dmark)
+    : graph(graph)
+    , fname()
+    , fext()
+    , separator(separator)
+    , dmark(dmark)
+    , asg()
+    , calc_of_columns()
+    , files()
+  {
     common::splitExt(filename, fname, fext);
+  }
+
+  ReadableMetricsCsvWriter::~ReadableMetricsCsvWriter() {
+  }
+
+  io::CsvIO& ReadableMetricsCsvWriter::openCsvFile(const string& nodeType, bool append) {
+    unique_ptr<CsvFile>& csvFile = files[nodeType];
+    csvFile.reset(new CsvFile(csvName(fname, fext, nodeType), append));
+    setCsvStyle(csvFile->csv, separator, dmark);
+    return csvFile->csv;
+  }
+
+  io::CsvIO& ReadableMetricsCsvWriter::getCsvFile(const string& nodeType) {
+    auto it = files.find(nodeType);
+    if (it != files.end())
+      return it->second->csv;
+    // the nodes without header are appended to the file, like before
+    return openCsvFile(nodeType, true);
+  }
 
+  void ReadableMetricsCsvWriter::begin() {
     std::unordered_set<std::string> tag_should_summarize;
     if (auto metadata_node = graph.findNode(graphconstants::UID_RUL_TAG_METADATA);
         metadata_node != Graph::invalidNode) {
@@ -206,10 +228,9 @@ namespace columbus { namespace graphsupport {
       }
     }
 
-    const auto &asg = graph.getHeaderInfo(graphconstants::HEADER_ASG_KEY);
+    asg = graph.getHeaderInfo(graphconstants::HEADER_ASG_KEY);
 
     // put metrics before tags
-    std::map<std::string, std::set<std::string, ColumnNameComparator>> calc_of_columns;
     auto metric_nodes = graph.findNodes(graphconstants::NTYPE_RUL_METRIC);
     while (metric_nodes.hasNext()) {
       auto metric_node = metric_nodes.next();
@@ -357,8 +378,6 @@ namespace columbus { namespace graphsupport {
       }
     }
 
-
-
     // Create the csv file headers
     const char *const IDColumn = "ID";
     const char *const ParentColumn = "Parent";
@@ -379,8 +398,7 @@ namespace columbus { namespace graphsupport {
         nodeTypeIterator->first == graphconstants::NTYPE_RPG_SUBROUTINE ||
         nodeTypeIterator->first == graphconstants::NTYPE_LIM_MODULE)
       {
-        io::CsvIO csvHeader(csvName(fname, fext, nodeTypeIterator->first), io::IOBase::omWrite);
-        setCsvStyle(csvHeader, separator, dmark);
+        io::CsvIO& csvHeader = openCsvFile(nodeTypeIterator->first, false);
         csvHeader.writeColumn(IDColumn);
         csvHeader.writeColumn(graphconstants::ATTR_NAME);
         csvHeader.writeColumn(graphconstants::ATTR_LONGNAME);
@@ -399,21 +417,17 @@ namespace columbus { namespace graphsupport {
        
         writeTagMetricsHeader(nodeTypeIterator->second, csvHeader);
         csvHeader.writeNewLine();
-        csvHeader.close();
 
       } else if (nodeTypeIterator->first == graphconstants::NTYPE_DCF_CLONECLASS) {
-        io::CsvIO csvHeader(csvName(fname, fext, nodeTypeIterator->first), io::IOBase::omWrite);
-        setCsvStyle(csvHeader, separator, dmark);
+        io::CsvIO& csvHeader = openCsvFile(nodeTypeIterator->first, false);
         csvHeader.writeColumn(IDColumn);
         csvHeader.writeColumn(graphconstants::ATTR_NAME);
         csvHeader.writeColumn(graphconstants::NTYPE_LIM_COMPONENT);
         writeTagMetricsHeader(nodeTypeIterator->second, csvHeader);
         csvHeader.writeNewLine();
-        csvHeader.close();
 
       } else if (nodeTypeIterator->first == graphconstants::NTYPE_DCF_CLONEINSTANCE) {
-        io::CsvIO csvHeader(csvName(fname, fext, nodeTypeIterator->first), io::IOBase::omWrite);
-        setCsvStyle(csvHeader, separator, dmark);
+        io::CsvIO& csvHeader = openCsvFile(nodeTypeIterator->first, false);
         csvHeader.writeColumn(IDColumn);
         csvHeader.writeColumn(graphconstants::ATTR_NAME);
         csvHeader.writeColumn(ParentColumn);
@@ -427,24 +441,20 @@ namespace columbus { namespace graphsupport {
 
         writeTagMetricsHeader(nodeTypeIterator->second, csvHeader);
         csvHeader.writeNewLine();
-        csvHeader.close();
 
       } else if (nodeTypeIterator->first == graphconstants::NTYPE_LIM_COMPONENT) {
-        io::CsvIO csvHeader(csvName(fname, fext, nodeTypeIterator->first), io::IOBase::omWrite);
-        setCsvStyle(csvHeader, separator, dmark);
+        io::CsvIO& csvHeader = openCsvFile(nodeTypeIterator->first, false);
         csvHeader.writeColumn(IDColumn);
         csvHeader.writeColumn(graphconstants::ATTR_NAME);
         csvHeader.writeColumn(graphconstants::ATTR_LONGNAME);
         writeTagMetricsHeader(nodeTypeIterator->second, csvHeader);
         csvHeader.writeNewLine();
-        csvHeader.close();
 
       } else if (nodeTypeIterator->first == graphconstants::NTYPE_LIM_PACKAGE ||
         nodeTypeIterator->first == graphconstants::NTYPE_RPG_SYSTEM ||
         nodeTypeIterator->first == graphconstants::NTYPE_LIM_NAMESPACE)
       {
-        io::CsvIO csvHeader(csvName(fname, fext, nodeTypeIterator->first), io::IOBase::omWrite);
-        setCsvStyle(csvHeader, separator, dmark);
+        io::CsvIO& csvHeader = openCsvFile(nodeTypeIterator->first, false);
         csvHeader.writeColumn(IDColumn);
         csvHeader.writeColumn(graphconstants::ATTR_NAME);
         csvHeader.writeColumn(graphconstants::ATTR_LONGNAME);
@@ -452,153 +462,149 @@ namespace columbus { namespace graphsupport {
         csvHeader.writeColumn(graphconstants::NTYPE_LIM_COMPONENT);
         writeTagMetricsHeader(nodeTypeIterator->second, csvHeader);
         csvHeader.writeNewLine();
-        csvHeader.close();
       } else if (nodeTypeIterator->first == graphconstants::NTYPE_LIM_FILE ||
         nodeTypeIterator->first == graphconstants::NTYPE_LIM_FOLDER)
       {
-        io::CsvIO csvHeader(csvName(fname, fext, nodeTypeIterator->first), io::IOBase::omWrite);
-        setCsvStyle(csvHeader, separator, dmark);
+        io::CsvIO& csvHeader = openCsvFile(nodeTypeIterator->first, false);
         csvHeader.writeColumn(IDColumn);
         csvHeader.writeColumn(graphconstants::ATTR_NAME);
         csvHeader.writeColumn(graphconstants::ATTR_LONGNAME);
         csvHeader.writeColumn(ParentColumn);
         writeTagMetricsHeader(nodeTypeIterator->second, csvHeader);
         csvHeader.writeNewLine();
-        csvHeader.close();
       }
     }
+  }
 
-    // Write out the metric values
-    auto all_nodes = graph.getNodes();
-    while (all_nodes.hasNext()) {
-      Node node = all_nodes.next();
-      string nodeType = node.getType().getType();
-      if (nodeType == graphconstants::NTYPE_LIM_CLASS ||
-        nodeType == graphconstants::NTYPE_LIM_STRUCTURE ||
-        nodeType == graphconstants::NTYPE_LIM_DELEGATE ||
-        nodeType == graphconstants::NTYPE_LIM_UNION ||
-        nodeType == graphconstants::NTYPE_LIM_ENUM ||
-        nodeType == graphconstants::NTYPE_LIM_INTERFACE ||
-        nodeType == graphconstants::NTYPE_LIM_ANNOTATION ||
-        nodeType == graphconstants::NTYPE_LIM_METHOD ||
-        nodeType == graphconstants::NTYPE_LIM_FUNCTION ||
-        nodeType == graphconstants::NTYPE_LIM_ATTRIBUTE ||
-        nodeType == graphconstants::NTYPE_RPG_PROGRAM ||
-        nodeType == graphconstants::NTYPE_RPG_MODULE ||
-        nodeType == graphconstants::NTYPE_RPG_PROCEDURE ||
-        nodeType == graphconstants::NTYPE_RPG_SUBROUTINE ||
-        nodeType == graphconstants::NTYPE_LIM_MODULE)
-      {
-        io::CsvIO csvOut(csvName(fname, fext, nodeType), io::IOBase::omAppend);
-        setCsvStyle(csvOut, separator, dmark);
-        csvOut.writeColumn(node.getUID());
-        string name;
-        getNodeNameAttribute(node, name);
-        csvOut.writeColumn(name);
-
-        getNodeLongNameAttribute(node, name);
-        csvOut.writeColumn(name);
+  void ReadableMetricsCsvWriter::writeNode(const Node& node) {
+    string nodeType = node.getType().getType();
+    if (nodeType == graphconstants::NTYPE_LIM_CLASS ||
+      nodeType == graphconstants::NTYPE_LIM_STRUCTURE ||
+      nodeType == graphconstants::NTYPE_LIM_DELEGATE ||
+      nodeType == graphconstants::NTYPE_LIM_UNION ||
+      nodeType == graphconstants::NTYPE_LIM_ENUM ||
+      nodeType == graphconstants::NTYPE_LIM_INTERFACE ||
+      nodeType == graphconstants::NTYPE_LIM_ANNOTATION ||
+      nodeType == graphconstants::NTYPE_LIM_METHOD ||
+      nodeType == graphconstants::NTYPE_LIM_FUNCTION ||
+      nodeType == graphconstants::NTYPE_LIM_ATTRIBUTE ||
+      nodeType == graphconstants::NTYPE_RPG_PROGRAM ||
+      nodeType == graphconstants::NTYPE_RPG_MODULE ||
+      nodeType == graphconstants::NTYPE_RPG_PROCEDURE ||
+      nodeType == graphconstants::NTYPE_RPG_SUBROUTINE ||
+      nodeType == graphconstants::NTYPE_LIM_MODULE)
+    {
+      io::CsvIO& csvOut = getCsvFile(nodeType);
+      csvOut.writeColumn(node.getUID());
+      string name;
+      getNodeNameAttribute(node, name);
+      csvOut.writeColumn(name);
+
+      getNodeLongNameAttribute(node, name);
+      csvOut.writeColumn(name);
+
+      writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_LIM_LOGICALTREE, Edge::edtReverse));
 
-        writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_LIM_LOGICALTREE, Edge::edtReverse));
+      
+      writeComponents(node, csvOut);
 
-        
-        writeComponents(node, csvOut);
+      writePositionColumns(node, csvOut, asg == graphconstants::HEADER_ASG_VALUE_CPP);
+      writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
+      csvOut.writeNewLine();
 
-        writePositionColumns(node, csvOut, asg == graphconstants::HEADER_ASG_VALUE_CPP);
-        writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
-        csvOut.writeNewLine();
-        csvOut.close();
-
-      } else if (nodeType == graphconstants::NTYPE_DCF_CLONECLASS) {
-        const Attribute& cloneSmellAttr = getNodeAttribute(node, Attribute::atString, graphconstants::ATTR_DCF_CLONESMELLTYPE, graphconstants::CONTEXT_ATTRIBUTE);
-        if (cloneSmellAttr.getStringValue() != "cstDisappearing") {
-          io::CsvIO csvOut(csvName(fname, fext, nodeType), io::IOBase::omAppend);
-          setCsvStyle(csvOut, separator, dmark);
-          csvOut.writeColumn(node.getUID());
-          string name;
-          getNodeNameAttribute(node, name);
-          csvOut.writeColumn(name);
-          writeComponents(node, csvOut);
-          writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
-          csvOut.writeNewLine();
-          csvOut.close();
-        }
-      } else if (nodeType == graphconstants::NTYPE_DCF_CLONEINSTANCE) {
-        const Attribute& cloneSmellAttr = getNodeAttribute(node, Attribute::atString, graphconstants::ATTR_DCF_CLONESMELLTYPE, graphconstants::CONTEXT_ATTRIBUTE);
-        bool fakeInstance = cloneSmellAttr.getStringValue() == "cstDisappearing";
-        if (!fakeInstance) {
-          Node parentNode = getParent(node,  Edge::EdgeType(graphconstants::ETYPE_DCF_CLONETREE, Edge::edtReverse));
-          const Attribute& cloneSmellAttr = getNodeAttribute(parentNode, Attribute::atString, graphconstants::ATTR_DCF_CLONESMELLTYPE, graphconstants::CONTEXT_ATTRIBUTE);
-          fakeInstance = cloneSmellAttr.getStringValue() == "cstDisappearing";
-        }
-        if (!fakeInstance) {
-          io::CsvIO csvOut(csvName(fname, fext, nodeType), io::IOBase::omAppend);
-          setCsvStyle(csvOut, separator, dmark);
-          csvOut.writeColumn(node.getUID());
-          string name;
-          getNodeNameAttribute(node, name);
-          csvOut.writeColumn(name);        
-          writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_DCF_CLONETREE, Edge::edtReverse));
-          writeComponents(node, csvOut);
-          writePositionColumns(node, csvOut);
-          writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
-          csvOut.writeNewLine();
-          csvOut.close();
-        }
-      } else if (nodeType == graphconstants::NTYPE_LIM_COMPONENT) {
-        io::CsvIO csvOut(csvName(fname, fext, nodeType), io::IOBase::omAppend);
-        setCsvStyle(csvOut, separator, dmark);
+    } else if (nodeType == graphconstants::NTYPE_DCF_CLONECLASS) {
+      const Attribute& cloneSmellAttr = getNodeAttribute(node, Attribute::atString, graphconstants::ATTR_DCF_CLONESMELLTYPE, graphconstants::CONTEXT_ATTRIBUTE);
+      if (cloneSmellAttr.getStringValue() != "cstDisappearing") {
+        io::CsvIO& csvOut = getCsvFile(nodeType);
         csvOut.writeColumn(node.getUID());
         string name;
         getNodeNameAttribute(node, name);
         csvOut.writeColumn(name);
-
-        getNodeLongNameAttribute(node, name);
-        csvOut.writeColumn(name);
-
+        writeComponents(node, csvOut);
         writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
         csvOut.writeNewLine();
-        csvOut.close();
-
-      } else if (nodeType == graphconstants::NTYPE_LIM_PACKAGE ||
-        nodeType == graphconstants::NTYPE_RPG_SYSTEM ||
-        nodeType == graphconstants::NTYPE_LIM_NAMESPACE)
-      {
-        io::CsvIO csvOut(csvName(fname, fext, nodeType), io::IOBase::omAppend);
-        setCsvStyle(csvOut, separator, dmark);
+      }
+    } else if (nodeType == graphconstants::NTYPE_DCF_CLONEINSTANCE) {
+      const Attribute& cloneSmellAttr = getNodeAttribute(node, Attribute::atString, graphconstants::ATTR_DCF_CLONESMELLTYPE, graphconstants::CONTEXT_ATTRIBUTE);
+      bool fakeInstance = cloneSmellAttr.getStringValue() == "cstDisappearing";
+      if (!fakeInstance) {
+        Node parentNode = getParent(node,  Edge::EdgeType(graphconstants::ETYPE_DCF_CLONETREE, Edge::edtReverse));
+        const Attribute& cloneSmellAttr = getNodeAttribute(parentNode, Attribute::atString, graphconstants::ATTR_DCF_CLONESMELLTYPE, graphconstants::CONTEXT_ATTRIBUTE);
+        fakeInstance = cloneSmellAttr.getStringValue() == "cstDisappearing";
+      }
+      if (!fakeInstance) {
+        io::CsvIO& csvOut = getCsvFile(nodeType);
         csvOut.writeColumn(node.getUID());
         string name;
         getNodeNameAttribute(node, name);
-        csvOut.writeColumn(name);
-
-        getNodeLongNameAttribute(node, name);
-        csvOut.writeColumn(name);
-
-        writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_LIM_LOGICALTREE, Edge::edtReverse));
+        csvOut.writeColumn(name);        
+        writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_DCF_CLONETREE, Edge::edtReverse));
         writeComponents(node, csvOut);
+        writePositionColumns(node, csvOut);
         writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
         csvOut.writeNewLine();
-        csvOut.close();
+      }
+    } else if (nodeType == graphconstants::NTYPE_LIM_COMPONENT) {
+      io::CsvIO& csvOut = getCsvFile(nodeType);
+      csvOut.writeColumn(node.getUID());
+      string name;
+      getNodeNameAttribute(node, name);
+      csvOut.writeColumn(name);
 
-      } else if (nodeType == graphconstants::NTYPE_LIM_FILE ||
-        nodeType == graphconstants::NTYPE_LIM_FOLDER)
-      {
-        io::CsvIO csvOut(csvName(fname, fext, nodeType), io::IOBase::omAppend);
-        setCsvStyle(csvOut, separator, dmark);
-        csvOut.writeColumn(node.getUID());
-        string name;
-        getNodeNameAttribute(node, name);
-        csvOut.writeColumn(name);
+      getNodeLongNameAttribute(node, name);
+      csvOut.writeColumn(name);
 
-        getNodeLongNameAttribute(node, name);
-        csvOut.writeColumn(name);
+      writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
+      csvOut.writeNewLine();
 
-        writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_LIM_PHYSICALTREE, Edge::edtReverse));
-        writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
-        csvOut.writeNewLine();
-        csvOut.close();
+    } else if (nodeType == graphconstants::NTYPE_LIM_PACKAGE ||
+      nodeType == graphconstants::NTYPE_RPG_SYSTEM ||
+      nodeType == graphconstants::NTYPE_LIM_NAMESPACE)
+    {
+      io::CsvIO& csvOut = getCsvFile(nodeType);
+      csvOut.writeColumn(node.getUID());
+      string name;
+      getNodeNameAttribute(node, name);
+      csvOut.writeColumn(name);
+
+      getNodeLongNameAttribute(node, name);
+      csvOut.writeColumn(name);
+
+      writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_LIM_LOGICALTREE, Edge::edtReverse));
+      writeComponents(node, csvOut);
+      writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
+      csvOut.writeNewLine();
 
-      }
+    } else if (nodeType == graphconstants::NTYPE_LIM_FILE ||
+      nodeType == graphconstants::NTYPE_LIM_FOLDER)
+    {
+      io::CsvIO& csvOut = getCsvFile(nodeType);
+      csvOut.writeColumn(node.getUID());
+      string name;
+      getNodeNameAttribute(node, name);
+      csvOut.writeColumn(name);
+
+      getNodeLongNameAttribute(node, name);
+      csvOut.writeColumn(name);
+
+      writeParent(node, csvOut, Edge::EdgeType(graphconstants::ETYPE_LIM_PHYSICALTREE, Edge::edtReverse));
+      writeTagMetrics(calc_of_columns[nodeType], node, csvOut);
+      csvOut.writeNewLine();
+
+    }
+  }
+
+  void ReadableMetricsCsvWriter::end() {
+    for (auto& csvFile : files) {
+      csvFile.second->csv.close();
+      csvFile.second->file.close();
     }
+    files.clear();
+  }
+
+  void exportReadableMetricsCSV(graph::Graph& graph, const string& filename, char separator, char dmark) {
+    GraphExporter exporter(graph);
+    exporter.addWriter(unique_ptr<GraphExportWriter>(new ReadableMetricsCsvWriter(graph, filename, separator, dmark)));
+    exporter.run();
   }
 }}
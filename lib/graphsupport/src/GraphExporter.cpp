@@ -0,0 +1,183 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/GraphExporter.h"
+#include <threadpool/inc/ThreadPool.h>
+#include <io/inc/messages.h>
+#include "../inc/messages.h"
+#include <Exception.h>
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+using namespace columbus::graph;
+using namespace columbus::io;
+using namespace std;
+
+namespace columbus { namespace graphsupport {
+
+  // The writers using the iterators of the graph hold the lock for this many nodes at once.
+  static const size_t iteratorWriterBlockSize = 1024;
+
+  // The size of the buffer of the output files.
+  static const size_t outputBufferSize = 1 << 20;
+
+  GraphExporter::GraphExporter(Graph& graph)
+    : graph(graph)
+    , writers()
+  {
+  }
+
+  void GraphExporter::addWriter(unique_ptr<GraphExportWriter> writer) {
+    writers.push_back(move(writer));
+  }
+
+  void GraphExporter::run() {
+    if (writers.empty())
+      return;
+
+    vector<Node> nodes;
+    Node::NodeIterator nodeIt = graph.getNodes();
+    while (nodeIt.hasNext())
+      nodes.push_back(nodeIt.next());
+
+    vector<Node> nodesOrderedByUID;
+    if (any_of(writers.begin(), writers.end(), [](const unique_ptr<GraphExportWriter>& writer) { return writer->needsNodesOrderedByUID(); })) {
+      nodesOrderedByUID = nodes;
+      stable_sort(nodesOrderedByUID.begin(), nodesOrderedByUID.end(), [](const Node& lhs, const Node& rhs) { return lhs.getUID() < rhs.getUID(); });
+    }
+
+    mutex iteratorMutex;
+    auto runWriter = [&nodes, &nodesOrderedByUID, &iteratorMutex](GraphExportWriter& writer) {
+      const vector<Node>& writerNodes = writer.needsNodesOrderedByUID() ? nodesOrderedByUID : nodes;
+      if (writer.isConcurrent()) {
+        writer.begin();
+        for (const Node& node : writerNodes)
+          writer.writeNode(node);
+        writer.end();
+        return;
+      }
+
+      {
+        lock_guard<mutex> lock(iteratorMutex);
+        writer.begin();
+      }
+      for (size_t blockBegin = 0; blockBegin < writerNodes.size(); blockBegin += iteratorWriterBlockSize) {
+        lock_guard<mutex> lock(iteratorMutex);
+        size_t blockEnd = min(blockBegin + iteratorWriterBlockSize, writerNodes.size());
+        for (size_t i = blockBegin; i < blockEnd; ++i)
+          writer.writeNode(writerNodes[i]);
+      }
+      {
+        lock_guard<mutex> lock(iteratorMutex);
+        writer.end();
+      }
+    };
+
+    if (writers.size() == 1) {
+      runWriter(*writers.front());
+      return;
+    }
+
+    thread::ThreadPool pool(static_cast<unsigned int>(writers.size()));
+    vector<thread::TaskFuture<void>> results;
+    for (auto& writer : writers) {
+      GraphExportWriter* currentWriter = writer.get();
+      results.push_back(pool.submit([&runWriter, currentWriter]() { runWriter(*currentWriter); }));
+    }
+
+    exception_ptr firstError;
+    for (auto& result : results) {
+      try {
+        result.get();
+      } catch (...) {
+        if (!firstError)
+          firstError = current_exception();
+      }
+    }
+    if (firstError)
+      rethrow_exception(firstError);
+  }
+
+  BufferedOutputFile::BufferedOutputFile(const string& filename, bool append)
+    : filename(filename)
+    , buffer(outputBufferSize)
+    , file()
+  {
+    // the buffer must be set before the file is opened
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(filename, append ? ios_base::out | ios_base::app : ios_base::out | ios_base::trunc);
+    if (!file)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_OPEN_FILE + filename);
+  }
+
+  void BufferedOutputFile::close() {
+    if (!file.is_open())
+      return;
+    file.close();
+    if (!file)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_CANNOT_WRITE_FILE(filename));
+  }
+
+  XMLExportWriter::XMLExportWriter(const Graph& graph, const string& filename)
+    : file(filename)
+    , sio()
+    , writer(graph, sio)
+  {
+    sio.open(file.getBuffer());
+  }
+
+  void XMLExportWriter::begin() {
+    writer.writeBegin();
+  }
+
+  void XMLExportWriter::writeNode(const Node& node) {
+    writer.writeNode(node);
+  }
+
+  void XMLExportWriter::end() {
+    writer.writeEnd();
+    sio.close();
+    file.close();
+  }
+
+  JSONExportWriter::JSONExportWriter(const Graph& graph, const string& filename)
+    : file(filename)
+    , jio()
+    , writer(graph, jio)
+  {
+    jio.open(file.getBuffer());
+  }
+
+  void JSONExportWriter::begin() {
+    writer.writeBegin();
+  }
+
+  void JSONExportWriter::writeNode(const Node& node) {
+    writer.writeNode(node);
+  }
+
+  void JSONExportWriter::end() {
+    writer.writeEnd();
+    jio.close();
+    file.close();
+  }
+
+}}
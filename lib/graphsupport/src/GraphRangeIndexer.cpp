@@ -22,6 +22,7 @@
 #include "../inc/Metric.h"
 #include "../inc/GraphConstants.h"
 #include <common/inc/StringSup.h>
+#include <algorithm>
 
 
 using namespace columbus::graph;
@@ -30,20 +31,21 @@ using namespace std;
 
 namespace columbus { namespace graphsupport { 
 
+  typedef pair<int, int> RangePosition;
+
   static void correctPath(string& path) {
     LowerDriveLetterOnWindows(path);
   }
 
-  GraphRangeIndexer::GraphRangeIndexer() : indexContainer() {
+  GraphRangeIndexer::GraphRangeIndexer() : strTable(), indexContainer(), buildMutex() {
   }
 
   GraphRangeIndexer& GraphRangeIndexer::getGraphRangeIndexerInstance() {
-    if(indexerObj == NULL) 
-      indexerObj = new GraphRangeIndexer();
-    return *indexerObj;
+    static GraphRangeIndexer indexerObj;
+    return indexerObj;
   }
 
-  GraphRangeIndexer::GraphRangeIndexer(const GraphRangeIndexer& graph) : indexContainer() {
+  GraphRangeIndexer::GraphRangeIndexer(const GraphRangeIndexer& graph) : strTable(), indexContainer(), buildMutex() {
   }
 
 
@@ -56,12 +58,14 @@ namespace columbus { namespace graphsupport {
     return false;
   }
 
-  void GraphRangeIndexer::getRangeFromNode(const graph::Node& node, RangedNode& range, Key& path) {
+  bool GraphRangeIndexer::getRangeFromNode(const graph::Node& node, RangedNode& range, Key& path) {
     std::string pathString;
     if (getPositionAttribute(node, pathString, range.line, range.col, range.endLine, range.endCol)) {
       correctPath(pathString);
       path = strTable.set(pathString);
+      return true;
     }
+    return false;
   }
 
   GraphRangeIndexer::PathIndex& GraphRangeIndexer::getGraphPathIndex(const graph::Graph& graph) {
@@ -74,6 +78,82 @@ namespace columbus { namespace graphsupport {
     return (indexContainer.back().second);
   }
 
+  void GraphRangeIndexer::buildPathNodes(PathNodes& pathNodes) {
+    vector<RangedNode>& nodes = pathNodes.nodes;
+    vector<RangePosition>& maxEnds = pathNodes.maxEnds;
+
+    // the new nodes are placed after the already indexed nodes with the same start position
+    stable_sort(nodes.begin() + pathNodes.sortedCount, nodes.end());
+    inplace_merge(nodes.begin(), nodes.begin() + pathNodes.sortedCount, nodes.end());
+    pathNodes.sortedCount = nodes.size();
+
+    // the root of every subtree of the implicit tree over [begin, end) is its middle element
+    auto build = [&nodes, &maxEnds](auto& self, size_t begin, size_t end) -> RangePosition {
+      size_t mid = begin + (end - begin) / 2;
+      RangePosition maxEnd(nodes[mid].endLine, nodes[mid].endCol);
+      if (begin < mid)
+        maxEnd = max(maxEnd, self(self, begin, mid));
+      if (mid + 1 < end)
+        maxEnd = max(maxEnd, self(self, mid + 1, end));
+      maxEnds[mid] = maxEnd;
+      return maxEnd;
+    };
+    maxEnds.assign(nodes.size(), RangePosition());
+    if (!nodes.empty())
+      build(build, 0, nodes.size());
+
+    pathNodes.dirty = false;
+  }
+
+  void GraphRangeIndexer::collectNodes(const PathNodes& pathNodes, const Range& range, std::list<graph::Node>& nodes) {
+    const vector<RangedNode>& indexed = pathNodes.nodes;
+    const vector<RangePosition>& maxEnds = pathNodes.maxEnds;
+    const RangePosition start(range.line, range.col);
+    const RangePosition end(range.endLine, range.endCol);
+
+    // the nodes starting after the end of the range can not overlap with it
+    size_t last = upper_bound(indexed.begin(), indexed.end(), end, [](const RangePosition& position, const RangedNode& rangedNode) {
+      return position < RangePosition(rangedNode.line, rangedNode.col);
+    }) - indexed.begin();
+
+    // in-order walk of the implicit tree, the subtrees ending before the range are skipped
+    auto collect = [&](auto& self, size_t begin, size_t end) -> void {
+      if (begin >= end || begin >= last)
+        return;
+      size_t mid = begin + (end - begin) / 2;
+      if (maxEnds[mid] < start)
+        return;
+      self(self, begin, mid);
+      if (mid < last) {
+        if (!(RangePosition(indexed[mid].endLine, indexed[mid].endCol) < start))
+          nodes.push_back(indexed[mid].node);
+        self(self, mid + 1, end);
+      }
+    };
+    collect(collect, 0, indexed.size());
+  }
+
+  const GraphRangeIndexer::PathNodes* GraphRangeIndexer::getPathNodes(const graph::Graph& graph, const string& origPath) {
+    if(!getIsOn(graph))
+      return NULL;
+    string path = origPath;
+    correctPath(path);
+    Key pathKey = strTable.get(path);
+    if(!pathKey)
+      return NULL;
+    PathIndex& index = getGraphPathIndex(graph);
+    PathIndex::iterator mapIt = index.find(pathKey);
+    if(mapIt == index.end())
+      return NULL;
+    PathNodes& pathNodes = mapIt->second;
+    if (pathNodes.dirty) {
+      lock_guard<mutex> lock(buildMutex);
+      if (pathNodes.dirty)
+        buildPathNodes(pathNodes);
+    }
+    return &pathNodes;
+  }
+
   void GraphRangeIndexer::turnOn(graph::Graph &graph) {
     if(getIsOn(graph))
       return;
@@ -85,17 +165,16 @@ namespace columbus { namespace graphsupport {
       RangedNode rangedNode;
       Key path;
       rangedNode.node = node;
-      getRangeFromNode(node, rangedNode, path);
-
-      NodePrioritiList& priList = index[path];
-      // insert node to list, list stay sorted
-      NodePrioritiList::iterator listIt;
-      for(listIt = priList.begin(); listIt != priList.end(); listIt++) {
-        if(rangedNode < *listIt) 
-          break;
-      }
-      priList.insert(listIt, rangedNode);
+      if (!getRangeFromNode(node, rangedNode, path))
+        continue;
+
+      PathNodes& pathNodes = index[path];
+      pathNodes.nodes.push_back(rangedNode);
+      pathNodes.dirty = true;
     }
+
+    for (PathIndex::iterator it = index.begin(); it != index.end(); ++it)
+      buildPathNodes(it->second);
   }
 
   void GraphRangeIndexer::turnOff(graph::Graph& graph) {
@@ -111,52 +190,34 @@ namespace columbus { namespace graphsupport {
     indexContainer.erase(it);
   }
 
-  bool GraphRangeIndexer::findNodesByPath(graph::Graph& graph, const string& origPath, std::list<graph::Node>& nodes) {
-    if(!getIsOn(graph))
+  bool GraphRangeIndexer::findNodesByPath(graph::Graph& graph, const string& path, std::list<graph::Node>& nodes) {
+    const PathNodes* pathNodes = getPathNodes(graph, path);
+    if(!pathNodes)
       return false;
-    string path = origPath;
-    correctPath(path);
-    Key pathKey = strTable.get(path);
-    if(!pathKey)
-      return false;
-    PathIndex& index = getGraphPathIndex(graph);
-    PathIndex::iterator mapIt = index.find(pathKey);
-    if(mapIt == index.end())
-      return false;
-    NodePrioritiList& list = mapIt->second;
-    for(NodePrioritiList::iterator it = list.begin(); it != list.end(); it++)
+    for(vector<RangedNode>::const_iterator it = pathNodes->nodes.begin(); it != pathNodes->nodes.end(); it++)
       nodes.push_back(it->node);
     return true;
   }
 
-  bool GraphRangeIndexer::findNodesByRange(graph::Graph& graph, const string& origPath, int line, int col, int endLine, int endCol, std::list<graph::Node>& nodes) {
-    if(!getIsOn(graph))
-      return false;
-    string path = origPath;
-    correctPath(path);
-    Key pathKey = strTable.get(path);
-    if(!pathKey)
-      return false;
-    PathIndex& index = getGraphPathIndex(graph);
-    PathIndex::iterator mapIt = index.find(pathKey);
-    if(mapIt == index.end())
+  bool GraphRangeIndexer::findNodesByRange(graph::Graph& graph, const string& path, int line, int col, int endLine, int endCol, std::list<graph::Node>& nodes) {
+    const PathNodes* pathNodes = getPathNodes(graph, path);
+    if(!pathNodes)
       return false;
-    NodePrioritiList& list = mapIt->second;
-    for(NodePrioritiList::iterator it = list.begin(); it != list.end(); it++) {
-      if( (endLine < it->line) || ((endLine == it->line) && (endCol < it->col)) )
-        break;
-
-      if( (line < it->endLine) || ((line == it->endLine) &&  (col <= (it->endCol))) )
-        nodes.push_back(it->node);
-    }
+    collectNodes(*pathNodes, Range(line, col, endLine, endCol), nodes);
     return true;
   }
 
-  GraphRangeIndexer* GraphRangeIndexer::indexerObj = NULL;
-
-  StrTable GraphRangeIndexer::strTable = StrTable();
+  bool GraphRangeIndexer::findNodesByRanges(graph::Graph& graph, const string& path, const vector<Range>& ranges, vector<list<graph::Node> >& nodes) {
+    const PathNodes* pathNodes = getPathNodes(graph, path);
+    if(!pathNodes)
+      return false;
+    nodes.resize(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i)
+      collectNodes(*pathNodes, ranges[i], nodes[i]);
+    return true;
+  }
 
-  bool GraphRangeIndexer::RangedNode::operator<(const GraphRangeIndexer::RangedNode &rangedNode) {
+  bool GraphRangeIndexer::RangedNode::operator<(const GraphRangeIndexer::RangedNode &rangedNode) const {
     if(this->line < rangedNode.line)
       return true;
     if(this->line == rangedNode.line)
@@ -178,14 +239,10 @@ namespace columbus { namespace graphsupport {
     rangedNode.endCol = endCol;
     rangedNode.endLine = endLine;
 
-    NodePrioritiList& priList = index[pathKey];
-    // insert node to list, list stay sorted
-    NodePrioritiList::iterator listIt;
-    for(listIt = priList.begin(); listIt != priList.end(); listIt++) {
-      if(rangedNode < *listIt) 
-        break;
-    }
-    priList.insert(listIt, rangedNode);
+    // the node is sorted into its place before the next query of the path
+    PathNodes& pathNodes = index[pathKey];
+    pathNodes.nodes.push_back(rangedNode);
+    pathNodes.dirty = true;
   }
 
 
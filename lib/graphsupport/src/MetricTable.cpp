@@ -0,0 +1,254 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/MetricTable.h"
+#include "../inc/Metric.h"
+#include "../inc/messages.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace columbus::graph;
+using namespace std;
+
+namespace columbus { namespace graphsupport {
+
+  const MetricTable::MetricId MetricTable::invalidMetricId = numeric_limits<MetricTable::MetricId>::max();
+
+  MetricTable::MetricTable(Graph& graph)
+    : graph(graph)
+    , metricNames()
+    , metricIds()
+    , rows()
+    , layouts()
+    , inUse(false)
+  {
+  }
+
+  MetricTable::~MetricTable() {
+  }
+
+  MetricTable::MetricId MetricTable::addMetric(const string& name) {
+    unordered_map<string, MetricId>::const_iterator it = metricIds.find(name);
+    if (it != metricIds.end())
+      return it->second;
+
+    if (inUse)
+      throw Exception(COLUMBUS_LOCATION, CMSG_EX_METRIC_TABLE_ALREADY_IN_USE(name));
+
+    MetricId id = (MetricId)metricNames.size();
+    metricNames.push_back(name);
+    metricIds.insert(make_pair(name, id));
+    return id;
+  }
+
+  MetricTable::MetricId MetricTable::findMetric(const string& name) const {
+    unordered_map<string, MetricId>::const_iterator it = metricIds.find(name);
+    if (it == metricIds.end())
+      return invalidMetricId;
+    return it->second;
+  }
+
+  const string& MetricTable::getMetricName(MetricId metric) const {
+    return metricNames[metric];
+  }
+
+  size_t MetricTable::getMetricCount() const {
+    return metricNames.size();
+  }
+
+  static const unsigned noSlot = numeric_limits<unsigned>::max();
+
+  void MetricTable::setNode(RowId row, const Node& node, RowKind kind) {
+    if (row >= rows.size())
+      rows.resize(max((size_t)row + 1, rows.size() * 2));
+    rows[row].node = node;
+    rows[row].kind = kind;
+    if (kind >= layouts.size())
+      layouts.resize((size_t)kind + 1);
+  }
+
+  bool MetricTable::hasNode(RowId row) const {
+    return row < rows.size() && rows[row].node != Graph::invalidNode;
+  }
+
+  MetricTable::Cell& MetricTable::getCell(RowId rowId, MetricId metric) {
+    if (!hasNode(rowId))
+      throw Exception(COLUMBUS_LOCATION, CMSG_EX_METRIC_TABLE_NO_NODE);
+
+    Row& row = rows[rowId];
+    Layout& layout = layouts[row.kind];
+    if (layout.slots.empty())
+      layout.slots.assign(metricNames.size(), noSlot);
+
+    unsigned slot = layout.slots[metric];
+    if (slot == noSlot) {
+      slot = (unsigned)layout.metrics.size();
+      layout.slots[metric] = slot;
+      layout.metrics.push_back(metric);
+    }
+
+    if (row.cells.empty())
+      row.nextOrder = 0;
+    if (slot >= row.cells.size())
+      row.cells.resize(layout.metrics.size(), Cell());
+    inUse = true;
+    return row.cells[slot];
+  }
+
+  const MetricTable::Cell* MetricTable::findCell(RowId rowId, MetricId metric) const {
+    if (rowId >= rows.size() || metric >= metricNames.size())
+      return NULL;
+    const Row& row = rows[rowId];
+    if (row.cells.empty())
+      return NULL;
+    unsigned slot = layouts[row.kind].slots[metric];
+    if (slot == noSlot || slot >= row.cells.size())
+      return NULL;
+    return &row.cells[slot];
+  }
+
+  unsigned short MetricTable::nextOrder(Row& row) {
+    if (row.nextOrder == numeric_limits<unsigned short>::max()) {
+      // renumbering the existing attributes to keep their order
+      vector<unsigned short*> used;
+      for (Cell& cell : row.cells) {
+        if (cell.flags & (cfInt | cfInvalid))
+          used.push_back(&cell.intOrder);
+        if (cell.flags & cfFloat)
+          used.push_back(&cell.floatOrder);
+      }
+      sort(used.begin(), used.end(), [](const unsigned short* a, const unsigned short* b) { return *a < *b; });
+      row.nextOrder = 0;
+      for (unsigned short* order : used)
+        *order = row.nextOrder++;
+    }
+    return row.nextOrder++;
+  }
+
+  void MetricTable::incMetricInt(RowId row, MetricId metric, int value) {
+    Cell& cell = getCell(row, metric);
+    if (cell.flags & cfInt) {
+      cell.intValue += value;
+      return;
+    }
+
+    // a new attribute is created (the INVALID one is removed, the float one is kept)
+    cell.flags = (cell.flags & cfFloat) | cfInt;
+    cell.intOrder = nextOrder(rows[row]);
+    cell.intValue = value;
+  }
+
+  void MetricTable::incMetricFloat(RowId row, MetricId metric, float value) {
+    Cell& cell = getCell(row, metric);
+    if (cell.flags & cfFloat) {
+      cell.floatValue += value;
+      return;
+    }
+
+    // a new attribute is created (the INVALID one is removed, the int one is kept)
+    if (cell.flags & cfInvalid)
+      cell.flags = 0;
+    cell.flags |= cfFloat;
+    cell.floatOrder = nextOrder(rows[row]);
+    cell.floatValue = value;
+  }
+
+  void MetricTable::setMetricINVALID(RowId row, MetricId metric) {
+    Cell& cell = getCell(row, metric);
+    if (cell.flags & cfInvalid)
+      return;
+
+    // the value attributes are removed and a new INVALID attribute is created
+    cell.flags = cfInvalid;
+    cell.intOrder = nextOrder(rows[row]);
+  }
+
+  bool MetricTable::getMetricInt(RowId row, MetricId metric, int& value) const {
+    const Cell* cell = findCell(row, metric);
+    if (!cell || !(cell->flags & cfInt))
+      return false;
+    value = cell->intValue;
+    return true;
+  }
+
+  bool MetricTable::getMetricFloat(RowId row, MetricId metric, float& value) const {
+    const Cell* cell = findCell(row, metric);
+    if (!cell || !(cell->flags & cfFloat))
+      return false;
+    value = cell->floatValue;
+    return true;
+  }
+
+  bool MetricTable::isINVALID(RowId row, MetricId metric) const {
+    const Cell* cell = findCell(row, metric);
+    return cell && (cell->flags & cfInvalid);
+  }
+
+  void MetricTable::materialize() {
+    // the attributes of a row by their creation order: (order, cell index, flag)
+    struct CreatedAttribute {
+      unsigned short order;
+      unsigned slot;
+      CellFlag flag;
+    };
+    vector<CreatedAttribute> order;
+
+    for (Row& row : rows) {
+      if (row.cells.empty())
+        continue;
+
+      const Layout& layout = layouts[row.kind];
+      order.clear();
+      for (unsigned slot = 0; slot < row.cells.size(); ++slot) {
+        const Cell& cell = row.cells[slot];
+        if (cell.flags & cfInt)
+          order.push_back(CreatedAttribute{ cell.intOrder, slot, cfInt });
+        if (cell.flags & cfFloat)
+          order.push_back(CreatedAttribute{ cell.floatOrder, slot, cfFloat });
+        if (cell.flags & cfInvalid)
+          order.push_back(CreatedAttribute{ cell.intOrder, slot, cfInvalid });
+      }
+      sort(order.begin(), order.end(), [](const CreatedAttribute& a, const CreatedAttribute& b) { return a.order < b.order; });
+
+      for (const CreatedAttribute& attribute : order) {
+        const Cell& cell = row.cells[attribute.slot];
+        const string& name = metricNames[layout.metrics[attribute.slot]];
+        switch (attribute.flag) {
+          case cfInt:
+            graphsupport::incMetricInt(graph, row.node, name, cell.intValue);
+            break;
+          case cfFloat:
+            graphsupport::incMetricFloat(graph, row.node, name, cell.floatValue);
+            break;
+          case cfInvalid:
+            graphsupport::setMetricINVALID(graph, row.node, name);
+            break;
+        }
+      }
+    }
+
+    // the values are not needed any more
+    rows = vector<Row>();
+    layouts = vector<Layout>();
+    inUse = false;
+  }
+
+}}
@@ -25,13 +25,13 @@
 #include "../inc/GraphConstants.h"
 #include "../inc/SarifExporter.h"
 #include "../inc/messages.h"
-#include "jsoncpp/inc/json.h"
 #include <algorithm>
 #include <Exception.h>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <graphsupport/inc/Metric.h>
 #include <regex>
+#include <vector>
 
 using namespace columbus::graph;
 using namespace columbus::graphsupport::graphconstants;
@@ -126,39 +126,6 @@ namespace {
         "file:///";
 #endif
 
-    /**
-    * \brief basic IO class for SARIF
-    */
-    class SarifIO : public virtual columbus::io::IOBase {
-    private:
-        const char *resultLeftMargin = "        ";
-        const char *ruleLeftMargin = "            ";
-    public:
-        void writeData(const Json::Value& root, bool isRule = false) {
-            Json::StreamWriterBuilder builder;
-            builder["indentation"] = "  ";
-            if (!isOpen()) throw columbus::IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_NOT_OPEN);
-            else {
-                std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-                common::updateMemoryStat();
-                writer->write(root, stream.get(), isRule ? ruleLeftMargin : resultLeftMargin);
-                common::updateMemoryStat();
-                flush();
-            }
-        }
-        void writeData(const string &text) {
-            *stream << text;
-        }
-        void writeData(const char *text) {
-            *stream << text;
-        }
-        void writeData(const vector<string> &text) {
-            for (auto &t : text) {
-                *stream << t;
-            }
-        }
-    };
-
     /**
     * \brief checks if the given node has the required attribute for a sarif field, similar to graph::Attribute::AttributeIterator
     * \param node [in]
@@ -213,50 +180,163 @@ namespace {
         return attr.findAttribute(aType, name, context).hasNext();
     }
 
+    /**
+    * \brief the SARIF location converted from a Node/AttributeComposite->Location
+    */
+    struct SarifLocation {
+        string uri;
+        int line;
+        int column;
+        int endLine;
+        int endColumn;
+        string description;
+    };
+
+    /**
+    * \brief a location of the SARIF thread flow (trace of the warning)
+    */
+    struct SarifThreadFlowLocation {
+        SarifLocation location;
+        bool hasMessage;
+        string message;
+        int nestingLevel;
+    };
+
     /**
     * \brief convert Node/AttributeComposite->Location to Sarif->Location
     * \param attrComp [in], reference to AttributeComposite to which will be converted
-    * \param location [in-out], refernce to Json::Value where the converted SARIF location will be stored
+    * \return the converted SARIF location
     */
-    void writeLocation(AttributeComposite &attrComp, Json::Value &location) {
+    SarifLocation readLocation(AttributeComposite &attrComp) {
         const AttributeString &path = (AttributeString&)componentHasTheRequiredAttribute(attrComp, Attribute::atString, ATTR_PATH, "");
         const AttributeInt &lineBegin = (AttributeInt&)componentHasTheRequiredAttribute(attrComp, Attribute::atInt, ATTR_LINE, "");
         const AttributeInt &lineEnd = (AttributeInt&)componentHasTheRequiredAttribute(attrComp, Attribute::atInt, ATTR_ENDLINE, "");
         const AttributeInt &columnBegin = (AttributeInt&)componentHasTheRequiredAttribute(attrComp, Attribute::atInt, ATTR_COLUMN, "");
         const AttributeInt &columnEnd = (AttributeInt&)componentHasTheRequiredAttribute(attrComp, Attribute::atInt, ATTR_ENDCOLUMN, "");
 
-        int line = lineBegin.getValue();
-        int endLine = lineEnd.getValue();
-        int column = columnBegin.getValue();
-        int endColumn = columnEnd.getValue();
-        std::string _path;
-        _path = uriFile + boost::filesystem::path(path.getStringValue()).generic_string();
-        boost::replace_all(_path, " ", "%20");
+        SarifLocation location;
+        location.line = lineBegin.getValue();
+        location.endLine = lineEnd.getValue();
+        location.column = columnBegin.getValue();
+        location.endColumn = columnEnd.getValue();
+        location.uri = uriFile + boost::filesystem::path(path.getStringValue()).generic_string();
+        boost::replace_all(location.uri, " ", "%20");
 
         // negative starting/ending value to 0, because sarif line/column number cannot have negative number
-        if (line <= 0) {
-            line = 1;
+        if (location.line <= 0) {
+            location.line = 1;
+        }
+        if (location.endLine <= 0) {
+            location.endLine = location.line;
         }
-        if (endLine <= 0) {
-            endLine = line;
+        if (location.column <= 0) {
+            location.column = 1;
         }
-        if (column <= 0) {
-            column = 1;
+        if (location.endColumn <= 0) {
+            location.endColumn = location.column;
         }
-        if (endColumn <= 0) {
-            endColumn = column;
+        return location;
+    }
+
+    SarifLocation readLocation(const Node &node) {
+        return readLocation((AttributeComposite&)node.findAttribute(Attribute::atComposite, ATTR_POSITION, CONTEXT_ATTRIBUTE).next());
+    }
+
+    /**
+    * \brief write the physicalLocation member of a SARIF location
+    * \param jio [in], the output
+    * \param location [in], the location to write
+    */
+    void writePhysicalLocation(JsonIO &jio, const SarifLocation &location) {
+        jio.writeName(SARIF_NAME_PHLOCATION);
+        jio.writeBeginObject();
+
+        jio.writeName(SARIF_NAME_ARTLOCATION);
+        jio.writeBeginObject();
+        if (!location.description.empty()) {
+            jio.writeName(SARIF_NAME_DESCRIPTION);
+            jio.writeBeginObject();
+            jio.writeMember(SARIF_NAME_TEXT, location.description);
+            jio.writeEndObject();
         }
+        jio.writeMember(SARIF_NAME_URI, location.uri);
+        jio.writeEndObject();
+
+        jio.writeName(SARIF_NAME_REGION);
+        jio.writeBeginObject();
+        jio.writeMember(SARIF_NAME_ENDCOLUMN, location.endColumn);
+        jio.writeMember(SARIF_NAME_ENDLINE, location.endLine);
+        jio.writeMember(SARIF_NAME_COLUMN, location.column);
+        jio.writeMember(SARIF_NAME_LINE, location.line);
+        jio.writeEndObject();
+
+        jio.writeEndObject();
+    }
 
-        location[SARIF_NAME_PHLOCATION][SARIF_NAME_ARTLOCATION][SARIF_NAME_URI] = _path;
+    /**
+    * \brief write the locations member of a SARIF result
+    * \param jio [in], the output
+    * \param locations [in], the locations to write
+    */
+    void writeLocations(JsonIO &jio, const vector<SarifLocation> &locations) {
+        jio.writeName(SARIF_NAME_LOCATIONS);
+        jio.writeBeginArray();
+        for (const SarifLocation &location : locations) {
+            jio.writeBeginObject();
+            writePhysicalLocation(jio, location);
+            jio.writeEndObject();
+        }
+        jio.writeEndArray();
+    }
 
-        location[SARIF_NAME_PHLOCATION][SARIF_NAME_REGION][SARIF_NAME_LINE] = line;
-        location[SARIF_NAME_PHLOCATION][SARIF_NAME_REGION][SARIF_NAME_COLUMN] = column;
-        location[SARIF_NAME_PHLOCATION][SARIF_NAME_REGION][SARIF_NAME_ENDLINE] = endLine;
-        location[SARIF_NAME_PHLOCATION][SARIF_NAME_REGION][SARIF_NAME_ENDCOLUMN] = endColumn;
+    /**
+    * \brief write the codeFlows member of a SARIF result (one thread flow)
+    * \param jio [in], the output
+    * \param threadFlowLocations [in], the locations of the thread flow
+    */
+    void writeCodeFlows(JsonIO &jio, const vector<SarifThreadFlowLocation> &threadFlowLocations) {
+        jio.writeName(SARIF_NAME_CODEFLOWS);
+        jio.writeBeginArray();
+        jio.writeBeginObject();
+        jio.writeName(SARIF_NAME_THREADFLOWS);
+        jio.writeBeginArray();
+        jio.writeBeginObject();
+        jio.writeName(SARIF_NAME_LOCATIONS);
+        jio.writeBeginArray();
+        int executionOrder = 0;
+        for (const SarifThreadFlowLocation &threadFlowLocation : threadFlowLocations) {
+            jio.writeBeginObject();
+            jio.writeMember(SARIF_NAME_EXECUTIONORDER, executionOrder);
+            jio.writeMember(SARIF_NAME_IMPORTANCE, SARIF_VALUE_IMPORTANCE::ESSENTIAL);
+            jio.writeName(SARIF_NAME_THREADFLOWLOCATION);
+            jio.writeBeginObject();
+            if (threadFlowLocation.hasMessage) {
+                jio.writeName(SARIF_NAME_MESSAGE);
+                jio.writeBeginObject();
+                jio.writeMember(SARIF_NAME_TEXT, threadFlowLocation.message);
+                jio.writeEndObject();
+            }
+            writePhysicalLocation(jio, threadFlowLocation.location);
+            jio.writeEndObject();
+            jio.writeMember(SARIF_NAME_NESTINGLEVEL, threadFlowLocation.nestingLevel);
+            jio.writeEndObject();
+            executionOrder++;
+        }
+        jio.writeEndArray();
+        jio.writeEndObject();
+        jio.writeEndArray();
+        jio.writeEndObject();
+        jio.writeEndArray();
     }
 
-    void writeLocation(const Node &node, Json::Value &location) {
-        writeLocation((AttributeComposite&)node.findAttribute(Attribute::atComposite, ATTR_POSITION, CONTEXT_ATTRIBUTE).next(), location);
+    /**
+    * \brief write a member of a SARIF object, which contains only a text (like message or description)
+    */
+    void writeTextMember(JsonIO &jio, const string &name, const string &text) {
+        jio.writeName(name);
+        jio.writeBeginObject();
+        jio.writeMember(SARIF_NAME_TEXT, text);
+        jio.writeEndObject();
     }
 
     void replace(string& str, pair<string, string> opening, pair<string, string> closing) {
@@ -367,379 +447,377 @@ namespace {
     }
 }
 
+
 namespace columbus {
     namespace graphsupport {
 
-        void exportToSarif(Graph & graph, const std::string & filename, const string & sarifSeverityLevel)
-        {
-            const string &asg = graph.getHeaderInfo("asg");
-            bool sarifSeverityLevelVal[] = {
+        SarifWriter::SarifWriter(Graph &graph, const string &filename, const string &sarifSeverityLevel)
+            : graph(graph)
+            , file(filename)
+            , jio()
+            , asg(graph.getHeaderInfo("asg"))
+            , sarifSeverityLevelVal{
                 sarifSeverityLevel.find('1') != std::string::npos,
                 sarifSeverityLevel.find('2') != std::string::npos,
                 sarifSeverityLevel.find('3') != std::string::npos,
                 sarifSeverityLevel.find('4') != std::string::npos,
                 sarifSeverityLevel.find('5') != std::string::npos,
                 sarifSeverityLevel.find('c') != std::string::npos || sarifSeverityLevel.find('C') != std::string::npos
-            };
+            }
+            , ruleIndexesInJson()
+            , types()
+        {
+            jio.open(file.getBuffer());
 
-            SarifIO sio;
-            sio.open(filename, io::IOBase::eOpenMode::omWrite);
+            // adding every type of node, that possibly can have warning in it
+            types.insert(NTYPE_LIM_COMPONENT);
+            types.insert(NTYPE_LIM_MODULE);
+            types.insert(NTYPE_LIM_NAMESPACE);
+            types.insert(NTYPE_LIM_PACKAGE);
+            types.insert(NTYPE_LIM_ROOT);
+            types.insert(NTYPE_LIM_CLASS);
+            types.insert(NTYPE_LIM_STRUCTURE);
+            types.insert(NTYPE_LIM_UNION);
+            types.insert(NTYPE_LIM_INTERFACE);
+            types.insert(NTYPE_LIM_ENUM);
+            types.insert(NTYPE_LIM_ANNOTATION);
+            types.insert(NTYPE_LIM_SOURCEFILE);
+            types.insert(NTYPE_LIM_CLASSDEF);
+            types.insert(NTYPE_LIM_FUNCTION);
+            types.insert(NTYPE_LIM_METHOD);
+            types.insert(NTYPE_LIM_FUNCTIONMEMBER);
+            types.insert(NTYPE_LIM_PROCEDURE);
+            types.insert(NTYPE_LIM_FUNCTIONDEF);
+            types.insert(NTYPE_LIM_METHODDEF);
+            types.insert(NTYPE_LIM_ATTRIBUTE);
+            types.insert(NTYPE_LIM_FILE);
+            types.insert(NTYPE_DCF_CLONECLASS);
+            types.insert(NTYPE_RPG_SYSTEM);
+            types.insert(NTYPE_RPG_PROGRAM);
+            types.insert(NTYPE_RPG_MODULE);
+            types.insert(NTYPE_RPG_PROCEDURE);
+            types.insert(NTYPE_RPG_SUBROUTINE);
+            types.insert(NTYPE_DCF_CLONEINSTANCE);
+        }
 
+        SarifWriter::~SarifWriter() {
+        }
+
+        void SarifWriter::begin() {
             /*
-            * ----------------------------------------- README ------------------------------------------------------
-            * Json value as a root has been removed beacause it consumes too much memory
-            * For a 5GB graph in memory, the Json::Value consumes an extra 10GB, and memory overflow can occure...
-            * Json::Value as shown below works just fine, its performance is acceptable, and its usage is clear,
-            *     the only problem is memory consumption
-            * The "Json::Value root" has been replaced with sio.writeData(...) as an alternate solution to not store
-            *     the data unnecessarily in the memory, since this library (jsoncpp) does not have an option to dump
-            *     data constantly into a stream as we assign a value, we must resolve to a solution like this.
-            * I will leave this code here as a reference
-            * -------------------------------------------------------------------------------------------------------
+            * The document is written directly into the file with JsonIO, the values of the rules and the results are
+            * collected only one by one. Building the whole document as a Json::Value would need about twice the
+            * memory of the graph.
             */
+            jio.writeBeginObject();
+            jio.writeMember(SARIF_NAME_SCHEMA, SARIF_VALUE_SCHEMA);
+            jio.writeMember(SARIF_NAME_VERSION, SARIF_VALUE_VERSION);
+            jio.writeName(SARIF_NAME_RUNS);
+            jio.writeBeginArray();
+            jio.writeBeginObject();
+            jio.writeName(SARIF_NAME_TOOL);
+            jio.writeBeginObject();
+            jio.writeName(SARIF_NAME_DRIVER);
+            jio.writeBeginObject();
+            jio.writeMember(SARIF_NAME_NAME, SARIF_VALUE_NAME);
+            jio.writeMember(SARIF_NAME_LANG, SARIF_VALUE_LANG);
+            jio.writeMember(SARIF_NAME_VERSION, PROJECT_VERSION);
+            jio.writeMember(SARIF_NAME_DOWNLOADURI, SARIF_VALUE_DOWNURI);
+
+            writeRules();
+
+            jio.writeEndObject();
+            jio.writeEndObject();
+            jio.writeName(SARIF_NAME_RESULTS);
+            jio.writeBeginArray();
+        }
 
-            /*Json::Value root(Json::objectValue);
-            root[SARIF_NAME_VERSION] = SARIF_VALUE_VERSION;
-            root[SARIF_NAME_SCHEMA] = SARIF_VALUE_SCHEMA;
-            root[SARIF_NAME_RUNS] = Json::arrayValue;
-            root[SARIF_NAME_RUNS][0] = Json::objectValue;
-            root[SARIF_NAME_RUNS][0][SARIF_NAME_TOOL][SARIF_NAME_DRIVER][SARIF_NAME_NAME] = SARIF_VALUE_NAME;
-            root[SARIF_NAME_RUNS][0][SARIF_NAME_TOOL][SARIF_NAME_DRIVER][SARIF_NAME_LANG] = SARIF_VALUE_LANG;
-            root[SARIF_NAME_RUNS][0][SARIF_NAME_TOOL][SARIF_NAME_DRIVER][SARIF_NAME_VERSION] = PROJECT_VERSION;
-            root[SARIF_NAME_RUNS][0][SARIF_NAME_TOOL][SARIF_NAME_DRIVER][SARIF_NAME_DOWNLOADURI] = SARIF_VALUE_DOWNURI;
-            root[SARIF_NAME_RUNS][0][SARIF_NAME_TOOL][SARIF_NAME_DRIVER][SARIF_NAME_SEMVER] = SARIF_VALUE_SEMVER;
-            root[SARIF_NAME_RUNS][0][SARIF_NAME_RESULTS] = Json::arrayValue;*/
-
-            //quote a string
-            auto quoted = [](const std::string &str)->std::string {
-                return "\"" + str + "\"";
-            };
-            sio.writeData({
-                "{\n",
-                "  " + quoted(SARIF_NAME_SCHEMA) + " : " + quoted(SARIF_VALUE_SCHEMA) + ",\n",
-                "  " + quoted(SARIF_NAME_VERSION) + " : " + quoted(SARIF_VALUE_VERSION) + ",\n",
-                "  " + quoted(SARIF_NAME_RUNS) + " :\n",
-                "  [\n",
-                "    {\n",
-                "      " + quoted(SARIF_NAME_TOOL) + " :\n",
-                "      {\n",
-                "        " + quoted(SARIF_NAME_DRIVER) + " :\n",
-                "          {\n",
-                "            " + quoted(SARIF_NAME_NAME) + " : " + quoted(SARIF_VALUE_NAME) + ",\n",
-                "            " + quoted(SARIF_NAME_LANG) + " : "+ quoted(SARIF_VALUE_LANG) +",\n",
-                "            " + quoted(SARIF_NAME_VERSION) + " : " + quoted(PROJECT_VERSION) + ",\n",
-                "            " + quoted(SARIF_NAME_DOWNLOADURI) + " : " + quoted(SARIF_VALUE_DOWNURI) + ",\n",
-                "            " + quoted(SARIF_NAME_RULES) + " :\n",
-                "            [",
-            });
-
-
+        void SarifWriter::writeRules() {
             //Everything related to collect,write and store the rules from the graph
-            map<string, int> ruleIndexesInJson;
-            {
-                Node::NodeIterator ruleNodes = graph.findNodes(NTYPE_RUL_METRIC);
-                int ruleCounter = 0;
-                boost::filesystem::path full_path(boost::filesystem::current_path().parent_path());
-                full_path /= "UsersGuide.html";
-                bool userGuideExist = boost::filesystem::exists(full_path);
-                string fullPathString = full_path.generic_string();
-                fullPathString = uriFile + fullPathString;
-                if (userGuideExist) {
-                    sio.writeData("        \"" + SARIF_NAME_INFORMATION_URI + "\" : \"" + fullPathString + "\",\n");
+            Node::NodeIterator ruleNodes = graph.findNodes(NTYPE_RUL_METRIC);
+            int ruleCounter = 0;
+            boost::filesystem::path full_path(boost::filesystem::current_path().parent_path());
+            full_path /= "UsersGuide.html";
+            bool userGuideExist = boost::filesystem::exists(full_path);
+            string fullPathString = full_path.generic_string();
+            fullPathString = uriFile + fullPathString;
+            if (userGuideExist) {
+                jio.writeMember(SARIF_NAME_INFORMATION_URI, fullPathString);
+            }
+
+            jio.writeName(SARIF_NAME_RULES);
+            jio.writeBeginArray();
+
+            while (ruleNodes.hasNext()) {
+                const Node &ruleNode = ruleNodes.next();
+                const string &description = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_DESCRIPTION, CONTEXT_RUL).getStringValue();
+                const bool ruleParent = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_WARNING, CONTEXT_RUL).getStringValue() == "true";
+                const string &name = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_DISPLAYNAME, CONTEXT_RUL).getStringValue();
+
+                bool hasHelpText = componentHasNonRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_HELPTEXT, CONTEXT_RUL);
+                string helpText;
+                string GFMText;
+                if (hasHelpText) {
+                    helpText = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_HELPTEXT, CONTEXT_RUL).getStringValue();
+                    GFMText = htmlToGFM(helpText, asg);
                 }
 
-                while (ruleNodes.hasNext()) {
-                    const Node &ruleNode = ruleNodes.next();
-                    const string &description = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_DESCRIPTION, CONTEXT_RUL).getStringValue();
-                    const bool ruleParent = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_WARNING, CONTEXT_RUL).getStringValue() == "true";
+                const bool enabled = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_ENABLED, CONTEXT_RUL).getStringValue() == "true";
 
-                    Json::Value rule(Json::objectValue);
-                    rule[SARIF_NAME_ID] = ruleNode.getUID();
-                    rule[SARIF_NAME_NAME] = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_DISPLAYNAME, CONTEXT_RUL).getStringValue();
-                    if (description != "") {
-                        rule[SARIF_NAME_SHORTDESC][SARIF_NAME_TEXT] = description;
-                    }
+                if (!ruleParent) continue;
 
-                    if (componentHasNonRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_HELPTEXT, CONTEXT_RUL)) {
-                        const string &helpText = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_HELPTEXT, CONTEXT_RUL).getStringValue();
-                        string GFMText = htmlToGFM(helpText, asg);
-                        rule[SARIF_NAME_FULLDESC][SARIF_NAME_TEXT] = helpText;
-                        rule[SARIF_NAME_FULLDESC][SARIF_NAME_MARKDOWN] = GFMText;
-                    }
+                AttributeComposite &ruleAttribute = (AttributeComposite&)componentHasTheRequiredAttribute(ruleNode, Attribute::atComposite, ATTR_RUL_SETTINGS, CONTEXT_RUL);
 
-                    rule[SARIF_NAME_DEFCONF][SARIF_NAME_ENABLED] = componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_ENABLED, CONTEXT_RUL).getStringValue() == "true";
+                bool hasPriority = componentHasNonRequiredAttribute(ruleAttribute, Attribute::atString, ATTR_RUL_PRIORITY, CONTEXT_RUL);
+                string level;
+                int rank = 0;
+                if (hasPriority) {
+                    string priority = componentHasTheRequiredAttribute(ruleAttribute, Attribute::atString, ATTR_RUL_PRIORITY, CONTEXT_RUL).getStringValue();
+                    rank = (priority == "Info" ? 0 : (priority == "Minor" ? 1 : (priority == "Major" ? 2 : (priority == "Critical" ? 3 : 4))));
 
-                    if (ruleParent) {
-                        AttributeComposite &ruleAttribute = (AttributeComposite&)componentHasTheRequiredAttribute(ruleNode, Attribute::atComposite, ATTR_RUL_SETTINGS, CONTEXT_RUL);
+                    // if the severity of the result is not required to be converted, then the rule will not be saved
+                    AttributeComposite& attrCalc = (AttributeComposite&)componentHasTheRequiredAttribute(ruleNode, Attribute::atComposite, ATTR_RUL_CALCULATED, CONTEXT_RUL);
+                    if (componentHasNonRequiredAttribute(attrCalc, Attribute::atString, ATTR_RUL_CALCULATEDFOR, CONTEXT_RUL)) {
+                        string calcVal = componentHasTheRequiredAttribute(attrCalc, Attribute::atString, ATTR_RUL_CALCULATEDFOR, CONTEXT_RUL).getStringValue();
 
-                        if (componentHasNonRequiredAttribute(ruleAttribute, Attribute::atString, ATTR_RUL_PRIORITY, CONTEXT_RUL)) {
-                            string priority = componentHasTheRequiredAttribute(ruleAttribute, Attribute::atString, ATTR_RUL_PRIORITY, CONTEXT_RUL).getStringValue();
-                            int rank = (priority == "Info" ? 0 : (priority == "Minor" ? 1 : (priority == "Major" ? 2 : (priority == "Critical" ? 3 : 4))));
+                        if (calcVal == NTYPE_DCF_CLONEINSTANCE || calcVal == NTYPE_DCF_CLONECLASS) {
+                            rank = 5;
+                        }
+                    }
+                    if (!sarifSeverityLevelVal[rank]) continue;
 
-                            // if the severity of the result is not required to be converted, then the rule will not be saved
-                            AttributeComposite& attrCalc = (AttributeComposite&)componentHasTheRequiredAttribute(ruleNode, Attribute::atComposite, ATTR_RUL_CALCULATED, CONTEXT_RUL);
-                            if (componentHasNonRequiredAttribute(attrCalc, Attribute::atString, ATTR_RUL_CALCULATEDFOR, CONTEXT_RUL)) {
-                                string calcVal = componentHasTheRequiredAttribute(attrCalc, Attribute::atString, ATTR_RUL_CALCULATEDFOR, CONTEXT_RUL).getStringValue();
+                    level = (priority == "Info") ? SARIF_VALUE_PRIORITY::info : (priority == "Minor" || priority == "Major") ? SARIF_VALUE_PRIORITY::warning : SARIF_VALUE_PRIORITY::error;
+                }
 
-                                if (calcVal == NTYPE_DCF_CLONEINSTANCE || calcVal == NTYPE_DCF_CLONECLASS) {
-                                    rank = 5;
-                                }
-                            }
-                            if (!sarifSeverityLevelVal[rank]) continue;
+                bool hasParentName = componentHasNonRequiredAttribute(ruleAttribute, Attribute::atString, "metricName", CONTEXT_RUL);
+                string parentName;
+                if (hasParentName) {
+                    parentName = componentHasTheRequiredAttribute(ruleAttribute, Attribute::atString, "metricName", CONTEXT_RUL).getStringValue();
+                }
 
-                            priority = (priority == "Info") ? SARIF_VALUE_PRIORITY::info : (priority == "Minor" || priority == "Major") ? SARIF_VALUE_PRIORITY::warning : SARIF_VALUE_PRIORITY::error;
-                            rule[SARIF_NAME_DEFCONF][SARIF_NAME_LEVEL] = priority;
-                            rule[SARIF_NAME_DEFCONF][SARIF_NAME_RANK] = rank;
-                        }
+                if (componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_GROUPTYPE, CONTEXT_RUL).getStringValue() == "summarized" || !hasPriority || !enabled) {
+                    continue;
+                }
 
-                        if (componentHasNonRequiredAttribute(ruleAttribute, Attribute::atString, "metricName", CONTEXT_RUL)) {
-                            const string &parentName = componentHasTheRequiredAttribute(ruleAttribute, Attribute::atString, "metricName", CONTEXT_RUL).getStringValue();
-                            rule[SARIF_NAME_RELATIONS] = Json::arrayValue;
-                            rule[SARIF_NAME_RELATIONS][0][SARIF_NAME_TARGET][SARIF_NAME_ID] = parentName;
-                            rule[SARIF_NAME_RELATIONS][0][SARIF_NAME_KINDS][0] = "subset";
+                jio.writeBeginObject();
+                jio.writeName(SARIF_NAME_DEFCONF);
+                jio.writeBeginObject();
+                jio.writeMember(SARIF_NAME_ENABLED, enabled);
+                jio.writeMember(SARIF_NAME_LEVEL, level);
+                jio.writeMember(SARIF_NAME_RANK, rank);
+                jio.writeEndObject();
+                if (hasHelpText) {
+                    jio.writeName(SARIF_NAME_FULLDESC);
+                    jio.writeBeginObject();
+                    jio.writeMember(SARIF_NAME_MARKDOWN, GFMText);
+                    jio.writeMember(SARIF_NAME_TEXT, helpText);
+                    jio.writeEndObject();
+                }
+                if (userGuideExist) {
+                    jio.writeMember(SARIF_NAME_HELPURI, fullPathString + "#" + (hasParentName ? parentName : ruleNode.getUID()));
+                }
+                jio.writeMember(SARIF_NAME_ID, ruleNode.getUID());
+                jio.writeMember(SARIF_NAME_NAME, name);
+                if (hasParentName) {
+                    jio.writeName(SARIF_NAME_RELATIONS);
+                    jio.writeBeginArray();
+                    jio.writeBeginObject();
+                    jio.writeName(SARIF_NAME_KINDS);
+                    jio.writeBeginArray();
+                    jio.writeValue("subset");
+                    jio.writeEndArray();
+                    jio.writeName(SARIF_NAME_TARGET);
+                    jio.writeBeginObject();
+                    jio.writeMember(SARIF_NAME_ID, parentName);
+                    jio.writeEndObject();
+                    jio.writeEndObject();
+                    jio.writeEndArray();
+                }
+                if (description != "") {
+                    writeTextMember(jio, SARIF_NAME_SHORTDESC, description);
+                }
+                jio.writeEndObject();
 
-                            if (userGuideExist) {
-                                rule[SARIF_NAME_HELPURI] = fullPathString + "#" + parentName;
-                            }
-                        }
-                        else {
-                            if (userGuideExist) {
-                                rule[SARIF_NAME_HELPURI] = fullPathString + "#" + ruleNode.getUID();
-                            }
-                        }
-                    }
-                    else {
-                        continue;
+                ruleIndexesInJson.emplace(ruleNode.getUID(), ruleCounter);
+                common::updateMemoryStat();
+                ruleCounter++;
+            }
+            //If clone class is to be converted we add a custom (new) Rule, called customCloneClassId
+            if (sarifSeverityLevelVal[5]) {
+                jio.writeBeginObject();
+                jio.writeName(SARIF_NAME_DEFCONF);
+                jio.writeBeginObject();
+                jio.writeMember(SARIF_NAME_ENABLED, true);
+                jio.writeMember(SARIF_NAME_LEVEL, "note");
+                jio.writeMember(SARIF_NAME_RANK, 5);
+                jio.writeEndObject();
+                writeTextMember(jio, SARIF_NAME_FULLDESC, "Clone Class");
+                jio.writeMember(SARIF_NAME_ID, customCloneClassId);
+                jio.writeMember(SARIF_NAME_NAME, customCloneClassName);
+                jio.writeEndObject();
+
+                ruleIndexesInJson.emplace(customCloneClassId, ruleCounter);
+                ruleCounter++;
+            }
+
+            jio.writeEndArray();
+        }
+
+        void SarifWriter::writeNode(const Node &node) {
+            const Node::NodeType &type = node.getType();
+            if (types.find(type) == types.end())
+                return;
+
+            AttributeComposite::AttributeIterator attr = node.findAttributeByContext(CONTEXT_WARNING);
+            string smellType = SARIF_VALUE_BASELINE::NEW;
+
+            // CloneClass changes
+            // CloneClass handling, add extra rule: All CloneClasses
+            if (type == NTYPE_DCF_CLONECLASS && ruleIndexesInJson.find(customCloneClassId) != ruleIndexesInJson.end()) {
+                const string &name = componentHasTheRequiredAttribute(node, Attribute::atString, ATTR_NAME, CONTEXT_ATTRIBUTE).getStringValue();
+                Edge::EdgeIterator edges = node.findOutEdges(Edge::EdgeType(ETYPE_DCF_CLONETREE, Edge::edtDirectional));
+                string cloneInstanceSmellType;
+                string cloneClassSmellType = getSmellType(node);
+                bool changed = false;
+                int locationsCounter = 0;
+                vector<SarifLocation> locations;
+
+                // has to iterate through the clone instances again
+                while (edges.hasNext()) {
+                    // CloneInstance
+                    const Node &edgeNode = edges.next().getToNode();
+                    cloneInstanceSmellType = getSmellType(edgeNode);
+
+                    if (componentHasNonRequiredAttribute(edgeNode, Attribute::atComposite, ATTR_POSITION, CONTEXT_ATTRIBUTE)) {
+                        locations.push_back(readLocation(edgeNode));
+                        locations.back().description = componentHasTheRequiredAttribute(edgeNode, Attribute::atString, ATTR_NAME, CONTEXT_ATTRIBUTE).getStringValue() + " location";
                     }
-                    if (componentHasTheRequiredAttribute(ruleNode, Attribute::atString, ATTR_RUL_GROUPTYPE, CONTEXT_RUL).getStringValue() != "summarized" && !rule[SARIF_NAME_DEFCONF][SARIF_NAME_RANK].empty() && !rule[SARIF_NAME_DEFCONF][SARIF_NAME_LEVEL].empty() && !rule[SARIF_NAME_DEFCONF][SARIF_NAME_ENABLED].empty() && rule[SARIF_NAME_DEFCONF][SARIF_NAME_ENABLED].asString() == "true") {
-                        sio.writeData(rule, true);
-                        sio.writeData(",");
-                        ruleIndexesInJson.emplace(rule[SARIF_NAME_ID].asString(), ruleCounter);
-                        common::updateMemoryStat();
-                        ruleCounter++;
+                    if (cloneClassSmellType == "cstNone" && cloneInstanceSmellType != "cstNone") {
+                        smellType = SARIF_VALUE_BASELINE::UPDATED;
+                        changed = true;
                     }
+
+                    locationsCounter++;
                 }
-                //If clone class is to be converted we add a custom (new) Rule, called customCloneClassId
-                if (sarifSeverityLevelVal[5]) {
-                    Json::Value rule(Json::objectValue);
-                    rule[SARIF_NAME_ID] = customCloneClassId;
-                    rule[SARIF_NAME_NAME] = customCloneClassName;
-                    rule[SARIF_NAME_FULLDESC][SARIF_NAME_TEXT] = "Clone Class";
-                    rule[SARIF_NAME_DEFCONF][SARIF_NAME_ENABLED] = true;
-                    rule[SARIF_NAME_DEFCONF][SARIF_NAME_LEVEL] = "note";
-                    rule[SARIF_NAME_DEFCONF][SARIF_NAME_RANK] = 5;
-
-                    sio.writeData(rule);
-                    ruleIndexesInJson.emplace(rule[SARIF_NAME_ID].asString(), ruleCounter);
-                    ruleCounter++;
+                if (cloneClassSmellType == "cstAppearing") smellType = SARIF_VALUE_BASELINE::NEW;
+                else if (cloneClassSmellType == "cstDisappearing") smellType = SARIF_VALUE_BASELINE::ABSENT;
+                else if (!changed) smellType = SARIF_VALUE_BASELINE::UNCHANGED;
+
+                if (locationsCounter > 0) {
+                    jio.writeBeginObject();
+                    jio.writeMember(SARIF_NAME_BASE_LINE, smellType);
+                    jio.writeMember(SARIF_NAME_KIND, "pass");
+                    if (!locations.empty()) {
+                        writeLocations(jio, locations);
+                    }
+                    writeTextMember(jio, SARIF_NAME_MESSAGE, name);
+                    jio.writeMember(SARIF_NAME_OCCURED, locationsCounter);
+                    jio.writeMember(SARIF_NAME_RULEID, customCloneClassId);
+                    jio.writeMember(SARIF_NAME_RULEINDEX, ruleIndexesInJson.find(customCloneClassId)->second);
+                    jio.writeEndObject();
+                    common::updateMemoryStat();
                 }
             }
 
-            sio.writeData({
-                    "\n",
-                    "             ]\n",
-                    "         }\n",
-                    "      },\n",
-                    "      " + quoted(SARIF_NAME_RESULTS) + ":\n",
-                    "      ["
-                });
+            // Warning handling (simple warnings, CloneClass warnings, CloneInstance warning)
+            while (attr.hasNext()) {
+                AttributeComposite& attrComp = (AttributeComposite&)attr.next();
+                const string &warningID = attrComp.getName();
+                const string &messageTextTemp = componentHasTheRequiredAttribute(attrComp, Attribute::atString, ATTR_WARNINGTEXT, "").getStringValue();
 
-            Node::NodeTypeSet types;
+                // if the rule doesn't exist (becuase its not required by severity switch), then the current result will not be examined and will not be saved
+                map<string, int>::const_iterator ruleIndex = ruleIndexesInJson.find(warningID);
+                if (ruleIndex == ruleIndexesInJson.end()) continue;
 
-            // adding every type of node, that possibly can have warning in it
-            {
-                types.insert(NTYPE_LIM_COMPONENT);
-                types.insert(NTYPE_LIM_MODULE);
-                types.insert(NTYPE_LIM_NAMESPACE);
-                types.insert(NTYPE_LIM_PACKAGE);
-                types.insert(NTYPE_LIM_ROOT);
-                types.insert(NTYPE_LIM_CLASS);
-                types.insert(NTYPE_LIM_STRUCTURE);
-                types.insert(NTYPE_LIM_UNION);
-                types.insert(NTYPE_LIM_INTERFACE);
-                types.insert(NTYPE_LIM_ENUM);
-                types.insert(NTYPE_LIM_ANNOTATION);
-                types.insert(NTYPE_LIM_SOURCEFILE);
-                types.insert(NTYPE_LIM_CLASSDEF);
-                types.insert(NTYPE_LIM_FUNCTION);
-                types.insert(NTYPE_LIM_METHOD);
-                types.insert(NTYPE_LIM_FUNCTIONMEMBER);
-                types.insert(NTYPE_LIM_PROCEDURE);
-                types.insert(NTYPE_LIM_FUNCTIONDEF);
-                types.insert(NTYPE_LIM_METHODDEF);
-                types.insert(NTYPE_LIM_ATTRIBUTE);
-                types.insert(NTYPE_LIM_FILE);
-                types.insert(NTYPE_DCF_CLONECLASS);
-                types.insert(NTYPE_RPG_SYSTEM);
-                types.insert(NTYPE_RPG_PROGRAM);
-                types.insert(NTYPE_RPG_MODULE);
-                types.insert(NTYPE_RPG_PROCEDURE);
-                types.insert(NTYPE_RPG_SUBROUTINE);
-                types.insert(NTYPE_DCF_CLONEINSTANCE);
-            }
-
-            Node::NodeIterator allNodes = graph.findNodes(types);
-            bool comma = false;
-
-            // Goes through all the Nodes that has one of the Node type declared above
-            while (allNodes.hasNext()) {
-                const Node &node = allNodes.next();
-                const Node::NodeType &type = node.getType();
-                AttributeComposite::AttributeIterator attr = node.findAttributeByContext(CONTEXT_WARNING);
-                string smellType = SARIF_VALUE_BASELINE::NEW;
-
-                // CloneClass changes
-                // CloneClass handling, add extra rule: All CloneClasses
-                if (type == NTYPE_DCF_CLONECLASS && ruleIndexesInJson.find(customCloneClassId) != ruleIndexesInJson.end()) {
-                    Json::Value result;
-                    const string &name = componentHasTheRequiredAttribute(node, Attribute::atString, ATTR_NAME, CONTEXT_ATTRIBUTE).getStringValue();
+                vector<SarifLocation> locations;
+                // multiple location for the same result
+                if (type == NTYPE_DCF_CLONECLASS) {
                     Edge::EdgeIterator edges = node.findOutEdges(Edge::EdgeType(ETYPE_DCF_CLONETREE, Edge::edtDirectional));
-                    string cloneInstanceSmellType;
-                    string cloneClassSmellType = getSmellType(node);
-                    bool changed = false;
-                    int locationsCounter = 0;
 
-                    // has to iterate through the clone instances again
                     while (edges.hasNext()) {
                         // CloneInstance
-                        const Node &edgeNode = edges.next().getToNode();
-                        cloneInstanceSmellType = getSmellType(edgeNode);
+                        Node edgeNode = edges.next().getToNode();
 
                         if (componentHasNonRequiredAttribute(edgeNode, Attribute::atComposite, ATTR_POSITION, CONTEXT_ATTRIBUTE)) {
-                            Json::Value location;
-                            writeLocation(edgeNode, location);
-                            const string &name = componentHasTheRequiredAttribute(edgeNode, Attribute::atString, ATTR_NAME, CONTEXT_ATTRIBUTE).getStringValue();
-                            result[SARIF_NAME_LOCATIONS].append(location);
-                            result[SARIF_NAME_LOCATIONS][result[SARIF_NAME_LOCATIONS].size() - 1][SARIF_NAME_PHLOCATION][SARIF_NAME_ARTLOCATION][SARIF_NAME_DESCRIPTION][SARIF_NAME_TEXT] = name + " location";
-                        }
-                        if (cloneClassSmellType == "cstNone" && cloneInstanceSmellType != "cstNone") {
-                            smellType = SARIF_VALUE_BASELINE::UPDATED;
-                            changed = true;
+                            locations.push_back(readLocation(edgeNode));
+                            locations.back().description = componentHasTheRequiredAttribute(edgeNode, Attribute::atString, ATTR_NAME, CONTEXT_ATTRIBUTE).getStringValue() + " location";
                         }
-
-                        locationsCounter++;
-                    }
-                    if (cloneClassSmellType == "cstAppearing") smellType = SARIF_VALUE_BASELINE::NEW;
-                    else if (cloneClassSmellType == "cstDisappearing") smellType = SARIF_VALUE_BASELINE::ABSENT;
-                    else if (!changed) smellType = SARIF_VALUE_BASELINE::UNCHANGED;
-
-                    result[SARIF_NAME_RULEINDEX] = ruleIndexesInJson.find(customCloneClassId)->second;
-                    result[SARIF_NAME_BASE_LINE] = smellType;
-                    result[SARIF_NAME_RULEID] = customCloneClassId;
-                    if (locationsCounter > 0) {
-                        result[SARIF_NAME_KIND] = "pass";
-                        result[SARIF_NAME_OCCURED] = locationsCounter;
-                        result[SARIF_NAME_MESSAGE][SARIF_NAME_TEXT] = name;
-                        if (comma) sio.writeData(",");
-                        sio.writeData(result);
-                        comma = true;
-                        common::updateMemoryStat();
                     }
                 }
+                // only one location for the result / not a cloneclass
+                else {
+                    locations.push_back(readLocation(attrComp));
+                }
+                if (locations.empty()) continue; // if there is a cloneclass that has no valid instance (eg. the Instance is cstDisappearing)
+
+                // if the node has traceCallBack attribute
+                vector<SarifThreadFlowLocation> threadFlowLocations;
+                if (componentHasNonRequiredAttribute(attrComp, Attribute::atComposite, ATTR_EXTRAINFO, CONTEXT_TRACE)) {
+                    AttributeComposite& attrExtraInfo = (AttributeComposite&)componentHasTheRequiredAttribute(attrComp, Attribute::atComposite, ATTR_EXTRAINFO, CONTEXT_TRACE);
+                    AttributeComposite::AttributeIterator attrItr = attrExtraInfo.findAttribute(Attribute::atComposite, ATTR_SOURCELINK, "");
+
+                    while (attrItr.hasNext()) {
+                        AttributeComposite& attrTraceComp = (AttributeComposite&)attrItr.next();
+                        SarifThreadFlowLocation threadFlowLocation;
 
-                // Warning handling (simple warnings, CloneClass warnings, CloneInstance warning)
-                while (attr.hasNext()) {
-                    AttributeComposite& attrComp = (AttributeComposite&)attr.next();
-                    const string &warningID = attrComp.getName();
-                    Json::Value result = Json::objectValue;
-                    const string &messageTextTemp = componentHasTheRequiredAttribute(attrComp, Attribute::atString, ATTR_WARNINGTEXT, "").getStringValue();
-                    int locationCounter = 0;
-
-                    // if the rule doesn't exist (becuase its not required by severity switch), then the current result will not be examined and will not be saved
-                    if (ruleIndexesInJson.find(warningID) == ruleIndexesInJson.end()) continue;
-
-                    // multiple location for the same result
-                    if (type == NTYPE_DCF_CLONECLASS) {
-                        Edge::EdgeIterator edges = node.findOutEdges(Edge::EdgeType(ETYPE_DCF_CLONETREE, Edge::edtDirectional));
-
-                        while (edges.hasNext()) {
-                            // CloneInstance
-                            Node edgeNode = edges.next().getToNode();
-
-                            if (componentHasNonRequiredAttribute(edgeNode, Attribute::atComposite, ATTR_POSITION, CONTEXT_ATTRIBUTE)) {
-                                Json::Value location;
-                                writeLocation(edgeNode, location);
-                                const string &name = componentHasTheRequiredAttribute(edgeNode, Attribute::atString, ATTR_NAME, CONTEXT_ATTRIBUTE).getStringValue();
-                                result[SARIF_NAME_LOCATIONS][locationCounter] = location;
-                                result[SARIF_NAME_LOCATIONS][locationCounter][SARIF_NAME_PHLOCATION][SARIF_NAME_ARTLOCATION][SARIF_NAME_DESCRIPTION][SARIF_NAME_TEXT] = name + " location";
-                                locationCounter++;
-                            }
+                        threadFlowLocation.location = readLocation(attrTraceComp);
+                        threadFlowLocation.location.uri = boost::filesystem::path(uriFile + componentHasTheRequiredAttribute(attrTraceComp, Attribute::atString, ATTR_PATH, "").getStringValue()).generic_string();
+
+                        // Add warningText or RoleName as threadflow message
+                        threadFlowLocation.hasMessage = true;
+                        if (componentHasNonRequiredAttribute(attrTraceComp, Attribute::atString, ATTR_WARNINGTEXT, "")) {
+                            threadFlowLocation.message = ((AttributeString&)componentHasTheRequiredAttribute(attrTraceComp, Attribute::atString, ATTR_WARNINGTEXT, "")).getStringValue();
                         }
-                    }
-                    // only one location for the result / not a cloneclass
-                    else {
-                        Json::Value location;
-                        writeLocation(attrComp, location);
-                        result[SARIF_NAME_LOCATIONS][locationCounter] = location;
-                        locationCounter++;
-                    }
-                    if (locationCounter == 0) continue; // if there is a cloneclass that has no valid instance (eg. the Instance is cstDisappearing)
-
-                    // if the node has traceCallBack attribute
-                    if (componentHasNonRequiredAttribute(attrComp, Attribute::atComposite, ATTR_EXTRAINFO, CONTEXT_TRACE)) {
-                        AttributeComposite& attrExtraInfo = (AttributeComposite&)componentHasTheRequiredAttribute(attrComp, Attribute::atComposite, ATTR_EXTRAINFO, CONTEXT_TRACE);
-                        AttributeComposite::AttributeIterator attrItr = attrExtraInfo.findAttribute(Attribute::atComposite, ATTR_SOURCELINK, "");
-                        int executionOrder = 0;
-
-                        while (attrItr.hasNext()) {
-                            AttributeComposite& attrTraceComp = (AttributeComposite&)attrItr.next();
-                            Json::Value location(Json::objectValue);
-
-                            writeLocation(attrTraceComp, location);
-
-                            result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_EXECUTIONORDER] = executionOrder;
-                            result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_THREADFLOWLOCATION] = location;
-                            result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_IMPORTANCE] = SARIF_VALUE_IMPORTANCE::ESSENTIAL;
-
-                            const string path = boost::filesystem::path(uriFile + componentHasTheRequiredAttribute(attrTraceComp, Attribute::atString, ATTR_PATH, "").getStringValue()).generic_string();
-                            result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_THREADFLOWLOCATION][SARIF_NAME_PHLOCATION][SARIF_NAME_ARTLOCATION][SARIF_NAME_URI] = path;
-
-                            // Add warningText or RoleName as threadflow message
-                            if (componentHasNonRequiredAttribute(attrTraceComp, Attribute::atString, ATTR_WARNINGTEXT, "")) {
-                                const string &warningText = ((AttributeString&)componentHasTheRequiredAttribute(attrTraceComp, Attribute::atString, ATTR_WARNINGTEXT, "")).getStringValue();
-                                result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_THREADFLOWLOCATION][SARIF_NAME_MESSAGE][SARIF_NAME_TEXT] = warningText;
-                            }
-                            else if (componentHasNonRequiredAttribute(attrTraceComp, Attribute::atString, "RoleName", "")) {
-                                const string &warningText = ((AttributeString&)componentHasTheRequiredAttribute(attrTraceComp, Attribute::atString, "RoleName", "")).getStringValue();
-                                result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_THREADFLOWLOCATION][SARIF_NAME_MESSAGE][SARIF_NAME_TEXT] = warningText;
-                            }
-
-                            if (componentHasNonRequiredAttribute(attrTraceComp, Attribute::atInt, ATTR_CALLSTACKDEPTH, "")) {
-                                const int callStackDepth = ((AttributeInt&)componentHasTheRequiredAttribute(attrTraceComp, Attribute::atInt, ATTR_CALLSTACKDEPTH, "")).getValue();
-                                result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_NESTINGLEVEL] = callStackDepth;
-                            }
-                            else {
-                                result[SARIF_NAME_CODEFLOWS][0][SARIF_NAME_THREADFLOWS][0][SARIF_NAME_LOCATIONS][executionOrder][SARIF_NAME_NESTINGLEVEL] = 0;
-                            }
-
-                            executionOrder++;
+                        else if (componentHasNonRequiredAttribute(attrTraceComp, Attribute::atString, "RoleName", "")) {
+                            threadFlowLocation.message = ((AttributeString&)componentHasTheRequiredAttribute(attrTraceComp, Attribute::atString, "RoleName", "")).getStringValue();
+                        }
+                        else {
+                            threadFlowLocation.hasMessage = false;
                         }
-                    }
 
-                    result[SARIF_NAME_MESSAGE][SARIF_NAME_TEXT] = messageTextTemp;
-                    result[SARIF_NAME_RULEINDEX] = ruleIndexesInJson.find(warningID)->second;
-                    result[SARIF_NAME_BASE_LINE] = smellType;
-                    result[SARIF_NAME_OCCURED] = locationCounter;
-                    result[SARIF_NAME_RULEID] = warningID;
-                    result[SARIF_NAME_KIND] = "pass";
+                        if (componentHasNonRequiredAttribute(attrTraceComp, Attribute::atInt, ATTR_CALLSTACKDEPTH, "")) {
+                            threadFlowLocation.nestingLevel = ((AttributeInt&)componentHasTheRequiredAttribute(attrTraceComp, Attribute::atInt, ATTR_CALLSTACKDEPTH, "")).getValue();
+                        }
+                        else {
+                            threadFlowLocation.nestingLevel = 0;
+                        }
 
-                    if (comma) sio.writeData(",");
-                    sio.writeData(result);
-                    comma = true;
-                    common::updateMemoryStat();
+                        threadFlowLocations.push_back(threadFlowLocation);
+                    }
                 }
 
+                jio.writeBeginObject();
+                jio.writeMember(SARIF_NAME_BASE_LINE, smellType);
+                if (!threadFlowLocations.empty()) {
+                    writeCodeFlows(jio, threadFlowLocations);
+                }
+                jio.writeMember(SARIF_NAME_KIND, "pass");
+                writeLocations(jio, locations);
+                writeTextMember(jio, SARIF_NAME_MESSAGE, messageTextTemp);
+                jio.writeMember(SARIF_NAME_OCCURED, static_cast<int>(locations.size()));
+                jio.writeMember(SARIF_NAME_RULEID, warningID);
+                jio.writeMember(SARIF_NAME_RULEINDEX, ruleIndex->second);
+                jio.writeEndObject();
+                common::updateMemoryStat();
             }
-            
-            sio.writeData({
-                "\n",
-                "      ]\n",
-                "    }\n",
-                "  ]\n",
-                "}" 
-            });
+        }
+
+        void SarifWriter::end() {
+            jio.writeEndArray();
+            jio.writeEndObject();
+            jio.writeEndArray();
+            jio.writeEndObject();
+            jio.close();
+            file.close();
 
             common::updateMemoryStat();
         }
+
+        void exportToSarif(Graph & graph, const std::string & filename, const string & sarifSeverityLevel)
+        {
+            GraphExporter exporter(graph);
+            exporter.addWriter(unique_ptr<GraphExportWriter>(new SarifWriter(graph, filename, sarifSeverityLevel)));
+            exporter.run();
+        }
     }
 }
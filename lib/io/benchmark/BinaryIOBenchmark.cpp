@@ -0,0 +1,95 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+/**
+* \file BinaryIOBenchmark.cpp
+* \brief Measures the throughput of the primitive reads/writes of BinaryIO and ZippedIO.
+*
+* Usage: BinaryIOBenchmark [temporary file] [number of values]
+*/
+
+#include <cstdio>
+#include <string>
+
+#include <io/inc/IO.h>
+#include "Benchmark.h"
+#include "Exception.h"
+
+using namespace std;
+using namespace columbus;
+using columbus::benchmark::measure;
+
+namespace {
+
+  template <class IOType>
+  void run(const char* name, const string& filename, size_t count) {
+    string prefix = string(name) + " ";
+
+    measure((prefix + "writeUInt4").c_str(), count * 4 / 1e6, "MB", [&]() {
+      IOType out(filename, io::IOBase::omWrite);
+      for (size_t i = 0; i < count; ++i)
+        out.writeUInt4((unsigned)i);
+      out.close();
+      return (unsigned long long)count;
+    });
+
+    measure((prefix + "readUInt4").c_str(), count * 4 / 1e6, "MB", [&]() {
+      IOType in(filename, io::IOBase::omRead);
+      unsigned long long sum = 0;
+      for (size_t i = 0; i < count; ++i)
+        sum += in.readUInt4();
+      return sum;
+    });
+
+    measure((prefix + "writeULongLong8").c_str(), count * 8 / 1e6, "MB", [&]() {
+      IOType out(filename, io::IOBase::omWrite);
+      for (size_t i = 0; i < count; ++i)
+        out.writeULongLong8(i);
+      out.close();
+      return (unsigned long long)count;
+    });
+
+    measure((prefix + "readULongLong8").c_str(), count * 8 / 1e6, "MB", [&]() {
+      IOType in(filename, io::IOBase::omRead);
+      unsigned long long sum = 0;
+      for (size_t i = 0; i < count; ++i)
+        sum += in.readULongLong8();
+      return sum;
+    });
+  }
+
+}
+
+int main(int argc, char* argv[]) {
+  string filename = argc > 1 ? argv[1] : "BinaryIOBenchmark.tmp";
+  size_t count = argc > 2 ? stoul(argv[2]) : 16 * 1024 * 1024;
+
+  try {
+    run<io::BinaryIO>("binary", filename, count);
+    run<io::ZippedIO>("zipped", filename, count);
+  } catch (const Exception& e) {
+    fprintf(stderr, "%s\n", e.getMessage().c_str());
+    remove(filename.c_str());
+    return 1;
+  }
+
+  remove(filename.c_str());
+  return 0;
+}
@@ -22,6 +22,9 @@
 #define BINARYIOIO_H
 
 #include <io/inc/ioBase.h>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 /**
 * \file BinaryIO.h
@@ -30,6 +33,13 @@
 
 namespace columbus {  namespace io {
 
+  /**
+  * \brief Binary reader/writer.
+  *
+  * The data is read and written in blocks through an internal buffer, so the primitive
+  * read/write methods are inline and touch the underlying stream only when the buffer
+  * runs out (or is full).
+  */
   class BinaryIO : virtual public IOBase{
     public:
       /**
@@ -79,14 +89,37 @@ namespace columbus {  namespace io {
       * \param toError [in] if it is true, stream is open to stderr, otherwise stdout
       */
       BinaryIO(bool toError);
-      
+
+      /**
+      * \brief destructor, writes out the buffered data
+      */
+      virtual ~BinaryIO();
+
+      /**
+      * \brief writes out the buffered data and closes the opened file
+      * \throw IOException if can't close the file
+      */
+      virtual void close() override;
+
+      /**
+      * \brief writes out the buffered data and flushes the stream
+      * \throw IOException if the file is not open
+      */
+      virtual void flush() override;
+
+      /**
+      * \brief check whether all of the data is read
+      * \throw IOException if the file is not open
+      */
+      virtual bool eof() override;
+
       /**
       * \brief Writes a boolean on 1 byte to the file.
       * \param b [in] output value
       * \throw IOException if the writing is failed.
       * \throw IOException if the open mode isn't write
       */
-      virtual void writeBool1(bool b);
+      void writeBool1(bool b);
 
       /**
       * \brief Reads 1 byte into a bool from the file.
@@ -94,7 +127,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual bool readBool1();
+      bool readBool1();
 
       /**
       * \brief Writes an unsigned charater on 1 byte to the file.
@@ -102,7 +135,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeUByte1(unsigned char b);
+      void writeUByte1(unsigned char b);
 
       /**
       * \brief Reads 1 byte into an unsigned char from the file.
@@ -110,7 +143,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual unsigned char readUByte1();
+      unsigned char readUByte1();
 
       /**
       * \brief Writes an charater on 1 byte to the file.
@@ -118,7 +151,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeByte1(char b);
+      void writeByte1(char b);
 
       /**
       * \brief Reads 1 byte into a char from the file.
@@ -126,7 +159,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual char readByte1();
+      char readByte1();
       
       /**
       * \brief Writes an unsigned short on 2 byte to the file.
@@ -134,7 +167,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeUShort2(unsigned short i);
+      void writeUShort2(unsigned short i);
 
       /**
       * \brief Reads 2 byte into an unsigned short from the file.
@@ -142,7 +175,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual unsigned short readUShort2();
+      unsigned short readUShort2();
 
       /**
       * \brief Writes a short on 2 byte to the file.
@@ -150,7 +183,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeShort2(short i);
+      void writeShort2(short i);
 
       /**
       * \brief Reads 2 byte into a short from the file.
@@ -158,7 +191,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual short readShort2();
+      short readShort2();
 
       /**
       * \brief Writes an unsigned integer on 4 byte to the file.
@@ -166,7 +199,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeUInt4(unsigned i);
+      void writeUInt4(unsigned i);
 
       /**
       * \brief Reads 4 byte into an unsigned integer from the file.
@@ -174,7 +207,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual unsigned readUInt4();
+      unsigned readUInt4();
       
       /**
       * \brief Writes an integer on 4 byte to the file.
@@ -182,7 +215,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeInt4(int i);
+      void writeInt4(int i);
 
       /**
       * \brief Reads 4 byte into an integer from the file.
@@ -190,7 +223,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual int readInt4();
+      int readInt4();
 
       /**
       * \brief Writes a long long on 8 byte to the file.
@@ -198,7 +231,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeLongLong8(long long i);
+      void writeLongLong8(long long i);
 
       /**
       * \brief Reads 8 byte into a long long from the file.
@@ -206,7 +239,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual long long readLongLong8();
+      long long readLongLong8();
 
       /**
       * \brief Writes an unsigned long long on 8 byte to the file.
@@ -214,7 +247,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeULongLong8(unsigned long long i);
+      void writeULongLong8(unsigned long long i);
 
       /**
       * \brief Reads 8 byte into an unsigned long long from the file.
@@ -222,7 +255,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual unsigned long long readULongLong8();
+      unsigned long long readULongLong8();
 
       /**
       * \brief Writes a double on 8 byte to the file.
@@ -230,7 +263,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeDouble8(double d);
+      void writeDouble8(double d);
 
       /**
       * \brief Reads 8 byte into a double from the file.
@@ -238,7 +271,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual double readDouble8();
+      double readDouble8();
 
             /**
       * \brief Writes a long double on 16 byte to the file.
@@ -309,7 +342,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the writing is failed.
       * \throw IOExceotion if the open mode isn't write
       */
-      virtual void writeFloat4(float f);
+      void writeFloat4(float f);
 
       /**
       * \brief Reads 4 byte into a float from the file.
@@ -317,7 +350,7 @@ namespace columbus {  namespace io {
       * \throw IOException if the reading is failed.
       * \throw IOExceotion if the open mode isn't read
       */
-      virtual float readFloat4();
+      float readFloat4();
 
       /**
       * \brief Writes a void* on 'size' byte to the file.
@@ -337,6 +370,26 @@ namespace columbus {  namespace io {
       */
       virtual void readData (void* data, std::streamsize size);
 
+      /**
+      * \brief Writes 'count' arithmetic values (at most 8 byte long each) from a contiguous array to the file.
+      * \param data [in] pointer to the first element
+      * \param count [in] the number of the elements
+      * \throw IOException if the writing is failed.
+      * \throw IOExceotion if the open mode isn't write
+      */
+      template <typename T>
+      void writeArray(const T* data, std::size_t count);
+
+      /**
+      * \brief Reads 'count' arithmetic values (at most 8 byte long each) from the file into a contiguous array.
+      * \param data [out] pointer to the first element
+      * \param count [in] the number of the elements
+      * \throw IOException if the reading is failed.
+      * \throw IOExceotion if the open mode isn't read
+      */
+      template <typename T>
+      void readArray(T* data, std::size_t count);
+
       virtual void setEndianState(EndianType endianState);
 
       virtual EndianType getEndianState();
@@ -349,6 +402,12 @@ namespace columbus {  namespace io {
 
       virtual void setStartWritePosition( std::streampos& startPos );
 
+      /**
+      * \brief gives back the current position in the file
+      * \throw IOException if the file is not open
+      */
+      virtual std::streampos getPosition();
+
     private:
 
       /**
@@ -358,12 +417,75 @@ namespace columbus {  namespace io {
 
       virtual void testLocalEndian();
 
-      virtual void write(const char* data, const std::streampos size);
-      virtual void read(char* data, const std::streampos size);
+      /**
+      * \brief writes the data directly to the underlying stream
+      */
+      virtual void write(const char* data, const std::streamsize size);
+
+      /**
+      * \brief reads at most 'size' bytes directly from the underlying stream
+      * \return the number of the read bytes, which is less than 'size' only at the end of the stream
+      */
+      virtual std::streamsize read(char* data, const std::streamsize size);
+
       virtual void seekg(std::streamoff off, std::ios_base::seekdir way = std::ios_base::beg);
       virtual void seekp(std::streamoff off, std::ios_base::seekdir way = std::ios_base::beg);
       virtual std::streampos tellg();
-      virtual void get(std::streambuf& sb, char delim);
+
+      /**
+      * \brief slow path of the reading, refills the buffer as many times as needed
+      */
+      void readBuffered(char* data, std::size_t size);
+
+      /**
+      * \brief slow path of the writing, writes out the buffer as many times as needed
+      */
+      void writeBuffered(const char* data, std::size_t size);
+
+      /**
+      * \brief refills the read buffer
+      * \return false if there is no more data
+      */
+      bool refillReadBuffer();
+
+      void checkReadMode() const;
+      void checkWriteMode() const;
+
+      template <typename T>
+      static T byteSwap(T value);
+
+      template <typename T>
+      T readValue();
+
+      template <typename T>
+      void writeValue(T value);
+
+  protected:
+      /**
+      * \brief reads the next block from the stream into the read buffer
+      * \return false if there is no more data
+      */
+      virtual bool fillReadBuffer();
+
+      /**
+      * \brief drops the read buffer and moves the position of the stream back to the first unread byte
+      */
+      virtual void discardReadBuffer();
+
+      /**
+      * \brief writes the content of the write buffer to the stream
+      */
+      void flushWriteBuffer();
+
+      /**
+      * \brief flushes the write buffer and drops the read buffer, after that the position of the stream is the logical position
+      */
+      void syncBuffers();
+
+      /**
+      * \brief reads at most 'size' bytes from the given stream, the end of the stream isn't an error
+      */
+      static std::streamsize readAvailable(std::istream& in, char* data, std::streamsize size);
 
   protected:
       // 2 byte
@@ -399,8 +521,176 @@ namespace columbus {  namespace io {
         double d;
         long double ld;
       } alltype;
+
+      /** \brief size of the read/write buffer */
+      static const std::size_t ioBufferSize = 64 * 1024;
+
+      std::unique_ptr<char[]> ioBuffer;
+
+      /** \brief the unread part of the read buffer (both are nullptr if there is no read buffer) */
+      const char* readPos;
+      const char* readEnd;
+
+      /** \brief the free part of the write buffer (both are nullptr if there is no write buffer) */
+      char* writePos;
+      char* writeEnd;
+
+      /** \brief the last refill reached the end of the stream */
+      bool endOfInput;
+
+      /** \brief cached endianState != localEndianState */
+      bool swapBytes;
   };
 
+  template <typename T>
+  inline T BinaryIO::byteSwap(T value) {
+    if (sizeof(T) > 1) {
+      unsigned char bytes[sizeof(T)];
+      std::memcpy(bytes, &value, sizeof(T));
+      for (std::size_t i = 0; i < sizeof(T) / 2; ++i) {
+        unsigned char tmp = bytes[i];
+        bytes[i] = bytes[sizeof(T) - 1 - i];
+        bytes[sizeof(T) - 1 - i] = tmp;
+      }
+      std::memcpy(&value, bytes, sizeof(T));
+    }
+    return value;
+  }
+
+  template <typename T>
+  inline T BinaryIO::readValue() {
+    T value;
+    if (static_cast<std::size_t>(readEnd - readPos) >= sizeof(T)) {
+      std::memcpy(&value, readPos, sizeof(T));
+      readPos += sizeof(T);
+    } else {
+      readBuffered(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+    return swapBytes ? byteSwap(value) : value;
+  }
+
+  template <typename T>
+  inline void BinaryIO::writeValue(T value) {
+    if (swapBytes)
+      value = byteSwap(value);
+    if (static_cast<std::size_t>(writeEnd - writePos) >= sizeof(T)) {
+      std::memcpy(writePos, &value, sizeof(T));
+      writePos += sizeof(T);
+    } else {
+      writeBuffered(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+  }
+
+  template <typename T>
+  inline void BinaryIO::writeArray(const T* data, std::size_t count) {
+    static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "writeArray supports only arithmetic types");
+    if (!swapBytes || sizeof(T) == 1) {
+      writeBuffered(reinterpret_cast<const char*>(data), count * sizeof(T));
+    } else {
+      checkWriteMode();
+      for (std::size_t i = 0; i < count; ++i)
+        writeValue(data[i]);
+    }
+  }
+
+  template <typename T>
+  inline void BinaryIO::readArray(T* data, std::size_t count) {
+    static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "readArray supports only arithmetic types");
+    readBuffered(reinterpret_cast<char*>(data), count * sizeof(T));
+    if (swapBytes && sizeof(T) > 1) {
+      for (std::size_t i = 0; i < count; ++i)
+        data[i] = byteSwap(data[i]);
+    }
+  }
+
+  inline void BinaryIO::writeBool1(bool b) {
+    writeValue<char>(b ? 1 : 0);
+  }
+
+  inline bool BinaryIO::readBool1() {
+    return readValue<char>() == 1;
+  }
+
+  inline void BinaryIO::writeUByte1(unsigned char b) {
+    writeValue(b);
+  }
+
+  inline unsigned char BinaryIO::readUByte1() {
+    return readValue<unsigned char>();
+  }
+
+  inline void BinaryIO::writeByte1(char b) {
+    writeValue(b);
+  }
+
+  inline char BinaryIO::readByte1() {
+    return readValue<char>();
+  }
+
+  inline void BinaryIO::writeUShort2(unsigned short i) {
+    writeValue(i);
+  }
+
+  inline unsigned short BinaryIO::readUShort2() {
+    return readValue<unsigned short>();
+  }
+
+  inline void BinaryIO::writeShort2(short i) {
+    writeValue(i);
+  }
+
+  inline short BinaryIO::readShort2() {
+    return readValue<short>();
+  }
+
+  inline void BinaryIO::writeUInt4(unsigned i) {
+    writeValue(i);
+  }
+
+  inline unsigned BinaryIO::readUInt4() {
+    return readValue<unsigned>();
+  }
+
+  inline void BinaryIO::writeInt4(int i) {
+    writeValue(i);
+  }
+
+  inline int BinaryIO::readInt4() {
+    return readValue<int>();
+  }
+
+  inline void BinaryIO::writeLongLong8(long long i) {
+    writeValue(i);
+  }
+
+  inline long long BinaryIO::readLongLong8() {
+    return readValue<long long>();
+  }
+
+  inline void BinaryIO::writeULongLong8(unsigned long long i) {
+    writeValue(i);
+  }
+
+  inline unsigned long long BinaryIO::readULongLong8() {
+    return readValue<unsigned long long>();
+  }
+
+  inline void BinaryIO::writeDouble8(double d) {
+    writeValue(d);
+  }
+
+  inline double BinaryIO::readDouble8() {
+    return readValue<double>();
+  }
+
+  inline void BinaryIO::writeFloat4(float f) {
+    writeValue(f);
+  }
+
+  inline float BinaryIO::readFloat4() {
+    return readValue<float>();
+  }
+
 
 }}
 
@@ -24,8 +24,10 @@
 #include <io/inc/ioBase.h>
 #include <io/inc/BinaryIO.h>
 #include <io/inc/ZippedIO.h>
+#include <io/inc/MappedIO.h>
 #include <io/inc/CsvIO.h>
 #include <io/inc/SimpleXmlIO.h>
+#include <io/inc/JsonIO.h>
 #include <io/inc/GraphmlIO.h>
 
 #endif
@@ -0,0 +1,176 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef JsonIO_H
+#define JsonIO_H
+
+#include <io/inc/ioBase.h>
+#include <vector>
+
+/**
+* \file JsonIO.h
+* \brief Contains JsonIO declaration
+*/
+
+namespace columbus {  namespace io {
+
+  /**
+  * \brief writes a JSON document directly to the stream
+  *
+  * Unlike the Json::Value of jsoncpp, nothing is built in the memory: the values are written as they come, so the
+  * size of the output is not limited by the memory. The separators and the indentation are written automatically.
+  */
+  class JsonIO : virtual public IOBase {
+
+    private:
+      // an opened object or array
+      struct Scope {
+        bool object;
+        bool empty;
+      };
+
+      std::vector<Scope> scopes; // the opened objects and arrays
+      bool afterName;            // a member name is written, its value comes next
+      std::string indentation;   // written once for every level of depth
+
+      void putIndentation(); // put a new line and the indentation of the current depth
+      void beginValue();     // write the separator before a value
+      void beginScope(bool object);
+      void endScope(bool object);
+
+      template<class Value>
+      void writeValueByTemplate(Value value);
+
+    public:
+
+      /**
+      * \brief constructor, create empty JsonIO object
+      */
+      JsonIO();
+
+      /**
+      * \brief create a JsonIO object and open a file
+      * \param filename [in] file name
+      * \param mode [in] open mode (it can be only omWrite)
+      * \throw IOException if open is failed
+      * \throw IOException wrong open mode
+      */
+      JsonIO(const std::string& filename, IOBase::eOpenMode mode);
+
+      /**
+      * \brief destructor
+      */
+      ~JsonIO();
+
+      /**
+      * \brief set the string written for every level of depth (two spaces by default)
+      * \param indentation [in] the indentation
+      */
+      void setIndentation(const std::string& indentation);
+
+      /**
+      * \brief write the beginning of an object ({)
+      * \throw IOException if the writing is failed.
+      * \throw IOException if the object is a member of an object and its name is not written
+      */
+      void writeBeginObject();
+
+      /**
+      * \brief write the end of the innermost opened object (})
+      * \throw IOException if the writing is failed.
+      * \throw IOException if no object is opened or the last member name has no value
+      */
+      void writeEndObject();
+
+      /**
+      * \brief write the beginning of an array ([)
+      * \throw IOException if the writing is failed.
+      * \throw IOException if the array is a member of an object and its name is not written
+      */
+      void writeBeginArray();
+
+      /**
+      * \brief write the end of the innermost opened array (])
+      * \throw IOException if the writing is failed.
+      * \throw IOException if no array is opened
+      */
+      void writeEndArray();
+
+      /**
+      * \brief write the name of the next member of the opened object ("name" : )
+      * \param name [in] the member name
+      * \throw IOException if the writing is failed.
+      * \throw IOException if the innermost scope is not an object or the last name has no value yet
+      */
+      void writeName(const std::string& name);
+
+      /**
+      * \brief write a value to the opened array or after a member name
+      * \param value [in] the value
+      * \throw IOException if the writing is failed.
+      * \throw IOException if the value is a member of an object and its name is not written
+      */
+      void writeValue(const std::string& value);
+
+      /**
+      * \brief write a value to the opened array or after a member name
+      */
+      void writeValue(const char* value);
+
+      /**
+      * \brief write a value to the opened array or after a member name
+      */
+      void writeValue(bool value);
+
+      /**
+      * \brief write a value to the opened array or after a member name
+      */
+      void writeValue(int value);
+
+      /**
+      * \brief write a value to the opened array or after a member name
+      */
+      void writeValue(long long value);
+
+      /**
+      * \brief write a value to the opened array or after a member name (the non-finite values are written as null)
+      */
+      void writeValue(double value);
+
+      /**
+      * \brief write a member with a simple value to the opened object ("name" : value)
+      * \param name [in] the member name
+      * \param value [in] the value
+      */
+      template<class Value>
+      void writeMember(const std::string& name, const Value& value) {
+        writeName(name);
+        writeValue(value);
+      }
+
+      /**
+      * \brief close the opened objects and arrays and close the file
+      */
+      void close();
+  };
+
+}}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef MAPPEDIO_H
+#define MAPPEDIO_H
+
+#include <io/inc/BinaryIO.h>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+/**
+* \file MappedIO.h
+* \brief Contains MappedIO declaration
+*/
+
+namespace columbus {  namespace io {
+
+  /**
+  * \brief Read only BinaryIO which memory maps the whole file instead of reading it through a file stream.
+  *
+  * The content of the file can be accessed directly (getData()) and the read position can be moved
+  * to any offset in constant time (seek()), so the data can be read in arbitrary order.
+  */
+  class MappedIO : virtual public BinaryIO {
+    public:
+
+      /**
+      * \brief constructor, creates an empty MappedIO object
+      */
+      MappedIO();
+
+      /**
+      * \brief creates a MappedIO object and maps the given file
+      * \param filename [in] file name
+      * \throw IOException if the mapping is failed
+      */
+      MappedIO(const std::string& filename);
+
+      /**
+      * \brief destructor, unmaps the file
+      */
+      virtual ~MappedIO();
+
+      /**
+      * \brief maps the given file (only reading is supported)
+      * \param filename [in] file name
+      * \throw IOException if the mapping is failed
+      */
+      virtual void open(const std::string& filename);
+
+      /**
+      * \brief unmaps the file
+      */
+      virtual void close() override;
+
+      /**
+      * \brief gives back the pointer to the beginning of the mapped content
+      */
+      const char* getData() const;
+
+      /**
+      * \brief gives back the size of the mapped content
+      */
+      std::size_t getSize() const;
+
+      /**
+      * \brief moves the read position to the given offset
+      * \param offset [in] the offset from the beginning of the file
+      * \throw IOException if the offset is outside of the file
+      */
+      void seek(std::size_t offset);
+
+      /**
+      * \brief gives back the read position (the offset from the beginning of the file)
+      * \throw IOException if no file is mapped
+      */
+      std::size_t tell();
+
+    protected:
+
+      /**
+      * \brief the rest of the mapping is used as read buffer, so nothing is copied
+      */
+      virtual bool fillReadBuffer() override;
+
+    private:
+
+      /**
+      * \internal \brief read only stream buffer over the mapped memory
+      */
+      class MemoryBuffer : public std::streambuf {
+        public:
+          MemoryBuffer(const char* data, std::size_t size);
+        protected:
+          virtual pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which) override;
+          virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+      };
+
+      boost::iostreams::mapped_file_source mapping;
+      std::unique_ptr<MemoryBuffer> buffer;
+  };
+
+}}
+
+#endif
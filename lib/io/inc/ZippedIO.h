@@ -36,15 +36,26 @@ namespace columbus {  namespace io {
         ZippedIO(const std::string& filename, IOBase::eOpenMode mode, bool zipped = true);
         ZippedIO(const char *filename, IOBase::eOpenMode mode, bool zipped = true);
 
+        /**
+        * \brief destructor, writes the buffered data into the filter stream before it is destroyed
+        */
+        virtual ~ZippedIO();
+
         virtual void setZip(bool zipmode);
 
     private:
 
         void addCompressorFilter();
 
-        virtual void write(const char* data, const std::streampos size) override;
-        virtual void read(char* data, const std::streampos size) override;
-        virtual void get(std::streambuf& sb, char delim) override;
+        virtual void write(const char* data, const std::streamsize size) override;
+        virtual std::streamsize read(char* data, const std::streamsize size) override;
+
+    protected:
+
+        /**
+        * \brief drops the read buffer, the position of the stream is moved back only if the file is not zipped
+        */
+        virtual void discardReadBuffer() override;
 
 
     public:
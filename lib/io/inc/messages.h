@@ -27,12 +27,15 @@
 #define CMSG_EX_OPEN_STREAMBUF       "Cannot open streambuffer"
 #define CMSG_EX_OPEN_ZIPPED_MODE     "Cannot open ZippedIO with not zipped mode"
 #define CMSG_EX_OPEN_XML_ONLY_WRITE  "You can open SimpleXmlIO only for writing"
+#define CMSG_EX_OPEN_JSON_ONLY_WRITE "You can open JsonIO only for writing"
 
 // file exceptions
 #define CMSG_EX_FILE_NOT_OPEN        "File is not open"
 #define CMSG_EX_FILE_READ_ONLY       "File is opened only for reading"
 #define CMSG_EX_FILE_WRITE_ONLY      "File is opened only for writing"
 #define CMSG_EX_FILE_ZIPPED          "The opened file is zipped"
+#define CMSG_EX_SEEK_OUT_OF_RANGE    "The position is outside of the file"
+#define CMSG_EX_UNEXPECTED_END_OF_FILE "Unexpected end of file"
 
 // xml exceptions
 #define CMSG_EX_XML_DECLARATION_TOP  "XML declaration can be writen only to the top of the file"
@@ -42,6 +45,11 @@
 #define CMSG_EX_XML_WRONG_TAG        "Wrong tag format"
 #define CMSG_EX_XML_WRONG_TAG_FORMAT "Wrong tag format : "
 
+// json exceptions
+#define CMSG_EX_JSON_NAME_EXPECTED   "The members of a JSON object must have a name"
+#define CMSG_EX_JSON_VALUE_EXPECTED  "The name of a JSON member must be followed by a value"
+#define CMSG_EX_JSON_SCOPE_NOT_FOUND "Opened JSON object or array is not found"
+
 // misc exceptions
 #define CMSG_EX_WRONG_SIZE           "Wrong type size"
 #define CMSG_EX_TOO_LONG_STRING      "The string length is greater than 65535"
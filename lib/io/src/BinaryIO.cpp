@@ -19,6 +19,7 @@
  */
 
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 #include <io/inc/BinaryIO.h>
@@ -108,7 +109,14 @@ namespace columbus {  namespace io {
     IOBase(OperationMode::binary),
     localEndianState(),
     endianState(),
-    blockSizePosition(0)
+    blockSizePosition(0),
+    ioBuffer(),
+    readPos(nullptr),
+    readEnd(nullptr),
+    writePos(nullptr),
+    writeEnd(nullptr),
+    endOfInput(false),
+    swapBytes(false)
   {
     testSizes();
     testLocalEndian();
@@ -118,7 +126,14 @@ namespace columbus {  namespace io {
     IOBase(OperationMode::binary),
     localEndianState(),
     endianState(),
-    blockSizePosition(0)
+    blockSizePosition(0),
+    ioBuffer(),
+    readPos(nullptr),
+    readEnd(nullptr),
+    writePos(nullptr),
+    writeEnd(nullptr),
+    endOfInput(false),
+    swapBytes(false)
   {
     testSizes();
     testLocalEndian();
@@ -129,7 +144,14 @@ namespace columbus {  namespace io {
     IOBase(OperationMode::binary),
     localEndianState(),
     endianState(),
-    blockSizePosition(0)
+    blockSizePosition(0),
+    ioBuffer(),
+    readPos(nullptr),
+    readEnd(nullptr),
+    writePos(nullptr),
+    writeEnd(nullptr),
+    endOfInput(false),
+    swapBytes(false)
   {
     testSizes();
     testLocalEndian();
@@ -140,428 +162,276 @@ namespace columbus {  namespace io {
     IOBase(OperationMode::binary),
     localEndianState(),
     endianState(),
-    blockSizePosition(0)
+    blockSizePosition(0),
+    ioBuffer(),
+    readPos(nullptr),
+    readEnd(nullptr),
+    writePos(nullptr),
+    writeEnd(nullptr),
+    endOfInput(false),
+    swapBytes(false)
   {
     testSizes();
     testLocalEndian();
     open(toError);
   }
 
-  void BinaryIO::writeBool1(bool b) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-
-    char c = b ? 1 : 0;
+  BinaryIO::~BinaryIO() {
     try {
-      write(&c, 1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+      if (stream != nullptr)
+        flushWriteBuffer();
+    } catch (...) {
     }
   }
 
-  bool BinaryIO::readBool1() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    char b = 0;
-    try {
-      read(&b, 1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return b == 1;
+  void BinaryIO::close() {
+    if (stream != nullptr)
+      flushWriteBuffer();
+    readPos = readEnd = nullptr;
+    endOfInput = false;
+    IOBase::close();
   }
 
-  void BinaryIO::writeUByte1(unsigned char b) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      write((const char*)&b, 1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+  void BinaryIO::flush() {
+    if (stream != nullptr)
+      flushWriteBuffer();
+    IOBase::flush();
   }
 
-  unsigned char BinaryIO::readUByte1() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    char b;
-    try {
-      read(&b, 1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return b;
+  bool BinaryIO::eof() {
+    if (readPos != readEnd)
+      return false;
+    if (endOfInput)
+      return true;
+    return IOBase::eof();
   }
 
-  void BinaryIO::writeByte1(char b) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      write(&b, 1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-  }
-
-  char BinaryIO::readByte1() {
+  void BinaryIO::checkReadMode() const {
     if( !((mode == omRead) || (mode == omReadWrite)) ) 
       throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    char b;
-    try {
-      read(&b, 1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return b;    
   }
 
-  void BinaryIO::writeUShort2(unsigned short i) {
+  void BinaryIO::checkWriteMode() const {
     if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
       throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      endianSwap2(i);
-      write((const char*)&i,2);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
   }
 
-  unsigned short BinaryIO::readUShort2() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    unsigned short s;
-    try {
-      read((char*)&s,2);
-      endianSwap2(s);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return s;
-  }
+  bool BinaryIO::fillReadBuffer() {
+    if (!ioBuffer)
+      ioBuffer = make_unique<char[]>(ioBufferSize);
 
-  void BinaryIO::writeShort2(short i) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      endianSwap2(*(reinterpret_cast<unsigned short*>(&i)));
-      write((const char*)&i,2);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    streamsize size = read(ioBuffer.get(), ioBufferSize);
+    readPos = ioBuffer.get();
+    readEnd = readPos + size;
+    endOfInput = size < (streamsize)ioBufferSize;
+    return size > 0;
   }
 
-  short BinaryIO::readShort2() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    short s;
-    try {
-      read((char*)&s,2);
-      endianSwap2(*(reinterpret_cast<unsigned short*>(&s)));
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return s;
+  void BinaryIO::discardReadBuffer() {
+    streamoff unread = readEnd - readPos;
+    readPos = readEnd = nullptr;
+    endOfInput = false;
+    if (unread > 0)
+      stream->seekg(-unread, ios_base::cur);
   }
 
-  void BinaryIO::writeUInt4(unsigned i) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      endianSwap4(i);
-      write( (char*)&i, 4);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-  }
+  void BinaryIO::flushWriteBuffer() {
+    if (writePos == nullptr)
+      return;
 
-  unsigned BinaryIO::readUInt4() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    unsigned u;
-    try {
-      read((char*)&u,4);
-      endianSwap4(u);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+    streamsize size = writePos - ioBuffer.get();
+    writePos = writeEnd = nullptr;
+    if (size > 0) {
+      try {
+        write(ioBuffer.get(), size);
+      } catch(const exception& fail) {
+        throw IOException(COLUMBUS_LOCATION, fail.what());
+      }
     }
-    return u;
   }
 
-  void BinaryIO::writeInt4(int i) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      endianSwap4(*(reinterpret_cast<unsigned int*>(&i)));
-      write( (char*)&i, 4);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+  void BinaryIO::syncBuffers() {
+    flushWriteBuffer();
+    if (readPos != nullptr) {
+      try {
+        discardReadBuffer();
+      } catch(const exception& fail) {
+        throw IOException(COLUMBUS_LOCATION, fail.what());
+      }
     }
   }
 
-  int BinaryIO::readInt4() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    int i;
+  streamsize BinaryIO::readAvailable(istream& in, char* data, streamsize size) {
     try {
-      read((char*)&i,4);
-      endianSwap4(*(reinterpret_cast<unsigned int*>(&i)));
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+      in.read(data, size);
+    } catch(const ios_base::failure&) {
+      // reaching the end of the stream sets the failbit too, which is not an error here
+      if (!in.eof() || in.bad())
+        throw;
     }
-    return i;
+    streamsize count = in.gcount();
+    if (in.eof())
+      in.clear();
+    return count;
   }
 
-  void BinaryIO::writeLongLong8(long long i) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
+  bool BinaryIO::refillReadBuffer() {
+    flushWriteBuffer();
     try {
-      endianSwap8(*(reinterpret_cast<unsigned long long*>(&i)));
-      write( (char*)&i, 8);
+      return fillReadBuffer();
     } catch(const exception& fail) {
       throw IOException(COLUMBUS_LOCATION, fail.what());
     }
   }
 
-  long long BinaryIO::readLongLong8() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    long long ll;
-    try {
-      read((char*)&ll,8);
-      endianSwap8(*(reinterpret_cast<unsigned long long*>(&ll)));
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+  void BinaryIO::readBuffered(char* data, size_t size) {
+    checkReadMode();
+    while (true) {
+      size_t available = readEnd - readPos;
+      if (size <= available) {
+        if (size > 0) {
+          memcpy(data, readPos, size);
+          readPos += size;
+        }
+        return;
+      }
+      if (available > 0) {
+        memcpy(data, readPos, available);
+        data += available;
+        size -= available;
+        readPos = readEnd;
+      }
+      if (!refillReadBuffer())
+        throw IOException(COLUMBUS_LOCATION, CMSG_EX_UNEXPECTED_END_OF_FILE);
     }
-    return ll;
   }
 
-  void BinaryIO::writeULongLong8(unsigned long long i) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      endianSwap8(i);
-      write( (char*)&i, 8);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-  }
+  void BinaryIO::writeBuffered(const char* data, size_t size) {
+    checkWriteMode();
+    if (readPos != nullptr)
+      syncBuffers();
 
-  unsigned long long BinaryIO::readULongLong8() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    unsigned long long ll;
-    try {
-      read((char*)&ll,8);
-      endianSwap8(ll);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return ll;
-  }
+    while (true) {
+      size_t room = writeEnd - writePos;
+      if (size <= room) {
+        if (size > 0) {
+          memcpy(writePos, data, size);
+          writePos += size;
+        }
+        return;
+      }
 
-  void BinaryIO::writeDouble8(double d) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      alltype x;
-      x.d = d;
-      endianSwap8(x.ull);
-      write( (char*)&x.ull, 8);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-  }
+      if (writePos == nullptr) {
+        if (!ioBuffer)
+          ioBuffer = make_unique<char[]>(ioBufferSize);
+        writePos = ioBuffer.get();
+        writeEnd = writePos + ioBufferSize;
+        continue;
+      }
 
-  double BinaryIO::readDouble8() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    alltype x;
-    try {
-      read((char*)&x.ull,8);
-      endianSwap8(x.ull);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+      memcpy(writePos, data, room);
+      writePos += room;
+      data += room;
+      size -= room;
+      flushWriteBuffer();
+
+      // large blocks are written directly instead of copying them through the buffer
+      if (size >= ioBufferSize) {
+        try {
+          write(data, size);
+        } catch(const exception& fail) {
+          throw IOException(COLUMBUS_LOCATION, fail.what());
+        }
+        return;
+      }
     }
-    return x.d;
   }
 
   void  BinaryIO::writeLongDouble16(long double d){
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      alltype x;
-      x.d = d;
-      endianSwap16(x.ld);
-      write( (char*)&x.ull, 16);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    alltype x;
+    memset(&x, 0, sizeof(x));
+    x.d = d;
+    endianSwap16(x.ld);
+    writeBuffered((const char*)x.bytes, 16);
   }
 
   long double  BinaryIO::readLongDouble16(){
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
     alltype x;
-    try {
-      read((char*)&x.ld,16);
-      endianSwap16(x.ld);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    readBuffered((char*)x.bytes, 16);
+    endianSwap16(x.ld);
     return x.d;
   }
 
   void BinaryIO::writeShortString(const string& s) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      size_t size =  s.size();
-      
-      if (size > 0xFFFF)
-        throw IOException(COLUMBUS_LOCATION, CMSG_EX_TOO_LONG_STRING);
-      unsigned short writeSize = (unsigned short)size;
+    checkWriteMode();
+    size_t size =  s.size();
 
-      writeShort2((short)size);
-      write(s.c_str(), writeSize);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    if (size > 0xFFFF)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_TOO_LONG_STRING);
 
+    writeShort2((short)size);
+    writeBuffered(s.data(), size);
   }
 
   const string BinaryIO::readShortString() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    try {
-      char* buffer;
-      unsigned short size = readShort2();
-
-      buffer = (char*)malloc(size);
-      if (!buffer)
-        throw IOException(COLUMBUS_LOCATION, CMSG_EX_MEMORY_ALLOCATION);
-        
-      read(buffer, size);
-      
-      string str;
-      str.assign(buffer, size);
-      free(buffer);
-      return str;
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    string str;
+    readShortString(str);
+    return str;
   }
 
   void BinaryIO::readShortString(string& s) {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    try {
-      char* buffer;
-      unsigned short size = readShort2();
-
-      buffer = (char*)malloc(size);
-      if (!buffer)
-        throw IOException(COLUMBUS_LOCATION, CMSG_EX_MEMORY_ALLOCATION);
-        
-      read(buffer, size);
-      s.assign(buffer, size);
-      free(buffer);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+    checkReadMode();
+    unsigned short size = readShort2();
+    if ((size_t)(readEnd - readPos) >= size) {
+      s.assign(readPos, size);
+      readPos += size;
+    } else {
+      s.resize(size);
+      readBuffered(&s[0], size);
     }
   }
 
   void BinaryIO::writeString(const string& s) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    size_t len = s.size();
-    try {
-      write(s.c_str(),(streamsize)len+1);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    // the terminating '\0' is written too
+    writeBuffered(s.c_str(), s.size() + 1);
   }
 
-
-
   void BinaryIO::readString(string& s) {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    try {
-      stringbuf ss;
-      get(ss,'\0');
-      // read string end 0
-      char zero;
-      read(&zero, 1);
-      s = ss.str();
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
+    checkReadMode();
+    s.clear();
+    while (true) {
+      if (readPos != readEnd) {
+        const char* zero = (const char*)memchr(readPos, '\0', readEnd - readPos);
+        if (zero != nullptr) {
+          s.append(readPos, zero);
+          readPos = zero + 1;
+          return;
+        }
+        s.append(readPos, readEnd);
+        readPos = readEnd;
+      }
+      if (!refillReadBuffer())
+        throw IOException(COLUMBUS_LOCATION, CMSG_EX_UNEXPECTED_END_OF_FILE);
     }
   }
 
-
   const string BinaryIO::readString() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    try {
-      stringbuf ss;
-      get(ss,'\0');
-      // read string end 0
-      char zero;
-      read(&zero, 1);
-      return ss.str();
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    string s;
+    readString(s);
+    return s;
   }
 
   void BinaryIO::writeData(const void* data, streamsize size) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      write((char*)data, size);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
+    writeBuffered((const char*)data, (size_t)size);
   }
 
   void BinaryIO::readData(void* data, streamsize size) {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    try {
-      read((char*)data,size);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-  }
-
-  void BinaryIO::writeFloat4(float f) {
-    if( !((mode == omWrite) || (mode == omReadWrite) || (mode == omAppend)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_READ_ONLY);
-    try {
-      alltype x;
-      x.f = f;
-      endianSwap4(x.u);
-      write( (char*)&x.u, 4);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-  }
-
-  float BinaryIO::readFloat4() {
-    if( !((mode == omRead) || (mode == omReadWrite)) ) 
-      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_WRITE_ONLY);
-    alltype x;
-    try {
-      read((char*)&x.u,4);
-      endianSwap4(x.u);
-    } catch(const exception& fail) {
-      throw IOException(COLUMBUS_LOCATION, fail.what());
-    }
-    return x.f;
+    readBuffered((char*)data, (size_t)size);
   }
 
   void BinaryIO::setEndianState(EndianType endianState) {
     this->endianState = endianState;
+    swapBytes = endianState != localEndianState;
   }
 
   BinaryIO::EndianType BinaryIO::getEndianState() {
@@ -575,6 +445,10 @@ namespace columbus {  namespace io {
   }
 
   void BinaryIO::skipNext(streamsize length) {
+    if (length >= 0 && length <= readEnd - readPos) {
+      readPos += length;
+      return;
+    }
     seekg(length,ios_base::cur);
   }
 
@@ -618,41 +492,44 @@ namespace columbus {  namespace io {
     seekp(startPos - curPos,ios_base::cur);
   }
 
-  void BinaryIO::write(const char* data, const streampos size) {
+  streampos BinaryIO::getPosition() {
+    if(!stream) {
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_NOT_OPEN);
+    }
+    return tellg();
+  }
+
+  void BinaryIO::write(const char* data, const streamsize size) {
     // There is deliberately no nullptr pointer check as it is used only internally
     // from the write methods, which already checks it.
     stream->write(data, size);
   }
 
-  void BinaryIO::read(char* data, const streampos size) {
+  streamsize BinaryIO::read(char* data, const streamsize size) {
     // There is deliberately no nullptr pointer check as it is used only internally
     // from the read methods, which already checks it.
-    stream->read(data, size);
+    return readAvailable(*stream, data, size);
   }
 
   void BinaryIO::seekg(streamoff off, ios_base::seekdir way) {
     // There is deliberately no nullptr pointer check as it is used only internally
     // from the read methods, which already checks it.
+    syncBuffers();
     stream->seekg(off, way);
   }
 
   void BinaryIO::seekp(streamoff off, ios_base::seekdir way) {
     // There is deliberately no nullptr pointer check as it is used only internally
     // from the write methods, which already checks it.
+    syncBuffers();
     stream->seekp(off, way);
   }
 
   streampos BinaryIO::tellg() {
     // There is deliberately no nullptr pointer check as it is used only internally
     // from the read methods, which already checks it.
-    return stream->tellg();
-  }
-
-  void BinaryIO::get(streambuf& sb, char delim) {
-    // There is deliberately no nullptr pointer check as it is used only internally
-    // from the read methods, which already checks it.
-    stream->get(sb, delim);
+    flushWriteBuffer();
+    return stream->tellg() - streamoff(readEnd - readPos);
   }
 
 }}
-
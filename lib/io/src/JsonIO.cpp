@@ -0,0 +1,258 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <io/inc/JsonIO.h>
+#include <io/inc/messages.h>
+#include "Exception.h"
+
+using namespace std;
+
+
+namespace columbus {  namespace io {
+
+  static void writeJsonString(iostream& stream, const char* value, size_t length) {
+    static const char hexDigits[] = "0123456789abcdef";
+    stream << '"';
+    const char* begin = value;
+    const char* end = value + length;
+    for (const char* c = value; c != end; ++c) {
+      const char* escaped = nullptr;
+      switch (*c) {
+        case '"':  escaped = "\\\""; break;
+        case '\\': escaped = "\\\\"; break;
+        case '\b': escaped = "\\b";  break;
+        case '\f': escaped = "\\f";  break;
+        case '\n': escaped = "\\n";  break;
+        case '\r': escaped = "\\r";  break;
+        case '\t': escaped = "\\t";  break;
+        default:
+          if (static_cast<unsigned char>(*c) >= 0x20)
+            continue;
+          break;
+      }
+      stream.write(begin, c - begin);
+      if (escaped) {
+        stream << escaped;
+      } else {
+        const char code[] = { '\\', 'u', '0', '0', hexDigits[(*c >> 4) & 0xF], hexDigits[*c & 0xF] };
+        stream.write(code, sizeof(code));
+      }
+      begin = c + 1;
+    }
+    stream.write(begin, end - begin);
+    stream << '"';
+  }
+
+  JsonIO::JsonIO() :
+    IOBase(OperationMode::text),
+    scopes(),
+    afterName(false),
+    indentation("  ")
+  {
+  }
+
+  JsonIO::JsonIO(const string& filename, eOpenMode mode) :
+    IOBase(OperationMode::text),
+    scopes(),
+    afterName(false),
+    indentation("  ")
+  {
+    if (mode != IOBase::omWrite)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_OPEN_JSON_ONLY_WRITE);
+    open(filename, mode);
+  }
+
+  JsonIO::~JsonIO() {
+    try {
+      close();
+    } catch (const exception&) {
+      // the destructor must not throw
+    }
+  }
+
+  void JsonIO::setIndentation(const string& indentation) {
+    this->indentation = indentation;
+  }
+
+  void JsonIO::putIndentation() {
+    *stream << '\n';
+    for (size_t i = 0; i < scopes.size(); ++i)
+      *stream << indentation;
+  }
+
+  void JsonIO::beginValue() {
+    if (afterName) {
+      afterName = false;
+      return;
+    }
+    if (scopes.empty())
+      return;
+
+    Scope& scope = scopes.back();
+    if (scope.object)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_JSON_NAME_EXPECTED);
+    if (!scope.empty)
+      *stream << ',';
+    scope.empty = false;
+    putIndentation();
+  }
+
+  void JsonIO::beginScope(bool object) {
+    try {
+      beginValue();
+      *stream << (object ? '{' : '[');
+      scopes.push_back(Scope{object, true});
+    } catch (const IOException&) {
+      throw;
+    } catch (const exception& fail) {
+      throw IOException(COLUMBUS_LOCATION, fail.what());
+    }
+  }
+
+  void JsonIO::endScope(bool object) {
+    if (scopes.empty() || scopes.back().object != object)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_JSON_SCOPE_NOT_FOUND);
+    if (afterName)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_JSON_VALUE_EXPECTED);
+    try {
+      bool empty = scopes.back().empty;
+      scopes.pop_back();
+      if (!empty)
+        putIndentation();
+      *stream << (object ? '}' : ']');
+      if (scopes.empty())
+        *stream << '\n';
+    } catch (const exception& fail) {
+      throw IOException(COLUMBUS_LOCATION, fail.what());
+    }
+  }
+
+  void JsonIO::writeBeginObject() {
+    beginScope(true);
+  }
+
+  void JsonIO::writeEndObject() {
+    endScope(true);
+  }
+
+  void JsonIO::writeBeginArray() {
+    beginScope(false);
+  }
+
+  void JsonIO::writeEndArray() {
+    endScope(false);
+  }
+
+  void JsonIO::writeName(const string& name) {
+    if (scopes.empty() || !scopes.back().object)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_JSON_SCOPE_NOT_FOUND);
+    if (afterName)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_JSON_VALUE_EXPECTED);
+    try {
+      Scope& scope = scopes.back();
+      if (!scope.empty)
+        *stream << ',';
+      scope.empty = false;
+      putIndentation();
+      writeJsonString(*stream, name.c_str(), name.size());
+      *stream << " : ";
+      afterName = true;
+    } catch (const exception& fail) {
+      throw IOException(COLUMBUS_LOCATION, fail.what());
+    }
+  }
+
+  template<class Value>
+  void JsonIO::writeValueByTemplate(Value value) {
+    try {
+      beginValue();
+      *stream << value;
+    } catch (const IOException&) {
+      throw;
+    } catch (const exception& fail) {
+      throw IOException(COLUMBUS_LOCATION, fail.what());
+    }
+  }
+
+  void JsonIO::writeValue(const string& value) {
+    try {
+      beginValue();
+      writeJsonString(*stream, value.c_str(), value.size());
+    } catch (const IOException&) {
+      throw;
+    } catch (const exception& fail) {
+      throw IOException(COLUMBUS_LOCATION, fail.what());
+    }
+  }
+
+  void JsonIO::writeValue(const char* value) {
+    try {
+      beginValue();
+      writeJsonString(*stream, value, strlen(value));
+    } catch (const IOException&) {
+      throw;
+    } catch (const exception& fail) {
+      throw IOException(COLUMBUS_LOCATION, fail.what());
+    }
+  }
+
+  void JsonIO::writeValue(bool value) {
+    writeValueByTemplate(value ? "true" : "false");
+  }
+
+  void JsonIO::writeValue(int value) {
+    writeValueByTemplate(value);
+  }
+
+  void JsonIO::writeValue(long long value) {
+    writeValueByTemplate(value);
+  }
+
+  void JsonIO::writeValue(double value) {
+    if (!isfinite(value)) {
+      writeValueByTemplate("null");
+      return;
+    }
+
+    // the same format as the one of jsoncpp: 17 significant digits and a decimal point at least
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer) - 2, "%.17g", value);
+    if (strpbrk(buffer, ".eE") == nullptr) {
+      buffer[length++] = '.';
+      buffer[length++] = '0';
+      buffer[length] = 0;
+    }
+    writeValueByTemplate(static_cast<const char*>(buffer));
+  }
+
+  void JsonIO::close() {
+    if (stream == nullptr)
+      return;
+    afterName = false;
+    while (!scopes.empty())
+      endScope(scopes.back().object);
+    IOBase::close();
+  }
+
+}}
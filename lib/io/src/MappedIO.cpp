@@ -0,0 +1,136 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include <io/inc/MappedIO.h>
+#include <io/inc/messages.h>
+#include "Exception.h"
+
+using namespace std;
+
+namespace columbus {  namespace io {
+
+  MappedIO::MemoryBuffer::MemoryBuffer(const char* data, size_t size) {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+
+  streambuf::pos_type MappedIO::MemoryBuffer::seekoff(off_type off, ios_base::seekdir way, ios_base::openmode which) {
+    if (!(which & ios_base::in))
+      return pos_type(off_type(-1));
+
+    off_type base;
+    switch (way) {
+      case ios_base::beg:
+        base = 0;
+        break;
+      case ios_base::cur:
+        base = gptr() - eback();
+        break;
+      default:
+        base = egptr() - eback();
+        break;
+    }
+
+    off_type target = base + off;
+    if (target < 0 || target > egptr() - eback())
+      return pos_type(off_type(-1));
+
+    setg(eback(), eback() + target, egptr());
+    return pos_type(target);
+  }
+
+  streambuf::pos_type MappedIO::MemoryBuffer::seekpos(pos_type pos, ios_base::openmode which) {
+    return seekoff(off_type(pos), ios_base::beg, which);
+  }
+
+  MappedIO::MappedIO() : BinaryIO(), mapping(), buffer() {
+  }
+
+  MappedIO::MappedIO(const string& filename) : BinaryIO(), mapping(), buffer() {
+    open(filename);
+  }
+
+  MappedIO::~MappedIO() {
+    close();
+  }
+
+  void MappedIO::open(const string& filename) {
+    close();
+    try {
+      mapping.open(filename);
+    } catch (const exception&) {
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_OPEN_FILE + filename);
+    }
+    if (!mapping.is_open())
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_OPEN_FILE + filename);
+
+    buffer = make_unique<MemoryBuffer>(mapping.data(), mapping.size());
+    BinaryIO::open(buffer.get());
+    mode = omRead;
+  }
+
+  void MappedIO::close() {
+    BinaryIO::close();
+    buffer.reset();
+    if (mapping.is_open())
+      mapping.close();
+  }
+
+  const char* MappedIO::getData() const {
+    return mapping.is_open() ? mapping.data() : nullptr;
+  }
+
+  size_t MappedIO::getSize() const {
+    return mapping.is_open() ? mapping.size() : 0;
+  }
+
+  void MappedIO::seek(size_t offset) {
+    if (!buffer)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_NOT_OPEN);
+    if (offset > mapping.size())
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_SEEK_OUT_OF_RANGE);
+    readPos = readEnd = nullptr;
+    endOfInput = false;
+    stream->clear();
+    buffer->pubseekpos(streampos(offset), ios_base::in);
+  }
+
+  size_t MappedIO::tell() {
+    if (!buffer)
+      throw IOException(COLUMBUS_LOCATION, CMSG_EX_FILE_NOT_OPEN);
+    // the read buffer is always the rest of the mapping
+    if (readPos)
+      return (size_t)(readPos - mapping.data());
+    return (size_t)buffer->pubseekoff(0, ios_base::cur, ios_base::in);
+  }
+
+  bool MappedIO::fillReadBuffer() {
+    size_t offset = (size_t)buffer->pubseekoff(0, ios_base::cur, ios_base::in);
+    if (offset >= mapping.size())
+      return false;
+
+    readPos = mapping.data() + offset;
+    readEnd = mapping.data() + mapping.size();
+    endOfInput = true;
+    buffer->pubseekoff(0, ios_base::end, ios_base::in);
+    return true;
+  }
+
+}}
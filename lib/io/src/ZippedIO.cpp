@@ -43,6 +43,14 @@ namespace columbus {  namespace io {
         open(filename, mode, zipped);
     }
 
+    ZippedIO::~ZippedIO() {
+        try {
+            if (filterstream != nullptr)
+                flushWriteBuffer();
+        } catch (...) {
+        }
+    }
+
     void ZippedIO::open(const string& filename, eOpenMode mode, bool zipped) {
         if (!(mode == omRead || mode == omWrite || mode == omAppend))
             throw IOException(COLUMBUS_LOCATION, CMSG_EX_OPEN_ZIPPED_MODE);
@@ -78,6 +86,7 @@ namespace columbus {  namespace io {
             return;
 
         try {
+            flushWriteBuffer();
             filterstream->strict_sync();
             delete filterstream.release();
             BinaryIO::close();
@@ -91,6 +100,7 @@ namespace columbus {  namespace io {
             return;
 
         if (zip != zipmode) {
+            syncBuffers();
             filterstream->sync();
 
             filterstream->pop();
@@ -137,22 +147,27 @@ namespace columbus {  namespace io {
       }
     }
 
-    void ZippedIO::write(const char* data, const streampos size) {
+    void ZippedIO::write(const char* data, const streamsize size) {
         // There is deliberately no nullptr pointer check as it is used only internally
         // from the write methods, which already checks it.
         filterstream->write(data, size);
     }
 
-    void ZippedIO::read(char* data, const streampos size) {
+    streamsize ZippedIO::read(char* data, const streamsize size) {
         // There is deliberately no nullptr pointer check as it is used only internally
         // from the read methods, which already checks it.
-        filterstream->read(data, size);
+        return readAvailable(*filterstream, data, size);
     }
 
-    void ZippedIO::get(streambuf& sb, char delim) {
-        // There is deliberately no nullptr pointer check as it is used only internally
-        // from the read methods, which already checks it.
-        filterstream->get(sb, delim);
+    void ZippedIO::discardReadBuffer() {
+        // The decompressed data can't be pushed back into the zlib stream, but positioning
+        // is not allowed in zipped mode anyway.
+        if (zip) {
+            readPos = readEnd = nullptr;
+            endOfInput = false;
+            return;
+        }
+        BinaryIO::discardReadBuffer();
     }
 
     void ZippedIO::writeStartSizeOfBlock() {
@@ -2,6 +2,9 @@
 #include "javascript/inc/javascript.h"
 #include "javascript/inc/messages.h"
 #include <assert.h>
+#include <string.h>
+#include <string>
+#include <vector>
 
 
 namespace columbus { namespace javascript { namespace asg { namespace addon {
@@ -9,6 +12,251 @@ namespace columbus { namespace javascript { namespace asg { namespace addon {
 
 napi_ref Factory::constructor;
 
+static bool getTypedArray(napi_env env, napi_value value, napi_typedarray_type expectedType, void** data, size_t* length) {
+    napi_status status;
+    bool isTypedArray;
+    status = napi_is_typedarray(env, value, &isTypedArray);
+    assert(status == napi_ok);
+    if (!isTypedArray)
+        return false;
+
+    napi_typedarray_type type;
+    status = napi_get_typedarray_info(env, value, &type, length, data, nullptr, nullptr);
+    assert(status == napi_ok);
+    return type == expectedType;
+}
+
+static bool getStringArray(napi_env env, napi_value value, std::vector<std::string>& strings) {
+    napi_status status;
+    bool isArray;
+    status = napi_is_array(env, value, &isArray);
+    assert(status == napi_ok);
+    if (!isArray)
+        return false;
+
+    uint32_t length;
+    status = napi_get_array_length(env, value, &length);
+    assert(status == napi_ok);
+
+    strings.resize(length);
+    for (uint32_t i = 0; i < length; ++i) {
+        napi_value element;
+        status = napi_get_element(env, value, i, &element);
+        assert(status == napi_ok);
+
+        size_t size;
+        status = napi_get_value_string_utf8(env, element, nullptr, 0, &size);
+        if (status != napi_ok)
+            return false;
+        strings[i].resize(size + 1);
+        status = napi_get_value_string_utf8(env, element, &strings[i][0], size + 1, &size);
+        assert(status == napi_ok);
+        strings[i].resize(size);
+    }
+    return true;
+}
+
+static napi_value createUint32Array(napi_env env, const std::vector<uint32_t>& values) {
+    napi_status status;
+    void* data;
+    napi_value buffer;
+    status = napi_create_arraybuffer(env, values.size() * sizeof(uint32_t), &data, &buffer);
+    assert(status == napi_ok);
+    if (!values.empty())
+        memcpy(data, values.data(), values.size() * sizeof(uint32_t));
+
+    napi_value array;
+    status = napi_create_typedarray(env, napi_uint32_array, values.size(), buffer, 0, &array);
+    assert(status == napi_ok);
+    return array;
+}
+
+static napi_value createKindMap(napi_env env, int last, std::string (*toString)(int)) {
+    napi_status status;
+    napi_value kinds;
+    status = napi_create_object(env, &kinds);
+    assert(status == napi_ok);
+
+    for (int kind = 0; kind < last; ++kind) {
+        napi_value value;
+        status = napi_create_int32(env, kind, &value);
+        assert(status == napi_ok);
+        status = napi_set_named_property(env, kinds, toString(kind).c_str(), value);
+        assert(status == napi_ok);
+    }
+    return kinds;
+}
+
+static std::string nodeKindToString(int kind) { return Common::toString(static_cast<NodeKind>(kind)); }
+static std::string edgeKindToString(int kind) { return Common::toString(static_cast<EdgeKind>(kind)); }
+
+static napi_status newWrapperInstance(napi_env env, base::Base* node, napi_value* instance) {
+    switch (node->getNodeKind()) {
+        case ndkSystem:
+            return SystemWrapper::NewInstance(env, dynamic_cast<base::System*>(node), instance);
+        case ndkComment:
+            return CommentWrapper::NewInstance(env, dynamic_cast<base::Comment*>(node), instance);
+        case ndkModuleDeclaration:
+            return ModuleDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::ModuleDeclaration*>(node), instance);
+        case ndkVariableDeclarator:
+            return VariableDeclaratorWrapper::NewInstance(env, dynamic_cast<declaration::VariableDeclarator*>(node), instance);
+        case ndkChainElement:
+            return ChainElementWrapper::NewInstance(env, dynamic_cast<expression::ChainElement*>(node), instance);
+        case ndkPrivateIdentifier:
+            return PrivateIdentifierWrapper::NewInstance(env, dynamic_cast<expression::PrivateIdentifier*>(node), instance);
+        case ndkProperty:
+            return PropertyWrapper::NewInstance(env, dynamic_cast<expression::Property*>(node), instance);
+        case ndkSpreadElement:
+            return SpreadElementWrapper::NewInstance(env, dynamic_cast<expression::SpreadElement*>(node), instance);
+        case ndkSuper:
+            return SuperWrapper::NewInstance(env, dynamic_cast<expression::Super*>(node), instance);
+        case ndkTemplateElement:
+            return TemplateElementWrapper::NewInstance(env, dynamic_cast<expression::TemplateElement*>(node), instance);
+        case ndkCatchClause:
+            return CatchClauseWrapper::NewInstance(env, dynamic_cast<statement::CatchClause*>(node), instance);
+        case ndkFunction:
+            return FunctionWrapper::NewInstance(env, dynamic_cast<statement::Function*>(node), instance);
+        case ndkSwitchCase:
+            return SwitchCaseWrapper::NewInstance(env, dynamic_cast<statement::SwitchCase*>(node), instance);
+        case ndkClassBody:
+            return ClassBodyWrapper::NewInstance(env, dynamic_cast<structure::ClassBody*>(node), instance);
+        case ndkMethodDefinition:
+            return MethodDefinitionWrapper::NewInstance(env, dynamic_cast<structure::MethodDefinition*>(node), instance);
+        case ndkPropertyDefinition:
+            return PropertyDefinitionWrapper::NewInstance(env, dynamic_cast<structure::PropertyDefinition*>(node), instance);
+        case ndkProgram:
+            return ProgramWrapper::NewInstance(env, dynamic_cast<base::Program*>(node), instance);
+        case ndkIdentifier:
+            return IdentifierWrapper::NewInstance(env, dynamic_cast<expression::Identifier*>(node), instance);
+        case ndkExportNamedDeclaration:
+            return ExportNamedDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::ExportNamedDeclaration*>(node), instance);
+        case ndkImportDeclaration:
+            return ImportDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::ImportDeclaration*>(node), instance);
+        case ndkCallExpression:
+            return CallExpressionWrapper::NewInstance(env, dynamic_cast<expression::CallExpression*>(node), instance);
+        case ndkMemberExpression:
+            return MemberExpressionWrapper::NewInstance(env, dynamic_cast<expression::MemberExpression*>(node), instance);
+        case ndkArrayExpression:
+            return ArrayExpressionWrapper::NewInstance(env, dynamic_cast<expression::ArrayExpression*>(node), instance);
+        case ndkArrowFunctionExpression:
+            return ArrowFunctionExpressionWrapper::NewInstance(env, dynamic_cast<expression::ArrowFunctionExpression*>(node), instance);
+        case ndkAssignmentExpression:
+            return AssignmentExpressionWrapper::NewInstance(env, dynamic_cast<expression::AssignmentExpression*>(node), instance);
+        case ndkAwaitExpression:
+            return AwaitExpressionWrapper::NewInstance(env, dynamic_cast<expression::AwaitExpression*>(node), instance);
+        case ndkBinaryExpression:
+            return BinaryExpressionWrapper::NewInstance(env, dynamic_cast<expression::BinaryExpression*>(node), instance);
+        case ndkChainExpression:
+            return ChainExpressionWrapper::NewInstance(env, dynamic_cast<expression::ChainExpression*>(node), instance);
+        case ndkClassExpression:
+            return ClassExpressionWrapper::NewInstance(env, dynamic_cast<expression::ClassExpression*>(node), instance);
+        case ndkConditionalExpression:
+            return ConditionalExpressionWrapper::NewInstance(env, dynamic_cast<expression::ConditionalExpression*>(node), instance);
+        case ndkFunctionExpression:
+            return FunctionExpressionWrapper::NewInstance(env, dynamic_cast<expression::FunctionExpression*>(node), instance);
+        case ndkImportExpression:
+            return ImportExpressionWrapper::NewInstance(env, dynamic_cast<expression::ImportExpression*>(node), instance);
+        case ndkLogicalExpression:
+            return LogicalExpressionWrapper::NewInstance(env, dynamic_cast<expression::LogicalExpression*>(node), instance);
+        case ndkMetaProperty:
+            return MetaPropertyWrapper::NewInstance(env, dynamic_cast<expression::MetaProperty*>(node), instance);
+        case ndkNewExpression:
+            return NewExpressionWrapper::NewInstance(env, dynamic_cast<expression::NewExpression*>(node), instance);
+        case ndkObjectExpression:
+            return ObjectExpressionWrapper::NewInstance(env, dynamic_cast<expression::ObjectExpression*>(node), instance);
+        case ndkSequenceExpression:
+            return SequenceExpressionWrapper::NewInstance(env, dynamic_cast<expression::SequenceExpression*>(node), instance);
+        case ndkTaggedTemplateExpression:
+            return TaggedTemplateExpressionWrapper::NewInstance(env, dynamic_cast<expression::TaggedTemplateExpression*>(node), instance);
+        case ndkTemplateLiteral:
+            return TemplateLiteralWrapper::NewInstance(env, dynamic_cast<expression::TemplateLiteral*>(node), instance);
+        case ndkThisExpression:
+            return ThisExpressionWrapper::NewInstance(env, dynamic_cast<expression::ThisExpression*>(node), instance);
+        case ndkUnaryExpression:
+            return UnaryExpressionWrapper::NewInstance(env, dynamic_cast<expression::UnaryExpression*>(node), instance);
+        case ndkUpdateExpression:
+            return UpdateExpressionWrapper::NewInstance(env, dynamic_cast<expression::UpdateExpression*>(node), instance);
+        case ndkYieldExpression:
+            return YieldExpressionWrapper::NewInstance(env, dynamic_cast<expression::YieldExpression*>(node), instance);
+        case ndkBigIntLiteral:
+            return BigIntLiteralWrapper::NewInstance(env, dynamic_cast<expression::BigIntLiteral*>(node), instance);
+        case ndkBooleanLiteral:
+            return BooleanLiteralWrapper::NewInstance(env, dynamic_cast<expression::BooleanLiteral*>(node), instance);
+        case ndkNullLiteral:
+            return NullLiteralWrapper::NewInstance(env, dynamic_cast<expression::NullLiteral*>(node), instance);
+        case ndkNumberLiteral:
+            return NumberLiteralWrapper::NewInstance(env, dynamic_cast<expression::NumberLiteral*>(node), instance);
+        case ndkRegExpLiteral:
+            return RegExpLiteralWrapper::NewInstance(env, dynamic_cast<expression::RegExpLiteral*>(node), instance);
+        case ndkStringLiteral:
+            return StringLiteralWrapper::NewInstance(env, dynamic_cast<expression::StringLiteral*>(node), instance);
+        case ndkArrayPattern:
+            return ArrayPatternWrapper::NewInstance(env, dynamic_cast<statement::ArrayPattern*>(node), instance);
+        case ndkAssignmentPattern:
+            return AssignmentPatternWrapper::NewInstance(env, dynamic_cast<statement::AssignmentPattern*>(node), instance);
+        case ndkObjectPattern:
+            return ObjectPatternWrapper::NewInstance(env, dynamic_cast<statement::ObjectPattern*>(node), instance);
+        case ndkRestElement:
+            return RestElementWrapper::NewInstance(env, dynamic_cast<statement::RestElement*>(node), instance);
+        case ndkBlockStatement:
+            return BlockStatementWrapper::NewInstance(env, dynamic_cast<statement::BlockStatement*>(node), instance);
+        case ndkBreakStatement:
+            return BreakStatementWrapper::NewInstance(env, dynamic_cast<statement::BreakStatement*>(node), instance);
+        case ndkContinueStatement:
+            return ContinueStatementWrapper::NewInstance(env, dynamic_cast<statement::ContinueStatement*>(node), instance);
+        case ndkDebuggerStatement:
+            return DebuggerStatementWrapper::NewInstance(env, dynamic_cast<statement::DebuggerStatement*>(node), instance);
+        case ndkEmptyStatement:
+            return EmptyStatementWrapper::NewInstance(env, dynamic_cast<statement::EmptyStatement*>(node), instance);
+        case ndkExpressionStatement:
+            return ExpressionStatementWrapper::NewInstance(env, dynamic_cast<statement::ExpressionStatement*>(node), instance);
+        case ndkForInStatement:
+            return ForInStatementWrapper::NewInstance(env, dynamic_cast<statement::ForInStatement*>(node), instance);
+        case ndkForStatement:
+            return ForStatementWrapper::NewInstance(env, dynamic_cast<statement::ForStatement*>(node), instance);
+        case ndkIfStatement:
+            return IfStatementWrapper::NewInstance(env, dynamic_cast<statement::IfStatement*>(node), instance);
+        case ndkLabeledStatement:
+            return LabeledStatementWrapper::NewInstance(env, dynamic_cast<statement::LabeledStatement*>(node), instance);
+        case ndkReturnStatement:
+            return ReturnStatementWrapper::NewInstance(env, dynamic_cast<statement::ReturnStatement*>(node), instance);
+        case ndkSwitchStatement:
+            return SwitchStatementWrapper::NewInstance(env, dynamic_cast<statement::SwitchStatement*>(node), instance);
+        case ndkThrowStatement:
+            return ThrowStatementWrapper::NewInstance(env, dynamic_cast<statement::ThrowStatement*>(node), instance);
+        case ndkTryStatement:
+            return TryStatementWrapper::NewInstance(env, dynamic_cast<statement::TryStatement*>(node), instance);
+        case ndkWhileStatement:
+            return WhileStatementWrapper::NewInstance(env, dynamic_cast<statement::WhileStatement*>(node), instance);
+        case ndkWithStatement:
+            return WithStatementWrapper::NewInstance(env, dynamic_cast<statement::WithStatement*>(node), instance);
+        case ndkClassDeclaration:
+            return ClassDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::ClassDeclaration*>(node), instance);
+        case ndkExportSpecifier:
+            return ExportSpecifierWrapper::NewInstance(env, dynamic_cast<structure::ExportSpecifier*>(node), instance);
+        case ndkFunctionDeclaration:
+            return FunctionDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::FunctionDeclaration*>(node), instance);
+        case ndkExportAllDeclaration:
+            return ExportAllDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::ExportAllDeclaration*>(node), instance);
+        case ndkExportDefaultDeclaration:
+            return ExportDefaultDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::ExportDefaultDeclaration*>(node), instance);
+        case ndkVariableDeclaration:
+            return VariableDeclarationWrapper::NewInstance(env, dynamic_cast<declaration::VariableDeclaration*>(node), instance);
+        case ndkForOfStatement:
+            return ForOfStatementWrapper::NewInstance(env, dynamic_cast<statement::ForOfStatement*>(node), instance);
+        case ndkDoWhileStatement:
+            return DoWhileStatementWrapper::NewInstance(env, dynamic_cast<statement::DoWhileStatement*>(node), instance);
+        case ndkImportDefaultSpecifier:
+            return ImportDefaultSpecifierWrapper::NewInstance(env, dynamic_cast<structure::ImportDefaultSpecifier*>(node), instance);
+        case ndkImportNamespaceSpecifier:
+            return ImportNamespaceSpecifierWrapper::NewInstance(env, dynamic_cast<structure::ImportNamespaceSpecifier*>(node), instance);
+        case ndkImportSpecifier:
+            return ImportSpecifierWrapper::NewInstance(env, dynamic_cast<structure::ImportSpecifier*>(node), instance);
+        default:
+            return napi_invalid_arg;
+    }
+}
+
 Factory::Factory(): env_(nullptr), wrapper_(nullptr) {}
 
 Factory::~Factory() { napi_delete_reference(env_, wrapper_); }
@@ -104,6 +352,9 @@ napi_value Factory::Init(napi_env env, napi_value& exports) {
         DECLARE_NAPI_METHOD("createImportDefaultSpecifierWrapper", createImportDefaultSpecifierWrapper),
         DECLARE_NAPI_METHOD("createImportNamespaceSpecifierWrapper", createImportNamespaceSpecifierWrapper),
         DECLARE_NAPI_METHOD("createImportSpecifierWrapper", createImportSpecifierWrapper),
+        DECLARE_NAPI_METHOD("createNodes", createNodes),
+        DECLARE_NAPI_METHOD("addEdges", addEdges),
+        DECLARE_NAPI_METHOD("getWrapper", getWrapper),
         DECLARE_NAPI_METHOD("saveAST", SaveAST),
         DECLARE_NAPI_METHOD("loadAST", LoadAST),
         DECLARE_NAPI_METHOD("clear", Clear)
@@ -119,6 +370,12 @@ napi_value Factory::Init(napi_env env, napi_value& exports) {
     status = napi_set_named_property(env, exports, "Factory", cons);
     assert(status == napi_ok);
 
+    status = napi_set_named_property(env, exports, "NodeKind", createKindMap(env, ndkLAST, nodeKindToString));
+    assert(status == napi_ok);
+
+    status = napi_set_named_property(env, exports, "EdgeKind", createKindMap(env, edkLAST, edgeKindToString));
+    assert(status == napi_ok);
+
     return exports;
 }
 
@@ -1684,6 +1941,195 @@ napi_value Factory::createImportSpecifierWrapper(napi_env env, napi_callback_inf
 
     return instance;
 }
+napi_value Factory::createNodes(napi_env env, napi_callback_info info) {
+    napi_status status;
+    size_t argc = 5;
+    napi_value args[5], jsthis;
+    status = napi_get_cb_info(env, info, &argc, args, &jsthis, nullptr);
+    assert(status == napi_ok);
+
+    if (argc != 5) {
+        napi_throw_type_error(env, nullptr, "Wrong number of arguments. Pass the node kinds, positions, path and name indices and the string table!");
+        return nullptr;
+    }
+
+    uint16_t* kinds;
+    int32_t* positions;
+    uint32_t* paths;
+    uint32_t* names;
+    size_t kindsLength, positionsLength, pathsLength, namesLength;
+    std::vector<std::string> strings;
+    if (!getTypedArray(env, args[0], napi_uint16_array, reinterpret_cast<void**>(&kinds), &kindsLength) ||
+        !getTypedArray(env, args[1], napi_int32_array, reinterpret_cast<void**>(&positions), &positionsLength) ||
+        !getTypedArray(env, args[2], napi_uint32_array, reinterpret_cast<void**>(&paths), &pathsLength) ||
+        !getTypedArray(env, args[3], napi_uint32_array, reinterpret_cast<void**>(&names), &namesLength) ||
+        !getStringArray(env, args[4], strings)) {
+        napi_throw_type_error(env, nullptr, "Arguments should be an Uint16Array, an Int32Array, two Uint32Arrays and an array of strings!");
+        return nullptr;
+    }
+
+    if (positionsLength != kindsLength * 8 || pathsLength != kindsLength || namesLength != kindsLength) {
+        napi_throw_type_error(env, nullptr, "Every node needs 8 positions (line, col, endline, endcol and their wide equivalents), a path and a name index!");
+        return nullptr;
+    }
+
+    // checked before creating anything, so an invalid batch does not leave half of its nodes in the ASG
+    for (size_t i = 0; i < kindsLength; ++i) {
+        NodeKind kind = static_cast<NodeKind>(kinds[i]);
+        if (kind >= ndkLAST) {
+            napi_throw_type_error(env, nullptr, "Invalid node kind");
+            return nullptr;
+        }
+        if (Common::getIsAbstract(kind)) {
+            napi_throw_type_error(env, nullptr, ("Cannot create a node of the abstract kind " + Common::toString(kind)).c_str());
+            return nullptr;
+        }
+        if (names[i] < strings.size() && !Common::getIsBaseClassKind(kind, ndkNamed)) {
+            napi_throw_type_error(env, nullptr, ("Cannot set the name of " + Common::toString(kind)).c_str());
+            return nullptr;
+        }
+    }
+
+    Factory* obj;
+    status = napi_unwrap(env, jsthis, reinterpret_cast<void**>(&obj));
+    assert(status == napi_ok);
+
+    std::vector<uint32_t> ids;
+    ids.reserve(kindsLength);
+    try {
+        for (size_t i = 0; i < kindsLength; ++i) {
+            base::Base* node = obj->factory->createNode(static_cast<NodeKind>(kinds[i]));
+            ids.push_back(node->getId());
+
+            base::Positioned* positioned = dynamic_cast<base::Positioned*>(node);
+            if (positioned != nullptr) {
+                const int32_t* position = positions + i * 8;
+                Range range = positioned->getPosition();
+                if (paths[i] < strings.size())
+                    range.setPath(strings[paths[i]]);
+                range.setLine(position[0]);
+                range.setCol(position[1]);
+                range.setEndLine(position[2]);
+                range.setEndCol(position[3]);
+                range.setWideLine(position[4]);
+                range.setWideCol(position[5]);
+                range.setWideEndLine(position[6]);
+                range.setWideEndCol(position[7]);
+                positioned->setPosition(range);
+            }
+
+            if (names[i] < strings.size())
+                dynamic_cast<base::Named&>(*node).setName(strings[names[i]]);
+        }
+    } catch (const columbus::Exception& e) {
+        napi_throw_error(env, nullptr, e.getMessage().c_str());
+        return nullptr;
+    }
+
+    return createUint32Array(env, ids);
+}
+
+napi_value Factory::addEdges(napi_env env, napi_callback_info info) {
+    napi_status status;
+    size_t argc = 1;
+    napi_value args[1], jsthis;
+    status = napi_get_cb_info(env, info, &argc, args, &jsthis, nullptr);
+    assert(status == napi_ok);
+
+    if (argc != 1) {
+        napi_throw_type_error(env, nullptr, "Wrong number of arguments");
+        return nullptr;
+    }
+
+    uint32_t* edges;
+    size_t edgesLength;
+    if (!getTypedArray(env, args[0], napi_uint32_array, reinterpret_cast<void**>(&edges), &edgesLength) || edgesLength % 3 != 0) {
+        napi_throw_type_error(env, nullptr, "Argument should be an Uint32Array of (source id, edge kind, target id) triplets!");
+        return nullptr;
+    }
+
+    Factory* obj;
+    status = napi_unwrap(env, jsthis, reinterpret_cast<void**>(&obj));
+    assert(status == napi_ok);
+
+    // the rejected edges are reported back as {index, reason} objects, where index is the number of the triplet
+    napi_value failures;
+    status = napi_create_array(env, &failures);
+    assert(status == napi_ok);
+    uint32_t failureCount = 0;
+
+    for (size_t i = 0; i < edgesLength / 3; ++i) {
+        NodeId sourceId = edges[i * 3];
+        EdgeKind edgeKind = static_cast<EdgeKind>(edges[i * 3 + 1]);
+        NodeId targetId = edges[i * 3 + 2];
+
+        std::string reason;
+        try {
+            if (!obj->factory->getExist(sourceId) || !obj->factory->getExist(targetId))
+                reason = "The node does not exist";
+            else if (edgeKind >= edkLAST || !obj->factory->getRef(sourceId).setEdge(edgeKind, obj->factory->getPointer(targetId)))
+                reason = "Invalid edge kind for " + Common::toString(obj->factory->getNodeKind(sourceId));
+        } catch (const columbus::Exception& e) {
+            reason = e.getMessage();
+        }
+
+        if (!reason.empty()) {
+            napi_value failure, index, message;
+            status = napi_create_object(env, &failure);
+            assert(status == napi_ok);
+            status = napi_create_uint32(env, static_cast<uint32_t>(i), &index);
+            assert(status == napi_ok);
+            status = napi_create_string_utf8(env, reason.c_str(), reason.size(), &message);
+            assert(status == napi_ok);
+            status = napi_set_named_property(env, failure, "index", index);
+            assert(status == napi_ok);
+            status = napi_set_named_property(env, failure, "reason", message);
+            assert(status == napi_ok);
+            status = napi_set_element(env, failures, failureCount++, failure);
+            assert(status == napi_ok);
+        }
+    }
+
+    return failures;
+}
+
+napi_value Factory::getWrapper(napi_env env, napi_callback_info info) {
+    napi_status status;
+    size_t argc = 1;
+    napi_value args[1], jsthis;
+    status = napi_get_cb_info(env, info, &argc, args, &jsthis, nullptr);
+    assert(status == napi_ok);
+
+    if (argc != 1) {
+        napi_throw_type_error(env, nullptr, "Wrong number of arguments");
+        return nullptr;
+    }
+
+    uint32_t id;
+    status = napi_get_value_uint32(env, args[0], &id);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Argument should be a node id!");
+        return nullptr;
+    }
+
+    Factory* obj;
+    status = napi_unwrap(env, jsthis, reinterpret_cast<void**>(&obj));
+    assert(status == napi_ok);
+
+    if (!obj->factory->getExist(id)) {
+        napi_throw_error(env, nullptr, "The node does not exist");
+        return nullptr;
+    }
+
+    napi_value instance;
+    status = newWrapperInstance(env, obj->factory->getPointer(id), &instance);
+    if (status != napi_ok) {
+        napi_throw_error(env, nullptr, ("Cannot wrap " + Common::toString(obj->factory->getNodeKind(id))).c_str());
+        return nullptr;
+    }
+
+    return instance;
+}
 inline bool ends_with(std::string const & value, std::string const & ending)
 {
     if (ending.size() > value.size()) return false;
@@ -124,6 +124,13 @@ class Factory {
     static napi_value LoadAST(napi_env env, napi_callback_info info);
     static napi_value Clear(napi_env env, napi_callback_info info);
     static napi_value getRoot(napi_env env, napi_callback_info info);   
+
+    // Batched construction: the nodes and the edges are passed in typed arrays, so a whole file (or more) is built
+    // by a single call instead of a create and a setter call (and a wrapper object) per node and edge.
+    static napi_value createNodes(napi_env env, napi_callback_info info);
+    static napi_value addEdges(napi_env env, napi_callback_info info);
+    static napi_value getWrapper(napi_env env, napi_callback_info info);
+
     static napi_value createCommentWrapper(napi_env env, napi_callback_info info);
     static napi_value createModuleDeclarationWrapper(napi_env env, napi_callback_info info);
     static napi_value createVariableDeclaratorWrapper(napi_env env, napi_callback_info info);
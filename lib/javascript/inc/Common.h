@@ -686,6 +686,13 @@ namespace columbus { namespace javascript { namespace asg {
       */
       bool getIsNotComposite(const base::Base& node);
 
+      /**
+      * \brief Decides whether the node kind is abstract or not (no node of an abstract kind can be created).
+      * \param kind [in] The examined node kind.
+      * \return Returns true if the node kind is abstract.
+      */
+      bool getIsAbstract(NodeKind kind);
+
       /**
       * \brief Gives back the string representation of the NodeId.
       * \param nodeId [in] The NodeId.
@@ -760,6 +760,21 @@ bool getIsNotComposite(const base::Base& node) {
     ndk == ndkEmptyStatement;
 }
 
+bool getIsAbstract(NodeKind kind) {
+  return
+    kind == ndkBase ||
+    kind == ndkNamed ||
+    kind == ndkPositioned ||
+    kind == ndkDeclaration ||
+    kind == ndkExpression ||
+    kind == ndkLiteral ||
+    kind == ndkPattern ||
+    kind == ndkStatement ||
+    kind == ndkClass ||
+    kind == ndkImpSpecifier ||
+    kind == ndkModuleSpecifier;
+}
+
 const std::string toString(NodeId id) {
   std::stringstream s;
   s << id;
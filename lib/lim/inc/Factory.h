@@ -108,7 +108,7 @@ namespace columbus { namespace lim { namespace asg {
       void loadHeader(const std::string &filename,const std::list<HeaderData*> &headerDataList);
 
       /**
-      * \brief Loads the graph.
+      * \brief Loads the graph. Files saved by saveMapped() are loaded through loadMapped(), with every node created.
       * \param filename [in] The graph is loaded from this file.
       * \param header   [in] The header information (also will be loaded).
       */
@@ -118,6 +118,41 @@ namespace columbus { namespace lim { namespace asg {
 
       void load( const std::string &filename , std::list<HeaderData*> &headerDataList, std::streampos& startPosition);
 
+      /**
+      * \brief Saves the graph in the memory mappable layout.
+      *
+      * The file is a normal uncompressed "csi" file (so load() can read it as well) which is followed by
+      * an index containing the file offset of every node and a footer pointing to the string table and to the index.
+      * \param filename [in] The graph is saved into this file.
+      * \param header   [in] The header information (also will be saved).
+      */
+      void saveMapped(const std::string &filename, std::list<HeaderData*> &headerDataList) const;
+
+      /**
+      * \brief Loads a graph saved by saveMapped() by memory mapping the file.
+      * \param filename [in] The graph is loaded from this file.
+      * \param header   [in] The header information (also will be loaded).
+      * \param lazy     [in] If it is true, the nodes are created only when they are accessed first, otherwise all of them are created immediately.
+      *                      A lazily loaded factory must not be accessed from several threads (not even through its const
+      *                      accessors, as they create the missing nodes from the single mapped file) until materializeAll() is called.
+      * \throw LimException If the file does not have the memory mappable layout.
+      */
+      void loadMapped(const std::string &filename, std::list<HeaderData*> &headerDataList, bool lazy);
+
+      /**
+      * \brief Decides whether the given file has the memory mappable layout (was saved by saveMapped()).
+      * \param filename [in] The name of the file.
+      * \return Returns true if the file can be loaded by loadMapped().
+      */
+      static bool isMappedFile(const std::string &filename);
+
+      /**
+      * \brief Creates all the nodes which are not materialized yet from the mapped file and releases the mapping.
+      *
+      * Lazy materialization is not thread safe, so this has to be called before the factory is accessed from several threads.
+      */
+      void materializeAll() const;
+
       void clear();
 
       /**
@@ -268,13 +303,13 @@ namespace columbus { namespace lim { namespace asg {
       * \brief Get the iterator for the nodes
       * \return An iterator to the nodes.
       */
-      const const_iterator begin() const{return const_iterator(container.begin(),this);}
+      const const_iterator begin() const{materializeAll(); return const_iterator(container.begin(),this);}
 
       /**
       * \brief Get the iterator for the nodes.
       * \return An iterator to the nodes.
       */
-      const const_iterator end() const {return const_iterator(container.end(),this);}
+      const const_iterator end() const {materializeAll(); return const_iterator(container.end(),this);}
 
       /**
       * \brief Creates and returns a constant iterator, which enumerates the nodes in the ASG.
@@ -601,6 +636,28 @@ namespace columbus { namespace lim { namespace asg {
       */
       void loadHeader(io::BinaryIO &binIo, const std::list<HeaderData*> &headerDataList);
 
+      /**
+      * \internal
+      * \brief Saves the file type tag and the graph header.
+      * \param binIo  [in] The file into which the header will be saved.
+      * \param header [in] The header information.
+      * \param zip    [in] Whether the ASG is going to be compressed.
+      */
+      void saveHeader(io::BinaryIO &binIo, std::list<HeaderData*> &headerDataList, bool zip) const;
+
+      /**
+      * \internal
+      * \brief Creates the node with the given id from the mapped file if it is not created yet.
+      * \param id [in] The id of the node.
+      */
+      void materializeNode(NodeId id) const;
+
+      /**
+      * \internal
+      * \brief Releases the mapped file.
+      */
+      void releaseMapping() const;
+
 
       // ******************** Private attributes ********************
 
@@ -640,6 +697,18 @@ namespace columbus { namespace lim { namespace asg {
       /** \internal \brief List of the ids of the deleted nodes. */
       std::list<NodeId> deletedNodeIdList;
 
+      /** \internal \brief The mapped file of a lazily loaded ASG (NULL if every node is materialized). */
+      mutable std::unique_ptr<io::MappedIO> mappedIO;
+
+      /** \internal \brief The file offsets of the nodes which are not materialized yet (zero if there is nothing to load). */
+      mutable std::vector<unsigned long long> mappedNodeOffsets;
+
+      /** \internal \brief The number of nodes which are not materialized yet. */
+      mutable size_t mappedNodesLeft;
+
+      /** \internal \brief True while a node is being materialized. */
+      mutable bool materializing;
+
       friend class VisitorFilter;
 
       friend class base::Base;
@@ -42,6 +42,7 @@
 #include "AsgCommon.h"
 #include "strtable/inc/RefDistributorStrTable.h"
 #include "csi/inc/csi.h"
+#include "io/inc/MappedIO.h"
 #include "Exception.h"
 
 #include "Constant.h"
@@ -40,6 +40,7 @@
 #define CMSG_EX_DON_T_HAVE_ANY_VISITOR                  "Do not have any visitor"
 #define CMSG_EX_MISSING_FILE_TYPE_INFORMATION           "Missing file type information"
 #define CMSG_EX_WRONG_FILE_TYPE_INFORMATION             "Wrong file type information"
+#define CMSG_EX_NOT_A_MAPPED_FILE(FILENAME)             "The file does not have the memory mappable layout (" + FILENAME + ")"
 #define CMSG_EX_MISSING_API_VERSION_INFORMATION         "Missing API version information"
 #define CMSG_EX_WRONG_API_VERSION(APVER_REQ, APVER_FOUND) "Wrong API version (" + APVER_REQ + " required, " + APVER_FOUND + " found)"
 #define CMSG_EX_MISSING_BINARY_VERSION_INFORMATION      "Missing binary version information"
@@ -22,6 +22,7 @@
 
 #include <string.h>
 #include <algorithm>
+#include <fstream>
 #include <sstream>
 #include <stdexcept>
 
@@ -36,6 +37,12 @@
 #include "common/inc/PlatformDependentDefines.h"
 
 namespace columbus { namespace lim { namespace asg {
+
+// The last bytes of a file saved by saveMapped() (the footer is: string table offset (8), index offset (8), magic).
+static const char MappedFileMagic[] = "LIMMAP1";
+static const size_t MappedFileMagicSize = 8;
+static const size_t MappedFileFooterSize = 8 + 8 + MappedFileMagicSize;
+
 Factory::Factory(RefDistributorStrTable& st, const std::string &rootPackageName, Language lang) :
   container(),
   strTable(&st),
@@ -44,6 +51,10 @@ Factory::Factory(RefDistributorStrTable& st, const std::string &rootPackageName,
   reverseEdges(NULL),
   registeredPointerStorage(),
   root(NULL),
+  mappedIO(),
+  mappedNodeOffsets(),
+  mappedNodesLeft(0),
+  materializing(false),
   simpleTypesStartId(10),
   numberOfSimpleTypes(7),
   fileSystemId(101),
@@ -97,6 +108,7 @@ Factory::~Factory() {
 }
 
 void Factory::swapStringTable(RefDistributorStrTable& newStrTable){
+  materializeAll();
   if (container.size() > 0 ) {
     std::map<Key,Key> oldAndNewStrKeyMap;
     for (Container::iterator it = container.begin() ;it!= container.end();++it) {
@@ -120,8 +132,26 @@ void Factory::save(const std::string &filename, std::list<HeaderData*> &headerDa
 }
 
 void Factory::save(io::ZippedIO& zipIo, std::list<HeaderData*> &headerDataList, bool zip) const {
+  materializeAll();
   TurnFilterOffSafely t(*this);
   zipIo.setEndianState(io::BinaryIO::etLittle);
+  saveHeader(zipIo, headerDataList, zip);
+
+  if (zip)
+    zipIo.setZip(true);
+  // saving the ASG
+  AlgorithmPreorder algPre;
+  algPre.setSafeMode();
+  VisitorSave vSave(zipIo);
+  algPre.run(*this, vSave);
+  // Writing the ENDMARK!
+  zipIo.writeUInt4(0); // NodeId
+  zipIo.writeUShort2(0); // NodeKind
+  strTable->save(zipIo);
+  zipIo.close();
+}
+
+void Factory::saveHeader(io::BinaryIO &zipIo, std::list<HeaderData*> &headerDataList, bool zip) const {
   // storage the headerData Full size 
   if (zip) {
     zipIo.writeString("zsi");
@@ -183,19 +213,41 @@ void Factory::save(io::ZippedIO& zipIo, std::list<HeaderData*> &headerDataList,
     zipIo.writeLongLong8(it->second.size() + 8);
     zipIo.writeData(it->second.data(), it->second.size());
   }
+}
 
-  if (zip)
-    zipIo.setZip(true);
-  // saving the ASG
-  AlgorithmPreorder algPre;
-  algPre.setSafeMode();
-  VisitorSave vSave(zipIo);
-  algPre.run(*this, vSave);
+void Factory::saveMapped(const std::string &filename, std::list<HeaderData*> &headerDataList) const {
+  materializeAll();
+  TurnFilterOffSafely t(*this);
+  io::BinaryIO binIo(filename.c_str(), io::IOBase::omWrite);
+  binIo.setEndianState(io::BinaryIO::etLittle);
+  saveHeader(binIo, headerDataList, false);
+
+  // saving the nodes in the order of their ids
+  std::vector<unsigned long long> offsets(container.size(), 0);
+  for (size_t id = 0; id < container.size(); ++id) {
+    if (container[id]) {
+      offsets[id] = (unsigned long long)binIo.getPosition();
+      container[id]->save(binIo);
+    }
+  }
   // Writing the ENDMARK!
-  zipIo.writeUInt4(0); // NodeId
-  zipIo.writeUShort2(0); // NodeKind
-  strTable->save(zipIo);
-  zipIo.close();
+  binIo.writeUInt4(0); // NodeId
+  binIo.writeUShort2(0); // NodeKind
+
+  unsigned long long strTableOffset = (unsigned long long)binIo.getPosition();
+  strTable->save(binIo);
+
+  // the node index
+  unsigned long long indexOffset = (unsigned long long)binIo.getPosition();
+  binIo.writeUInt4((unsigned)offsets.size());
+  for (unsigned long long offset : offsets)
+    binIo.writeULongLong8(offset);
+
+  // the footer
+  binIo.writeULongLong8(strTableOffset);
+  binIo.writeULongLong8(indexOffset);
+  binIo.writeData(MappedFileMagic, MappedFileMagicSize);
+  binIo.close();
 }
 
 void Factory::loadHeader(const std::string &filename, const std::list<HeaderData*> &headerDataList) {
@@ -308,6 +360,11 @@ void Factory::load( io::ZippedIO &zipIo, const std::list<HeaderData*> &headerDat
 
 }
 void Factory::load(const std::string &filename, std::list<HeaderData*> &headerDataList) {
+  // the files saved by saveMapped() are read from the mapping, but every node is created (lazy loading has to be asked for explicitly)
+  if (isMappedFile(filename)) {
+    loadMapped(filename, headerDataList, false);
+    return;
+  }
   io::ZippedIO zipIo(filename.c_str(), io::IOBase::omRead, false);
   load(zipIo, headerDataList);
 }
@@ -318,7 +375,135 @@ void Factory::load( const std::string &filename , std::list<HeaderData*> &header
   load( zipIo, headerDataList);
 }
 
+bool Factory::isMappedFile(const std::string &filename) {
+  // only the magic at the end of the file is read, the file is not mapped
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    return false;
+  file.seekg(0, std::ios::end);
+  std::streamoff fileSize = file.tellg();
+  if (fileSize < (std::streamoff)MappedFileFooterSize)
+    return false;
+  char magic[MappedFileMagicSize];
+  file.seekg(fileSize - (std::streamoff)MappedFileMagicSize);
+  if (!file.read(magic, MappedFileMagicSize))
+    return false;
+  return memcmp(magic, MappedFileMagic, MappedFileMagicSize) == 0;
+}
+
+void Factory::loadMapped(const std::string &filename, std::list<HeaderData*> &headerDataList, bool lazy) {
+  clear();
+
+  std::unique_ptr<io::MappedIO> mapped(new io::MappedIO(filename));
+  mapped->setEndianState(io::BinaryIO::etLittle);
+  size_t fileSize = mapped->getSize();
+  if (fileSize < MappedFileFooterSize || memcmp(mapped->getData() + fileSize - MappedFileMagicSize, MappedFileMagic, MappedFileMagicSize) != 0)
+    throw LimException(COLUMBUS_LOCATION, CMSG_EX_NOT_A_MAPPED_FILE(filename));
+
+  char tag[4];
+  mapped->readData(tag, 4);
+  if (strcmp(tag, "csi"))
+    throw LimException(COLUMBUS_LOCATION, CMSG_EX_MISSING_FILE_TYPE_INFORMATION);
+  loadHeader(*mapped, headerDataList);
+
+  // reading the footer
+  mapped->seek(fileSize - MappedFileFooterSize);
+  unsigned long long strTableOffset = mapped->readULongLong8();
+  unsigned long long indexOffset = mapped->readULongLong8();
+  if (strTableOffset >= fileSize || indexOffset >= fileSize)
+    throw LimException(COLUMBUS_LOCATION, CMSG_EX_NOT_A_MAPPED_FILE(filename));
+
+  // loading the string table
+  mapped->seek(strTableOffset);
+  strTable->loadWithKeepingTheRefMap(*mapped);
+
+  // loading the node index
+  mapped->seek(indexOffset);
+  size_t nodeCount = mapped->readUInt4();
+  mappedNodeOffsets.assign(nodeCount, 0);
+  mappedNodesLeft = 0;
+  for (size_t id = 0; id < nodeCount; ++id) {
+    mappedNodeOffsets[id] = mapped->readULongLong8();
+    if (mappedNodeOffsets[id])
+      ++mappedNodesLeft;
+  }
+
+  container.resize(nodeCount, NULL);
+  if (filter->container.size() < nodeCount)
+    filter->container.resize(nodeCount);
+  for (size_t id = 0; id < nodeCount; ++id)
+    if (mappedNodeOffsets[id])
+      filter->container[id] = Filter::NotFiltered;
+
+  mappedIO = std::move(mapped);
+
+  // fill the deletedNodeIdList with the free ids
+  for (size_t id = 100; id < nodeCount; ++id)
+    if (!mappedNodeOffsets[id])
+      deletedNodeIdList.push_back(id);
+
+  materializeNode(100);
+  root = dynamic_cast<logical::Package*>(container[100]);
+
+  if (!lazy)
+    materializeAll();
+}
+
+void Factory::materializeNode(NodeId id) const {
+  if (!mappedIO || id >= mappedNodeOffsets.size() || !mappedNodeOffsets[id])
+    return;
+
+  Factory& self = const_cast<Factory&>(*this);
+  // the filter state may have been set before the node was created
+  Filter::FilterState filterState = filter->container[id];
+
+  // the node can be materialized while the load() of another node is running (e.g. by getPointer()),
+  // so the read position and the state of the outer load are restored afterwards
+  bool nested = materializing;
+  size_t outerPosition = nested ? mappedIO->tell() : 0;
+
+  mappedIO->seek(mappedNodeOffsets[id]);
+  NodeId storedId = mappedIO->readUInt4();
+  NodeKind kind = (NodeKind)mappedIO->readUShort2();
+  if (storedId != id)
+    throw LimException(COLUMBUS_LOCATION, CMSG_EX_INVALID_NODE_ID(id));
+
+  materializing = true;
+  try {
+    self.createNode(kind, id).load(*mappedIO);
+  } catch (...) {
+    materializing = nested;
+    throw;
+  }
+  materializing = nested;
+  if (nested)
+    mappedIO->seek(outerPosition);
+
+  filter->container[id] = filterState;
+  mappedNodeOffsets[id] = 0;
+  if (--mappedNodesLeft == 0)
+    releaseMapping();
+}
+
+void Factory::materializeAll() const {
+  if (!mappedIO)
+    return;
+
+  for (NodeId id = 0; mappedIO && id < mappedNodeOffsets.size(); ++id)
+    materializeNode(id);
+
+  releaseMapping();
+}
+
+void Factory::releaseMapping() const {
+  mappedIO.reset();
+  mappedNodeOffsets.clear();
+  mappedNodeOffsets.shrink_to_fit();
+  mappedNodesLeft = 0;
+}
+
 void Factory::clear() {
+  releaseMapping();
   disableReverseEdges();
   for (Container::iterator i = container.begin(); i != container.end(); ++i) {
     if (*i) {
@@ -357,13 +542,18 @@ logical::Package* Factory::getRoot() const {
 bool Factory::getExist(NodeId id) const {
   if (container.size() <= id)
     return false;
+  if (!container[id])
+    materializeNode(id);
   return container[id] != NULL;
 }
 
 base::Base& Factory::getRef(NodeId id) const {
   base::Base* p = NULL;
-  if (id < container.size())
+  if (id < container.size()) {
+    if (!container[id])
+      materializeNode(id);
     p = container[id];
+  }
   if (!p)
     throw LimException(COLUMBUS_LOCATION, CMSG_EX_INVALID_NODE_ID(id));
   return *p;
@@ -373,6 +563,10 @@ base::Base* Factory::getPointer(NodeId id) const {
   base::Base* p = NULL;
   try {
     p = container.at(id);
+    if (!p && mappedIO) {
+      materializeNode(id);
+      p = container[id];
+    }
   } catch (const std::out_of_range&) {
     throw LimException(COLUMBUS_LOCATION, CMSG_EX_INVALID_NODE_ID(id));
   }
@@ -384,6 +578,7 @@ RefDistributorStrTable& Factory::getStringTable() const {
 }
 
 void Factory::destroyNode(NodeId id) {
+  materializeAll();
   if (!reverseEdges)
     throw LimException(COLUMBUS_LOCATION, CMSG_EX_YOU_MUST_ENABLE_THE_REVERSE_EDGE_FIRST);
 
@@ -412,6 +607,7 @@ void Factory::destroyNode(NodeId id) {
 }
 
 void Factory::destroyThisNodeOnly(NodeId id) {
+  materializeAll();
   if (!reverseEdges)
     throw LimException(COLUMBUS_LOCATION, CMSG_EX_YOU_MUST_ENABLE_THE_REVERSE_EDGE_FIRST);
 
@@ -458,10 +654,12 @@ const base::Base& Factory::ConstIterator::next() {
 }
 
 const Factory::ConstIterator Factory::constIterator() const {
+  materializeAll();
   return ConstIterator(&container,this);
 }
 
 bool Factory::isEmpty() const {
+  materializeAll();
   for (Container::const_iterator it = container.begin(); it != container.end(); ++it) {
     if (*it) {
       return false;
@@ -568,6 +766,7 @@ void Factory::setNotFilteredThisNodeOnly(NodeId id) {
 }
 
 void Factory::enableReverseEdges(ReverseEdges::FuncPtrWithBaseParameterType newSelector) {
+  materializeAll();
   if (!reverseEdges || (newSelector != reverseEdges->selectorFunc)){
     if (reverseEdges){
       delete reverseEdges;
@@ -600,6 +799,7 @@ bool Factory::getExistsReverseEdges() const {
 }
 
 base::Base* Factory::createNode(NodeKind kind) {
+  materializeAll();
   base::Base *p = 0;
   NodeId id;
   if (deletedNodeIdList.empty())
@@ -643,6 +843,8 @@ base::Base* Factory::createNode(NodeKind kind) {
 }
 
 base::Base& Factory::createNode(NodeKind kind, NodeId i) {
+  if (!materializing)
+    materializeAll();
   base::Base *p = 0;
   switch (kind) {
     case ndkComment: p = new base::Comment(i,this); break;
@@ -1290,6 +1492,7 @@ logical::Friendship& Factory::createFriendship(NodeId friendNode) {
 
 base::Base* Factory::replaceNode(base::Base &node)
 {
+  materializeAll();
   NodeId id = node.getId();
   base::Base* p = NULL;
 
@@ -25,6 +25,7 @@
 #include "graph/inc/graph.h"
 
 #include "RulParser.h"
+#include "MetricBuffer.h"
 
 #include <memory>
 
@@ -49,6 +50,19 @@ namespace columbus { namespace lim { namespace metrics {
       void run();
       void apRun();
 
+      /**
+      * Redirects the metric modifications of the handlers into the given buffer instead of
+      * the graph (used by the parallel computation, see ParallelLimMetrics)
+      */
+      void setMetricBuffer( MetricBuffer* buffer );
+
+      /**
+      * Stores the metric values in the given table, which has to be materialized into the
+      * graph by the caller. Without a table the visitor uses its own one and materializes it
+      * at the end of run()
+      */
+      void setMetricTable( graphsupport::MetricTable* table );
+
       //
       // VISITORS
       //
@@ -71,6 +85,11 @@ namespace columbus { namespace lim { namespace metrics {
       void begin( const asg::base::Base& node );
       void end( const asg::base::Base& node );
 
+      /**
+      * Creates the wrapper of the node, the graph node is looked up only at the first visit of the node
+      */
+      NodeWrapper wrap( const asg::base::Base& node );
+
       //
       // DATA MEMBERS
       //
@@ -90,6 +109,10 @@ namespace columbus { namespace lim { namespace metrics {
 
       DispatchPhases phase;                   ///> Which phase should be used when dispatching
       bool useVisitEnd;                       ///> Whether or not to use the visitEnd methods in the current pass
+      MetricBuffer* buffer;                   ///> The buffer of the metric modifications (NULL if the table is written directly)
+      graphsupport::MetricTable* table;       ///> The table of the metric values
+      std::unique_ptr<graphsupport::MetricTable> ownTable; ///> The table used if none is given
+      std::vector<graph::Node> graphNodes;    ///> The graph nodes of the already visited lim nodes (indexed by the lim node id)
   };
 
 }}}
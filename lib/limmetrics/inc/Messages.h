@@ -29,9 +29,13 @@
 #define CMSG_LIMMETRICS_PHASE_OVER                                WriteMsg::mlDebug,   "Phase %s over\n"
 #define CMSG_LIMMETRICS_DISABLED_METRIC                           WriteMsg::mlDebug,   "The metric %s is disabled\n"
 #define CMSG_LIMMETRICS_HANDLER_CREATED                           WriteMsg::mlDebug,   "Created MetricHandler with name <%s>\n"
+#define CMSG_LIMMETRICS_PARALLEL_GROUPS                           WriteMsg::mlDebug,   "%u independent metric handler groups are computed in %u lanes on %u threads\n"
+#define CMSG_LIMMETRICS_PARALLEL_LANE                             WriteMsg::mlDDebug,  "  Lane %u: %s\n"
+#define CMSG_LIMMETRICS_PARALLEL_REPLAY                           WriteMsg::mlDebug,   "Writing %lu buffered metric modifications to the graph\n"
 
 #define CMSG_LIMMETRICS_EX_INVALID_GRAPH_NODE( id )               "Error: Invalid graph node for corresponding lim node (" + id + ")"
 #define CMSG_LIMMETRICS_EX_INVALID_METRIC_TYPE( metric )          "Error: Invalid metric type for " + metric
+#define CMSG_LIMMETRICS_EX_UNREGISTERED_METRIC( metric )          "Error: The metric " + metric + " is not registered in the metric table"
 
 //------- OLD ---------
 #define CMSG_LIMMETRICS_CLASSKIND_NOT_FOUND               WriteMsg::mlDebug,   "Debug: Class node kind [%d] not found\n"
@@ -0,0 +1,120 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _METRIC_BUFFER_H_
+#define _METRIC_BUFFER_H_
+
+#include "graph/inc/graph.h"
+#include "graphsupport/inc/MetricTable.h"
+
+#include <vector>
+
+namespace columbus { namespace lim { namespace metrics {
+
+  /**
+  * The MetricBuffer class collects the metric modifications of a group of metric
+  * handlers instead of writing them into the metric table directly, so the handlers
+  * can run on separate threads while the (not thread safe) table is modified by only
+  * one thread afterwards.
+  *
+  * Every modification is labeled with the ordinal of the dispatched node (event)
+  * and the position of the handler in the dependency order. Since every buffer sees
+  * the same sequence of events, merging the buffers by these labels reproduces the
+  * order of the modifications of the single threaded run.
+  */
+  class MetricBuffer {
+
+    public:
+
+      MetricBuffer();
+
+      /**
+      * Signals that a new node is dispatched to the handlers
+      */
+      void nextEvent();
+
+      /**
+      * Sets the position (in the dependency order) of the handler which is dispatched next
+      */
+      void setHandler( unsigned position );
+
+      /**
+      * Records the same modifications as the corresponding methods of NodeWrapper
+      */
+      void addMetric( graphsupport::MetricTable::RowId row, const graph::Node& node, graphsupport::MetricTable::RowKind kind, graphsupport::MetricTable::MetricId metric, int value );
+      void addMetric( graphsupport::MetricTable::RowId row, const graph::Node& node, graphsupport::MetricTable::RowKind kind, graphsupport::MetricTable::MetricId metric, float value );
+      void setInvalid( graphsupport::MetricTable::RowId row, const graph::Node& node, graphsupport::MetricTable::RowKind kind, graphsupport::MetricTable::MetricId metric );
+
+      /**
+      * Returns the number of the recorded modifications
+      */
+      size_t size() const;
+
+      /**
+      * Writes the modifications of the buffers into the metric table in the order of the
+      * single threaded run, and clears the buffers
+      */
+      static void replay( graphsupport::MetricTable& table, const std::vector<MetricBuffer*>& buffers );
+
+    private:
+
+      enum Operation : unsigned char {
+        opIncInt,
+        opIncFloat,
+        opSetInvalid
+      };
+
+      struct Record {
+        unsigned event;
+        graphsupport::MetricTable::RowId row;
+        graphsupport::MetricTable::MetricId metric;
+        unsigned short handler;
+        Operation operation;
+        union {
+          int intValue;
+          float floatValue;
+        } value;
+      };
+
+      void add( graphsupport::MetricTable::RowId row, const graph::Node& node, graphsupport::MetricTable::RowKind kind, graphsupport::MetricTable::MetricId metric, Operation operation, Record& record );
+
+      unsigned event;
+      unsigned short handler;
+
+      std::vector<Record> records;
+
+      /**
+      * The graph node and the kind of a modified row
+      */
+      struct RowNode {
+        graphsupport::MetricTable::RowId row;
+        graph::Node node;
+        graphsupport::MetricTable::RowKind kind;
+      };
+
+      /**
+      * The graph nodes of the modified rows (consecutive modifications mostly refer to the same row)
+      */
+      std::vector<RowNode> nodes;
+  };
+
+}}}
+
+#endif
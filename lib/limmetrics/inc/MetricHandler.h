@@ -26,6 +26,7 @@
 #include "NodeWrapper.h"
 
 #include "graphsupport/inc/GraphConstants.h"
+#include "graphsupport/inc/MetricTable.h"
 
 #include <map>
 #include <functional>
@@ -106,6 +107,11 @@ namespace columbus { namespace lim { namespace metrics {
       */
       void setCalculatedFor( const std::set<std::string>& c );
 
+      /**
+      * Setter for the id of this metric in the metric table the values are stored in
+      */
+      void setMetricId( graphsupport::MetricTable::MetricId id );
+
       //
       // DISPATCH
       //
@@ -170,6 +176,11 @@ namespace columbus { namespace lim { namespace metrics {
       std::string name;
       MetricDataTypes type;
 
+      /**
+      * The id of the metric in the metric table (resolved once, see RulParser::registerMetrics)
+      */
+      graphsupport::MetricTable::MetricId metricId;
+
       bool enabled;
       bool dependency;
 
@@ -23,9 +23,12 @@
 
 #include "lim/inc/lim.h"
 #include "graph/inc/graph.h"
+#include "graphsupport/inc/MetricTable.h"
 
 namespace columbus { namespace lim { namespace metrics {
 
+  class MetricBuffer;
+
   /**
   * The NodeWrapper class encapsulates a LIM and a GRAPH node and adds helper
   * methods that make common, metrics related tasks easier.
@@ -49,9 +52,14 @@ namespace columbus { namespace lim { namespace metrics {
       * lim graph. The corresponding graph node is automatically loaded using a
       * unique id obtained from the lim node.
       */
-      NodeWrapper() {}
+      NodeWrapper() : limNode( nullptr ), graph( nullptr ), table( nullptr ), buffer( nullptr ) {}
       NodeWrapper( const asg::base::Base& limNode, graph::Graph& graph );
 
+      /**
+      * Constructs a node wrapper for an already looked up graph node
+      */
+      NodeWrapper( const asg::base::Base& limNode, graph::Graph& graph, const graph::Node& graphNode );
+
       //
       // GETTERS
       //
@@ -85,17 +93,41 @@ namespace columbus { namespace lim { namespace metrics {
       */
       bool getIsVariant() const;
 
+      /**
+      * Getter/setter for the buffer which collects the metric modifications instead of the graph
+      * (only used by the parallel computation, see ParallelLimMetrics)
+      */
+      MetricBuffer* getMetricBuffer() const;
+      void setMetricBuffer( MetricBuffer* buffer );
+
+      /**
+      * Getter/setter for the metric table which stores the metric values of the node
+      * (its row is the id of the lim node and its row kind is the node kind of the lim node).
+      * Without a table the graph node is modified directly.
+      */
+      graphsupport::MetricTable* getMetricTable() const;
+      void setMetricTable( graphsupport::MetricTable* table );
+
       //
       // GRAPH HELPERS
       //
 
       /**
       * Metric value setters/incrementers
+      * (with a metric table or a metric buffer the metric must be registered in the table)
       */
       void addMetric( const std::string& metric, int value );
       void addMetric( const std::string& metric, float value );
       void setInvalid( const std::string& metric );
 
+      /**
+      * Metric value setters/incrementers by the id of the metric in the metric table
+      * (the node must have a metric table or a metric buffer)
+      */
+      void addMetric( graphsupport::MetricTable::MetricId metric, int value );
+      void addMetric( graphsupport::MetricTable::MetricId metric, float value );
+      void setInvalid( graphsupport::MetricTable::MetricId metric );
+
       /**
       * Metric value getters
       */
@@ -122,11 +154,23 @@ namespace columbus { namespace lim { namespace metrics {
 
       static bool isParentClass( const asg::base::Base& node );
 
+      /**
+      * The id of the metric in the metric table (throws if the metric is not registered)
+      */
+      graphsupport::MetricTable::MetricId getMetricId( const std::string& metric ) const;
+
+      /**
+      * The kind of the row of the node in the metric table
+      */
+      graphsupport::MetricTable::RowKind getRowKind() const;
+
       static asg::Language lnk2limLang( asg::LanguageKind kind );
 
       const asg::base::Base* limNode;
       graph::Node graphNode;
       graph::Graph* graph;
+      graphsupport::MetricTable* table;
+      MetricBuffer* buffer;
   };
 
 }}}
@@ -0,0 +1,97 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _PARALLEL_LIM_METRICS_H_
+#define _PARALLEL_LIM_METRICS_H_
+
+#include "LimMetrics.h"
+
+#include <memory>
+#include <vector>
+
+namespace columbus { namespace lim { namespace metrics {
+
+  /**
+  * Computes the metrics of the LIM on several threads.
+  *
+  * The "on" metric handlers are partitioned into groups which are independent of each
+  * other according to MetricHandler::getDependencies (e.g. RFC, NLM and NOI end up in the
+  * same group). The groups are distributed among lanes, every lane runs a LimMetricsVisitor
+  * with its own shared containers, so the traversal state (the package/class/method stacks)
+  * and the aggregated values (the scope, component and file infos) are never shared between
+  * threads. The lanes only record the metric modifications, which are written into the metric
+  * table by the calling thread when every lane is finished, in the same order as in the single
+  * threaded run. So every graph node is modified by exactly one thread and the result is the
+  * same as the result of LimMetricsVisitor.
+  *
+  * The LIM is materialized and its reverse edges are built before the lanes are started,
+  * after that it is only read.
+  */
+  class ParallelLimMetrics {
+
+    public:
+
+      /**
+      * The "outside" information (overrides, factory, LCOMMap) is taken from the given shared
+      * containers, the inheritance helper is created for every lane (its caches are not thread safe)
+      */
+      ParallelLimMetrics( asg::Factory& factory, graph::Graph& graph, rul::RulHandler& rul, SharedContainers& shared, unsigned maxThreads );
+      ~ParallelLimMetrics();
+
+      /**
+      * Stores the metric values in the given table, which has to be materialized into the
+      * graph by the caller. Without a table an own one is used and materialized by run()
+      */
+      void setMetricTable( graphsupport::MetricTable* table );
+
+      void run();
+
+    private:
+
+      /**
+      * A lane computes one or more independent handler groups on one thread
+      */
+      struct Lane {
+        std::set<std::string> handlers;
+        SharedContainers shared;
+        std::unique_ptr<InheritanceHelper> inheritance;
+        MetricBuffer buffer;
+        std::unique_ptr<LimMetricsVisitor> visitor;
+      };
+
+      /**
+      * Distributes the handler groups among at most maxThreads lanes (greedily, the largest group first)
+      */
+      void createLanes( const std::vector<std::vector<std::string>>& groups );
+
+      asg::Factory& factory;
+      graph::Graph& graph;
+      rul::RulHandler& rul;
+      SharedContainers& shared;
+      unsigned maxThreads;
+      graphsupport::MetricTable* table;
+      std::unique_ptr<graphsupport::MetricTable> ownTable;
+
+      std::vector<std::unique_ptr<Lane>> lanes;
+  };
+
+}}}
+
+#endif
@@ -57,6 +57,27 @@ namespace columbus { namespace lim { namespace metrics {
       */
       void phaseOver( DispatchPhases phase );
 
+      /**
+      * Collects the groups of the "on" metric handlers which are independent of each other, i.e.
+      * there is no dependency between two handlers of different groups (the groups are the
+      * connected components of the dependency graph, listed in dependency order)
+      * Can only be used after run()
+      */
+      void getIndependentGroups( std::vector<std::vector<std::string>>& groups ) const;
+
+      /**
+      * Restricts the dispatch to the given handlers (their position in the dependency order is kept)
+      * Can only be used after run()
+      */
+      void selectHandlers( const std::set<std::string>& ids );
+
+      /**
+      * Registers the metrics of the "on" handlers in the given metric table, so the
+      * handlers can address their values by the resolved metric ids
+      * Can only be used after run()
+      */
+      void registerMetrics( graphsupport::MetricTable& table );
+
     private:
 
       /**
@@ -83,6 +104,12 @@ namespace columbus { namespace lim { namespace metrics {
       std::map<std::string, MetricHandler*> handlerMap;
       std::vector<std::string> handlerOrder;
 
+      /**
+      * The handlers to be dispatched (resolved from handlerOrder) and their positions in handlerOrder
+      */
+      std::vector<MetricHandler*> dispatchOrder;
+      std::vector<unsigned> dispatchPositions;
+
       /**
       * The original rul handler
       */
@@ -49,7 +49,11 @@ namespace columbus { namespace lim { namespace metrics {
     rul( make_unique<RulParser>( rul, shared ) ),
     reverseEdges( factory.getReverseEdges() ),
     phase( phaseVisit ),
-    useVisitEnd( true )
+    useVisitEnd( true ),
+    buffer( NULL ),
+    table( NULL ),
+    ownTable(),
+    graphNodes()
   {
     ap.setVisitSpecialNodes(true, true);
     ap.setCrossEdgeToTraversal(lim::asg::edkScope_HasMember);
@@ -62,7 +66,11 @@ namespace columbus { namespace lim { namespace metrics {
     rul( move(rulParser) ),
     reverseEdges( factory.getReverseEdges() ),
     phase( phaseVisit ),
-    useVisitEnd( true )
+    useVisitEnd( true ),
+    buffer( NULL ),
+    table( NULL ),
+    ownTable(),
+    graphNodes()
   {
     ap.setVisitSpecialNodes(true, true);
     ap.setCrossEdgeToTraversal(lim::asg::edkScope_HasMember);
@@ -77,6 +85,12 @@ namespace columbus { namespace lim { namespace metrics {
 
   void LimMetricsVisitor::run() {
     rul->run();
+    if ( ! table ) {
+      ownTable = make_unique<graphsupport::MetricTable>( graph );
+      table = ownTable.get();
+    }
+    rul->registerMetrics( *table );
+
     // main run
     WriteMsg::write( CMSG_LIMMETRICS_PHASE, "Visit" );
     apRun();
@@ -101,6 +115,19 @@ namespace columbus { namespace lim { namespace metrics {
     WriteMsg::write( CMSG_LIMMETRICS_PHASE_OVER, "Finalize" );
     rul->phaseOver( phaseFinalize );
 
+    if ( ownTable ) {
+      ownTable->materialize();
+      ownTable.reset();
+      table = NULL;
+    }
+  }
+
+  void LimMetricsVisitor::setMetricBuffer( MetricBuffer* buffer ) {
+    this->buffer = buffer;
+  }
+
+  void LimMetricsVisitor::setMetricTable( graphsupport::MetricTable* table ) {
+    this->table = table;
   }
 
   void LimMetricsVisitor::apRun() {
@@ -155,17 +182,45 @@ namespace columbus { namespace lim { namespace metrics {
 
   void LimMetricsVisitor::begin( const base::Base& node ) {
     VISIT_DEBUG( "begin" );
-    NodeWrapper nw( node, graph );
+    NodeWrapper nw = wrap( node );
+    if ( buffer ) {
+      buffer->nextEvent();
+      nw.setMetricBuffer( buffer );
+    }
     rul->dispatch( phase, nw );
   }
 
   void LimMetricsVisitor::end( const base::Base& node ) {
     if ( useVisitEnd ) {
       VISIT_DEBUG( "end" );
-      NodeWrapper nw( node, graph );
+      NodeWrapper nw = wrap( node );
+      if ( buffer ) {
+        buffer->nextEvent();
+        nw.setMetricBuffer( buffer );
+      }
       rul->dispatch( phaseVisitEnd, nw );
     }
   }
-   
-}}}
 
+  NodeWrapper LimMetricsVisitor::wrap( const base::Base& node ) {
+    NodeId id = node.getId();
+    if ( id >= graphNodes.size() ) {
+      graphNodes.resize( max( (size_t) id + 1, graphNodes.size() * 2 ) );
+    }
+
+    if ( graphNodes[id] == graph::Graph::invalidNode ) {
+      NodeWrapper nw( node, graph );
+      graphNodes[id] = nw.getGraphNode();
+      // with a buffer the table is only read, the row is bound when the buffer is replayed
+      if ( table && ! buffer ) {
+        table->setNode( id, graphNodes[id], (graphsupport::MetricTable::RowKind) node.getNodeKind() );
+      }
+      nw.setMetricTable( table );
+      return nw;
+    }
+    NodeWrapper nw( node, graph, graphNodes[id] );
+    nw.setMetricTable( table );
+    return nw;
+  }
+
+}}}
@@ -0,0 +1,155 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/MetricBuffer.h"
+
+#include <queue>
+
+using namespace std;
+using namespace columbus::graph;
+using namespace columbus::graphsupport;
+
+namespace columbus { namespace lim { namespace metrics {
+
+  MetricBuffer::MetricBuffer() :
+    event( 0 ),
+    handler( 0 ),
+    records(),
+    nodes()
+  {}
+
+  void MetricBuffer::nextEvent() {
+    ++event;
+    handler = 0;
+  }
+
+  void MetricBuffer::setHandler( unsigned position ) {
+    handler = (unsigned short) position;
+  }
+
+  void MetricBuffer::addMetric( MetricTable::RowId row, const Node& node, MetricTable::RowKind kind, MetricTable::MetricId metric, int value ) {
+    Record record;
+    record.value.intValue = value;
+    add( row, node, kind, metric, opIncInt, record );
+  }
+
+  void MetricBuffer::addMetric( MetricTable::RowId row, const Node& node, MetricTable::RowKind kind, MetricTable::MetricId metric, float value ) {
+    Record record;
+    record.value.floatValue = value;
+    add( row, node, kind, metric, opIncFloat, record );
+  }
+
+  void MetricBuffer::setInvalid( MetricTable::RowId row, const Node& node, MetricTable::RowKind kind, MetricTable::MetricId metric ) {
+    Record record;
+    record.value.intValue = 0;
+    add( row, node, kind, metric, opSetInvalid, record );
+  }
+
+  size_t MetricBuffer::size() const {
+    return records.size();
+  }
+
+  void MetricBuffer::add( MetricTable::RowId row, const Node& node, MetricTable::RowKind kind, MetricTable::MetricId metric, Operation operation, Record& record ) {
+    if ( nodes.empty() || nodes.back().row != row ) {
+      nodes.push_back( RowNode{ row, node, kind } );
+    }
+
+    record.event = event;
+    record.row = row;
+    record.metric = metric;
+    record.handler = handler;
+    record.operation = operation;
+    records.push_back( record );
+  }
+
+  void MetricBuffer::replay( MetricTable& table, const vector<MetricBuffer*>& buffers ) {
+
+    for ( MetricBuffer* buffer : buffers ) {
+      for ( const RowNode& rowNode : buffer->nodes ) {
+        if ( ! table.hasNode( rowNode.row ) ) {
+          table.setNode( rowNode.row, rowNode.node, rowNode.kind );
+        }
+      }
+    }
+
+    // The records of a buffer are already ordered, so a k-way merge is enough
+    struct Cursor {
+      MetricBuffer* buffer;
+      size_t index;
+    };
+
+    auto later = []( const Cursor& a, const Cursor& b ) {
+      const Record& ra = a.buffer->records[a.index];
+      const Record& rb = b.buffer->records[b.index];
+      if ( ra.event != rb.event ) {
+        return ra.event > rb.event;
+      }
+      return ra.handler > rb.handler;
+    };
+
+    priority_queue<Cursor, vector<Cursor>, decltype(later)> queue( later );
+    for ( MetricBuffer* buffer : buffers ) {
+      if ( ! buffer->records.empty() ) {
+        queue.push( Cursor{ buffer, 0 } );
+      }
+    }
+
+    while ( ! queue.empty() ) {
+      Cursor cursor = queue.top();
+      queue.pop();
+
+      MetricBuffer& buffer = *cursor.buffer;
+      unsigned event = buffer.records[cursor.index].event;
+      unsigned short handler = buffer.records[cursor.index].handler;
+
+      // The modifications of the same handler for the same event are written in one go
+      for ( ; cursor.index < buffer.records.size(); ++cursor.index ) {
+        const Record& record = buffer.records[cursor.index];
+        if ( record.event != event || record.handler != handler ) {
+          break;
+        }
+
+        switch ( record.operation ) {
+          case opIncInt:
+            table.incMetricInt( record.row, record.metric, record.value.intValue );
+            break;
+          case opIncFloat:
+            table.incMetricFloat( record.row, record.metric, record.value.floatValue );
+            break;
+          case opSetInvalid:
+            table.setMetricINVALID( record.row, record.metric );
+            break;
+        }
+      }
+
+      if ( cursor.index < buffer.records.size() ) {
+        queue.push( cursor );
+      }
+    }
+
+    for ( MetricBuffer* buffer : buffers ) {
+      buffer->records = vector<Record>();
+      buffer->nodes = vector<RowNode>();
+      buffer->event = 0;
+      buffer->handler = 0;
+    }
+  }
+
+}}}
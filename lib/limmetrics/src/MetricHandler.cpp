@@ -29,10 +29,10 @@ using namespace columbus::graphsupport::graphconstants;
 namespace columbus { namespace lim { namespace metrics {
 
   MetricHandler::MetricHandler() :
-    name( "Undefined" ), type( mdtInt ), enabled( false ), dependency( false ), shared( NULL ) {}
+    name( "Undefined" ), type( mdtInt ), metricId( graphsupport::MetricTable::invalidMetricId ), enabled( false ), dependency( false ), shared( NULL ) {}
 
   MetricHandler::MetricHandler( const string& name, MetricDataTypes type, bool enabled, SharedContainers* shared ) :
-      name( name ), type( type ), enabled( enabled ), dependency( false ), shared( shared )
+      name( name ), type( type ), metricId( graphsupport::MetricTable::invalidMetricId ), enabled( enabled ), dependency( false ), shared( shared )
   {
     WriteMsg::write( CMSG_LIMMETRICS_HANDLER_CREATED, name.c_str() );
   }
@@ -73,6 +73,10 @@ namespace columbus { namespace lim { namespace metrics {
     calc = c;
   }
 
+  void MetricHandler::setMetricId( graphsupport::MetricTable::MetricId id ) {
+    metricId = id;
+  }
+
   void MetricHandler::dispatch( DispatchPhases phase, NodeWrapper& node ) {
     HandlerFunction* function = NULL;
     
@@ -242,7 +246,11 @@ namespace columbus { namespace lim { namespace metrics {
       throw Exception( COLUMBUS_LOCATION, CMSG_LIMMETRICS_EX_INVALID_METRIC_TYPE( name ) );
     }
     if ( enabled && isCalculatedFor(node) ) {
-      node.addMetric( name, value );
+      if ( metricId != graphsupport::MetricTable::invalidMetricId ) {
+        node.addMetric( metricId, value );
+      } else {
+        node.addMetric( name, value );
+      }
     } else {
       WriteMsg::write( CMSG_LIMMETRICS_DISABLED_METRIC, name.c_str() );
     }
@@ -253,7 +261,11 @@ namespace columbus { namespace lim { namespace metrics {
       throw Exception( COLUMBUS_LOCATION, CMSG_LIMMETRICS_EX_INVALID_METRIC_TYPE( name ) );
     }
     if ( enabled && isCalculatedFor(node) ) {
-      node.addMetric( name, (float)value );
+      if ( metricId != graphsupport::MetricTable::invalidMetricId ) {
+        node.addMetric( metricId, (float)value );
+      } else {
+        node.addMetric( name, (float)value );
+      }
     } else {
       WriteMsg::write( CMSG_LIMMETRICS_DISABLED_METRIC, name.c_str() );
     }
@@ -261,7 +273,11 @@ namespace columbus { namespace lim { namespace metrics {
 
   void MetricHandler::setInvalid( NodeWrapper& node ) {
     if ( enabled && isCalculatedFor(node) ) {
-      node.setInvalid( name );
+      if ( metricId != graphsupport::MetricTable::invalidMetricId ) {
+        node.setInvalid( metricId );
+      } else {
+        node.setInvalid( name );
+      }
     } else {
       WriteMsg::write( CMSG_LIMMETRICS_DISABLED_METRIC, name.c_str() );
     }
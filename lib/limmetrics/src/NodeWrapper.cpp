@@ -20,6 +20,7 @@
 
 #include "../inc/NodeWrapper.h"
 #include "../inc/Messages.h"
+#include "../inc/MetricBuffer.h"
 
 #include "common/inc/WriteMessage.h"
 #include "graphsupport/inc/GraphConstants.h"
@@ -33,13 +34,16 @@ using namespace columbus::graphsupport::graphconstants;
 
 namespace columbus { namespace lim { namespace metrics {
 
-  NodeWrapper::NodeWrapper( const base::Base& limNode, Graph& graph ) : limNode( &limNode ), graph( &graph ) {
+  NodeWrapper::NodeWrapper( const base::Base& limNode, Graph& graph ) : limNode( &limNode ), graph( &graph ), table( nullptr ), buffer( nullptr ) {
     graphNode = graph.findNode( lim2graph::VisitorGraphConverter::determineNodeName( limNode ) );
     if ( this->graphNode == graph::Graph::invalidNode ) {
       throw Exception( COLUMBUS_LOCATION, CMSG_LIMMETRICS_EX_INVALID_GRAPH_NODE( Common::toString( limNode.getId() ) ) );
     }
   }
 
+  NodeWrapper::NodeWrapper( const base::Base& limNode, Graph& graph, const Node& graphNode ) :
+    limNode( &limNode ), graphNode( graphNode ), graph( &graph ), table( nullptr ), buffer( nullptr ) {}
+
   const Node& NodeWrapper::getGraphNode() const {
     return graphNode;
   }
@@ -120,24 +124,99 @@ namespace columbus { namespace lim { namespace metrics {
     return false; // TODO temporary
   }
 
+  MetricBuffer* NodeWrapper::getMetricBuffer() const {
+    return buffer;
+  }
+
+  void NodeWrapper::setMetricBuffer( MetricBuffer* buffer ) {
+    this->buffer = buffer;
+  }
+
+  graphsupport::MetricTable* NodeWrapper::getMetricTable() const {
+    return table;
+  }
+
+  void NodeWrapper::setMetricTable( graphsupport::MetricTable* table ) {
+    this->table = table;
+  }
+
+  graphsupport::MetricTable::MetricId NodeWrapper::getMetricId( const std::string& metric ) const {
+    graphsupport::MetricTable::MetricId id = table ? table->findMetric( metric ) : graphsupport::MetricTable::invalidMetricId;
+    if ( id == graphsupport::MetricTable::invalidMetricId ) {
+      throw Exception( COLUMBUS_LOCATION, CMSG_LIMMETRICS_EX_UNREGISTERED_METRIC( metric ) );
+    }
+    return id;
+  }
+
   void NodeWrapper::addMetric( const std::string& metric, int value ) {
     //cout << "  " << limNode->getId() << "(" << Common::to_string(limNode->getNodeKind()) << ") --> " << metric << "= " << value << endl;
+    if ( table || buffer ) {
+      addMetric( getMetricId( metric ), value );
+      return;
+    }
     columbus::graphsupport::incMetricInt(*graph, graphNode, metric, value);
   }
 
   void NodeWrapper::addMetric( const std::string& metric, float value ) {
     //cout << "  " << limNode->getId() << "(" << Common::to_string(limNode->getNodeKind()) << ") --> " << metric << "= " << value << endl;
-    if (std::isnan(value))
-      columbus::graphsupport::setMetricINVALID(*graph, graphNode, metric);
-    else
-      columbus::graphsupport::incMetricFloat(*graph, graphNode, metric, value);
+    if (std::isnan(value)) {
+      setInvalid(metric);
+      return;
+    }
+    if ( table || buffer ) {
+      addMetric( getMetricId( metric ), value );
+      return;
+    }
+    columbus::graphsupport::incMetricFloat(*graph, graphNode, metric, value);
   }
 
   void NodeWrapper::setInvalid( const std::string& metric ) {
+    if ( table || buffer ) {
+      setInvalid( getMetricId( metric ) );
+      return;
+    }
     columbus::graphsupport::setMetricINVALID(*graph, graphNode, metric);
   }
 
+  void NodeWrapper::addMetric( graphsupport::MetricTable::MetricId metric, int value ) {
+    if ( buffer ) {
+      buffer->addMetric( limNode->getId(), graphNode, getRowKind(), metric, value );
+      return;
+    }
+    table->incMetricInt( limNode->getId(), metric, value );
+  }
+
+  void NodeWrapper::addMetric( graphsupport::MetricTable::MetricId metric, float value ) {
+    if (std::isnan(value)) {
+      setInvalid(metric);
+      return;
+    }
+    if ( buffer )
+      buffer->addMetric( limNode->getId(), graphNode, getRowKind(), metric, value );
+    else
+      table->incMetricFloat( limNode->getId(), metric, value );
+  }
+
+  void NodeWrapper::setInvalid( graphsupport::MetricTable::MetricId metric ) {
+    if ( buffer ) {
+      buffer->setInvalid( limNode->getId(), graphNode, getRowKind(), metric );
+      return;
+    }
+    table->setMetricINVALID( limNode->getId(), metric );
+  }
+
+  graphsupport::MetricTable::RowKind NodeWrapper::getRowKind() const {
+    return (graphsupport::MetricTable::RowKind) limNode->getNodeKind();
+  }
+
   int NodeWrapper::getIntMetric(const std::string& metric) {
+    if ( table ) {
+      graphsupport::MetricTable::MetricId id = table->findMetric( metric );
+      int value = 0;
+      if ( id != graphsupport::MetricTable::invalidMetricId && table->getMetricInt( limNode->getId(), id, value ) ) {
+        return value;
+      }
+    }
     graph::Attribute::AttributeIterator aIt = graphNode.findAttributeByName(metric);
     if (aIt.hasNext()) {
       return ((graph::AttributeInt&)aIt.next()).getValue();
@@ -148,6 +227,13 @@ namespace columbus { namespace lim { namespace metrics {
   }
 
   float NodeWrapper::getFloatMetric(const std::string& metric) {
+    if ( table ) {
+      graphsupport::MetricTable::MetricId id = table->findMetric( metric );
+      float value = 0;
+      if ( id != graphsupport::MetricTable::invalidMetricId && table->getMetricFloat( limNode->getId(), id, value ) ) {
+        return value;
+      }
+    }
     graph::Attribute::AttributeIterator aIt = graphNode.findAttributeByName(metric);
     if (aIt.hasNext()) {
       return ((graph::AttributeFloat&)aIt.next()).getValue();
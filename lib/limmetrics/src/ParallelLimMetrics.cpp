@@ -0,0 +1,165 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include "../inc/ParallelLimMetrics.h"
+#include "../inc/Messages.h"
+
+#include <common/inc/WriteMessage.h>
+#include <threadpool/inc/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace common;
+using namespace columbus::lim::asg;
+
+namespace columbus { namespace lim { namespace metrics {
+
+  ParallelLimMetrics::ParallelLimMetrics( Factory& factory, graph::Graph& graph, rul::RulHandler& rul, SharedContainers& shared, unsigned maxThreads ) :
+    factory( factory ),
+    graph( graph ),
+    rul( rul ),
+    shared( shared ),
+    maxThreads( max( maxThreads, 1u ) ),
+    table( NULL ),
+    ownTable(),
+    lanes()
+  {}
+
+  ParallelLimMetrics::~ParallelLimMetrics() {}
+
+  void ParallelLimMetrics::setMetricTable( graphsupport::MetricTable* table ) {
+    this->table = table;
+  }
+
+  void ParallelLimMetrics::run() {
+
+    // the lazy parts of the factory are not thread safe
+    factory.materializeAll();
+    factory.getReverseEdges();
+
+    if ( ! table ) {
+      ownTable = make_unique<graphsupport::MetricTable>( graph );
+      table = ownTable.get();
+    }
+
+    // the groups are determined by a throwaway parser, the lanes parse the rul for themselves
+    vector<vector<string>> groups;
+    {
+      SharedContainers probeShared;
+      RulParser probe( rul, probeShared );
+      probe.run();
+      probe.getIndependentGroups( groups );
+
+      // the lanes only look up the metric ids, so the table is not modified by the threads
+      probe.registerMetrics( *table );
+    }
+
+    createLanes( groups );
+
+    unsigned threads = min( maxThreads, (unsigned) lanes.size() );
+    WriteMsg::write( CMSG_LIMMETRICS_PARALLEL_GROUPS, (unsigned) groups.size(), (unsigned) lanes.size(), threads );
+
+    if ( ! lanes.empty() ) {
+      thread::ThreadPool pool( threads );
+      vector<thread::TaskFuture<void>> futures;
+      for ( unique_ptr<Lane>& lane : lanes ) {
+        LimMetricsVisitor* visitor = lane->visitor.get();
+        futures.push_back( pool.submit( [visitor]() { visitor->run(); } ) );
+      }
+
+      // rethrows the first failure of the lanes
+      for ( thread::TaskFuture<void>& future : futures ) {
+        future.wait();
+      }
+      for ( thread::TaskFuture<void>& future : futures ) {
+        future.get();
+      }
+    }
+
+    vector<MetricBuffer*> buffers;
+    size_t modifications = 0;
+    for ( unique_ptr<Lane>& lane : lanes ) {
+      buffers.push_back( &lane->buffer );
+      modifications += lane->buffer.size();
+    }
+
+    WriteMsg::write( CMSG_LIMMETRICS_PARALLEL_REPLAY, (unsigned long) modifications );
+    MetricBuffer::replay( *table, buffers );
+
+    lanes.clear();
+
+    if ( ownTable ) {
+      ownTable->materialize();
+      ownTable.reset();
+      table = NULL;
+    }
+  }
+
+  void ParallelLimMetrics::createLanes( const vector<vector<string>>& groups ) {
+
+    vector<const vector<string>*> ordered;
+    for ( const vector<string>& group : groups ) {
+      ordered.push_back( &group );
+    }
+    stable_sort( ordered.begin(), ordered.end(), []( const vector<string>* a, const vector<string>* b ) {
+      return a->size() > b->size();
+    });
+
+    lanes.clear();
+    size_t laneCount = min( (size_t) maxThreads, groups.size() );
+    vector<size_t> weights( laneCount, 0 );
+    for ( size_t i = 0; i < laneCount; ++i ) {
+      lanes.push_back( make_unique<Lane>() );
+    }
+
+    for ( const vector<string>* group : ordered ) {
+      size_t lightest = min_element( weights.begin(), weights.end() ) - weights.begin();
+      lanes[lightest]->handlers.insert( group->begin(), group->end() );
+      weights[lightest] += group->size();
+    }
+
+    for ( size_t i = 0; i < lanes.size(); ++i ) {
+      Lane& lane = *lanes[i];
+
+      lane.inheritance = make_unique<InheritanceHelper>( factory.getReverseEdges() );
+      lane.shared.overrides = shared.overrides;
+      lane.shared.factory = shared.factory;
+      lane.shared.inheritance = lane.inheritance.get();
+      lane.shared.LCOMMap = shared.LCOMMap; // only the lane of LCOM5 writes it
+
+      unique_ptr<RulParser> parser = make_unique<RulParser>( rul, lane.shared );
+      parser->run();
+      parser->selectHandlers( lane.handlers );
+      parser->registerMetrics( *table );
+
+      lane.visitor = make_unique<LimMetricsVisitor>( factory, graph, move( parser ) );
+      lane.visitor->setMetricBuffer( &lane.buffer );
+      lane.visitor->setMetricTable( table );
+
+      string names;
+      for ( const string& handler : lane.handlers ) {
+        names += handler + " ";
+      }
+      WriteMsg::write( CMSG_LIMMETRICS_PARALLEL_LANE, (unsigned) i, names.c_str() );
+    }
+  }
+
+}}}
@@ -20,6 +20,7 @@
 
 #include "../inc/RulParser.h"
 #include "../inc/Messages.h"
+#include "../inc/MetricBuffer.h"
 
 // separate metrics headers
 #include "../inc/metrics/CBO.h"
@@ -60,6 +61,11 @@ namespace columbus { namespace lim { namespace metrics {
       parse();
       sort();
       processed = true;
+
+      for ( unsigned i = 0; i < handlerOrder.size(); ++i ) {
+        dispatchOrder.push_back( handlerMap[handlerOrder[i]] );
+        dispatchPositions.push_back( i );
+      }
     }
   }
 
@@ -263,9 +269,12 @@ namespace columbus { namespace lim { namespace metrics {
       stack( node, true ); // push
     }
 
-    vector<string>::iterator orderIt = handlerOrder.begin(), orderEnd = handlerOrder.end();
-    for ( ; orderIt != orderEnd; ++orderIt ) {
-      handlerMap[*orderIt]->dispatch( phase, node );
+    MetricBuffer* buffer = node.getMetricBuffer();
+    for ( size_t i = 0; i < dispatchOrder.size(); ++i ) {
+      if ( buffer ) {
+        buffer->setHandler( dispatchPositions[i] );
+      }
+      dispatchOrder[i]->dispatch( phase, node );
     }
 
     if ( phase == phaseVisitEnd ) {
@@ -278,6 +287,70 @@ namespace columbus { namespace lim { namespace metrics {
     shared.phaseOver( phase );
   }
 
+  void RulParser::getIndependentGroups( vector<vector<string>>& groups ) const {
+
+    // union-find over the positions of the handlers in the dependency order
+    map<string, unsigned> positions;
+    for ( unsigned i = 0; i < handlerOrder.size(); ++i ) {
+      positions[handlerOrder[i]] = i;
+    }
+
+    vector<unsigned> parents( handlerOrder.size() );
+    for ( unsigned i = 0; i < parents.size(); ++i ) {
+      parents[i] = i;
+    }
+
+    auto findRoot = [&parents]( unsigned i ) {
+      while ( parents[i] != i ) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+      }
+      return i;
+    };
+
+    for ( unsigned i = 0; i < handlerOrder.size(); ++i ) {
+      const set<string>& dependencies = handlerMap.find( handlerOrder[i] )->second->getDependencies();
+      for ( const string& dependency : dependencies ) {
+        map<string, unsigned>::const_iterator dIt = positions.find( dependency );
+        if ( dIt != positions.end() ) {
+          unsigned a = findRoot( i ), b = findRoot( dIt->second );
+          parents[max( a, b )] = min( a, b );
+        }
+      }
+    }
+
+    // the group of a handler is identified by the position of its root
+    map<unsigned, size_t> groupIndexes;
+    groups.clear();
+    for ( unsigned i = 0; i < handlerOrder.size(); ++i ) {
+      unsigned root = findRoot( i );
+      map<unsigned, size_t>::iterator gIt = groupIndexes.find( root );
+      if ( gIt == groupIndexes.end() ) {
+        gIt = groupIndexes.insert( make_pair( root, groups.size() ) ).first;
+        groups.push_back( vector<string>() );
+      }
+      groups[gIt->second].push_back( handlerOrder[i] );
+    }
+  }
+
+  void RulParser::selectHandlers( const set<string>& ids ) {
+    dispatchOrder.clear();
+    dispatchPositions.clear();
+    for ( unsigned i = 0; i < handlerOrder.size(); ++i ) {
+      if ( ids.find( handlerOrder[i] ) != ids.end() ) {
+        dispatchOrder.push_back( handlerMap[handlerOrder[i]] );
+        dispatchPositions.push_back( i );
+      }
+    }
+  }
+
+  void RulParser::registerMetrics( graphsupport::MetricTable& table ) {
+    for ( unsigned i = 0; i < handlerOrder.size(); ++i ) {
+      MetricHandler* handler = handlerMap[handlerOrder[i]];
+      handler->setMetricId( table.addMetric( handler->getName() ) );
+    }
+  }
+
   /*
   * Stack maintenance + child relations among scopes for correct aggregation
   * Besides getting pushed to the scope stack, the following happens to each scope type 
@@ -21,10 +21,12 @@
 #ifndef _STRTABLE_H
 #define _STRTABLE_H
 
-#include <map>
+#include <deque>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdio>
+#include <cstdint>
 
 namespace columbus {
 
@@ -34,6 +36,15 @@ namespace columbus {
 
 typedef unsigned Key;   // must be 32bit at least
 
+/**
+ * String table which assigns a "unique" key to every stored string.
+ *
+ * The keys are built from the 16 bit Pearson hash of the string and a per bucket counter, so they are
+ * the same as the ones produced by the earlier versions and the saved file format is unchanged. The
+ * lookups however go through two flat open addressing indexes (string -> entry, key -> entry) which
+ * use a 64 bit hash, and the entries themselves are stored in a chunked arena without per node
+ * allocations.
+ */
 class StrTable
 {
   public:
@@ -52,6 +63,9 @@ class StrTable
     // Gives back the number of buckets.
     unsigned getNumberOfBuckets() const;
 
+    // Gives back the number of the stored strings.
+    std::size_t size() const;
+
     // Inserts the given string into the string table and gives back a "unique" key.
     Key set(const char* s, StrType type = strDefault);
 
@@ -59,6 +73,9 @@ class StrTable
     
     // Inserts the given string into the string table and gives back a "unique" key.
     Key set(const std::string& s, StrType type = strDefault);
+
+    // Inserts the given string into the string table and gives back a "unique" key.
+    Key set(std::string_view s, StrType type = strDefault);
     
     // Sets the type of the given string. If the given string does not exist in the table than it inserts it 
     // with a given type. 
@@ -73,11 +90,17 @@ class StrTable
 
     // Gives back the "unique" key of the given string if it is in the string table. Otherwise it returns 0.
     Key get(const std::string& s) const;
+
+    // Gives back the "unique" key of the given string if it is in the string table. Otherwise it returns 0.
+    Key get(std::string_view s) const;
     
     // Gives back the string stored in the string table with the given "unique" key or an empty string in case 
     // there is no string in the table with that key.
     const std::string& get(const Key key) const;
 
+    // Same as get(Key), but gives back a view of the stored string.
+    std::string_view getView(const Key key) const;
+
     // Saves the string table to the given file. The file must be already opened for writing!!!!!!!!!!!
     void save(FILE* file, StrType filterType = strDefault) const;
 
@@ -94,31 +117,53 @@ class StrTable
     // Returns true if the given key is valid or false if it is invalid. 
     static bool getIsValid(Key key) { return key != 0; }
 
+    // Gives back the 64 bit hash of the given characters (the one used by the lookup indexes).
+    static std::uint64_t hash64(const char* s, std::size_t length);
+
     //  Prints out the content of the table.
     void dump();
     
   protected:
-    typedef std::map<Key, std::pair<std::string, StrType> > Map;
 
-    unsigned                       no_buckets;           // Number of buckets
+    // One stored string. The entries are never moved, so the references given back by get(Key) stay valid.
+    struct Entry {
+      std::string   str;
+      std::uint64_t hash;
+      Key           key;
+      StrType       type;
+    };
+
+    // One slot of an open addressing index. Zero entry means empty slot.
+    struct Slot {
+      std::uint32_t entry;   // index of the entry + 1
+      std::uint32_t tag;     // upper half of the hash of the slot (filters out most of the false matches)
+    };
+
+    unsigned                       no_buckets;           // Number of buckets (only used for the key generation)
     std::vector<unsigned short>    count;                // Internal counter for each bucket 
-    std::vector<Map>               str_table;            // The string table 
+    std::deque<Entry>              entries;              // The string arena
+    std::vector<Slot>              str_index;            // string -> entry index
+    std::vector<Slot>              key_index;            // key -> entry index
 
 
     unsigned short hash(const char* pString) const;     
     unsigned short hash(const char* pString, unsigned long length) const;     
-    Key get(const char* s, std::size_t length, unsigned short hash_value, unsigned bucket_index) const;
+
+    static std::uint64_t hashKey(Key key);
+
+    Key find(const char* s, std::size_t length, std::uint64_t hash_value) const;
+    const Entry* findEntry(Key key) const;
+    Entry* findEntry(Key key);
+    Key insert(const char* s, std::size_t length, std::uint64_t hash_value, StrType type);
+    void addEntry(const char* s, std::size_t length, std::uint64_t hash_value, Key key, StrType type);
+    void indexEntry(std::uint32_t entryIndex);
+    void grow();
+    void reset(unsigned buckets);
+
+    // Gives back the indexes of the entries in the order of the saved file format (bucket, key).
+    std::vector<std::uint32_t> getSaveOrder() const;
 
     void copy(const StrTable& st); 
-#ifdef DOSTAT    
-    struct table_stat {
-      unsigned long      element_count;
-      unsigned long      number_of_search;
-      unsigned long long number_of_it;
-    };
-    
-    table_stat* statistic_counter;
-#endif
 
 };
 
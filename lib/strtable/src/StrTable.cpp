@@ -18,6 +18,7 @@
  *  limitations under the Licence.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <common/inc/WriteMessage.h>
@@ -28,6 +29,10 @@
 static_assert(sizeof(unsigned) >= 4, "Size of the 'unsigned' is expected to be greater than or equal to 4 bytes!");
 static_assert(sizeof(unsigned short) >= 2, "Size of the 'unsigned short' is expected to be greater than or equal to 2 bytes!");
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #define CHECKIO(instr, error_msg)    \
 if (!(instr)) {  \
     common::WriteMsg::writeToErr( common::WriteMsg::mlError, error_msg); \
@@ -56,68 +61,98 @@ unsigned char random_numbers[] =  /* Table from p. 678.*/
    163,200,222,235,248,243,219, 10,152,131,123,229,203, 76,120,209
 };
 
-StrTable::StrTable(const unsigned buckets) : no_buckets(buckets), count(), str_table()
-#ifdef DOSTAT
-  , statistic_counter(NULL)
-#endif  
-{
-  str_table.resize(no_buckets);
-  count.resize(no_buckets, 1);
+namespace {
+
+  // Initial size of the open addressing indexes (must be a power of two).
+  const std::size_t initialIndexSize = 1024;
+
+  // Constants of the 64 bit hash (from wyhash).
+  const std::uint64_t secret0 = 0xa0761d6478bd642full;
+  const std::uint64_t secret1 = 0xe7037ed1a0b428dbull;
+  const std::uint64_t secret2 = 0x8ebc6af09c88c6e3ull;
+
+  inline std::uint64_t mum(std::uint64_t a, std::uint64_t b)
+  {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)a * b;
+    return (std::uint64_t)r ^ (std::uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    std::uint64_t hi;
+    std::uint64_t lo = _umul128(a, b, &hi);
+    return lo ^ hi;
+#else
+    std::uint64_t ha = a >> 32, hb = b >> 32, la = (std::uint32_t)a, lb = (std::uint32_t)b;
+    std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t c = t < rl;
+    std::uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+  }
 
-#ifdef DOSTAT
-  statistic_counter = (table_stat*)calloc(no_buckets , sizeof(table_stat));
-  if (!statistic_counter) {
-    common::WriteMsg::writeToErr( CMSG_ERROR_MEMORY_ALLOCATION);
-    abort();
+  inline std::uint64_t read64(const unsigned char* p)
+  {
+    std::uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
   }
-#endif
+
+  inline std::uint64_t read32(const unsigned char* p)
+  {
+    std::uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+  }
+
+  // Reads 1-3 bytes.
+  inline std::uint64_t read3(const unsigned char* p, std::size_t k)
+  {
+    return (((std::uint64_t)p[0]) << 16) | (((std::uint64_t)p[k >> 1]) << 8) | p[k - 1];
+  }
+
+}
+
+StrTable::StrTable(const unsigned buckets) : no_buckets(), count(), entries(), str_index(), key_index()
+{
+  reset(buckets);
 }
 
-StrTable::StrTable(const StrTable& st) : no_buckets(), count(), str_table()
-#ifdef DOSTAT
-  , statistic_counter(NULL)
-#endif  
+StrTable::StrTable(const StrTable& st) : no_buckets(), count(), entries(), str_index(), key_index()
 {
   copy(st);
 }
 
 StrTable::~StrTable()
 {
-#ifdef DOSTAT
-  for (unsigned i = 0; i < no_buckets; i++)
-    fprintf(stderr, "%03d[noe:%08lu nos:%08lu noit:%020llu avg:%.2lf]\n", i, statistic_counter[i].element_count, statistic_counter[i].number_of_search, statistic_counter[i].number_of_it, (double)statistic_counter[i].number_of_it / statistic_counter[i].number_of_search);
-
-  free(statistic_counter);
-#endif
 }
 
-void StrTable::copy(const StrTable& st)
+void StrTable::reset(unsigned buckets)
 {
-  no_buckets = st.no_buckets;
-
-#ifdef DOSTAT
-  free(statistic_counter);
-
-  statistic_counter = (table_stat*)calloc(no_buckets , sizeof(table_stat));
-  if (!statistic_counter) {
-    common::WriteMsg::writeToErr( CMSG_ERROR_MEMORY_ALLOCATION);
-    abort();
-  }
-#endif
+  no_buckets = buckets ? buckets : 1;
 
   count.clear();
-  count.resize(no_buckets);
+  count.resize(no_buckets, 1);
 
-  str_table.clear();
-  str_table.resize(no_buckets);
+  entries.clear();
 
-  for (unsigned i = 0; i < no_buckets; i++) {
-    count[i] = st.count[i];
+  str_index.clear();
+  str_index.resize(initialIndexSize, Slot{0, 0});
+  key_index.clear();
+  key_index.resize(initialIndexSize, Slot{0, 0});
+}
 
-    for (Map::const_iterator it = st.str_table[i].begin(); it != st.str_table[i].end(); ++it) {
-      str_table[i].insert(Map::value_type(it->first, std::make_pair(it->second.first, it->second.second)));
-    }
-  }
+void StrTable::copy(const StrTable& st)
+{
+  if (this == &st)
+    return;
+
+  no_buckets = st.no_buckets;
+  count = st.count;
+  entries = st.entries;
+  str_index = st.str_index;
+  key_index = st.key_index;
 }
 
 StrTable& StrTable::operator=(const StrTable& rhs)
@@ -131,6 +166,46 @@ unsigned StrTable::getNumberOfBuckets() const
   return no_buckets;
 }
 
+std::size_t StrTable::size() const
+{
+  return entries.size();
+}
+
+std::uint64_t StrTable::hash64(const char* s, std::size_t length)
+{
+  const unsigned char* p = (const unsigned char*)s;
+  std::uint64_t seed = secret0 ^ mum(secret0 ^ length, secret1);
+  std::uint64_t a, b;
+
+  if (length <= 16) {
+    if (length >= 4) {
+      a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+      b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+    } else if (length > 0) {
+      a = read3(p, length);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    std::size_t i = length;
+    while (i > 16) {
+      seed = mum(read64(p) ^ secret1, read64(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+    a = read64(p + i - 16);
+    b = read64(p + i - 8);
+  }
+
+  return mum(secret1 ^ length, mum(a ^ secret1, b ^ seed) ^ secret2);
+}
+
+std::uint64_t StrTable::hashKey(Key key)
+{
+  return mum((std::uint64_t)key ^ secret0, secret1);
+}
+
 /* Hashing function described in                   */
 /* "Fast Hashing of Variable-Length Text Strings," */
 /* by Peter K. Pearson, CACM, June 1990.           */
@@ -184,70 +259,162 @@ unsigned short StrTable::hash(const char* string,unsigned long length) const
   return (hash_hi << 8) | hash_low;
 }
 
-Key StrTable::set(const std::string& s, StrType type)
+Key StrTable::find(const char* s, std::size_t length, std::uint64_t hash_value) const
 {
-  return set(s.c_str(), (unsigned)s.size(), type);
+  // It does not check the s because it is already checked in StrTable::set or in StrTable::get.
+  const std::size_t mask = str_index.size() - 1;
+  const std::uint32_t tag = (std::uint32_t)(hash_value >> 32);
+
+  for (std::size_t pos = hash_value & mask; ; pos = (pos + 1) & mask) {
+    const Slot& slot = str_index[pos];
+    if (!slot.entry)
+      return 0;
+
+    if (slot.tag == tag) {
+      const Entry& entry = entries[slot.entry - 1];
+      if (entry.str.length() == length && memcmp(entry.str.data(), s, length) == 0)
+        return entry.key;
+    }
+  }
 }
 
-Key StrTable::set(const char* s, unsigned length, StrType type)
+const StrTable::Entry* StrTable::findEntry(Key key) const
 {
-  if (s == NULL)
-    return 0;
+  if (!key)
+    return NULL;
 
-  if(length == 0)
-    return 0;
+  const std::size_t mask = key_index.size() - 1;
 
-  Key key;
-  unsigned short hash_value = hash(s, length);
-  unsigned bucket_index = hash_value % no_buckets;
+  for (std::size_t pos = hashKey(key) & mask; ; pos = (pos + 1) & mask) {
+    const Slot& slot = key_index[pos];
+    if (!slot.entry)
+      return NULL;
 
-  // If the string does not exists in the table we insert it
-  if (!(key = get(s,length, hash_value, bucket_index))) {
+    if (slot.tag == key)
+      return &entries[slot.entry - 1];
+  }
+}
 
-    key = ((Key)hash_value << 16) | count[bucket_index]++;
+StrTable::Entry* StrTable::findEntry(Key key)
+{
+  return const_cast<Entry*>(static_cast<const StrTable*>(this)->findEntry(key));
+}
 
-    if (count[bucket_index] == 0xFFFF)
-      common::WriteMsg::writeToErr( CMSG_BUCKET_IS_FULL, bucket_index);
+void StrTable::indexEntry(std::uint32_t entryIndex)
+{
+  const Entry& entry = entries[entryIndex];
+
+  // string index (if the same string is stored with several keys, the smallest key wins like in the earlier versions)
+  {
+    const std::size_t mask = str_index.size() - 1;
+    const std::uint32_t tag = (std::uint32_t)(entry.hash >> 32);
+    for (std::size_t pos = entry.hash & mask; ; pos = (pos + 1) & mask) {
+      Slot& slot = str_index[pos];
+      if (!slot.entry) {
+        slot.entry = entryIndex + 1;
+        slot.tag = tag;
+        break;
+      }
+      if (slot.tag == tag) {
+        Entry& other = entries[slot.entry - 1];
+        if (other.str == entry.str) {
+          if (entry.key < other.key)
+            slot.entry = entryIndex + 1;
+          break;
+        }
+      }
+    }
+  }
 
+  // key index
+  {
+    const std::size_t mask = key_index.size() - 1;
+    for (std::size_t pos = hashKey(entry.key) & mask; ; pos = (pos + 1) & mask) {
+      Slot& slot = key_index[pos];
+      if (!slot.entry) {
+        slot.entry = entryIndex + 1;
+        slot.tag = entry.key;
+        break;
+      }
+    }
+  }
+}
 
-    str_table[bucket_index].insert(Map::value_type(key, std::make_pair(std::string(s,length), type)));
+void StrTable::grow()
+{
+  std::size_t newSize = str_index.size() * 2;
 
-#ifdef DOSTAT
-    statistic_counter[bucket_index].element_count++;
-#endif
-  }
+  str_index.clear();
+  str_index.resize(newSize, Slot{0, 0});
+  key_index.clear();
+  key_index.resize(newSize, Slot{0, 0});
+
+  for (std::uint32_t i = 0; i < (std::uint32_t)entries.size(); ++i)
+    indexEntry(i);
+}
+
+void StrTable::addEntry(const char* s, std::size_t length, std::uint64_t hash_value, Key key, StrType type)
+{
+  // The load factor of the indexes is kept below 1/2.
+  if ((entries.size() + 1) * 2 > str_index.size())
+    grow();
+
+  entries.push_back(Entry{std::string(s, length), hash_value, key, type});
+  indexEntry((std::uint32_t)(entries.size() - 1));
+}
+
+Key StrTable::insert(const char* s, std::size_t length, std::uint64_t hash_value, StrType type)
+{
+  // The key is built in the same way as in the earlier versions of the table.
+  unsigned short pearson_hash = hash(s, (unsigned long)length);
+  unsigned bucket_index = pearson_hash % no_buckets;
+
+  Key key = ((Key)pearson_hash << 16) | count[bucket_index]++;
+
+  if (count[bucket_index] == 0xFFFF)
+    common::WriteMsg::writeToErr( CMSG_BUCKET_IS_FULL, bucket_index);
+
+  addEntry(s, length, hash_value, key, type);
   return key;
 }
 
-Key StrTable::set(const char* s, StrType type)
+Key StrTable::set(const std::string& s, StrType type)
+{
+  return set(s.c_str(), (unsigned)s.size(), type);
+}
+
+Key StrTable::set(std::string_view s, StrType type)
+{
+  return set(s.data(), (unsigned)s.size(), type);
+}
+
+Key StrTable::set(const char* s, unsigned length, StrType type)
 {
   if (s == NULL)
     return 0;
 
-  if (!s[0])
+  if(length == 0)
     return 0;
 
-  Key key;
-  unsigned short hash_value = hash(s);
-  unsigned bucket_index = hash_value % no_buckets;
+  std::uint64_t hash_value = hash64(s, length);
 
   // If the string does not exists in the table we insert it
-  if (!(key = get(s, strlen(s), hash_value, bucket_index))) {
-
-    key = ((Key)hash_value << 16) | count[bucket_index]++;
-
-    if (count[bucket_index] == 0xFFFF)
-      common::WriteMsg::writeToErr( CMSG_BUCKET_IS_FULL, bucket_index);
+  Key key = find(s, length, hash_value);
+  if (!key)
+    key = insert(s, length, hash_value, type);
 
+  return key;
+}
 
-    str_table[bucket_index].insert(Map::value_type(key, std::make_pair(s, type)));
+Key StrTable::set(const char* s, StrType type)
+{
+  if (s == NULL)
+    return 0;
 
-#ifdef DOSTAT
-    statistic_counter[bucket_index].element_count++;
-#endif
-  }
+  if (!s[0])
+    return 0;
 
-  return key;
+  return set(s, (unsigned)strlen(s), type);
 }
 
 void StrTable::setType(const char *s, StrType type)
@@ -258,60 +425,32 @@ void StrTable::setType(const char *s, StrType type)
   if (!s[0])
     return;
 
-  Key key;
-  unsigned short hash_value = hash(s);
-  unsigned bucket_index = hash_value % no_buckets;
+  std::size_t length = strlen(s);
+  std::uint64_t hash_value = hash64(s, length);
 
   // If the string does not exists in the table we insert it
-  if (!(key = get(s, strlen(s), hash_value, bucket_index))) {
-
-    key = ((Key)hash_value << 16) | count[bucket_index]++;
-
-    if (count[bucket_index] == 0xFFFF)
-      common::WriteMsg::writeToErr( CMSG_BUCKET_IS_FULL, bucket_index);
-
-    str_table[bucket_index].insert(Map::value_type(key, std::make_pair(s, type)));
-
-#ifdef DOSTAT
-    statistic_counter[bucket_index].element_count++;
-#endif
-  } else    // Just modify the type of it
-    str_table[bucket_index].find(key)->second.second = type;
+  Key key = find(s, length, hash_value);
+  if (!key)
+    insert(s, length, hash_value, type);
+  else    // Just modify the type of it
+    findEntry(key)->type = type;
 }
 
 void StrTable::setType(const Key key, StrType type)
 {
-  unsigned bucket_index = (key >>16) % no_buckets;
-
-  Map::iterator it = str_table[bucket_index].find(key);
-  if (it != str_table[bucket_index].end())
-    it->second.second = type;
+  Entry* entry = findEntry(key);
+  if (entry)
+    entry->type = type;
 }
 
-Key StrTable::get(const char* s, size_t length, unsigned short hash_value, unsigned bucket_index) const
+Key StrTable::get(const std::string& s) const
 {
-  // It does not check the s because it is already checked in StrTable::set or in StrTable::get.
-#ifdef DOSTAT
-  statistic_counter[bucket_index].number_of_search++;
-#endif
-
-  Map::const_iterator from = str_table[bucket_index].lower_bound((Key)hash_value << 16);
-  Map::const_iterator to = str_table[bucket_index].upper_bound(((Key)hash_value << 16) + 0xFFFF);
-
-  for(Map::const_iterator it = from; it != to; ++it) {
-#ifdef DOSTAT
-    statistic_counter[bucket_index].number_of_it++;
-#endif
-    if ((it->second.first.length() == length)&&(it->second.first.compare(0,length,s,length) == 0)) {
-      return it->first;
-    }
-  }
-  return 0;
+  return get(s.c_str(), (unsigned)s.size());
 }
 
-Key StrTable::get(const std::string& s) const
+Key StrTable::get(std::string_view s) const
 {
-  return get(s.c_str(), (unsigned)s.size());
+  return get(s.data(), (unsigned)s.size());
 }
 
 Key StrTable::get(const char* s) const
@@ -322,10 +461,7 @@ Key StrTable::get(const char* s) const
   if (!s[0])
     return 0;
 
-  unsigned short hash_value = hash(s);
-  unsigned bucket_index = hash_value % no_buckets;
-
-  return get(s, strlen(s), hash_value, bucket_index);
+  return get(s, (unsigned)strlen(s));
 }
 
 Key StrTable::get(const char* s, unsigned length) const
@@ -336,25 +472,49 @@ Key StrTable::get(const char* s, unsigned length) const
   if (length == 0)
     return 0;
 
-  unsigned short hash_value = hash(s, length);
-  unsigned bucket_index = hash_value % no_buckets;
-
-  return get(s, length, hash_value, bucket_index);
-
+  return find(s, length, hash64(s, length));
 }
 
 const std::string& StrTable::get(Key key) const
 {
   static std::string empty_string;
-  unsigned bucket_index = (key >>16) % no_buckets;
 
-  Map::const_iterator it = str_table[bucket_index].find(key);
-  if (it != str_table[bucket_index].end())
-    return it->second.first;
+  const Entry* entry = findEntry(key);
+  if (entry)
+    return entry->str;
 
   return empty_string;
 }
 
+std::string_view StrTable::getView(Key key) const
+{
+  const Entry* entry = findEntry(key);
+  if (entry)
+    return entry->str;
+
+  return std::string_view();
+}
+
+std::vector<std::uint32_t> StrTable::getSaveOrder() const
+{
+  std::vector<std::uint32_t> order(entries.size());
+  for (std::uint32_t i = 0; i < (std::uint32_t)order.size(); ++i)
+    order[i] = i;
+
+  const unsigned buckets = no_buckets;
+  std::sort(order.begin(), order.end(), [this, buckets](std::uint32_t lhs, std::uint32_t rhs) {
+    Key lkey = entries[lhs].key;
+    Key rkey = entries[rhs].key;
+    unsigned lbucket = (lkey >> 16) % buckets;
+    unsigned rbucket = (rkey >> 16) % buckets;
+    if (lbucket != rbucket)
+      return lbucket < rbucket;
+    return lkey < rkey;
+  });
+
+  return order;
+}
+
 void StrTable::save(FILE* file, StrType filterType) const
 {
   CHECKIO(fwrite("STRTBL", 6, 1, file), CMSG_WRITE_ERR);     // ID string (6)
@@ -365,30 +525,26 @@ void StrTable::save(FILE* file, StrType filterType) const
     CHECKIO(fwrite(&ic, 2, 1, file), CMSG_WRITE_ERR);        // no_buckets x Internal counter (2)
   }
 
-  // write out each element
-  for (unsigned j = 0; j < no_buckets; j++) {
-    const Map& current_map = str_table[j];
-
-    for (Map::const_iterator it = current_map.begin(); it != current_map.end(); ++it) {
-      if (filterType == strTmp) {      // In tmp mode nodes with tmp flag will be skipped.
-        if (it->second.second == strTmp)
+  // write out each element (in the order of the buckets and the keys like the earlier versions did)
+  for (std::uint32_t index : getSaveOrder()) {
+    const Entry& entry = entries[index];
+    if (filterType == strTmp) {      // In tmp mode nodes with tmp flag will be skipped.
+      if (entry.type == strTmp)
+        continue;
+    } else
+      if (filterType == strToSave)  // In save mode only nodes with save flag will be written out.
+        if (entry.type != strToSave)
           continue;
-      } else
-        if (filterType == strToSave)  // In save mode only nodes with save flag will be written out.
-          if (it->second.second != strToSave)
-            continue;
 
-      CHECKIO(fwrite(&it->first, 4, 1, file), CMSG_WRITE_ERR);   // The key (4)
-      unsigned str_size = (unsigned)it->second.first.size();
-      CHECKIO(fwrite(&str_size, 4, 1, file), CMSG_WRITE_ERR);    // Size of the string (4)
+    CHECKIO(fwrite(&entry.key, 4, 1, file), CMSG_WRITE_ERR);   // The key (4)
+    unsigned str_size = (unsigned)entry.str.size();
+    CHECKIO(fwrite(&str_size, 4, 1, file), CMSG_WRITE_ERR);    // Size of the string (4)
 
-      CHECKIO(fwrite(it->second.first.c_str(), str_size, 1, file), CMSG_WRITE_ERR); // Characters of the string (n)
-
-    }
+    CHECKIO(fwrite(entry.str.c_str(), str_size, 1, file), CMSG_WRITE_ERR); // Characters of the string (n)
   }
 
   // Write out the end of StringTable sign
-  unsigned long end_sign = 0;
+  unsigned end_sign = 0;
   CHECKIO(fwrite(&end_sign, 4, 1, file), CMSG_WRITE_ERR);    
  
 }
@@ -403,23 +559,20 @@ void StrTable::save(columbus::io::BinaryIO& file, StrType filterType) const
     file.writeUShort2(ic);  // no_buckets x Internal counter (2)
   }
 
-  for (unsigned j = 0; j < no_buckets; j++) {
-    const Map& current_map = str_table[j];
-
-    for (Map::const_iterator it = current_map.begin(); it != current_map.end(); ++it) {
-      if (filterType == strTmp) {      // In tmp mode nodes with tmp flag will be skipped.
-        if (it->second.second == strTmp)
+  for (std::uint32_t index : getSaveOrder()) {
+    const Entry& entry = entries[index];
+    if (filterType == strTmp) {      // In tmp mode nodes with tmp flag will be skipped.
+      if (entry.type == strTmp)
+        continue;
+    } else
+      if (filterType == strToSave)  // In save mode only nodes with save flag will be written out.
+        if (entry.type != strToSave)
           continue;
-      } else
-        if (filterType == strToSave)  // In save mode only nodes with save flag will be written out.
-          if (it->second.second != strToSave)
-            continue;
-
-      file.writeUInt4(it->first);
-      size_t str_size = it->second.first.size();
-      file.writeUInt4((unsigned)str_size);
-      file.writeData(it->second.first.c_str(), str_size);
-    }
+
+    file.writeUInt4(entry.key);
+    size_t str_size = entry.str.size();
+    file.writeUInt4((unsigned)str_size);
+    file.writeData(entry.str.c_str(), str_size);
   }
     // Write out the end of StringTable sign
   file.writeUInt4(0);
@@ -434,22 +587,9 @@ void StrTable::load(FILE* file)
     return;
   }
 
-  CHECKIO(fread(&no_buckets, 4, 1, file), CMSG_READ_ERR);
-  str_table.clear();
-  str_table.resize(no_buckets);
-
-  count.clear();
-  count.resize(no_buckets, 0);
-
-#ifdef DOSTAT
-  free(statistic_counter);
-
-  statistic_counter = (table_stat*)calloc(no_buckets , sizeof(table_stat));
-  if (!statistic_counter) {
-    common::WriteMsg::writeToErr( CMSG_ERROR_MEMORY_ALLOCATION);
-    abort();
-  }
-#endif
+  unsigned buckets;
+  CHECKIO(fread(&buckets, 4, 1, file), CMSG_READ_ERR);
+  reset(buckets);
 
   for (unsigned i = 0; i < no_buckets; i++) {
     unsigned short ic;
@@ -457,6 +597,7 @@ void StrTable::load(FILE* file)
     count[i] = ic;
   }
   
+  std::string buffer;
   while (true) {
     Key key = 0;
 
@@ -469,17 +610,12 @@ void StrTable::load(FILE* file)
     unsigned str_size;
     CHECKIO(fread(&str_size, 4, 1, file), CMSG_READ_ERR); // Size of the string (4)
 
-    char* buffer = (char*)calloc(1, str_size + 1);
-    if (!buffer) {
-      common::WriteMsg::writeToErr( CMSG_LOAD_ERROR);
-      abort();
-    }
+    buffer.resize(str_size);
+    if (str_size)
+      CHECKIO(fread(&buffer[0], str_size, 1, file), CMSG_READ_ERR);  // Characters of the string (n)
 
-    CHECKIO(fread(buffer, str_size, 1, file), CMSG_READ_ERR);  // Characters of the string (n)
-    unsigned bucket_index = (key >>16) % no_buckets;
-    str_table[bucket_index].insert(Map::value_type(key, std::make_pair(std::string(buffer, str_size), strDefault)));
-    
-    free(buffer);
+    if (!findEntry(key))
+      addEntry(buffer.data(), str_size, hash64(buffer.data(), str_size), key, strDefault);
   }
 }
 
@@ -492,27 +628,13 @@ void StrTable::load(columbus::io::BinaryIO& file)
     return;
   }
 
-  no_buckets = file.readUInt4();
-  str_table.clear();
-  str_table.resize(no_buckets);
-
-  count.clear();
-  count.resize(no_buckets, 0);
-
-#ifdef DOSTAT
-  free(statistic_counter);
-
-  statistic_counter = (table_stat*)calloc(no_buckets , sizeof(table_stat));
-  if (!statistic_counter) {
-    common::WriteMsg::writeToErr( CMSG_ERROR_MEMORY_ALLOCATION);
-    abort();
-  }
-#endif
+  reset(file.readUInt4());
 
   for (unsigned i = 0; i < no_buckets; i++) {
     count[i] = file.readUShort2();  // no_buckets x Internal counter (2)
   }
 
+  std::string buffer;
   while (true) {
     Key key;
     key = file.readUInt4();
@@ -523,37 +645,35 @@ void StrTable::load(columbus::io::BinaryIO& file)
 
     unsigned str_size = file.readUInt4(); // Size of the string (4)
 
-    char* buffer = (char*)calloc(1, str_size + 1);
-    if (!buffer) {
-      common::WriteMsg::writeToErr( CMSG_LOAD_ERROR);
-      abort();
-    }
+    buffer.resize(str_size);
+    file.readData(&buffer[0], str_size); // Characters of the string (n)
 
-    file.readData(buffer, str_size); // Characters of the string (n)
-
-    unsigned bucket_index = (key >>16) % no_buckets;
-    str_table[bucket_index].insert(Map::value_type(key, std::make_pair(std::string(buffer, str_size), strDefault)));
-
-    free(buffer);
+    if (!findEntry(key))
+      addEntry(buffer.data(), str_size, hash64(buffer.data(), str_size), key, strDefault);
   }
 }
 
 void StrTable::dump()
 {
-  unsigned i = 0;
-  Map::size_type total_counter = 0;
-  for (std::vector<Map>::const_iterator it = str_table.begin(); it != str_table.end(); ++it) {
-    common::WriteMsg::write( CMSG_BUCKET_TOTAL_NUMBER, i++, it->size());
-    for (Map::const_iterator sit = it->begin(); sit != it->end(); ++sit)
-      printf("[%X]:[%s][%d]\n", sit->first, sit->second.first.c_str(),  sit->second.second);
-    total_counter += it->size();
+  std::vector<std::uint32_t> order = getSaveOrder();
+  std::vector<std::size_t> bucket_sizes(no_buckets, 0);
+  for (const Entry& entry : entries)
+    bucket_sizes[(entry.key >> 16) % no_buckets]++;
+
+  unsigned current_bucket = 0;
+  std::vector<std::uint32_t>::const_iterator it = order.begin();
+  for (unsigned i = 0; i < no_buckets; ++i) {
+    common::WriteMsg::write( CMSG_BUCKET_TOTAL_NUMBER, i, bucket_sizes[i]);
+    for (; it != order.end() && (entries[*it].key >> 16) % no_buckets == current_bucket; ++it)
+      printf("[%X]:[%s][%d]\n", entries[*it].key, entries[*it].str.c_str(), entries[*it].type);
+    ++current_bucket;
   }
   
   for (unsigned i = 0; i < no_buckets; ++i) {
     printf("Counter[%u]:%hu\n", i, count[i]);
   }
   
-  common::WriteMsg::write( CMSG_TOTAL_COUNT, total_counter);
+  common::WriteMsg::write( CMSG_TOTAL_COUNT, entries.size());
 }
 
 } // columbus namespace
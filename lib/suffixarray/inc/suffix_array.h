@@ -25,11 +25,49 @@
 #include<queue>
 #include<stack>
 #include<map>
+#include<deque>
+#include<algorithm>
+
+#include <threadpool/inc/ThreadPool.h>
 
 #include "sequence.h"
 
 namespace columbus { namespace suffix_array {
 
+/**
+ * \brief Splits [0, n) into consecutive parts of at least minChunk elements (at most one part per thread of the pool).
+ * \return the boundaries of the parts (the first one is 0, the last one is n)
+ */
+inline std::vector<size_t> splitRange(columbus::thread::ThreadPool* pool, size_t n, size_t minChunk) {
+  size_t chunks = pool ? std::min<size_t>(pool->getPoolSize(), n / minChunk) : 1;
+  if (chunks == 0)
+    chunks = 1;
+  std::vector<size_t> bounds(chunks + 1);
+  for (size_t c = 0; c <= chunks; ++c)
+    bounds[c] = n * c / chunks;
+  return bounds;
+}
+
+/**
+ * \brief Calls func(chunk, begin, end) for every part given by the boundaries. The parts are processed by the
+ *        pool (the first one by the calling thread) and the function returns when all of them are done.
+ */
+template<class Func>
+void parallelRun(columbus::thread::ThreadPool* pool, const std::vector<size_t>& bounds, Func func) {
+  size_t chunks = bounds.size() - 1;
+  if (chunks == 1 || !pool) {
+    for (size_t c = 0; c < chunks; ++c)
+      func(c, bounds[c], bounds[c + 1]);
+    return;
+  }
+  std::vector<columbus::thread::TaskFuture<void> > futures;
+  for (size_t c = 1; c < chunks; ++c)
+    futures.push_back(pool->submit([&func, &bounds, c]() { func(c, bounds[c], bounds[c + 1]); }));
+  func(0, bounds[0], bounds[1]);
+  for (size_t c = 0; c < futures.size(); ++c)
+    futures[c].get();
+}
+
 template<class T>
 class SuffixArray {
 
@@ -102,41 +140,101 @@ public:
     void run(CloneVisitor& visitor /*void (*process)(CloneClass&)*/ ) {
       if(suffixArray.sequence.getLength() == 0)
         return;
-      bool* leftExt = new bool[suffixArray.sequence.getLength()];
+      enumerate(0, suffixArray.sequence.getLength(), [this, &visitor](const IntervalData& interval) {
+        CloneClass cc;
+        createCloneClass(interval, cc);
+        visitor.visit(cc);
+      });
+    }
+
+    /**
+     * The lcp-intervals are collected by the pool and passed to the visitor in the same order as run(visitor) does.
+     * An interval with lcp >= min_length cannot contain a suffix whose lcp is less than min_length (except its
+     * first one), so the suffix array is cut into parts at such suffixes and the parts are enumerated
+     * independently. Only the bounds of the reported intervals are collected, the clone classes are created and
+     * visited by the calling thread.
+     */
+    void run(CloneVisitor& visitor, columbus::thread::ThreadPool* pool) {
+      const unsigned n = suffixArray.sequence.getLength();
+      if(!pool || pool->getPoolSize() < 2 || min_length == 0 || n < 2 * minPartSize) {
+        run(visitor);
+        return;
+      }
+
+      const unsigned partSize = std::max<unsigned>(minPartSize, n / (4 * pool->getPoolSize()));
+      std::deque<columbus::thread::TaskFuture<std::vector<IntervalData> > > parts;
+      unsigned next = 0;
+      while(next < n || !parts.empty()) {
+        // keep at most two parts per thread in flight to bound the memory of the collected intervals
+        while(next < n && parts.size() < 2 * pool->getPoolSize()) {
+          unsigned begin = next;
+          unsigned end = std::min(n, begin + partSize);
+          while(end < n && suffixArray.suffixes[end].lcp >= min_length)
+            ++end;
+          parts.push_back(pool->submit([this, begin, end]() {
+            std::vector<IntervalData> intervals;
+            enumerate(begin, end, [&intervals](const IntervalData& interval) { intervals.push_back(interval); });
+            return intervals;
+          }));
+          next = end;
+        }
+        std::vector<IntervalData> intervals = parts.front().get();
+        parts.pop_front();
+        for(size_t i = 0; i < intervals.size(); ++i) {
+          CloneClass cc;
+          createCloneClass(intervals[i], cc);
+          visitor.visit(cc);
+        }
+      }
+    }
+
+  private:
 
-      leftExt[0] = false;
+    static constexpr unsigned minPartSize = 1 << 16;
 
+    // true if the suffixes at y-1 and y are preceded by the same element
+    bool isLeftExtendable(unsigned y) const {
+      return !(suffixArray.suffixes[y].position == 0 || suffixArray.suffixes[y-1].position == 0 || (suffixArray.sequence[suffixArray.suffixes[y].position-1]!=suffixArray.sequence[suffixArray.suffixes[y-1].position-1]));
+    }
+
+    // true if the interval is long and frequent enough and it is not left extendable
+    bool isReported(const IntervalData& interval) const {
+      unsigned int num = interval.rb - interval.lb + 1;
+      if(interval.lcp >= min_length && ( max_length == 0 ||  interval.lcp <= max_length ) && (num >= min_occurance)) {
+        bool leftExtendable = true;
+        for(int y = interval.lb + 1; y <= interval.rb && leftExtendable; ++y) {
+          leftExtendable = (_extendable && isLeftExtendable(y));
+        }
+        return !leftExtendable;
+      }
+      return false;
+    }
+
+    // create clone class and instances
+    void createCloneClass(const IntervalData& interval, CloneClass& cc) const {
+      cc.length = interval.lcp;
+      cc.num = interval.rb - interval.lb + 1;
+      cc.position = new unsigned int[cc.num];
+      for(int y = interval.lb, pos_count = 0; y <= interval.rb; ++y, ++pos_count) {
+        cc.position[pos_count] = (suffixArray.suffixes[y].position);
+      }
+    }
+
+    /**
+     * Reports the clone intervals of the suffixes [begin, end). The lcp of the first suffix is handled as 0.
+     */
+    template<class Report>
+    void enumerate(unsigned begin, unsigned end, Report report) const {
       std::stack<IntervalData> intervalStack;
-      intervalStack.push(IntervalData(0, 0, -1));
+      intervalStack.push(IntervalData(0, begin, -1));
 
-      for(size_t i = 1; i < suffixArray.sequence.getLength(); ++i) {
-        leftExt[i] = !(suffixArray.suffixes[i].position == 0 || suffixArray.suffixes[i-1].position == 0 || (suffixArray.sequence[suffixArray.suffixes[i].position-1]!=suffixArray.sequence[suffixArray.suffixes[i-1].position-1]));
+      for(unsigned i = begin + 1; i < end; ++i) {
         int lb = i - 1;
 
         while(suffixArray.suffixes[i].lcp < intervalStack.top().lcp) {
           intervalStack.top().rb = i - 1;
-          //process()
-          unsigned int num = intervalStack.top().rb - intervalStack.top().lb + 1;
-          if(intervalStack.top().lcp >= min_length && ( max_length == 0 ||  intervalStack.top().lcp <= max_length ) && (num >= min_occurance)) {
-            // create clone class and instances
-            bool leftExtendable = true;
-            CloneClass cc;
-            cc.length = intervalStack.top().lcp;
-            cc.num = num;
-            int begin = intervalStack.top().lb;
-            int end = intervalStack.top().rb;
-            cc.position = new unsigned int[num];
-            cc.position[0] = suffixArray.suffixes[begin].position;
-
-            for(int y = begin + 1, pos_count = 1; y <= end; ++y, ++pos_count) {
-              leftExtendable = (leftExtendable && (_extendable && leftExt[y]));
-              cc.position[pos_count] = (suffixArray.suffixes[y].position);
-            }
-            if(!leftExtendable) {
-              visitor.visit(cc);
-            }
-          }
-
+          if(isReported(intervalStack.top()))
+            report(intervalStack.top());
           lb = intervalStack.top().lb;
           intervalStack.pop();
         }
@@ -145,33 +243,11 @@ public:
         }
       }
       while(!intervalStack.empty()) {
-        intervalStack.top().rb = suffixArray.sequence.getLength() - 1;
-        //process()
-        unsigned int num = intervalStack.top().rb - intervalStack.top().lb + 1;
-        if(intervalStack.top().lcp >= min_length && ( max_length == 0 ||  intervalStack.top().lcp <= max_length ) && (num >= min_occurance)) {
-          // create clone class and instances
-          bool leftExtendable = true;
-          CloneClass cc;
-          cc.length = intervalStack.top().lcp;
-          cc.num = 0;
-          cc.position = new unsigned int[num];
-          int begin = intervalStack.top().lb;
-          int end = intervalStack.top().rb;
-          cc.num = num;
-
-          cc.position[0] = suffixArray.suffixes[begin].position;
-          for(int y = begin+1, pos_count = 1; y <= end; ++y, ++pos_count) {
-            leftExtendable = (leftExtendable && (_extendable && leftExt[y]));
-            cc.position[pos_count] = (suffixArray.suffixes[y].position);
-          }
-          if(!leftExtendable) {
-            visitor.visit(cc);
-          }
-        }
-
+        intervalStack.top().rb = end - 1;
+        if(isReported(intervalStack.top()))
+          report(intervalStack.top());
         intervalStack.pop();
       }
-      delete[] leftExt;
     }
   };
 
@@ -209,25 +285,45 @@ class LinearSuffixArray : public SuffixArray<T> {
   using SuffixArray<T>::suffixes;
 
 protected:
-  inline bool leq(unsigned a1, unsigned a2, unsigned b1, unsigned b2) { // lexic. order for pairs
+
+  // the arrays shorter than this are processed by the calling thread only
+  static constexpr size_t minChunkSize = 1 << 16;
+
+  columbus::thread::ThreadPool* pool;
+
+  inline bool leq(unsigned a1, unsigned a2, unsigned b1, unsigned b2) const { // lexic. order for pairs
     return(a1 < b1 || (a1 == b1 && a2 <= b2));
   }
 
   // and triples
-  inline bool leq(unsigned a1, unsigned a2, unsigned a3, unsigned b1, unsigned b2, unsigned b3) {
+  inline bool leq(unsigned a1, unsigned a2, unsigned a3, unsigned b1, unsigned b2, unsigned b3) const {
     return(a1 < b1 || (a1 == b1 && leq(a2,a3, b2,b3)));
   }
 
   // stably sort a[0..n-1] to b[0..n-1] with keys in 0..K from r
-  static void radixPass(unsigned* a, unsigned* b, unsigned* r, unsigned n, unsigned K) {
-    int* c = new int[K + 1];                          // counter array
-    for (unsigned i = 0;  i <= K;  i++) c[i] = 0;         // reset counters
-    for (unsigned i = 0;  i < n;  i++) c[r[a[i]]]++;    // count occurences
-    for (unsigned i = 0, sum = 0;  i <= K;  i++) { // exclusive prefix sums
-       int t = c[i];  c[i] = sum;  sum += t;
+  void radixPass(unsigned* a, unsigned* b, unsigned* r, unsigned n, unsigned K) const {
+    std::vector<size_t> bounds = splitRange(pool, n, minChunkSize);
+    size_t chunks = bounds.size() - 1;
+    if (chunks > 1 && (size_t)(K + 1) * chunks > n) {
+      // the counters would cost more than the keys themselves
+      bounds = splitRange(NULL, n, minChunkSize);
+      chunks = 1;
+    }
+    // counter array of each part (keys are counted by part, so the sort stays stable)
+    std::vector<unsigned> c((size_t)(K + 1) * chunks, 0);
+    parallelRun(pool, bounds, [&](size_t chunk, size_t begin, size_t end) {
+      unsigned* cc = &c[chunk * (K + 1)];
+      for (size_t i = begin;  i < end;  i++) cc[r[a[i]]]++;    // count occurences
+    });
+    for (unsigned i = 0, sum = 0;  i <= K;  i++) {            // exclusive prefix sums
+      for (size_t chunk = 0;  chunk < chunks;  chunk++) {
+        unsigned t = c[chunk * (K + 1) + i];  c[chunk * (K + 1) + i] = sum;  sum += t;
+      }
     }
-    for (unsigned i = 0;  i < n;  i++) b[c[r[a[i]]]++] = a[i];      // sort
-    delete [] c;
+    parallelRun(pool, bounds, [&](size_t chunk, size_t begin, size_t end) {
+      unsigned* cc = &c[chunk * (K + 1)];
+      for (size_t i = begin;  i < end;  i++) b[cc[r[a[i]]]++] = a[i];      // sort
+    });
   }
 
   // find the suffix array SA of s[0..n-1] in {1..K}^n
@@ -241,7 +337,10 @@ protected:
 
       // generate positions of mod 1 and mod  2 suffixes
       // the "+(n0-n1)" adds a dummy mod 1 suffix if n%3 == 1
-      for (unsigned i=0, j=0;  i < n+(n0-n1);  i++) if (i%3 != 0) s12[j++] = i;
+      std::vector<size_t> bounds = splitRange(pool, n02, minChunkSize);
+      parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+        for (size_t j = begin;  j < end;  j++) s12[j] = (unsigned)(3 * (j / 2) + 1 + j % 2);
+      });
 
       // lsb radix sort the mod 1 and mod 2 triples
       radixPass(s12 , SA12, s+2, n02, K);
@@ -249,47 +348,78 @@ protected:
       radixPass(s12 , SA12, s  , n02, K);
 
       // find lexicographic names of triples
-      unsigned name = 0, c0 = -1, c1 = -1, c2 = -1;
-      for (unsigned i = 0;  i < n02;  i++) {
-        if (s[SA12[i]] != c0 || s[SA12[i]+1] != c1 || s[SA12[i]+2] != c2) {
-          name++;  c0 = s[SA12[i]];  c1 = s[SA12[i]+1];  c2 = s[SA12[i]+2];
+      // (every part counts its new names first, so the names of a part start after the names of the previous ones)
+      auto isNewName = [&](size_t i) {
+        return i == 0 || s[SA12[i]] != s[SA12[i-1]] || s[SA12[i]+1] != s[SA12[i-1]+1] || s[SA12[i]+2] != s[SA12[i-1]+2];
+      };
+      std::vector<unsigned> firstName(bounds.size(), 0);
+      parallelRun(pool, bounds, [&](size_t chunk, size_t begin, size_t end) {
+        unsigned names = 0;
+        for (size_t i = begin;  i < end;  i++) if (isNewName(i)) names++;
+        firstName[chunk + 1] = names;
+      });
+      for (size_t chunk = 1;  chunk < firstName.size();  chunk++) firstName[chunk] += firstName[chunk - 1];
+      unsigned name = firstName.back();
+      parallelRun(pool, bounds, [&](size_t chunk, size_t begin, size_t end) {
+        unsigned name = firstName[chunk];
+        for (size_t i = begin;  i < end;  i++) {
+          if (isNewName(i)) name++;
+          if (SA12[i] % 3 == 1) { s12[SA12[i]/3]      = name; } // left half
+          else                  { s12[SA12[i]/3 + n0] = name; } // right half
         }
-        if (SA12[i] % 3 == 1) { s12[SA12[i]/3]      = name; } // left half
-        else                  { s12[SA12[i]/3 + n0] = name; } // right half
-      }
+      });
 
       // recurse if names are not yet unique
       if (name < n02) {
         suffixArray(s12, SA12, n02, name);
         // store unique names in s12 using the suffix array
-        for (unsigned i = 0;  i < n02;  i++) s12[SA12[i]] = i + 1;
-      } else // generate the suffix array of s12 directly
-        for (unsigned i = 0;  i < n02;  i++) SA12[s12[i] - 1] = i;
+        parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+          for (size_t i = begin;  i < end;  i++) s12[SA12[i]] = (unsigned)i + 1;
+        });
+      } else { // generate the suffix array of s12 directly
+        parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+          for (size_t i = begin;  i < end;  i++) SA12[s12[i] - 1] = (unsigned)i;
+        });
+      }
 
       // stably sort the mod 0 suffixes from SA12 by their first character
       for (unsigned i=0, j=0;  i < n02;  i++) if (SA12[i] < n0) s0[j++] = 3*SA12[i];
       radixPass(s0, SA0, s, n0, K);
 
       // merge sorted SA0 suffixes and sorted SA12 suffixes
-      for (unsigned p=0,  t=n0-n1,  k=0;  k < n;  k++) {
-    #define GetI() (SA12[t] < n0 ? SA12[t] * 3 + 1 : (SA12[t] - n0) * 3 + 2)
-        unsigned i = GetI(); // pos of current offset 12 suffix
-        unsigned j = SA0[p]; // pos of current offset 0  suffix
-        if (SA12[t] < n0 ?
+      // (SA12 is cut into parts, and the first SA0 suffix of each part is found by binary search)
+    #define GetI(t) (SA12[t] < n0 ? SA12[t] * 3 + 1 : (SA12[t] - n0) * 3 + 2)
+      auto isSmaller12 = [&](unsigned t, unsigned j) { // suffix from SA12[t] is smaller than the mod 0 suffix j
+        unsigned i = GetI(t); // pos of current offset 12 suffix
+        return SA12[t] < n0 ?
             leq(s[i],       s12[SA12[t] + n0], s[j],       s12[j/3]) :
-            leq(s[i],s[i+1],s12[SA12[t]-n0+1], s[j],s[j+1],s12[j/3+n0]))
-        { // suffix from SA12 is smaller
-          SA[k] = i;  t++;
-          if (t == n02) { // done --- only SA0 suffixes left
-            for (k++;  p < n0;  p++, k++) SA[k] = SA0[p];
-          }
-        } else {
-          SA[k] = j;  p++;
-          if (p == n0)  { // done --- only SA12 suffixes left
-            for (k++;  t < n02;  t++, k++) SA[k] = GetI();
+            leq(s[i],s[i+1],s12[SA12[t]-n0+1], s[j],s[j+1],s12[j/3+n0]);
+      };
+      const unsigned tFirst = n0 - n1;
+      std::vector<size_t> mergeBounds = splitRange(pool, n02 - tFirst, minChunkSize);
+      parallelRun(pool, mergeBounds, [&](size_t chunk, size_t begin, size_t end) {
+        unsigned t = tFirst + (unsigned)begin, tEnd = tFirst + (unsigned)end;
+        auto firstBigger0 = [&](unsigned t) { // number of SA0 suffixes smaller than the suffix from SA12[t]
+          if (t == n02)
+            return n0;
+          unsigned lo = 0, hi = n0;
+          while (lo < hi) {
+            unsigned mid = lo + (hi - lo) / 2;
+            if (isSmaller12(t, SA0[mid])) hi = mid; else lo = mid + 1;
           }
+          return lo;
+        };
+        unsigned p = chunk == 0 ? 0 : firstBigger0(t);
+        unsigned pEnd = firstBigger0(tEnd);
+        unsigned k = (unsigned)begin + p;
+        while (t < tEnd && p < pEnd) {
+          if (isSmaller12(t, SA0[p])) { SA[k++] = GetI(t);  t++; } // suffix from SA12 is smaller
+          else                        { SA[k++] = SA0[p];   p++; }
         }
-      }
+        for (;  t < tEnd;  t++, k++) SA[k] = GetI(t);
+        for (;  p < pEnd;  p++, k++) SA[k] = SA0[p];
+      });
+    #undef GetI
       delete [] s12; delete [] SA12; delete [] SA0; delete [] s0;
   }
 
@@ -314,27 +444,43 @@ protected:
    * 12 if h > 0 then h := h-1 fi
    * 13 fi
    * 14 od
+   *
+   * Instead of the Rank array, the text order predecessors (Phi) are stored in the no longer needed sa array, and
+   * it is overwritten by the lcp values in text order. The text is cut into parts, every part starts with h = 0.
    */
-    void computeLCP(unsigned* normSeq, unsigned* sa, int n) {
-      //suffixes = new SuffixArray<T>::SuffixArrayElement()[n];
+    void computeLCP(unsigned* normSeq, unsigned* sa, unsigned n) {
       suffixes = new typename SuffixArray<T>::SuffixArrayElement[n];
-      unsigned* Rank = new unsigned[n];
-      for(int i = 0; i < n; ++i) {
-        Rank[sa[i]] = i;
-        suffixes[i].position = sa[i];
-      }
-      int h = 0;
-      int k = 0;
-      suffixes[0].lcp = 0;
-      for(int i = 0; i < n; ++i) {
-        if(Rank[i] > 0) {
-          k = sa[Rank[i]-1];
+      std::vector<size_t> bounds = splitRange(pool, n, minChunkSize);
+      parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+          suffixes[i].position = sa[i];
+        }
+      });
+      // sa[i] := the position of the suffix preceding suffix i in the suffix array (n for the first one)
+      parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+          sa[suffixes[i].position] = i > 0 ? suffixes[i-1].position : n;
+        }
+      });
+      // sa[i] := lcp of suffix i and its predecessor
+      parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+        unsigned h = 0;
+        for(size_t i = begin; i < end; ++i) {
+          unsigned k = sa[i];
+          if(k == n) {
+            sa[i] = 0;
+            continue;
+          }
           while(normSeq[i+h] == normSeq[k+h]) h++;
-          suffixes[Rank[i]].lcp = h;
+          sa[i] = h;
           if( h > 0) h--;
         }
-      }
-      delete[] Rank;
+      });
+      parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+          suffixes[i].lcp = sa[suffixes[i].position];
+        }
+      });
     }
 
 public:
@@ -344,38 +490,43 @@ public:
      * Two Efficient Algorithms for Linear Suffix Array Construction
      * Ge Nong, Sen Zhang, Wai Hong Chan
      *
+     * If a thread pool is given, the normalization of the sequence, the radix sorts, the naming and the merge steps of
+     * the construction and the lcp computation are done in parallel. The result does not depend on the pool.
      */
-  LinearSuffixArray(Sequence<T>& _sequence) : SuffixArray<T>(_sequence) {
+  LinearSuffixArray(Sequence<T>& _sequence, columbus::thread::ThreadPool* _pool = NULL) : SuffixArray<T>(_sequence), pool(_pool) {
     if(_sequence.getLength() > 1) {
-      unsigned* sa = new unsigned[sequence.getLength()];
-
-      std::map<T, size_t> seqMap;
-      std::set<T> values;
-      // create normalize map
-      for(size_t i = 0; i < sequence.getLength(); ++i) {
-        values.insert(sequence[i]);
-      }
-
-      size_t seqCounter = 1;
-      for(typename std::set<T>::iterator it = values.begin(); it != values.end(); ++it) {
-        seqMap.insert(std::make_pair(*it, seqCounter++));
+      const unsigned n = sequence.getLength();
+      unsigned* sa = new unsigned[n];
+
+      // create normalize map: the sorted distinct values of the sequence (collected by parts)
+      std::vector<size_t> bounds = splitRange(pool, n, minChunkSize);
+      std::vector<std::vector<T> > partValues(bounds.size() - 1);
+      auto equivalent = [](const T& a, const T& b) { return !(a < b) && !(b < a); };
+      parallelRun(pool, bounds, [&](size_t chunk, size_t begin, size_t end) {
+        std::vector<T>& values = partValues[chunk];
+        values.assign(&sequence[(unsigned)begin], &sequence[(unsigned)begin] + (end - begin));
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end(), equivalent), values.end());
+      });
+      std::vector<T> values;
+      for(size_t i = 0; i < partValues.size(); ++i) {
+        values.insert(values.end(), partValues[i].begin(), partValues[i].end());
+        std::vector<T>().swap(partValues[i]);
       }
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end(), equivalent), values.end());
+      unsigned seqCounter = (unsigned)values.size() + 1;
 
       // create normalized sequence
-      unsigned* normSeq = new unsigned[sequence.getLength() + 3];
-
-
-      for(size_t i = 0; i < sequence.getLength(); ++i) {
-        typename std::map<T, size_t>::iterator it = seqMap.find(sequence[i]);
-        if(it != seqMap.end()) {
-          normSeq[i] = it->second;
-        } else {
-          // it can't be
+      unsigned* normSeq = new unsigned[n + 3];
+      parallelRun(pool, bounds, [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+          normSeq[i] = (unsigned)(std::lower_bound(values.begin(), values.end(), sequence[(unsigned)i]) - values.begin()) + 1;
         }
-      }
-      normSeq[sequence.getLength()] = normSeq[sequence.getLength() + 1] = normSeq[sequence.getLength() + 2] = 0;
-      suffixArray(normSeq, sa, sequence.getLength(), seqCounter);
-      computeLCP(normSeq, sa, sequence.getLength());
+      });
+      normSeq[n] = normSeq[n + 1] = normSeq[n + 2] = 0;
+      suffixArray(normSeq, sa, n, seqCounter);
+      computeLCP(normSeq, sa, n);
       delete[] sa;
       delete[] normSeq;
     }
@@ -21,9 +21,13 @@
 #ifndef _THREADPOOL_H
 #define _THREADPOOL_H
 
-#include <queue>
-#include <set>
-#include <map>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/thread/recursive_mutex.hpp>
@@ -37,6 +41,10 @@
  * \file ThreadPool.h
  * \brief Interafce of thread pool class
  *
+ * The pool owns a fixed set of persistent worker threads. Every worker has its own
+ * double ended task queue: the owner pops from the back (LIFO, cache friendly), while
+ * idle workers steal from the front of the other queues. Tasks submitted from outside
+ * of the pool are distributed among the workers in a round-robin fashion.
  */
 
 namespace columbus { namespace thread {
@@ -62,50 +70,223 @@ namespace columbus { namespace thread {
       virtual void operator()() {};
   };
 
+  /**
+   * \brief priority of a submitted task (higher priority tasks are always picked first)
+   */
+  enum TaskPriority {
+    tpLow,
+    tpNormal,
+    tpHigh,
+    tpCount
+  };
+
+  /**
+   * \internal \brief type erased unit of work stored in the worker queues
+   */
+  class PoolJob {
+  public:
+    /**
+     * \brief state of the job
+     */
+    enum State {
+      jsPending,
+      jsStarted,
+      jsCancelled
+    };
+
+    PoolJob(std::function<void()> body, TaskPriority priority)
+      : _body(std::move(body))
+      , _priority(priority)
+      , _state(jsPending)
+    {}
+
+    /**
+     * \brief runs the job unless it was cancelled before
+     * \return false if the job was cancelled
+     */
+    bool run()
+    {
+      int expected = jsPending;
+      if (!_state.compare_exchange_strong(expected, jsStarted))
+        return false;
+      _body();
+      return true;
+    }
+
+    /**
+     * \brief cancels the job if it has not started yet
+     * \return true if the job will never run
+     */
+    bool cancel()
+    {
+      int expected = jsPending;
+      if (_state.compare_exchange_strong(expected, jsCancelled))
+      {
+        // release the captured state (and the promise of the future) immediately
+        _body = nullptr;
+        return true;
+      }
+      return expected == jsCancelled;
+    }
+
+    TaskPriority getPriority() const { return _priority; }
+
+  private:
+    std::function<void()> _body;
+    TaskPriority _priority;
+    std::atomic<int> _state;
+  };
+
+  typedef std::shared_ptr<PoolJob> PtrPoolJob;
+
+  /**
+   * \brief handle of a submitted task: the future of its result and the possibility to cancel it
+   *
+   * If the task is cancelled before it has started, get() throws std::future_error (broken_promise).
+   */
+  template <typename R>
+  class TaskFuture {
+  public:
+    TaskFuture() {}
+
+    TaskFuture(std::future<R>&& future, const PtrPoolJob& job)
+      : _future(std::move(future))
+      , _job(job)
+    {}
+
+    /**
+     * \brief waits for the result of the task (rethrows the exception of the task)
+     */
+    R get() { return _future.get(); }
+
+    /**
+     * \brief waits until the task is finished or cancelled
+     */
+    void wait() const { _future.wait(); }
+
+    /**
+     * \brief true if the handle refers to a submitted task
+     */
+    bool valid() const { return _future.valid(); }
+
+    /**
+     * \brief cancels the task if it has not started yet
+     * \return true if the task will never run
+     */
+    bool cancel() { return _job && _job->cancel(); }
+
+    /**
+     * \brief gives access to the underlying future
+     */
+    std::future<R>& getFuture() { return _future; }
+
+  private:
+    std::future<R> _future;
+    PtrPoolJob _job;
+  };
+
   class ThreadPool {
 
   private:
 
+    /**
+     * \internal \brief the task queues of a worker thread (one deque per priority)
+     */
+    struct WorkQueue {
+      boost::mutex lock;
+      std::deque<PtrPoolJob> jobs[tpCount];
+    };
+
     /**
      * \internal \brief task pool maximum size
      */
     unsigned int _poolSize;
 
     /**
-     * \internal \brief lock for runnum variable (incrase, decrase running threads number)
+     * \internal \brief the queues of the workers (indexed in the same way as _workers)
      */
-    boost::recursive_mutex _running_lock;
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
 
     /**
-     * \internal \brief mutex for task_queue_cond condition variable
+     * \internal \brief the persistent worker threads
      */
-    boost::mutex _mutex_queue;
+    std::vector<PtrThread> _workers;
 
     /**
-     * \internal \brief condition variable for waiting tasks
+     * \internal \brief mutex for the idle workers and for the waiters of wait()
      */
-    boost::condition_variable task_queue_cond;
+    boost::mutex _idle_mutex;
 
     /**
-     * \internal \brief lock for the threads for thread unsafe operations
+     * \internal \brief condition variable for the idle workers
      */
-    boost::shared_mutex _exclusive_task_lock;
+    boost::condition_variable _work_available;
+
+    /**
+     * \internal \brief condition variable for wait()
+     */
+    boost::condition_variable _all_done;
+
+    /**
+     * \internal \brief number of queued tasks which are not picked up by any worker yet
+     */
+    std::atomic<unsigned int> _queued;
 
     /**
-     * \internal \brief number of running tasks
+     * \internal \brief number of submitted tasks which are not finished yet
      */
-    unsigned int _runnum;
+    std::atomic<unsigned int> _unfinished;
+
+    /**
+     * \internal \brief the next queue an external submission is put into
+     */
+    std::atomic<unsigned int> _next_queue;
+
+    /**
+     * \internal \brief true if the workers must terminate
+     */
+    bool _stopping;
+
+    /**
+     * \internal \brief lock for the threads for thread unsafe operations
+     */
+    boost::shared_mutex _exclusive_task_lock;
 
     /**
      * \internal \brief number of failed threads
      */
-    unsigned int _errors;
+    std::atomic<unsigned int> _errors;
 
     /**
-     * \internal \brief contains the smart pointers to threads
+     * \internal \brief contains the smart pointers to the threads started by addSingleThread
      */
     std::vector<columbus::thread::PtrThread> _threads;
 
+    /**
+     * \internal \brief starts the worker threads
+     */
+    void start();
+
+    /**
+     * \internal \brief the main loop of a worker thread
+     */
+    void workerLoop(unsigned int index);
+
+    /**
+     * \internal \brief picks the next job for the given worker (own queue first, then stealing)
+     */
+    PtrPoolJob findJob(unsigned int index);
+
+    /**
+     * \internal \brief puts the job into a worker queue and wakes up one idle worker
+     */
+    void enqueue(const PtrPoolJob& job);
+
+    /**
+     * \internal \brief runs the job and maintains the counters
+     */
+    void execute(const PtrPoolJob& job);
+
   public:
 
     /**
@@ -116,11 +297,29 @@ namespace columbus { namespace thread {
     typedef boost::lock_guard<boost::shared_mutex> TaskLock;
 
     /**
-     * \brief add new task to thread pool
-     * \param task [in] smart pointer to a task object
-     * \return smart pointer to started thread
+     * \brief submits a callable to the pool
+     * \param func     [in] the callable object to run
+     * \param priority [in] the priority of the task
+     * \return handle of the task containing the future of its result
      */
-    PtrThread add(PtrTask task);
+    template <typename Func>
+    TaskFuture<std::invoke_result_t<std::decay_t<Func>>> submit(Func&& func, TaskPriority priority = tpNormal)
+    {
+      typedef std::invoke_result_t<std::decay_t<Func>> Result;
+      auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+      std::future<Result> future = packagedTask->get_future();
+      PtrPoolJob job = std::make_shared<PoolJob>([packagedTask]() { (*packagedTask)(); }, priority);
+      enqueue(job);
+      return TaskFuture<Result>(std::move(future), job);
+    }
+
+    /**
+     * \brief add new task to thread pool (compatibility interface, the task is run by one of the workers)
+     * \param task     [in] smart pointer to a task object
+     * \param priority [in] the priority of the task
+     * \return handle of the task
+     */
+    TaskFuture<void> add(PtrTask task, TaskPriority priority = tpNormal);
 
     /**
      * \brief start thread outside of thread pool
@@ -136,13 +335,13 @@ namespace columbus { namespace thread {
     unsigned int getPoolSize() const;
 
     /**
-     * \brief get the number of threads terminated with error
+     * \brief get the number of tasks terminated with error
      * \return number of errors
      */
     unsigned int getErrors() const;
 
     /**
-     * \brief wait until the threads are terminated
+     * \brief wait until all the added tasks and single threads are terminated (the workers stay alive)
      */
     void wait();
 
@@ -163,14 +362,11 @@ namespace columbus { namespace thread {
     ThreadPool();
 
     /**
-     * \brief destructor, wait end of all added thread
+     * \brief destructor, wait end of all added tasks and stops the workers
      */
     ~ThreadPool();
 
     static int getNumberOfCores();
-
-    friend class ThreadPoolTask;
-    friend class ThreadPoolTaskRunner;
   };
 
 }}
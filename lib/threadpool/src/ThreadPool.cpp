@@ -33,6 +33,13 @@ using namespace std;
 
 namespace columbus { namespace thread {
 
+  namespace {
+    // The pool and the worker index of the current thread (used to push the tasks submitted
+    // by a worker into its own queue).
+    thread_local ThreadPool* currentPool = nullptr;
+    thread_local unsigned int currentWorker = 0;
+  }
+
   class ThreadPoolTaskRunner {
   protected:
     ThreadPool::PtrTask _task;
@@ -48,69 +55,119 @@ namespace columbus { namespace thread {
 
   };
 
-  class ThreadPoolTask {
-  protected:
-    ThreadPool* _pool;
-    ThreadPool::PtrTask _task;
-  public:
-    ThreadPoolTask(ThreadPool* pool, ThreadPool::PtrTask task)
-      : _pool(pool)
-      , _task(task)
-    {
-    }
+  void ThreadPool::start()
+  {
+    if (_poolSize == 0)
+      _poolSize = 1;
 
-    ThreadPoolTask(const ThreadPoolTask& tpt)
-      : _pool(tpt._pool)
-      , _task(tpt._task)
-    {
-    }
+    for (unsigned int i = 0; i < _poolSize; ++i)
+      _queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+
+    for (unsigned int i = 0; i < _poolSize; ++i)
+      _workers.push_back(PtrThread(new boost::thread([this, i]() { workerLoop(i); })));
+  }
 
-    ThreadPoolTask& operator=(const ThreadPoolTask& tpt)
+  void ThreadPool::workerLoop(unsigned int index)
+  {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true)
     {
-      _pool = tpt._pool;
-      _task = tpt._task;
-      return *this;
+      PtrPoolJob job = findJob(index);
+      if (job)
+      {
+        execute(job);
+        continue;
+      }
+
+      boost::unique_lock<boost::mutex> lock(_idle_mutex);
+      _work_available.wait(lock, [this]() { return _stopping || _queued.load() > 0; });
+      if (_stopping && _queued.load() == 0)
+        return;
     }
+  }
 
-    void operator()()
+  PtrPoolJob ThreadPool::findJob(unsigned int index)
+  {
+    for (int priority = tpCount - 1; priority >= 0; --priority)
     {
-      while(true)
+      // own queue first (LIFO)
       {
+        WorkQueue& own = *_queues[index];
+        boost::lock_guard<boost::mutex> lock(own.lock);
+        std::deque<PtrPoolJob>& jobs = own.jobs[priority];
+        if (!jobs.empty())
         {
-          boost::unique_lock<boost::recursive_mutex > safe_running_lock(_pool->_running_lock);
-          if(_pool->_runnum < _pool->_poolSize) {
-            _pool->_runnum++;
-            break;
-          }
+          PtrPoolJob job = jobs.back();
+          jobs.pop_back();
+          --_queued;
+          return job;
         }
-        boost::unique_lock<boost::mutex> lock(_pool->_mutex_queue);
-        _pool->task_queue_cond.wait(lock);
       }
 
-      try
-      {
-        (*_task)();
-      }
-      catch (...)
+      // steal from the others (FIFO)
+      for (unsigned int i = 1; i < _poolSize; ++i)
       {
-        boost::unique_lock<boost::recursive_mutex > safe_running_lock(_pool->_running_lock);
-        ++_pool->_errors;
+        WorkQueue& victim = *_queues[(index + i) % _poolSize];
+        boost::lock_guard<boost::mutex> lock(victim.lock);
+        std::deque<PtrPoolJob>& jobs = victim.jobs[priority];
+        if (!jobs.empty())
+        {
+          PtrPoolJob job = jobs.front();
+          jobs.pop_front();
+          --_queued;
+          return job;
+        }
       }
+    }
+    return PtrPoolJob();
+  }
 
-      {
-        boost::unique_lock<boost::recursive_mutex > safe_running_lock(_pool->_running_lock);
-        _pool->_runnum--;
-      }
-      _pool->task_queue_cond.notify_all();
+  void ThreadPool::enqueue(const PtrPoolJob& job)
+  {
+    unsigned int index = (currentPool == this) ? currentWorker : (_next_queue++ % _poolSize);
+
+    ++_unfinished;
+    {
+      WorkQueue& queue = *_queues[index];
+      boost::lock_guard<boost::mutex> lock(queue.lock);
+      queue.jobs[job->getPriority()].push_back(job);
+      ++_queued;
     }
-    
-  };
 
-  PtrThread ThreadPool::add(PtrTask task)
+    // taking the mutex guarantees that a worker which is just going to sleep does not miss the notification
+    {
+      boost::lock_guard<boost::mutex> lock(_idle_mutex);
+    }
+    _work_available.notify_one();
+  }
+
+  void ThreadPool::execute(const PtrPoolJob& job)
   {
-    PtrThread newTask(new boost::thread(ThreadPoolTask(this, task)));
-    _threads.push_back(newTask);
-    return newTask;
+    // Cancelled jobs are simply dropped.
+    job->run();
+
+    if (--_unfinished == 0)
+    {
+      boost::lock_guard<boost::mutex> lock(_idle_mutex);
+      _all_done.notify_all();
+    }
+  }
+
+  TaskFuture<void> ThreadPool::add(PtrTask task, TaskPriority priority)
+  {
+    return submit([this, task]()
+    {
+      try
+      {
+        (*task)();
+      }
+      catch (...)
+      {
+        ++_errors;
+      }
+    }, priority);
   }
 
   PtrThread ThreadPool::addSingleThread(PtrTask task)
@@ -133,6 +190,11 @@ namespace columbus { namespace thread {
 
   void ThreadPool::wait()
   {
+    {
+      boost::unique_lock<boost::mutex> lock(_idle_mutex);
+      _all_done.wait(lock, [this]() { return _unfinished.load() == 0; });
+    }
+
     for(auto& threadPtr : _threads)
     {
       threadPtr->join();
@@ -141,29 +203,42 @@ namespace columbus { namespace thread {
 
   ThreadPool::ThreadPool(unsigned int poolSize)
     : _poolSize(poolSize)
-    , _running_lock()
-    , _mutex_queue()
-    , task_queue_cond()
-    , _runnum(0)
+    , _queued(0)
+    , _unfinished(0)
+    , _next_queue(0)
+    , _stopping(false)
     , _errors(0)
   {
+    start();
   }
 
   ThreadPool::ThreadPool()
     : _poolSize(1)
-    , _running_lock()
-    , _mutex_queue()
-    , task_queue_cond()
-    , _runnum(0)
+    , _queued(0)
+    , _unfinished(0)
+    , _next_queue(0)
+    , _stopping(false)
     , _errors(0)
   {
     // get number of cpu cores
     _poolSize = getNumberOfCores();
+    start();
   }
 
   ThreadPool::~ThreadPool(void)
   {
     wait();
+
+    {
+      boost::lock_guard<boost::mutex> lock(_idle_mutex);
+      _stopping = true;
+    }
+    _work_available.notify_all();
+
+    for (auto& worker : _workers)
+    {
+      worker->join();
+    }
   }
 
   boost::shared_mutex& ThreadPool::getTaskLockMutex()
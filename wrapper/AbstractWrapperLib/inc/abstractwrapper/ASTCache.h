@@ -0,0 +1,149 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef __AST_CACHE_H
+#define __AST_CACHE_H
+
+#include <boost/uuid/detail/sha1.hpp>
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#define AST_CACHE_DEPENDENCY_EXTENSION    ".deps"                       ///< CAN lists the input files of the translation unit into <output>.deps
+
+namespace ColumbusWrappers {
+
+  /**
+   * @brief Computes the SHA-1 digest of the keys and of the file contents of the AST cache.
+   */
+  class CacheHasher {
+  public:
+    CacheHasher();
+
+    /**
+     * @brief Adds a string to the hash. The strings are separated, so ("ab", "c") and ("a", "bc") give different hashes.
+     * @param part           [in] The string.
+     */
+    void add(const std::string& part);
+
+    /**
+     * @brief Adds the content of a file to the hash.
+     * @param filename       [in] The name of the file.
+     * @return                    False, if the file cannot be read.
+     */
+    bool addFile(const std::string& filename);
+
+    /**
+     * @brief Returns the digest as a hexadecimal string.
+     */
+    std::string str() const;
+
+  private:
+    boost::uuids::detail::sha1 sha;
+  };
+
+  /**
+   * @brief Content-addressed cache of the CAN outputs (.ast, .comment and the .err of cppcheck).
+   *
+   * It works like the direct mode of ccache. The primary key is the hash of the canonical command line and of the source file.
+   * Its manifest lists the files included by the translation unit in the last analysis. The outputs are stored under the
+   * result key, which is the hash of the primary key and of the current contents of these files. So a translation unit is
+   * looked up without preprocessing it. The least recently used entries are evicted when the cache grows over its size limit.
+   */
+  class ASTCache {
+  public:
+    /**
+     * @brief Constructor of ASTCache class.
+     * @param cacheDir       [in] The directory of the cache, it is shared by the parallel wrappers.
+     * @param maxSize        [in] The size limit of the cache in bytes.
+     */
+    ASTCache(const std::string& cacheDir, uint64_t maxSize);
+
+    /**
+     * @brief Looks up the translation unit and links (or copies) the cached outputs to their place.
+     * @param primaryKey     [in] The primary key of the translation unit.
+     * @param output         [in] The AST file to be created.
+     * @param withErr        [in] The entry has to contain the output of cppcheck as well.
+     * @return                    True, if the outputs are created from the cache.
+     */
+    bool retrieve(const std::string& primaryKey, const std::string& output, bool withErr);
+
+    /**
+     * @brief Stores the outputs of a successful analysis. The dependency file written by CAN is deleted.
+     * @param primaryKey     [in] The primary key of the translation unit.
+     * @param output         [in] The AST file created by CAN.
+     * @param withErr        [in] The output of cppcheck is stored as well.
+     * @param startTime      [in] The time when the analysis was started; if an input file is modified since then, nothing is stored.
+     * @return                    True, if the outputs are stored.
+     */
+    bool store(const std::string& primaryKey, const std::string& output, bool withErr, std::time_t startTime);
+
+  private:
+    /**
+     * @brief Returns the full path of a cache file, the files are distributed into subdirectories by the first two digits of their key.
+     */
+    std::string getEntryName(const std::string& key, const std::string& extension) const;
+
+    /**
+     * @brief Computes the result key from the primary key and the input files listed in the manifest.
+     * @return                    False, if an input file does not exist.
+     */
+    bool getResultKey(const std::string& primaryKey, const std::vector<std::string>& dependencies, std::string& resultKey);
+
+    /**
+     * @brief Copies the file into the cache through a temporary file, so the parallel readers never see a partial file.
+     * @param source         [in] The file to be stored.
+     * @param target         [in] The name of the file in the cache.
+     * @param delta          [in,out] The size change of the cache is added to it.
+     * @return                    True, if the file is stored.
+     */
+    bool storeFile(const std::string& source, const std::string& target, int64_t& delta) const;
+
+    /**
+     * @brief Renames the temporary file to its name in the cache (replacing the previous version).
+     * @param temporary      [in] The temporary file in the directory of the target.
+     * @param target         [in] The name of the file in the cache.
+     * @param delta          [in,out] The size change of the cache is added to it.
+     * @return                    True, if the file is renamed.
+     */
+    bool publishFile(const std::string& temporary, const std::string& target, int64_t& delta) const;
+
+    /**
+     * @brief Adds the size change to the size of the cache and evicts the least recently used files if the cache is too big.
+     */
+    void updateSize(int64_t delta) const;
+
+    /**
+     * @brief Deletes the least recently used files until the cache shrinks to 80% of its limit.
+     * @return                    The size of the cache after the cleanup.
+     */
+    uint64_t cleanup() const;
+
+    std::string cacheDir;                           ///< the directory of the cache
+    uint64_t maxSize;                               ///< the size limit of the cache in bytes
+    std::map<std::string, std::string> fileHashes;  ///< the content hashes of the input files computed by this wrapper
+  };
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 #include "AbstractWrapper.h"
 #include "AbstractWrapperLib/inc/paramsup/ParamsupCommon.h"
 #include <boost/interprocess/sync/file_lock.hpp>
@@ -88,6 +89,29 @@ namespace ColumbusWrappers {
      */
     void concatenatePrefixAndParams(const char* prefix, const std::list<Argument>& input_list, std::list<Argument>& output_paramlist, bool separately = true) const;
 
+    /**
+     * @brief Returns the hash of the analyzer tools (CAN and cppcheck). It is computed by the first compiler wrapper and stored in the config file.
+     * @return                         The hash of the tools.
+     */
+    std::string getAnalyzerToolHash() const;
+
+    /**
+     * @brief Computes the primary key of a translation unit in the AST cache.
+     * @param analyzerArgs       [in] The arguments of CAN.
+     * @param cppcheckArgs       [in] The arguments of cppcheck (empty if it is not run).
+     * @param workDir            [in] The working directory of the compiler, the relative paths of the arguments are resolved in it.
+     * @return                         The primary key.
+     */
+    std::string getASTCacheKey(const std::vector<std::string>& analyzerArgs, const std::vector<std::string>& cppcheckArgs, const std::string& workDir) const;
+
+    /**
+     * @brief Appends the result of an AST cache lookup to the statCANCache.csv.
+     * @param input              [in] The analyzed source file.
+     * @param hit                [in] True, if the outputs are taken from the cache.
+     * @param seconds            [in] The time of the lookup.
+     */
+    void writeASTCacheStat(const std::string& input, bool hit, double seconds) const;
+
     int comp_needtorun;                                             ///< compiling needed or not from config
     int instrument_mode;                                            ///< define instrumentatation mode
     int comp_needstat;                                              ///< CAN needed to create stat file or not
@@ -99,6 +123,8 @@ namespace ColumbusWrappers {
     std::vector<std::string> comp_extraparam;                       ///< extra parameters for CAN
     int comp_numofextraparam;                                       ///< number of extra parameters
     std::string filter_path;                                        ///< path to the softfilter file
+    std::string ast_cache_dir;                                      ///< directory of the AST cache (the cache is not used if it is empty)
+    int ast_cache_size;                                             ///< size limit of the AST cache in MByte
 
     std::string comp_tool;                                          ///< name of the compiler tool (CAN)
     std::string comp_config_tool;                                   ///< name of the compiler configuration tool (CANConfig)
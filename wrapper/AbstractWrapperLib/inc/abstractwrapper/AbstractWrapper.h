@@ -26,6 +26,8 @@
 #include <set>
 #include <vector>
 
+#include "DeferredCommand.h"
+
 namespace ColumbusWrappers {
   class AbstractWrapper {
 
@@ -85,7 +87,7 @@ namespace ColumbusWrappers {
     /**
      * @brief Wraps common::getPrivateProfileString()
      */
-    std::string getConfigString(const char* section, const char* key, const char* def);
+    std::string getConfigString(const char* section, const char* key, const char* def) const;
 
     /**
      * @brief Collects arguments and their number of parameters from the configuration which are need to be skipped.
@@ -188,6 +190,13 @@ namespace ColumbusWrappers {
      */
     int  silentSystemCall (const std::string& cmd) const; 
 
+    /**
+     * @brief Appends the command to the journal of the deferred analysis.
+     * @param command        [in] The deferred command.
+     * @return                    True, if the command is recorded.
+     */
+    bool deferCommand(const DeferredCommand& command) const;
+
     /**
      * @brief Determines whether the given file is an object file or not.
      * @param name           [in] The given file name.
@@ -232,6 +241,7 @@ namespace ColumbusWrappers {
 
     int instrument_enable;                            ///< instrument is enabled or not
     int prep_instrument;                              ///< prepare for instrument: it means that the CAN analyzes preprocessed files, so we have to preprocess these files before CAN calling
+    int defer_analysis;                               ///< the analyzer commands are recorded into the journal and the DeferredAnalysis runs them after the build
   };
 }
 
@@ -0,0 +1,94 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef __DEFERRED_COMMAND_H
+#define __DEFERRED_COMMAND_H
+
+#include <string>
+#include <vector>
+
+#define DEFERRED_ANALYSIS_JOURNAL         "deferred.journal"            ///< the name of the journal in the wrapper log directory
+
+namespace ColumbusWrappers {
+
+  /**
+   * @brief A command of the analysis which is recorded by the wrapper instead of running it.
+   *
+   * The wrapper appends the commands to the journal, the DeferredAnalysis runs them after the build.
+   */
+  struct DeferredCommand {
+    /**
+     * @brief Enum for the kinds of the deferred commands.
+     */
+    enum Kind {
+      dck_analyze,    ///< CAN, the commands of this kind are independent of each other
+      dck_cppcheck,   ///< cppcheck, the commands of this kind are independent of each other
+      dck_archive,    ///< CANLib, it depends on the previous commands
+      dck_link        ///< CANLink, it depends on the previous commands
+    };
+
+    DeferredCommand() : kind(dck_analyze) {}
+
+    /**
+     * @brief Marks an entry of the input list which is written into the input list file only if it exists when the command is run.
+     * @param filename       [in] The name of the file.
+     * @return                    The marked entry.
+     */
+    static std::string optionalInput(const std::string& filename);
+
+    Kind kind;                              ///< The kind of the command.
+    std::string workDir;                    ///< The working directory of the wrapped tool.
+    std::string input;                      ///< The analyzed source file (dck_analyze), its errors are not reported if it is filtered out.
+    std::string output;                     ///< The full path of the output of the command.
+    std::string resultList;                 ///< The output is appended to this list file (ast.list, aast.list, component.list) after a successful run.
+    std::string stderrFile;                 ///< The standard error of the command is redirected into this file.
+    std::string inputListFile;              ///< The input list file of the command which is written from the inputList before the run.
+    std::string commandLine;                ///< The whole command line if the command is run through the shell (otherwise it is empty).
+    std::string executable;                 ///< The executable of the command.
+    std::vector<std::string> arguments;     ///< The arguments of the executable.
+    std::vector<std::string> inputList;     ///< The content of the input list file.
+  };
+
+  /**
+   * @brief Returns the name of the journal.
+   * @param logDir         [in] The wrapper log directory.
+   * @return                    The full path of the journal.
+   */
+  std::string getDeferredJournalName(const std::string& logDir);
+
+  /**
+   * @brief Appends the command to the journal. The journal is locked during the writing, so the wrappers can run parallel.
+   * @param journal        [in] The name of the journal.
+   * @param command        [in] The deferred command.
+   * @return                    True, if the command is written.
+   */
+  bool appendDeferredCommand(const std::string& journal, const DeferredCommand& command);
+
+  /**
+   * @brief Reads all the commands of the journal in the order of their recording.
+   * @param journal        [in] The name of the journal.
+   * @param commands       [out] The commands are appended to this vector.
+   * @return                    False, if the journal cannot be opened or it is corrupt.
+   */
+  bool loadDeferredCommands(const std::string& journal, std::vector<DeferredCommand>& commands);
+
+}
+
+#endif
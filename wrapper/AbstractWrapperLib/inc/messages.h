@@ -80,6 +80,23 @@
 #define CMSG_ABSTRACT_WRAPPER_SPLIT_COMMAND_FILE_ARGS              common::WriteMsg::mlDDDebug, "Argument from commandfile after splitting arguments: %s"
 #define CMSG_ABSTRACT_WRAPPER_COMMAND_FILE_ARGS_QOUTES_REMOVED     common::WriteMsg::mlDDDebug, "Argument from commandfile after removing quotes: %s"
 
+//DeferredAnalysis messages
+#define CMSG_CANNOT_WRITE_DEFERRED_JOURNAL                         "Cannot write the deferred analysis journal: %s"
+#define CMSG_CANNOT_READ_DEFERRED_JOURNAL                          "Cannot read the deferred analysis journal: %s"
+#define CMSG_COMMAND_DEFERRED                                      "The analysis of %s is deferred."
+#define CMSG_DEFERRED_ANALYSIS_STARTED                             "Running %d deferred commands on %d threads."
+#define CMSG_DEFERRED_ANALYSIS_WRONG_ARGUMENT                      "Wrong argument: %s"
+#define CMSG_DEFERRED_ANALYSIS_WAITING_FOR_LOAD                    common::WriteMsg::mlDDebug, "Waiting for the system load (%.2f) to drop below %.2f."
+#define CMSG_CANNOT_CHANGE_WORKDIR                                 "Cannot change the working directory to %s"
+
+//ASTCache messages
+#define CMSG_AST_CACHE_HIT                                         "The AST of %s is taken from the cache."
+#define CMSG_AST_CACHE_MISS                                        common::WriteMsg::mlDebug, "The AST of %s is not found in the cache."
+#define CMSG_AST_CACHE_STORED                                      common::WriteMsg::mlDebug, "The AST %s is stored in the cache."
+#define CMSG_AST_CACHE_INPUT_MODIFIED                              "The input file %s was modified during the analysis, the AST is not cached."
+#define CMSG_AST_CACHE_CANNOT_STORE                                "Cannot store %s in the AST cache."
+#define CMSG_AST_CACHE_CLEANUP                                     "The AST cache is cleaned up, its size is %llu MByte."
+
 //ArParamsup messages
 #define CMSG_AR_PARAMSUP_NO_OUTPUT_ARCHIVE_FILE                    "No output archive file was given!"
 
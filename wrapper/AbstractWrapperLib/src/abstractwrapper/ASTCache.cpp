@@ -0,0 +1,367 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/filesystem.hpp>
+#include "../../inc/abstractwrapper/ASTCache.h"
+#include "../../inc/paramsup/ParamsupCommon.h"
+#include "../../inc/messages.h"
+
+#include <common/inc/FileSup.h>
+#include <common/inc/WriteMessage.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace common;
+using namespace boost::interprocess;
+
+#define AST_CACHE               "ASTCache"
+#define AST_CACHE_MANIFEST_TAG  "ASTCACHE 1"
+#define AST_CACHE_SIZE_FILE     "size"
+
+namespace ColumbusWrappers {
+
+  CacheHasher::CacheHasher() : sha()
+  {
+  }
+
+  void CacheHasher::add(const string& part)
+  {
+    uint64_t size = part.size();
+    char sizeBytes[sizeof(size)];
+    for (size_t i = 0; i < sizeof(size); ++i)
+      sizeBytes[i] = (char)(size >> (8 * i));
+
+    sha.process_bytes(sizeBytes, sizeof(sizeBytes));
+    sha.process_bytes(part.data(), part.size());
+  }
+
+  bool CacheHasher::addFile(const string& filename)
+  {
+    ifstream in(filename.c_str(), ios::binary);
+    if (!in.is_open())
+      return false;
+
+    vector<char> buffer(1 << 16);
+    uint64_t size = 0;
+    while (in)
+    {
+      in.read(buffer.data(), buffer.size());
+      sha.process_bytes(buffer.data(), (size_t)in.gcount());
+      size += (uint64_t)in.gcount();
+    }
+
+    add(to_string(size));
+    return !in.bad();
+  }
+
+  string CacheHasher::str() const
+  {
+    // the digest is finalized on a copy, so more data can be added afterwards
+    boost::uuids::detail::sha1 copy(sha);
+    boost::uuids::detail::sha1::digest_type digest;
+    copy.get_digest(digest);
+
+    stringstream stream;
+    stream << hex << setfill('0');
+    for (const auto& part : digest)
+      stream << setw(2 * sizeof(part)) << (unsigned)part;
+    return stream.str();
+  }
+
+
+  namespace
+  {
+    bool loadLines(const string& filename, vector<string>& lines)
+    {
+      ifstream in(filename.c_str(), ios::binary);
+      if (!in.is_open())
+        return false;
+
+      string line;
+      while (getline(in, line))
+      {
+        if (!line.empty() && line[line.length() - 1] == '\r')
+          line.erase(line.length() - 1);
+        if (!line.empty())
+          lines.push_back(line);
+      }
+      return true;
+    }
+
+    // Creates the file from the cache. Hard links are used if possible, as the ASTs are big.
+    bool linkFile(const string& source, const string& target)
+    {
+      boost::system::error_code ec;
+      boost::filesystem::remove(target, ec);
+      boost::filesystem::create_hard_link(source, target, ec);
+      if (ec)
+      {
+        ec.clear();
+        boost::filesystem::copy_file(source, target, boost::filesystem::copy_option::overwrite_if_exists, ec);
+      }
+      return !ec;
+    }
+
+    // The least recently used entries are evicted first, so a hit renews the files of the entry.
+    void touchFile(const string& filename)
+    {
+      boost::system::error_code ec;
+      boost::filesystem::last_write_time(filename, time(nullptr), ec);
+    }
+  }
+
+
+  ASTCache::ASTCache(const string& cacheDir, uint64_t maxSize) : cacheDir(cacheDir), maxSize(maxSize), fileHashes()
+  {
+  }
+
+  string ASTCache::getEntryName(const string& key, const string& extension) const
+  {
+    return (boost::filesystem::path(cacheDir) / key.substr(0, 2) / (key + extension)).string();
+  }
+
+  bool ASTCache::getResultKey(const string& primaryKey, const vector<string>& dependencies, string& resultKey)
+  {
+    CacheHasher hasher;
+    hasher.add(primaryKey);
+    for (const auto& dependency : dependencies)
+    {
+      auto it = fileHashes.find(dependency);
+      if (it == fileHashes.end())
+      {
+        CacheHasher fileHasher;
+        if (!fileHasher.addFile(dependency))
+          return false;
+
+        it = fileHashes.insert(make_pair(dependency, fileHasher.str())).first;
+      }
+      hasher.add(dependency);
+      hasher.add(it->second);
+    }
+    resultKey = hasher.str();
+    return true;
+  }
+
+  bool ASTCache::retrieve(const string& primaryKey, const string& output, bool withErr)
+  {
+    const string manifest = getEntryName(primaryKey, ".manifest");
+    vector<string> dependencies;
+    string resultKey;
+    if (!loadLines(manifest, dependencies) || dependencies.empty() || dependencies.front() != AST_CACHE_MANIFEST_TAG)
+      return false;
+
+    dependencies.erase(dependencies.begin());
+    if (!getResultKey(primaryKey, dependencies, resultKey))
+      return false;
+
+    vector<pair<string, string>> files;
+    files.push_back(make_pair(getEntryName(resultKey, ".ast"), output));
+    files.push_back(make_pair(getEntryName(resultKey, ".ast.comment"), output + ".comment"));
+    if (withErr)
+      files.push_back(make_pair(getEntryName(resultKey, ".ast.err"), output + ".err"));
+
+    for (const auto& file : files)
+    {
+      if (!linkFile(file.first, file.second))
+      {
+        for (const auto& created : files)
+          pathDeleteFile(created.second);
+        return false;
+      }
+    }
+
+    touchFile(manifest);
+    for (const auto& file : files)
+      touchFile(file.first);
+
+    return true;
+  }
+
+  bool ASTCache::store(const string& primaryKey, const string& output, bool withErr, time_t startTime)
+  {
+    const string dependencyFile = output + AST_CACHE_DEPENDENCY_EXTENSION;
+    vector<string> dependencies;
+    bool loaded = loadLines(dependencyFile, dependencies);
+    pathDeleteFile(dependencyFile);
+    if (!loaded || dependencies.empty())
+      return false;
+
+    // The outputs may not belong to the current contents of a file modified during the analysis.
+    for (const auto& dependency : dependencies)
+    {
+      boost::system::error_code ec;
+      time_t modified = boost::filesystem::last_write_time(dependency, ec);
+      if (ec || modified >= startTime)
+      {
+        writeInfoMsg(AST_CACHE, CMSG_AST_CACHE_INPUT_MODIFIED, dependency.c_str());
+        return false;
+      }
+    }
+
+    string resultKey;
+    if (!getResultKey(primaryKey, dependencies, resultKey))
+      return false;
+
+    // The results are stored before the manifest, so a manifest always refers to complete results.
+    int64_t delta = 0;
+    bool ok = storeFile(output, getEntryName(resultKey, ".ast"), delta)
+           && storeFile(output + ".comment", getEntryName(resultKey, ".ast.comment"), delta)
+           && (!withErr || storeFile(output + ".err", getEntryName(resultKey, ".ast.err"), delta));
+
+    if (ok)
+    {
+      const string manifest = getEntryName(primaryKey, ".manifest");
+      const string temporary = manifest + "." + boost::filesystem::unique_path().string() + ".tmp";
+      boost::system::error_code ec;
+      boost::filesystem::create_directories(boost::filesystem::path(manifest).parent_path(), ec);
+
+      ofstream out(temporary.c_str(), ios::binary);
+      out << AST_CACHE_MANIFEST_TAG << '\n';
+      for (const auto& dependency : dependencies)
+        out << dependency << '\n';
+      out.close();
+      ok = out && publishFile(temporary, manifest, delta);
+    }
+
+    if (!ok)
+      writeWarningMsg(AST_CACHE, CMSG_AST_CACHE_CANNOT_STORE, output.c_str());
+    else
+      writeDebugMsg(AST_CACHE, CMSG_AST_CACHE_STORED, output.c_str());
+
+    updateSize(delta);
+    return ok;
+  }
+
+  bool ASTCache::storeFile(const string& source, const string& target, int64_t& delta) const
+  {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(boost::filesystem::path(target).parent_path(), ec);
+
+    const string temporary = target + "." + boost::filesystem::unique_path().string() + ".tmp";
+    boost::filesystem::copy_file(source, temporary, boost::filesystem::copy_option::overwrite_if_exists, ec);
+    if (ec)
+    {
+      pathDeleteFile(temporary);
+      return false;
+    }
+    return publishFile(temporary, target, delta);
+  }
+
+  bool ASTCache::publishFile(const string& temporary, const string& target, int64_t& delta) const
+  {
+    boost::system::error_code ec;
+    uintmax_t oldSize = boost::filesystem::file_size(target, ec);
+    if (ec)
+      oldSize = 0;
+
+    uintmax_t newSize = boost::filesystem::file_size(temporary, ec);
+    if (!ec)
+      boost::filesystem::rename(temporary, target, ec);
+
+    if (ec)
+    {
+      pathDeleteFile(temporary);
+      return false;
+    }
+
+    delta += (int64_t)newSize - (int64_t)oldSize;
+    return true;
+  }
+
+  void ASTCache::updateSize(int64_t delta) const
+  {
+    if (delta == 0)
+      return;
+
+    try
+    {
+      const string sizeFile = (boost::filesystem::path(cacheDir) / AST_CACHE_SIZE_FILE).string();
+      const string lockFile = getLockFileName(sizeFile);
+      ofstream lock(lockFile.c_str());
+      file_lock f_lock(lockFile.c_str());
+      boost::interprocess::scoped_lock<file_lock> e_lock(f_lock);
+
+      int64_t size = 0;
+      {
+        ifstream in(sizeFile.c_str());
+        in >> size;
+      }
+
+      size = max<int64_t>(0, size + delta);
+      if ((uint64_t)size > maxSize)
+        size = (int64_t)cleanup();
+
+      ofstream out(sizeFile.c_str(), ios::trunc);
+      out << size << endl;
+    }
+    catch (const interprocess_exception& ex)
+    {
+      writeWarningMsg(AST_CACHE, "%s", ex.what());
+    }
+  }
+
+  uint64_t ASTCache::cleanup() const
+  {
+    struct CacheFile
+    {
+      time_t lastUse;
+      uintmax_t size;
+      boost::filesystem::path path;
+    };
+
+    vector<CacheFile> files;
+    uint64_t size = 0;
+    boost::system::error_code ec;
+    for (boost::filesystem::recursive_directory_iterator it(cacheDir, ec), end; !ec && it != end; it.increment(ec))
+    {
+      const boost::filesystem::path& path = it->path();
+      if (it.depth() == 0 || !boost::filesystem::is_regular_file(path, ec) || path.extension() == ".tmp")
+        continue;
+
+      CacheFile file = { boost::filesystem::last_write_time(path, ec), boost::filesystem::file_size(path, ec), path };
+      if (ec)
+        continue;
+
+      size += file.size;
+      files.push_back(file);
+    }
+
+    sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) { return a.lastUse < b.lastUse; });
+
+    const uint64_t targetSize = maxSize / 10 * 8;
+    for (const auto& file : files)
+    {
+      if (size <= targetSize)
+        break;
+
+      if (boost::filesystem::remove(file.path, ec))
+        size -= file.size;
+    }
+
+    writeInfoMsg(AST_CACHE, CMSG_AST_CACHE_CLEANUP, (unsigned long long)(size / (1024 * 1024)));
+    return size;
+  }
+
+}
@@ -113,7 +113,12 @@ namespace ColumbusWrappers {
       for (const auto& extraFileExtension : extraFiles)
       {
         string extraFileName = astName + extraFileExtension;
-        if (common::pathFileExists(extraFileName))
+        if (defer_analysis)
+        {
+          // it is created by the deferred analysis too
+          inputFileList.push_back(DeferredCommand::optionalInput(extraFileName));
+        }
+        else if (common::pathFileExists(extraFileName))
         {
           inputFileList.push_back(extraFileName);
         }
@@ -122,12 +127,15 @@ namespace ColumbusWrappers {
     }
 
     string inputfile_list = wrapper_temp_dir + DIRDIVSTRING + common::toString(getCurrentProcessId()) + "input.list";
-    ofstream inputlist(inputfile_list.c_str(), ios::trunc);
-    if (inputlist.is_open())
+    if (!defer_analysis)
     {
-      for (const string& inputFilename : inputFileList)
-        inputlist << inputFilename << "\n";
-      inputlist.close();
+      ofstream inputlist(inputfile_list.c_str(), ios::trunc);
+      if (inputlist.is_open())
+      {
+        for (const string& inputFilename : inputFileList)
+          inputlist << inputFilename << "\n";
+        inputlist.close();
+      }
     }
 
     if (archive_needstat)
@@ -144,6 +152,20 @@ namespace ColumbusWrappers {
     for (const string& arg : args)
       writeInfoMsg(ABSTRACT_ARCHIVE, "[%s]", arg.c_str());
 
+    if (defer_analysis)
+    {
+      DeferredCommand command;
+      command.kind = DeferredCommand::dck_archive;
+      command.workDir = currentWorkDir;
+      command.output = indepFullpath(aastFileName);
+      command.resultList = wrapper_log_dir + DIRDIVSTRING + "aast.list";
+      command.inputListFile = inputfile_list;
+      command.executable = archive_tool;
+      command.arguments = args;
+      command.inputList.assign(inputFileList.begin(), inputFileList.end());
+      return deferCommand(command);
+    }
+
     int ret = systemCall(archive_tool, args);
     if (ret != 0)
     {
@@ -25,13 +25,16 @@
 #include <common/inc/PlatformDependentDefines.h>
 #include <common/inc/WriteMessage.h>
 #include <common/inc/DirectoryFilter.h>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <regex>
 #include <functional>
 #include <sstream>
 
 
 #include "../../inc/abstractwrapper/AbstractCompiler.h"
+#include "../../inc/abstractwrapper/ASTCache.h"
 #include "../../inc/messages.h"
 
 
@@ -92,6 +95,7 @@ namespace ColumbusWrappers {
                                                           comp_numofparamtoskip(0),
                                                           comp_extraparam(),
                                                           comp_numofextraparam(0),
+                                                          ast_cache_size(5120),
                                                           comp_tool(),
                                                           cl_version { 0, 0, 0 },
                                                           clang_version { 0, 0, 0 },
@@ -111,6 +115,8 @@ namespace ColumbusWrappers {
     no_delayed_template_parsing = getConfigInt(COMPILERSECTION, NO_DELAYED_TEMPLATE_PARSING, 0);
     comp_ml = getConfigInt(COMPILERSECTION, TOOL_MESSAGE_LEVEL, 2);
     filter_path = getConfigString(LINKERSECTION, LINK_FILTER_FILE, NULL);
+    ast_cache_dir = getConfigString(COMPILERSECTION, AST_CACHE_DIR, NULL);
+    ast_cache_size = getConfigInt(COMPILERSECTION, AST_CACHE_SIZE, 5120);
 
     comp_numofparamtoskip = getConfigInt(COMPILERSECTION, NUM_OF_PARAM_TO_SKIP, 0);
     getParamToSkip(COMPILERSECTION, comp_numofparamtoskip, comp_paramtoskip);
@@ -248,6 +254,96 @@ namespace ColumbusWrappers {
   }
 
 
+  string AbstractCompiler::getAnalyzerToolHash() const
+  {
+    string toolHash = getConfigString(COMPILERSECTION, AST_CACHE_TOOL_HASH, NULL);
+    if (!toolHash.empty())
+      return toolHash;
+
+    try
+    {
+      string lockFileName = common::getLockFileName(configfile);
+      ofstream lock(lockFileName.c_str());
+      file_lock f_lock(lockFileName.c_str());
+      scoped_lock<file_lock> e_lock(f_lock);
+
+      // the tools are copied into the wrapper directory for every analysis, so their content is hashed instead of their modification time
+      toolHash = getConfigString(COMPILERSECTION, AST_CACHE_TOOL_HASH, NULL);
+      if (toolHash.empty())
+      {
+        CacheHasher hasher;
+        hasher.addFile(comp_tool + BINARYEXT);
+        if (run_cppcheck)
+          hasher.addFile(wrapper_bin_dir + DIRDIVSTRING + "cppcheck" + DIRDIVSTRING + "cppcheck" + BINARYEXT);
+
+        toolHash = hasher.str();
+        writePrivateProfileString(COMPILERSECTION, AST_CACHE_TOOL_HASH, toolHash.c_str(), configfile.c_str());
+      }
+    }
+    catch (const boost::interprocess::interprocess_exception& ex)
+    {
+      writeInfoMsg(ABSTRACT_COMPILER, "Failed to store the hash of the analyzer tools! (%s)\n", ex.what());
+    }
+    return toolHash;
+  }
+
+  string AbstractCompiler::getASTCacheKey(const vector<string>& analyzerArgs, const vector<string>& cppcheckArgs, const string& workDir) const
+  {
+    CacheHasher hasher;
+    hasher.add(getAnalyzerToolHash());
+    hasher.add(workDir);
+
+    for (const auto& argument : analyzerArgs)
+    {
+      // the outputs do not depend on the output names and on the filter
+      if (argument.find("-o=") == 0 || argument.find("-stat=") == 0 || argument.find("-fltp=") == 0)
+        continue;
+
+      // the config file of CAN is in the wrapper work directory, which is not the same in every analysis
+      if (argument.find("-config=") == 0)
+      {
+        hasher.add("-config=");
+        hasher.addFile(argument.substr(8));
+        continue;
+      }
+
+      hasher.add(argument);
+    }
+
+    hasher.add("cppcheck");
+    for (const auto& argument : cppcheckArgs)
+      hasher.add(argument);
+
+    return hasher.str();
+  }
+
+  void AbstractCompiler::writeASTCacheStat(const string& input, bool hit, double seconds) const
+  {
+    if (!comp_needstat)
+      return;
+
+    try
+    {
+      string statfile = wrapper_log_dir + DIRDIVSTRING + "statCANCache.csv";
+      string lockFile = getLockFileName(statfile);
+      ofstream lock(lockFile.c_str());
+      file_lock f_lock(lockFile.c_str());
+      scoped_lock<file_lock> e_lock(f_lock);
+
+      bool writeHeader = !pathFileExists(statfile, false);
+      ofstream stat(statfile.c_str(), ios::app);
+      if (writeHeader)
+        stat << "Input;Cache result;Lookup time (s)" << endl;
+
+      stat << input << ';' << (hit ? "hit" : "miss") << ';' << fixed << setprecision(2) << seconds << endl;
+    }
+    catch (const boost::interprocess::interprocess_exception& ex)
+    {
+      writeInfoMsg(ABSTRACT_COMPILER, "Failed to write the AST cache statistics! (%s)\n", ex.what());
+    }
+  }
+
+
   bool AbstractCompiler::executeCompiler(CompilerArgs& compArgs, PreprocArgs& preprocArgs, list<Argument>& generated_files) const {
     if (compArgs.comp_input_files.empty()) {
       writeWarningMsg(ABSTRACT_COMPILER, CMSG_COMPILER_HAS_NO_INPUT);
@@ -310,6 +406,7 @@ namespace ColumbusWrappers {
     }
 
     bool ok = true;
+    ASTCache astCache(ast_cache_dir, (uint64_t)ast_cache_size * 1024 * 1024);
 
     for(list<Argument>::const_iterator it_f = compArgs.comp_input_files.begin(); it_f != compArgs.comp_input_files.end(); it_f++) {
       Argument outputFileArg;
@@ -483,12 +580,11 @@ namespace ColumbusWrappers {
         writeInfoMsg(ABSTRACT_COMPILER, "%s", arg.c_str());
       }
 
-      int ret = systemCall (comp_tool, analyzer_command_arguments);
-
-      if(run_cppcheck && (lang == "c" || lang == "c++")) {
-        vector<string> cppcheck_args;
-        string cppcheck_cmd = wrapper_bin_dir + DIRDIVSTRING + "cppcheck" + DIRDIVSTRING + "cppcheck";
+      const bool runs_cppcheck = run_cppcheck && (lang == "c" || lang == "c++");
+      vector<string> cppcheck_args;
+      string cppcheck_cmd = wrapper_bin_dir + DIRDIVSTRING + "cppcheck" + DIRDIVSTRING + "cppcheck";
 
+      if(runs_cppcheck) {
         cppcheck_args.push_back("--xml");
         cppcheck_args.push_back("--xml-version=2");
 
@@ -524,7 +620,52 @@ namespace ColumbusWrappers {
         }
         
         cppcheck_args.push_back(indepFullpath(input));
+      }
+
+      // the outputs may be hard links into the AST cache, so they are recreated instead of being overwritten
+      pathDeleteFile(output);
+      pathDeleteFile(output + ".comment");
+
+      int ret = 0;
+      bool cached = false;
+      bool cppcheck_ok = true;
+      string cache_key;
+      time_t start_time = time(nullptr);
+
+      if (!ast_cache_dir.empty()) {
+        auto lookup_start = chrono::steady_clock::now();
+        cache_key = getASTCacheKey(analyzer_command_arguments, cppcheck_args, tmpdir);
+        cached = astCache.retrieve(cache_key, output, runs_cppcheck);
+        writeASTCacheStat(common::pathCanonicalize(input.c_str()), cached, chrono::duration<double>(chrono::steady_clock::now() - lookup_start).count());
+
+        if (cached) {
+          writeInfoMsg(ABSTRACT_COMPILER, CMSG_AST_CACHE_HIT, input.c_str());
+        } else {
+          writeDebugMsg(ABSTRACT_COMPILER, CMSG_AST_CACHE_MISS, input.c_str());
+
+          // CAN lists the files of the translation unit, they are the dependencies of the new cache entry
+          if (!defer_analysis)
+            analyzer_command_arguments.insert(analyzer_command_arguments.end() - 2, "-deps=" + output + AST_CACHE_DEPENDENCY_EXTENSION);
+        }
+      }
+
+      if (!cached) {
+        if (defer_analysis) {
+          DeferredCommand command;
+          command.kind = DeferredCommand::dck_analyze;
+          command.workDir = tmpdir;
+          command.input = common::pathCanonicalize(input.c_str());
+          command.output = indepFullpath(output);
+          command.resultList = wrapper_log_dir + DIRDIVSTRING + "ast.list";
+          command.executable = comp_tool;
+          command.arguments = analyzer_command_arguments;
+          ok = deferCommand(command) && ok;
+        } else {
+          ret = systemCall (comp_tool, analyzer_command_arguments);
+        }
+      }
 
+      if(runs_cppcheck && !cached) {
         string cppcheck_cmd_full = cppcheck_cmd;
         for(vector<string>::iterator it = cppcheck_args.begin(); it != cppcheck_args.end(); ++it)
           cppcheck_cmd_full += " " + *it;
@@ -532,15 +673,38 @@ namespace ColumbusWrappers {
         writeInfoMsg(ABSTRACT_COMPILER, CMSG_ANALYZER_WRAPPER_COMMAND, cppcheck_cmd_full.c_str());
         
         pathDeleteFile(output + ".err");
-        int ret_cc = common::run(cppcheck_cmd, cppcheck_args, "", output + ".err");
-        if(ret_cc != 0) {
-          pathDeleteFile(output + ".err");
-          writeErrorMsg(ABSTRACT_COMPILER, CMSG_CPPCHECK_FAILED, ret_cc);
-          ok = false;
+        if (defer_analysis) {
+          DeferredCommand command;
+          command.kind = DeferredCommand::dck_cppcheck;
+          command.workDir = tmpdir;
+          command.output = indepFullpath(output);
+          command.stderrFile = command.output + ".err";
+          command.executable = cppcheck_cmd;
+          command.arguments = cppcheck_args;
+          ok = deferCommand(command) && ok;
+        } else {
+          int ret_cc = common::run(cppcheck_cmd, cppcheck_args, "", output + ".err");
+          if(ret_cc != 0) {
+            pathDeleteFile(output + ".err");
+            writeErrorMsg(ABSTRACT_COMPILER, CMSG_CPPCHECK_FAILED, ret_cc);
+            ok = false;
+            cppcheck_ok = false;
+          }
         }
 
       }
 
+      // the DeferredAnalysis checks the results of the deferred commands
+      if (defer_analysis && !cached)
+        continue;
+
+      if (!cached && !cache_key.empty()) {
+        if (ret == 0 && cppcheck_ok)
+          astCache.store(cache_key, output, runs_cppcheck, start_time);
+        else
+          pathDeleteFile(output + AST_CACHE_DEPENDENCY_EXTENSION);
+      }
+
       if (ret != 0) {
         DirectoryFilter directoryFilter;
         directoryFilter.openFilterFile(filter_path);
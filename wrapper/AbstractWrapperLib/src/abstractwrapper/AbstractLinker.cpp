@@ -285,7 +285,7 @@ namespace ColumbusWrappers {
     inputFileList.sort(compareArguments);
     string currentWorkDir = common::getCwd();
     string inputfile_list = wrapper_temp_dir + DIRDIVSTRING + common::toString(getCurrentProcessId()) + "input.list";
-    for (list<Argument>::iterator it_inputfiles = inputFileList.begin(); it_inputfiles != inputFileList.end(); ++it_inputfiles) {
+    for (list<Argument>::iterator it_inputfiles = inputFileList.begin(); it_inputfiles != inputFileList.end() && !defer_analysis; ++it_inputfiles) {
       ofstream inputlist(inputfile_list.c_str(), ios::app);
       if (inputlist.is_open()) {
         inputlist << indepFullpath(it_inputfiles->name) << endl;
@@ -328,6 +328,22 @@ namespace ColumbusWrappers {
 
     writeInfoMsg(ABSTRACT_LINKER, CMSG_CURRENT_WORKDIR, currentWorkDir.c_str());
     writeInfoMsg(ABSTRACT_LINKER, CMSG_ANALYZER_WRAPPER_COMMAND, sys_cmd.c_str());
+
+    if (defer_analysis) {
+      DeferredCommand command;
+      command.kind = DeferredCommand::dck_link;
+      command.workDir = currentWorkDir;
+      command.output = indepFullpath(output);
+      string f, e;
+      if (common::splitExt(output, f, e))
+        command.resultList = wrapper_log_dir + DIRDIVSTRING + "component.list";
+      command.inputListFile = inputfile_list;
+      command.commandLine = sys_cmd;
+      for (list<Argument>::iterator it_inputfiles = inputFileList.begin(); it_inputfiles != inputFileList.end(); ++it_inputfiles)
+        command.inputList.push_back(indepFullpath(it_inputfiles->name));
+      return deferCommand(command);
+    }
+
     int ret = systemCall(sys_cmd);
     if (ret != 0) {
       writeErrorMsg(ABSTRACT_LINKER, CMSG_TOOL_RETURNS, link_tool.c_str(), ret);
@@ -61,7 +61,8 @@ namespace ColumbusWrappers {
                                                         messagelevel(3),
                                                         wrappedExe(),
                                                         instrument_enable(0),
-                                                        prep_instrument(0)
+                                                        prep_instrument(0),
+                                                        defer_analysis(0)
   {
     readConfig();
     getEnvVars();
@@ -80,6 +81,7 @@ namespace ColumbusWrappers {
     messagelevel = getConfigInt(ALLSECTION, MESSAGE_LEVEL, 3);
     instrument_enable = getConfigInt(ALLSECTION, ENABLE_COMPILER_INSTRUMENT, 0);
     prep_instrument = getConfigInt(ALLSECTION, PREPARE_FOR_INSTRUMENT, 0);
+    defer_analysis = getConfigInt(ALLSECTION, DEFER_ANALYSIS, 0);
   }
 
 
@@ -119,7 +121,7 @@ namespace ColumbusWrappers {
   }
 
 
-  string AbstractWrapper::getConfigString(const char* section, const char* key, const char* def) {
+  string AbstractWrapper::getConfigString(const char* section, const char* key, const char* def) const {
     bool casesensitive = false;
 #if defined(__linux__) || defined(__APPLE__)
     casesensitive = true;
@@ -529,6 +531,17 @@ namespace ColumbusWrappers {
   }
 
 
+  bool AbstractWrapper::deferCommand(const DeferredCommand& command) const {
+    string journal = getDeferredJournalName(wrapper_log_dir);
+    if (!appendDeferredCommand(journal, command)) {
+      writeErrorMsg(ABSTRACT_WRAPPER, CMSG_CANNOT_WRITE_DEFERRED_JOURNAL, journal.c_str());
+      return false;
+    }
+    writeInfoMsg(ABSTRACT_WRAPPER, CMSG_COMMAND_DEFERRED, command.output.c_str());
+    return true;
+  }
+
+
   int AbstractWrapper::silentSystemCall(const string& cmd) const {
     return common::run(cmd, true);
   }
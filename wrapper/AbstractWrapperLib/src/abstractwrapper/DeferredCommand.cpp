@@ -0,0 +1,183 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include "../../inc/abstractwrapper/DeferredCommand.h"
+
+#include <common/inc/FileSup.h>
+#include <common/inc/PlatformDependentDefines.h>
+#include <common/inc/StringSup.h>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace common;
+using namespace boost::interprocess;
+
+// A journal record is a single line. Its fields are separated by tabulators, the tabulators,
+// line ends and backslashes of the fields are escaped. The two lists are preceded by their size.
+
+namespace ColumbusWrappers {
+
+  namespace
+  {
+    void writeField(ostream& out, const string& field)
+    {
+      out << '\t';
+      for (char c : field)
+      {
+        switch (c)
+        {
+          case '\\': out << "\\\\"; break;
+          case '\t': out << "\\t"; break;
+          case '\n': out << "\\n"; break;
+          case '\r': out << "\\r"; break;
+          default: out << c; break;
+        }
+      }
+    }
+
+    void splitRecord(const string& line, vector<string>& fields)
+    {
+      string field;
+      for (size_t i = 0; i < line.length(); ++i)
+      {
+        char c = line[i];
+        if (c == '\t')
+        {
+          fields.push_back(field);
+          field.clear();
+        }
+        else if (c == '\\' && i + 1 < line.length())
+        {
+          switch (line[++i])
+          {
+            case 't': field += '\t'; break;
+            case 'n': field += '\n'; break;
+            case 'r': field += '\r'; break;
+            default: field += line[i]; break;
+          }
+        }
+        else
+          field += c;
+      }
+      fields.push_back(field);
+    }
+
+    bool readList(const vector<string>& fields, size_t& index, vector<string>& list)
+    {
+      if (index >= fields.size())
+        return false;
+      size_t size = str2int(fields[index++]);
+      if (fields.size() - index < size)
+        return false;
+      list.assign(fields.begin() + index, fields.begin() + index + size);
+      index += size;
+      return true;
+    }
+  }
+
+  string DeferredCommand::optionalInput(const string& filename)
+  {
+    return "?" + filename;
+  }
+
+  string getDeferredJournalName(const string& logDir)
+  {
+    return logDir + DIRDIVSTRING + DEFERRED_ANALYSIS_JOURNAL;
+  }
+
+  bool appendDeferredCommand(const string& journal, const DeferredCommand& command)
+  {
+    // the whole record is written at once under the lock, so the records of the parallel wrappers are not mixed
+    ostringstream record;
+    record << (int)command.kind;
+    writeField(record, command.workDir);
+    writeField(record, command.input);
+    writeField(record, command.output);
+    writeField(record, command.resultList);
+    writeField(record, command.stderrFile);
+    writeField(record, command.inputListFile);
+    writeField(record, command.commandLine);
+    writeField(record, command.executable);
+    writeField(record, toString((unsigned long)command.arguments.size()));
+    for (const string& argument : command.arguments)
+      writeField(record, argument);
+    writeField(record, toString((unsigned long)command.inputList.size()));
+    for (const string& input : command.inputList)
+      writeField(record, input);
+    record << '\n';
+
+    string lockFile = getLockFileName(journal);
+    ofstream lock(lockFile.c_str());
+    file_lock f_lock(lockFile.c_str());
+    scoped_lock<file_lock> e_lock(f_lock);
+
+    ofstream out(journal.c_str(), ios::app | ios::binary);
+    if (!out.is_open())
+      return false;
+    out << record.str();
+    out.flush();
+    return out.good();
+  }
+
+  bool loadDeferredCommands(const string& journal, vector<DeferredCommand>& commands)
+  {
+    ifstream in(journal.c_str(), ios::binary);
+    if (!in.is_open())
+      return false;
+
+    string line;
+    vector<string> fields;
+    while (getline(in, line))
+    {
+      if (line.empty())
+        continue;
+
+      fields.clear();
+      splitRecord(line, fields);
+      if (fields.size() < 11)
+        return false;
+
+      DeferredCommand command;
+      int kind = str2int(fields[0]);
+      if (kind < DeferredCommand::dck_analyze || kind > DeferredCommand::dck_link)
+        return false;
+      command.kind = (DeferredCommand::Kind)kind;
+      command.workDir = fields[1];
+      command.input = fields[2];
+      command.output = fields[3];
+      command.resultList = fields[4];
+      command.stderrFile = fields[5];
+      command.inputListFile = fields[6];
+      command.commandLine = fields[7];
+      command.executable = fields[8];
+
+      size_t index = 9;
+      if (!readList(fields, index, command.arguments) || !readList(fields, index, command.inputList))
+        return false;
+
+      commands.push_back(std::move(command));
+    }
+    return true;
+  }
+
+}
@@ -65,6 +65,14 @@
 
 #define NO_DELAYED_TEMPLATE_PARSING       "NO_DELAYED_TEMPLATE_PARSING" ///< -fno-delayed-template-parsing
 
+#define DEFER_ANALYSIS                    "DEFER_ANALYSIS"              ///< -deferAnalysis
+
+#define AST_CACHE_DIR                     "AST_CACHE_DIR"               ///< -astCacheDir
+
+#define AST_CACHE_SIZE                    "AST_CACHE_SIZE"              ///< -astCacheSize
+
+#define AST_CACHE_TOOL_HASH               "AST_CACHE_TOOL_HASH"         ///< it is set to the hash of the analyzer tools by the first compiler wrapper
+
 #define ANALYZER_WRAPPER_CONFIG           "analyzer_wrapper_config.ini" ///< the name of the analyzer wrapper config file
 
 #endif
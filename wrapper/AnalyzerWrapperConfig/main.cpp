@@ -60,6 +60,9 @@ string instrumenting;
 string prepForInstrument;
 string runCppcheck;
 string noDelayedTemplateParsing;
+string deferAnalysis;
+string astCacheDir;
+string astCacheSize;
 int linkingMode = 3;
 
 //Callback functions for argument processing.
@@ -135,6 +138,21 @@ static bool ppNoDelayedTemplateParsing(const Option *o, char *argv[]) {
   return true;
 }
 
+static bool ppDeferAnalysis(const Option *o, char *argv[]) {
+  deferAnalysis = argv[0];
+  return true;
+}
+
+static bool ppAstCacheDir(const Option *o, char *argv[]) {
+  astCacheDir = argv[0];
+  return true;
+}
+
+static bool ppAstCacheSize(const Option *o, char *argv[]) {
+  astCacheSize = argv[0];
+  return true;
+}
+
 static bool ppLinkingMode(const Option *o, char *argv[]) {
   linkingMode = common::str2int(argv[0]);
   return true;
@@ -158,6 +176,9 @@ const Option OPTIONS_OBJ[] = {
   { false,  "-prepareCompilerInstrument", 1, "needednumber{0,1}",                   0, OT_WS,    ppPrepCompInst,                 NULL, "Set prepare for instrument: it means that the CAN analyzes preprocessed files, so we have to preprocess these files before CAN calling. e.g.: -prepareCompilerInstrument 0|1"},
   { false,  "-runCppcheck",               1, "enablenumber{0,1}",                   0, OT_WS,    ppCppcheck,                     NULL, "Set whether run cppcheck or not. e.g.: -runCppcheck 0|1"},
   { false,  "-noDelayedTemplateParsing",  1, "enablenumber{0,1}",                   0, OT_WS,    ppNoDelayedTemplateParsing,     NULL, "Set whether to pass -fno-delayed-template-parsing to the CAN."},
+  { false,  "-deferAnalysis",             1, "enablenumber{0,1}",                   0, OT_WS,    ppDeferAnalysis,                NULL, "Set whether the compiler, linker and archive only record their analyzer commands into the journal of the DeferredAnalysis instead of running them. e.g.: -deferAnalysis 0|1"},
+  { false,  "-astCacheDir",               1, "directory",                           0, OT_WS,    ppAstCacheDir,                  NULL, "Set the directory of the AST cache. The compiler takes the outputs of CAN and cppcheck from this cache if neither the command line nor the source and the included files are changed. e.g.: -astCacheDir dirname"},
+  { false,  "-astCacheSize",              1, "number",                              0, OT_WS,    ppAstCacheSize,                 NULL, "Set the size limit of the AST cache in MByte (default: 5120). The least recently used entries are evicted over this limit. e.g.: -astCacheSize 5120"},
   { false,  "-linkingMode",               1, "number",                              0, OT_WS,    ppLinkingMode,                  NULL, "Set the linking mode.\nMode 1: Invoke CANLink instead of CANLib for the static libraries. Do not link the the lcsi of the static library into the lcsi of the exe.\nMode 2: Invoke CANLink instead of CANLib for the static libraries. Link the the lcsi of the static library into the lcsi of the exe. Mode 3: Use CANLib and link the csi files of the acsi into the lcsi of the exe."},
   COMMON_CL_ARGS
 };
@@ -268,7 +289,19 @@ int main(int argc, char **argv) {
     writePrivateProfileString(COMPILERSECTION, NO_DELAYED_TEMPLATE_PARSING, noDelayedTemplateParsing.c_str(), configfile.c_str(), casesensitive);
   }
 
-  
+
+  if (!deferAnalysis.empty()) {
+    writePrivateProfileString(ALLSECTION, DEFER_ANALYSIS, deferAnalysis.c_str(), configfile.c_str(), casesensitive);
+  }
+
+  if (!astCacheDir.empty()) {
+    writePrivateProfileString(COMPILERSECTION, AST_CACHE_DIR, astCacheDir.c_str(), configfile.c_str(), casesensitive);
+  }
+
+  if (!astCacheSize.empty()) {
+    writePrivateProfileString(COMPILERSECTION, AST_CACHE_SIZE, astCacheSize.c_str(), configfile.c_str(), casesensitive);
+  }
+
   writePrivateProfileString(ALLSECTION, LINKING_MODE, toString(linkingMode).c_str(), configfile.c_str(), casesensitive);
 
   MAIN_END
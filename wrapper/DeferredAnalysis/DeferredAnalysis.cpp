@@ -0,0 +1,276 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/filesystem/operations.hpp>
+#include "DeferredAnalysis/DeferredAnalysis.h"
+#include <AbstractWrapperLib/inc/messages.h>
+#include <AbstractWrapperLib/inc/paramsup/ParamsupCommon.h>
+#include <AnalyzerWrapperConfig/AnalyzerWrapperConfig.h>
+#include <common/inc/FileSup.h>
+#include <common/inc/StringSup.h>
+#include <common/inc/WriteMessage.h>
+#include <common/inc/PlatformDependentDefines.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace common;
+using namespace boost::interprocess;
+
+#define DEFERRED_ANALYSIS    "DeferredAnalysis"
+
+namespace ColumbusWrappers {
+
+  DeferredAnalysis::DeferredAnalysis(string configfile) : AbstractWrapper(configfile), jobs(0), maxLoad(0), filter_path(), directoryFilter() {
+    filter_path = getConfigString(LINKERSECTION, LINK_FILTER_FILE, NULL);
+    directoryFilter.openFilterFile(filter_path);
+  }
+
+  bool DeferredAnalysis::process(int argc, char** argv) {
+    for (int i = 0; i < argc; ++i) {
+      string param = argv[i];
+      if (param == "-jobs" && i + 1 < argc) {
+        jobs = (unsigned)max(0, str2int(argv[++i]));
+      } else if (param == "-maxLoad" && i + 1 < argc) {
+        maxLoad = atof(argv[++i]);
+      } else {
+        writeErrorMsg(DEFERRED_ANALYSIS, CMSG_DEFERRED_ANALYSIS_WRONG_ARGUMENT, param.c_str());
+        return false;
+      }
+    }
+
+    unsigned cores = max(1u, thread::hardware_concurrency());
+    if (jobs == 0)
+      jobs = cores;
+    if (maxLoad <= 0)
+      maxLoad = cores;
+
+    string journal = getDeferredJournalName(wrapper_log_dir);
+    if (!pathFileExists(journal, false))
+      return true;
+
+    // the journal is taken over, so the commands recorded meanwhile go into a new one
+    string takenJournal = journal + "." + toString(getCurrentProcessId());
+    {
+      string lockFile = getLockFileName(journal);
+      ofstream lock(lockFile.c_str());
+      file_lock f_lock(lockFile.c_str());
+      boost::interprocess::scoped_lock<file_lock> e_lock(f_lock);
+
+      boost::system::error_code ec;
+      boost::filesystem::rename(journal, takenJournal, ec);
+      if (ec) {
+        writeErrorMsg(DEFERRED_ANALYSIS, CMSG_CANNOT_READ_DEFERRED_JOURNAL, journal.c_str());
+        return false;
+      }
+    }
+
+    vector<DeferredCommand> commands;
+    if (!loadDeferredCommands(takenJournal, commands)) {
+      writeErrorMsg(DEFERRED_ANALYSIS, CMSG_CANNOT_READ_DEFERRED_JOURNAL, takenJournal.c_str());
+      return false;
+    }
+
+    vector<const DeferredCommand*> independentCommands;
+    vector<const DeferredCommand*> dependentCommands;
+    for (const DeferredCommand& command : commands) {
+      if (command.kind == DeferredCommand::dck_analyze || command.kind == DeferredCommand::dck_cppcheck)
+        independentCommands.push_back(&command);
+      else
+        dependentCommands.push_back(&command);
+    }
+
+    writeInfoMsg(DEFERRED_ANALYSIS, CMSG_DEFERRED_ANALYSIS_STARTED, (int)commands.size(), (int)min<size_t>(jobs, max<size_t>(1, independentCommands.size())));
+
+    runIndependentCommands(independentCommands);
+
+    string currentWorkDir = getCwd();
+    for (const DeferredCommand* command : dependentCommands)
+      finishCommand(*command, runDependentCommand(*command));
+    boost::system::error_code ec;
+    boost::filesystem::current_path(currentWorkDir, ec);
+
+    pathDeleteFile(takenJournal);
+    return true;
+  }
+
+  int DeferredAnalysis::runInWorkDir(int argc, char** argv) {
+    if (argc < 3)
+      return 1;
+
+    boost::system::error_code ec;
+    boost::filesystem::current_path(argv[0], ec);
+    if (ec) {
+      writeErrorMsg(DEFERRED_ANALYSIS, CMSG_CANNOT_CHANGE_WORKDIR, argv[0]);
+      return 1;
+    }
+
+    string stderrFile = argv[1];
+    vector<string> arguments(argv + 3, argv + argc);
+    return run(argv[2], arguments, string(), stderrFile == "-" ? string() : stderrFile);
+  }
+
+  void DeferredAnalysis::runIndependentCommands(const vector<const DeferredCommand*>& commands) {
+    string self = getExecutableProgramDir() + DIRDIVSTRING + DEFERRED_ANALYSIS;
+
+    atomic<size_t> next(0);
+    int running = 0;
+    mutex runningMutex;
+    mutex resultMutex;
+
+    auto worker = [&]() {
+      for (size_t i = next++; i < commands.size(); i = next++) {
+        const DeferredCommand& command = *commands[i];
+        if (command.kind == DeferredCommand::dck_cppcheck)
+          pathDeleteFile(command.stderrFile);
+
+        vector<string> arguments = { "-run", command.workDir, command.stderrFile.empty() ? "-" : command.stderrFile, command.executable };
+        arguments.insert(arguments.end(), command.arguments.begin(), command.arguments.end());
+
+        waitForLoad(running, runningMutex);
+        int ret = run(self, arguments);
+        {
+          lock_guard<mutex> lock(runningMutex);
+          --running;
+        }
+
+        lock_guard<mutex> lock(resultMutex);
+        finishCommand(command, ret);
+      }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 0; i < jobs && i < commands.size(); ++i)
+      threads.emplace_back(worker);
+    for (thread& t : threads)
+      t.join();
+  }
+
+  void DeferredAnalysis::waitForLoad(int& running, mutex& runningMutex) const {
+    unique_lock<mutex> lock(runningMutex);
+#if defined(__linux__) || defined(__APPLE__)
+    // at least one command is always running, so the analysis progresses even if the build keeps the machine busy
+    double load = 0;
+    while (running > 0 && getloadavg(&load, 1) == 1 && load > maxLoad) {
+      writeDebugMsg(DEFERRED_ANALYSIS, CMSG_DEFERRED_ANALYSIS_WAITING_FOR_LOAD, load, maxLoad);
+      lock.unlock();
+      this_thread::sleep_for(chrono::seconds(1));
+      lock.lock();
+    }
+#endif
+    ++running;
+  }
+
+  int DeferredAnalysis::runDependentCommand(const DeferredCommand& command) const {
+    boost::system::error_code ec;
+    boost::filesystem::current_path(command.workDir, ec);
+    if (ec) {
+      writeErrorMsg(DEFERRED_ANALYSIS, CMSG_CANNOT_CHANGE_WORKDIR, command.workDir.c_str());
+      return 1;
+    }
+
+    if (!command.inputListFile.empty()) {
+      ofstream inputlist(command.inputListFile.c_str(), ios::trunc);
+      for (const string& input : command.inputList) {
+        if (input.empty() || input[0] != '?')
+          inputlist << input << "\n";
+        else if (pathFileExists(input.substr(1)))
+          inputlist << input.substr(1) << "\n";
+      }
+    }
+
+    if (!command.commandLine.empty())
+      return systemCall(command.commandLine);
+    return systemCall(command.executable, command.arguments);
+  }
+
+  void DeferredAnalysis::finishCommand(const DeferredCommand& command, int ret) {
+    switch (command.kind) {
+      case DeferredCommand::dck_analyze:
+        if (ret != 0) {
+          if (!directoryFilter.isFilteredOut(command.input)) {
+            writeErrorMsg(DEFERRED_ANALYSIS, CMSG_TOOL_RETURNS, command.executable.c_str(), ret);
+            reportFailure(command.executable, ret);
+          }
+        } else {
+          appendToResultList(command);
+        }
+        break;
+
+      case DeferredCommand::dck_cppcheck:
+        if (ret != 0) {
+          pathDeleteFile(command.stderrFile);
+          writeErrorMsg(DEFERRED_ANALYSIS, CMSG_CPPCHECK_FAILED, ret);
+          reportFailure(command.executable, ret);
+        }
+        break;
+
+      case DeferredCommand::dck_archive:
+      case DeferredCommand::dck_link:
+        if (ret != 0) {
+          string tool = command.commandLine.empty() ? command.executable : command.commandLine.substr(0, command.commandLine.find(' '));
+          writeErrorMsg(DEFERRED_ANALYSIS, CMSG_TOOL_RETURNS, tool.c_str(), ret);
+          reportFailure(tool, ret);
+        } else {
+          appendToResultList(command);
+          pathDeleteFile(command.inputListFile);
+        }
+        break;
+    }
+  }
+
+  void DeferredAnalysis::appendToResultList(const DeferredCommand& command) const {
+    if (command.resultList.empty())
+      return;
+
+    string lockFile = getLockFileName(command.resultList);
+    ofstream resultlist(command.resultList.c_str(), ios::app);
+    ofstream lock(lockFile.c_str());
+
+    file_lock f_lock(lockFile.c_str());
+
+    if (resultlist.is_open()) {
+      //sets an exclusive lock on the file (no other processes can read or write it)
+      boost::interprocess::scoped_lock<file_lock> e_lock(f_lock);
+
+      resultlist << command.output << endl;
+      resultlist.flush();
+      resultlist.close();
+    }
+    lock.close();
+  }
+
+  void DeferredAnalysis::reportFailure(const string& tool, int ret) const {
+    FILE *error_file = fopen((wrapper_log_dir + DIRDIVSTRING "Error.log").c_str(), "at");
+    if (error_file != NULL) {
+      fprintf(error_file, "%s :%d\n", tool.c_str(), ret);
+      fclose(error_file);
+    }
+  }
+
+}
@@ -0,0 +1,105 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+#ifndef _DEFERRED_ANALYSIS_H
+#define _DEFERRED_ANALYSIS_H
+
+#include <AbstractWrapperLib/inc/abstractwrapper/AbstractWrapper.h>
+#include <common/inc/DirectoryFilter.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ColumbusWrappers {
+  class DeferredAnalysis : public AbstractWrapper {
+/**
+ * @brief This class runs the analyzer commands recorded by the wrappers into the journal.
+ *
+ * The CAN and cppcheck commands are run by a bounded number of threads which wait while the system load is too high,
+ * then the CANLib and CANLink commands are run in the order of their recording, because they depend on the earlier commands.
+ */
+  public:
+    /**
+     * @brief Public constructor for DeferredAnalysis class.
+     *
+     * @param configfile     [in] The input configuration file (analyzer_wrapper_config.ini) for analyzer wrapper.
+     */
+    DeferredAnalysis(std::string configfile);
+
+    /**
+     * @brief Takes over the journal and runs its commands.
+     *
+     * @param argc            [in] Number of input arguments.
+     * @param argv            [in] Array for input arguments (-jobs number, -maxLoad number).
+     * @return                     False, if the arguments are wrong or the journal cannot be read.
+     */
+    bool process(int argc, char** argv);
+
+    /**
+     * @brief Runs one command in the given working directory. The independent commands are run in separate DeferredAnalysis processes by this function,
+     *        because the working directory belongs to the process.
+     *
+     * @param argc            [in] Number of input arguments.
+     * @param argv            [in] The working directory, the standard error file ("-" if none), the executable and its arguments.
+     * @return                     The exit code of the command.
+     */
+    static int runInWorkDir(int argc, char** argv);
+
+  private:
+    /**
+     * @brief Runs the independent commands parallel.
+     */
+    void runIndependentCommands(const std::vector<const DeferredCommand*>& commands);
+
+    /**
+     * @brief Waits while the system load is above the limit and other commands are running, then counts the command as running.
+     *        The check and the count are done under the mutex, so the threads cannot start together on a busy system.
+     */
+    void waitForLoad(int& running, std::mutex& runningMutex) const;
+
+    /**
+     * @brief Runs a dependent command in the current process.
+     * @return                     The exit code of the command.
+     */
+    int runDependentCommand(const DeferredCommand& command) const;
+
+    /**
+     * @brief Checks the result of the command in the same way as the wrapper does.
+     */
+    void finishCommand(const DeferredCommand& command, int ret);
+
+    /**
+     * @brief Appends the output of the command to its result list.
+     */
+    void appendToResultList(const DeferredCommand& command) const;
+
+    /**
+     * @brief Records the failure of the command into the Error.log like the exewrapper.
+     */
+    void reportFailure(const std::string& tool, int ret) const;
+
+    unsigned jobs;                        ///< The maximum number of the parallel commands.
+    double maxLoad;                       ///< The new commands are not started while the system load is above this.
+    std::string filter_path;              ///< The path of the filter file.
+    DirectoryFilter directoryFilter;      ///< The errors of the filtered out files are not reported.
+  };
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ *  This file is part of OpenStaticAnalyzer.
+ *
+ *  Copyright (c) 2004-2018 Department of Software Engineering - University of Szeged
+ *
+ *  Licensed under Version 1.2 of the EUPL (the "Licence");
+ *
+ *  You may not use this work except in compliance with the Licence.
+ *
+ *  You may obtain a copy of the Licence in the LICENSE file or at:
+ *
+ *  https://joinup.ec.europa.eu/software/page/eupl
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the Licence is distributed on an "AS IS" basis,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the Licence for the specific language governing permissions and
+ *  limitations under the Licence.
+ */
+
+/**
+ * @page DeferredAnalysis
+ *
+ * @brief This program runs the analyzer commands which were recorded into the journal by the wrappers in deferred analysis mode. It uses analyzer_wrapper_config.ini file.
+ */
+
+/**
+ * @file wrapper/DeferredAnalysis/main.cpp
+ * @brief This program runs the analyzer commands which were recorded into the journal by the wrappers in deferred analysis mode. It uses analyzer_wrapper_config.ini file.
+ */
+
+#include "DeferredAnalysis/DeferredAnalysis.h"
+#include <common/inc/FileSup.h>
+#include <common/inc/PlatformDependentDefines.h>
+#include <AnalyzerWrapperConfig/AnalyzerWrapperConfig.h>
+#include <cstring>
+
+int main(int argc, char** argv) {
+  int ret = 0;
+
+  // one of the commands run by the DeferredAnalysis in its working directory
+  if (argc > 1 && strcmp(argv[1], "-run") == 0)
+    return ColumbusWrappers::DeferredAnalysis::runInWorkDir(argc-2, argv+2);
+
+  ColumbusWrappers::DeferredAnalysis da(common::getExecutableProgramDir() + DIRDIVSTRING + ANALYZER_WRAPPER_CONFIG);
+  ret = da.process(argc-1, argv+1) ? 0 : 1;
+
+  return ret;
+}